@@ -171,6 +171,7 @@ typedef enum asirikuyReturnCode_t
   ERROR_IN_RATES_RETRIEVAL = 3029,
   BID_ASK_IS_ZERO		= 3030,
   FILE_WRITING_ERROR	= 3031,  
+  FILE_READING_ERROR	= 3032,
 } AsirikuyReturnCode;
 
 typedef enum orderType_t
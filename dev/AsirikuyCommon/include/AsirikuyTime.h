@@ -56,7 +56,8 @@ extern "C" {
 * Converts time_t to struct tm.
 *
 * This function is thread-safe re-entrant version
-* of the standard C function "gmtime".
+* of the standard C function "gmtime". The date is taken
+* from the calendar day cache (see Calendar.h).
 *
 * @param struct tm* ptm
 *   The caller must allocate the struct tm.
@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief     Asynchronous logging with severity checks before argument evaluation.
+ * @details   Messages are formatted into a lock-free ring buffer and written to pantheios by a background thread.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef ASYNC_LOG_H_
+#define ASYNC_LOG_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#include <pantheios/pantheios.h>
+
+/* The least severe level compiled in. Building with e.g. -DASIRIKUY_LOG_SEVERITY_CEILING=PANTHEIOS_SEV_NOTICE
+ * removes every DEBUG and INFORMATIONAL log statement, arguments included. */
+#ifndef ASIRIKUY_LOG_SEVERITY_CEILING
+  #define ASIRIKUY_LOG_SEVERITY_CEILING PANTHEIOS_SEV_DEBUG
+#endif
+
+#define ASYNC_LOG_CAPACITY     4096 /* A power of 2 */
+#define ASYNC_LOG_MESSAGE_SIZE 512  /* Longer messages are truncated */
+#define ASYNC_LOG_IDLE_MS      2
+
+/* TRUE if a message of the given severity would be written. Guards code that only prepares log arguments. */
+#define ASIRIKUY_LOG_ENABLED(severity) (((severity) <= ASIRIKUY_LOG_SEVERITY_CEILING) && ((severity) <= gAsyncLogSeverity))
+
+/* Drop-in replacements for pantheios_logprintf and pantheios_logputs. The arguments are only evaluated if the severity is enabled. */
+#define ASIRIKUY_LOG_PRINTF(severity, ...) do { if(ASIRIKUY_LOG_ENABLED(severity)) asyncLogPrintf((severity), __VA_ARGS__); } while(0)
+#define ASIRIKUY_LOG_PUTS(severity, message) do { if(ASIRIKUY_LOG_ENABLED(severity)) asyncLogPuts((severity), (message)); } while(0)
+
+/**
+* Writes a message. The default sink is pantheios_logputs.
+*
+* @param int severity
+*   The pantheios severity of the message.
+*
+* @param const char* pMessage
+*   The formatted message.
+*/
+typedef void (*AsyncLogSink)(int severity, const char* pMessage);
+
+typedef struct asyncLogStats_t
+{
+  int queued;
+  int written;
+  int dropped;  /* Less severe than WARNING and the ring was full */
+  int overflow; /* WARNING or more severe and the ring was full, so written by the caller */
+} AsyncLogStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The most verbose severity currently enabled. Read by ASIRIKUY_LOG_ENABLED. */
+extern volatile int gAsyncLogSeverity;
+
+/**
+* Sets the most verbose severity to write, normally the MaxSeverity of the framework config.
+*
+* @param int severity
+*   A pantheios severity.
+*/
+void setAsyncLogSeverity(int severity);
+
+/**
+* Replaces the sink messages are written to, NULL for pantheios_logputs.
+*
+* @param AsyncLogSink sink
+*   The new sink.
+*/
+void setAsyncLogSink(AsyncLogSink sink);
+
+/**
+* Starts the background writer. Until it is started messages are written by the logging thread.
+*
+* @return BOOL
+*   FALSE if the writer thread could not be started.
+*/
+BOOL startAsyncLog();
+
+/**
+* Writes every queued message and stops the background writer.
+*/
+void stopAsyncLog();
+
+/**
+* Writes every message queued so far on the calling thread.
+*/
+void flushAsyncLog();
+
+/**
+* Formats a message and queues it for the background writer without taking any lock.
+* Use ASIRIKUY_LOG_PRINTF instead, so the arguments aren't evaluated for disabled severities.
+*
+* @param int severity
+*   The pantheios severity of the message.
+*
+* @param const char* pFormat
+*   printf style format.
+*/
+void asyncLogPrintf(int severity, const char* pFormat, ...);
+
+/**
+* Queues a message for the background writer without taking any lock.
+*
+* @param int severity
+*   The pantheios severity of the message.
+*
+* @param const char* pMessage
+*   The message.
+*/
+void asyncLogPuts(int severity, const char* pMessage);
+
+/**
+* Returns the counters since the library was loaded.
+*
+* @param AsyncLogStats* pStats
+*   Receives the counters.
+*/
+void getAsyncLogStats(AsyncLogStats* pStats);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ASYNC_LOG_H_ */
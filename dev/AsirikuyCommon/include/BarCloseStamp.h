@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief     Detects bar close events on rates buffers.
+ * @details   Values computed from closed bars of a higher timeframe only change when a new bar opens on it. A stamp remembers which bars a cached value was computed from so that it is only recomputed after a bar close.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef BAR_CLOSE_STAMP_H_
+#define BAR_CLOSE_STAMP_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct barCloseStamp_t
+{
+  BOOL   isValid;
+  int    variant;         /* Caller defined value for the inputs of the cached values, e.g. an averaging period */
+  int    arraySize;
+  time_t openTime;        /* Open time of the forming bar */
+  time_t lastClosedTime;  /* The last closed bar is compared as well so that reloaded rates are detected */
+  double lastClosedHigh;
+  double lastClosedLow;
+  double lastClosedClose;
+} BarCloseStamp;
+
+/**
+* Marks a stamp as not matching any rates.
+*
+* @param BarCloseStamp* pStamp
+*   The stamp to invalidate.
+*/
+void invalidateBarCloseStamp(BarCloseStamp* pStamp);
+
+/**
+* Checks whether the closed bars of a rates buffer are still the ones a stamp was taken on.
+* Updates of the forming bar don't change the closed bars.
+*
+* @param const Rates* pRates
+*   The rates to check.
+*
+* @param int variant
+*   Must match the variant the stamp was taken with.
+*
+* @param const BarCloseStamp* pStamp
+*   The stamp to compare.
+*
+* @return BOOL
+*   TRUE if values computed from the closed bars when the stamp was taken can be reused.
+*/
+BOOL isBarCloseStampCurrent(const Rates* pRates, int variant, const BarCloseStamp* pStamp);
+
+/**
+* Stamps the closed bars of a rates buffer.
+*
+* @param const Rates* pRates
+*   The rates to stamp.
+*
+* @param int variant
+*   Caller defined value for the inputs of the cached values.
+*
+* @param BarCloseStamp* pStamp
+*   The stamp to update.
+*/
+void setBarCloseStamp(const Rates* pRates, int variant, BarCloseStamp* pStamp);
+
+/**
+* Finds the slot of a strategy instance in a table of values stamped per instance, claiming a free slot if it has none.
+*
+* @param int* pOwners
+*   MAX_INSTANCES slot owners, the instance ID + 1 or 0 for a free slot. A zeroed static array is all free.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param BOOL* pIsClaimed
+*   Set to TRUE if the slot was just claimed, so its stamps must be invalidated before use.
+*
+* @return int
+*   The slot index or -1 if every slot is owned by another instance.
+*/
+int claimInstanceStampSlot(int* pOwners, int instanceId, BOOL* pIsClaimed);
+
+/**
+* Frees the slot of a strategy instance in a table of values stamped per instance.
+*
+* @param int* pOwners
+*   The slot owners passed to claimInstanceStampSlot.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @return int
+*   The freed slot index or -1 if the instance had no slot.
+*/
+int releaseInstanceStampSlot(int* pOwners, int instanceId);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BAR_CLOSE_STAMP_H_ */
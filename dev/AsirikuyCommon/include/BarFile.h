@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief     Bar history files in the binary bar format or the csv layouts written by RecordBars and exported by MetaTrader.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef BAR_FILE_H_
+#define BAR_FILE_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#define BAR_FILE_MAGIC   0x53524142  /* "BARS" */
+#define BAR_FILE_VERSION 1
+
+/* Stored at the start of a binary bar file and followed by the records, oldest first. */
+typedef struct barFileHeader_t
+{
+  int magic;
+  int version;
+  int timeframe;  /* Minutes, 0 if unknown */
+  int reserved;
+} BarFileHeader;
+
+typedef struct barRecord_t
+{
+  int    time;
+  int    reserved;
+  double open;
+  double high;
+  double low;
+  double close;
+  double volume;
+} BarRecord;
+
+/* A growable bar history with the same array layout as Rates. */
+typedef struct barSeries_t
+{
+  int     timeframe;
+  int     size;
+  int     capacity;
+  time_t* time;
+  double* open;
+  double* high;
+  double* low;
+  double* close;
+  double* volume;
+} BarSeries;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Initializes an empty series.
+*
+* @param BarSeries* pSeries
+*   The series to initialize.
+*/
+void initBarSeries(BarSeries* pSeries);
+
+/**
+* Frees the arrays of a series and leaves it empty.
+*
+* @param BarSeries* pSeries
+*   The series to free.
+*/
+void freeBarSeries(BarSeries* pSeries);
+
+/**
+* Appends a bar to a series.
+*
+* @param BarSeries* pSeries
+*   The series to append to.
+*
+* @param const BarRecord* pBar
+*   The bar to append.
+*
+* @return AsirikuyReturnCode
+*   INSUFFICIENT_MEMORY if the series could not grow.
+*/
+AsirikuyReturnCode appendBarToSeries(BarSeries* pSeries, const BarRecord* pBar);
+
+/**
+* Parses a csv line in one of the layouts written by RecordBars or exported by MetaTrader:
+*   1401062400, 1.37, 1.38, 1.36, 1.375, 120
+*   26/05/14 00:00, 1.37, 1.38, 1.36, 1.375, 120
+*   2014-05-26, 1.37, 1.38, 1.36, 1.375, 120
+*   2014.05.26,00:00,1.37,1.38,1.36,1.375,120
+* Times are read as UTC.
+*
+* @param const char* line
+*   The line to parse.
+*
+* @param BarRecord* pBar
+*   Receives the bar.
+*
+* @return BOOL
+*   FALSE for headers and malformed lines.
+*/
+BOOL parseBarLine(const char* line, BarRecord* pBar);
+
+/**
+* Loads a bar file, detecting binary files by their header and reading anything else as csv.
+* Lines that don't parse are skipped.
+*
+* @param const char* filePath
+*   The file to load.
+*
+* @param BarSeries* pSeries
+*   Receives the bars, appended to the ones it already holds.
+*
+* @return AsirikuyReturnCode
+*   ERROR_IN_RATES_RETRIEVAL if the file can't be opened, INSUFFICIENT_MEMORY if the series could not grow.
+*/
+AsirikuyReturnCode loadBarFile(const char* filePath, BarSeries* pSeries);
+
+/**
+* Writes a series to a binary bar file, replacing the file.
+*
+* @param const char* filePath
+*   The file to write.
+*
+* @param const BarSeries* pSeries
+*   The bars to write.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file could not be written.
+*/
+AsirikuyReturnCode saveBarFile(const char* filePath, const BarSeries* pSeries);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BAR_FILE_H_ */
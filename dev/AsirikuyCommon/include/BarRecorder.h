@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @brief     Buffered binary bar recorder.
+ * @details   Keeps bar files open per strategy instance, appends bars in batches and maintains a day index next to each file.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef BAR_RECORDER_H_
+#define BAR_RECORDER_H_
+#pragma once
+
+#include <stdio.h>
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifndef BAR_FILE_H_
+  #include "BarFile.h"
+#endif
+
+#define BAR_RECORDER_BUFFER_SIZE   64  /* Bars buffered before they are written */
+#define BAR_RECORDER_FLUSH_SECONDS 300 /* Longest time a buffered bar waits to be written */
+#define BAR_INDEX_EXTENSION        ".idx"
+
+/* Text layouts of the csv files written by earlier versions of RecordBars. */
+typedef enum barTextLayout_t
+{
+  BAR_TEXT_DATE_AS_INTEGER = 0, /* 1401062400, 1.370000, ... */
+  BAR_TEXT_DATE_AS_STRING  = 1, /*  26/05/14 00:00, 1.370000, ... */
+  BAR_TEXT_DATE_FOR_R      = 2, /*  2014-05-26, 1.370000, ... */
+  BAR_TEXT_NONE            = -1
+} BarTextLayout;
+
+/* One entry per day, stored in the index file next to a bar file. */
+typedef struct barIndexEntry_t
+{
+  int dayTime;     /* Midnight of the day */
+  int firstRecord; /* Record of the first bar of the day */
+} BarIndexEntry;
+
+typedef struct barRecorder_t
+{
+  int           instanceId;
+  FILE*         pBarFile;
+  FILE*         pIndexFile;
+  int           writtenBars;  /* Bars in the file */
+  int           writtenDays;  /* Entries in the index file */
+  int           lastTime;     /* Time of the latest bar, written or buffered */
+  int           lastDayTime;
+  int           bufferedBars;
+  int           bufferedDays;
+  time_t        lastFlushTime;
+  BarRecord     bars[BAR_RECORDER_BUFFER_SIZE];
+  BarIndexEntry days[BAR_RECORDER_BUFFER_SIZE];
+  char          path[MAX_FILE_PATH_CHARS];
+  BarTextLayout exportLayout;
+  char          exportPath[MAX_FILE_PATH_CHARS];
+} BarRecorder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Opens a binary bar file for appending, creating it when it doesn't exist.
+* The day index is rebuilt if it is missing or doesn't match the file.
+*
+* @param BarRecorder* pRecorder
+*   The recorder to open.
+*
+* @param const char* pPath
+*   Path of the bar file. The index is kept at the same path followed by BAR_INDEX_EXTENSION.
+*
+* @param int timeframe
+*   Timeframe of the bars in minutes, stored in the header of a new file.
+*
+* @param const char* pCsvPath
+*   A csv bar file whose bars are imported into a new file. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file can't be opened or doesn't hold bars.
+*/
+AsirikuyReturnCode openBarRecorder(BarRecorder* pRecorder, const char* pPath, int timeframe, const char* pCsvPath);
+
+/**
+* Buffers a bar. Bars that are not newer than the latest recorded bar are ignored.
+* The buffer is written when it is full or when BAR_RECORDER_FLUSH_SECONDS have passed since the last write.
+*
+* @param BarRecorder* pRecorder
+*   The recorder.
+*
+* @param const BarRecord* pBar
+*   The bar to record.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if a write failed. The bars stay buffered.
+*/
+AsirikuyReturnCode appendBarRecorder(BarRecorder* pRecorder, const BarRecord* pBar);
+
+/**
+* Writes the buffered bars and index entries.
+*
+* @param BarRecorder* pRecorder
+*   The recorder.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if a write failed. The bars stay buffered.
+*/
+AsirikuyReturnCode flushBarRecorder(BarRecorder* pRecorder);
+
+/**
+* Writes the buffered bars and closes the files.
+*
+* @param BarRecorder* pRecorder
+*   The recorder to close.
+*/
+void closeBarRecorder(BarRecorder* pRecorder);
+
+/**
+* Returns the number of bars recorded, including buffered ones.
+*
+* @param const BarRecorder* pRecorder
+*   The recorder.
+*
+* @return int
+*   The number of bars.
+*/
+int getBarRecorderCount(const BarRecorder* pRecorder);
+
+/**
+* Rewrites the day index of a binary bar file from its bars.
+*
+* @param const char* pPath
+*   Path of the bar file.
+*
+* @return AsirikuyReturnCode
+*   ERROR_IN_RATES_RETRIEVAL if the bar file can't be read, FILE_WRITING_ERROR if the index can't be written.
+*/
+AsirikuyReturnCode rebuildBarFileIndex(const char* pPath);
+
+/**
+* Writes the bars of a binary bar file within a time range as text. The day index is used to skip to the first bar.
+*
+* @param const char* pPath
+*   Path of the bar file.
+*
+* @param const char* pTextPath
+*   Path of the text file, replaced if it exists.
+*
+* @param BarTextLayout layout
+*   The text layout.
+*
+* @param time_t fromTime
+*   Time of the first bar exported. 0 exports from the start.
+*
+* @param time_t toTime
+*   Time of the last bar exported. 0 exports to the end.
+*
+* @param int* pExported
+*   Set to the number of bars exported. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   ERROR_IN_RATES_RETRIEVAL if the bar file can't be read, FILE_WRITING_ERROR if the text file can't be written.
+*/
+AsirikuyReturnCode exportBarFileText(const char* pPath, const char* pTextPath, BarTextLayout layout, time_t fromTime, time_t toTime, int* pExported);
+
+/**
+* Returns the recorder of a strategy instance, opening it on first use.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param const char* pPath
+*   Path of the bar file.
+*
+* @param int timeframe
+*   Timeframe of the bars in minutes.
+*
+* @param const char* pCsvPath
+*   The csv bar file imported into a new bar file and rewritten from it when the recorder is closed. May be NULL.
+*
+* @param BarTextLayout exportLayout
+*   Layout of the csv file, BAR_TEXT_NONE to leave it untouched on close.
+*
+* @param BarRecorder** ppRecorder
+*   Set to the recorder.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the recorder is available.
+*/
+AsirikuyReturnCode getInstanceBarRecorder(int instanceId, const char* pPath, int timeframe, const char* pCsvPath, BarTextLayout exportLayout, BarRecorder** ppRecorder);
+
+/**
+* Closes the recorder of a strategy instance if it has one, exporting its csv file if requested.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void closeInstanceBarRecorder(int instanceId);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BAR_RECORDER_H_ */
@@ -47,6 +47,22 @@
   #include "AsirikuyDefines.h"
 #endif
 
+#define MAX_SHARED_RATES           64
+#define MAX_SHARED_RATES_KEY_CHARS 64
+
+/**
+* Identifies rates that can be converted once and read by every instance asking for them.
+* Two instances share rates only when every field matches.
+*/
+typedef struct sharedRatesKey_t
+{
+  char symbol[MAX_SHARED_RATES_KEY_CHARS];    /* Broker symbol of the source chart */
+  char timeZones[MAX_SHARED_RATES_KEY_CHARS]; /* Time zone configuration used for the conversion */
+  int  sourceTimeframe;                       /* Timeframe of the source chart */
+  int  timeframe;                             /* Timeframe after conversion */
+  int  arraySize;                             /* Number of converted bars */
+} SharedRatesKey;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,6 +74,118 @@ AsirikuyReturnCode allocateRates(RatesBuffers** ppRatesBuffer, int instanceId, R
 AsirikuyReturnCode incrementRatesOffset(int instanceId, int ratesIndex);
 AsirikuyReturnCode copyRatesBuffer(Rates* pDest, Rates* pSrc);
 
+/**
+* Enables sharing of converted rates between instances. Only strategies that never write into their rates may share them.
+*
+* @param BOOL isEnabled
+*   TRUE to convert rates once per key and tick, FALSE to keep a private copy per instance.
+*/
+void setShareRatesBuffers(BOOL isEnabled);
+
+/**
+* Reports whether converted rates are shared between instances.
+*
+* @return BOOL
+*   TRUE if sharing is enabled.
+*/
+BOOL isShareRatesBuffersEnabled();
+
+/**
+* Binds a rates index of an instance to the shared rates for a key. The first instance asking for a key allocates them
+* and the last instance releasing them frees them. Binding to a different key releases the previous binding.
+*
+* @param int instanceId
+*   The instance, which must already have a rates buffer allocated.
+*
+* @param int ratesIndex
+*   The rates index of the instance to bind.
+*
+* @param const SharedRatesKey* pKey
+*   The key of the shared rates.
+*
+* @param const RatesInfo* pRatesInfo
+*   Used to allocate the shared rates if they don't exist yet.
+*
+* @param int* pSharedRatesId
+*   Receives the id of the shared rates.
+*
+* @return AsirikuyReturnCode
+*   TOO_MANY_INSTANCES if all shared rates are in use.
+*/
+AsirikuyReturnCode acquireSharedRates(int instanceId, int ratesIndex, const SharedRatesKey* pKey, const RatesInfo* pRatesInfo, int* pSharedRatesId);
+
+/**
+* Write locks shared rates if the source bar is newer than the last one converted into them.
+*
+* @param int sharedRatesId
+*   The id returned by acquireSharedRates().
+*
+* @param time_t sourceTime
+*   Open time of the latest source bar.
+*
+* @param double sourceClose
+*   Close of the latest source bar.
+*
+* @param double sourceVolume
+*   Volume of the latest source bar.
+*
+* @param RatesBuffers** ppSharedBuffers
+*   Receives the buffers to convert into.
+*
+* @param int* pRatesIndex
+*   Receives the rates index to convert into.
+*
+* @return BOOL
+*   TRUE if the rates must be converted. endSharedRatesUpdate() must then be called. FALSE if they are up to date.
+*/
+BOOL beginSharedRatesUpdate(int sharedRatesId, time_t sourceTime, double sourceClose, double sourceVolume, RatesBuffers** ppSharedBuffers, int* pRatesIndex);
+
+/**
+* Releases the write lock taken by beginSharedRatesUpdate().
+*
+* @param int sharedRatesId
+*   The id of the shared rates.
+*/
+void endSharedRatesUpdate(int sharedRatesId);
+
+/**
+* Read locks every shared rates bound to an instance and points its rates at them. The rates are read-only until detachSharedRates() is called.
+*
+* @param int instanceId
+*   The instance to attach.
+*
+* @return AsirikuyReturnCode
+*   UNKNOWN_INSTANCE_ID if the instance does not have a rates buffer allocated.
+*/
+AsirikuyReturnCode attachSharedRates(int instanceId);
+
+/**
+* Clears the shared rates views of an instance and releases their read locks.
+*
+* @param int instanceId
+*   The instance to detach.
+*/
+void detachSharedRates(int instanceId);
+
+/**
+* Counts the memory held by all allocated rates, counting shared rates once.
+*
+* @return size_t
+*   The number of bytes.
+*/
+size_t getRatesBuffersMemoryUsage();
+
+/**
+* Counts how many times shared rates were converted.
+*
+* @param int sharedRatesId
+*   The id of the shared rates.
+*
+* @return int
+*   The number of conversions since the shared rates were allocated.
+*/
+int getSharedRatesConversions(int sharedRatesId);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @brief     Incremental builders for Renko and constant volume bars derived from a rates buffer.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef DERIVED_RATES_H_
+#define DERIVED_RATES_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum derivedRatesType_t
+{
+  DERIVED_RENKO_RATES           = 0, /* A bar closes when the price moves more than the bar size away from its open */
+  DERIVED_CONSTANT_VOLUME_RATES = 1  /* A bar closes when its volume reaches the bar size */
+} DerivedRatesType;
+
+/* The derived bar which is still collecting source bars. */
+typedef struct derivedBar_t
+{
+  BOOL   isNew;   /* The next source bar opens a new derived bar */
+  time_t time;
+  double open;
+  double high;
+  double low;
+  double volume;
+} DerivedBar;
+
+typedef struct derivedRatesBuilder_t
+{
+  int              instanceId;
+  int              ratesIndex;
+  BOOL             isBuilt;
+  DerivedRatesType type;
+  double           barSize;
+  int              capacity;
+  int              closedBars;       /* Derived bars which no later source bar can change */
+  Rates            rates;            /* The closed bars followed by the bar containing the forming source bar */
+  DerivedBar       openBar;          /* State after the last consumed source bar */
+  int              consumedBars;     /* Closed source bars folded into the derived bars */
+  time_t           firstSourceTime;  /* The derived bars are anchored to the open of the first source bar */
+  time_t           lastConsumedTime;
+  double           lastConsumedClose;
+} DerivedRatesBuilder;
+
+/**
+* Initializes an empty builder.
+*
+* @param DerivedRatesBuilder* pBuilder
+*   The builder to initialize.
+*/
+void initDerivedRatesBuilder(DerivedRatesBuilder* pBuilder);
+
+/**
+* Frees the derived bars of a builder and leaves it empty.
+*
+* @param DerivedRatesBuilder* pBuilder
+*   The builder to free.
+*/
+void freeDerivedRatesBuilder(DerivedRatesBuilder* pBuilder);
+
+/**
+* Brings the derived bars up to date with a source rates buffer.
+* Only the source bars which closed since the previous update are consumed and the forming source bar is applied to a copy of the open derived bar.
+* The bars are rebuilt from the first source bar when the source no longer starts at the same bar, its consumed bars changed or the type or size differ.
+* The result is identical to building the derived bars from all the source bars.
+*
+* @param DerivedRatesBuilder* pBuilder
+*   The builder to update.
+*
+* @param DerivedRatesType type
+*   The kind of derived bars.
+*
+* @param double barSize
+*   The renko brick size in price units or the volume of a constant volume bar.
+*
+* @param const Rates* pSource
+*   The source rates. The last bar is the forming one.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the update was successful.
+*/
+AsirikuyReturnCode updateDerivedRates(DerivedRatesBuilder* pBuilder, DerivedRatesType type, double barSize, const Rates* pSource);
+
+/**
+* Points a rates buffer at the derived bars of a builder. The arrays remain owned by the builder.
+*
+* @param const DerivedRatesBuilder* pBuilder
+*   The builder to view.
+*
+* @param Rates* pRates
+*   The rates buffer to point at the derived bars.
+*/
+void viewDerivedRates(const DerivedRatesBuilder* pBuilder, Rates* pRates);
+
+/**
+* Finds the builder which persists the derived bars of a rates index of a strategy instance between runs.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param int ratesIndex
+*   The rates index the derived bars are exposed on.
+*
+* @param BOOL isCreated
+*   Creates an empty builder when the instance has none for the rates index.
+*
+* @return DerivedRatesBuilder*
+*   The builder or NULL if none exists and none could be created.
+*/
+DerivedRatesBuilder* getDerivedRatesBuilder(int instanceId, int ratesIndex, BOOL isCreated);
+
+/**
+* Frees a builder returned by getDerivedRatesBuilder() and makes its slot available to other instances.
+*
+* @param DerivedRatesBuilder* pBuilder
+*   The builder to release.
+*/
+void releaseDerivedRatesBuilder(DerivedRatesBuilder* pBuilder);
+
+/**
+* Frees every builder of a strategy instance and makes their slots available to other instances.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void releaseInstanceDerivedRatesBuilders(int instanceId);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* DERIVED_RATES_H_ */
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief     Per bar balance, equity and margin of a backtest.
+ * @details   Stored as structure of arrays, with downsampling to a target number of points.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef EQUITY_CURVE_H_
+#define EQUITY_CURVE_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#define EQUITY_CURVE_FILE_MAGIC   0x56435145 /* "EQCV" */
+#define EQUITY_CURVE_FILE_VERSION 1
+
+typedef enum equityCurveDownsampling_t
+{
+  EQUITY_CURVE_KEEP_ALL = 0, /* Keep every captured point */
+  EQUITY_CURVE_LTTB     = 1, /* Largest triangle three buckets on the equity, keeps the visual shape */
+  EQUITY_CURVE_MIN_MAX  = 2  /* Lowest and highest equity of each bucket, keeps every drawdown extreme */
+} EquityCurveDownsampling;
+
+typedef struct equityCurve_t
+{
+  int                     capacity;       /* Points the arrays can hold */
+  int                     totalPoints;
+  int                     overflowPoints; /* Points captured after the arrays were full. They are not stored. */
+  int                     targetPoints;   /* Points kept by downsampleEquityCurve. 0 keeps every point. */
+  EquityCurveDownsampling downsampling;
+  int*                    time;
+  double*                 balance;
+  double*                 equity;
+  double*                 margin;
+} EquityCurve;
+
+/* Followed by totalPoints times, then totalPoints balances, equities and margins. */
+typedef struct equityCurveFileHeader_t
+{
+  int magic;
+  int version;
+  int totalPoints;
+  int overflowPoints;
+} EquityCurveFileHeader;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Allocates the arrays of an equity curve in one block.
+*
+* @param EquityCurve* pCurve
+*   The curve to allocate.
+*
+* @param int capacity
+*   The number of points to hold, usually the number of bars of the test.
+*
+* @param int targetPoints
+*   The number of points kept by downsampleEquityCurve. 0 keeps every point.
+*
+* @param EquityCurveDownsampling downsampling
+*   How the points are chosen when there are more than targetPoints.
+*
+* @return AsirikuyReturnCode
+*   INVALID_PARAMETER if the capacity isn't positive, INSUFFICIENT_MEMORY if the arrays can't be allocated.
+*/
+AsirikuyReturnCode allocEquityCurve(EquityCurve* pCurve, int capacity, int targetPoints, EquityCurveDownsampling downsampling);
+
+/**
+* Releases the arrays of an equity curve.
+*
+* @param EquityCurve* pCurve
+*   The curve to free.
+*/
+void freeEquityCurve(EquityCurve* pCurve);
+
+/**
+* Discards the points of an equity curve, keeping its arrays.
+*
+* @param EquityCurve* pCurve
+*   The curve to clear.
+*/
+void clearEquityCurve(EquityCurve* pCurve);
+
+/**
+* Appends a point to an equity curve.
+*
+* @param EquityCurve* pCurve
+*   The curve.
+*
+* @param int time
+*   Time of the bar.
+*
+* @param double balance
+*   Account balance at the bar.
+*
+* @param double equity
+*   Balance plus the floating profit of the open orders.
+*
+* @param double margin
+*   Margin used by the open orders.
+*
+* @return BOOL
+*   FALSE if the arrays are full. The point is counted in overflowPoints.
+*/
+BOOL addEquityCurvePoint(EquityCurve* pCurve, int time, double balance, double equity, double margin);
+
+/**
+* Reduces the points of an equity curve to its target number of points in place.
+* The first and last points are always kept.
+*
+* @param EquityCurve* pCurve
+*   The curve.
+*/
+void downsampleEquityCurve(EquityCurve* pCurve);
+
+/**
+* Writes the points of an equity curve to a binary file.
+*
+* @param const EquityCurve* pCurve
+*   The curve.
+*
+* @param const char* pPath
+*   Path of the file.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file can't be written.
+*/
+AsirikuyReturnCode writeEquityCurve(const EquityCurve* pCurve, const char* pPath);
+
+/**
+* Reads an equity curve written by writeEquityCurve. The arrays are allocated to fit the points.
+*
+* @param EquityCurve* pCurve
+*   Receives the curve. Free it with freeEquityCurve.
+*
+* @param const char* pPath
+*   Path of the file.
+*
+* @return AsirikuyReturnCode
+*   FILE_READING_ERROR if the file can't be read or isn't an equity curve.
+*/
+AsirikuyReturnCode readEquityCurve(EquityCurve* pCurve, const char* pPath);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* EQUITY_CURVE_H_ */
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @brief     Change aware cache of small side files.
+ * @details   Keeps the parsed value of each file and only parses it again when its modification time or size changes. Files are checked at most once per check interval.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef FILE_CACHE_H_
+#define FILE_CACHE_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#define FILE_CACHE_SIZE              1024
+#define FILE_CACHE_MAX_VALUE_SIZE    128
+#define FILE_CACHE_MAX_TEXT_SIZE     4096 /* Longer files are parsed from their first part */
+#define DEFAULT_FILE_CACHE_CHECK_MS  500
+
+/* Parses the text of a file into a value. Returns FALSE if the text doesn't hold a value. */
+typedef BOOL (*FileCacheParser)(const char* pText, void* pValue);
+
+typedef struct fileCacheStats_t
+{
+  int lookups;
+  int checks;   /* Lookups that looked at the file's modification time and size */
+  int parses;   /* Lookups that opened and parsed the file */
+  int writes;
+  int evictions;
+} FileCacheStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Sets how long a cached value is used before the file is checked for changes again.
+*
+* @param int milliseconds
+*   The check interval. 0 checks the file on every lookup.
+*/
+void setFileCacheCheckInterval(int milliseconds);
+
+/**
+* Returns the value of a file, parsing it only if it changed since it was last parsed.
+*
+* @param const char* pPath
+*   Path of the file.
+*
+* @param FileCacheParser parser
+*   Parses the text of the file. Must always be the same for a given path.
+*
+* @param void* pValue
+*   Receives the value. Left untouched if the file doesn't exist or can't be parsed.
+*
+* @param size_t valueSize
+*   Size of the value, up to FILE_CACHE_MAX_VALUE_SIZE.
+*
+* @return BOOL
+*   FALSE if the file doesn't exist or can't be parsed.
+*/
+BOOL readFileCache(const char* pPath, FileCacheParser parser, void* pValue, size_t valueSize);
+
+/**
+* Writes the text of a file and caches the value parsed from it, so the next lookup doesn't read the file back.
+*
+* @param const char* pPath
+*   Path of the file, replaced if it exists.
+*
+* @param const char* pText
+*   The text to write.
+*
+* @param FileCacheParser parser
+*   Parses the text.
+*
+* @param size_t valueSize
+*   Size of the value, up to FILE_CACHE_MAX_VALUE_SIZE.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file could not be written.
+*/
+AsirikuyReturnCode writeFileCache(const char* pPath, const char* pText, FileCacheParser parser, size_t valueSize);
+
+/**
+* Returns the cache counters since the last reset.
+*
+* @param FileCacheStats* pStats
+*   Receives the counters.
+*/
+void getFileCacheStats(FileCacheStats* pStats);
+
+/**
+* Forgets every cached file and clears the counters.
+*/
+void resetFileCache();
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* FILE_CACHE_H_ */
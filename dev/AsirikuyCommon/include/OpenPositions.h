@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @brief     Aggregated exposure of the open orders.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef OPEN_POSITIONS_H_
+#define OPEN_POSITIONS_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum positionSideIndex_t
+{
+  LONG_POSITIONS  = 0, /* BUY, BUYLIMIT and BUYSTOP orders */
+  SHORT_POSITIONS = 1, /* SELL, SELLLIMIT and SELLSTOP orders */
+  POSITION_SIDES  = 2
+} PositionSideIndex;
+
+typedef struct positionSide_t
+{
+  int     totalOrders;
+  double  lots;
+  double  lotsTimesOpen;       /* Sum of lots * openPrice */
+  double  marketLots;          /* BUY or SELL orders only */
+  double  marketLotsTimesOpen;
+  double  stopLossRisk;        /* Sum of lots * |openPrice - stopLoss| of the market orders whose stop is a loss */
+  double  stopLossProfit;      /* Same for the market orders whose stop locks in a profit */
+  double* pOpenPrices;         /* Open prices in ascending order */
+  double* pLotsBelow;          /* pLotsBelow[i] = lots of the orders before pOpenPrices[i] */
+  double* pLotsTimesOpenBelow; /* pLotsTimesOpenBelow[i] = lots * openPrice of the orders before pOpenPrices[i] */
+} PositionSide;
+
+typedef struct openPositions_t
+{
+  PositionSide sides[POSITION_SIDES];
+  double       volatilityRiskLots;     /* Lots counted by the volatility risk, see getOpenPositionsVolatilityRisk() */
+  double       volatilityRiskLotsNoTP; /* Same over the orders without take profit */
+} OpenPositions;
+
+/**
+* Aggregates the open orders of an order history by side.
+*
+* @param OpenPositions* pPositions
+*   The aggregate to initialize. Must be released with freeOpenPositions().
+*
+* @param const OrderInfo* pOrders
+*   The order history, e.g. StrategyParams.orderInfo.
+*
+* @param int size
+*   The number of entries in pOrders.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode initOpenPositions(OpenPositions* pPositions, const OrderInfo* pOrders, int size);
+
+/**
+* Releases the memory owned by an open positions aggregate.
+*
+* @param OpenPositions* pPositions
+*   The aggregate to release.
+*/
+void freeOpenPositions(OpenPositions* pPositions);
+
+/**
+* Returns the floating profit or loss of the open orders, in lots times loss per lot.
+*
+* Longs are valued at the ask and shorts at the bid. The value of each side is a single multiply-add of
+* the current price with the side totals, or a lookup of the losing orders when profits are ignored.
+*
+* @param const OpenPositions* pPositions
+*   An initialized aggregate.
+*
+* @param double bid
+*   The current bid price.
+*
+* @param double ask
+*   The current ask price.
+*
+* @param double lossPerPriceUnit
+*   Loss of one lot for a price move of 1, i.e. maxLossPerLot() for a stop loss of 1.
+*
+* @param BOOL isIgnoredLockedProfit
+*   If TRUE only the losing orders are counted.
+*
+* @param double* pLotsAtPrice
+*   Receives the lots of the orders opened exactly at the current price, which are not part of the result.
+*   Callers that don't ignore profits value them with their own loss per lot for a zero distance.
+*
+* @return double
+*   The sum of lots * distance to the current price * lossPerPriceUnit, negative for losses.
+*/
+double getOpenPositionsPNL(const OpenPositions* pPositions, double bid, double ask, double lossPerPriceUnit, BOOL isIgnoredLockedProfit, double* pLotsAtPrice);
+
+/**
+* Returns the result of all the market orders being stopped out.
+*
+* @param const OpenPositions* pPositions
+*   An initialized aggregate.
+*
+* @param double lossPerPriceUnit
+*   Loss of one lot for a price move of 1.
+*
+* @param BOOL isIgnoredLockedProfit
+*   If TRUE the stops that lock in a profit are not counted.
+*
+* @return double
+*   The sum of lots * stop distance * lossPerPriceUnit, negative for losses.
+*/
+double getOpenPositionsStopLossRisk(const OpenPositions* pPositions, double lossPerPriceUnit, BOOL isIgnoredLockedProfit);
+
+/**
+* Returns the loss of the open orders for a move of the same size against every order.
+*
+* Matches how EasyTrade has always counted it: from the first market order whose stop is a loss, in order
+* history order, every later open order counts.
+*
+* @param const OpenPositions* pPositions
+*   An initialized aggregate.
+*
+* @param double lossPerLot
+*   Loss of one lot for the move, e.g. maxLossPerLot() for the daily ATR.
+*
+* @param BOOL isNoTakeProfitOnly
+*   If TRUE only the orders without take profit are counted.
+*
+* @return double
+*   The loss as a negative number.
+*/
+double getOpenPositionsVolatilityRisk(const OpenPositions* pPositions, double lossPerLot, BOOL isNoTakeProfitOnly);
+
+/**
+* Returns the lots weighted average open price of the market orders of a side.
+*
+* @param const OpenPositions* pPositions
+*   An initialized aggregate.
+*
+* @param PositionSideIndex side
+*   LONG_POSITIONS or SHORT_POSITIONS.
+*
+* @return double
+*   The break even price, or 0 if the side has no market orders.
+*/
+double getOpenPositionsBreakEvenPrice(const OpenPositions* pPositions, PositionSideIndex side);
+
+/**
+* Returns the lots of all the open orders.
+*
+* @param const OpenPositions* pPositions
+*   An initialized aggregate.
+*
+* @return double
+*   The total lots.
+*/
+double getOpenPositionsLots(const OpenPositions* pPositions);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* OPEN_POSITIONS_H_ */
@@ -0,0 +1,280 @@
+/**
+ * @file
+ * @brief     Day bucketed index over the order history.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef ORDER_HISTORY_INDEX_H_
+#define ORDER_HISTORY_INDEX_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORDER_HISTORY_DAYS_OF_YEAR  366
+#define ORDER_HISTORY_MAX_WEEK_DAYS 10 /* Upper bound of the buckets returned by findOrderHistoryWeekDays() */
+
+typedef struct orderHistoryDay_t
+{
+  time_t     dayNumber;      /* Days since 01/01/1970 of the open time. Day of year for the day of year totals */
+  int        orders;         /* Orders with a ticket. 0 marks an empty slot */
+  int        marketOrders;   /* BUY and SELL orders */
+  int        closedWins;     /* Closed orders with profit > 0 */
+  int        closedLosses;   /* Closed orders with profit < 0 */
+  double     closedLossPips; /* Sum of |closePrice - openPrice| * lots over the closed losses */
+  int        firstOrder;     /* Lowest orderInfo index in the bucket */
+  int        firstOpenOrder; /* First open order of the bucket, -1 if there is none */
+  const int* pNextOpenOrder; /* pNextOpenOrder[i] = next open order of the bucket after order i, -1 at the end */
+} OrderHistoryDay;
+
+typedef struct orderHistoryIndex_t
+{
+  const OrderInfo* pOrders;
+  int              size;
+  int              latestOrder;             /* Order with the latest open time, first one on ties, -1 if none */
+  int              latestMarketOrder;       /* Same among the BUY and SELL orders */
+  int              latestClosedMarketOrder; /* Same among the closed BUY and SELL orders */
+  int              capacity;                /* Slots in pDays, a power of 2 */
+  OrderHistoryDay* pDays;                   /* Open addressing table keyed by day number */
+  int*             pNextOpenInDay;
+  int*             pNextOpenInDayOfYear;
+  OrderInfo*       pIndexedOrders;          /* The orders as they were last indexed */
+  OrderHistoryDay  dayOfYearTotals[ORDER_HISTORY_DAYS_OF_YEAR]; /* Orders of all years by day of year */
+} OrderHistoryIndex;
+
+/**
+* Buckets an order history by the day of the open time.
+*
+* The index refers to pOrders, which must not change while the index is in use.
+* Orders with ticket 0 are empty entries and are not indexed.
+*
+* @param OrderHistoryIndex* pIndex
+*   The index to initialize. Must be released with freeOrderHistoryIndex().
+*
+* @param const OrderInfo* pOrders
+*   The order history, e.g. StrategyParams.orderInfo.
+*
+* @param int size
+*   The number of entries in pOrders.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode initOrderHistoryIndex(OrderHistoryIndex* pIndex, const OrderInfo* pOrders, int size);
+
+/**
+* Brings an index up to date with the order history of a new call.
+*
+* The platform sends the whole order history on every call, so each order is compared with the
+* copy that was indexed. Only new orders and orders that closed since the last update are added
+* to the buckets, and the other orders cost a memcmp. The index is rebuilt when orders were removed
+* or moved, or when the size changed. A released or zeroed index is built from scratch.
+*
+* @param OrderHistoryIndex* pIndex
+*   The index to update.
+*
+* @param const OrderInfo* pOrders
+*   The order history of the current call.
+*
+* @param int size
+*   The number of entries in pOrders.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode updateOrderHistoryIndex(OrderHistoryIndex* pIndex, const OrderInfo* pOrders, int size);
+
+/**
+* Releases the memory owned by an order history index. The orders are not touched.
+*
+* @param OrderHistoryIndex* pIndex
+*   The index to release.
+*/
+void freeOrderHistoryIndex(OrderHistoryIndex* pIndex);
+
+/**
+* Finds the index which persists the order history of a strategy instance between calls.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param BOOL isCreated
+*   Creates an empty index when the instance has none. It is built by the first updateOrderHistoryIndex().
+*
+* @return OrderHistoryIndex*
+*   The index or NULL if none exists and none could be created.
+*/
+OrderHistoryIndex* getInstanceOrderHistoryIndex(int instanceId, BOOL isCreated);
+
+/**
+* Frees the index of a strategy instance and makes its slot available to other instances.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void releaseInstanceOrderHistoryIndex(int instanceId);
+
+/**
+* Finds the orders opened on the same day as a time.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the day.
+*
+* @return const OrderHistoryDay*
+*   The bucket of the day, or NULL if no order was opened that day.
+*/
+const OrderHistoryDay* findOrderHistoryDay(const OrderHistoryIndex* pIndex, time_t time);
+
+/**
+* Finds the orders opened from Monday to Friday of the week of a time.
+*
+* Days are selected the way the weekly EasyTrade queries always have: by day of year within the
+* year of the time. When the Monday falls in the previous year orders are matched by day of year
+* only, whatever their year.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the week.
+*
+* @param const OrderHistoryDay* pWeekDays[]
+*   Receives the non-empty buckets. Must hold ORDER_HISTORY_MAX_WEEK_DAYS entries.
+*
+* @return int
+*   The number of buckets written to pWeekDays.
+*/
+int findOrderHistoryWeekDays(const OrderHistoryIndex* pIndex, time_t time, const OrderHistoryDay* pWeekDays[]);
+
+/**
+* Counts the losing orders opened on the day of a time. Closed orders with a negative profit are
+* losses, open orders are losses while the price is against them.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the day.
+*
+* @param double bid
+*   The current bid price.
+*
+* @param double ask
+*   The current ask price.
+*
+* @param double* pLostPips
+*   Receives the sum of the losses in price distance times lots.
+*
+* @return int
+*   The number of losing orders.
+*/
+int getOrderHistoryLossesInDay(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask, double* pLostPips);
+
+/**
+* Counts the losing orders opened in the week of a time. Days are selected as in findOrderHistoryWeekDays().
+* Open buy losses are measured from the bid.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the week.
+*
+* @param double bid
+*   The current bid price.
+*
+* @param double ask
+*   The current ask price.
+*
+* @param double* pLostPips
+*   Receives the sum of the losses in price distance times lots.
+*
+* @return int
+*   The number of losing orders.
+*/
+int getOrderHistoryLossesInWeek(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask, double* pLostPips);
+
+/**
+* Counts the winning orders opened on the day of a time. Closed orders with a positive profit are
+* wins, open orders are wins once the price is past their take profit.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the day.
+*
+* @param double bid
+*   The current bid price.
+*
+* @param double ask
+*   The current ask price.
+*
+* @return int
+*   The number of winning orders.
+*/
+int getOrderHistoryWinsInDay(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask);
+
+/**
+* Counts the winning orders opened in the week of a time. Days are selected as in findOrderHistoryWeekDays().
+* Unlike getOrderHistoryWinsInDay() open orders without a take profit are not skipped.
+*
+* @param const OrderHistoryIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   Any time of the week.
+*
+* @param double bid
+*   The current bid price.
+*
+* @param double ask
+*   The current ask price.
+*
+* @return int
+*   The number of winning orders.
+*/
+int getOrderHistoryWinsInWeek(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ORDER_HISTORY_INDEX_H_ */
@@ -0,0 +1,158 @@
+/**
+ * @file
+ * @brief     Current day and week bars aggregated incrementally from intraday rates.
+ * @details   Each strategy instance keeps the open, high, low, close and volume of the session its latest closed bar belongs to, updated from the bars which closed since the previous run.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef SESSION_BARS_H_
+#define SESSION_BARS_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum sessionType_t
+{
+  SESSION_DAY   = 0, /* Calendar day of the bar times */
+  SESSION_WEEK  = 1, /* Sunday to Saturday, so that Sunday bars open the trading week */
+  TOTAL_SESSION_TYPES
+} SessionType;
+
+typedef struct sessionBar_t
+{
+  time_t key;        /* Day number or week number of the session */
+  time_t time;       /* Open time of the first bar of the session */
+  int    startIndex; /* Index of the first bar of the session in the source rates, -1 when there is no session */
+  int    bars;       /* Closed source bars in the session */
+  double open;
+  double high;
+  double low;
+  double close;
+  double volume;
+} SessionBar;
+
+typedef struct sessionTracker_t
+{
+  int        instanceId;
+  BOOL       isBuilt;
+  int        lastConsumedIndex; /* Index of the newest closed source bar folded into the sessions */
+  time_t     lastConsumedTime;
+  SessionBar sessions[TOTAL_SESSION_TYPES];
+} SessionTracker;
+
+/**
+* Returns the key identifying the session a time belongs to.
+*
+* @param SessionType type
+*   The kind of session.
+*
+* @param time_t time
+*   The time to evaluate.
+*
+* @return time_t
+*   The day number for SESSION_DAY or the week number for SESSION_WEEK.
+*/
+time_t getSessionKey(SessionType type, time_t time);
+
+/**
+* Initializes an empty tracker.
+*
+* @param SessionTracker* pTracker
+*   The tracker to initialize.
+*/
+void initSessionTracker(SessionTracker* pTracker);
+
+/**
+* Brings the sessions up to date with a source rates buffer.
+* Only the bars which closed since the previous update are folded in. The sessions are rebuilt by walking back from
+* the newest closed bar when the previously consumed bar is no longer in the buffer.
+* A session which started before the oldest bar of a sliding buffer keeps its aggregate and a startIndex of 0.
+* The forming bar, the last one of the buffer, is never included.
+*
+* @param SessionTracker* pTracker
+*   The tracker to update.
+*
+* @param const Rates* pSource
+*   The intraday source rates. The last bar is the forming one.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the update was successful.
+*/
+AsirikuyReturnCode updateSessionTracker(SessionTracker* pTracker, const Rates* pSource);
+
+/**
+* Returns the session the newest closed bar belongs to.
+*
+* @param const SessionTracker* pTracker
+*   The tracker to read.
+*
+* @param SessionType type
+*   The kind of session.
+*
+* @return const SessionBar*
+*   The session. Its startIndex is -1 when the source had no closed bar.
+*/
+const SessionBar* getSessionBar(const SessionTracker* pTracker, SessionType type);
+
+/**
+* Finds the tracker which persists the sessions of a strategy instance between runs.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param BOOL isCreated
+*   Creates an empty tracker when the instance has none.
+*
+* @return SessionTracker*
+*   The tracker or NULL if none exists and none could be created.
+*/
+SessionTracker* getSessionTracker(int instanceId, BOOL isCreated);
+
+/**
+* Makes the tracker of a strategy instance available to other instances.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void releaseInstanceSessionTracker(int instanceId);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SESSION_BARS_H_ */
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @brief     Shared memory segment with the live status of every strategy instance.
+ * @details   Each instance owns a fixed slot written in place under a sequence lock so that monitors in other processes can read it without locking.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef STATUS_SEGMENT_H_
+#define STATUS_SEGMENT_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#if defined _WIN32 || defined _WIN64
+  #define STATUS_SEGMENT_NAME "Local\\AsirikuyStatus"
+#else
+  #define STATUS_SEGMENT_NAME "/AsirikuyStatus"
+#endif
+
+#define STATUS_SEGMENT_MAGIC   0x54415453 /* "STAT" */
+#define STATUS_SEGMENT_VERSION 1
+#define STATUS_MAX_UI_VALUES   20
+#define STATUS_UI_NAME_SIZE    32
+#define STATUS_SYMBOL_SIZE     32
+#define STATUS_MAX_SYMBOLS     64
+
+/* The sequence is odd while the slot is being written. */
+typedef struct instanceStatus_t
+{
+  volatile int sequence;
+  volatile int owner;          /* Instance ID + 1, 0 for a free slot */
+  int          heartBeatTime;  /* Wall clock time of the latest tick */
+  int          heartBeatHour;
+  int          uiValuesCount;
+  int          reserved;
+  char         uiNames[STATUS_MAX_UI_VALUES][STATUS_UI_NAME_SIZE];
+  double       uiValues[STATUS_MAX_UI_VALUES];
+} InstanceStatus;
+
+typedef struct symbolStatus_t
+{
+  volatile int sequence;
+  volatile int state;          /* STATUS_SLOT_FREE, STATUS_SLOT_CLAIMED or STATUS_SLOT_USED */
+  int          updateTime;
+  int          reserved;
+  char         symbol[STATUS_SYMBOL_SIZE];
+  double       predictedWeeklyATR;
+  double       predictedMaxWeeklyATR;
+} SymbolStatus;
+
+#define STATUS_SLOT_FREE    0
+#define STATUS_SLOT_CLAIMED 1
+#define STATUS_SLOT_USED    2
+
+typedef struct statusSegment_t
+{
+  volatile int   magic;        /* Written last by the process creating the segment */
+  int            version;
+  int            totalInstances;
+  int            totalSymbols;
+  InstanceStatus instances[MAX_INSTANCES];
+  SymbolStatus   symbols[STATUS_MAX_SYMBOLS];
+} StatusSegment;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Maps the status segment, creating it if it doesn't exist. The mapping is shared by the whole process and kept until closeStatusSegment().
+* A segment created by another process that isn't initialized yet is retried on the next call.
+*
+* @param BOOL isCreated
+*   Set to FALSE to only open an existing segment, as monitors do.
+*
+* @return StatusSegment*
+*   The segment or NULL if it isn't available.
+*/
+StatusSegment* openStatusSegment(BOOL isCreated);
+
+/**
+* Unmaps the status segment. The segment itself remains for other processes.
+*/
+void closeStatusSegment();
+
+/**
+* Returns the slot of a strategy instance, claiming a free slot on first use.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @return InstanceStatus*
+*   The slot or NULL if the segment isn't available or full.
+*/
+InstanceStatus* getInstanceStatus(int instanceId);
+
+/**
+* Frees the slot of a strategy instance if it has one.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void releaseInstanceStatus(int instanceId);
+
+/**
+* Returns the slot of a symbol, claiming a free slot on first use.
+*
+* @param const char* pSymbol
+*   The symbol.
+*
+* @return SymbolStatus*
+*   The slot or NULL if the segment isn't available or full.
+*/
+SymbolStatus* getSymbolStatus(const char* pSymbol);
+
+/**
+* Marks the start of an in place update of a slot, waiting while another writer holds it.
+*
+* @param volatile int* pSequence
+*   The sequence of the slot.
+*/
+void beginStatusWrite(volatile int* pSequence);
+
+/**
+* Marks the end of an in place update of a slot.
+*
+* @param volatile int* pSequence
+*   The sequence of the slot.
+*/
+void endStatusWrite(volatile int* pSequence);
+
+/**
+* Copies an instance slot, retrying while it is being written.
+*
+* @param const InstanceStatus* pStatus
+*   The slot in the segment.
+*
+* @param InstanceStatus* pCopy
+*   Receives a consistent copy.
+*
+* @return BOOL
+*   FALSE if the slot kept changing and no consistent copy was made.
+*/
+BOOL readInstanceStatus(const InstanceStatus* pStatus, InstanceStatus* pCopy);
+
+/**
+* Copies a symbol slot, retrying while it is being written.
+*
+* @param const SymbolStatus* pStatus
+*   The slot in the segment.
+*
+* @param SymbolStatus* pCopy
+*   Receives a consistent copy.
+*
+* @return BOOL
+*   FALSE if the slot kept changing and no consistent copy was made.
+*/
+BOOL readSymbolStatus(const SymbolStatus* pStatus, SymbolStatus* pCopy);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* STATUS_SEGMENT_H_ */
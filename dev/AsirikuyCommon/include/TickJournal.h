@@ -0,0 +1,208 @@
+/**
+ * @file
+ * @brief     Memory mapped ring journal of the ticks received by a strategy instance.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef TICK_JOURNAL_H_
+#define TICK_JOURNAL_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TICK_JOURNAL_MAGIC   0x4B434954 /* "TICK" */
+#define TICK_JOURNAL_VERSION 1
+
+typedef struct tickRecord_t
+{
+  int    time;
+  int    reserved;
+  double bid;
+  double ask;
+} TickRecord;
+
+/* Stored at the start of the journal file and followed by capacity records. */
+typedef struct tickJournalHeader_t
+{
+  int magic;
+  int version;
+  int capacity;
+  int head;     /* Slot of the oldest record */
+  int count;
+  int reserved;
+} TickJournalHeader;
+
+typedef struct tickJournal_t
+{
+  int                instanceId;
+  TickJournalHeader* pHeader;
+  TickRecord*        pRecords;
+  size_t             mappedSize;
+  void*              hFile;    /* Windows file and mapping handles */
+  void*              hMapping;
+  int                fd;       /* POSIX file descriptor */
+} TickJournal;
+
+/**
+* Maps a journal file, creating or reinitializing it when it doesn't hold a journal of the requested capacity.
+*
+* @param TickJournal* pJournal
+*   The journal to open.
+*
+* @param const char* pPath
+*   Path of the journal file.
+*
+* @param int capacity
+*   Number of ticks kept. Older ticks are overwritten.
+*
+* @param BOOL* pIsCreated
+*   Set to TRUE if the journal was empty because the file was created or reinitialized. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the journal could be mapped.
+*/
+AsirikuyReturnCode openTickJournal(TickJournal* pJournal, const char* pPath, int capacity, BOOL* pIsCreated);
+
+/**
+* Unmaps a journal. The ticks remain in the file.
+*
+* @param TickJournal* pJournal
+*   The journal to close.
+*/
+void closeTickJournal(TickJournal* pJournal);
+
+/**
+* Removes all ticks from a journal.
+*
+* @param TickJournal* pJournal
+*   The journal to reset.
+*/
+void resetTickJournal(TickJournal* pJournal);
+
+/**
+* Appends a tick, overwriting the oldest one when the journal is full.
+*
+* @param TickJournal* pJournal
+*   The journal to append to.
+*
+* @param int time
+*   Broker time of the tick.
+*
+* @param double bid
+*   Bid price.
+*
+* @param double ask
+*   Ask price.
+*/
+void appendTickJournal(TickJournal* pJournal, int time, double bid, double ask);
+
+/**
+* Returns the number of ticks in a journal.
+*
+* @param const TickJournal* pJournal
+*   The journal.
+*
+* @return int
+*   The number of ticks.
+*/
+int getTickJournalCount(const TickJournal* pJournal);
+
+/**
+* Returns a tick directly from the mapping. Ticks are indexed from the oldest one.
+*
+* @param const TickJournal* pJournal
+*   The journal.
+*
+* @param int index
+*   Index from 0 (oldest) to getTickJournalCount() - 1 (latest).
+*
+* @return const TickRecord*
+*   The tick. Valid until it is overwritten or the journal is closed.
+*/
+const TickRecord* getTickJournalRecord(const TickJournal* pJournal, int index);
+
+/**
+* Appends the ticks of a CSV tick file written by earlier versions, one "time,bid,ask" line per tick.
+*
+* @param TickJournal* pJournal
+*   The journal to append to.
+*
+* @param const char* pCsvPath
+*   Path of the CSV file.
+*
+* @param int* pImported
+*   Set to the number of imported ticks. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the file could be read.
+*/
+AsirikuyReturnCode importTickJournalCSV(TickJournal* pJournal, const char* pCsvPath, int* pImported);
+
+/**
+* Returns the journal of a strategy instance, opening it on first use. A new journal imports the CSV tick file if one exists.
+*
+* @param int instanceId
+*   The strategy instance.
+*
+* @param const char* pPath
+*   Path of the journal file.
+*
+* @param const char* pCsvPath
+*   Path of the CSV tick file to import into a new journal.
+*
+* @param TickJournal** ppJournal
+*   Set to the journal.
+*
+* @return AsirikuyReturnCode
+*   An error code indicating if the journal is available.
+*/
+AsirikuyReturnCode getInstanceTickJournal(int instanceId, const char* pPath, const char* pCsvPath, TickJournal** ppJournal);
+
+/**
+* Closes the journal of a strategy instance if it has one.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void closeInstanceTickJournal(int instanceId);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* TICK_JOURNAL_H_ */
@@ -0,0 +1,183 @@
+/**
+ * @file
+ * @brief     Time-indexed seek over rates arrays.
+ * @details   A sparse index with one entry per calendar day is combined with a binary search inside the day
+ * @details   so locating a bar by time is O(log bars-per-day) regardless of the length of the history.
+ * @details   The index works over contiguous time_t arrays (Rates) as well as time fields embedded in
+ * @details   arrays of structures (ASTRates) by describing the time field with a base pointer, stride and width.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef TIME_INDEX_H_
+#define TIME_INDEX_H_
+#pragma once
+
+#include <stddef.h>
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct timeIndex_t
+{
+  const char* pFirstTime; /* Address of the time field of the first element */
+  size_t      stride;     /* Distance in bytes between consecutive time fields */
+  size_t      fieldSize;  /* sizeof(int) or sizeof(time_t) */
+  int         size;       /* Number of indexed elements */
+  time_t      firstDay;   /* Day number (time / SECONDS_PER_DAY) of the first element */
+  int         totalDays;  /* Number of entries in pDayStart excluding the terminating entry */
+  int*        pDayStart;  /* pDayStart[d] = index of the first element on or after day firstDay + d */
+} TimeIndex;
+
+/**
+* Builds a time index over an array of structures or a contiguous time array.
+*
+* Times must be in non-decreasing order. Duplicates and gaps (weekends, holidays, missing data)
+* are allowed. Indexing stops at the first negative time, which the tester uses to mark the end
+* of the valid data.
+*
+* @param TimeIndex* pIndex
+*   The index to initialize. Must be released with freeTimeIndex().
+*
+* @param const void* pFirstTime
+*   Address of the time field of element 0.
+*
+* @param size_t stride
+*   Distance in bytes between the time fields of consecutive elements.
+*
+* @param size_t fieldSize
+*   Width of the time field. Either sizeof(int) or sizeof(time_t).
+*
+* @param int size
+*   The number of elements in the array.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode initTimeIndex(TimeIndex* pIndex, const void* pFirstTime, size_t stride, size_t fieldSize, int size);
+
+/**
+* Builds a time index over a contiguous time_t array such as Rates.time.
+*
+* @param TimeIndex* pIndex
+*   The index to initialize. Must be released with freeTimeIndex().
+*
+* @param const time_t* pTimes
+*   The bar open times in non-decreasing order.
+*
+* @param int size
+*   The number of elements in pTimes.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode initTimeIndexFromTimes(TimeIndex* pIndex, const time_t* pTimes, int size);
+
+/**
+* Releases the memory owned by a time index. The indexed array is not touched.
+*
+* @param TimeIndex* pIndex
+*   The index to release.
+*/
+void freeTimeIndex(TimeIndex* pIndex);
+
+/**
+* Returns the time of an indexed element.
+*
+* @param const TimeIndex* pIndex
+*   An initialized index.
+*
+* @param int index
+*   The element index. Must be in [0, pIndex->size).
+*
+* @return time_t
+*   The time of the element.
+*/
+time_t timeIndexTimeAt(const TimeIndex* pIndex, int index);
+
+/**
+* Finds the first element with time >= the requested time.
+*
+* @param const TimeIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   The time to seek.
+*
+* @return int
+*   The index of the first element at or after time, or pIndex->size if there is none.
+*/
+int timeIndexLowerBound(const TimeIndex* pIndex, time_t time);
+
+/**
+* Finds the first element with time > the requested time.
+*
+* @param const TimeIndex* pIndex
+*   An initialized index.
+*
+* @param time_t time
+*   The time to seek.
+*
+* @return int
+*   The index of the first element after time, or pIndex->size if there is none.
+*/
+int timeIndexUpperBound(const TimeIndex* pIndex, time_t time);
+
+/**
+* Binary search over a contiguous time_t array without a prebuilt index.
+*
+* Used where the array changes on every bar (e.g. the rates buffers) and building a day index
+* would cost more than it saves.
+*
+* @param const time_t* pTimes
+*   The times in non-decreasing order.
+*
+* @param int size
+*   The number of elements to search.
+*
+* @param time_t time
+*   The time to seek.
+*
+* @return int
+*   The index of the first element with a time > time, or size if there is none.
+*/
+int searchTimeUpperBound(const time_t* pTimes, int size, time_t time);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* TIME_INDEX_H_ */
@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief     Hierarchical timer wheel for time-driven events.
+ * @details   Timers are scheduled once and fire only when the wheel clock passes their due time, so the cost of
+ * @details   advancing the clock does not depend on the number of pending timers. Four levels of 64 one-second
+ * @details   slots cover about 194 days, timers further away wait in an overflow list. Timer nodes are owned by the caller.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIMER_WHEEL_LEVELS    4  /* Number of wheel levels */
+#define TIMER_WHEEL_SLOT_BITS 6  /* Each level has 2^TIMER_WHEEL_SLOT_BITS slots */
+#define TIMER_WHEEL_SLOTS     (1 << TIMER_WHEEL_SLOT_BITS)
+
+typedef struct wheelTimer_t
+{
+  time_t                dueTime;  /* The time at or after which the timer fires */
+  int                   id;       /* Caller defined identifier */
+  int                   level;    /* Wheel level, TIMER_WHEEL_LEVELS for the overflow list, -1 for the expired list */
+  struct wheelTimer_t** ppHead;   /* The list the timer is linked into. NULL when not scheduled. */
+  struct wheelTimer_t*  pPrev;
+  struct wheelTimer_t*  pNext;
+} WheelTimer;
+
+typedef struct timerWheel_t
+{
+  time_t      currentTime;
+  int         totalTimers;
+  int         levelCounts[TIMER_WHEEL_LEVELS + 1]; /* The last entry counts the overflow list */
+  WheelTimer* pSlots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+  WheelTimer* pOverflow;
+  WheelTimer* pExpired;                            /* Timers scheduled at or before currentTime */
+} TimerWheel;
+
+/**
+* Called for every timer that fires. The timer is no longer scheduled when the callback runs,
+* so the callback may schedule it again.
+*/
+typedef void (*TimerWheelCallback)(WheelTimer* pTimer, void* pContext);
+
+/**
+* Initializes an empty timer wheel.
+*
+* @param TimerWheel* pWheel
+*   The wheel to initialize.
+*
+* @param time_t startTime
+*   The initial wheel time. Timers due at or before this time fire on the next advance.
+*/
+void initTimerWheel(TimerWheel* pWheel, time_t startTime);
+
+/**
+* Initializes a timer node so that it can be scheduled.
+*
+* @param WheelTimer* pTimer
+*   The timer to initialize.
+*
+* @param int id
+*   A caller defined identifier available to the callback.
+*/
+void initWheelTimer(WheelTimer* pTimer, int id);
+
+/**
+* Schedules a timer. A timer that is already scheduled is moved to the new due time.
+*
+* @param TimerWheel* pWheel
+*   The wheel.
+*
+* @param WheelTimer* pTimer
+*   The timer to schedule. Must stay valid until it fires or is cancelled.
+*
+* @param time_t dueTime
+*   The time at or after which the timer fires.
+*/
+void scheduleWheelTimer(TimerWheel* pWheel, WheelTimer* pTimer, time_t dueTime);
+
+/**
+* Cancels a timer. Cancelling a timer that is not scheduled has no effect.
+*
+* @param TimerWheel* pWheel
+*   The wheel.
+*
+* @param WheelTimer* pTimer
+*   The timer to cancel.
+*/
+void cancelWheelTimer(TimerWheel* pWheel, WheelTimer* pTimer);
+
+/**
+* Returns TRUE if the timer is waiting to fire.
+*
+* @param const WheelTimer* pTimer
+*   The timer.
+*
+* @return BOOL
+*   TRUE if the timer is scheduled.
+*/
+BOOL isWheelTimerScheduled(const WheelTimer* pTimer);
+
+/**
+* Advances the wheel clock and fires every timer due at or before the new time, in due order
+* between slots. Moving the clock backwards has no effect other than firing expired timers.
+*
+* @param TimerWheel* pWheel
+*   The wheel.
+*
+* @param time_t currentTime
+*   The new wheel time.
+*
+* @param TimerWheelCallback callback
+*   Called once for every timer that fires.
+*
+* @param void* pContext
+*   Passed to the callback.
+*
+* @return int
+*   The number of timers that fired.
+*/
+int advanceTimerWheel(TimerWheel* pWheel, time_t currentTime, TimerWheelCallback callback, void* pContext);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* TIMER_WHEEL_H_ */
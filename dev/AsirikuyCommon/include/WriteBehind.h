@@ -0,0 +1,149 @@
+/**
+ * @file
+ * @brief     Write-behind persistence of small state files.
+ * @details   Files are written by a background thread through a temporary file and a rename, so a crash never leaves a half written file.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef WRITE_BEHIND_H_
+#define WRITE_BEHIND_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#define WRITE_BEHIND_SLOTS          MAX_INSTANCES
+#define WRITE_BEHIND_TEMP_EXTENSION ".tmp"
+
+/**
+* Fault injection hook, called half way through writing a temporary file.
+*
+* @param const char* pPath
+*   Path of the file being replaced.
+*
+* @param size_t writtenBytes
+*   Bytes already written to the temporary file.
+*
+* @return BOOL
+*   FALSE abandons the write as if the process died at this point.
+*/
+typedef BOOL (*WriteBehindFault)(const char* pPath, size_t writtenBytes);
+
+typedef struct writeBehindStats_t
+{
+  int queued;
+  int coalesced; /* Queued while an older version was still waiting, so the older one was never written */
+  int writes;
+  int failures;
+} WriteBehindStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Replaces a file with new content through a temporary file and a rename.
+*
+* @param const char* pPath
+*   Path of the file.
+*
+* @param const void* pData
+*   The new content.
+*
+* @param size_t size
+*   Size of the content in bytes.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file could not be replaced. The old file is left untouched.
+*/
+AsirikuyReturnCode writeFileAtomically(const char* pPath, const void* pData, size_t size);
+
+/**
+* Copies the new content of a file and returns without writing it. The background writer replaces the file
+* with the latest content queued for the key; versions queued before it was written are skipped.
+*
+* @param int key
+*   Identifies the file, usually an instance ID.
+*
+* @param const char* pPath
+*   Path of the file.
+*
+* @param const void* pData
+*   The new content.
+*
+* @param size_t size
+*   Size of the content in bytes.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if every slot was used and the synchronous write failed.
+*/
+AsirikuyReturnCode queueWriteBehind(int key, const char* pPath, const void* pData, size_t size);
+
+/**
+* Writes the content queued for a key, if any, waits for a write in progress and forgets the key.
+* Content that could not be written is kept and retried by the next queue, flush or stop.
+*
+* @param int key
+*   The key passed to queueWriteBehind.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the queued content could not be written.
+*/
+AsirikuyReturnCode flushWriteBehind(int key);
+
+/**
+* Stops the background writer after writing everything queued. The writer starts again on the next queueWriteBehind.
+*/
+void stopWriteBehind();
+
+/**
+* Sets the fault injection hook, NULL to remove it.
+*
+* @param WriteBehindFault fault
+*   The hook.
+*/
+void setWriteBehindFault(WriteBehindFault fault);
+
+/**
+* Returns the counters since the library was loaded.
+*
+* @param WriteBehindStats* pStats
+*   Receives the counters.
+*/
+void getWriteBehindStats(WriteBehindStats* pStats);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* WRITE_BEHIND_H_ */
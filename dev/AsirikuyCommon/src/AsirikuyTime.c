@@ -39,35 +39,24 @@
 #include "Precompiled.h"
 #include "AsirikuyTime.h"
 #include "AsirikuyDefines.h"
+#include "Calendar.h"
 
 struct tm *safe_gmtime(struct tm* ptm, time_t time)
 {
-  time_t dayTime   = (time_t)(time % SECONDS_PER_DAY);
-  time_t dayNumber = (time_t)(time / SECONDS_PER_DAY);
-  int    year      = UNIX_EPOCH_YEAR;
+  CalendarDay day;
+  int         dayTime;
 
-  ptm->tm_sec      = dayTime % SECONDS_PER_MINUTE;
-  ptm->tm_min      = (dayTime % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE;
-  ptm->tm_hour     = (int)(dayTime / SECONDS_PER_HOUR);
-  ptm->tm_wday     = DAY_OF_WEEK(time);
+  getCalendarDay(&day, time);
+  dayTime = (int)(time - day.dayNumber * SECONDS_PER_DAY);
 
-  while(dayNumber >= (time_t)YEARSIZE(year)) 
-  {
-    dayNumber -= YEARSIZE(year);
-    year++;
-  }
-
-  ptm->tm_year = year - TM_EPOCH_YEAR;
-  ptm->tm_yday = (int)dayNumber;
-  ptm->tm_mon  = 0;
-
-  while(dayNumber >= (time_t)DAYS_PER_MONTH[LEAPYEAR(year)][ptm->tm_mon]) 
-  {
-    dayNumber -= DAYS_PER_MONTH[LEAPYEAR(year)][ptm->tm_mon];
-    ptm->tm_mon++;
-  }
-
-  ptm->tm_mday  = (int)dayNumber + 1;
+  ptm->tm_sec   = dayTime % SECONDS_PER_MINUTE;
+  ptm->tm_min   = (dayTime % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE;
+  ptm->tm_hour  = dayTime / SECONDS_PER_HOUR;
+  ptm->tm_mday  = day.monthDay;
+  ptm->tm_mon   = day.month;
+  ptm->tm_year  = day.year - TM_EPOCH_YEAR;
+  ptm->tm_wday  = day.dayOfWeek;
+  ptm->tm_yday  = day.dayOfYear;
   ptm->tm_isdst = 0;
 
   return ptm;
@@ -0,0 +1,386 @@
+/**
+ * @file
+ * @brief     Asynchronous logging with severity checks before argument evaluation.
+ * @details   Messages are formatted into a lock-free ring buffer and written to pantheios by a background thread.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "AsyncLog.h"
+#include <stdarg.h>
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  #include <process.h>
+  typedef HANDLE  LogWriterHandle;
+  typedef SRWLOCK LogWriterLock;
+  #define LOG_WRITER_LOCK_INIT SRWLOCK_INIT
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  #include <unistd.h>
+  typedef pthread_t       LogWriterHandle;
+  typedef pthread_mutex_t LogWriterLock;
+  #define LOG_WRITER_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#else
+  #error "Unsupported operating system"
+#endif
+
+#define RING_MASK (ASYNC_LOG_CAPACITY - 1)
+
+/* Bounded multiple producer ring. A cell with sequence == position is free for the producer claiming that position,
+ * and one with sequence == position + 1 holds a message for the consumer. The stored value is the sequence minus
+ * the cell index, so the zero initialized ring starts with every cell free and no initialization can race a producer. */
+typedef struct asyncLogCell_t
+{
+  volatile unsigned int sequence;
+  int                   severity;
+  char                  message[ASYNC_LOG_MESSAGE_SIZE];
+} AsyncLogCell;
+
+volatile int gAsyncLogSeverity = PANTHEIOS_SEV_DEBUG;
+
+static AsyncLogCell          gRing[ASYNC_LOG_CAPACITY];
+static volatile unsigned int gEnqueuePosition = 0;
+static unsigned int          gDequeuePosition = 0; /* Only touched with gConsumerLock held */
+static LogWriterLock         gConsumerLock = LOG_WRITER_LOCK_INIT;
+static LogWriterHandle       gWriter;
+static volatile int          gIsWriterRunning  = FALSE;
+static volatile int          gIsWriterStopping = FALSE;
+static volatile AsyncLogSink gSink = NULL;
+static volatile int          gQueued   = 0;
+static volatile int          gWritten  = 0;
+static volatile int          gDropped  = 0;
+static volatile int          gOverflow = 0;
+static int                   gReportedDrops = 0;
+
+static BOOL compareAndSwap(volatile unsigned int* pValue, unsigned int expected, unsigned int desired)
+{
+#if defined _WIN32 || defined _WIN64
+  return (unsigned int)InterlockedCompareExchange((volatile LONG*)pValue, (LONG)desired, (LONG)expected) == expected;
+#else
+  return __sync_bool_compare_and_swap(pValue, expected, desired);
+#endif
+}
+
+static void atomicIncrement(volatile int* pValue)
+{
+#if defined _WIN32 || defined _WIN64
+  InterlockedIncrement((volatile LONG*)pValue);
+#else
+  __sync_fetch_and_add(pValue, 1);
+#endif
+}
+
+static void memoryBarrier()
+{
+#if defined _WIN32 || defined _WIN64
+  MemoryBarrier();
+#else
+  __sync_synchronize();
+#endif
+}
+
+static void sleepWriter()
+{
+#if defined _WIN32 || defined _WIN64
+  Sleep(ASYNC_LOG_IDLE_MS);
+#else
+  usleep(ASYNC_LOG_IDLE_MS * 1000);
+#endif
+}
+
+static void lockConsumer()
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockExclusive(&gConsumerLock);
+#else
+  pthread_mutex_lock(&gConsumerLock);
+#endif
+}
+
+static void unlockConsumer()
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockExclusive(&gConsumerLock);
+#else
+  pthread_mutex_unlock(&gConsumerLock);
+#endif
+}
+
+static void writeMessage(int severity, const char* pMessage)
+{
+  AsyncLogSink sink = gSink;
+
+  if(sink != NULL)
+  {
+    sink(severity, pMessage);
+  }
+  else
+  {
+    pantheios_logputs(severity, (PAN_CHAR_T*)pMessage);
+  }
+}
+
+static void formatMessage(char* pBuffer, const char* pFormat, va_list arguments)
+{
+  vsnprintf(pBuffer, ASYNC_LOG_MESSAGE_SIZE, pFormat, arguments);
+  pBuffer[ASYNC_LOG_MESSAGE_SIZE - 1] = '\0';
+}
+
+/* Claims the next free cell. Returns NULL if the ring is full. */
+static AsyncLogCell* claimCell(unsigned int* pPosition)
+{
+  unsigned int position = gEnqueuePosition;
+
+  for(;;)
+  {
+    unsigned int  index = position & RING_MASK;
+    AsyncLogCell* pCell = &gRing[index];
+    int           difference;
+
+    memoryBarrier();
+    difference = (int)(pCell->sequence + index - position);
+
+    if(difference == 0)
+    {
+      if(compareAndSwap(&gEnqueuePosition, position, position + 1))
+      {
+        *pPosition = position;
+        return pCell;
+      }
+    }
+    else if(difference < 0)
+    {
+      return NULL;
+    }
+    position = gEnqueuePosition;
+  }
+}
+
+static void publishCell(AsyncLogCell* pCell, unsigned int position)
+{
+  memoryBarrier();
+  pCell->sequence = position + 1 - (position & RING_MASK);
+}
+
+/* Called with gConsumerLock held. Stops at the first cell whose producer hasn't published it yet. */
+static int drainRing()
+{
+  int drained = 0;
+
+  for(;;)
+  {
+    unsigned int  index = gDequeuePosition & RING_MASK;
+    AsyncLogCell* pCell = &gRing[index];
+
+    memoryBarrier();
+    if((int)(pCell->sequence + index - (gDequeuePosition + 1)) < 0)
+    {
+      break;
+    }
+
+    writeMessage(pCell->severity, pCell->message);
+    memoryBarrier();
+    pCell->sequence = gDequeuePosition + ASYNC_LOG_CAPACITY - index;
+    gDequeuePosition++;
+    atomicIncrement(&gWritten);
+    drained++;
+  }
+
+  return drained;
+}
+
+/* Only called by the writer thread, or after it was joined. */
+static void reportDrops()
+{
+  int dropped = gDropped;
+
+  if(dropped > gReportedDrops)
+  {
+    char message[ASYNC_LOG_MESSAGE_SIZE];
+    sprintf(message, "reportDrops() The log buffer was full, %d messages were dropped.", dropped - gReportedDrops);
+    writeMessage(PANTHEIOS_SEV_WARNING, message);
+    gReportedDrops = dropped;
+  }
+}
+
+static void runWriter()
+{
+  while(!gIsWriterStopping)
+  {
+    int drained;
+
+    lockConsumer();
+    drained = drainRing();
+    unlockConsumer();
+
+    reportDrops();
+    if(drained == 0)
+    {
+      sleepWriter();
+    }
+  }
+}
+
+#if defined _WIN32 || defined _WIN64
+static unsigned __stdcall writerEntry(void* pArgument)
+{
+  (void)pArgument;
+  runWriter();
+  return 0;
+}
+#else
+static void* writerEntry(void* pArgument)
+{
+  (void)pArgument;
+  runWriter();
+  return NULL;
+}
+#endif
+
+void setAsyncLogSeverity(int severity)
+{
+  gAsyncLogSeverity = severity;
+}
+
+void setAsyncLogSink(AsyncLogSink sink)
+{
+  flushAsyncLog();
+  gSink = sink;
+}
+
+BOOL startAsyncLog()
+{
+  lockConsumer();
+  if(!gIsWriterRunning)
+  {
+    gIsWriterStopping = FALSE;
+#if defined _WIN32 || defined _WIN64
+    gWriter = (HANDLE)_beginthreadex(NULL, 0, writerEntry, NULL, 0, NULL);
+    gIsWriterRunning = (gWriter != NULL);
+#else
+    gIsWriterRunning = (pthread_create(&gWriter, NULL, writerEntry, NULL) == 0);
+#endif
+
+    if(!gIsWriterRunning)
+    {
+      pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"startAsyncLog() Failed to start the log writer thread. Messages are written synchronously.");
+    }
+  }
+  unlockConsumer();
+
+  return gIsWriterRunning;
+}
+
+void stopAsyncLog()
+{
+  lockConsumer();
+  if(!gIsWriterRunning)
+  {
+    unlockConsumer();
+    return;
+  }
+  gIsWriterStopping = TRUE;
+  unlockConsumer();
+
+#if defined _WIN32 || defined _WIN64
+  WaitForSingleObject(gWriter, INFINITE);
+  CloseHandle(gWriter);
+#else
+  pthread_join(gWriter, NULL);
+#endif
+
+  lockConsumer();
+  gIsWriterRunning  = FALSE;
+  gIsWriterStopping = FALSE;
+  drainRing();
+  unlockConsumer();
+
+  reportDrops();
+}
+
+void flushAsyncLog()
+{
+  lockConsumer();
+  drainRing();
+  unlockConsumer();
+}
+
+void asyncLogPrintf(int severity, const char* pFormat, ...)
+{
+  AsyncLogCell* pCell;
+  unsigned int  position;
+  va_list       arguments;
+
+  if(!gIsWriterRunning || ((pCell = claimCell(&position)) == NULL))
+  {
+    char message[ASYNC_LOG_MESSAGE_SIZE];
+
+    if(gIsWriterRunning)
+    {
+      /* The ring is full. Never lose warnings and errors, even if they are written out of order. */
+      if(severity > PANTHEIOS_SEV_WARNING)
+      {
+        atomicIncrement(&gDropped);
+        return;
+      }
+      atomicIncrement(&gOverflow);
+    }
+
+    va_start(arguments, pFormat);
+    formatMessage(message, pFormat, arguments);
+    va_end(arguments);
+    writeMessage(severity, message);
+    return;
+  }
+
+  pCell->severity = severity;
+  va_start(arguments, pFormat);
+  formatMessage(pCell->message, pFormat, arguments);
+  va_end(arguments);
+  publishCell(pCell, position);
+  atomicIncrement(&gQueued);
+}
+
+void asyncLogPuts(int severity, const char* pMessage)
+{
+  asyncLogPrintf(severity, "%s", pMessage);
+}
+
+void getAsyncLogStats(AsyncLogStats* pStats)
+{
+  memoryBarrier();
+  pStats->queued   = gQueued;
+  pStats->written  = gWritten;
+  pStats->dropped  = gDropped;
+  pStats->overflow = gOverflow;
+}
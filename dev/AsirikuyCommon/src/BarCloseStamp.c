@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief     Detects bar close events on rates buffers.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "BarCloseStamp.h"
+#include "CriticalSection.h"
+
+void invalidateBarCloseStamp(BarCloseStamp* pStamp)
+{
+  pStamp->isValid = FALSE;
+}
+
+BOOL isBarCloseStampCurrent(const Rates* pRates, int variant, const BarCloseStamp* pStamp)
+{
+  int shift0Index = pRates->info.arraySize - 1;
+  int shift1Index = pRates->info.arraySize - 2;
+
+  if(!pStamp->isValid || (shift1Index < 0))
+  {
+    return FALSE;
+  }
+
+  return (pStamp->variant == variant)
+    && (pStamp->arraySize == pRates->info.arraySize)
+    && (pStamp->openTime == pRates->time[shift0Index])
+    && (pStamp->lastClosedTime == pRates->time[shift1Index])
+    && (pStamp->lastClosedHigh == pRates->high[shift1Index])
+    && (pStamp->lastClosedLow == pRates->low[shift1Index])
+    && (pStamp->lastClosedClose == pRates->close[shift1Index]);
+}
+
+void setBarCloseStamp(const Rates* pRates, int variant, BarCloseStamp* pStamp)
+{
+  int shift0Index = pRates->info.arraySize - 1;
+  int shift1Index = pRates->info.arraySize - 2;
+
+  if(shift1Index < 0)
+  {
+    pStamp->isValid = FALSE;
+    return;
+  }
+
+  pStamp->isValid         = TRUE;
+  pStamp->variant         = variant;
+  pStamp->arraySize       = pRates->info.arraySize;
+  pStamp->openTime        = pRates->time[shift0Index];
+  pStamp->lastClosedTime  = pRates->time[shift1Index];
+  pStamp->lastClosedHigh  = pRates->high[shift1Index];
+  pStamp->lastClosedLow   = pRates->low[shift1Index];
+  pStamp->lastClosedClose = pRates->close[shift1Index];
+}
+
+int claimInstanceStampSlot(int* pOwners, int instanceId, BOOL* pIsClaimed)
+{
+  int owner = instanceId + 1, index = -1, i;
+
+  *pIsClaimed = FALSE;
+
+  enterCriticalSection();
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(pOwners[i] == owner)
+    {
+      index = i;
+      break;
+    }
+    if((index < 0) && (pOwners[i] == 0))
+    {
+      index = i;
+    }
+  }
+
+  if((index >= 0) && (pOwners[index] != owner))
+  {
+    pOwners[index] = owner;
+    *pIsClaimed    = TRUE;
+  }
+
+  leaveCriticalSection();
+
+  return index;
+}
+
+int releaseInstanceStampSlot(int* pOwners, int instanceId)
+{
+  int owner = instanceId + 1, index = -1, i;
+
+  enterCriticalSection();
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(pOwners[i] == owner)
+    {
+      pOwners[i] = 0;
+      index      = i;
+      break;
+    }
+  }
+
+  leaveCriticalSection();
+
+  return index;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file
+ * @brief     Bar history files in the binary bar format or the csv layouts written by RecordBars and exported by MetaTrader.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "BarFile.h"
+#include "Calendar.h"
+
+#define INITIAL_SERIES_CAPACITY 1024
+#define MAX_BAR_LINE_SIZE       256
+
+static BOOL growBarSeries(BarSeries* pSeries)
+{
+  int     capacity = (pSeries->capacity > 0) ? 2 * pSeries->capacity : INITIAL_SERIES_CAPACITY;
+  time_t* pTime    = (time_t*)realloc(pSeries->time, capacity * sizeof(time_t));
+  double* pArrays[5];
+  double** ppTargets[5];
+  int i;
+
+  if(pTime == NULL)
+  {
+    return FALSE;
+  }
+  pSeries->time = pTime;
+
+  ppTargets[0] = &pSeries->open;
+  ppTargets[1] = &pSeries->high;
+  ppTargets[2] = &pSeries->low;
+  ppTargets[3] = &pSeries->close;
+  ppTargets[4] = &pSeries->volume;
+
+  for(i = 0; i < 5; i++)
+  {
+    pArrays[i] = (double*)realloc(*ppTargets[i], capacity * sizeof(double));
+    if(pArrays[i] == NULL)
+    {
+      return FALSE;
+    }
+    *ppTargets[i] = pArrays[i];
+  }
+
+  pSeries->capacity = capacity;
+  return TRUE;
+}
+
+static time_t utcTime(int year, int month, int monthDay, int hour, int minute)
+{
+  return daysFromCivil(year, month, monthDay) * 86400 + hour * 3600 + minute * 60;
+}
+
+void initBarSeries(BarSeries* pSeries)
+{
+  memset(pSeries, 0, sizeof(BarSeries));
+}
+
+void freeBarSeries(BarSeries* pSeries)
+{
+  free(pSeries->time);
+  free(pSeries->open);
+  free(pSeries->high);
+  free(pSeries->low);
+  free(pSeries->close);
+  free(pSeries->volume);
+  initBarSeries(pSeries);
+}
+
+AsirikuyReturnCode appendBarToSeries(BarSeries* pSeries, const BarRecord* pBar)
+{
+  if(pSeries->size == pSeries->capacity && !growBarSeries(pSeries))
+  {
+    return INSUFFICIENT_MEMORY;
+  }
+
+  pSeries->time[pSeries->size]   = (time_t)pBar->time;
+  pSeries->open[pSeries->size]   = pBar->open;
+  pSeries->high[pSeries->size]   = pBar->high;
+  pSeries->low[pSeries->size]    = pBar->low;
+  pSeries->close[pSeries->size]  = pBar->close;
+  pSeries->volume[pSeries->size] = pBar->volume;
+  pSeries->size++;
+
+  return SUCCESS;
+}
+
+BOOL parseBarLine(const char* line, BarRecord* pBar)
+{
+  int year, month, monthDay, hour = 0, minute = 0, epoch;
+  int consumed = 0;
+
+  memset(pBar, 0, sizeof(BarRecord));
+
+  while(*line == ' ' || *line == '\t')
+  {
+    line++;
+  }
+
+  if(sscanf(line, "%d.%d.%d,%d:%d,%n", &year, &month, &monthDay, &hour, &minute, &consumed) == 5 && consumed > 0)
+  {
+    pBar->time = (int)utcTime(year, month, monthDay, hour, minute);
+  }
+  else if(sscanf(line, "%d/%d/%d %d:%d ,%n", &monthDay, &month, &year, &hour, &minute, &consumed) == 5 && consumed > 0)
+  {
+    pBar->time = (int)utcTime((year < 100) ? 2000 + year : year, month, monthDay, hour, minute);
+  }
+  else if(sscanf(line, "%d-%d-%d ,%n", &year, &month, &monthDay, &consumed) == 3 && consumed > 0)
+  {
+    pBar->time = (int)utcTime(year, month, monthDay, 0, 0);
+  }
+  else if(sscanf(line, "%d ,%n", &epoch, &consumed) == 1 && consumed > 0)
+  {
+    pBar->time = epoch;
+  }
+  else
+  {
+    return FALSE;
+  }
+
+  return sscanf(line + consumed, "%lf ,%lf ,%lf ,%lf ,%lf", &pBar->open, &pBar->high, &pBar->low, &pBar->close, &pBar->volume) >= 4;
+}
+
+AsirikuyReturnCode loadBarFile(const char* filePath, BarSeries* pSeries)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+  BarFileHeader header;
+  BarRecord     bar;
+  char          line[MAX_BAR_LINE_SIZE];
+  FILE*         fp = fopen(filePath, "rb");
+
+  if(fp == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadBarFile() failed to open %s", filePath);
+    return ERROR_IN_RATES_RETRIEVAL;
+  }
+
+  if(fread(&header, sizeof(BarFileHeader), 1, fp) == 1 && header.magic == BAR_FILE_MAGIC)
+  {
+    if(header.version != BAR_FILE_VERSION)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadBarFile() %s has unsupported version %d", filePath, header.version);
+      fclose(fp);
+      return ERROR_IN_RATES_RETRIEVAL;
+    }
+
+    pSeries->timeframe = header.timeframe;
+    while(returnCode == SUCCESS && fread(&bar, sizeof(BarRecord), 1, fp) == 1)
+    {
+      returnCode = appendBarToSeries(pSeries, &bar);
+    }
+  }
+  else
+  {
+    rewind(fp);
+    while(returnCode == SUCCESS && fgets(line, sizeof(line), fp) != NULL)
+    {
+      if(parseBarLine(line, &bar))
+      {
+        returnCode = appendBarToSeries(pSeries, &bar);
+      }
+    }
+  }
+
+  fclose(fp);
+
+  if(returnCode != SUCCESS)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadBarFile() ran out of memory loading %s", filePath);
+  }
+
+  return returnCode;
+}
+
+AsirikuyReturnCode saveBarFile(const char* filePath, const BarSeries* pSeries)
+{
+  BarFileHeader header;
+  BarRecord     bar;
+  BOOL          isWritten;
+  FILE*         fp = fopen(filePath, "wb");
+  int i;
+
+  if(fp == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"saveBarFile() failed to create %s", filePath);
+    return FILE_WRITING_ERROR;
+  }
+
+  memset(&header, 0, sizeof(BarFileHeader));
+  header.magic     = BAR_FILE_MAGIC;
+  header.version   = BAR_FILE_VERSION;
+  header.timeframe = pSeries->timeframe;
+  isWritten = fwrite(&header, sizeof(BarFileHeader), 1, fp) == 1;
+
+  memset(&bar, 0, sizeof(BarRecord));
+  for(i = 0; isWritten && i < pSeries->size; i++)
+  {
+    bar.time   = (int)pSeries->time[i];
+    bar.open   = pSeries->open[i];
+    bar.high   = pSeries->high[i];
+    bar.low    = pSeries->low[i];
+    bar.close  = pSeries->close[i];
+    bar.volume = pSeries->volume[i];
+    isWritten  = fwrite(&bar, sizeof(BarRecord), 1, fp) == 1;
+  }
+
+  if(fclose(fp) != 0 || !isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"saveBarFile() failed to write %s", filePath);
+    return FILE_WRITING_ERROR;
+  }
+
+  return SUCCESS;
+}
@@ -0,0 +1,652 @@
+/**
+ * @file
+ * @brief     Buffered binary bar recorder.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "BarRecorder.h"
+#include "AsirikuyTime.h"
+#include "CriticalSection.h"
+
+#define SECONDS_PER_DAY 86400
+
+static int dayStart(int time)
+{
+  return time - time % SECONDS_PER_DAY;
+}
+
+static BOOL getIndexPath(const char* pPath, char indexPath[MAX_FILE_PATH_CHARS])
+{
+  if(strlen(pPath) + strlen(BAR_INDEX_EXTENSION) >= MAX_FILE_PATH_CHARS)
+  {
+    return FALSE;
+  }
+
+  strcpy(indexPath, pPath);
+  strcat(indexPath, BAR_INDEX_EXTENSION);
+  return TRUE;
+}
+
+static BOOL isBarFileHeaderValid(const BarFileHeader* pHeader)
+{
+  return (pHeader->magic == BAR_FILE_MAGIC) && (pHeader->version == BAR_FILE_VERSION);
+}
+
+/* Returns the number of complete records in an open bar file. A record cut short by a crash is not counted. */
+static int countBarRecords(FILE* pBarFile)
+{
+  long size;
+
+  fseek(pBarFile, 0, SEEK_END);
+  size = ftell(pBarFile);
+  if(size < (long)sizeof(BarFileHeader))
+  {
+    return 0;
+  }
+
+  return (int)((size - (long)sizeof(BarFileHeader)) / (long)sizeof(BarRecord));
+}
+
+static BOOL readBarRecord(FILE* pBarFile, int record, BarRecord* pBar)
+{
+  return (fseek(pBarFile, (long)(sizeof(BarFileHeader) + (size_t)record * sizeof(BarRecord)), SEEK_SET) == 0)
+    && (fread(pBar, sizeof(BarRecord), 1, pBarFile) == 1);
+}
+
+/* Writes an index entry for the first bar of every day of an open bar file. */
+static BOOL writeBarIndex(FILE* pBarFile, int totalBars, const char* pIndexPath, int* pTotalDays)
+{
+  BarIndexEntry entry;
+  BarRecord     bar;
+  BOOL          isWritten = TRUE;
+  FILE*         pIndexFile = fopen(pIndexPath, "wb");
+  int i;
+
+  *pTotalDays = 0;
+
+  if(pIndexFile == NULL)
+  {
+    return FALSE;
+  }
+
+  entry.dayTime = 0;
+  for(i = 0; isWritten && i < totalBars; i++)
+  {
+    isWritten = (i > 0 || fseek(pBarFile, (long)sizeof(BarFileHeader), SEEK_SET) == 0)
+      && (fread(&bar, sizeof(BarRecord), 1, pBarFile) == 1);
+
+    if(isWritten && ((i == 0) || (dayStart(bar.time) != entry.dayTime)))
+    {
+      entry.dayTime     = dayStart(bar.time);
+      entry.firstRecord = i;
+      isWritten = fwrite(&entry, sizeof(BarIndexEntry), 1, pIndexFile) == 1;
+      (*pTotalDays)++;
+    }
+  }
+
+  return (fclose(pIndexFile) == 0) && isWritten;
+}
+
+/* Checks that an index ends with the day of the latest bar. An index left behind by a crash lags the bar file. */
+static BOOL isBarIndexValid(const char* pIndexPath, int totalBars, int lastDayTime, int* pTotalDays)
+{
+  BarIndexEntry entry;
+  long          size;
+  BOOL          isValid;
+  FILE*         pIndexFile = fopen(pIndexPath, "rb");
+
+  *pTotalDays = 0;
+
+  if(pIndexFile == NULL)
+  {
+    return FALSE;
+  }
+
+  fseek(pIndexFile, 0, SEEK_END);
+  size = ftell(pIndexFile);
+  isValid = (size % (long)sizeof(BarIndexEntry)) == 0;
+
+  if(isValid && (size > 0))
+  {
+    isValid = (fseek(pIndexFile, size - (long)sizeof(BarIndexEntry), SEEK_SET) == 0)
+      && (fread(&entry, sizeof(BarIndexEntry), 1, pIndexFile) == 1)
+      && (entry.dayTime == lastDayTime)
+      && (entry.firstRecord < totalBars);
+  }
+  else if(isValid)
+  {
+    isValid = totalBars == 0;
+  }
+
+  fclose(pIndexFile);
+
+  *pTotalDays = (int)(size / (long)sizeof(BarIndexEntry));
+  return isValid;
+}
+
+static void importBarCsv(BarRecorder* pRecorder, const char* pCsvPath)
+{
+  BarSeries series;
+  BarRecord bar;
+  FILE*     fp = fopen(pCsvPath, "r");
+  int i;
+
+  if(fp == NULL)
+  {
+    /* Nothing to import. */
+    return;
+  }
+  fclose(fp);
+
+  initBarSeries(&series);
+  if(loadBarFile(pCsvPath, &series) == SUCCESS)
+  {
+    memset(&bar, 0, sizeof(BarRecord));
+    for(i = 0; i < series.size; i++)
+    {
+      bar.time   = (int)series.time[i];
+      bar.open   = series.open[i];
+      bar.high   = series.high[i];
+      bar.low    = series.low[i];
+      bar.close  = series.close[i];
+      bar.volume = series.volume[i];
+      appendBarRecorder(pRecorder, &bar);
+    }
+    flushBarRecorder(pRecorder);
+
+    pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"openBarRecorder() Imported %d bars from %s.", getBarRecorderCount(pRecorder), pCsvPath);
+  }
+  freeBarSeries(&series);
+}
+
+AsirikuyReturnCode openBarRecorder(BarRecorder* pRecorder, const char* pPath, int timeframe, const char* pCsvPath)
+{
+  BarFileHeader header;
+  BarRecord     bar;
+  BOOL          isCreated = FALSE;
+  char          indexPath[MAX_FILE_PATH_CHARS];
+
+  memset(pRecorder, 0, sizeof(BarRecorder));
+  pRecorder->instanceId    = -1;
+  pRecorder->exportLayout  = BAR_TEXT_NONE;
+  pRecorder->lastFlushTime = time(NULL);
+
+  if(!getIndexPath(pPath, indexPath))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openBarRecorder() Path too long %s.", pPath);
+    return INVALID_PARAMETER;
+  }
+  strcpy(pRecorder->path, pPath);
+
+  pRecorder->pBarFile = fopen(pPath, "r+b");
+  if(pRecorder->pBarFile == NULL)
+  {
+    memset(&header, 0, sizeof(BarFileHeader));
+    header.magic     = BAR_FILE_MAGIC;
+    header.version   = BAR_FILE_VERSION;
+    header.timeframe = timeframe;
+
+    pRecorder->pBarFile = fopen(pPath, "w+b");
+    if((pRecorder->pBarFile == NULL) || (fwrite(&header, sizeof(BarFileHeader), 1, pRecorder->pBarFile) != 1) || (fflush(pRecorder->pBarFile) != 0))
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openBarRecorder() Failed to create %s.", pPath);
+      closeBarRecorder(pRecorder);
+      return FILE_WRITING_ERROR;
+    }
+    isCreated = TRUE;
+  }
+  else if((fread(&header, sizeof(BarFileHeader), 1, pRecorder->pBarFile) != 1) || !isBarFileHeaderValid(&header))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openBarRecorder() %s is not a bar file.", pPath);
+    closeBarRecorder(pRecorder);
+    return FILE_WRITING_ERROR;
+  }
+
+  pRecorder->writtenBars = countBarRecords(pRecorder->pBarFile);
+  if((pRecorder->writtenBars > 0) && readBarRecord(pRecorder->pBarFile, pRecorder->writtenBars - 1, &bar))
+  {
+    pRecorder->lastTime    = bar.time;
+    pRecorder->lastDayTime = dayStart(bar.time);
+  }
+
+  if(!isBarIndexValid(indexPath, pRecorder->writtenBars, pRecorder->lastDayTime, &pRecorder->writtenDays))
+  {
+    if(pRecorder->writtenBars > 0)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"openBarRecorder() Rebuilding bar index %s.", indexPath);
+    }
+    if(!writeBarIndex(pRecorder->pBarFile, pRecorder->writtenBars, indexPath, &pRecorder->writtenDays))
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openBarRecorder() Failed to write bar index %s.", indexPath);
+      closeBarRecorder(pRecorder);
+      return FILE_WRITING_ERROR;
+    }
+  }
+
+  pRecorder->pIndexFile = fopen(indexPath, "ab");
+  if(pRecorder->pIndexFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openBarRecorder() Failed to open bar index %s.", indexPath);
+    closeBarRecorder(pRecorder);
+    return FILE_WRITING_ERROR;
+  }
+
+  if(isCreated && (pCsvPath != NULL))
+  {
+    importBarCsv(pRecorder, pCsvPath);
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode appendBarRecorder(BarRecorder* pRecorder, const BarRecord* pBar)
+{
+  AsirikuyReturnCode returnCode;
+  int day = dayStart(pBar->time);
+
+  if((getBarRecorderCount(pRecorder) > 0) && (pBar->time <= pRecorder->lastTime))
+  {
+    return SUCCESS;
+  }
+
+  /* A failed write leaves the buffer full, so retry it before buffering more. */
+  if(pRecorder->bufferedBars == BAR_RECORDER_BUFFER_SIZE)
+  {
+    returnCode = flushBarRecorder(pRecorder);
+    if(returnCode != SUCCESS)
+    {
+      return returnCode;
+    }
+  }
+
+  if((getBarRecorderCount(pRecorder) == 0) || (day != pRecorder->lastDayTime))
+  {
+    pRecorder->days[pRecorder->bufferedDays].dayTime     = day;
+    pRecorder->days[pRecorder->bufferedDays].firstRecord = getBarRecorderCount(pRecorder);
+    pRecorder->bufferedDays++;
+    pRecorder->lastDayTime = day;
+  }
+
+  pRecorder->bars[pRecorder->bufferedBars] = *pBar;
+  pRecorder->bars[pRecorder->bufferedBars].reserved = 0;
+  pRecorder->bufferedBars++;
+  pRecorder->lastTime = pBar->time;
+
+  /* Live bars are usually further apart than the flush interval and get written straight away, backtests fill the buffer. */
+  if((pRecorder->bufferedBars == BAR_RECORDER_BUFFER_SIZE) || (time(NULL) - pRecorder->lastFlushTime >= BAR_RECORDER_FLUSH_SECONDS))
+  {
+    return flushBarRecorder(pRecorder);
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode flushBarRecorder(BarRecorder* pRecorder)
+{
+  long offset = (long)(sizeof(BarFileHeader) + (size_t)pRecorder->writtenBars * sizeof(BarRecord));
+
+  pRecorder->lastFlushTime = time(NULL);
+
+  /* Bars are written before the index entries that point at them. */
+  if(pRecorder->bufferedBars > 0)
+  {
+    if((fseek(pRecorder->pBarFile, offset, SEEK_SET) != 0)
+      || (fwrite(pRecorder->bars, sizeof(BarRecord), pRecorder->bufferedBars, pRecorder->pBarFile) != (size_t)pRecorder->bufferedBars)
+      || (fflush(pRecorder->pBarFile) != 0))
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"flushBarRecorder() Failed to write %d bars to %s.", pRecorder->bufferedBars, pRecorder->path);
+      return FILE_WRITING_ERROR;
+    }
+    pRecorder->writtenBars += pRecorder->bufferedBars;
+    pRecorder->bufferedBars = 0;
+  }
+
+  if(pRecorder->bufferedDays > 0)
+  {
+    if((fwrite(pRecorder->days, sizeof(BarIndexEntry), pRecorder->bufferedDays, pRecorder->pIndexFile) != (size_t)pRecorder->bufferedDays)
+      || (fflush(pRecorder->pIndexFile) != 0))
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"flushBarRecorder() Failed to write the index of %s.", pRecorder->path);
+      return FILE_WRITING_ERROR;
+    }
+    pRecorder->writtenDays += pRecorder->bufferedDays;
+    pRecorder->bufferedDays = 0;
+  }
+
+  return SUCCESS;
+}
+
+void closeBarRecorder(BarRecorder* pRecorder)
+{
+  if((pRecorder->pBarFile != NULL) && (pRecorder->pIndexFile != NULL))
+  {
+    flushBarRecorder(pRecorder);
+  }
+  if(pRecorder->pBarFile != NULL)
+  {
+    fclose(pRecorder->pBarFile);
+  }
+  if(pRecorder->pIndexFile != NULL)
+  {
+    fclose(pRecorder->pIndexFile);
+  }
+
+  pRecorder->pBarFile     = NULL;
+  pRecorder->pIndexFile   = NULL;
+  pRecorder->bufferedBars = 0;
+  pRecorder->bufferedDays = 0;
+  pRecorder->instanceId   = -1;
+}
+
+int getBarRecorderCount(const BarRecorder* pRecorder)
+{
+  return pRecorder->writtenBars + pRecorder->bufferedBars;
+}
+
+AsirikuyReturnCode rebuildBarFileIndex(const char* pPath)
+{
+  BarFileHeader header;
+  char          indexPath[MAX_FILE_PATH_CHARS];
+  BOOL          isWritten;
+  int           totalDays;
+  FILE*         pBarFile;
+
+  if(!getIndexPath(pPath, indexPath))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"rebuildBarFileIndex() Path too long %s.", pPath);
+    return INVALID_PARAMETER;
+  }
+
+  pBarFile = fopen(pPath, "rb");
+  if((pBarFile == NULL) || (fread(&header, sizeof(BarFileHeader), 1, pBarFile) != 1) || !isBarFileHeaderValid(&header))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"rebuildBarFileIndex() Failed to read bar file %s.", pPath);
+    if(pBarFile != NULL)
+    {
+      fclose(pBarFile);
+    }
+    return ERROR_IN_RATES_RETRIEVAL;
+  }
+
+  isWritten = writeBarIndex(pBarFile, countBarRecords(pBarFile), indexPath, &totalDays);
+  fclose(pBarFile);
+
+  if(!isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"rebuildBarFileIndex() Failed to write bar index %s.", indexPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  return SUCCESS;
+}
+
+/* Returns the record of the first bar of the day containing fromTime, or 0 if the index can't tell. */
+static int findFirstBarRecord(const char* pPath, time_t fromTime, int totalBars)
+{
+  BarIndexEntry* pEntries;
+  char           indexPath[MAX_FILE_PATH_CHARS];
+  long           size;
+  int            totalDays, low, high, firstRecord = 0;
+  FILE*          pIndexFile;
+
+  if((fromTime <= 0) || !getIndexPath(pPath, indexPath) || ((pIndexFile = fopen(indexPath, "rb")) == NULL))
+  {
+    return 0;
+  }
+
+  fseek(pIndexFile, 0, SEEK_END);
+  size      = ftell(pIndexFile);
+  totalDays = (int)(size / (long)sizeof(BarIndexEntry));
+  pEntries  = (totalDays > 0) ? (BarIndexEntry*)malloc(totalDays * sizeof(BarIndexEntry)) : NULL;
+
+  rewind(pIndexFile);
+  if((pEntries != NULL) && (fread(pEntries, sizeof(BarIndexEntry), totalDays, pIndexFile) == (size_t)totalDays))
+  {
+    /* Last day starting at or before fromTime. */
+    low  = 0;
+    high = totalDays - 1;
+    while(low <= high)
+    {
+      int middle = low + (high - low) / 2;
+      if((time_t)pEntries[middle].dayTime <= fromTime)
+      {
+        firstRecord = pEntries[middle].firstRecord;
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle - 1;
+      }
+    }
+  }
+
+  free(pEntries);
+  fclose(pIndexFile);
+
+  return (firstRecord < totalBars) ? firstRecord : 0;
+}
+
+static BOOL writeBarText(FILE* pTextFile, const BarRecord* pBar, BarTextLayout layout)
+{
+  char      timeString[MAX_TIME_STRING_SIZE] = "";
+  struct tm timeInfo;
+
+  safe_gmtime(&timeInfo, (time_t)pBar->time);
+
+  switch(layout)
+  {
+  case BAR_TEXT_DATE_AS_INTEGER:
+    return fprintf(pTextFile, "%d, %lf, %lf, %lf, %lf, %lf\n", pBar->time, pBar->open, pBar->high, pBar->low, pBar->close, pBar->volume) > 0;
+  case BAR_TEXT_DATE_AS_STRING:
+    strftime(timeString, MAX_TIME_STRING_SIZE - 1, " %d/%m/%y %H:%M", &timeInfo);
+    break;
+  case BAR_TEXT_DATE_FOR_R:
+    strftime(timeString, MAX_TIME_STRING_SIZE - 1, " %Y-%m-%d", &timeInfo);
+    break;
+  default:
+    return FALSE;
+  }
+
+  return fprintf(pTextFile, "%s, %lf, %lf, %lf, %lf, %lf\n", timeString, pBar->open, pBar->high, pBar->low, pBar->close, pBar->volume) > 0;
+}
+
+AsirikuyReturnCode exportBarFileText(const char* pPath, const char* pTextPath, BarTextLayout layout, time_t fromTime, time_t toTime, int* pExported)
+{
+  BarFileHeader header;
+  BarRecord     bar;
+  BOOL          isWritten = TRUE;
+  FILE*         pBarFile;
+  FILE*         pTextFile;
+  int           totalBars, i, exported = 0;
+
+  if(pExported != NULL)
+  {
+    *pExported = 0;
+  }
+
+  if((layout < BAR_TEXT_DATE_AS_INTEGER) || (layout > BAR_TEXT_DATE_FOR_R))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"exportBarFileText() Invalid layout %d.", (int)layout);
+    return INVALID_PARAMETER;
+  }
+
+  pBarFile = fopen(pPath, "rb");
+  if((pBarFile == NULL) || (fread(&header, sizeof(BarFileHeader), 1, pBarFile) != 1) || !isBarFileHeaderValid(&header))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"exportBarFileText() Failed to read bar file %s.", pPath);
+    if(pBarFile != NULL)
+    {
+      fclose(pBarFile);
+    }
+    return ERROR_IN_RATES_RETRIEVAL;
+  }
+
+  pTextFile = fopen(pTextPath, "w");
+  if(pTextFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"exportBarFileText() Failed to create %s.", pTextPath);
+    fclose(pBarFile);
+    return FILE_WRITING_ERROR;
+  }
+
+  totalBars = countBarRecords(pBarFile);
+  i = findFirstBarRecord(pPath, fromTime, totalBars);
+  fseek(pBarFile, (long)(sizeof(BarFileHeader) + (size_t)i * sizeof(BarRecord)), SEEK_SET);
+
+  for(; isWritten && i < totalBars && fread(&bar, sizeof(BarRecord), 1, pBarFile) == 1; i++)
+  {
+    if((time_t)bar.time < fromTime)
+    {
+      continue;
+    }
+    if((toTime > 0) && ((time_t)bar.time > toTime))
+    {
+      break;
+    }
+
+    isWritten = writeBarText(pTextFile, &bar, layout);
+    exported++;
+  }
+
+  fclose(pBarFile);
+  if((fclose(pTextFile) != 0) || !isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"exportBarFileText() Failed to write %s.", pTextPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  if(pExported != NULL)
+  {
+    *pExported = exported;
+  }
+
+  return SUCCESS;
+}
+
+static BarRecorder gBarRecorders[MAX_INSTANCES];
+static BOOL        gBarRecordersInitialized = FALSE;
+
+AsirikuyReturnCode getInstanceBarRecorder(int instanceId, const char* pPath, int timeframe, const char* pCsvPath, BarTextLayout exportLayout, BarRecorder** ppRecorder)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+  BarRecorder*       pRecorder = NULL;
+  int                i;
+
+  *ppRecorder = NULL;
+
+  enterCriticalSection();
+
+  if(!gBarRecordersInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      gBarRecorders[i].instanceId = -1;
+    }
+    gBarRecordersInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gBarRecorders[i].instanceId == instanceId)
+    {
+      *ppRecorder = &gBarRecorders[i];
+      leaveCriticalSection();
+      return SUCCESS;
+    }
+
+    if((pRecorder == NULL) && (gBarRecorders[i].instanceId == -1))
+    {
+      pRecorder = &gBarRecorders[i];
+    }
+  }
+
+  if(pRecorder == NULL)
+  {
+    leaveCriticalSection();
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getInstanceBarRecorder() No free bar recorder for instance %d.", instanceId);
+    return TOO_MANY_INSTANCES;
+  }
+
+  if((pCsvPath != NULL) && (strlen(pCsvPath) >= MAX_FILE_PATH_CHARS))
+  {
+    leaveCriticalSection();
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getInstanceBarRecorder() Path too long %s.", pCsvPath);
+    return INVALID_PARAMETER;
+  }
+
+  returnCode = openBarRecorder(pRecorder, pPath, timeframe, pCsvPath);
+  if(returnCode == SUCCESS)
+  {
+    pRecorder->instanceId   = instanceId;
+    pRecorder->exportLayout = (pCsvPath != NULL) ? exportLayout : BAR_TEXT_NONE;
+    if(pCsvPath != NULL)
+    {
+      strcpy(pRecorder->exportPath, pCsvPath);
+    }
+    *ppRecorder = pRecorder;
+  }
+
+  leaveCriticalSection();
+
+  return returnCode;
+}
+
+void closeInstanceBarRecorder(int instanceId)
+{
+  BarTextLayout exportLayout = BAR_TEXT_NONE;
+  char          path[MAX_FILE_PATH_CHARS];
+  char          exportPath[MAX_FILE_PATH_CHARS];
+  int           i;
+
+  enterCriticalSection();
+
+  for(i = 0; gBarRecordersInitialized && (i < MAX_INSTANCES); i++)
+  {
+    if(gBarRecorders[i].instanceId == instanceId)
+    {
+      exportLayout = gBarRecorders[i].exportLayout;
+      strcpy(path, gBarRecorders[i].path);
+      strcpy(exportPath, gBarRecorders[i].exportPath);
+      closeBarRecorder(&gBarRecorders[i]);
+      break;
+    }
+  }
+
+  leaveCriticalSection();
+
+  /* The text file is only written on close so bars aren't formatted and appended one file open at a time. */
+  if(exportLayout != BAR_TEXT_NONE)
+  {
+    exportBarFileText(path, exportPath, exportLayout, 0, 0, NULL);
+  }
+}
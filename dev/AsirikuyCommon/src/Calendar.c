@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief     Calendar decomposition of time_t values with a per-thread day cache.
+ * @details   Date conversions use the days from civil and civil from days algorithms by Howard Hinnant.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "Calendar.h"
+
+#if defined _MSC_VER
+  #define CALENDAR_THREAD_LOCAL __declspec(thread)
+#else
+  #define CALENDAR_THREAD_LOCAL __thread
+#endif
+
+#define DAYS_PER_ERA          146097 /* Days in 400 Gregorian years */
+#define EPOCH_ERA_DAY_OFFSET  719468 /* Days from 01/03/0000 to 01/01/1970 */
+#define CACHE_MASK            (CALENDAR_CACHE_SIZE - 1)
+
+typedef struct calendarCacheEntry_t
+{
+  BOOL        isValid;
+  CalendarDay day;
+} CalendarCacheEntry;
+
+static CALENDAR_THREAD_LOCAL CalendarCacheEntry gCalendarCache[CALENDAR_CACHE_SIZE];
+
+static time_t floorDayNumber(time_t time)
+{
+  time_t dayNumber = time / SECONDS_PER_DAY;
+  return dayNumber - ((time % SECONDS_PER_DAY) < 0);
+}
+
+static int secondOfDay(time_t time)
+{
+  return (int)(time - floorDayNumber(time) * SECONDS_PER_DAY);
+}
+
+time_t daysFromCivil(int year, int month, int monthDay)
+{
+  time_t era, yearOfEra, dayOfEra;
+  int    marchBasedMonth;
+
+  year           -= (month <= 2);
+  era             = (year >= 0 ? year : year - 399) / 400;
+  yearOfEra       = year - era * 400;
+  marchBasedMonth = month + ((month > 2) ? -3 : 9);
+  dayOfEra        = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + (153 * marchBasedMonth + 2) / 5 + monthDay - 1;
+
+  return era * DAYS_PER_ERA + dayOfEra - EPOCH_ERA_DAY_OFFSET;
+}
+
+void civilFromDays(time_t dayNumber, int* pYear, int* pMonth, int* pMonthDay)
+{
+  time_t shiftedDay = dayNumber + EPOCH_ERA_DAY_OFFSET;
+  time_t era        = (shiftedDay >= 0 ? shiftedDay : shiftedDay - (DAYS_PER_ERA - 1)) / DAYS_PER_ERA;
+  time_t dayOfEra   = shiftedDay - era * DAYS_PER_ERA;
+  time_t yearOfEra  = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / (DAYS_PER_ERA - 1)) / 365;
+  time_t dayOfYear  = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100); /* March based */
+  int    monthIndex = (int)((5 * dayOfYear + 2) / 153);                                 /* March = 0 */
+
+  *pMonthDay = (int)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+  *pMonth    = monthIndex + 3 - 12 * (monthIndex >= 10);
+  *pYear     = (int)(yearOfEra + era * 400) + (*pMonth <= 2);
+}
+
+static void decomposeDay(CalendarDay* pDay, time_t dayNumber)
+{
+  int month, weekDay = (int)((dayNumber + THURSDAY) % DAYS_PER_WEEK);
+
+  civilFromDays(dayNumber, &pDay->year, &month, &pDay->monthDay);
+
+  pDay->dayNumber = dayNumber;
+  pDay->month     = month - 1;
+  pDay->dayOfYear = (int)(dayNumber - daysFromCivil(pDay->year, 1, 1));
+  pDay->dayOfWeek = weekDay + DAYS_PER_WEEK * (weekDay < 0);
+}
+
+void getCalendarDay(CalendarDay* pDay, time_t time)
+{
+  time_t              dayNumber = floorDayNumber(time);
+  CalendarCacheEntry* pEntry    = &gCalendarCache[dayNumber & CACHE_MASK];
+
+  if(!pEntry->isValid || (pEntry->day.dayNumber != dayNumber))
+  {
+    decomposeDay(&pEntry->day, dayNumber);
+    pEntry->isValid = TRUE;
+  }
+
+  *pDay = pEntry->day;
+}
+
+int calendarDayOfYear(time_t time)
+{
+  CalendarDay day;
+  getCalendarDay(&day, time);
+  return day.dayOfYear;
+}
+
+int calendarDayOfWeek(time_t time)
+{
+  int weekDay = (int)((floorDayNumber(time) + THURSDAY) % DAYS_PER_WEEK);
+  return weekDay + DAYS_PER_WEEK * (weekDay < 0);
+}
+
+int calendarHour(time_t time)
+{
+  return secondOfDay(time) / SECONDS_PER_HOUR;
+}
+
+int calendarMinute(time_t time)
+{
+  return (secondOfDay(time) % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE;
+}
@@ -49,8 +49,85 @@
 #include "TimeZoneOffsets.h"
 #include "CriticalSection.h"
 
-static int gExtendedBufferSize = DEFAULT_RATES_BUF_EXT;
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  typedef SRWLOCK ReadWriteLock;
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  typedef pthread_rwlock_t ReadWriteLock;
+#else
+  #error "Unsupported operating system"
+#endif
+
+#define SHARED_RATES_INSTANCE_ID(sharedRatesId) (-2 - (sharedRatesId)) /* -1 marks an unused buffer */
+#define NO_SHARED_RATES                         -1
+
+typedef struct sharedRates_t
+{
+  SharedRatesKey key;
+  int            refCount;
+  int            ratesIndex;        /* The index of the converted rates inside buffers */
+  BOOL           hasSourceStamp;
+  time_t         lastSourceTime;    /* Latest source bar converted so far */
+  double         lastSourceClose;
+  double         lastSourceVolume;
+  int            totalConversions;
+  RatesBuffers   buffers;
+  ReadWriteLock  lock;
+} SharedRates;
+
+static int          gExtendedBufferSize = DEFAULT_RATES_BUF_EXT;
 static RatesBuffers gRatesBuffers[MAX_INSTANCES];
+static BOOL         gShareRatesBuffers = FALSE;
+static BOOL         gSharedRatesInitialized = FALSE;
+static SharedRates  gSharedRates[MAX_SHARED_RATES];
+static int          gSharedRatesBindings[MAX_INSTANCES][MAX_RATES_BUFFERS];
+static int          gAttachedSharedRates[MAX_INSTANCES][MAX_RATES_BUFFERS];
+
+static void initReadWriteLock(ReadWriteLock* pLock)
+{
+#if defined _WIN32 || defined _WIN64
+  InitializeSRWLock(pLock);
+#else
+  pthread_rwlock_init(pLock, NULL);
+#endif
+}
+
+static void lockForReading(ReadWriteLock* pLock)
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockShared(pLock);
+#else
+  pthread_rwlock_rdlock(pLock);
+#endif
+}
+
+static void unlockForReading(ReadWriteLock* pLock)
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockShared(pLock);
+#else
+  pthread_rwlock_unlock(pLock);
+#endif
+}
+
+static void lockForWriting(ReadWriteLock* pLock)
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockExclusive(pLock);
+#else
+  pthread_rwlock_wrlock(pLock);
+#endif
+}
+
+static void unlockForWriting(ReadWriteLock* pLock)
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockExclusive(pLock);
+#else
+  pthread_rwlock_unlock(pLock);
+#endif
+}
 
 void setExtendedBufferSize(int size)
 {
@@ -62,38 +139,41 @@ void setExtendedBufferSize(int size)
   }
 }
 
-static void initRatesBuffer(int instanceIndex, int ratesIndex)
+static void clearRates(Rates* rates)
+{
+  rates->info.isEnabled     = FALSE;
+  rates->info.isBufferFull  = FALSE;
+  rates->info.timeframe     = 0;
+  rates->info.arraySize     = 0;
+  rates->info.point         = 0;
+  rates->time               = NULL;
+  rates->open               = NULL;
+  rates->high               = NULL;
+  rates->low                = NULL;
+  rates->close              = NULL;
+  rates->volume             = NULL;
+}
+
+static void initRatesBuffer(RatesBuffers* pRatesBuffers)
 {
   int i;
 
-  gRatesBuffers[instanceIndex].instanceId = -1;
+  pRatesBuffers->instanceId = -1;
 
   for(i = 0; i < MAX_RATES_BUFFERS; i++)
   {
-    Rates* rates = &gRatesBuffers[instanceIndex].rates[i];
-
-    gRatesBuffers[instanceIndex].bufferOffsets[i] = 0;
-    rates->info.isEnabled     = FALSE;
-    rates->info.isBufferFull  = FALSE;
-    rates->info.timeframe     = 0;
-    rates->info.arraySize     = 0;
-    rates->info.point         = 0;
-    rates->time               = NULL;
-    rates->open               = NULL;
-    rates->high               = NULL;
-    rates->low                = NULL;
-    rates->close              = NULL;
-    rates->volume             = NULL;
+    pRatesBuffers->bufferOffsets[i] = 0;
+    clearRates(&pRatesBuffers->rates[i]);
   }
 }
 
-static void resetRatesOffset(int instanceIndex, int ratesIndex)
+static void resetRatesOffset(RatesBuffers* pRatesBuffers, int ratesIndex)
 {
-  Rates* pRates = &gRatesBuffers[instanceIndex].rates[ratesIndex];
-  int oldIndex, newIndex, oldOffset = gRatesBuffers[instanceIndex].bufferOffsets[ratesIndex];
-  gRatesBuffers[instanceIndex].bufferOffsets[ratesIndex] = 0;
+  Rates* pRates = &pRatesBuffers->rates[ratesIndex];
+  int oldIndex, newIndex, oldOffset = pRatesBuffers->bufferOffsets[ratesIndex];
+  pRatesBuffers->bufferOffsets[ratesIndex] = 0;
 
-  //pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"resetRatesOffset() instanceId = %d, ratesIndex = %d, oldOffset = %d", gRatesBuffers[instanceIndex].instanceId, ratesIndex, oldOffset);
+  //pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"resetRatesOffset() instanceId = %d, ratesIndex = %d, oldOffset = %d", pRatesBuffers->instanceId, ratesIndex, oldOffset);
 
   /* Shift the pointers to the front of the buffers */
   if(pRates->time)   
@@ -153,20 +233,62 @@ static void resetRatesOffset(int instanceIndex, int ratesIndex)
   }
 }
 
-AsirikuyReturnCode allocateRates(RatesBuffers** ppRatesBuffer, int instanceId, RatesInfo* pRatesInfo)
+static void allocateRatesArrays(Rates* pRates, const RatesInfo* pRatesInfo)
+{
+  int ratesValueIndex;
+
+  pRates->info.isEnabled    = pRatesInfo->isEnabled;
+  pRates->info.isBufferFull = pRatesInfo->isBufferFull;
+  pRates->info.timeframe    = pRatesInfo->timeframe;
+  pRates->info.arraySize    = pRatesInfo->arraySize;
+  pRates->info.point        = pRatesInfo->point;
+  pRates->info.digits       = pRatesInfo->digits;
+
+  pRates->time   = (time_t*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(time_t));
+  pRates->open   = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
+  pRates->high   = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
+  pRates->low    = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
+  pRates->close  = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
+  pRates->volume = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
+
+  for(ratesValueIndex = 0; ratesValueIndex < pRates->info.arraySize; ratesValueIndex++)
+  {
+    pRates->time  [ratesValueIndex] = 0;
+    pRates->open  [ratesValueIndex] = 0;
+    pRates->high  [ratesValueIndex] = 0;
+    pRates->low   [ratesValueIndex] = 0;
+    pRates->close [ratesValueIndex] = 0;
+    pRates->volume[ratesValueIndex] = 0;
+  }
+}
+
+static int findInstanceIndex(int instanceId)
 {
-  int instanceIndex, ratesIndex, ratesValueIndex;
+  int instanceIndex;
 
   for(instanceIndex = 0; instanceIndex < MAX_INSTANCES; instanceIndex++)
   {
     if(gRatesBuffers[instanceIndex].instanceId == instanceId)
     {
-      /* Rates are already allocated for this instance */
-      *ppRatesBuffer = &gRatesBuffers[instanceIndex];
-      return SUCCESS;
+      return instanceIndex;
     }
   }
 
+  return -1;
+}
+
+AsirikuyReturnCode allocateRates(RatesBuffers** ppRatesBuffer, int instanceId, RatesInfo* pRatesInfo)
+{
+  int instanceIndex, ratesIndex;
+
+  instanceIndex = findInstanceIndex(instanceId);
+  if(instanceIndex >= 0)
+  {
+    /* Rates are already allocated for this instance */
+    *ppRatesBuffer = &gRatesBuffers[instanceIndex];
+    return SUCCESS;
+  }
+
   enterCriticalSection();
   {
     /* Find the first unused index */
@@ -187,36 +309,12 @@ AsirikuyReturnCode allocateRates(RatesBuffers** ppRatesBuffer, int instanceId, R
 
     for(ratesIndex = 0; ratesIndex < MAX_RATES_BUFFERS; ratesIndex++)
     {
-      Rates* pRates = &gRatesBuffers[instanceIndex].rates[ratesIndex];
-
       if(!pRatesInfo[ratesIndex].isEnabled)
       {
         continue;
       }
 
-      pRates->info.isEnabled    = pRatesInfo[ratesIndex].isEnabled;
-      pRates->info.isBufferFull = pRatesInfo[ratesIndex].isBufferFull;
-      pRates->info.timeframe    = pRatesInfo[ratesIndex].timeframe;
-      pRates->info.arraySize    = pRatesInfo[ratesIndex].arraySize;
-      pRates->info.point        = pRatesInfo[ratesIndex].point;
-	  pRates->info.digits       = pRatesInfo[ratesIndex].digits;
-
-      pRates->time   = (time_t*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(time_t));
-      pRates->open   = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
-      pRates->high   = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
-      pRates->low    = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
-      pRates->close  = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
-      pRates->volume = (double*)malloc((pRates->info.arraySize + gExtendedBufferSize) * sizeof(double));
-
-      for(ratesValueIndex = 0; ratesValueIndex < pRates->info.arraySize; ratesValueIndex++)
-      {
-        pRates->time  [ratesValueIndex] = 0;
-        pRates->open  [ratesValueIndex] = 0;
-        pRates->high  [ratesValueIndex] = 0;
-        pRates->low   [ratesValueIndex] = 0;
-        pRates->close [ratesValueIndex] = 0;
-        pRates->volume[ratesValueIndex] = 0;
-      }
+      allocateRatesArrays(&gRatesBuffers[instanceIndex].rates[ratesIndex], &pRatesInfo[ratesIndex]);
     }
 
     *ppRatesBuffer = &gRatesBuffers[instanceIndex];
@@ -226,11 +324,11 @@ AsirikuyReturnCode allocateRates(RatesBuffers** ppRatesBuffer, int instanceId, R
   return SUCCESS;
 }
 
-static void resetRatesBuffer(int instanceIndex, int ratesIndex)
+static void resetRatesBuffer(RatesBuffers* pRatesBuffers, int ratesIndex)
 {
-  Rates* pRates = &gRatesBuffers[instanceIndex].rates[ratesIndex];
+  Rates* pRates = &pRatesBuffers->rates[ratesIndex];
 
-  resetRatesOffset(instanceIndex, ratesIndex);
+  resetRatesOffset(pRatesBuffers, ratesIndex);
 
   if(pRates->time)
   {
@@ -258,70 +356,159 @@ static void resetRatesBuffer(int instanceIndex, int ratesIndex)
   }
 
   /* re-initialize rates buffer - sets all pointers to NULL */
-  initRatesBuffer(instanceIndex, ratesIndex);
+  pRatesBuffers->bufferOffsets[ratesIndex] = 0;
+  clearRates(pRates);
   return;
 }
 
-void resetInstanceBuffer(int instanceId)
+static void initSharedRates()
 {
   int i, j;
+
+  if(gSharedRatesInitialized)
+  {
+    return;
+  }
+
+  for(i = 0; i < MAX_SHARED_RATES; i++)
+  {
+    memset(&gSharedRates[i].key, 0, sizeof(SharedRatesKey));
+    gSharedRates[i].refCount = 0;
+    initRatesBuffer(&gSharedRates[i].buffers);
+    initReadWriteLock(&gSharedRates[i].lock);
+  }
+
   for(i = 0; i < MAX_INSTANCES; i++)
   {
     for(j = 0; j < MAX_RATES_BUFFERS; j++)
     {
-      if(gRatesBuffers[i].instanceId == instanceId)
-      {
-        resetRatesBuffer(i, j);
-        gRatesBuffers[i].instanceId = -1;
-      }
+      gSharedRatesBindings[i][j] = NO_SHARED_RATES;
+      gAttachedSharedRates[i][j] = NO_SHARED_RATES;
     }
   }
+
+  gSharedRatesInitialized = TRUE;
 }
 
-void resetAllRatesBuffers()
+static void freeSharedRates(int sharedRatesId)
+{
+  SharedRates* pShared = &gSharedRates[sharedRatesId];
+
+  /* Wait for instances still reading the previous tick */
+  lockForWriting(&pShared->lock);
+  resetRatesBuffer(&pShared->buffers, pShared->ratesIndex);
+  memset(&pShared->key, 0, sizeof(SharedRatesKey));
+  pShared->refCount = 0;
+  unlockForWriting(&pShared->lock);
+}
+
+/* Must be called inside the critical section. */
+static void releaseSharedRatesBinding(int instanceIndex, int ratesIndex)
+{
+  int sharedRatesId = gSharedRatesBindings[instanceIndex][ratesIndex];
+
+  if(sharedRatesId == NO_SHARED_RATES)
+  {
+    return;
+  }
+
+  gSharedRatesBindings[instanceIndex][ratesIndex] = NO_SHARED_RATES;
+  if(--gSharedRates[sharedRatesId].refCount <= 0)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"releaseSharedRatesBinding() Freeing shared rates for %s, timeframe = %d", gSharedRates[sharedRatesId].key.symbol, gSharedRates[sharedRatesId].key.timeframe);
+    freeSharedRates(sharedRatesId);
+  }
+}
+
+void resetInstanceBuffer(int instanceId)
 {
   int i, j;
+
+  enterCriticalSection();
+  initSharedRates();
   for(i = 0; i < MAX_INSTANCES; i++)
   {
+    if(gRatesBuffers[i].instanceId != instanceId)
+    {
+      continue;
+    }
+
+    detachSharedRates(instanceId);
     for(j = 0; j < MAX_RATES_BUFFERS; j++)
     {
-      resetRatesBuffer(i, j);
-      gRatesBuffers[i].instanceId = -1;
+      releaseSharedRatesBinding(i, j);
+      resetRatesBuffer(&gRatesBuffers[i], j);
     }
+    gRatesBuffers[i].instanceId = -1;
   }
+  leaveCriticalSection();
 }
 
+void resetAllRatesBuffers()
+{
+  int i, j;
 
+  enterCriticalSection();
+  initSharedRates();
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gRatesBuffers[i].instanceId != -1)
+    {
+      detachSharedRates(gRatesBuffers[i].instanceId);
+    }
 
-AsirikuyReturnCode incrementRatesOffset(int instanceId, int ratesIndex)
-{
-  int instanceIndex;
+    for(j = 0; j < MAX_RATES_BUFFERS; j++)
+    {
+      gSharedRatesBindings[i][j] = NO_SHARED_RATES;
+      resetRatesBuffer(&gRatesBuffers[i], j);
+    }
+    gRatesBuffers[i].instanceId = -1;
+  }
 
-  for(instanceIndex = 0; instanceIndex < MAX_INSTANCES; instanceIndex++)
+  for(i = 0; i < MAX_SHARED_RATES; i++)
   {
-    if(gRatesBuffers[instanceIndex].instanceId == instanceId)
+    if(gSharedRates[i].refCount > 0)
     {
-      break;
+      freeSharedRates(i);
     }
   }
+  leaveCriticalSection();
+}
+
+static RatesBuffers* findRatesBuffers(int instanceId)
+{
+  int instanceIndex;
+
+  if((instanceId <= SHARED_RATES_INSTANCE_ID(0)) && (instanceId > SHARED_RATES_INSTANCE_ID(MAX_SHARED_RATES)))
+  {
+    return &gSharedRates[SHARED_RATES_INSTANCE_ID(0) - instanceId].buffers;
+  }
+
+  instanceIndex = findInstanceIndex(instanceId);
+  return (instanceIndex >= 0) ? &gRatesBuffers[instanceIndex] : NULL;
+}
 
-  if(instanceIndex >= MAX_INSTANCES)
+AsirikuyReturnCode incrementRatesOffset(int instanceId, int ratesIndex)
+{
+  RatesBuffers* pRatesBuffers = findRatesBuffers(instanceId);
+
+  if(pRatesBuffers == NULL)
   {
     pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"incrementRatesOffset() failed. instanceId: %d does not have a rates buffer allocated", instanceId);
     return UNKNOWN_INSTANCE_ID;
   }
 
-  gRatesBuffers[instanceIndex].bufferOffsets[ratesIndex]++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].time++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].open++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].high++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].low++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].close++;
-  gRatesBuffers[instanceIndex].rates[ratesIndex].volume++;
+  pRatesBuffers->bufferOffsets[ratesIndex]++;
+  pRatesBuffers->rates[ratesIndex].time++;
+  pRatesBuffers->rates[ratesIndex].open++;
+  pRatesBuffers->rates[ratesIndex].high++;
+  pRatesBuffers->rates[ratesIndex].low++;
+  pRatesBuffers->rates[ratesIndex].close++;
+  pRatesBuffers->rates[ratesIndex].volume++;
 
-  if(gRatesBuffers[instanceIndex].bufferOffsets[ratesIndex] >= gExtendedBufferSize)
+  if(pRatesBuffers->bufferOffsets[ratesIndex] >= gExtendedBufferSize)
   {
-    resetRatesOffset(instanceIndex, ratesIndex);
+    resetRatesOffset(pRatesBuffers, ratesIndex);
   }
   
   return SUCCESS;
@@ -352,4 +539,274 @@ AsirikuyReturnCode copyRatesBuffer(Rates* pDest, Rates* pSrc)
   pDest->volume         = pSrc->volume;
 
   return SUCCESS;
-}
\ No newline at end of file
+}
+
+void setShareRatesBuffers(BOOL isEnabled)
+{
+  gShareRatesBuffers = isEnabled;
+}
+
+BOOL isShareRatesBuffersEnabled()
+{
+  return gShareRatesBuffers;
+}
+
+static BOOL isSameSharedRatesKey(const SharedRatesKey* pKey1, const SharedRatesKey* pKey2)
+{
+  return (strcmp(pKey1->symbol, pKey2->symbol) == 0)
+    && (strcmp(pKey1->timeZones, pKey2->timeZones) == 0)
+    && (pKey1->sourceTimeframe == pKey2->sourceTimeframe)
+    && (pKey1->timeframe == pKey2->timeframe)
+    && (pKey1->arraySize == pKey2->arraySize);
+}
+
+AsirikuyReturnCode acquireSharedRates(int instanceId, int ratesIndex, const SharedRatesKey* pKey, const RatesInfo* pRatesInfo, int* pSharedRatesId)
+{
+  int instanceIndex, sharedRatesId, freeId = NO_SHARED_RATES;
+
+  if((pKey == NULL) || (pRatesInfo == NULL) || (pSharedRatesId == NULL))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"acquireSharedRates() failed. NULL argument");
+    return NULL_POINTER;
+  }
+
+  if((ratesIndex < 0) || (ratesIndex >= MAX_RATES_BUFFERS))
+  {
+    return INVALID_PARAMETER;
+  }
+
+  enterCriticalSection();
+  initSharedRates();
+
+  instanceIndex = findInstanceIndex(instanceId);
+  if(instanceIndex < 0)
+  {
+    leaveCriticalSection();
+    pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"acquireSharedRates() failed. instanceId: %d does not have a rates buffer allocated", instanceId);
+    return UNKNOWN_INSTANCE_ID;
+  }
+
+  sharedRatesId = gSharedRatesBindings[instanceIndex][ratesIndex];
+  if(sharedRatesId != NO_SHARED_RATES)
+  {
+    if(isSameSharedRatesKey(&gSharedRates[sharedRatesId].key, pKey))
+    {
+      *pSharedRatesId = sharedRatesId;
+      leaveCriticalSection();
+      return SUCCESS;
+    }
+
+    releaseSharedRatesBinding(instanceIndex, ratesIndex);
+  }
+
+  for(sharedRatesId = 0; sharedRatesId < MAX_SHARED_RATES; sharedRatesId++)
+  {
+    if(gSharedRates[sharedRatesId].refCount <= 0)
+    {
+      if(freeId == NO_SHARED_RATES)
+      {
+        freeId = sharedRatesId;
+      }
+    }
+    else if(isSameSharedRatesKey(&gSharedRates[sharedRatesId].key, pKey))
+    {
+      break;
+    }
+  }
+
+  if(sharedRatesId >= MAX_SHARED_RATES)
+  {
+    if(freeId == NO_SHARED_RATES)
+    {
+      leaveCriticalSection();
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"acquireSharedRates() failed. All %d shared rates buffers are in use", MAX_SHARED_RATES);
+      return TOO_MANY_INSTANCES;
+    }
+
+    sharedRatesId = freeId;
+    gSharedRates[sharedRatesId].key              = *pKey;
+    gSharedRates[sharedRatesId].ratesIndex       = ratesIndex;
+    gSharedRates[sharedRatesId].hasSourceStamp   = FALSE;
+    gSharedRates[sharedRatesId].totalConversions = 0;
+    initRatesBuffer(&gSharedRates[sharedRatesId].buffers);
+    gSharedRates[sharedRatesId].buffers.instanceId = SHARED_RATES_INSTANCE_ID(sharedRatesId);
+    allocateRatesArrays(&gSharedRates[sharedRatesId].buffers.rates[ratesIndex], pRatesInfo);
+    pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"acquireSharedRates() Allocated shared rates for %s, timeframe = %d, bars = %d", pKey->symbol, pKey->timeframe, pKey->arraySize);
+  }
+
+  gSharedRates[sharedRatesId].refCount++;
+  gSharedRatesBindings[instanceIndex][ratesIndex] = sharedRatesId;
+  *pSharedRatesId = sharedRatesId;
+  leaveCriticalSection();
+
+  return SUCCESS;
+}
+
+BOOL beginSharedRatesUpdate(int sharedRatesId, time_t sourceTime, double sourceClose, double sourceVolume, RatesBuffers** ppSharedBuffers, int* pRatesIndex)
+{
+  SharedRates* pShared = &gSharedRates[sharedRatesId];
+  BOOL isStale;
+
+  lockForWriting(&pShared->lock);
+
+  /* Instances on the same symbol may call with a chart that has not received the latest tick yet.
+   * Older source data never overwrites newer converted data. */
+  isStale = !pShared->buffers.rates[pShared->ratesIndex].info.isBufferFull
+    || !pShared->hasSourceStamp
+    || (sourceTime > pShared->lastSourceTime)
+    || ((sourceTime == pShared->lastSourceTime) && ((sourceClose != pShared->lastSourceClose) || (sourceVolume != pShared->lastSourceVolume)));
+
+  if(!isStale)
+  {
+    unlockForWriting(&pShared->lock);
+    return FALSE;
+  }
+
+  pShared->hasSourceStamp   = TRUE;
+  pShared->lastSourceTime   = sourceTime;
+  pShared->lastSourceClose  = sourceClose;
+  pShared->lastSourceVolume = sourceVolume;
+  pShared->totalConversions++;
+
+  *ppSharedBuffers = &pShared->buffers;
+  *pRatesIndex     = pShared->ratesIndex;
+  return TRUE;
+}
+
+void endSharedRatesUpdate(int sharedRatesId)
+{
+  unlockForWriting(&gSharedRates[sharedRatesId].lock);
+}
+
+AsirikuyReturnCode attachSharedRates(int instanceId)
+{
+  int instanceIndex, ratesIndex, sharedRatesId, next;
+
+  if(!gSharedRatesInitialized)
+  {
+    return SUCCESS;
+  }
+
+  instanceIndex = findInstanceIndex(instanceId);
+  if(instanceIndex < 0)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"attachSharedRates() failed. instanceId: %d does not have a rates buffer allocated", instanceId);
+    return UNKNOWN_INSTANCE_ID;
+  }
+
+  /* Lock in ascending shared rates order so that instances sharing several buffers cannot deadlock. */
+  for(sharedRatesId = -1; ; sharedRatesId = next)
+  {
+    next = MAX_SHARED_RATES;
+    for(ratesIndex = 0; ratesIndex < MAX_RATES_BUFFERS; ratesIndex++)
+    {
+      int boundId = gSharedRatesBindings[instanceIndex][ratesIndex];
+      if((boundId > sharedRatesId) && (boundId < next))
+      {
+        next = boundId;
+      }
+    }
+
+    if(next >= MAX_SHARED_RATES)
+    {
+      break;
+    }
+
+    lockForReading(&gSharedRates[next].lock);
+
+    for(ratesIndex = 0; ratesIndex < MAX_RATES_BUFFERS; ratesIndex++)
+    {
+      if(gSharedRatesBindings[instanceIndex][ratesIndex] == next)
+      {
+        SharedRates* pShared = &gSharedRates[next];
+        gRatesBuffers[instanceIndex].rates[ratesIndex] = pShared->buffers.rates[pShared->ratesIndex];
+        gAttachedSharedRates[instanceIndex][ratesIndex] = next;
+      }
+    }
+  }
+
+  return SUCCESS;
+}
+
+void detachSharedRates(int instanceId)
+{
+  int instanceIndex, ratesIndex, i;
+
+  if(!gSharedRatesInitialized)
+  {
+    return;
+  }
+
+  instanceIndex = findInstanceIndex(instanceId);
+  if(instanceIndex < 0)
+  {
+    return;
+  }
+
+  for(ratesIndex = 0; ratesIndex < MAX_RATES_BUFFERS; ratesIndex++)
+  {
+    int  sharedRatesId = gAttachedSharedRates[instanceIndex][ratesIndex];
+    BOOL isAttachedLater = FALSE;
+
+    if(sharedRatesId == NO_SHARED_RATES)
+    {
+      continue;
+    }
+
+    /* The view only borrows the shared arrays, so clear it before the instance buffer can be reset. */
+    clearRates(&gRatesBuffers[instanceIndex].rates[ratesIndex]);
+    gAttachedSharedRates[instanceIndex][ratesIndex] = NO_SHARED_RATES;
+
+    /* Shared rates attached to several indexes were read locked once. */
+    for(i = ratesIndex + 1; i < MAX_RATES_BUFFERS; i++)
+    {
+      isAttachedLater |= (gAttachedSharedRates[instanceIndex][i] == sharedRatesId);
+    }
+
+    if(!isAttachedLater)
+    {
+      unlockForReading(&gSharedRates[sharedRatesId].lock);
+    }
+  }
+}
+
+size_t getRatesBuffersMemoryUsage()
+{
+  const size_t BAR_SIZE = sizeof(time_t) + 5 * sizeof(double);
+  size_t total = 0;
+  int i, j;
+
+  enterCriticalSection();
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    for(j = 0; j < MAX_RATES_BUFFERS; j++)
+    {
+      /* Attached views borrow shared arrays and are counted below */
+      if((gRatesBuffers[i].instanceId != -1) && (gRatesBuffers[i].rates[j].time != NULL) && (!gSharedRatesInitialized || (gAttachedSharedRates[i][j] == NO_SHARED_RATES)))
+      {
+        total += (gRatesBuffers[i].rates[j].info.arraySize + gExtendedBufferSize) * BAR_SIZE;
+      }
+    }
+  }
+
+  for(i = 0; gSharedRatesInitialized && (i < MAX_SHARED_RATES); i++)
+  {
+    if(gSharedRates[i].refCount > 0)
+    {
+      total += (gSharedRates[i].key.arraySize + gExtendedBufferSize) * BAR_SIZE;
+    }
+  }
+  leaveCriticalSection();
+
+  return total;
+}
+
+int getSharedRatesConversions(int sharedRatesId)
+{
+  if((sharedRatesId < 0) || (sharedRatesId >= MAX_SHARED_RATES))
+  {
+    return 0;
+  }
+
+  return gSharedRates[sharedRatesId].totalConversions;
+}
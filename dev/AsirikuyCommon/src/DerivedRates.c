@@ -0,0 +1,372 @@
+/**
+ * @file
+ * @brief     Incremental builders for Renko and constant volume bars derived from a rates buffer.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "DerivedRates.h"
+#include "CriticalSection.h"
+
+#define MIN_DERIVED_RATES_CAPACITY 64
+
+static AsirikuyReturnCode reserveDerivedBars(DerivedRatesBuilder* pBuilder, int bars)
+{
+  int     capacity = pBuilder->capacity;
+  time_t* pTime;
+  double* pArrays[5];
+  double** ppArrays[5];
+  int     i;
+
+  if(bars <= capacity)
+  {
+    return SUCCESS;
+  }
+
+  if(capacity < MIN_DERIVED_RATES_CAPACITY)
+  {
+    capacity = MIN_DERIVED_RATES_CAPACITY;
+  }
+  while(capacity < bars)
+  {
+    capacity *= 2;
+  }
+
+  ppArrays[0] = &pBuilder->rates.open;
+  ppArrays[1] = &pBuilder->rates.high;
+  ppArrays[2] = &pBuilder->rates.low;
+  ppArrays[3] = &pBuilder->rates.close;
+  ppArrays[4] = &pBuilder->rates.volume;
+
+  /* Each array keeps its old block until the reallocation succeeds so a failure leaves the bars intact. */
+  pTime = (time_t*)realloc(pBuilder->rates.time, capacity * sizeof(time_t));
+  if(pTime != NULL)
+  {
+    pBuilder->rates.time = pTime;
+  }
+  for(i = 0; i < 5; i++)
+  {
+    pArrays[i] = (double*)realloc(*ppArrays[i], capacity * sizeof(double));
+    if(pArrays[i] != NULL)
+    {
+      *ppArrays[i] = pArrays[i];
+    }
+  }
+
+  if((pTime == NULL) || (pArrays[0] == NULL) || (pArrays[1] == NULL) || (pArrays[2] == NULL) || (pArrays[3] == NULL) || (pArrays[4] == NULL))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"reserveDerivedBars() Failed to allocate %d derived bars.", capacity);
+    return INSUFFICIENT_MEMORY;
+  }
+
+  pBuilder->capacity = capacity;
+  return SUCCESS;
+}
+
+static void setDerivedBar(DerivedRatesBuilder* pBuilder, int index, time_t time, double open, double high, double low, double close, double volume)
+{
+  pBuilder->rates.time[index]   = time;
+  pBuilder->rates.open[index]   = open;
+  pBuilder->rates.high[index]   = high;
+  pBuilder->rates.low[index]    = low;
+  pBuilder->rates.close[index]  = close;
+  pBuilder->rates.volume[index] = volume;
+}
+
+/* Folds source bar i into a derived bar. A bar which completes is written after the closed bars and TRUE is returned.
+ * The last source bar always completes the bar it belongs to. Storage for one more bar must be reserved. */
+static BOOL addSourceBar(DerivedRatesBuilder* pBuilder, DerivedBar* pBar, const Rates* pSource, int i, BOOL isLast)
+{
+  int index = pBuilder->closedBars;
+
+  if(pBar->isNew)
+  {
+    pBar->open   = (index == 0) ? pSource->open[i] : pBuilder->rates.close[index - 1];
+    pBar->time   = pSource->time[i];
+    pBar->high   = pBar->open;
+    pBar->low    = pBar->open;
+    pBar->volume = 0;
+    pBar->isNew  = FALSE;
+  }
+
+  pBar->volume += pSource->volume[i];
+  if(pSource->low[i] < pBar->low)
+  {
+    pBar->low = pSource->low[i];
+  }
+  if(pSource->high[i] > pBar->high)
+  {
+    pBar->high = pSource->high[i];
+  }
+
+  if(pBuilder->type == DERIVED_RENKO_RATES)
+  {
+    /* Measured from the bar open against this source bar only, as the bricks always were. */
+    double down     = pBar->open - pSource->low[i];
+    double up       = pSource->high[i] - pBar->open;
+    BOOL   isDown   = down > pBuilder->barSize;
+    BOOL   isUp     = up > pBuilder->barSize;
+
+    if(!isDown && !isUp && !isLast)
+    {
+      return FALSE;
+    }
+
+    /* An up brick takes precedence when a source bar crosses both ways. */
+    if(isUp)
+    {
+      setDerivedBar(pBuilder, index, pBar->time, pBar->open, pBar->open + pBuilder->barSize, pBar->low, pBar->open + pBuilder->barSize, pBar->volume);
+    }
+    else if(isDown)
+    {
+      setDerivedBar(pBuilder, index, pBar->time, pBar->open, pBar->high, pBar->open - pBuilder->barSize, pBar->open - pBuilder->barSize, pBar->volume);
+    }
+    else
+    {
+      setDerivedBar(pBuilder, index, pBar->time, pBar->open, pBar->high, pBar->low, pSource->close[i], pBar->volume);
+    }
+  }
+  else
+  {
+    if((pBar->volume < pBuilder->barSize) && !isLast)
+    {
+      return FALSE;
+    }
+
+    setDerivedBar(pBuilder, index, pBar->time, pBar->open, pBar->high, pBar->low, pSource->close[i], pBar->volume);
+  }
+
+  pBar->isNew = TRUE;
+  return TRUE;
+}
+
+static BOOL isDerivedRatesResumable(const DerivedRatesBuilder* pBuilder, DerivedRatesType type, double barSize, const Rates* pSource)
+{
+  int consumed = pBuilder->consumedBars;
+
+  if(!pBuilder->isBuilt || (pBuilder->type != type) || (pBuilder->barSize != barSize))
+  {
+    return FALSE;
+  }
+
+  if((consumed >= pSource->info.arraySize) || (pSource->time[0] != pBuilder->firstSourceTime))
+  {
+    return FALSE;
+  }
+
+  return (consumed == 0) || ((pSource->time[consumed - 1] == pBuilder->lastConsumedTime) && (pSource->close[consumed - 1] == pBuilder->lastConsumedClose));
+}
+
+void initDerivedRatesBuilder(DerivedRatesBuilder* pBuilder)
+{
+  memset(pBuilder, 0, sizeof(DerivedRatesBuilder));
+  pBuilder->instanceId    = -1;
+  pBuilder->ratesIndex    = -1;
+  pBuilder->openBar.isNew = TRUE;
+}
+
+void freeDerivedRatesBuilder(DerivedRatesBuilder* pBuilder)
+{
+  int instanceId = pBuilder->instanceId;
+  int ratesIndex = pBuilder->ratesIndex;
+
+  free(pBuilder->rates.time);
+  free(pBuilder->rates.open);
+  free(pBuilder->rates.high);
+  free(pBuilder->rates.low);
+  free(pBuilder->rates.close);
+  free(pBuilder->rates.volume);
+
+  initDerivedRatesBuilder(pBuilder);
+  pBuilder->instanceId = instanceId;
+  pBuilder->ratesIndex = ratesIndex;
+}
+
+AsirikuyReturnCode updateDerivedRates(DerivedRatesBuilder* pBuilder, DerivedRatesType type, double barSize, const Rates* pSource)
+{
+  AsirikuyReturnCode returnCode;
+  DerivedBar         formingBar;
+  int                last = pSource->info.arraySize - 1;
+  int                i;
+
+  if(last < 0)
+  {
+    pBuilder->isBuilt = FALSE;
+    pBuilder->rates.info.arraySize = 0;
+    return SUCCESS;
+  }
+
+  if(!isDerivedRatesResumable(pBuilder, type, barSize, pSource))
+  {
+    pBuilder->isBuilt         = TRUE;
+    pBuilder->type            = type;
+    pBuilder->barSize         = barSize;
+    pBuilder->closedBars      = 0;
+    pBuilder->consumedBars    = 0;
+    pBuilder->firstSourceTime = pSource->time[0];
+    pBuilder->openBar.isNew   = TRUE;
+  }
+
+  for(i = pBuilder->consumedBars; i < last; i++)
+  {
+    returnCode = reserveDerivedBars(pBuilder, pBuilder->closedBars + 1);
+    if(returnCode != SUCCESS)
+    {
+      pBuilder->isBuilt = FALSE;
+      pBuilder->rates.info.arraySize = 0;
+      return returnCode;
+    }
+
+    if(addSourceBar(pBuilder, &pBuilder->openBar, pSource, i, FALSE))
+    {
+      pBuilder->closedBars++;
+    }
+  }
+
+  if(last > pBuilder->consumedBars)
+  {
+    pBuilder->consumedBars      = last;
+    pBuilder->lastConsumedTime  = pSource->time[last - 1];
+    pBuilder->lastConsumedClose = pSource->close[last - 1];
+  }
+
+  /* The forming source bar can still change so it completes a copy of the open bar. */
+  returnCode = reserveDerivedBars(pBuilder, pBuilder->closedBars + 1);
+  if(returnCode != SUCCESS)
+  {
+    pBuilder->isBuilt = FALSE;
+    pBuilder->rates.info.arraySize = 0;
+    return returnCode;
+  }
+
+  formingBar = pBuilder->openBar;
+  addSourceBar(pBuilder, &formingBar, pSource, last, TRUE);
+  pBuilder->rates.info.arraySize = pBuilder->closedBars + 1;
+
+  return SUCCESS;
+}
+
+void viewDerivedRates(const DerivedRatesBuilder* pBuilder, Rates* pRates)
+{
+  pRates->info.arraySize = pBuilder->rates.info.arraySize;
+  pRates->time   = pBuilder->rates.time;
+  pRates->open   = pBuilder->rates.open;
+  pRates->high   = pBuilder->rates.high;
+  pRates->low    = pBuilder->rates.low;
+  pRates->close  = pBuilder->rates.close;
+  pRates->volume = pBuilder->rates.volume;
+}
+
+static DerivedRatesBuilder gDerivedRatesBuilders[MAX_INSTANCES];
+static BOOL                gDerivedRatesBuildersInitialized = FALSE;
+
+DerivedRatesBuilder* getDerivedRatesBuilder(int instanceId, int ratesIndex, BOOL isCreated)
+{
+  DerivedRatesBuilder* pBuilder = NULL;
+  int i;
+
+  enterCriticalSection();
+
+  if(!gDerivedRatesBuildersInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      initDerivedRatesBuilder(&gDerivedRatesBuilders[i]);
+    }
+    gDerivedRatesBuildersInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if((gDerivedRatesBuilders[i].instanceId == instanceId) && (gDerivedRatesBuilders[i].ratesIndex == ratesIndex))
+    {
+      pBuilder = &gDerivedRatesBuilders[i];
+      break;
+    }
+  }
+
+  if((pBuilder == NULL) && isCreated)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gDerivedRatesBuilders[i].instanceId == -1)
+      {
+        pBuilder = &gDerivedRatesBuilders[i];
+        pBuilder->instanceId = instanceId;
+        pBuilder->ratesIndex = ratesIndex;
+        break;
+      }
+    }
+
+    if(pBuilder == NULL)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getDerivedRatesBuilder() No free builder for instance %d, rates index %d.", instanceId, ratesIndex);
+    }
+  }
+
+  leaveCriticalSection();
+
+  return pBuilder;
+}
+
+void releaseDerivedRatesBuilder(DerivedRatesBuilder* pBuilder)
+{
+  enterCriticalSection();
+
+  freeDerivedRatesBuilder(pBuilder);
+  pBuilder->instanceId = -1;
+  pBuilder->ratesIndex = -1;
+
+  leaveCriticalSection();
+}
+
+void releaseInstanceDerivedRatesBuilders(int instanceId)
+{
+  int i;
+
+  enterCriticalSection();
+
+  if(gDerivedRatesBuildersInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gDerivedRatesBuilders[i].instanceId == instanceId)
+      {
+        freeDerivedRatesBuilder(&gDerivedRatesBuilders[i]);
+        gDerivedRatesBuilders[i].instanceId = -1;
+        gDerivedRatesBuilders[i].ratesIndex = -1;
+      }
+    }
+  }
+
+  leaveCriticalSection();
+}
@@ -0,0 +1,297 @@
+/**
+ * @file
+ * @brief     Per bar balance, equity and margin of a backtest.
+ * @details   Stored as structure of arrays, with downsampling to a target number of points.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "EquityCurve.h"
+
+AsirikuyReturnCode allocEquityCurve(EquityCurve* pCurve, int capacity, int targetPoints, EquityCurveDownsampling downsampling)
+{
+  double* pBlock;
+
+  memset(pCurve, 0, sizeof(EquityCurve));
+  if(capacity <= 0)
+  {
+    return INVALID_PARAMETER;
+  }
+
+  /* The doubles come first so every array stays aligned. The block is released through the balance array. */
+  pBlock = (double*)malloc(capacity * (3 * sizeof(double) + sizeof(int)));
+  if(pBlock == NULL)
+  {
+    return INSUFFICIENT_MEMORY;
+  }
+
+  pCurve->capacity     = capacity;
+  pCurve->targetPoints = targetPoints;
+  pCurve->downsampling = downsampling;
+  pCurve->balance      = pBlock;
+  pCurve->equity       = pBlock + capacity;
+  pCurve->margin       = pBlock + 2 * capacity;
+  pCurve->time         = (int*)(pBlock + 3 * capacity);
+  return SUCCESS;
+}
+
+void freeEquityCurve(EquityCurve* pCurve)
+{
+  free(pCurve->balance);
+  memset(pCurve, 0, sizeof(EquityCurve));
+}
+
+void clearEquityCurve(EquityCurve* pCurve)
+{
+  pCurve->totalPoints    = 0;
+  pCurve->overflowPoints = 0;
+}
+
+BOOL addEquityCurvePoint(EquityCurve* pCurve, int time, double balance, double equity, double margin)
+{
+  int index = pCurve->totalPoints;
+
+  if(index >= pCurve->capacity)
+  {
+    pCurve->overflowPoints++;
+    return FALSE;
+  }
+
+  pCurve->time[index]    = time;
+  pCurve->balance[index] = balance;
+  pCurve->equity[index]  = equity;
+  pCurve->margin[index]  = margin;
+  pCurve->totalPoints++;
+  return TRUE;
+}
+
+static void copyPoint(EquityCurve* pCurve, int source, int dest)
+{
+  pCurve->time[dest]    = pCurve->time[source];
+  pCurve->balance[dest] = pCurve->balance[source];
+  pCurve->equity[dest]  = pCurve->equity[source];
+  pCurve->margin[dest]  = pCurve->margin[source];
+}
+
+/* Points are only ever moved to a lower index, and every bucket is read before any point is written over it. */
+static int downsampleLttb(EquityCurve* pCurve, int targetPoints)
+{
+  int    totalPoints = pCurve->totalPoints;
+  double every = (double)(totalPoints - 2) / (targetPoints - 2);
+  double selectedTime = pCurve->time[0], selectedEquity = pCurve->equity[0];
+  int    kept = 1, bucket;
+
+  for(bucket = 0; bucket < targetPoints - 2; bucket++)
+  {
+    int    start     = (int)(bucket * every) + 1;
+    int    end       = (int)((bucket + 1) * every) + 1;
+    int    nextEnd   = (int)((bucket + 2) * every) + 1;
+    double nextTime  = 0, nextEquity = 0, maxArea = -1;
+    int    best = start, j;
+
+    if(nextEnd > totalPoints)
+    {
+      nextEnd = totalPoints;
+    }
+
+    /* The next bucket is represented by its average point. */
+    for(j = end; j < nextEnd; j++)
+    {
+      nextTime   += pCurve->time[j];
+      nextEquity += pCurve->equity[j];
+    }
+    nextTime   /= nextEnd - end;
+    nextEquity /= nextEnd - end;
+
+    /* Keep the point forming the largest triangle with the last kept point and the next average. */
+    for(j = start; j < end; j++)
+    {
+      double area = fabs((selectedTime - nextTime) * (pCurve->equity[j] - selectedEquity) - (selectedTime - pCurve->time[j]) * (nextEquity - selectedEquity));
+      if(area > maxArea)
+      {
+        maxArea = area;
+        best    = j;
+      }
+    }
+
+    selectedTime   = pCurve->time[best];
+    selectedEquity = pCurve->equity[best];
+    copyPoint(pCurve, best, kept++);
+  }
+
+  copyPoint(pCurve, totalPoints - 1, kept++);
+  return kept;
+}
+
+static int downsampleMinMax(EquityCurve* pCurve, int targetPoints)
+{
+  int    totalPoints = pCurve->totalPoints;
+  int    buckets = (targetPoints - 2) / 2;
+  double size = (double)(totalPoints - 2) / buckets;
+  int    kept = 1, bucket;
+
+  for(bucket = 0; bucket < buckets; bucket++)
+  {
+    int start = (int)(bucket * size) + 1;
+    int end   = (int)((bucket + 1) * size) + 1;
+    int lowest = start, highest = start, j;
+
+    for(j = start + 1; j < end; j++)
+    {
+      if(pCurve->equity[j] < pCurve->equity[lowest])
+      {
+        lowest = j;
+      }
+      if(pCurve->equity[j] > pCurve->equity[highest])
+      {
+        highest = j;
+      }
+    }
+
+    /* In time order, once if both extremes are the same point. */
+    copyPoint(pCurve, lowest < highest ? lowest : highest, kept++);
+    if(lowest != highest)
+    {
+      copyPoint(pCurve, lowest < highest ? highest : lowest, kept++);
+    }
+  }
+
+  copyPoint(pCurve, totalPoints - 1, kept++);
+  return kept;
+}
+
+void downsampleEquityCurve(EquityCurve* pCurve)
+{
+  int targetPoints = pCurve->targetPoints;
+
+  if((pCurve->downsampling == EQUITY_CURVE_KEEP_ALL) || (targetPoints <= 0) || (pCurve->totalPoints <= targetPoints))
+  {
+    return;
+  }
+
+  if((targetPoints < 3) || ((pCurve->downsampling == EQUITY_CURVE_MIN_MAX) && (targetPoints < 4)))
+  {
+    /* Too few points for any bucket, keep the ends. */
+    copyPoint(pCurve, pCurve->totalPoints - 1, 1);
+    pCurve->totalPoints = targetPoints < 2 ? 1 : 2;
+    return;
+  }
+
+  if(pCurve->downsampling == EQUITY_CURVE_LTTB)
+  {
+    pCurve->totalPoints = downsampleLttb(pCurve, targetPoints);
+  }
+  else
+  {
+    pCurve->totalPoints = downsampleMinMax(pCurve, targetPoints);
+  }
+}
+
+AsirikuyReturnCode writeEquityCurve(const EquityCurve* pCurve, const char* pPath)
+{
+  EquityCurveFileHeader header;
+  FILE*  pFile = fopen(pPath, "wb");
+  size_t total = (size_t)pCurve->totalPoints;
+  BOOL   isWritten;
+
+  if(pFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeEquityCurve() Failed to open %s", pPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  header.magic          = EQUITY_CURVE_FILE_MAGIC;
+  header.version        = EQUITY_CURVE_FILE_VERSION;
+  header.totalPoints    = pCurve->totalPoints;
+  header.overflowPoints = pCurve->overflowPoints;
+
+  isWritten = (fwrite(&header, sizeof(header), 1, pFile) == 1)
+    && (fwrite(pCurve->time, sizeof(int), total, pFile) == total)
+    && (fwrite(pCurve->balance, sizeof(double), total, pFile) == total)
+    && (fwrite(pCurve->equity, sizeof(double), total, pFile) == total)
+    && (fwrite(pCurve->margin, sizeof(double), total, pFile) == total);
+
+  if(fclose(pFile) != 0)
+  {
+    isWritten = FALSE;
+  }
+
+  if(!isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeEquityCurve() Failed to write %s", pPath);
+    return FILE_WRITING_ERROR;
+  }
+  return SUCCESS;
+}
+
+AsirikuyReturnCode readEquityCurve(EquityCurve* pCurve, const char* pPath)
+{
+  EquityCurveFileHeader header;
+  FILE*  pFile = fopen(pPath, "rb");
+  size_t total;
+  BOOL   isRead;
+
+  memset(pCurve, 0, sizeof(EquityCurve));
+  if(pFile == NULL)
+  {
+    return FILE_READING_ERROR;
+  }
+
+  if((fread(&header, sizeof(header), 1, pFile) != 1) || (header.magic != EQUITY_CURVE_FILE_MAGIC) || (header.version != EQUITY_CURVE_FILE_VERSION) || (header.totalPoints < 0))
+  {
+    fclose(pFile);
+    return FILE_READING_ERROR;
+  }
+
+  if(allocEquityCurve(pCurve, header.totalPoints > 0 ? header.totalPoints : 1, 0, EQUITY_CURVE_KEEP_ALL) != SUCCESS)
+  {
+    fclose(pFile);
+    return INSUFFICIENT_MEMORY;
+  }
+
+  total  = (size_t)header.totalPoints;
+  isRead = (fread(pCurve->time, sizeof(int), total, pFile) == total)
+    && (fread(pCurve->balance, sizeof(double), total, pFile) == total)
+    && (fread(pCurve->equity, sizeof(double), total, pFile) == total)
+    && (fread(pCurve->margin, sizeof(double), total, pFile) == total);
+  fclose(pFile);
+
+  if(!isRead)
+  {
+    freeEquityCurve(pCurve);
+    return FILE_READING_ERROR;
+  }
+
+  pCurve->totalPoints    = header.totalPoints;
+  pCurve->overflowPoints = header.overflowPoints;
+  return SUCCESS;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file
+ * @brief     Change aware cache of small side files.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "FileCache.h"
+#include "CriticalSection.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+#elif defined __linux__ || defined __APPLE__
+  #include <sys/stat.h>
+#else
+  #error "Unsupported operating system"
+#endif
+
+typedef struct fileSignature_t
+{
+  int64_t modified; /* Nanoseconds on POSIX, 100 nanosecond units on Windows */
+  int64_t size;
+} FileSignature;
+
+typedef struct fileCacheEntry_t
+{
+  BOOL          isUsed;
+  BOOL          exists;   /* The file existed when it was last checked */
+  BOOL          isParsed; /* The value holds the parsed file */
+  unsigned int  hash;
+  char          path[MAX_FILE_PATH_CHARS];
+  FileSignature signature;
+  uint64_t      checkTime;
+  uint64_t      useCount;
+  size_t        valueSize;
+  unsigned char value[FILE_CACHE_MAX_VALUE_SIZE];
+} FileCacheEntry;
+
+static FileCacheEntry gEntries[FILE_CACHE_SIZE];
+static FileCacheStats gStats;
+static uint64_t       gUseCount = 0;
+static int            gCheckInterval = DEFAULT_FILE_CACHE_CHECK_MS;
+
+static uint64_t getMilliseconds()
+{
+#if defined _WIN32 || defined _WIN64
+  return (uint64_t)GetTickCount64();
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000 + (uint64_t)(now.tv_nsec / 1000000);
+#endif
+}
+
+static unsigned int hashPath(const char* pPath)
+{
+  unsigned int hash = 2166136261u;
+
+  while(*pPath != '\0')
+  {
+    hash = (hash ^ (unsigned char)*pPath++) * 16777619u;
+  }
+
+  return hash;
+}
+
+/* Returns FALSE if the file doesn't exist. */
+static BOOL getFileSignature(const char* pPath, FileSignature* pSignature)
+{
+#if defined _WIN32 || defined _WIN64
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+  if(!GetFileAttributesExA(pPath, GetFileExInfoStandard, &attributes))
+  {
+    return FALSE;
+  }
+  pSignature->modified = ((int64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+  pSignature->size     = ((int64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+#else
+  struct stat fileStat;
+
+  if(stat(pPath, &fileStat) != 0)
+  {
+    return FALSE;
+  }
+  #if defined __APPLE__
+  pSignature->modified = (int64_t)fileStat.st_mtimespec.tv_sec * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+  #else
+  pSignature->modified = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+  #endif
+  pSignature->size     = (int64_t)fileStat.st_size;
+#endif
+
+  return TRUE;
+}
+
+/* Returns the entry of a path, taking over the least recently used entry if it has none. */
+static FileCacheEntry* getEntry(const char* pPath, size_t valueSize)
+{
+  unsigned int    hash = hashPath(pPath);
+  FileCacheEntry* pOldest = &gEntries[0];
+  int i;
+
+  for(i = 0; i < FILE_CACHE_SIZE; i++)
+  {
+    if(gEntries[i].isUsed && (gEntries[i].hash == hash) && (strcmp(gEntries[i].path, pPath) == 0))
+    {
+      if(gEntries[i].valueSize != valueSize)
+      {
+        gEntries[i].isUsed = FALSE;
+        pOldest = &gEntries[i];
+        break;
+      }
+      gEntries[i].useCount = ++gUseCount;
+      return &gEntries[i];
+    }
+
+    if(!gEntries[i].isUsed)
+    {
+      pOldest = &gEntries[i];
+    }
+    else if(pOldest->isUsed && (gEntries[i].useCount < pOldest->useCount))
+    {
+      pOldest = &gEntries[i];
+    }
+  }
+
+  if(pOldest->isUsed)
+  {
+    gStats.evictions++;
+  }
+
+  memset(pOldest, 0, sizeof(FileCacheEntry));
+  pOldest->hash      = hash;
+  pOldest->valueSize = valueSize;
+  pOldest->useCount  = ++gUseCount;
+  strcpy(pOldest->path, pPath);
+  return pOldest;
+}
+
+static BOOL parseFile(const char* pPath, FileCacheParser parser, void* pValue)
+{
+  char   text[FILE_CACHE_MAX_TEXT_SIZE];
+  size_t length;
+  FILE*  fp = fopen(pPath, "r");
+
+  if(fp == NULL)
+  {
+    return FALSE;
+  }
+
+  length = fread(text, 1, FILE_CACHE_MAX_TEXT_SIZE - 1, fp);
+  text[length] = '\0';
+  fclose(fp);
+
+  return parser(text, pValue);
+}
+
+void setFileCacheCheckInterval(int milliseconds)
+{
+  gCheckInterval = milliseconds;
+}
+
+BOOL readFileCache(const char* pPath, FileCacheParser parser, void* pValue, size_t valueSize)
+{
+  FileCacheEntry* pEntry;
+  FileSignature   signature;
+  uint64_t        now;
+  BOOL            exists, isParsed;
+
+  if((valueSize > FILE_CACHE_MAX_VALUE_SIZE) || (strlen(pPath) >= MAX_FILE_PATH_CHARS))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"readFileCache() Can't cache %s.", pPath);
+    return FALSE;
+  }
+
+  enterCriticalSection();
+
+  gStats.lookups++;
+  now    = getMilliseconds();
+  pEntry = getEntry(pPath, valueSize);
+
+  if(!pEntry->isUsed || (now - pEntry->checkTime >= (uint64_t)gCheckInterval))
+  {
+    gStats.checks++;
+    memset(&signature, 0, sizeof(FileSignature));
+    exists = getFileSignature(pPath, &signature);
+
+    /* The signature is taken before parsing, so a change made while parsing is picked up by the next check. */
+    if(!pEntry->isUsed || (exists != pEntry->exists) || (signature.modified != pEntry->signature.modified) || (signature.size != pEntry->signature.size))
+    {
+      pEntry->isParsed = FALSE;
+      if(exists)
+      {
+        gStats.parses++;
+        pEntry->isParsed = parseFile(pPath, parser, pEntry->value);
+      }
+    }
+
+    pEntry->isUsed    = TRUE;
+    pEntry->exists    = exists;
+    pEntry->signature = signature;
+    pEntry->checkTime = now;
+  }
+
+  isParsed = pEntry->isParsed;
+  if(isParsed)
+  {
+    memcpy(pValue, pEntry->value, valueSize);
+  }
+
+  leaveCriticalSection();
+
+  return isParsed;
+}
+
+AsirikuyReturnCode writeFileCache(const char* pPath, const char* pText, FileCacheParser parser, size_t valueSize)
+{
+  FileCacheEntry* pEntry;
+  BOOL            isWritten;
+  FILE*           fp;
+
+  if((valueSize > FILE_CACHE_MAX_VALUE_SIZE) || (strlen(pPath) >= MAX_FILE_PATH_CHARS))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileCache() Can't cache %s.", pPath);
+    return INVALID_PARAMETER;
+  }
+
+  enterCriticalSection();
+
+  gStats.writes++;
+  pEntry = getEntry(pPath, valueSize);
+
+  fp = fopen(pPath, "w");
+  isWritten = (fp != NULL) && (fputs(pText, fp) >= 0);
+  if((fp != NULL) && (fclose(fp) != 0))
+  {
+    isWritten = FALSE;
+  }
+
+  if(!isWritten)
+  {
+    /* Nothing is known about the file anymore. */
+    pEntry->isUsed = FALSE;
+    leaveCriticalSection();
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileCache() Failed to write %s.", pPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  memset(&pEntry->signature, 0, sizeof(FileSignature));
+  pEntry->exists    = getFileSignature(pPath, &pEntry->signature);
+  pEntry->isParsed  = parser(pText, pEntry->value);
+  pEntry->isUsed    = TRUE;
+  pEntry->checkTime = getMilliseconds();
+
+  leaveCriticalSection();
+
+  return SUCCESS;
+}
+
+void getFileCacheStats(FileCacheStats* pStats)
+{
+  enterCriticalSection();
+  *pStats = gStats;
+  leaveCriticalSection();
+}
+
+void resetFileCache()
+{
+  enterCriticalSection();
+  memset(gEntries, 0, sizeof(gEntries));
+  memset(&gStats, 0, sizeof(FileCacheStats));
+  gUseCount = 0;
+  leaveCriticalSection();
+}
@@ -0,0 +1,304 @@
+/**
+ * @file
+ * @brief     Aggregated exposure of the open orders.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "OpenPositions.h"
+
+typedef struct pricedLots_t
+{
+  double openPrice;
+  double lots;
+} PricedLots;
+
+static int compareOpenPrices(const void* pLeft, const void* pRight)
+{
+  double left  = ((const PricedLots*)pLeft)->openPrice;
+  double right = ((const PricedLots*)pRight)->openPrice;
+
+  return (left > right) - (left < right);
+}
+
+static PositionSideIndex getPositionSide(OrderType type)
+{
+  return (type == BUY || type == BUYLIMIT || type == BUYSTOP) ? LONG_POSITIONS : SHORT_POSITIONS;
+}
+
+/* Index of the first open price >= price, or > price if inclusive is FALSE. */
+static int seekOpenPrice(const PositionSide* pSide, double price, BOOL inclusive)
+{
+  int low = 0, high = pSide->totalOrders;
+
+  while(low < high)
+  {
+    int middle = low + (high - low) / 2;
+    if(pSide->pOpenPrices[middle] < price || (!inclusive && pSide->pOpenPrices[middle] == price))
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+static AsirikuyReturnCode initPositionSide(PositionSide* pSide, PricedLots* pPricedLots)
+{
+  int i;
+
+  if(pSide->totalOrders == 0)
+  {
+    return SUCCESS;
+  }
+
+  pSide->pOpenPrices = (double*)malloc((3 * pSide->totalOrders + 2) * sizeof(double));
+  if(pSide->pOpenPrices == NULL)
+  {
+    return INSUFFICIENT_MEMORY;
+  }
+  pSide->pLotsBelow          = pSide->pOpenPrices + pSide->totalOrders;
+  pSide->pLotsTimesOpenBelow = pSide->pLotsBelow + pSide->totalOrders + 1;
+
+  qsort(pPricedLots, pSide->totalOrders, sizeof(PricedLots), compareOpenPrices);
+
+  pSide->pLotsBelow[0]          = 0;
+  pSide->pLotsTimesOpenBelow[0] = 0;
+  for(i = 0; i < pSide->totalOrders; i++)
+  {
+    pSide->pOpenPrices[i]             = pPricedLots[i].openPrice;
+    pSide->pLotsBelow[i + 1]          = pSide->pLotsBelow[i] + pPricedLots[i].lots;
+    pSide->pLotsTimesOpenBelow[i + 1] = pSide->pLotsTimesOpenBelow[i] + pPricedLots[i].lots * pPricedLots[i].openPrice;
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode initOpenPositions(OpenPositions* pPositions, const OrderInfo* pOrders, int size)
+{
+  PricedLots*        pPricedLots[POSITION_SIDES];
+  BOOL               isVolatilityRiskCounted = FALSE, isVolatilityRiskCountedNoTP = FALSE;
+  AsirikuyReturnCode returnCode = SUCCESS;
+  int                i, side;
+
+  if(pPositions == NULL || (pOrders == NULL && size > 0))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"initOpenPositions() failed. pPositions or pOrders = NULL");
+    return NULL_POINTER;
+  }
+
+  memset(pPositions, 0, sizeof(OpenPositions));
+
+  pPricedLots[LONG_POSITIONS]  = (PricedLots*)malloc((size > 0 ? size : 1) * sizeof(PricedLots));
+  pPricedLots[SHORT_POSITIONS] = (PricedLots*)malloc((size > 0 ? size : 1) * sizeof(PricedLots));
+  if(pPricedLots[LONG_POSITIONS] == NULL || pPricedLots[SHORT_POSITIONS] == NULL)
+  {
+    free(pPricedLots[LONG_POSITIONS]);
+    free(pPricedLots[SHORT_POSITIONS]);
+    return INSUFFICIENT_MEMORY;
+  }
+
+  for(i = 0; i < size; i++)
+  {
+    const OrderInfo* pOrder = &pOrders[i];
+    PositionSide*    pSide;
+    BOOL             isStopLossRisk;
+    double           stopLossDistance;
+
+    if(pOrder->ticket == 0 || !pOrder->isOpen)
+    {
+      continue;
+    }
+
+    pSide = &pPositions->sides[getPositionSide(pOrder->type)];
+    pPricedLots[getPositionSide(pOrder->type)][pSide->totalOrders].openPrice = pOrder->openPrice;
+    pPricedLots[getPositionSide(pOrder->type)][pSide->totalOrders].lots      = pOrder->lots;
+    pSide->totalOrders++;
+    pSide->lots          += pOrder->lots;
+    pSide->lotsTimesOpen += pOrder->lots * (double)pOrder->openPrice;
+
+    isStopLossRisk = (pOrder->type == BUY && pOrder->openPrice - pOrder->stopLoss > 0)
+                  || (pOrder->type == SELL && pOrder->openPrice - pOrder->stopLoss < 0);
+
+    if(pOrder->type == BUY || pOrder->type == SELL)
+    {
+      pSide->marketLots          += pOrder->lots;
+      pSide->marketLotsTimesOpen += pOrder->lots * (double)pOrder->openPrice;
+
+      stopLossDistance = fabs(pOrder->openPrice - pOrder->stopLoss);
+      if(isStopLossRisk)
+      {
+        pSide->stopLossRisk += pOrder->lots * stopLossDistance;
+      }
+      else
+      {
+        pSide->stopLossProfit += pOrder->lots * stopLossDistance;
+      }
+    }
+
+    /* Once an order with a losing stop is found every later order counts, losing stop or not. */
+    isVolatilityRiskCounted = isVolatilityRiskCounted || isStopLossRisk;
+    if(isVolatilityRiskCounted)
+    {
+      pPositions->volatilityRiskLots += pOrder->lots;
+    }
+
+    if(pOrder->takeProfit == 0)
+    {
+      isVolatilityRiskCountedNoTP = isVolatilityRiskCountedNoTP || isStopLossRisk;
+      if(isVolatilityRiskCountedNoTP)
+      {
+        pPositions->volatilityRiskLotsNoTP += pOrder->lots;
+      }
+    }
+  }
+
+  for(side = 0; side < POSITION_SIDES && returnCode == SUCCESS; side++)
+  {
+    returnCode = initPositionSide(&pPositions->sides[side], pPricedLots[side]);
+  }
+
+  free(pPricedLots[LONG_POSITIONS]);
+  free(pPricedLots[SHORT_POSITIONS]);
+
+  if(returnCode != SUCCESS)
+  {
+    freeOpenPositions(pPositions);
+  }
+
+  return returnCode;
+}
+
+void freeOpenPositions(OpenPositions* pPositions)
+{
+  int side;
+
+  if(pPositions == NULL)
+  {
+    return;
+  }
+
+  for(side = 0; side < POSITION_SIDES; side++)
+  {
+    free(pPositions->sides[side].pOpenPrices);
+  }
+  memset(pPositions, 0, sizeof(OpenPositions));
+}
+
+double getOpenPositionsPNL(const OpenPositions* pPositions, double bid, double ask, double lossPerPriceUnit, BOOL isIgnoredLockedProfit, double* pLotsAtPrice)
+{
+  const PositionSide* pLong  = &pPositions->sides[LONG_POSITIONS];
+  const PositionSide* pShort = &pPositions->sides[SHORT_POSITIONS];
+  double longPNL, shortPNL;
+
+  *pLotsAtPrice = 0;
+
+  if(isIgnoredLockedProfit)
+  {
+    /* Longs lose above the ask, shorts below the bid. */
+    int longStart = seekOpenPrice(pLong, ask, FALSE);
+    int shortEnd  = seekOpenPrice(pShort, bid, TRUE);
+
+    longPNL  = fma(ask, pLong->lots - pLong->pLotsBelow[longStart], -(pLong->lotsTimesOpen - pLong->pLotsTimesOpenBelow[longStart]));
+    shortPNL = fma(-bid, pShort->pLotsBelow[shortEnd], pShort->pLotsTimesOpenBelow[shortEnd]);
+
+    if(pLong->totalOrders == 0)
+    {
+      longPNL = 0;
+    }
+    if(pShort->totalOrders == 0)
+    {
+      shortPNL = 0;
+    }
+  }
+  else
+  {
+    longPNL  = fma(ask, pLong->lots, -pLong->lotsTimesOpen);
+    shortPNL = fma(-bid, pShort->lots, pShort->lotsTimesOpen);
+
+    if(pLong->totalOrders > 0)
+    {
+      int first = seekOpenPrice(pLong, ask, TRUE);
+      *pLotsAtPrice += pLong->pLotsBelow[seekOpenPrice(pLong, ask, FALSE)] - pLong->pLotsBelow[first];
+    }
+    if(pShort->totalOrders > 0)
+    {
+      int first = seekOpenPrice(pShort, bid, TRUE);
+      *pLotsAtPrice += pShort->pLotsBelow[seekOpenPrice(pShort, bid, FALSE)] - pShort->pLotsBelow[first];
+    }
+  }
+
+  return (longPNL + shortPNL) * lossPerPriceUnit;
+}
+
+double getOpenPositionsStopLossRisk(const OpenPositions* pPositions, double lossPerPriceUnit, BOOL isIgnoredLockedProfit)
+{
+  double risk = 0;
+  int    side;
+
+  for(side = 0; side < POSITION_SIDES; side++)
+  {
+    risk -= pPositions->sides[side].stopLossRisk;
+    if(!isIgnoredLockedProfit)
+    {
+      risk += pPositions->sides[side].stopLossProfit;
+    }
+  }
+
+  return risk * lossPerPriceUnit;
+}
+
+double getOpenPositionsVolatilityRisk(const OpenPositions* pPositions, double lossPerLot, BOOL isNoTakeProfitOnly)
+{
+  return -(isNoTakeProfitOnly ? pPositions->volatilityRiskLotsNoTP : pPositions->volatilityRiskLots) * lossPerLot;
+}
+
+double getOpenPositionsBreakEvenPrice(const OpenPositions* pPositions, PositionSideIndex side)
+{
+  const PositionSide* pSide = &pPositions->sides[side];
+
+  if(pSide->marketLots <= 0)
+  {
+    return 0;
+  }
+
+  return pSide->marketLotsTimesOpen / pSide->marketLots;
+}
+
+double getOpenPositionsLots(const OpenPositions* pPositions)
+{
+  return pPositions->sides[LONG_POSITIONS].lots + pPositions->sides[SHORT_POSITIONS].lots;
+}
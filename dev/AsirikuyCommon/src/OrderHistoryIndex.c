@@ -0,0 +1,655 @@
+/**
+ * @file
+ * @brief     Day bucketed index over the order history.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "Calendar.h"
+#include "CriticalSection.h"
+#include "OrderHistoryIndex.h"
+
+typedef struct instanceOrderHistory_t
+{
+  int               instanceId;
+  OrderHistoryIndex index;
+} InstanceOrderHistory;
+
+static InstanceOrderHistory gInstanceHistories[MAX_INSTANCES];
+static BOOL                 gInstanceHistoriesInitialized = FALSE;
+
+static void initOrderHistoryDay(OrderHistoryDay* pDay, time_t dayNumber, const int* pNextOpenOrder)
+{
+  memset(pDay, 0, sizeof(OrderHistoryDay));
+  pDay->dayNumber      = dayNumber;
+  pDay->firstOrder     = -1;
+  pDay->firstOpenOrder = -1;
+  pDay->pNextOpenOrder = pNextOpenOrder;
+}
+
+static int hashDay(time_t dayNumber, int capacity)
+{
+  return (int)(((unsigned int)dayNumber * 2654435761u) & (unsigned int)(capacity - 1));
+}
+
+/* Returns the slot of a day, which is empty (orders == 0) if no order was opened that day. */
+static OrderHistoryDay* findSlot(const OrderHistoryIndex* pIndex, time_t dayNumber)
+{
+  int slot = hashDay(dayNumber, pIndex->capacity);
+
+  while(pIndex->pDays[slot].orders != 0 && pIndex->pDays[slot].dayNumber != dayNumber)
+  {
+    slot = (slot + 1) & (pIndex->capacity - 1);
+  }
+
+  return &pIndex->pDays[slot];
+}
+
+/* Finds the day and day of year buckets of an order, making the day slot ready if it was empty. */
+static void findOrderDays(OrderHistoryIndex* pIndex, const OrderInfo* pOrder, OrderHistoryDay** ppDay, OrderHistoryDay** ppDayOfYear)
+{
+  CalendarDay calendarDay;
+
+  getCalendarDay(&calendarDay, pOrder->openTime);
+
+  *ppDay = findSlot(pIndex, calendarDay.dayNumber);
+  if((*ppDay)->orders == 0)
+  {
+    initOrderHistoryDay(*ppDay, calendarDay.dayNumber, pIndex->pNextOpenInDay);
+  }
+  *ppDayOfYear = &pIndex->dayOfYearTotals[calendarDay.dayOfYear];
+}
+
+static BOOL isMarketOrder(const OrderInfo* pOrder)
+{
+  return pOrder->type == BUY || pOrder->type == SELL;
+}
+
+static void addClosedOrder(OrderHistoryDay* pDay, const OrderInfo* pOrder)
+{
+  if(pOrder->profit > 0)
+  {
+    pDay->closedWins++;
+  }
+  else if(pOrder->profit < 0)
+  {
+    pDay->closedLosses++;
+    pDay->closedLossPips += fabs(pOrder->closePrice - pOrder->openPrice) * pOrder->lots;
+  }
+}
+
+static void addOrder(OrderHistoryDay* pDay, const OrderInfo* pOrder, int order)
+{
+  if(pDay->orders == 0 || order < pDay->firstOrder)
+  {
+    pDay->firstOrder = order;
+  }
+
+  pDay->orders++;
+
+  if(isMarketOrder(pOrder))
+  {
+    pDay->marketOrders++;
+  }
+
+  if(!pOrder->isOpen)
+  {
+    addClosedOrder(pDay, pOrder);
+  }
+}
+
+/* Open orders are listed in array order. Linking them from the last one makes each insert O(1). */
+static void linkOpenOrder(OrderHistoryDay* pDay, int* pNextOpenOrder, int order)
+{
+  int previous = -1, next = pDay->firstOpenOrder;
+
+  while(next >= 0 && next < order)
+  {
+    previous = next;
+    next     = pNextOpenOrder[next];
+  }
+
+  pNextOpenOrder[order] = next;
+  if(previous == -1)
+  {
+    pDay->firstOpenOrder = order;
+  }
+  else
+  {
+    pNextOpenOrder[previous] = order;
+  }
+}
+
+static void unlinkOpenOrder(OrderHistoryDay* pDay, int* pNextOpenOrder, int order)
+{
+  int previous = -1, next = pDay->firstOpenOrder;
+
+  while(next >= 0 && next != order)
+  {
+    previous = next;
+    next     = pNextOpenOrder[next];
+  }
+
+  if(next == -1)
+  {
+    return;
+  }
+
+  if(previous == -1)
+  {
+    pDay->firstOpenOrder = pNextOpenOrder[order];
+  }
+  else
+  {
+    pNextOpenOrder[previous] = pNextOpenOrder[order];
+  }
+  pNextOpenOrder[order] = -1;
+}
+
+/* Keeps the order with the latest open time, the first one in the array on ties. Like the scans, orders opened at time 0 are never the latest. */
+static void updateLatestOrder(const OrderInfo* pOrders, int* pLatest, int order)
+{
+  time_t openTime = pOrders[order].openTime;
+
+  if(openTime <= 0)
+  {
+    return;
+  }
+
+  if(*pLatest == -1 || openTime > pOrders[*pLatest].openTime || (openTime == pOrders[*pLatest].openTime && order < *pLatest))
+  {
+    *pLatest = order;
+  }
+}
+
+static void indexOrder(OrderHistoryIndex* pIndex, int order)
+{
+  const OrderInfo* pOrder = &pIndex->pOrders[order];
+  OrderHistoryDay* pDay;
+  OrderHistoryDay* pDayOfYear;
+
+  findOrderDays(pIndex, pOrder, &pDay, &pDayOfYear);
+  addOrder(pDay, pOrder, order);
+  addOrder(pDayOfYear, pOrder, order);
+
+  updateLatestOrder(pIndex->pOrders, &pIndex->latestOrder, order);
+  if(isMarketOrder(pOrder))
+  {
+    updateLatestOrder(pIndex->pOrders, &pIndex->latestMarketOrder, order);
+    if(!pOrder->isOpen)
+    {
+      updateLatestOrder(pIndex->pOrders, &pIndex->latestClosedMarketOrder, order);
+    }
+  }
+}
+
+static void linkOpenOrders(OrderHistoryIndex* pIndex, int order)
+{
+  OrderHistoryDay* pDay;
+  OrderHistoryDay* pDayOfYear;
+
+  findOrderDays(pIndex, &pIndex->pOrders[order], &pDay, &pDayOfYear);
+  linkOpenOrder(pDay, pIndex->pNextOpenInDay, order);
+  linkOpenOrder(pDayOfYear, pIndex->pNextOpenInDayOfYear, order);
+}
+
+/* Moves an order that was indexed as open to the closed counts of its buckets. */
+static void closeIndexedOrder(OrderHistoryIndex* pIndex, int order)
+{
+  const OrderInfo* pOrder = &pIndex->pOrders[order];
+  OrderHistoryDay* pDay;
+  OrderHistoryDay* pDayOfYear;
+
+  findOrderDays(pIndex, pOrder, &pDay, &pDayOfYear);
+  unlinkOpenOrder(pDay, pIndex->pNextOpenInDay, order);
+  unlinkOpenOrder(pDayOfYear, pIndex->pNextOpenInDayOfYear, order);
+  addClosedOrder(pDay, pOrder);
+  addClosedOrder(pDayOfYear, pOrder);
+
+  if(isMarketOrder(pOrder))
+  {
+    updateLatestOrder(pIndex->pOrders, &pIndex->latestClosedMarketOrder, order);
+  }
+}
+
+AsirikuyReturnCode initOrderHistoryIndex(OrderHistoryIndex* pIndex, const OrderInfo* pOrders, int size)
+{
+  int i;
+
+  if(pIndex == NULL || (pOrders == NULL && size > 0))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"initOrderHistoryIndex() failed. pIndex or pOrders = NULL");
+    return NULL_POINTER;
+  }
+
+  memset(pIndex, 0, sizeof(OrderHistoryIndex));
+  pIndex->pOrders                 = pOrders;
+  pIndex->latestOrder             = -1;
+  pIndex->latestMarketOrder       = -1;
+  pIndex->latestClosedMarketOrder = -1;
+
+  /* At most one day per order, so the table stays at most half full. */
+  pIndex->capacity = 16;
+  while(pIndex->capacity < 2 * size)
+  {
+    pIndex->capacity *= 2;
+  }
+
+  pIndex->pDays                = (OrderHistoryDay*)calloc(pIndex->capacity, sizeof(OrderHistoryDay));
+  pIndex->pNextOpenInDay       = (int*)malloc((size > 0 ? size : 1) * sizeof(int));
+  pIndex->pNextOpenInDayOfYear = (int*)malloc((size > 0 ? size : 1) * sizeof(int));
+  pIndex->pIndexedOrders       = (OrderInfo*)malloc((size > 0 ? size : 1) * sizeof(OrderInfo));
+  if(pIndex->pDays == NULL || pIndex->pNextOpenInDay == NULL || pIndex->pNextOpenInDayOfYear == NULL || pIndex->pIndexedOrders == NULL)
+  {
+    freeOrderHistoryIndex(pIndex);
+    return INSUFFICIENT_MEMORY;
+  }
+  pIndex->size = size;
+  if(size > 0)
+  {
+    memcpy(pIndex->pIndexedOrders, pOrders, size * sizeof(OrderInfo));
+  }
+
+  for(i = 0; i < ORDER_HISTORY_DAYS_OF_YEAR; i++)
+  {
+    initOrderHistoryDay(&pIndex->dayOfYearTotals[i], i, pIndex->pNextOpenInDayOfYear);
+  }
+
+  /* Counts are accumulated in array order so that the sums match a scan of the orders. */
+  for(i = 0; i < size; i++)
+  {
+    pIndex->pNextOpenInDay[i]       = -1;
+    pIndex->pNextOpenInDayOfYear[i] = -1;
+
+    if(pOrders[i].ticket != 0)
+    {
+      indexOrder(pIndex, i);
+    }
+  }
+
+  for(i = size - 1; i >= 0; i--)
+  {
+    if(pOrders[i].ticket != 0 && pOrders[i].isOpen)
+    {
+      linkOpenOrders(pIndex, i);
+    }
+  }
+
+  return SUCCESS;
+}
+
+/* Whether an order kept its place in the array, so that its buckets are still valid. */
+static BOOL isSameOrder(const OrderInfo* pIndexed, const OrderInfo* pOrder)
+{
+  return pIndexed->ticket == pOrder->ticket && pIndexed->type == pOrder->type && pIndexed->openTime == pOrder->openTime;
+}
+
+static BOOL isSameClosedResult(const OrderInfo* pIndexed, const OrderInfo* pOrder)
+{
+  return pIndexed->profit == pOrder->profit && pIndexed->openPrice == pOrder->openPrice && pIndexed->closePrice == pOrder->closePrice && pIndexed->lots == pOrder->lots;
+}
+
+AsirikuyReturnCode updateOrderHistoryIndex(OrderHistoryIndex* pIndex, const OrderInfo* pOrders, int size)
+{
+  int i;
+
+  if(pIndex == NULL || (pOrders == NULL && size > 0))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"updateOrderHistoryIndex() failed. pIndex or pOrders = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pIndex->pDays == NULL || size != pIndex->size)
+  {
+    freeOrderHistoryIndex(pIndex);
+    return initOrderHistoryIndex(pIndex, pOrders, size);
+  }
+
+  pIndex->pOrders = pOrders;
+
+  for(i = 0; i < size; i++)
+  {
+    OrderInfo*       pIndexed = &pIndex->pIndexedOrders[i];
+    const OrderInfo* pOrder   = &pOrders[i];
+
+    if(memcmp(pIndexed, pOrder, sizeof(OrderInfo)) == 0)
+    {
+      continue;
+    }
+
+    if(pIndexed->ticket == 0 && pOrder->ticket != 0)
+    {
+      indexOrder(pIndex, i);
+      if(pOrder->isOpen)
+      {
+        linkOpenOrders(pIndex, i);
+      }
+    }
+    else if(pIndexed->ticket != 0 || pOrder->ticket != 0)
+    {
+      if(!isSameOrder(pIndexed, pOrder) || (!pIndexed->isOpen && (pOrder->isOpen || !isSameClosedResult(pIndexed, pOrder))))
+      {
+        /* Orders were removed, moved or rewritten. This does not happen on a normal open or close. */
+        freeOrderHistoryIndex(pIndex);
+        return initOrderHistoryIndex(pIndex, pOrders, size);
+      }
+
+      if(pIndexed->isOpen && !pOrder->isOpen)
+      {
+        closeIndexedOrder(pIndex, i);
+      }
+    }
+
+    *pIndexed = *pOrder;
+  }
+
+  return SUCCESS;
+}
+
+void freeOrderHistoryIndex(OrderHistoryIndex* pIndex)
+{
+  if(pIndex == NULL)
+  {
+    return;
+  }
+
+  free(pIndex->pDays);
+  free(pIndex->pNextOpenInDay);
+  free(pIndex->pNextOpenInDayOfYear);
+  free(pIndex->pIndexedOrders);
+  pIndex->pDays                   = NULL;
+  pIndex->pNextOpenInDay          = NULL;
+  pIndex->pNextOpenInDayOfYear    = NULL;
+  pIndex->pIndexedOrders          = NULL;
+  pIndex->size                    = 0;
+  pIndex->capacity                = 0;
+  pIndex->latestOrder             = -1;
+  pIndex->latestMarketOrder       = -1;
+  pIndex->latestClosedMarketOrder = -1;
+}
+
+OrderHistoryIndex* getInstanceOrderHistoryIndex(int instanceId, BOOL isCreated)
+{
+  OrderHistoryIndex* pIndex = NULL;
+  int i;
+
+  enterCriticalSection();
+
+  if(!gInstanceHistoriesInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      memset(&gInstanceHistories[i], 0, sizeof(InstanceOrderHistory));
+      gInstanceHistories[i].instanceId = -1;
+    }
+    gInstanceHistoriesInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gInstanceHistories[i].instanceId == instanceId)
+    {
+      pIndex = &gInstanceHistories[i].index;
+      break;
+    }
+  }
+
+  if((pIndex == NULL) && isCreated)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gInstanceHistories[i].instanceId == -1)
+      {
+        gInstanceHistories[i].instanceId = instanceId;
+        pIndex = &gInstanceHistories[i].index;
+        break;
+      }
+    }
+
+    if(pIndex == NULL)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getInstanceOrderHistoryIndex() No free index for instance %d.", instanceId);
+    }
+  }
+
+  leaveCriticalSection();
+
+  return pIndex;
+}
+
+void releaseInstanceOrderHistoryIndex(int instanceId)
+{
+  int i;
+
+  enterCriticalSection();
+
+  if(gInstanceHistoriesInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gInstanceHistories[i].instanceId == instanceId)
+      {
+        freeOrderHistoryIndex(&gInstanceHistories[i].index);
+        memset(&gInstanceHistories[i], 0, sizeof(InstanceOrderHistory));
+        gInstanceHistories[i].instanceId = -1;
+      }
+    }
+  }
+
+  leaveCriticalSection();
+}
+
+const OrderHistoryDay* findOrderHistoryDay(const OrderHistoryIndex* pIndex, time_t time)
+{
+  const OrderHistoryDay* pDay;
+  CalendarDay calendarDay;
+
+  if(pIndex->pDays == NULL)
+  {
+    return NULL;
+  }
+
+  getCalendarDay(&calendarDay, time);
+  pDay = findSlot(pIndex, calendarDay.dayNumber);
+
+  return pDay->orders != 0 ? pDay : NULL;
+}
+
+int findOrderHistoryWeekDays(const OrderHistoryIndex* pIndex, time_t time, const OrderHistoryDay* pWeekDays[])
+{
+  CalendarDay calendarDay;
+  int monday, friday, day, lastDayOfYear;
+  int totalDays = 0;
+
+  if(pIndex->pDays == NULL)
+  {
+    return 0;
+  }
+
+  getCalendarDay(&calendarDay, time);
+
+  monday = calendarDay.dayOfYear - calendarDay.dayOfWeek + 1;
+  friday = calendarDay.dayOfYear - calendarDay.dayOfWeek + 5;
+
+  if(monday >= 0)
+  {
+    /* Days past the end of the year belong to the next year and are not part of the week. */
+    lastDayOfYear = (int)(daysFromCivil(calendarDay.year + 1, 0, 1) - daysFromCivil(calendarDay.year, 0, 1)) - 1;
+    if(friday > lastDayOfYear)
+    {
+      friday = lastDayOfYear;
+    }
+
+    for(day = monday; day <= friday; day++)
+    {
+      const OrderHistoryDay* pDay = findSlot(pIndex, calendarDay.dayNumber - calendarDay.dayOfYear + day);
+      if(pDay->orders != 0)
+      {
+        pWeekDays[totalDays++] = pDay;
+      }
+    }
+  }
+  else
+  {
+    /* The week starts in the previous year: early January days match as they are, the others as
+       days of a 365 day year before it. */
+    for(day = 0; day <= friday && day < 7; day++)
+    {
+      if(pIndex->dayOfYearTotals[day].orders != 0)
+      {
+        pWeekDays[totalDays++] = &pIndex->dayOfYearTotals[day];
+      }
+    }
+    for(day = monday + 365; day <= friday + 365 && day < ORDER_HISTORY_DAYS_OF_YEAR; day++)
+    {
+      if(day >= 7 && pIndex->dayOfYearTotals[day].orders != 0)
+      {
+        pWeekDays[totalDays++] = &pIndex->dayOfYearTotals[day];
+      }
+    }
+  }
+
+  return totalDays;
+}
+
+/* Adds the open orders of a bucket that are losing at the current prices. */
+static int addOpenLosses(const OrderHistoryIndex* pIndex, const OrderHistoryDay* pDay, double bid, double ask, double buyLossPrice, double* pLostPips)
+{
+  int lossTimes = 0;
+  int i;
+
+  for(i = pDay->firstOpenOrder; i >= 0; i = pDay->pNextOpenOrder[i])
+  {
+    const OrderInfo* pOrder = &pIndex->pOrders[i];
+
+    if(pOrder->type == BUY && ask < pOrder->openPrice)
+    {
+      lossTimes++;
+      *pLostPips += fabs(buyLossPrice - pOrder->openPrice) * pOrder->lots;
+    }
+
+    if(pOrder->type == SELL && bid > pOrder->openPrice)
+    {
+      lossTimes++;
+      *pLostPips += fabs(bid - pOrder->openPrice) * pOrder->lots;
+    }
+  }
+
+  return lossTimes;
+}
+
+/* Adds the open orders of a bucket that are past their take profit at the current prices. */
+static int addOpenWins(const OrderHistoryIndex* pIndex, const OrderHistoryDay* pDay, double bid, double ask, BOOL skipWithoutTakeProfit)
+{
+  int winningTimes = 0;
+  int i;
+
+  for(i = pDay->firstOpenOrder; i >= 0; i = pDay->pNextOpenOrder[i])
+  {
+    const OrderInfo* pOrder = &pIndex->pOrders[i];
+
+    if(skipWithoutTakeProfit && pOrder->takeProfit <= 0)
+    {
+      continue;
+    }
+
+    if(pOrder->type == BUY && ask > pOrder->takeProfit)
+    {
+      winningTimes++;
+    }
+
+    if(pOrder->type == SELL && bid < pOrder->takeProfit)
+    {
+      winningTimes++;
+    }
+  }
+
+  return winningTimes;
+}
+
+int getOrderHistoryLossesInDay(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask, double* pLostPips)
+{
+  const OrderHistoryDay* pDay = findOrderHistoryDay(pIndex, time);
+
+  *pLostPips = 0;
+  if(pDay == NULL)
+  {
+    return 0;
+  }
+
+  *pLostPips = pDay->closedLossPips;
+  return pDay->closedLosses + addOpenLosses(pIndex, pDay, bid, ask, ask, pLostPips);
+}
+
+int getOrderHistoryLossesInWeek(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask, double* pLostPips)
+{
+  const OrderHistoryDay* pWeekDays[ORDER_HISTORY_MAX_WEEK_DAYS];
+  int totalDays = findOrderHistoryWeekDays(pIndex, time, pWeekDays);
+  int lossTimes = 0;
+  int i;
+
+  *pLostPips = 0;
+  for(i = 0; i < totalDays; i++)
+  {
+    *pLostPips += pWeekDays[i]->closedLossPips;
+    lossTimes  += pWeekDays[i]->closedLosses + addOpenLosses(pIndex, pWeekDays[i], bid, ask, bid, pLostPips);
+  }
+
+  return lossTimes;
+}
+
+int getOrderHistoryWinsInDay(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask)
+{
+  const OrderHistoryDay* pDay = findOrderHistoryDay(pIndex, time);
+
+  if(pDay == NULL)
+  {
+    return 0;
+  }
+
+  return pDay->closedWins + addOpenWins(pIndex, pDay, bid, ask, TRUE);
+}
+
+int getOrderHistoryWinsInWeek(const OrderHistoryIndex* pIndex, time_t time, double bid, double ask)
+{
+  const OrderHistoryDay* pWeekDays[ORDER_HISTORY_MAX_WEEK_DAYS];
+  int totalDays = findOrderHistoryWeekDays(pIndex, time, pWeekDays);
+  int winningTimes = 0;
+  int i;
+
+  for(i = 0; i < totalDays; i++)
+  {
+    winningTimes += pWeekDays[i]->closedWins + addOpenWins(pIndex, pWeekDays[i], bid, ask, FALSE);
+  }
+
+  return winningTimes;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file
+ * @brief     Current day and week bars aggregated incrementally from intraday rates.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "SessionBars.h"
+#include "Calendar.h"
+#include "CriticalSection.h"
+#include "TimeIndex.h"
+
+static SessionTracker gSessionTrackers[MAX_INSTANCES];
+static BOOL           gSessionTrackersInitialized = FALSE;
+
+time_t getSessionKey(SessionType type, time_t time)
+{
+  CalendarDay calendarDay;
+
+  getCalendarDay(&calendarDay, time);
+
+  if(type == SESSION_WEEK)
+  {
+    /* 01/01/1970 was a Thursday, so shifting by 4 days makes weeks start on Sunday. */
+    time_t shiftedDay = calendarDay.dayNumber + 4;
+    return (shiftedDay >= 0) ? shiftedDay / 7 : -((-shiftedDay + 6) / 7);
+  }
+
+  return calendarDay.dayNumber;
+}
+
+static void clearSessionBar(SessionBar* pSession)
+{
+  memset(pSession, 0, sizeof(SessionBar));
+  pSession->startIndex = -1;
+}
+
+static void foldSessionBar(SessionBar* pSession, SessionType type, const Rates* pSource, int index)
+{
+  time_t key = getSessionKey(type, pSource->time[index]);
+
+  if((pSession->startIndex < 0) || (key != pSession->key))
+  {
+    pSession->key        = key;
+    pSession->time       = pSource->time[index];
+    pSession->startIndex = index;
+    pSession->bars       = 1;
+    pSession->open       = pSource->open[index];
+    pSession->high       = pSource->high[index];
+    pSession->low        = pSource->low[index];
+    pSession->close      = pSource->close[index];
+    pSession->volume     = pSource->volume[index];
+    return;
+  }
+
+  if(pSource->high[index] > pSession->high)
+  {
+    pSession->high = pSource->high[index];
+  }
+
+  if(pSource->low[index] < pSession->low)
+  {
+    pSession->low = pSource->low[index];
+  }
+
+  pSession->close   = pSource->close[index];
+  pSession->volume += pSource->volume[index];
+  pSession->bars++;
+}
+
+static void foldSourceBars(SessionTracker* pTracker, const Rates* pSource, int first, int last)
+{
+  int i, type;
+
+  for(i = first; i <= last; i++)
+  {
+    for(type = 0; type < TOTAL_SESSION_TYPES; type++)
+    {
+      foldSessionBar(&pTracker->sessions[type], (SessionType)type, pSource, i);
+    }
+  }
+
+  if(last >= first)
+  {
+    pTracker->lastConsumedIndex = last;
+    pTracker->lastConsumedTime  = pSource->time[last];
+  }
+}
+
+/* A day never spans more bars than its week, so walking back over the week covers both sessions. */
+static void rebuildSessions(SessionTracker* pTracker, const Rates* pSource, int lastClosedIndex)
+{
+  time_t weekKey = getSessionKey(SESSION_WEEK, pSource->time[lastClosedIndex]);
+  int    first   = lastClosedIndex;
+  int    type;
+
+  while((first > 0) && (getSessionKey(SESSION_WEEK, pSource->time[first - 1]) == weekKey))
+  {
+    first--;
+  }
+
+  for(type = 0; type < TOTAL_SESSION_TYPES; type++)
+  {
+    clearSessionBar(&pTracker->sessions[type]);
+  }
+
+  foldSourceBars(pTracker, pSource, first, lastClosedIndex);
+  pTracker->isBuilt = TRUE;
+}
+
+void initSessionTracker(SessionTracker* pTracker)
+{
+  int type;
+
+  memset(pTracker, 0, sizeof(SessionTracker));
+  pTracker->instanceId        = -1;
+  pTracker->lastConsumedIndex = -1;
+
+  for(type = 0; type < TOTAL_SESSION_TYPES; type++)
+  {
+    clearSessionBar(&pTracker->sessions[type]);
+  }
+}
+
+AsirikuyReturnCode updateSessionTracker(SessionTracker* pTracker, const Rates* pSource)
+{
+  int lastClosedIndex, consumedIndex, offset, type;
+
+  if(pTracker == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"updateSessionTracker() failed. pTracker = NULL");
+    return NULL_POINTER;
+  }
+
+  if((pSource == NULL) || (pSource->time == NULL))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"updateSessionTracker() failed. pSource = NULL");
+    return NULL_POINTER;
+  }
+
+  lastClosedIndex = pSource->info.arraySize - 2;
+  if(lastClosedIndex < 0)
+  {
+    for(type = 0; type < TOTAL_SESSION_TYPES; type++)
+    {
+      clearSessionBar(&pTracker->sessions[type]);
+    }
+    pTracker->isBuilt           = FALSE;
+    pTracker->lastConsumedIndex = -1;
+    return SUCCESS;
+  }
+
+  if(!pTracker->isBuilt)
+  {
+    rebuildSessions(pTracker, pSource, lastClosedIndex);
+    return SUCCESS;
+  }
+
+  /* The buffer may have grown or slid forward since the last run, so locate the last consumed bar by its time. */
+  consumedIndex = pTracker->lastConsumedIndex;
+  if((consumedIndex > lastClosedIndex) || (pSource->time[consumedIndex] != pTracker->lastConsumedTime))
+  {
+    consumedIndex = searchTimeUpperBound(pSource->time, lastClosedIndex + 1, pTracker->lastConsumedTime) - 1;
+  }
+
+  if((consumedIndex < 0) || (pSource->time[consumedIndex] != pTracker->lastConsumedTime))
+  {
+    rebuildSessions(pTracker, pSource, lastClosedIndex);
+    return SUCCESS;
+  }
+
+  /* A session which started before the oldest bar of a sliding buffer keeps its aggregate and points at the oldest bar. */
+  offset = consumedIndex - pTracker->lastConsumedIndex;
+  for(type = 0; type < TOTAL_SESSION_TYPES; type++)
+  {
+    if(pTracker->sessions[type].startIndex >= 0)
+    {
+      pTracker->sessions[type].startIndex += offset;
+      if(pTracker->sessions[type].startIndex < 0)
+      {
+        pTracker->sessions[type].startIndex = 0;
+      }
+    }
+  }
+
+  pTracker->lastConsumedIndex = consumedIndex;
+  foldSourceBars(pTracker, pSource, consumedIndex + 1, lastClosedIndex);
+
+  return SUCCESS;
+}
+
+const SessionBar* getSessionBar(const SessionTracker* pTracker, SessionType type)
+{
+  return &pTracker->sessions[type];
+}
+
+SessionTracker* getSessionTracker(int instanceId, BOOL isCreated)
+{
+  SessionTracker* pTracker = NULL;
+  int i;
+
+  enterCriticalSection();
+
+  if(!gSessionTrackersInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      initSessionTracker(&gSessionTrackers[i]);
+    }
+    gSessionTrackersInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gSessionTrackers[i].instanceId == instanceId)
+    {
+      pTracker = &gSessionTrackers[i];
+      break;
+    }
+  }
+
+  if((pTracker == NULL) && isCreated)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gSessionTrackers[i].instanceId == -1)
+      {
+        pTracker = &gSessionTrackers[i];
+        pTracker->instanceId = instanceId;
+        break;
+      }
+    }
+
+    if(pTracker == NULL)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getSessionTracker() No free tracker for instance %d.", instanceId);
+    }
+  }
+
+  leaveCriticalSection();
+
+  return pTracker;
+}
+
+void releaseInstanceSessionTracker(int instanceId)
+{
+  int i;
+
+  enterCriticalSection();
+
+  if(gSessionTrackersInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if(gSessionTrackers[i].instanceId == instanceId)
+      {
+        initSessionTracker(&gSessionTrackers[i]);
+      }
+    }
+  }
+
+  leaveCriticalSection();
+}
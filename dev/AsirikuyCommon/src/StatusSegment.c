@@ -0,0 +1,405 @@
+/**
+ * @file
+ * @brief     Shared memory segment with the live status of every strategy instance.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "StatusSegment.h"
+#include "CriticalSection.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+#elif defined __linux__ || defined __APPLE__
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sched.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#else
+  #error "Unsupported operating system"
+#endif
+
+#define MAX_READ_ATTEMPTS 100
+
+static StatusSegment* gStatusSegment = NULL;
+#if defined _WIN32 || defined _WIN64
+static HANDLE         gStatusMapping = NULL;
+#endif
+
+static BOOL compareAndSwap(volatile int* pValue, int expected, int desired)
+{
+#if defined _WIN32 || defined _WIN64
+  return InterlockedCompareExchange((volatile LONG*)pValue, desired, expected) == expected;
+#else
+  return __sync_bool_compare_and_swap(pValue, expected, desired);
+#endif
+}
+
+static void atomicIncrement(volatile int* pValue)
+{
+#if defined _WIN32 || defined _WIN64
+  InterlockedIncrement((volatile LONG*)pValue);
+#else
+  __sync_fetch_and_add(pValue, 1);
+#endif
+}
+
+static void yieldThread()
+{
+#if defined _WIN32 || defined _WIN64
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+static void memoryBarrier()
+{
+#if defined _WIN32 || defined _WIN64
+  MemoryBarrier();
+#else
+  __sync_synchronize();
+#endif
+}
+
+static BOOL isStatusSegmentReady(const StatusSegment* pSegment)
+{
+  return (pSegment->magic == STATUS_SEGMENT_MAGIC)
+    && (pSegment->version == STATUS_SEGMENT_VERSION)
+    && (pSegment->totalInstances == MAX_INSTANCES)
+    && (pSegment->totalSymbols == STATUS_MAX_SYMBOLS);
+}
+
+/* Maps the named segment. Sets *pIsNew when this call created it. */
+static StatusSegment* mapStatusSegment(BOOL isCreated, BOOL* pIsNew)
+{
+  StatusSegment* pSegment = NULL;
+
+  *pIsNew = FALSE;
+
+#if defined _WIN32 || defined _WIN64
+  if(isCreated)
+  {
+    gStatusMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(StatusSegment), STATUS_SEGMENT_NAME);
+    *pIsNew = (gStatusMapping != NULL) && (GetLastError() != ERROR_ALREADY_EXISTS);
+  }
+  else
+  {
+    gStatusMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, STATUS_SEGMENT_NAME);
+  }
+
+  if(gStatusMapping == NULL)
+  {
+    return NULL;
+  }
+
+  pSegment = (StatusSegment*)MapViewOfFile(gStatusMapping, isCreated ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, sizeof(StatusSegment));
+  if(pSegment == NULL)
+  {
+    CloseHandle(gStatusMapping);
+    gStatusMapping = NULL;
+  }
+#elif defined __linux__ || defined __APPLE__
+  struct stat segmentStat;
+  void*       pMapping;
+  int         fd = -1;
+
+  if(isCreated)
+  {
+    fd = shm_open(STATUS_SEGMENT_NAME, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if(fd >= 0)
+    {
+      *pIsNew = TRUE;
+      if(ftruncate(fd, (off_t)sizeof(StatusSegment)) != 0)
+      {
+        close(fd);
+        shm_unlink(STATUS_SEGMENT_NAME);
+        return NULL;
+      }
+    }
+    else
+    {
+      fd = shm_open(STATUS_SEGMENT_NAME, O_RDWR, 0644);
+    }
+  }
+  else
+  {
+    fd = shm_open(STATUS_SEGMENT_NAME, O_RDONLY, 0);
+  }
+
+  if(fd < 0)
+  {
+    return NULL;
+  }
+
+  /* The creator may not have sized the segment yet. */
+  if((fstat(fd, &segmentStat) != 0) || ((size_t)segmentStat.st_size < sizeof(StatusSegment)))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  pMapping = mmap(NULL, sizeof(StatusSegment), isCreated ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(pMapping != MAP_FAILED)
+  {
+    pSegment = (StatusSegment*)pMapping;
+  }
+#endif
+
+  return pSegment;
+}
+
+static void unmapStatusSegment(StatusSegment* pSegment)
+{
+#if defined _WIN32 || defined _WIN64
+  UnmapViewOfFile(pSegment);
+  CloseHandle(gStatusMapping);
+  gStatusMapping = NULL;
+#elif defined __linux__ || defined __APPLE__
+  munmap(pSegment, sizeof(StatusSegment));
+#endif
+}
+
+StatusSegment* openStatusSegment(BOOL isCreated)
+{
+  StatusSegment* pSegment;
+  BOOL           isNew;
+
+  if(gStatusSegment != NULL)
+  {
+    return gStatusSegment;
+  }
+
+  enterCriticalSection();
+
+  if(gStatusSegment != NULL)
+  {
+    leaveCriticalSection();
+    return gStatusSegment;
+  }
+
+  pSegment = mapStatusSegment(isCreated, &isNew);
+  if(pSegment != NULL)
+  {
+    if(isNew)
+    {
+      /* A new segment reads as zeros, so every slot is already free. */
+      pSegment->version        = STATUS_SEGMENT_VERSION;
+      pSegment->totalInstances = MAX_INSTANCES;
+      pSegment->totalSymbols   = STATUS_MAX_SYMBOLS;
+      memoryBarrier();
+      pSegment->magic          = STATUS_SEGMENT_MAGIC;
+      pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"openStatusSegment() Created status segment %s.", STATUS_SEGMENT_NAME);
+    }
+
+    if(isStatusSegmentReady(pSegment))
+    {
+      gStatusSegment = pSegment;
+    }
+    else
+    {
+      if(pSegment->magic == STATUS_SEGMENT_MAGIC)
+      {
+        pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openStatusSegment() Status segment %s has an incompatible layout.", STATUS_SEGMENT_NAME);
+      }
+      unmapStatusSegment(pSegment);
+    }
+  }
+
+  leaveCriticalSection();
+
+  return gStatusSegment;
+}
+
+void closeStatusSegment()
+{
+  enterCriticalSection();
+
+  if(gStatusSegment != NULL)
+  {
+    unmapStatusSegment(gStatusSegment);
+    gStatusSegment = NULL;
+  }
+
+  leaveCriticalSection();
+}
+
+InstanceStatus* getInstanceStatus(int instanceId)
+{
+  StatusSegment* pSegment = openStatusSegment(TRUE);
+  int            owner = instanceId + 1, i;
+
+  if(pSegment == NULL)
+  {
+    return NULL;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(pSegment->instances[i].owner == owner)
+    {
+      return &pSegment->instances[i];
+    }
+  }
+
+  /* Slots are claimed atomically because other processes share the segment. */
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if((pSegment->instances[i].owner == 0) && compareAndSwap(&pSegment->instances[i].owner, 0, owner))
+    {
+      return &pSegment->instances[i];
+    }
+  }
+
+  return NULL;
+}
+
+void releaseInstanceStatus(int instanceId)
+{
+  StatusSegment* pSegment = gStatusSegment;
+  int            owner = instanceId + 1, i;
+
+  if(pSegment == NULL)
+  {
+    return;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(pSegment->instances[i].owner == owner)
+    {
+      beginStatusWrite(&pSegment->instances[i].sequence);
+      pSegment->instances[i].heartBeatTime = 0;
+      pSegment->instances[i].heartBeatHour = 0;
+      pSegment->instances[i].uiValuesCount = 0;
+      endStatusWrite(&pSegment->instances[i].sequence);
+      compareAndSwap(&pSegment->instances[i].owner, owner, 0);
+      return;
+    }
+  }
+}
+
+SymbolStatus* getSymbolStatus(const char* pSymbol)
+{
+  StatusSegment* pSegment = openStatusSegment(TRUE);
+  SymbolStatus*  pStatus;
+  int            i;
+
+  if(pSegment == NULL)
+  {
+    return NULL;
+  }
+
+  for(i = 0; i < STATUS_MAX_SYMBOLS; i++)
+  {
+    pStatus = &pSegment->symbols[i];
+    if((pStatus->state == STATUS_SLOT_USED) && (strncmp(pStatus->symbol, pSymbol, STATUS_SYMBOL_SIZE - 1) == 0))
+    {
+      return pStatus;
+    }
+  }
+
+  /* The name is written before the slot is published. Two writers racing for a new symbol may each get a slot, readers use the first. */
+  for(i = 0; i < STATUS_MAX_SYMBOLS; i++)
+  {
+    pStatus = &pSegment->symbols[i];
+    if((pStatus->state == STATUS_SLOT_FREE) && compareAndSwap(&pStatus->state, STATUS_SLOT_FREE, STATUS_SLOT_CLAIMED))
+    {
+      strncpy(pStatus->symbol, pSymbol, STATUS_SYMBOL_SIZE - 1);
+      pStatus->symbol[STATUS_SYMBOL_SIZE - 1] = '\0';
+      memoryBarrier();
+      pStatus->state = STATUS_SLOT_USED;
+      return pStatus;
+    }
+  }
+
+  return NULL;
+}
+
+/* An odd sequence is also the writer lock. Symbol slots are written by every instance of every terminal mapping the segment, so the sequence is only ever moved atomically. */
+void beginStatusWrite(volatile int* pSequence)
+{
+  int sequence;
+
+  for(;;)
+  {
+    sequence = *pSequence;
+    if(!(sequence & 1) && compareAndSwap(pSequence, sequence, sequence + 1))
+    {
+      return;
+    }
+    yieldThread();
+  }
+}
+
+void endStatusWrite(volatile int* pSequence)
+{
+  atomicIncrement(pSequence);
+}
+
+/* Copies a slot between two reads of its sequence. The copy is only consistent if the sequence was even and didn't change. */
+static BOOL readStatusSlot(const volatile int* pSequence, const void* pSlot, void* pCopy, size_t size)
+{
+  int attempt, sequence;
+
+  for(attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++)
+  {
+    sequence = *pSequence;
+    if(sequence & 1)
+    {
+      continue;
+    }
+
+    memoryBarrier();
+    memcpy(pCopy, pSlot, size);
+    memoryBarrier();
+
+    if(*pSequence == sequence)
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+BOOL readInstanceStatus(const InstanceStatus* pStatus, InstanceStatus* pCopy)
+{
+  return readStatusSlot(&pStatus->sequence, pStatus, pCopy, sizeof(InstanceStatus));
+}
+
+BOOL readSymbolStatus(const SymbolStatus* pStatus, SymbolStatus* pCopy)
+{
+  return readStatusSlot(&pStatus->sequence, pStatus, pCopy, sizeof(SymbolStatus));
+}
@@ -0,0 +1,382 @@
+/**
+ * @file
+ * @brief     Memory mapped ring journal of the ticks received by a strategy instance.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "TickJournal.h"
+#include "CriticalSection.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+#elif defined __linux__ || defined __APPLE__
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#else
+  #error "Unsupported operating system"
+#endif
+
+static BOOL isTickJournalHeaderValid(const TickJournalHeader* pHeader, int capacity)
+{
+  return (pHeader->magic == TICK_JOURNAL_MAGIC)
+    && (pHeader->version == TICK_JOURNAL_VERSION)
+    && (pHeader->capacity == capacity)
+    && (pHeader->head >= 0) && (pHeader->head < capacity)
+    && (pHeader->count >= 0) && (pHeader->count <= capacity);
+}
+
+static void unmapTickJournal(TickJournal* pJournal)
+{
+#if defined _WIN32 || defined _WIN64
+  if(pJournal->pHeader != NULL)
+  {
+    UnmapViewOfFile(pJournal->pHeader);
+  }
+  if(pJournal->hMapping != NULL)
+  {
+    CloseHandle((HANDLE)pJournal->hMapping);
+  }
+  if(pJournal->hFile != NULL)
+  {
+    CloseHandle((HANDLE)pJournal->hFile);
+  }
+#elif defined __linux__ || defined __APPLE__
+  if(pJournal->pHeader != NULL)
+  {
+    munmap(pJournal->pHeader, pJournal->mappedSize);
+  }
+  if(pJournal->fd >= 0)
+  {
+    close(pJournal->fd);
+  }
+#endif
+
+  pJournal->pHeader    = NULL;
+  pJournal->pRecords   = NULL;
+  pJournal->mappedSize = 0;
+  pJournal->hFile      = NULL;
+  pJournal->hMapping   = NULL;
+  pJournal->fd         = -1;
+}
+
+/* Maps the file at the given size, growing or shrinking it first if needed. Returns FALSE on failure. */
+static BOOL mapTickJournal(TickJournal* pJournal, const char* pPath, size_t size)
+{
+#if defined _WIN32 || defined _WIN64
+  LARGE_INTEGER fileSize;
+  HANDLE        hFile;
+
+  hFile = CreateFileA(pPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(hFile == INVALID_HANDLE_VALUE)
+  {
+    return FALSE;
+  }
+  pJournal->hFile = hFile;
+
+  if(!GetFileSizeEx(hFile, &fileSize) || ((size_t)fileSize.QuadPart != size))
+  {
+    fileSize.QuadPart = (LONGLONG)size;
+    if(!SetFilePointerEx(hFile, fileSize, NULL, FILE_BEGIN) || !SetEndOfFile(hFile))
+    {
+      return FALSE;
+    }
+  }
+
+  pJournal->hMapping = CreateFileMappingA(hFile, NULL, PAGE_READWRITE, 0, 0, NULL);
+  if(pJournal->hMapping == NULL)
+  {
+    return FALSE;
+  }
+
+  pJournal->pHeader = (TickJournalHeader*)MapViewOfFile((HANDLE)pJournal->hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if(pJournal->pHeader == NULL)
+  {
+    return FALSE;
+  }
+#elif defined __linux__ || defined __APPLE__
+  struct stat fileStat;
+  void*       pMapping;
+
+  pJournal->fd = open(pPath, O_RDWR | O_CREAT, 0644);
+  if(pJournal->fd < 0)
+  {
+    return FALSE;
+  }
+
+  if((fstat(pJournal->fd, &fileStat) != 0) || ((size_t)fileStat.st_size != size))
+  {
+    if(ftruncate(pJournal->fd, (off_t)size) != 0)
+    {
+      return FALSE;
+    }
+  }
+
+  pMapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, pJournal->fd, 0);
+  if(pMapping == MAP_FAILED)
+  {
+    return FALSE;
+  }
+  pJournal->pHeader = (TickJournalHeader*)pMapping;
+#endif
+
+  pJournal->mappedSize = size;
+  pJournal->pRecords   = (TickRecord*)(pJournal->pHeader + 1);
+  return TRUE;
+}
+
+AsirikuyReturnCode openTickJournal(TickJournal* pJournal, const char* pPath, int capacity, BOOL* pIsCreated)
+{
+  size_t size = sizeof(TickJournalHeader) + (size_t)capacity * sizeof(TickRecord);
+
+  if(pIsCreated != NULL)
+  {
+    *pIsCreated = FALSE;
+  }
+
+  memset(pJournal, 0, sizeof(TickJournal));
+  pJournal->instanceId = -1;
+  pJournal->fd         = -1;
+
+  if(capacity <= 0)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openTickJournal() Invalid capacity %d.", capacity);
+    return INVALID_PARAMETER;
+  }
+
+  if(!mapTickJournal(pJournal, pPath, size))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openTickJournal() Failed to map tick journal %s.", pPath);
+    unmapTickJournal(pJournal);
+    return FILE_WRITING_ERROR;
+  }
+
+  if(!isTickJournalHeaderValid(pJournal->pHeader, capacity))
+  {
+    /* A new file reads as zeros so this also initializes created journals. */
+    if(pJournal->pHeader->magic != 0)
+    {
+      pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"openTickJournal() Reinitializing tick journal %s.", pPath);
+    }
+    pJournal->pHeader->magic    = TICK_JOURNAL_MAGIC;
+    pJournal->pHeader->version  = TICK_JOURNAL_VERSION;
+    pJournal->pHeader->capacity = capacity;
+    pJournal->pHeader->reserved = 0;
+    resetTickJournal(pJournal);
+
+    if(pIsCreated != NULL)
+    {
+      *pIsCreated = TRUE;
+    }
+  }
+
+  return SUCCESS;
+}
+
+void closeTickJournal(TickJournal* pJournal)
+{
+  unmapTickJournal(pJournal);
+  pJournal->instanceId = -1;
+}
+
+void resetTickJournal(TickJournal* pJournal)
+{
+  pJournal->pHeader->head  = 0;
+  pJournal->pHeader->count = 0;
+}
+
+void appendTickJournal(TickJournal* pJournal, int time, double bid, double ask)
+{
+  TickJournalHeader* pHeader  = pJournal->pHeader;
+  int                capacity = pHeader->capacity;
+  int                slot     = pHeader->head + pHeader->count;
+  TickRecord*        pRecord;
+
+  if(slot >= capacity)
+  {
+    slot -= capacity;
+  }
+
+  pRecord = &pJournal->pRecords[slot];
+  pRecord->time     = time;
+  pRecord->reserved = 0;
+  pRecord->bid      = bid;
+  pRecord->ask      = ask;
+
+  /* The record is written before the header publishes it. */
+  if(pHeader->count < capacity)
+  {
+    pHeader->count++;
+  }
+  else
+  {
+    pHeader->head = (pHeader->head + 1 == capacity) ? 0 : pHeader->head + 1;
+  }
+}
+
+int getTickJournalCount(const TickJournal* pJournal)
+{
+  return pJournal->pHeader->count;
+}
+
+const TickRecord* getTickJournalRecord(const TickJournal* pJournal, int index)
+{
+  int slot = pJournal->pHeader->head + index;
+
+  if(slot >= pJournal->pHeader->capacity)
+  {
+    slot -= pJournal->pHeader->capacity;
+  }
+
+  return &pJournal->pRecords[slot];
+}
+
+AsirikuyReturnCode importTickJournalCSV(TickJournal* pJournal, const char* pCsvPath, int* pImported)
+{
+  char   data[200];
+  int    time, imported = 0;
+  double bid, ask;
+  FILE*  fp;
+
+  if(pImported != NULL)
+  {
+    *pImported = 0;
+  }
+
+  fp = fopen(pCsvPath, "r");
+  if(fp == NULL)
+  {
+    /* Nothing to import. */
+    return SUCCESS;
+  }
+
+  while(fgets(data, sizeof(data), fp) != NULL)
+  {
+    if(sscanf(data, "%d,%lf,%lf", &time, &bid, &ask) == 3)
+    {
+      appendTickJournal(pJournal, time, bid, ask);
+      imported++;
+    }
+  }
+
+  fclose(fp);
+
+  pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"importTickJournalCSV() Imported %d ticks from %s.", imported, pCsvPath);
+
+  if(pImported != NULL)
+  {
+    *pImported = imported;
+  }
+
+  return SUCCESS;
+}
+
+static TickJournal gTickJournals[MAX_INSTANCES];
+static BOOL        gTickJournalsInitialized = FALSE;
+
+AsirikuyReturnCode getInstanceTickJournal(int instanceId, const char* pPath, const char* pCsvPath, TickJournal** ppJournal)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+  TickJournal*       pJournal = NULL;
+  BOOL               isCreated;
+  int                i;
+
+  *ppJournal = NULL;
+
+  enterCriticalSection();
+
+  if(!gTickJournalsInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      gTickJournals[i].instanceId = -1;
+    }
+    gTickJournalsInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gTickJournals[i].instanceId == instanceId)
+    {
+      *ppJournal = &gTickJournals[i];
+      leaveCriticalSection();
+      return SUCCESS;
+    }
+
+    if((pJournal == NULL) && (gTickJournals[i].instanceId == -1))
+    {
+      pJournal = &gTickJournals[i];
+    }
+  }
+
+  if(pJournal == NULL)
+  {
+    leaveCriticalSection();
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getInstanceTickJournal() No free tick journal for instance %d.", instanceId);
+    return TOO_MANY_INSTANCES;
+  }
+
+  returnCode = openTickJournal(pJournal, pPath, TICK_DATA_STORAGE_LIMIT, &isCreated);
+  if(returnCode == SUCCESS)
+  {
+    pJournal->instanceId = instanceId;
+    if(isCreated && (pCsvPath != NULL))
+    {
+      returnCode = importTickJournalCSV(pJournal, pCsvPath, NULL);
+    }
+    *ppJournal = pJournal;
+  }
+
+  leaveCriticalSection();
+
+  return returnCode;
+}
+
+void closeInstanceTickJournal(int instanceId)
+{
+  int i;
+
+  enterCriticalSection();
+
+  for(i = 0; gTickJournalsInitialized && (i < MAX_INSTANCES); i++)
+  {
+    if(gTickJournals[i].instanceId == instanceId)
+    {
+      closeTickJournal(&gTickJournals[i]);
+      break;
+    }
+  }
+
+  leaveCriticalSection();
+}
@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @brief     Time-indexed seek over rates arrays.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "TimeIndex.h"
+
+static time_t dayNumber(time_t time)
+{
+  /* Floor division so that times before the epoch land on the correct day. */
+  time_t day = time / SECONDS_PER_DAY;
+  if((time % SECONDS_PER_DAY) < 0)
+  {
+    day--;
+  }
+  return day;
+}
+
+time_t timeIndexTimeAt(const TimeIndex* pIndex, int index)
+{
+  const char* pField = pIndex->pFirstTime + (size_t)index * pIndex->stride;
+
+  if(pIndex->fieldSize == sizeof(time_t))
+  {
+    time_t time;
+    memcpy(&time, pField, sizeof(time_t));
+    return time;
+  }
+  else
+  {
+    int time;
+    memcpy(&time, pField, sizeof(int));
+    return (time_t)time;
+  }
+}
+
+AsirikuyReturnCode initTimeIndex(TimeIndex* pIndex, const void* pFirstTime, size_t stride, size_t fieldSize, int size)
+{
+  int    i, day;
+  time_t lastDay;
+
+  if(pIndex == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"initTimeIndex() failed. pIndex = NULL");
+    return NULL_POINTER;
+  }
+
+  pIndex->pFirstTime = (const char*)pFirstTime;
+  pIndex->stride     = stride;
+  pIndex->fieldSize  = fieldSize;
+  pIndex->size       = 0;
+  pIndex->firstDay   = 0;
+  pIndex->totalDays  = 0;
+  pIndex->pDayStart  = NULL;
+
+  if(pFirstTime == NULL || size <= 0)
+  {
+    return SUCCESS;
+  }
+
+  if(fieldSize != sizeof(int) && fieldSize != sizeof(time_t))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"initTimeIndex() failed. Unsupported time field size = %d", (int)fieldSize);
+    return INVALID_PARAMETER;
+  }
+
+  /* Only index the valid part of the array. A negative time marks the end of the data. */
+  while(pIndex->size < size && timeIndexTimeAt(pIndex, pIndex->size) >= 0)
+  {
+    pIndex->size++;
+  }
+
+  if(pIndex->size == 0)
+  {
+    return SUCCESS;
+  }
+
+  pIndex->firstDay  = dayNumber(timeIndexTimeAt(pIndex, 0));
+  lastDay           = dayNumber(timeIndexTimeAt(pIndex, pIndex->size - 1));
+  pIndex->totalDays = (int)(lastDay - pIndex->firstDay + 1);
+
+  if(pIndex->totalDays <= 0)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"initTimeIndex() failed. Times are not in ascending order.");
+    pIndex->size      = 0;
+    pIndex->totalDays = 0;
+    return INVALID_PARAMETER;
+  }
+
+  pIndex->pDayStart = (int*)malloc((pIndex->totalDays + 1) * sizeof(int));
+  if(pIndex->pDayStart == NULL)
+  {
+    pIndex->size      = 0;
+    pIndex->totalDays = 0;
+    return INSUFFICIENT_MEMORY;
+  }
+
+  /* Single forward pass. Days without bars point at the first bar of the next trading day. */
+  day = 0;
+  for(i = 0; i < pIndex->size; i++)
+  {
+    int barDay = (int)(dayNumber(timeIndexTimeAt(pIndex, i)) - pIndex->firstDay);
+    while(day <= barDay)
+    {
+      pIndex->pDayStart[day++] = i;
+    }
+  }
+  while(day <= pIndex->totalDays)
+  {
+    pIndex->pDayStart[day++] = pIndex->size;
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode initTimeIndexFromTimes(TimeIndex* pIndex, const time_t* pTimes, int size)
+{
+  return initTimeIndex(pIndex, pTimes, sizeof(time_t), sizeof(time_t), size);
+}
+
+void freeTimeIndex(TimeIndex* pIndex)
+{
+  if(pIndex == NULL)
+  {
+    return;
+  }
+
+  free(pIndex->pDayStart);
+  pIndex->pDayStart = NULL;
+  pIndex->size      = 0;
+  pIndex->totalDays = 0;
+}
+
+static int seekIndex(const TimeIndex* pIndex, time_t time, BOOL inclusive)
+{
+  time_t day;
+  int    low, high;
+
+  if(pIndex->size == 0)
+  {
+    return 0;
+  }
+
+  day = dayNumber(time) - pIndex->firstDay;
+  if(day < 0)
+  {
+    return 0;
+  }
+  if(day >= pIndex->totalDays)
+  {
+    return pIndex->size;
+  }
+
+  /* Binary search within the bars of a single day. */
+  low  = pIndex->pDayStart[day];
+  high = pIndex->pDayStart[day + 1];
+  while(low < high)
+  {
+    int    mid     = low + (high - low) / 2;
+    time_t midTime = timeIndexTimeAt(pIndex, mid);
+
+    if(inclusive ? (midTime < time) : (midTime <= time))
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+int timeIndexLowerBound(const TimeIndex* pIndex, time_t time)
+{
+  return seekIndex(pIndex, time, TRUE);
+}
+
+int timeIndexUpperBound(const TimeIndex* pIndex, time_t time)
+{
+  return seekIndex(pIndex, time, FALSE);
+}
+
+int searchTimeUpperBound(const time_t* pTimes, int size, time_t time)
+{
+  int low = 0, high = size;
+
+  while(low < high)
+  {
+    int mid = low + (high - low) / 2;
+
+    if(pTimes[mid] <= time)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  return low;
+}
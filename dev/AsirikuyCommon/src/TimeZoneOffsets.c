@@ -42,9 +42,11 @@
 
 #include "Precompiled.h"
 #include "TimeZoneOffsets.h"
+#include "AsyncLog.h"
 #include "Broker-tz.h"
 
 #include <AsirikuyTime.h>
+#include <Calendar.h>
 #include <Logging.h>
 #include <CriticalSection.h>
 #include <NTPCWrapper.hpp>
@@ -83,13 +85,13 @@ static AsirikuyReturnCode checkTZValidity(time_t brokerTime, time_t referenceTim
     pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"checkTZValidity() adjusted broker time = %s", safe_timeString(timeString, adjustedBrokerTime));
     return BROKER_TZ_MISMATCH;
   }
-  else if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+  else if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
   {
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checkTZValidity() Local time(UTC)      = %s", safe_timeString(timeString, localTimeUTC));
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checkTZValidity() broker time          = %s", safe_timeString(timeString, brokerTime));
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checkTZValidity() reference time       = %s", safe_timeString(timeString, referenceTime));
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checkTZValidity() adjusted local time  = %s", safe_timeString(timeString, adjustedLocalTime));
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checkTZValidity() adjusted broker time = %s", safe_timeString(timeString, adjustedBrokerTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checkTZValidity() Local time(UTC)      = %s", safe_timeString(timeString, localTimeUTC));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checkTZValidity() broker time          = %s", safe_timeString(timeString, brokerTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checkTZValidity() reference time       = %s", safe_timeString(timeString, referenceTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checkTZValidity() adjusted local time  = %s", safe_timeString(timeString, adjustedLocalTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checkTZValidity() adjusted broker time = %s", safe_timeString(timeString, adjustedBrokerTime));
   }
   
   return SUCCESS;
@@ -169,7 +171,7 @@ AsirikuyReturnCode getTimeOffsets(time_t currentBrokerTime, AccountInfo* pAccoun
     return returnCode;
   }
   
-  pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getTimeOffsets() Calculating local time offsets.");
+  ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "getTimeOffsets() Calculating local time offsets.");
   returnCode = calculateOffsets(currentBrokerTime, pTZOffsets->localTZOffsets, localTZ);
   if(returnCode != SUCCESS)
   {
@@ -177,7 +179,7 @@ AsirikuyReturnCode getTimeOffsets(time_t currentBrokerTime, AccountInfo* pAccoun
     return returnCode;
   }
   
-  pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getTimeOffsets() Calculating broker time offsets.");
+  ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "getTimeOffsets() Calculating broker time offsets.");
   returnCode = calculateOffsets(currentBrokerTime, pTZOffsets->brokerTZOffsets, brokerTZ);
   if(returnCode != SUCCESS)
   {
@@ -185,7 +187,7 @@ AsirikuyReturnCode getTimeOffsets(time_t currentBrokerTime, AccountInfo* pAccoun
     return returnCode;
   }
   
-  pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getTimeOffsets() Calculating reference time offsets.");
+  ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "getTimeOffsets() Calculating reference time offsets.");
   returnCode = calculateOffsets(currentBrokerTime, pTZOffsets->referenceTZOffsets, referenceTZ);
   if(returnCode != SUCCESS)
   {
@@ -209,7 +211,7 @@ AsirikuyReturnCode getTimeOffsets(time_t currentBrokerTime, AccountInfo* pAccoun
 time_t getAdjustedBrokerTime(time_t brokerTime, TZOffsets* pTZOffsets)
 {
   time_t adjustedBrokerTime = brokerTime;
-  struct tm timeInfo;
+  int    dayOfYear;
 
   if(pTZOffsets == NULL)
   {
@@ -217,15 +219,15 @@ time_t getAdjustedBrokerTime(time_t brokerTime, TZOffsets* pTZOffsets)
     return NULL_POINTER;
   }
   
-  safe_gmtime(&timeInfo, brokerTime);
-  adjustedBrokerTime += ((pTZOffsets->referenceTZOffsets[timeInfo.tm_yday] - pTZOffsets->brokerTZOffsets[timeInfo.tm_yday]) * SECONDS_PER_HOUR);
+  dayOfYear = calendarDayOfYear(brokerTime);
+  adjustedBrokerTime += ((pTZOffsets->referenceTZOffsets[dayOfYear] - pTZOffsets->brokerTZOffsets[dayOfYear]) * SECONDS_PER_HOUR);
 
-  if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+  if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
   {
     char sourceTime[MAX_TIME_STRING_SIZE] = "";
     char destTime[MAX_TIME_STRING_SIZE] = "";
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getAdjustedBrokerTime() Day of year = %d, Reference offset = %d. Broker offset = %d", timeInfo.tm_yday, pTZOffsets->referenceTZOffsets[timeInfo.tm_yday], pTZOffsets->brokerTZOffsets[timeInfo.tm_yday]);
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getAdjustedBrokerTime() Original time = %s. Adjusted time = %s", safe_timeString(sourceTime, brokerTime), safe_timeString(destTime, adjustedBrokerTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "getAdjustedBrokerTime() Day of year = %d, Reference offset = %d. Broker offset = %d", dayOfYear, pTZOffsets->referenceTZOffsets[dayOfYear], pTZOffsets->brokerTZOffsets[dayOfYear]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "getAdjustedBrokerTime() Original time = %s. Adjusted time = %s", safe_timeString(sourceTime, brokerTime), safe_timeString(destTime, adjustedBrokerTime));
   }
 
   return adjustedBrokerTime;
@@ -234,7 +236,7 @@ time_t getAdjustedBrokerTime(time_t brokerTime, TZOffsets* pTZOffsets)
 time_t getAdjustedLocalTime(time_t localTimeUTC, TZOffsets* pTZOffsets)
 {
   time_t adjustedLocalTime = localTimeUTC;
-  struct tm timeInfo;
+  int    dayOfYear;
 
   if(pTZOffsets == NULL)
   {
@@ -242,15 +244,15 @@ time_t getAdjustedLocalTime(time_t localTimeUTC, TZOffsets* pTZOffsets)
     return NULL_POINTER;
   }
 
-  safe_gmtime(&timeInfo, localTimeUTC);
-  adjustedLocalTime += (pTZOffsets->referenceTZOffsets[timeInfo.tm_yday] * SECONDS_PER_HOUR);
+  dayOfYear = calendarDayOfYear(localTimeUTC);
+  adjustedLocalTime += (pTZOffsets->referenceTZOffsets[dayOfYear] * SECONDS_PER_HOUR);
 
-  if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+  if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
   {
     char sourceTime[MAX_TIME_STRING_SIZE] = "";
     char destTime[MAX_TIME_STRING_SIZE] = "";
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getAdjustedLocalTime() Day of year = %d, Reference offset = %d. Local offset = %d", timeInfo.tm_yday, pTZOffsets->referenceTZOffsets[timeInfo.tm_yday], pTZOffsets->localTZOffsets[timeInfo.tm_yday]);
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"getAdjustedLocalTime() Original time = %s. Adjusted time = %s", safe_timeString(sourceTime, localTimeUTC), safe_timeString(destTime, adjustedLocalTime));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "getAdjustedLocalTime() Day of year = %d, Reference offset = %d. Local offset = %d", dayOfYear, pTZOffsets->referenceTZOffsets[dayOfYear], pTZOffsets->localTZOffsets[dayOfYear]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "getAdjustedLocalTime() Original time = %s. Adjusted time = %s", safe_timeString(sourceTime, localTimeUTC), safe_timeString(destTime, adjustedLocalTime));
   }
 
   return adjustedLocalTime;
@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @brief     Hierarchical timer wheel for time-driven events.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "TimerWheel.h"
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+static void linkTimer(TimerWheel* pWheel, WheelTimer** ppHead, WheelTimer* pTimer, int level)
+{
+  pTimer->ppHead = ppHead;
+  pTimer->level  = level;
+  pTimer->pPrev  = NULL;
+  pTimer->pNext  = *ppHead;
+  if(*ppHead != NULL)
+  {
+    (*ppHead)->pPrev = pTimer;
+  }
+  *ppHead = pTimer;
+
+  if(level >= 0)
+  {
+    pWheel->levelCounts[level]++;
+  }
+  pWheel->totalTimers++;
+}
+
+static void unlinkTimer(TimerWheel* pWheel, WheelTimer* pTimer)
+{
+  if(pTimer->pPrev != NULL)
+  {
+    pTimer->pPrev->pNext = pTimer->pNext;
+  }
+  else
+  {
+    *pTimer->ppHead = pTimer->pNext;
+  }
+  if(pTimer->pNext != NULL)
+  {
+    pTimer->pNext->pPrev = pTimer->pPrev;
+  }
+
+  if(pTimer->level >= 0)
+  {
+    pWheel->levelCounts[pTimer->level]--;
+  }
+  pWheel->totalTimers--;
+
+  pTimer->ppHead = NULL;
+  pTimer->pPrev  = NULL;
+  pTimer->pNext  = NULL;
+}
+
+/* Places a timer on the level whose span covers its distance from the wheel time. */
+static void placeTimer(TimerWheel* pWheel, WheelTimer* pTimer)
+{
+  time_t delta = pTimer->dueTime - pWheel->currentTime;
+  int    level;
+
+  if(delta < 0)
+  {
+    linkTimer(pWheel, &pWheel->pExpired, pTimer, -1);
+    return;
+  }
+
+  for(level = 0; level < TIMER_WHEEL_LEVELS; level++)
+  {
+    if(delta < ((time_t)1 << (TIMER_WHEEL_SLOT_BITS * (level + 1))))
+    {
+      int slot = (int)((pTimer->dueTime >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK);
+      linkTimer(pWheel, &pWheel->pSlots[level][slot], pTimer, level);
+      return;
+    }
+  }
+
+  linkTimer(pWheel, &pWheel->pOverflow, pTimer, TIMER_WHEEL_LEVELS);
+}
+
+/* Re-places every timer of a list relative to the current wheel time. */
+static void cascadeList(TimerWheel* pWheel, WheelTimer** ppHead)
+{
+  WheelTimer* pTimer = *ppHead;
+
+  while(pTimer != NULL)
+  {
+    WheelTimer* pNext = pTimer->pNext;
+    unlinkTimer(pWheel, pTimer);
+    placeTimer(pWheel, pTimer);
+    pTimer = pNext;
+  }
+}
+
+static int fireList(TimerWheel* pWheel, WheelTimer** ppHead, TimerWheelCallback callback, void* pContext)
+{
+  int fired = 0;
+
+  while(*ppHead != NULL)
+  {
+    WheelTimer* pTimer = *ppHead;
+    unlinkTimer(pWheel, pTimer);
+    fired++;
+    if(callback != NULL)
+    {
+      callback(pTimer, pContext);
+    }
+  }
+
+  return fired;
+}
+
+void initTimerWheel(TimerWheel* pWheel, time_t startTime)
+{
+  memset(pWheel, 0, sizeof(TimerWheel));
+  pWheel->currentTime = startTime;
+}
+
+void initWheelTimer(WheelTimer* pTimer, int id)
+{
+  memset(pTimer, 0, sizeof(WheelTimer));
+  pTimer->id    = id;
+  pTimer->level = -1;
+}
+
+void scheduleWheelTimer(TimerWheel* pWheel, WheelTimer* pTimer, time_t dueTime)
+{
+  cancelWheelTimer(pWheel, pTimer);
+  pTimer->dueTime = dueTime;
+
+  if(dueTime <= pWheel->currentTime)
+  {
+    linkTimer(pWheel, &pWheel->pExpired, pTimer, -1);
+  }
+  else
+  {
+    placeTimer(pWheel, pTimer);
+  }
+}
+
+void cancelWheelTimer(TimerWheel* pWheel, WheelTimer* pTimer)
+{
+  if(pTimer->ppHead != NULL)
+  {
+    unlinkTimer(pWheel, pTimer);
+  }
+}
+
+BOOL isWheelTimerScheduled(const WheelTimer* pTimer)
+{
+  return pTimer->ppHead != NULL;
+}
+
+int advanceTimerWheel(TimerWheel* pWheel, time_t currentTime, TimerWheelCallback callback, void* pContext)
+{
+  int fired = fireList(pWheel, &pWheel->pExpired, callback, pContext);
+
+  while(pWheel->currentTime < currentTime)
+  {
+    int    lowestLevel, level;
+    time_t nextTime;
+
+    if(pWheel->totalTimers == 0)
+    {
+      pWheel->currentTime = currentTime;
+      break;
+    }
+
+    /* Nothing can fire before the next boundary of the lowest non-empty level, so jump straight to it. */
+    for(lowestLevel = 0; lowestLevel < TIMER_WHEEL_LEVELS && pWheel->levelCounts[lowestLevel] == 0; lowestLevel++);
+
+    if(lowestLevel == 0)
+    {
+      nextTime = pWheel->currentTime + 1;
+    }
+    else
+    {
+      int shift = TIMER_WHEEL_SLOT_BITS * lowestLevel;
+      nextTime = ((pWheel->currentTime >> shift) + 1) << shift;
+    }
+
+    if(nextTime > currentTime)
+    {
+      pWheel->currentTime = currentTime;
+      break;
+    }
+
+    pWheel->currentTime = nextTime;
+
+    /* Cascade every level whose lower neighbour wrapped, top level first. */
+    for(level = 1; level <= TIMER_WHEEL_LEVELS; level++)
+    {
+      if((pWheel->currentTime & (((time_t)1 << (TIMER_WHEEL_SLOT_BITS * level)) - 1)) != 0)
+      {
+        break;
+      }
+    }
+    for(level = level - 1; level >= 1; level--)
+    {
+      if(level == TIMER_WHEEL_LEVELS)
+      {
+        cascadeList(pWheel, &pWheel->pOverflow);
+      }
+      else
+      {
+        int slot = (int)((pWheel->currentTime >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK);
+        cascadeList(pWheel, &pWheel->pSlots[level][slot]);
+      }
+    }
+
+    fired += fireList(pWheel, &pWheel->pSlots[0][pWheel->currentTime & SLOT_MASK], callback, pContext);
+
+    /* Timers scheduled by the callbacks in the past fire in the same advance. */
+    fired += fireList(pWheel, &pWheel->pExpired, callback, pContext);
+  }
+
+  return fired;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file
+ * @brief     Runs a batch of independent tasks on a pool of worker threads.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "WorkerThreads.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  #include <process.h>
+  typedef HANDLE           WorkerHandle;
+  typedef CRITICAL_SECTION WorkerLock;
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  #include <unistd.h>
+  typedef pthread_t        WorkerHandle;
+  typedef pthread_mutex_t  WorkerLock;
+#else
+  #error "Unsupported operating system"
+#endif
+
+typedef struct taskQueue_t
+{
+  WorkerLock   lock;
+  int          nextTask;
+  int          totalTasks;
+  ParallelTask task;
+  void*        pContext;
+} TaskQueue;
+
+typedef struct worker_t
+{
+  TaskQueue* pQueue;
+  int        threadIndex;
+} Worker;
+
+static void lockQueue(TaskQueue* pQueue)
+{
+#if defined _WIN32 || defined _WIN64
+  EnterCriticalSection(&pQueue->lock);
+#else
+  pthread_mutex_lock(&pQueue->lock);
+#endif
+}
+
+static void unlockQueue(TaskQueue* pQueue)
+{
+#if defined _WIN32 || defined _WIN64
+  LeaveCriticalSection(&pQueue->lock);
+#else
+  pthread_mutex_unlock(&pQueue->lock);
+#endif
+}
+
+static void runWorker(Worker* pWorker)
+{
+  TaskQueue* pQueue = pWorker->pQueue;
+  int taskIndex;
+
+  for(;;)
+  {
+    lockQueue(pQueue);
+    taskIndex = pQueue->nextTask++;
+    unlockQueue(pQueue);
+
+    if(taskIndex >= pQueue->totalTasks)
+    {
+      break;
+    }
+
+    pQueue->task(taskIndex, pWorker->threadIndex, pQueue->pContext);
+  }
+}
+
+#if defined _WIN32 || defined _WIN64
+static unsigned __stdcall workerEntry(void* pArgument)
+{
+  runWorker((Worker*)pArgument);
+  return 0;
+}
+#else
+static void* workerEntry(void* pArgument)
+{
+  runWorker((Worker*)pArgument);
+  return NULL;
+}
+#endif
+
+static BOOL startWorker(Worker* pWorker, WorkerHandle* pHandle)
+{
+#if defined _WIN32 || defined _WIN64
+  *pHandle = (HANDLE)_beginthreadex(NULL, 0, workerEntry, pWorker, 0, NULL);
+  return *pHandle != NULL;
+#else
+  return pthread_create(pHandle, NULL, workerEntry, pWorker) == 0;
+#endif
+}
+
+static void joinWorker(WorkerHandle handle)
+{
+#if defined _WIN32 || defined _WIN64
+  WaitForSingleObject(handle, INFINITE);
+  CloseHandle(handle);
+#else
+  pthread_join(handle, NULL);
+#endif
+}
+
+int getProcessorCount()
+{
+#if defined _WIN32 || defined _WIN64
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return (systemInfo.dwNumberOfProcessors > 0) ? (int)systemInfo.dwNumberOfProcessors : 1;
+#else
+  long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  return (processors > 0) ? (int)processors : 1;
+#endif
+}
+
+AsirikuyReturnCode runParallelTasks(int totalTasks, int totalThreads, ParallelTask task, void* pContext)
+{
+  TaskQueue    queue;
+  Worker       workers[MAX_WORKER_THREADS];
+  WorkerHandle handles[MAX_WORKER_THREADS];
+  int totalStarted = 0, i;
+
+  if(task == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runParallelTasks() failed. task = NULL");
+    return NULL_POINTER;
+  }
+
+  if(totalTasks <= 0)
+  {
+    return SUCCESS;
+  }
+
+  if(totalThreads <= 0)
+  {
+    totalThreads = getProcessorCount();
+  }
+  if(totalThreads > totalTasks)
+  {
+    totalThreads = totalTasks;
+  }
+  if(totalThreads > MAX_WORKER_THREADS)
+  {
+    totalThreads = MAX_WORKER_THREADS;
+  }
+
+  queue.nextTask   = 0;
+  queue.totalTasks = totalTasks;
+  queue.task       = task;
+  queue.pContext   = pContext;
+#if defined _WIN32 || defined _WIN64
+  InitializeCriticalSection(&queue.lock);
+#else
+  pthread_mutex_init(&queue.lock, NULL);
+#endif
+
+  for(i = 0; i < totalThreads; i++)
+  {
+    workers[totalStarted].pQueue      = &queue;
+    workers[totalStarted].threadIndex = totalStarted;
+    if(startWorker(&workers[totalStarted], &handles[totalStarted]))
+    {
+      totalStarted++;
+    }
+  }
+
+  if(totalStarted < totalThreads)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"runParallelTasks() started %d of %d worker threads.", totalStarted, totalThreads);
+  }
+
+  for(i = 0; i < totalStarted; i++)
+  {
+    joinWorker(handles[i]);
+  }
+
+#if defined _WIN32 || defined _WIN64
+  DeleteCriticalSection(&queue.lock);
+#else
+  pthread_mutex_destroy(&queue.lock);
+#endif
+
+  if(totalStarted == 0)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runParallelTasks() failed. No worker thread could be started.");
+    return INSUFFICIENT_MEMORY;
+  }
+
+  return SUCCESS;
+}
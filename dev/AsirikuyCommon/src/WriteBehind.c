@@ -0,0 +1,505 @@
+/**
+ * @file
+ * @brief     Write-behind persistence of small state files.
+ * @details   Files are written by a background thread through a temporary file and a rename, so a crash never leaves a half written file.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "WriteBehind.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  #include <process.h>
+  #include <io.h>
+  typedef HANDLE             WriterHandle;
+  typedef SRWLOCK            WriterLock;
+  typedef CONDITION_VARIABLE WriterCondition;
+  #define WRITER_LOCK_INIT      SRWLOCK_INIT
+  #define WRITER_CONDITION_INIT CONDITION_VARIABLE_INIT
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  #include <unistd.h>
+  typedef pthread_t          WriterHandle;
+  typedef pthread_mutex_t    WriterLock;
+  typedef pthread_cond_t     WriterCondition;
+  #define WRITER_LOCK_INIT      PTHREAD_MUTEX_INITIALIZER
+  #define WRITER_CONDITION_INIT PTHREAD_COND_INITIALIZER
+#else
+  #error "Unsupported operating system"
+#endif
+
+typedef struct writeBehindSlot_t
+{
+  int            key;       /* -1 if the slot is free */
+  BOOL           isDirty;   /* Holds content that isn't on disk yet */
+  BOOL           isWriting; /* A thread is writing a copy of the content */
+  BOOL           isFailed;  /* The last write failed. Retried by the next queue or flush rather than in a loop. */
+  char           path[MAX_FILE_PATH_CHARS];
+  unsigned char* pData;
+  size_t         size;
+  size_t         capacity;
+} WriteBehindSlot;
+
+static WriteBehindSlot  gSlots[WRITE_BEHIND_SLOTS];
+static BOOL             gAreSlotsInitialized = FALSE;
+static WriterLock       gLock      = WRITER_LOCK_INIT;
+static WriterCondition  gCondition = WRITER_CONDITION_INIT; /* Signalled when content is queued, a write ends or the writer stops */
+static WriterHandle     gWriter;
+static BOOL             gIsWriterRunning = FALSE;
+static BOOL             gIsWriterStopping = FALSE;
+static WriteBehindFault gFault = NULL;
+static WriteBehindStats gStats;
+
+static void lockWriter()
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_lock(&gLock);
+#endif
+}
+
+static void unlockWriter()
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_unlock(&gLock);
+#endif
+}
+
+static void waitWriter()
+{
+#if defined _WIN32 || defined _WIN64
+  SleepConditionVariableSRW(&gCondition, &gLock, INFINITE, 0);
+#else
+  pthread_cond_wait(&gCondition, &gLock);
+#endif
+}
+
+static void wakeWriters()
+{
+#if defined _WIN32 || defined _WIN64
+  WakeAllConditionVariable(&gCondition);
+#else
+  pthread_cond_broadcast(&gCondition);
+#endif
+}
+
+static void initSlots()
+{
+  int i;
+
+  if(gAreSlotsInitialized)
+  {
+    return;
+  }
+
+  for(i = 0; i < WRITE_BEHIND_SLOTS; i++)
+  {
+    memset(&gSlots[i], 0, sizeof(WriteBehindSlot));
+    gSlots[i].key = -1;
+  }
+  gAreSlotsInitialized = TRUE;
+}
+
+static WriteBehindSlot* findSlot(int key, BOOL isCreated)
+{
+  WriteBehindSlot* pFree = NULL;
+  int i;
+
+  initSlots();
+  for(i = 0; i < WRITE_BEHIND_SLOTS; i++)
+  {
+    if(gSlots[i].key == key)
+    {
+      return &gSlots[i];
+    }
+    if((pFree == NULL) && (gSlots[i].key == -1))
+    {
+      pFree = &gSlots[i];
+    }
+  }
+
+  if(isCreated && (pFree != NULL))
+  {
+    pFree->key = key;
+    return pFree;
+  }
+
+  return NULL;
+}
+
+static void releaseSlot(WriteBehindSlot* pSlot)
+{
+  free(pSlot->pData);
+  memset(pSlot, 0, sizeof(WriteBehindSlot));
+  pSlot->key = -1;
+}
+
+/* Takes a copy of the content of a dirty slot to write it without holding the lock. The caller frees the copy. */
+static unsigned char* takeSlotContent(WriteBehindSlot* pSlot, char* pPath, size_t* pSize)
+{
+  unsigned char* pCopy = (unsigned char*)malloc(pSlot->size > 0 ? pSlot->size : 1);
+
+  if(pCopy == NULL)
+  {
+    return NULL;
+  }
+
+  memcpy(pCopy, pSlot->pData, pSlot->size);
+  strcpy(pPath, pSlot->path);
+  *pSize           = pSlot->size;
+  pSlot->isDirty   = FALSE;
+  pSlot->isWriting = TRUE;
+  return pCopy;
+}
+
+/* Called with the lock held after a write of the slot's content ended. */
+static void endSlotWrite(WriteBehindSlot* pSlot, AsirikuyReturnCode result)
+{
+  pSlot->isWriting = FALSE;
+  if(result == SUCCESS)
+  {
+    gStats.writes++;
+  }
+  else
+  {
+    gStats.failures++;
+    /* Unless newer content was queued meanwhile, the content that failed is still the latest one. */
+    if(!pSlot->isDirty)
+    {
+      pSlot->isDirty  = TRUE;
+      pSlot->isFailed = TRUE;
+    }
+  }
+  wakeWriters();
+}
+
+static void runWriter()
+{
+  char           path[MAX_FILE_PATH_CHARS];
+  unsigned char* pCopy;
+  size_t         size;
+  int            i;
+
+  lockWriter();
+  while(!gIsWriterStopping)
+  {
+    WriteBehindSlot* pSlot = NULL;
+
+    for(i = 0; i < WRITE_BEHIND_SLOTS; i++)
+    {
+      if((gSlots[i].key != -1) && gSlots[i].isDirty && !gSlots[i].isWriting && !gSlots[i].isFailed)
+      {
+        pSlot = &gSlots[i];
+        break;
+      }
+    }
+
+    if(pSlot == NULL)
+    {
+      waitWriter();
+      continue;
+    }
+
+    pCopy = takeSlotContent(pSlot, path, &size);
+    if(pCopy == NULL)
+    {
+      endSlotWrite(pSlot, INSUFFICIENT_MEMORY);
+      continue;
+    }
+
+    unlockWriter();
+    {
+      AsirikuyReturnCode result = writeFileAtomically(path, pCopy, size);
+      free(pCopy);
+      lockWriter();
+      endSlotWrite(pSlot, result);
+    }
+  }
+  unlockWriter();
+}
+
+#if defined _WIN32 || defined _WIN64
+static unsigned __stdcall writerEntry(void* pArgument)
+{
+  (void)pArgument;
+  runWriter();
+  return 0;
+}
+#else
+static void* writerEntry(void* pArgument)
+{
+  (void)pArgument;
+  runWriter();
+  return NULL;
+}
+#endif
+
+/* Called with the lock held. */
+static BOOL startWriter()
+{
+  if(gIsWriterRunning)
+  {
+    return TRUE;
+  }
+
+#if defined _WIN32 || defined _WIN64
+  gWriter = (HANDLE)_beginthreadex(NULL, 0, writerEntry, NULL, 0, NULL);
+  gIsWriterRunning = (gWriter != NULL);
+#else
+  gIsWriterRunning = (pthread_create(&gWriter, NULL, writerEntry, NULL) == 0);
+#endif
+
+  if(!gIsWriterRunning)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"startWriter() Failed to start the write-behind thread. Files are written synchronously.");
+  }
+  return gIsWriterRunning;
+}
+
+static BOOL syncFile(FILE* pFile)
+{
+  if(fflush(pFile) != 0)
+  {
+    return FALSE;
+  }
+#if defined _WIN32 || defined _WIN64
+  return _commit(_fileno(pFile)) == 0;
+#else
+  return fsync(fileno(pFile)) == 0;
+#endif
+}
+
+AsirikuyReturnCode writeFileAtomically(const char* pPath, const void* pData, size_t size)
+{
+  char   tempPath[MAX_FILE_PATH_CHARS + sizeof(WRITE_BEHIND_TEMP_EXTENSION)];
+  size_t half = size / 2;
+  BOOL   isWritten;
+  FILE*  pFile;
+
+  strcpy(tempPath, pPath);
+  strcat(tempPath, WRITE_BEHIND_TEMP_EXTENSION);
+
+  pFile = fopen(tempPath, "wb");
+  if(pFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileAtomically() Failed to open %s.", tempPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  isWritten = (fwrite(pData, 1, half, pFile) == half);
+  if(isWritten && (gFault != NULL) && (fflush(pFile) == 0) && !gFault(pPath, half))
+  {
+    /* Leave the temporary file as a killed process would. */
+    fclose(pFile);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileAtomically() Write of %s abandoned by fault injection.", pPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  isWritten = isWritten && (fwrite((const unsigned char*)pData + half, 1, size - half, pFile) == size - half) && syncFile(pFile);
+  if((fclose(pFile) != 0) || !isWritten)
+  {
+    remove(tempPath);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileAtomically() Failed to write %s.", tempPath);
+    return FILE_WRITING_ERROR;
+  }
+
+#if defined _WIN32 || defined _WIN64
+  isWritten = MoveFileExA(tempPath, pPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+  isWritten = (rename(tempPath, pPath) == 0);
+#endif
+  if(!isWritten)
+  {
+    remove(tempPath);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeFileAtomically() Failed to replace %s.", pPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode queueWriteBehind(int key, const char* pPath, const void* pData, size_t size)
+{
+  WriteBehindSlot* pSlot;
+
+  if(strlen(pPath) >= MAX_FILE_PATH_CHARS)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"queueWriteBehind() Path too long: %s", pPath);
+    return INVALID_PARAMETER;
+  }
+
+  lockWriter();
+
+  pSlot = findSlot(key, TRUE);
+  if((pSlot == NULL) || !startWriter())
+  {
+    unlockWriter();
+    return writeFileAtomically(pPath, pData, size);
+  }
+
+  if(pSlot->capacity < size)
+  {
+    unsigned char* pBuffer = (unsigned char*)realloc(pSlot->pData, size);
+    if(pBuffer == NULL)
+    {
+      unlockWriter();
+      return writeFileAtomically(pPath, pData, size);
+    }
+    pSlot->pData    = pBuffer;
+    pSlot->capacity = size;
+  }
+
+  gStats.queued++;
+  if(pSlot->isDirty)
+  {
+    gStats.coalesced++;
+  }
+
+  memcpy(pSlot->pData, pData, size);
+  strcpy(pSlot->path, pPath);
+  pSlot->size     = size;
+  pSlot->isDirty  = TRUE;
+  pSlot->isFailed = FALSE;
+  wakeWriters();
+
+  unlockWriter();
+  return SUCCESS;
+}
+
+AsirikuyReturnCode flushWriteBehind(int key)
+{
+  AsirikuyReturnCode result = SUCCESS;
+  WriteBehindSlot*   pSlot;
+  char               path[MAX_FILE_PATH_CHARS];
+  unsigned char*     pCopy;
+  size_t             size;
+
+  lockWriter();
+
+  pSlot = findSlot(key, FALSE);
+  if(pSlot == NULL)
+  {
+    unlockWriter();
+    return SUCCESS;
+  }
+
+  while(pSlot->isWriting)
+  {
+    waitWriter();
+  }
+
+  if(pSlot->key != key)
+  {
+    /* Flushed by another thread while waiting. */
+    unlockWriter();
+    return SUCCESS;
+  }
+
+  if(pSlot->isDirty)
+  {
+    pCopy = takeSlotContent(pSlot, path, &size);
+    if(pCopy == NULL)
+    {
+      result = INSUFFICIENT_MEMORY;
+    }
+    else
+    {
+      unlockWriter();
+      result = writeFileAtomically(path, pCopy, size);
+      free(pCopy);
+      lockWriter();
+    }
+    endSlotWrite(pSlot, result);
+  }
+
+  /* A slot that failed keeps its content for the next queue, flush or stop, and one queued during the write is left to the writer. */
+  if((result == SUCCESS) && !pSlot->isDirty)
+  {
+    releaseSlot(pSlot);
+  }
+  unlockWriter();
+
+  return result;
+}
+
+void stopWriteBehind()
+{
+  int i;
+
+  lockWriter();
+  if(!gIsWriterRunning)
+  {
+    unlockWriter();
+    return;
+  }
+  gIsWriterStopping = TRUE;
+  wakeWriters();
+  unlockWriter();
+
+#if defined _WIN32 || defined _WIN64
+  WaitForSingleObject(gWriter, INFINITE);
+  CloseHandle(gWriter);
+#else
+  pthread_join(gWriter, NULL);
+#endif
+
+  lockWriter();
+  gIsWriterRunning  = FALSE;
+  gIsWriterStopping = FALSE;
+  unlockWriter();
+
+  for(i = 0; i < WRITE_BEHIND_SLOTS; i++)
+  {
+    if(gSlots[i].key != -1)
+    {
+      flushWriteBehind(gSlots[i].key);
+    }
+  }
+}
+
+void setWriteBehindFault(WriteBehindFault fault)
+{
+  lockWriter();
+  gFault = fault;
+  unlockWriter();
+}
+
+void getWriteBehindStats(WriteBehindStats* pStats)
+{
+  lockWriter();
+  *pStats = gStats;
+  unlockWriter();
+}
@@ -34,8 +34,534 @@
  * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
  */
 
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <math.h>
+#include <time.h>
 #include <boost/test/unit_test.hpp>
 
+#include "AsirikuyDefines.h"
+#include "AsirikuyTime.h"
+#include "AsyncLog.h"
+#include "BarCloseStamp.h"
+#include "BarFile.h"
+#include "BarRecorder.h"
+#include "Calendar.h"
+#include "DerivedRates.h"
+#include "EquityCurve.h"
+#include "FileCache.h"
+#include "ContiguousRatesCircBuf.h"
+#include "OrderHistoryIndex.h"
+#include "OpenPositions.h"
+#include "SessionBars.h"
+#include "StatusSegment.h"
+#include "TickJournal.h"
+#include "TimeIndex.h"
+#include "TimerWheel.h"
+#include "WorkerThreads.h"
+#include "WriteBehind.h"
+
+namespace
+{
+  struct AosBar
+  {
+    double open;
+    double close;
+    int    time;
+  };
+
+  int linearLowerBound(const std::vector<time_t>& times, time_t time)
+  {
+    int i = 0;
+    while(i < (int)times.size() && times[i] < time) i++;
+    return i;
+  }
+
+  int linearUpperBound(const std::vector<time_t>& times, time_t time)
+  {
+    int i = 0;
+    while(i < (int)times.size() && times[i] <= time) i++;
+    return i;
+  }
+
+  void checkTimeIndexAgainstScan(const std::vector<time_t>& times)
+  {
+    TimeIndex index;
+    BOOST_REQUIRE(initTimeIndexFromTimes(&index, &times[0], (int)times.size()) == SUCCESS);
+
+    for(time_t t = times.front() - 2 * SECONDS_PER_DAY; t <= times.back() + 2 * SECONDS_PER_DAY; t += 900)
+    {
+      BOOST_CHECK_EQUAL(timeIndexLowerBound(&index, t), linearLowerBound(times, t));
+      BOOST_CHECK_EQUAL(timeIndexUpperBound(&index, t), linearUpperBound(times, t));
+      BOOST_CHECK_EQUAL(searchTimeUpperBound(&times[0], (int)times.size(), t), linearUpperBound(times, t));
+    }
+
+    freeTimeIndex(&index);
+  }
+
+  struct FiredTimers
+  {
+    time_t            now;
+    std::vector<int>  ids;
+  };
+
+  void recordFiredTimer(WheelTimer* pTimer, void* pContext)
+  {
+    FiredTimers* pFired = (FiredTimers*)pContext;
+    BOOST_CHECK(pTimer->dueTime <= pFired->now);
+    pFired->ids.push_back(pTimer->id);
+  }
+
+  /* Hourly bars with weekend gaps, 6 weeks long. */
+  std::vector<time_t> hourlyBarsWithWeekends()
+  {
+    std::vector<time_t> times;
+    for(time_t t = 1325462400; t < 1325462400 + 42 * SECONDS_PER_DAY; t += SECONDS_PER_HOUR)
+    {
+      int dayOfWeek = (int)DAY_OF_WEEK(t);
+      if(dayOfWeek != SATURDAY && dayOfWeek != SUNDAY) times.push_back(t);
+    }
+    return times;
+  }
+
+  /* Order history scans as EasyTrade did them before the order history index. */
+  struct ScannedHistory
+  {
+    std::vector<OrderInfo> orders;
+    double                 bid;
+    double                 ask;
+  };
+
+  int scanLossTimesInDay(const ScannedHistory& h, time_t currentTime, double* total_lost_pips)
+  {
+    int lossTimes = 0;
+    struct tm timeInfo1, timeInfo2;
+    *total_lost_pips = 0;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket == 0) continue;
+      safe_gmtime(&timeInfo2, o.openTime);
+      if(timeInfo1.tm_year != timeInfo2.tm_year || timeInfo1.tm_yday != timeInfo2.tm_yday) continue;
+
+      if(o.isOpen == FALSE && o.profit < 0)
+      {
+        lossTimes++;
+        /* In double like the index. fabs(float) would round the product to float in C++. */
+        *total_lost_pips += fabs((double)o.closePrice - o.openPrice) * o.lots;
+      }
+      if(o.isOpen == TRUE)
+      {
+        if(o.type == BUY && h.ask < o.openPrice)
+        {
+          lossTimes++;
+          *total_lost_pips += fabs(h.ask - o.openPrice) * o.lots;
+        }
+        if(o.type == SELL && h.bid > o.openPrice)
+        {
+          lossTimes++;
+          *total_lost_pips += fabs(h.bid - o.openPrice) * o.lots;
+        }
+      }
+    }
+    return lossTimes;
+  }
+
+  int scanWinTimesInDay(const ScannedHistory& h, time_t currentTime)
+  {
+    int winningTimes = 0;
+    struct tm timeInfo1, timeInfo2;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket == 0) continue;
+      safe_gmtime(&timeInfo2, o.openTime);
+      if(timeInfo1.tm_year != timeInfo2.tm_year || timeInfo1.tm_yday != timeInfo2.tm_yday) continue;
+
+      if(o.isOpen == FALSE && o.profit > 0) winningTimes++;
+      if(o.isOpen == TRUE && o.takeProfit > 0)
+      {
+        if(o.type == BUY && h.ask > o.takeProfit) winningTimes++;
+        if(o.type == SELL && h.bid < o.takeProfit) winningTimes++;
+      }
+    }
+    return winningTimes;
+  }
+
+  /* Returns whether an order is in the week of timeInfo1 the way getLossTimesInWeek() and getWinTimesInWeek() decided it. */
+  bool scanIsInWeek(const struct tm& timeInfo1, time_t openTime)
+  {
+    struct tm timeInfo2;
+    BOOL isCrossNewYear = FALSE;
+    int monday = timeInfo1.tm_yday - timeInfo1.tm_wday + 1;
+    int friday = timeInfo1.tm_yday - timeInfo1.tm_wday + 5;
+    int current;
+
+    if(monday < 0)
+    {
+      isCrossNewYear = TRUE;
+      monday += 365;
+      friday += 365;
+    }
+
+    safe_gmtime(&timeInfo2, openTime);
+    current = timeInfo2.tm_yday;
+    if(isCrossNewYear == FALSE && timeInfo2.tm_year != timeInfo1.tm_year) return false;
+    if(isCrossNewYear && timeInfo2.tm_yday < 7) current += 365;
+    return current >= monday && current <= friday;
+  }
+
+  int scanLossTimesInWeek(const ScannedHistory& h, time_t currentTime, double* total_lost_pips)
+  {
+    int lossTimes = 0;
+    struct tm timeInfo1;
+    *total_lost_pips = 0;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket == 0 || !scanIsInWeek(timeInfo1, o.openTime)) continue;
+
+      if(o.isOpen == FALSE && o.profit < 0)
+      {
+        *total_lost_pips += fabs((double)o.closePrice - o.openPrice) * o.lots;
+        lossTimes++;
+      }
+      if(o.isOpen == TRUE)
+      {
+        if(o.type == BUY && h.ask < o.openPrice)
+        {
+          *total_lost_pips += fabs(h.bid - o.openPrice) * o.lots;
+          lossTimes++;
+        }
+        if(o.type == SELL && h.bid > o.openPrice)
+        {
+          *total_lost_pips += fabs(h.bid - o.openPrice) * o.lots;
+          lossTimes++;
+        }
+      }
+    }
+    return lossTimes;
+  }
+
+  int scanWinTimesInWeek(const ScannedHistory& h, time_t currentTime)
+  {
+    int winningTimes = 0;
+    struct tm timeInfo1;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket == 0 || !scanIsInWeek(timeInfo1, o.openTime)) continue;
+
+      if(o.isOpen == FALSE && o.profit > 0) winningTimes++;
+      if(o.isOpen == TRUE)
+      {
+        if(o.type == BUY && h.ask > o.takeProfit) winningTimes++;
+        if(o.type == SELL && h.bid < o.takeProfit) winningTimes++;
+      }
+    }
+    return winningTimes;
+  }
+
+  int scanHasSameDayOrder(const ScannedHistory& h, time_t currentTime, BOOL* pIsOpen)
+  {
+    struct tm timeInfo1, timeInfo2;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    *pIsOpen = FALSE;
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      if(h.orders[i].ticket == 0) continue;
+      safe_gmtime(&timeInfo2, h.orders[i].openTime);
+      if(timeInfo1.tm_year == timeInfo2.tm_year && timeInfo1.tm_mon == timeInfo2.tm_mon && timeInfo1.tm_mday == timeInfo2.tm_mday)
+      {
+        *pIsOpen = h.orders[i].isOpen;
+        return TRUE;
+      }
+    }
+    return FALSE;
+  }
+
+  int scanOrderCountToday(const ScannedHistory& h, time_t currentTime)
+  {
+    int count = 0;
+    struct tm timeInfo1, timeInfo2;
+
+    safe_gmtime(&timeInfo1, currentTime);
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket == 0 || (o.type != BUY && o.type != SELL)) continue;
+      safe_gmtime(&timeInfo2, o.openTime);
+      if(timeInfo1.tm_year == timeInfo2.tm_year && timeInfo1.tm_yday == timeInfo2.tm_yday) count++;
+    }
+    return count;
+  }
+
+  int scanLatestOrderIndex(const ScannedHistory& h)
+  {
+    time_t maxTime = 0;
+    int    index = -1;
+
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      if(h.orders[i].ticket != 0 && h.orders[i].openTime > maxTime)
+      {
+        maxTime = h.orders[i].openTime;
+        index = (int)i;
+      }
+    }
+    return index;
+  }
+
+  int scanLatestMarketOrderIndex(const ScannedHistory& h, BOOL isClosedOnly)
+  {
+    time_t maxTime = 0;
+    int    index = -1;
+
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      if(o.ticket != 0 && (o.type == BUY || o.type == SELL) && (isClosedOnly == FALSE || o.isOpen == FALSE) && o.openTime > maxTime)
+      {
+        maxTime = o.openTime;
+        index = (int)i;
+      }
+    }
+    return index;
+  }
+
+  void checkOrderHistoryIndex(const OrderHistoryIndex* pIndex, const ScannedHistory& history, time_t firstTime, int days)
+  {
+    BOOST_CHECK_EQUAL(pIndex->latestOrder, scanLatestOrderIndex(history));
+    BOOST_CHECK_EQUAL(pIndex->latestMarketOrder, scanLatestMarketOrderIndex(history, FALSE));
+    BOOST_CHECK_EQUAL(pIndex->latestClosedMarketOrder, scanLatestMarketOrderIndex(history, TRUE));
+
+    for(time_t t = firstTime - SECONDS_PER_DAY; t <= firstTime + (days + 1) * SECONDS_PER_DAY; t += 5 * SECONDS_PER_HOUR)
+    {
+      double scannedPips, indexedPips;
+      BOOL   scannedIsOpen, indexedIsOpen = FALSE;
+      const OrderHistoryDay* pDay = findOrderHistoryDay(pIndex, t);
+
+      BOOST_CHECK_EQUAL(getOrderHistoryLossesInDay(pIndex, t, history.bid, history.ask, &indexedPips), scanLossTimesInDay(history, t, &scannedPips));
+      BOOST_CHECK_CLOSE(indexedPips + 1, scannedPips + 1, 1e-9);
+
+      BOOST_CHECK_EQUAL(getOrderHistoryLossesInWeek(pIndex, t, history.bid, history.ask, &indexedPips), scanLossTimesInWeek(history, t, &scannedPips));
+      BOOST_CHECK_CLOSE(indexedPips + 1, scannedPips + 1, 1e-9);
+
+      BOOST_CHECK_EQUAL(getOrderHistoryWinsInDay(pIndex, t, history.bid, history.ask), scanWinTimesInDay(history, t));
+      BOOST_CHECK_EQUAL(getOrderHistoryWinsInWeek(pIndex, t, history.bid, history.ask), scanWinTimesInWeek(history, t));
+
+      if(pDay != NULL) indexedIsOpen = history.orders[pDay->firstOrder].isOpen;
+      BOOST_CHECK_EQUAL(pDay != NULL, scanHasSameDayOrder(history, t, &scannedIsOpen) == TRUE);
+      BOOST_CHECK_EQUAL(indexedIsOpen, scannedIsOpen);
+
+      BOOST_CHECK_EQUAL(pDay != NULL ? pDay->marketOrders : 0, scanOrderCountToday(history, t));
+    }
+  }
+
+  /* Orders spread over a few weeks around firstTime plus a few from previous years on the same days. */
+  ScannedHistory randomOrderHistory(unsigned int seed, int size, time_t firstTime, int days)
+  {
+    ScannedHistory h;
+
+    srand(seed);
+    h.orders.resize(size);
+    for(int i = 0; i < size; i++)
+    {
+      OrderInfo& o = h.orders[i];
+      memset(&o, 0, sizeof(OrderInfo));
+      o.ticket     = (rand() % 10 == 0) ? 0 : i + 1;
+      o.type       = (OrderType)(rand() % 6);
+      o.openTime   = firstTime + (time_t)(rand() % days) * SECONDS_PER_DAY + rand() % SECONDS_PER_DAY;
+      if(rand() % 8 == 0)
+      {
+        o.openTime -= (time_t)(1 + rand() % 3) * 365 * SECONDS_PER_DAY;
+      }
+      o.isOpen     = (rand() % 3 == 0) ? TRUE : FALSE;
+      o.openPrice  = (float)(1.30 + (rand() % 200) * 0.0001);
+      o.closePrice = (float)(1.30 + (rand() % 200) * 0.0001);
+      o.takeProfit = (rand() % 4 == 0) ? 0 : (float)(1.30 + (rand() % 200) * 0.0001);
+      o.lots       = (float)(0.01 * (1 + rand() % 100));
+      o.profit     = (float)((rand() % 3) - 1) * o.lots;
+    }
+    h.bid = 1.3100;
+    h.ask = 1.3102;
+
+    return h;
+  }
+
+  /* maxLossPerLot() for a fixed conversion: proportional to the distance, with its own value for a zero distance. */
+  double modelLossPerLot(double distance)
+  {
+    return distance == 0 ? 7.5 : 100000 * distance;
+  }
+
+  /* Open order sums as EasyTrade did them before the open positions aggregate, without the equity division. */
+  double scanStrategyPNL(const ScannedHistory& h, BOOL isIgnoredLockedProfit)
+  {
+    double risk = 0;
+
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      double openPrice = o.openPrice, currentPrice = 0;
+      int    adjust = 0;
+
+      if(o.ticket == 0 || !o.isOpen) continue;
+      if(o.type == BUY || o.type == BUYLIMIT || o.type == BUYSTOP)
+      {
+        currentPrice = h.ask;
+        if(openPrice - currentPrice > 0) adjust = -1;
+        else if(!isIgnoredLockedProfit) adjust = 1;
+      }
+      if(o.type == SELL || o.type == SELLLIMIT || o.type == SELLSTOP)
+      {
+        currentPrice = h.bid;
+        if(openPrice - currentPrice < 0) adjust = -1;
+        else if(!isIgnoredLockedProfit) adjust = 1;
+      }
+      risk = risk + o.lots * modelLossPerLot(fabs(currentPrice - openPrice)) * adjust;
+    }
+    return risk;
+  }
+
+  double scanStrategyRisk(const ScannedHistory& h, BOOL isIgnoredLockedProfit)
+  {
+    double risk = 0, stopLoss, mLP;
+
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+      int adjust = 0;
+
+      if(o.ticket == 0 || !o.isOpen) continue;
+      if(o.type == BUY)
+      {
+        if(o.openPrice - o.stopLoss > 0) adjust = -1;
+        else if(!isIgnoredLockedProfit) adjust = 1;
+      }
+      if(o.type == SELL)
+      {
+        if(o.openPrice - o.stopLoss < 0) adjust = -1;
+        else if(!isIgnoredLockedProfit) adjust = 1;
+      }
+      if(adjust == 0) continue;
+
+      stopLoss = fabs(o.openPrice - o.stopLoss);
+      mLP = (stopLoss == 0) ? 0 : modelLossPerLot(stopLoss);
+      risk = risk + o.lots * mLP * adjust;
+    }
+    return risk;
+  }
+
+  double scanStrategyVolRisk(const ScannedHistory& h, double dailyATR, bool isNoTakeProfitOnly)
+  {
+    int    adjust = 0;
+    double risk = 0;
+
+    for(size_t i = 0; i < h.orders.size(); i++)
+    {
+      const OrderInfo& o = h.orders[i];
+
+      if(o.ticket == 0 || !o.isOpen || (isNoTakeProfitOnly && o.takeProfit != 0)) continue;
+      if(o.type == BUY && o.openPrice - o.stopLoss > 0) adjust = -1;
+      if(o.type == SELL && o.openPrice - o.stopLoss < 0) adjust = -1;
+      risk = risk + o.lots * modelLossPerLot(dailyATR) * adjust;
+    }
+    return risk;
+  }
+  struct ScannedBar
+  {
+    time_t time;
+    double open, high, low, close, volume;
+  };
+
+  /* The bars addNewRenkoRates() and addNewConstantVolumeRates() built from every source bar on each call. */
+  std::vector<ScannedBar> scanDerivedRates(const Rates& source, DerivedRatesType type, double barSize)
+  {
+    std::vector<ScannedBar> bars;
+    int    arraySize = source.info.arraySize;
+    bool   newCandle = true;
+    double cumulativeUp = 0, cumulativeDown = 0, cumulativeVolume = 0;
+    double currentOpen = 0, lowest = 0, highest = 0;
+    time_t currentTime = 0;
+
+    for(int i = 0; i < arraySize; i++)
+    {
+      if(newCandle)
+      {
+        currentOpen      = bars.empty() ? source.open[i] : bars.back().close;
+        currentTime      = source.time[i];
+        lowest           = currentOpen;
+        highest          = currentOpen;
+        cumulativeVolume = 0;
+        newCandle        = false;
+      }
+
+      cumulativeDown    = currentOpen - source.low[i];
+      cumulativeUp      = source.high[i] - currentOpen;
+      cumulativeVolume += source.volume[i];
+      if(source.low[i] < lowest) lowest = source.low[i];
+      if(source.high[i] > highest) highest = source.high[i];
+
+      if(type == DERIVED_RENKO_RATES)
+      {
+        if((cumulativeDown > barSize) || (cumulativeUp > barSize) || (i == arraySize - 1))
+        {
+          ScannedBar bar = { 0 };
+          if(cumulativeDown > barSize)
+          {
+            ScannedBar down = { currentTime, currentOpen, highest, currentOpen - barSize, currentOpen - barSize, cumulativeVolume };
+            bar = down;
+          }
+          if(cumulativeUp > barSize)
+          {
+            ScannedBar up = { currentTime, currentOpen, currentOpen + barSize, lowest, currentOpen + barSize, cumulativeVolume };
+            bar = up;
+          }
+          if((i == arraySize - 1) && (cumulativeDown < barSize) && (cumulativeUp < barSize))
+          {
+            ScannedBar forming = { currentTime, currentOpen, highest, lowest, source.close[i], cumulativeVolume };
+            bar = forming;
+          }
+          bars.push_back(bar);
+          newCandle = true;
+        }
+      }
+      else if((cumulativeVolume >= barSize) || (i == arraySize - 1))
+      {
+        ScannedBar bar = { currentTime, currentOpen, highest, lowest, source.close[i], cumulativeVolume };
+        bars.push_back(bar);
+        newCandle = true;
+      }
+    }
+    return bars;
+  }
+
+  bool isSameDerivedRates(const std::vector<ScannedBar>& expected, const Rates& derived)
+  {
+    if((int)expected.size() != derived.info.arraySize) return false;
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      if(expected[i].time != derived.time[i] || expected[i].open != derived.open[i] || expected[i].high != derived.high[i] ||
+         expected[i].low != derived.low[i] || expected[i].close != derived.close[i] || expected[i].volume != derived.volume[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(Asirikuy_Common)
 
 BOOST_AUTO_TEST_CASE(placeholder)
@@ -43,4 +569,1795 @@ BOOST_AUTO_TEST_CASE(placeholder)
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(timeIndex_weekendAndHolidayGaps)
+{
+  /* Hourly bars from Monday 2012-01-02, skipping weekends and a whole week in the middle. */
+  std::vector<time_t> times;
+  time_t t = 1325462400;
+
+  for(int hour = 0; hour < 24 * 42; hour++, t += SECONDS_PER_HOUR)
+  {
+    int dayOfWeek = (int)DAY_OF_WEEK(t);
+    if(dayOfWeek == SATURDAY || dayOfWeek == SUNDAY || (hour >= 24 * 14 && hour < 24 * 21))
+    {
+      continue;
+    }
+    times.push_back(t);
+  }
+
+  checkTimeIndexAgainstScan(times);
+}
+
+BOOST_AUTO_TEST_CASE(timeIndex_duplicateTimestamps)
+{
+  std::vector<time_t> times;
+  time_t t = 1325462400;
+
+  for(int i = 0; i < 500; i++)
+  {
+    times.push_back(t);
+    if(i % 3 == 0) times.push_back(t);
+    if(i % 7 == 0) times.push_back(t);
+    t += (i % 5 == 0) ? SECONDS_PER_DAY : 1800;
+  }
+
+  checkTimeIndexAgainstScan(times);
+}
+
+BOOST_AUTO_TEST_CASE(timeIndex_arrayOfStructures)
+{
+  std::vector<AosBar> bars(300);
+  std::vector<time_t> times;
+  TimeIndex index;
+
+  for(int i = 0; i < (int)bars.size(); i++)
+  {
+    bars[i].time = 1325462400 + (i / 2) * 4 * SECONDS_PER_HOUR;
+    times.push_back(bars[i].time);
+  }
+  /* A negative time marks the end of the valid data. */
+  bars[250].time = -1;
+  times.resize(250);
+
+  BOOST_REQUIRE(initTimeIndex(&index, &bars[0].time, sizeof(AosBar), sizeof(int), (int)bars.size()) == SUCCESS);
+  BOOST_CHECK_EQUAL(index.size, 250);
+  BOOST_CHECK_EQUAL(timeIndexTimeAt(&index, 17), times[17]);
+
+  for(time_t t = times.front() - SECONDS_PER_DAY; t <= times.back() + SECONDS_PER_DAY; t += 600)
+  {
+    BOOST_CHECK_EQUAL(timeIndexLowerBound(&index, t), linearLowerBound(times, t));
+    BOOST_CHECK_EQUAL(timeIndexUpperBound(&index, t), linearUpperBound(times, t));
+  }
+
+  freeTimeIndex(&index);
+}
+
+BOOST_AUTO_TEST_CASE(timerWheel_swapAccrualFiresOnSameBars)
+{
+  /* Same rule as addInterest() in the tester: accrue when more than an hour passed since the last accrual
+     and there are open orders. The wheel only decides when the per-bar check needs to run. */
+  std::vector<time_t> times = hourlyBarsWithWeekends();
+  TimerWheel  wheel;
+  WheelTimer  swapTimer;
+  FiredTimers fired;
+  time_t      lastScan = 0, lastWheel = 0;
+  bool        swapDue = false;
+
+  initTimerWheel(&wheel, 0);
+  initWheelTimer(&swapTimer, 0);
+  scheduleWheelTimer(&wheel, &swapTimer, lastWheel + SECONDS_PER_HOUR + 1);
+
+  for(size_t bar = 0; bar < times.size(); bar++)
+  {
+    time_t now       = times[bar] + (bar % 3) * 600;
+    bool   hasOrders = (bar / 17) % 2 == 0;
+    bool   scanFires = hasOrders && (now - lastScan > SECONDS_PER_HOUR);
+    bool   wheelFires = false;
+
+    fired.now = now;
+    fired.ids.clear();
+    advanceTimerWheel(&wheel, now, recordFiredTimer, &fired);
+    swapDue = swapDue || !fired.ids.empty();
+
+    if(swapDue && hasOrders && (now - lastWheel > SECONDS_PER_HOUR))
+    {
+      wheelFires = true;
+      lastWheel  = now;
+      swapDue    = false;
+      scheduleWheelTimer(&wheel, &swapTimer, lastWheel + SECONDS_PER_HOUR + 1);
+    }
+    if(scanFires)
+    {
+      lastScan = now;
+    }
+
+    BOOST_CHECK_EQUAL(scanFires, wheelFires);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(timerWheel_holdingTimeExitsFireOnSameBars)
+{
+  /* One timer per order at openTime + maxHoldingTime compared with a per-bar scan over all orders. */
+  const int               totalOrders = 400;
+  std::vector<time_t>     times = hourlyBarsWithWeekends();
+  std::vector<time_t>     dueTimes(totalOrders);
+  std::vector<int>        scanExitBar(totalOrders, -1), wheelExitBar(totalOrders, -1);
+  std::vector<WheelTimer> timers(totalOrders);
+  TimerWheel              wheel;
+  FiredTimers             fired;
+  size_t                  bar;
+  int                     i;
+
+  initTimerWheel(&wheel, times[0]);
+  for(i = 0; i < totalOrders; i++)
+  {
+    time_t openTime = times[(i * 37) % (times.size() / 2)];
+    time_t maxHoldingTime = ((i * 7919) % 200) * 1800 + 60;
+
+    dueTimes[i] = openTime + maxHoldingTime;
+    initWheelTimer(&timers[i], i);
+    scheduleWheelTimer(&wheel, &timers[i], dueTimes[i]);
+  }
+
+  for(bar = 0; bar < times.size(); bar++)
+  {
+    for(i = 0; i < totalOrders; i++)
+    {
+      if(scanExitBar[i] < 0 && times[bar] >= dueTimes[i]) scanExitBar[i] = (int)bar;
+    }
+
+    fired.now = times[bar];
+    fired.ids.clear();
+    advanceTimerWheel(&wheel, times[bar], recordFiredTimer, &fired);
+    for(i = 0; i < (int)fired.ids.size(); i++)
+    {
+      BOOST_CHECK_EQUAL(wheelExitBar[fired.ids[i]], -1);
+      wheelExitBar[fired.ids[i]] = (int)bar;
+    }
+  }
+
+  for(i = 0; i < totalOrders; i++)
+  {
+    BOOST_CHECK_EQUAL(scanExitBar[i], wheelExitBar[i]);
+  }
+  BOOST_CHECK_EQUAL(wheel.totalTimers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(timerWheel_longDelaysAndCancellation)
+{
+  TimerWheel  wheel;
+  WheelTimer  timers[3];
+  FiredTimers fired;
+  time_t      start = 1325462400;
+
+  initTimerWheel(&wheel, start);
+  initWheelTimer(&timers[0], 0);
+  initWheelTimer(&timers[1], 1);
+  initWheelTimer(&timers[2], 2);
+
+  /* Beyond the span of the wheel levels, in the overflow list. */
+  scheduleWheelTimer(&wheel, &timers[0], start + 400 * SECONDS_PER_DAY);
+  scheduleWheelTimer(&wheel, &timers[1], start + 3 * SECONDS_PER_DAY);
+  scheduleWheelTimer(&wheel, &timers[2], start + 5 * SECONDS_PER_DAY);
+  cancelWheelTimer(&wheel, &timers[2]);
+  BOOST_CHECK(!isWheelTimerScheduled(&timers[2]));
+
+  fired.now = start + 3 * SECONDS_PER_DAY - 1;
+  BOOST_CHECK_EQUAL(advanceTimerWheel(&wheel, fired.now, recordFiredTimer, &fired), 0);
+
+  fired.now = start + 399 * SECONDS_PER_DAY;
+  BOOST_CHECK_EQUAL(advanceTimerWheel(&wheel, fired.now, recordFiredTimer, &fired), 1);
+  BOOST_CHECK_EQUAL(fired.ids[0], 1);
+
+  fired.now = start + 401 * SECONDS_PER_DAY;
+  BOOST_CHECK_EQUAL(advanceTimerWheel(&wheel, fired.now, recordFiredTimer, &fired), 1);
+  BOOST_CHECK_EQUAL(fired.ids[1], 0);
+  BOOST_CHECK_EQUAL(wheel.totalTimers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(calendar_matchesGmtime)
+{
+  /* 1901 - 2099 every 7 hours and 13 minutes, so every hour of the day and day of the week is visited. */
+  const time_t start = -2145916800;
+  const time_t end   = 4102444800;
+  int mismatches = 0;
+
+  for(time_t time = start; time < end; time += 7 * SECONDS_PER_HOUR + 13 * SECONDS_PER_MINUTE + 1)
+  {
+    struct tm expected, actual;
+#if defined _MSC_VER
+    if(time < 0) continue; /* gmtime on Windows rejects times before 1970 */
+    expected = *gmtime(&time);
+#else
+    gmtime_r(&time, &expected);
+#endif
+    safe_gmtime(&actual, time);
+
+    if((actual.tm_year != expected.tm_year) || (actual.tm_mon != expected.tm_mon) || (actual.tm_mday != expected.tm_mday)
+      || (actual.tm_hour != expected.tm_hour) || (actual.tm_min != expected.tm_min) || (actual.tm_sec != expected.tm_sec)
+      || (actual.tm_wday != expected.tm_wday) || (actual.tm_yday != expected.tm_yday)
+      || (calendarDayOfWeek(time) != expected.tm_wday) || (calendarDayOfYear(time) != expected.tm_yday)
+      || (calendarHour(time) != expected.tm_hour) || (calendarMinute(time) != expected.tm_min))
+    {
+      mismatches++;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(mismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(calendar_civilRoundTrip)
+{
+  for(time_t dayNumber = -800000; dayNumber < 800000; dayNumber += 3)
+  {
+    int year, month, monthDay;
+    civilFromDays(dayNumber, &year, &month, &monthDay);
+    BOOST_REQUIRE_EQUAL(daysFromCivil(year, month, monthDay), dayNumber);
+  }
+
+  BOOST_CHECK_EQUAL(daysFromCivil(1970, 1, 1), 0);
+  BOOST_CHECK_EQUAL(daysFromCivil(2000, 3, 1), 11017);
+  BOOST_CHECK_EQUAL(daysFromCivil(1969, 12, 31), -1);
+}
+
+BOOST_AUTO_TEST_CASE(calendar_cacheCollisions)
+{
+  /* Days CALENDAR_CACHE_SIZE apart share a cache entry and must evict each other cleanly. */
+  const time_t first  = 1388534400; /* 01/01/2014 */
+  const time_t second = first + CALENDAR_CACHE_SIZE * SECONDS_PER_DAY;
+  CalendarDay day;
+
+  for(int i = 0; i < 4; i++)
+  {
+    getCalendarDay(&day, first + i);
+    BOOST_CHECK_EQUAL(day.year, 2014);
+    BOOST_CHECK_EQUAL(day.month, 0);
+    BOOST_CHECK_EQUAL(day.monthDay, 1);
+
+    getCalendarDay(&day, second + i);
+    BOOST_CHECK_EQUAL(day.month, 2);
+    BOOST_CHECK_EQUAL(day.monthDay, 6);
+    BOOST_CHECK_EQUAL(day.dayOfYear, CALENDAR_CACHE_SIZE);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(calendar_benchmarkAgainstGmtime)
+{
+  /* A strategy run decomposes the same bar and order times many times over, so replay
+   * 10 years of hourly bars with each bar time decomposed 8 times. */
+  const time_t start       = 1262304000; /* 01/01/2010 */
+  const int    totalBars   = 10 * 365 * 24;
+  const int    repetitions = 8;
+  long         gmtimeSum = 0, calendarSum = 0;
+  clock_t      begin;
+  double       gmtimeSeconds, calendarSeconds;
+
+  begin = clock();
+  for(int bar = 0; bar < totalBars; bar++)
+  {
+    time_t time = start + (time_t)bar * SECONDS_PER_HOUR;
+    for(int i = 0; i < repetitions; i++)
+    {
+      struct tm timeInfo;
+#if defined _MSC_VER
+      timeInfo = *gmtime(&time);
+#else
+      gmtime_r(&time, &timeInfo);
+#endif
+      gmtimeSum += timeInfo.tm_yday + timeInfo.tm_wday + timeInfo.tm_hour;
+    }
+  }
+  gmtimeSeconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+  begin = clock();
+  for(int bar = 0; bar < totalBars; bar++)
+  {
+    time_t time = start + (time_t)bar * SECONDS_PER_HOUR;
+    for(int i = 0; i < repetitions; i++)
+    {
+      struct tm timeInfo;
+      safe_gmtime(&timeInfo, time);
+      calendarSum += timeInfo.tm_yday + timeInfo.tm_wday + timeInfo.tm_hour;
+    }
+  }
+  calendarSeconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+  BOOST_TEST_MESSAGE("gmtime: " << gmtimeSeconds << "s, safe_gmtime with calendar cache: " << calendarSeconds << "s for " << totalBars * repetitions << " decompositions");
+  BOOST_CHECK_EQUAL(calendarSum, gmtimeSum);
+}
+
+BOOST_AUTO_TEST_CASE(sharedRates_convertOncePerTick)
+{
+  const int TOTAL_INSTANCES = 50;
+  const int TOTAL_BARS      = 1000;
+  const int TOTAL_TICKS     = 100;
+
+  RatesInfo ratesInfo[MAX_RATES_BUFFERS], disabledInfo[MAX_RATES_BUFFERS];
+  SharedRatesKey key;
+  RatesBuffers* pBuffers;
+  size_t privateMemory, sharedMemory;
+  int sharedRatesId, firstSharedRatesId = -1, totalConversions = 0;
+
+  memset(ratesInfo, 0, sizeof(ratesInfo));
+  memset(disabledInfo, 0, sizeof(disabledInfo));
+  ratesInfo[0].isEnabled = TRUE;
+  ratesInfo[0].timeframe = 60;
+  ratesInfo[0].arraySize = TOTAL_BARS;
+  ratesInfo[0].point     = 0.00001;
+  ratesInfo[0].digits    = 5;
+
+  memset(&key, 0, sizeof(key));
+  strcpy(key.symbol, "EURUSD");
+  strcpy(key.timeZones, "Broker|Reference");
+  key.sourceTimeframe = 60;
+  key.timeframe       = 60;
+  key.arraySize       = TOTAL_BARS;
+
+  setExtendedBufferSize(DEFAULT_RATES_BUF_EXT);
+  resetAllRatesBuffers();
+
+  /* Before: every instance converts into its own copy. */
+  for(int instance = 0; instance < TOTAL_INSTANCES; instance++)
+  {
+    BOOST_REQUIRE_EQUAL(allocateRates(&pBuffers, 1000 + instance, ratesInfo), SUCCESS);
+  }
+  privateMemory = getRatesBuffersMemoryUsage();
+  resetAllRatesBuffers();
+  BOOST_CHECK_EQUAL(getRatesBuffersMemoryUsage(), (size_t)0);
+
+  /* After: the instances borrow one shared copy. */
+  setShareRatesBuffers(TRUE);
+  for(int instance = 0; instance < TOTAL_INSTANCES; instance++)
+  {
+    BOOST_REQUIRE_EQUAL(allocateRates(&pBuffers, 1000 + instance, disabledInfo), SUCCESS);
+    BOOST_REQUIRE_EQUAL(acquireSharedRates(1000 + instance, 0, &key, ratesInfo, &sharedRatesId), SUCCESS);
+    if(firstSharedRatesId < 0)
+    {
+      firstSharedRatesId = sharedRatesId;
+    }
+    BOOST_CHECK_EQUAL(sharedRatesId, firstSharedRatesId);
+  }
+  sharedMemory = getRatesBuffersMemoryUsage();
+
+  BOOST_TEST_MESSAGE("Rates memory for " << TOTAL_INSTANCES << " instances: " << privateMemory << " bytes private, " << sharedMemory << " bytes shared");
+  BOOST_CHECK_EQUAL(privateMemory, sharedMemory * TOTAL_INSTANCES);
+
+  for(int tick = 0; tick < TOTAL_TICKS; tick++)
+  {
+    /* Two ticks per bar, so updates within a bar are detected by close and volume. */
+    time_t sourceTime = 1262563200 + (tick / 2) * 3600;
+    double sourceClose = 1.4 + tick * 0.0001;
+
+    for(int instance = 0; instance < TOTAL_INSTANCES; instance++)
+    {
+      RatesBuffers* pSharedBuffers;
+      int ratesIndex;
+
+      if(beginSharedRatesUpdate(firstSharedRatesId, sourceTime, sourceClose, tick, &pSharedBuffers, &ratesIndex))
+      {
+        Rates* pRates = &pSharedBuffers->rates[ratesIndex];
+        pRates->info.isBufferFull = TRUE;
+        pRates->time[TOTAL_BARS - 1]  = sourceTime;
+        pRates->close[TOTAL_BARS - 1] = sourceClose;
+        totalConversions++;
+        endSharedRatesUpdate(firstSharedRatesId);
+      }
+
+      /* A chart that has not received the latest tick yet must not roll the shared rates back. */
+      BOOST_CHECK(!beginSharedRatesUpdate(firstSharedRatesId, sourceTime - 3600, sourceClose, tick, &pSharedBuffers, &ratesIndex));
+
+      BOOST_REQUIRE_EQUAL(attachSharedRates(1000 + instance), SUCCESS);
+      BOOST_REQUIRE_EQUAL(allocateRates(&pBuffers, 1000 + instance, disabledInfo), SUCCESS);
+      BOOST_CHECK(pBuffers->rates[0].info.isEnabled);
+      BOOST_CHECK_EQUAL(pBuffers->rates[0].info.arraySize, TOTAL_BARS);
+      BOOST_CHECK_EQUAL(pBuffers->rates[0].time[TOTAL_BARS - 1], sourceTime);
+      BOOST_CHECK_EQUAL(pBuffers->rates[0].close[TOTAL_BARS - 1], sourceClose);
+      detachSharedRates(1000 + instance);
+      BOOST_CHECK(pBuffers->rates[0].close == NULL);
+    }
+  }
+
+  BOOST_TEST_MESSAGE("Conversions for " << TOTAL_TICKS << " ticks: " << TOTAL_TICKS * TOTAL_INSTANCES << " private, " << totalConversions << " shared");
+  BOOST_CHECK_EQUAL(totalConversions, TOTAL_TICKS);
+  BOOST_CHECK_EQUAL(getSharedRatesConversions(firstSharedRatesId), TOTAL_TICKS);
+
+  /* Another time zone configuration gets its own rates. */
+  strcpy(key.timeZones, "Broker|Other");
+  BOOST_REQUIRE_EQUAL(allocateRates(&pBuffers, 2000, disabledInfo), SUCCESS);
+  BOOST_REQUIRE_EQUAL(acquireSharedRates(2000, 0, &key, ratesInfo, &sharedRatesId), SUCCESS);
+  BOOST_CHECK_NE(sharedRatesId, firstSharedRatesId);
+  BOOST_CHECK_EQUAL(getRatesBuffersMemoryUsage(), sharedMemory * 2);
+
+  /* The last instance to release the shared rates frees them. */
+  resetInstanceBuffer(2000);
+  for(int instance = 0; instance < TOTAL_INSTANCES - 1; instance++)
+  {
+    resetInstanceBuffer(1000 + instance);
+  }
+  BOOST_CHECK_EQUAL(getRatesBuffersMemoryUsage(), sharedMemory);
+  resetInstanceBuffer(1000 + TOTAL_INSTANCES - 1);
+  BOOST_CHECK_EQUAL(getRatesBuffersMemoryUsage(), (size_t)0);
+
+  setShareRatesBuffers(FALSE);
+  resetAllRatesBuffers();
+}
+
+BOOST_AUTO_TEST_CASE(barCloseStamp_invalidatedOnBarClose)
+{
+  const int BARS = 4;
+  time_t    times[BARS]  = { 0, 3600, 7200, 10800 };
+  double    opens[BARS]  = { 1.0, 1.1, 1.2, 1.3 };
+  double    highs[BARS]  = { 1.5, 1.6, 1.7, 1.8 };
+  double    lows[BARS]   = { 0.5, 0.6, 0.7, 0.8 };
+  double    closes[BARS] = { 1.1, 1.2, 1.3, 1.4 };
+  double    volumes[BARS] = { 0 };
+  Rates         rates;
+  BarCloseStamp stamp;
+
+  memset(&rates, 0, sizeof(Rates));
+  rates.info.arraySize = BARS;
+  rates.time   = times;
+  rates.open   = opens;
+  rates.high   = highs;
+  rates.low    = lows;
+  rates.close  = closes;
+  rates.volume = volumes;
+
+  invalidateBarCloseStamp(&stamp);
+  BOOST_CHECK(!isBarCloseStampCurrent(&rates, 14, &stamp));
+
+  setBarCloseStamp(&rates, 14, &stamp);
+  BOOST_CHECK(isBarCloseStampCurrent(&rates, 14, &stamp));
+  BOOST_CHECK(!isBarCloseStampCurrent(&rates, 20, &stamp));
+
+  /* Ticks only update the forming bar. */
+  highs[BARS - 1]  = 2.0;
+  lows[BARS - 1]   = 0.1;
+  closes[BARS - 1] = 1.9;
+  BOOST_CHECK(isBarCloseStampCurrent(&rates, 14, &stamp));
+
+  /* Reloaded history rewrites the last closed bar. */
+  closes[BARS - 2] = 1.25;
+  BOOST_CHECK(!isBarCloseStampCurrent(&rates, 14, &stamp));
+  setBarCloseStamp(&rates, 14, &stamp);
+
+  /* A new bar opens. */
+  memmove(times, times + 1, (BARS - 1) * sizeof(time_t));
+  memmove(closes, closes + 1, (BARS - 1) * sizeof(double));
+  times[BARS - 1]  = 14400;
+  closes[BARS - 1] = closes[BARS - 2];
+  BOOST_CHECK(!isBarCloseStampCurrent(&rates, 14, &stamp));
+
+  /* Too few bars to have a closed one. */
+  setBarCloseStamp(&rates, 14, &stamp);
+  rates.info.arraySize = 1;
+  setBarCloseStamp(&rates, 14, &stamp);
+  BOOST_CHECK(!isBarCloseStampCurrent(&rates, 14, &stamp));
+}
+
+BOOST_AUTO_TEST_CASE(barCloseStamp_instanceSlotsAreReleased)
+{
+  static int owners[MAX_INSTANCES];
+  BOOL       isClaimed;
+  int        index;
+
+  index = claimInstanceStampSlot(owners, 0, &isClaimed);
+  BOOST_CHECK_EQUAL(index, 0);
+  BOOST_CHECK(isClaimed);
+  BOOST_CHECK_EQUAL(claimInstanceStampSlot(owners, 0, &isClaimed), index);
+  BOOST_CHECK(!isClaimed);
+
+  /* More distinct instances than slots over time, as in optimizer runs. */
+  for(int instanceId = 1; instanceId <= 3 * MAX_INSTANCES; instanceId++)
+  {
+    BOOST_REQUIRE(claimInstanceStampSlot(owners, instanceId, &isClaimed) > 0);
+    BOOST_REQUIRE(isClaimed);
+    BOOST_REQUIRE(releaseInstanceStampSlot(owners, instanceId) > 0);
+  }
+
+  for(int instanceId = 1; instanceId < MAX_INSTANCES; instanceId++)
+  {
+    BOOST_REQUIRE(claimInstanceStampSlot(owners, instanceId, &isClaimed) >= 0);
+  }
+  BOOST_CHECK_EQUAL(claimInstanceStampSlot(owners, MAX_INSTANCES, &isClaimed), -1);
+
+  /* A released ID is claimed again, so its values are recomputed. */
+  BOOST_CHECK_EQUAL(releaseInstanceStampSlot(owners, 0), index);
+  BOOST_CHECK_EQUAL(releaseInstanceStampSlot(owners, 0), -1);
+  BOOST_CHECK_EQUAL(claimInstanceStampSlot(owners, 0, &isClaimed), index);
+  BOOST_CHECK(isClaimed);
+}
+
+BOOST_AUTO_TEST_CASE(orderHistoryIndex_matchesScan)
+{
+  /* Windows around a new year with a Monday in the previous year (2015) and one without (2017). */
+  const time_t firstTimes[] = { 1448928000, 1512086400, 1325376000 };
+
+  for(unsigned int seed = 1; seed <= 30; seed++)
+  {
+    time_t         firstTime = firstTimes[seed % 3];
+    int            days      = 14 + (int)(seed % 60);
+    ScannedHistory history   = randomOrderHistory(seed, (seed % 2) ? ORDERINFO_ARRAY_SIZE : 500, firstTime, days);
+    OrderHistoryIndex index;
+
+    BOOST_REQUIRE(initOrderHistoryIndex(&index, &history.orders[0], (int)history.orders.size()) == SUCCESS);
+    checkOrderHistoryIndex(&index, history, firstTime, days);
+
+    freeOrderHistoryIndex(&index);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(orderHistoryIndex_updatesAcrossCalls)
+{
+  const time_t firstTimes[] = { 1448928000, 1512086400, 1325376000 };
+
+  for(unsigned int seed = 1; seed <= 12; seed++)
+  {
+    time_t             firstTime = firstTimes[seed % 3];
+    int                days      = 14 + (int)(seed % 40);
+    ScannedHistory     history   = randomOrderHistory(seed, 500, firstTime, days);
+    OrderHistoryIndex* pIndex    = getInstanceOrderHistoryIndex(7000 + seed, TRUE);
+
+    BOOST_REQUIRE(pIndex != NULL);
+    BOOST_REQUIRE(updateOrderHistoryIndex(pIndex, &history.orders[0], (int)history.orders.size()) == SUCCESS);
+    checkOrderHistoryIndex(pIndex, history, firstTime, days);
+
+    for(int call = 0; call < 20; call++)
+    {
+      /* Each call sees the history in a new array, as the platform sends it. */
+      ScannedHistory next = history;
+      int            changes = 1 + rand() % 20;
+
+      for(int change = 0; change < changes; change++)
+      {
+        int        i    = rand() % (int)next.orders.size();
+        OrderInfo& o    = next.orders[i];
+        int        roll = rand() % 10;
+
+        if(o.ticket == 0)
+        {
+          /* A new order fills an empty entry. */
+          o.ticket     = 100000 + call * 100 + change;
+          o.type       = (OrderType)(rand() % 6);
+          o.openTime   = firstTime + (time_t)(rand() % days) * SECONDS_PER_DAY + rand() % SECONDS_PER_DAY;
+          o.isOpen     = (rand() % 2 == 0) ? TRUE : FALSE;
+          o.openPrice  = (float)(1.30 + (rand() % 200) * 0.0001);
+          o.closePrice = (float)(1.30 + (rand() % 200) * 0.0001);
+          o.lots       = (float)(0.01 * (1 + rand() % 100));
+          o.profit     = (float)((rand() % 3) - 1) * o.lots;
+        }
+        else if(o.isOpen)
+        {
+          /* Open orders change on every tick and sometimes close. */
+          o.profit     = (float)((rand() % 3) - 1) * o.lots;
+          o.closePrice = (float)(1.30 + (rand() % 200) * 0.0001);
+          if(roll < 5) o.isOpen = FALSE;
+        }
+        else if(roll == 0)
+        {
+          /* Orders are removed or moved, which needs a rebuild. */
+          std::swap(o, next.orders[rand() % (int)next.orders.size()]);
+        }
+      }
+
+      BOOST_REQUIRE(updateOrderHistoryIndex(pIndex, &next.orders[0], (int)next.orders.size()) == SUCCESS);
+      checkOrderHistoryIndex(pIndex, next, firstTime, days);
+      history = next;
+    }
+
+    releaseInstanceOrderHistoryIndex(7000 + seed);
+    BOOST_CHECK(getInstanceOrderHistoryIndex(7000 + seed, FALSE) == NULL);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(openPositions_matchesScan)
+{
+  for(unsigned int seed = 1; seed <= 40; seed++)
+  {
+    ScannedHistory history = randomOrderHistory(seed, (seed % 2) ? ORDERINFO_ARRAY_SIZE : 500, 1448928000, 30);
+    OpenPositions  positions;
+    double         lotsAtPrice, buyLots = 0, buyLotsTimesOpen = 0;
+
+    /* Prices that floats hold exactly so that some orders are opened at the current price. */
+    history.bid = (float)1.3100;
+    history.ask = (float)1.3102;
+    for(size_t i = 0; i < history.orders.size(); i++)
+    {
+      OrderInfo& o = history.orders[i];
+      int        roll = rand() % 10;
+
+      if(roll == 0) o.openPrice = (float)history.ask;
+      if(roll == 1) o.openPrice = (float)history.bid;
+      o.stopLoss = (roll == 2) ? 0 : (roll == 3) ? o.openPrice : (float)(1.30 + (rand() % 200) * 0.0001);
+      if(o.ticket != 0 && o.isOpen && o.type == BUY)
+      {
+        buyLots          += o.lots;
+        buyLotsTimesOpen += o.lots * (double)o.openPrice;
+      }
+    }
+
+    BOOST_REQUIRE(initOpenPositions(&positions, &history.orders[0], (int)history.orders.size()) == SUCCESS);
+
+    for(int ignored = 0; ignored <= 1; ignored++)
+    {
+      double pnl = getOpenPositionsPNL(&positions, history.bid, history.ask, modelLossPerLot(1), (BOOL)ignored, &lotsAtPrice);
+      pnl += lotsAtPrice * modelLossPerLot(0);
+
+      BOOST_CHECK_SMALL(pnl - scanStrategyPNL(history, (BOOL)ignored), 1e-6);
+      BOOST_CHECK_SMALL(getOpenPositionsStopLossRisk(&positions, modelLossPerLot(1), (BOOL)ignored) - scanStrategyRisk(history, (BOOL)ignored), 1e-6);
+    }
+
+    BOOST_CHECK_SMALL(getOpenPositionsVolatilityRisk(&positions, modelLossPerLot(0.0050), FALSE) - scanStrategyVolRisk(history, 0.0050, false), 1e-6);
+    BOOST_CHECK_SMALL(getOpenPositionsVolatilityRisk(&positions, modelLossPerLot(0.0050), TRUE) - scanStrategyVolRisk(history, 0.0050, true), 1e-6);
+    BOOST_CHECK_SMALL(getOpenPositionsVolatilityRisk(&positions, modelLossPerLot(0), FALSE) - scanStrategyVolRisk(history, 0, false), 1e-6);
+
+    if(buyLots > 0)
+    {
+      BOOST_CHECK_CLOSE(getOpenPositionsBreakEvenPrice(&positions, LONG_POSITIONS), buyLotsTimesOpen / buyLots, 1e-9);
+    }
+
+    freeOpenPositions(&positions);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(derivedRates_matchRebuild)
+{
+  const int    BARS   = 3000;
+  const int    WINDOW = 400;
+  const int    TICKS  = 3;
+  const DerivedRatesType types[]    = { DERIVED_RENKO_RATES, DERIVED_CONSTANT_VOLUME_RATES };
+  const double barSizes[][2]        = { { 0.00155, 0.00415 }, { 50, 230 } };
+  std::vector<time_t> times(BARS);
+  std::vector<double> opens(BARS), highs(BARS), lows(BARS), closes(BARS), volumes(BARS);
+  double price = 1.3;
+
+  srand(7);
+  for(int i = 0; i < BARS; i++)
+  {
+    times[i]   = 1400000000 + (time_t)i * 60;
+    opens[i]   = price;
+    closes[i]  = price + (rand() % 41 - 20) * 0.0001;
+    highs[i]   = std::max(opens[i], closes[i]) + (rand() % 10) * 0.0001;
+    lows[i]    = std::min(opens[i], closes[i]) - (rand() % 10) * 0.0001;
+    volumes[i] = 1 + rand() % 60;
+    price      = closes[i];
+  }
+
+  for(int t = 0; t < 2; t++)
+  {
+    DerivedRatesBuilder builder;
+    bool isMatching = true;
+
+    initDerivedRatesBuilder(&builder);
+
+    for(int n = 1; n <= BARS && isMatching; n++)
+    {
+      /* The source grows until the window is full and slides afterwards. */
+      int    first    = std::max(0, n - WINDOW);
+      int    last     = n - 1;
+      double barSize  = barSizes[t][(n > BARS / 2) ? 1 : 0];
+      double high     = highs[last], low = lows[last], close = closes[last], volume = volumes[last];
+      Rates  source;
+
+      memset(&source, 0, sizeof(Rates));
+      source.info.arraySize = n - first;
+      source.time   = &times[first];
+      source.open   = &opens[first];
+      source.high   = &highs[first];
+      source.low    = &lows[first];
+      source.close  = &closes[first];
+      source.volume = &volumes[first];
+
+      for(int tick = 1; tick <= TICKS && isMatching; tick++)
+      {
+        highs[last]   = opens[last] + (high - opens[last]) * tick / TICKS;
+        lows[last]    = opens[last] - (opens[last] - low) * tick / TICKS;
+        closes[last]  = (tick == TICKS) ? close : opens[last];
+        volumes[last] = (tick == TICKS) ? volume : volume * tick / TICKS;
+
+        BOOST_REQUIRE_EQUAL(updateDerivedRates(&builder, types[t], barSize, &source), SUCCESS);
+        isMatching = isSameDerivedRates(scanDerivedRates(source, types[t], barSize), builder.rates);
+      }
+      highs[last] = high; lows[last] = low; closes[last] = close; volumes[last] = volume;
+    }
+
+    BOOST_CHECK(isMatching);
+    freeDerivedRatesBuilder(&builder);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(derivedRates_releasedWithInstance)
+{
+  time_t times[]   = { 1400000000, 1400000060, 1400000120 };
+  double prices[]  = { 1.3000, 1.3050, 1.3100 };
+  double volumes[] = { 10, 10, 10 };
+  Rates  source;
+
+  memset(&source, 0, sizeof(Rates));
+  source.info.arraySize = 3;
+  source.time   = times;
+  source.open   = prices;
+  source.high   = prices;
+  source.low    = prices;
+  source.close  = prices;
+  source.volume = volumes;
+
+  for(int ratesIndex = 5; ratesIndex <= 6; ratesIndex++)
+  {
+    DerivedRatesBuilder* pBuilder = getDerivedRatesBuilder(9100, ratesIndex, TRUE);
+    BOOST_REQUIRE(pBuilder != NULL);
+    BOOST_REQUIRE_EQUAL(updateDerivedRates(pBuilder, DERIVED_RENKO_RATES, 0.0010, &source), SUCCESS);
+    BOOST_CHECK(pBuilder->rates.time != NULL);
+  }
+  BOOST_REQUIRE(getDerivedRatesBuilder(9101, 5, TRUE) != NULL);
+
+  releaseInstanceDerivedRatesBuilders(9100);
+
+  BOOST_CHECK(getDerivedRatesBuilder(9100, 5, FALSE) == NULL);
+  BOOST_CHECK(getDerivedRatesBuilder(9100, 6, FALSE) == NULL);
+  BOOST_CHECK(getDerivedRatesBuilder(9101, 5, FALSE) != NULL);
+
+  releaseInstanceDerivedRatesBuilders(9101);
+}
+
+BOOST_AUTO_TEST_CASE(tickJournal_ringAndImport)
+{
+  const char* pPath    = "tickJournalTest.ticks";
+  const char* pCsvPath = "tickJournalTest.csv";
+  const int   CAPACITY = 50;
+  TickJournal journal;
+  BOOL        isCreated;
+  int         imported;
+  FILE*       fp;
+
+  remove(pPath);
+  BOOST_REQUIRE_EQUAL(openTickJournal(&journal, pPath, CAPACITY, &isCreated), SUCCESS);
+  BOOST_CHECK(isCreated);
+  BOOST_CHECK_EQUAL(getTickJournalCount(&journal), 0);
+
+  for(int i = 0; i < 120; i++)
+  {
+    appendTickJournal(&journal, 1000 + i, 1.3 + i * 0.0001, 1.3002 + i * 0.0001);
+    BOOST_CHECK_EQUAL(getTickJournalCount(&journal), std::min(i + 1, CAPACITY));
+  }
+  BOOST_CHECK_EQUAL(getTickJournalRecord(&journal, 0)->time, 1070);
+  BOOST_CHECK_EQUAL(getTickJournalRecord(&journal, CAPACITY - 1)->time, 1119);
+  closeTickJournal(&journal);
+
+  /* The ticks survive reopening. */
+  BOOST_REQUIRE_EQUAL(openTickJournal(&journal, pPath, CAPACITY, &isCreated), SUCCESS);
+  BOOST_CHECK(!isCreated);
+  BOOST_REQUIRE_EQUAL(getTickJournalCount(&journal), CAPACITY);
+  for(int i = 0; i < CAPACITY; i++)
+  {
+    const TickRecord* pRecord = getTickJournalRecord(&journal, i);
+    BOOST_CHECK_EQUAL(pRecord->time, 1070 + i);
+    BOOST_CHECK_EQUAL(pRecord->bid, 1.3 + (70 + i) * 0.0001);
+    BOOST_CHECK_EQUAL(pRecord->ask, 1.3002 + (70 + i) * 0.0001);
+  }
+  closeTickJournal(&journal);
+
+  /* A different capacity starts a new journal, which imports the CSV ticks. */
+  fp = fopen(pCsvPath, "w");
+  BOOST_REQUIRE(fp != NULL);
+  for(int i = 0; i < 30; i++)
+  {
+    fprintf(fp, "%d,%lf,%lf\n", 2000 + i, 1.25 + i * 0.001, 1.2502 + i * 0.001);
+  }
+  fclose(fp);
+
+  BOOST_REQUIRE_EQUAL(openTickJournal(&journal, pPath, CAPACITY / 2, &isCreated), SUCCESS);
+  BOOST_CHECK(isCreated);
+  BOOST_REQUIRE_EQUAL(importTickJournalCSV(&journal, pCsvPath, &imported), SUCCESS);
+  BOOST_CHECK_EQUAL(imported, 30);
+  BOOST_REQUIRE_EQUAL(getTickJournalCount(&journal), CAPACITY / 2);
+  BOOST_CHECK_EQUAL(getTickJournalRecord(&journal, 0)->time, 2005);
+  BOOST_CHECK_CLOSE(getTickJournalRecord(&journal, 0)->bid, 1.255, 1e-9);
+
+  resetTickJournal(&journal);
+  BOOST_CHECK_EQUAL(getTickJournalCount(&journal), 0);
+  closeTickJournal(&journal);
+
+  remove(pPath);
+  remove(pCsvPath);
+}
+
+BOOST_AUTO_TEST_CASE(sessionTracker_matchesBackwardWalk)
+{
+  const int BARS   = 2000;
+  const int WINDOW = 100; /* Shorter than a week of hourly bars, so week sessions outlive the buffer. */
+  std::vector<time_t> times;
+  std::vector<double> opens, highs, lows, closes, volumes;
+  time_t barTime = 1400371200; /* Sunday 18/05/2014 00:00 */
+  double price   = 1.3;
+  SessionTracker tracker;
+  bool   isMatching = true;
+
+  srand(11);
+  while((int)times.size() < BARS)
+  {
+    /* Hourly bars without Saturdays and with a few missing hours. */
+    if((calendarDayOfWeek(barTime) != 6) && (rand() % 20 != 0))
+    {
+      double close = price + (rand() % 41 - 20) * 0.0001;
+      times.push_back(barTime);
+      opens.push_back(price);
+      closes.push_back(close);
+      highs.push_back(std::max(price, close) + (rand() % 10) * 0.0001);
+      lows.push_back(std::min(price, close) - (rand() % 10) * 0.0001);
+      volumes.push_back(1 + rand() % 60);
+      price = close;
+    }
+    barTime += 3600;
+  }
+
+  initSessionTracker(&tracker);
+
+  for(int n = 2; n <= BARS && isMatching; n += 1 + rand() % 3)
+  {
+    int   first = std::max(0, n - WINDOW), lastClosed = n - 2;
+    Rates source;
+
+    memset(&source, 0, sizeof(Rates));
+    source.info.arraySize = n - first;
+    source.time   = &times[first];
+    source.open   = &opens[first];
+    source.high   = &highs[first];
+    source.low    = &lows[first];
+    source.close  = &closes[first];
+    source.volume = &volumes[first];
+
+    BOOST_REQUIRE_EQUAL(updateSessionTracker(&tracker, &source), SUCCESS);
+
+    for(int type = 0; type < TOTAL_SESSION_TYPES && isMatching; type++)
+    {
+      const SessionBar* pSession = getSessionBar(&tracker, (SessionType)type);
+      time_t key   = getSessionKey((SessionType)type, times[lastClosed]);
+      int    start = lastClosed;
+      double high, low, volume = 0;
+
+      /* The session over the whole history, walking back from the newest closed bar. */
+      while((start > 0) && (getSessionKey((SessionType)type, times[start - 1]) == key))
+      {
+        start--;
+      }
+      high = highs[start];
+      low  = lows[start];
+      for(int i = start; i <= lastClosed; i++)
+      {
+        high    = std::max(high, highs[i]);
+        low     = std::min(low, lows[i]);
+        volume += volumes[i];
+      }
+
+      isMatching = (pSession->key == key) && (pSession->time == times[start])
+        && (pSession->startIndex == std::max(0, start - first)) && (pSession->bars == lastClosed - start + 1)
+        && (pSession->open == opens[start]) && (pSession->close == closes[lastClosed])
+        && (pSession->high == high) && (pSession->low == low) && (pSession->volume == volume);
+      BOOST_CHECK_MESSAGE(isMatching, "session type " << type << " differs after " << n << " bars");
+    }
+  }
+
+  /* A sunday bar opens the trading week and a saturday one still belongs to it. */
+  BOOST_CHECK_EQUAL(getSessionKey(SESSION_WEEK, 1400371200), getSessionKey(SESSION_WEEK, 1400371200 + 6 * 86400 + 3600));
+  BOOST_CHECK_EQUAL(getSessionKey(SESSION_WEEK, 1400371200) + 1, getSessionKey(SESSION_WEEK, 1400371200 + 7 * 86400));
+  BOOST_CHECK_EQUAL(getSessionKey(SESSION_DAY, 1400371200 + 86399) + 1, getSessionKey(SESSION_DAY, 1400371200 + 86400));
+}
+
+BOOST_AUTO_TEST_CASE(barFile_loadsBinaryAndCsvLayouts)
+{
+  const char* lines[] = {
+    "Date,Open,High,Low,Close,Volume",
+    "1401062400, 1.370000, 1.380000, 1.360000, 1.375000, 120.000000",
+    " 26/05/14 01:00, 1.375000, 1.385000, 1.365000, 1.380000, 80.000000",
+    " 2014-05-27, 1.380000, 1.390000, 1.370000, 1.385000, 60.000000",
+    "2014.05.27,03:00,1.385,1.395,1.375,1.39,40"
+  };
+  const time_t expectedTimes[] = {1401062400, 1401066000, 1401148800, 1401159600};
+  BarSeries csvSeries, binarySeries;
+  BarRecord bar;
+  FILE*     fp;
+
+  BOOST_CHECK(!parseBarLine(lines[0], &bar));
+
+  fp = fopen("barFileTest.csv", "w");
+  BOOST_REQUIRE(fp != NULL);
+  for(int i = 0; i < 5; i++)
+  {
+    fprintf(fp, "%s\n", lines[i]);
+  }
+  fclose(fp);
+
+  initBarSeries(&csvSeries);
+  BOOST_REQUIRE_EQUAL(loadBarFile("barFileTest.csv", &csvSeries), SUCCESS);
+  BOOST_REQUIRE_EQUAL(csvSeries.size, 4);
+  for(int i = 0; i < 4; i++)
+  {
+    BOOST_CHECK_EQUAL(csvSeries.time[i], expectedTimes[i]);
+    BOOST_CHECK_CLOSE(csvSeries.close[i], 1.375 + 0.005 * i, 1e-9);
+  }
+  BOOST_CHECK_CLOSE(csvSeries.volume[3], 40.0, 1e-9);
+
+  /* A binary round trip keeps every value and the timeframe. */
+  csvSeries.timeframe = 60;
+  BOOST_REQUIRE_EQUAL(saveBarFile("barFileTest.bin", &csvSeries), SUCCESS);
+  initBarSeries(&binarySeries);
+  BOOST_REQUIRE_EQUAL(loadBarFile("barFileTest.bin", &binarySeries), SUCCESS);
+  BOOST_REQUIRE_EQUAL(binarySeries.size, 4);
+  BOOST_CHECK_EQUAL(binarySeries.timeframe, 60);
+  for(int i = 0; i < 4; i++)
+  {
+    BOOST_CHECK_EQUAL(binarySeries.time[i], csvSeries.time[i]);
+    BOOST_CHECK_EQUAL(binarySeries.open[i], csvSeries.open[i]);
+    BOOST_CHECK_EQUAL(binarySeries.high[i], csvSeries.high[i]);
+    BOOST_CHECK_EQUAL(binarySeries.low[i], csvSeries.low[i]);
+    BOOST_CHECK_EQUAL(binarySeries.close[i], csvSeries.close[i]);
+    BOOST_CHECK_EQUAL(binarySeries.volume[i], csvSeries.volume[i]);
+  }
+
+  BOOST_CHECK_EQUAL(loadBarFile("barFileTestMissing.csv", &binarySeries), ERROR_IN_RATES_RETRIEVAL);
+
+  freeBarSeries(&csvSeries);
+  freeBarSeries(&binarySeries);
+  remove("barFileTest.csv");
+  remove("barFileTest.bin");
+}
+
+BOOST_AUTO_TEST_CASE(barRecorder_buffersIndexesAndExports)
+{
+  const int    start = 1401062400; /* Monday 26/05/14 00:00 */
+  BarRecorder  recorder;
+  BarRecord    bar;
+  BarSeries    series;
+  char         line[256];
+  int          exported, lines;
+  FILE*        fp;
+
+  remove("barRecorderTest.bin");
+  remove("barRecorderTest.bin.idx");
+
+  /* Two legacy csv bars are imported into the new file. */
+  fp = fopen("barRecorderTest.csv", "w");
+  BOOST_REQUIRE(fp != NULL);
+  fprintf(fp, "%d, 1.0, 1.1, 0.9, 1.05, 10\n%d, 1.0, 1.1, 0.9, 1.05, 10\n", start, start + 3600);
+  fclose(fp);
+
+  BOOST_REQUIRE_EQUAL(openBarRecorder(&recorder, "barRecorderTest.bin", 60, "barRecorderTest.csv"), SUCCESS);
+  BOOST_CHECK_EQUAL(getBarRecorderCount(&recorder), 2);
+
+  memset(&bar, 0, sizeof(BarRecord));
+  for(int i = 2; i < 100; i++)
+  {
+    bar.time  = start + 3600 * i;
+    bar.open  = 1.0 + i;
+    bar.high  = 1.5 + i;
+    bar.low   = 0.5 + i;
+    bar.close = 1.25 + i;
+    BOOST_REQUIRE_EQUAL(appendBarRecorder(&recorder, &bar), SUCCESS);
+  }
+
+  /* Bars that are not newer than the latest one are dropped. */
+  BOOST_REQUIRE_EQUAL(appendBarRecorder(&recorder, &bar), SUCCESS);
+  bar.time = start;
+  BOOST_REQUIRE_EQUAL(appendBarRecorder(&recorder, &bar), SUCCESS);
+  BOOST_CHECK_EQUAL(getBarRecorderCount(&recorder), 100);
+
+  /* Beyond the imported bars, only full buffers have reached the file so far. */
+  BOOST_CHECK_EQUAL(recorder.writtenBars, 2 + BAR_RECORDER_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(recorder.bufferedBars, 98 - BAR_RECORDER_BUFFER_SIZE);
+  closeBarRecorder(&recorder);
+
+  initBarSeries(&series);
+  BOOST_REQUIRE_EQUAL(loadBarFile("barRecorderTest.bin", &series), SUCCESS);
+  BOOST_REQUIRE_EQUAL(series.size, 100);
+  BOOST_CHECK_EQUAL(series.timeframe, 60);
+  for(int i = 0; i < 100; i++)
+  {
+    BOOST_CHECK_EQUAL(series.time[i], (time_t)(start + 3600 * i));
+  }
+  BOOST_CHECK_CLOSE(series.close[99], 100.25, 1e-9);
+  freeBarSeries(&series);
+
+  /* A lost index is rebuilt when the file is reopened and appending continues after the latest bar. */
+  remove("barRecorderTest.bin.idx");
+  BOOST_REQUIRE_EQUAL(openBarRecorder(&recorder, "barRecorderTest.bin", 60, NULL), SUCCESS);
+  BOOST_CHECK_EQUAL(recorder.writtenDays, 5);
+  BOOST_CHECK_EQUAL(recorder.lastTime, start + 3600 * 99);
+  bar.time = start + 3600 * 100;
+  BOOST_REQUIRE_EQUAL(appendBarRecorder(&recorder, &bar), SUCCESS);
+  closeBarRecorder(&recorder);
+  BOOST_CHECK_EQUAL(recorder.writtenDays, 5);
+
+  /* The third day has 24 bars and every layout reads back. */
+  BOOST_REQUIRE_EQUAL(exportBarFileText("barRecorderTest.bin", "barRecorderTest.txt", BAR_TEXT_DATE_AS_STRING, start + 2 * 86400, start + 3 * 86400 - 1, &exported), SUCCESS);
+  BOOST_CHECK_EQUAL(exported, 24);
+
+  fp = fopen("barRecorderTest.txt", "r");
+  BOOST_REQUIRE(fp != NULL);
+  BOOST_REQUIRE(fgets(line, sizeof(line), fp) != NULL);
+  BOOST_CHECK_EQUAL(std::string(line), std::string(" 28/05/14 00:00, 49.000000, 49.500000, 48.500000, 49.250000, 0.000000\n"));
+  BOOST_REQUIRE(parseBarLine(line, &bar));
+  BOOST_CHECK_EQUAL(bar.time, start + 2 * 86400);
+  for(lines = 1; fgets(line, sizeof(line), fp) != NULL; lines++);
+  fclose(fp);
+  BOOST_CHECK_EQUAL(lines, 24);
+
+  BOOST_REQUIRE_EQUAL(exportBarFileText("barRecorderTest.bin", "barRecorderTest.txt", BAR_TEXT_DATE_AS_INTEGER, 0, 0, &exported), SUCCESS);
+  BOOST_CHECK_EQUAL(exported, 101);
+  BOOST_REQUIRE_EQUAL(exportBarFileText("barRecorderTest.bin", "barRecorderTest.txt", BAR_TEXT_DATE_FOR_R, start + 4 * 86400, 0, &exported), SUCCESS);
+  BOOST_CHECK_EQUAL(exported, 5);
+  BOOST_CHECK_EQUAL(exportBarFileText("barRecorderTest.bin", "barRecorderTest.txt", BAR_TEXT_NONE, 0, 0, &exported), INVALID_PARAMETER);
+  BOOST_CHECK_EQUAL(exportBarFileText("barRecorderTestMissing.bin", "barRecorderTest.txt", BAR_TEXT_DATE_FOR_R, 0, 0, &exported), ERROR_IN_RATES_RETRIEVAL);
+
+  /* Instance recorders rewrite their csv file on close. */
+  BarRecorder* pRecorder;
+  BOOST_REQUIRE_EQUAL(getInstanceBarRecorder(7, "barRecorderTest.bin", 60, "barRecorderTest.csv", BAR_TEXT_DATE_AS_INTEGER, &pRecorder), SUCCESS);
+  BOOST_CHECK_EQUAL(getBarRecorderCount(pRecorder), 101);
+  closeInstanceBarRecorder(7);
+  initBarSeries(&series);
+  BOOST_REQUIRE_EQUAL(loadBarFile("barRecorderTest.csv", &series), SUCCESS);
+  BOOST_CHECK_EQUAL(series.size, 101);
+  freeBarSeries(&series);
+
+  remove("barRecorderTest.bin");
+  remove("barRecorderTest.bin.idx");
+  remove("barRecorderTest.csv");
+  remove("barRecorderTest.txt");
+}
+
+namespace
+{
+  /* Boost.Test is not thread safe, so the tasks only count and the checks run on the test thread. */
+  void countParallelTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    std::vector<int>* pCounts = (std::vector<int>*)pContext;
+    (*pCounts)[taskIndex] += (threadIndex >= 0 && threadIndex < MAX_WORKER_THREADS) ? 1 : 100;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(workerThreads_runEveryTaskOnce)
+{
+  const int threadCounts[] = {0, 1, 3, 8, 500};
+
+  BOOST_CHECK(getProcessorCount() >= 1);
+  BOOST_CHECK_EQUAL(runParallelTasks(0, 4, countParallelTask, NULL), SUCCESS);
+  BOOST_CHECK_EQUAL(runParallelTasks(1, 4, NULL, NULL), NULL_POINTER);
+
+  for(int t = 0; t < 5; t++)
+  {
+    std::vector<int> counts(1000, 0);
+
+    BOOST_REQUIRE_EQUAL(runParallelTasks((int)counts.size(), threadCounts[t], countParallelTask, &counts), SUCCESS);
+    BOOST_CHECK_EQUAL(std::count(counts.begin(), counts.end(), 1), (int)counts.size());
+  }
+}
+
+namespace
+{
+  struct SeqlockRace
+  {
+    InstanceStatus* pStatus;
+    int             writes;
+    int             reads;
+    int             tornReads;
+    volatile int    isWriting;
+  };
+
+  /* Task 0 rewrites every value of the slot with the same number while task 1 checks that copies never mix two writes. */
+  void seqlockRaceTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    SeqlockRace*   pRace = (SeqlockRace*)pContext;
+    InstanceStatus copy;
+
+    if(taskIndex == 0)
+    {
+      for(int i = 1; i <= pRace->writes; i++)
+      {
+        beginStatusWrite(&pRace->pStatus->sequence);
+        pRace->pStatus->heartBeatTime = i;
+        for(int j = 0; j < STATUS_MAX_UI_VALUES; j++)
+        {
+          pRace->pStatus->uiValues[j] = i;
+        }
+        endStatusWrite(&pRace->pStatus->sequence);
+      }
+      pRace->isWriting = 0;
+      return;
+    }
+
+    while(pRace->isWriting)
+    {
+      if(!readInstanceStatus(pRace->pStatus, &copy))
+      {
+        continue;
+      }
+      pRace->reads++;
+      for(int j = 0; j < STATUS_MAX_UI_VALUES; j++)
+      {
+        if(copy.uiValues[j] != copy.heartBeatTime)
+        {
+          pRace->tornReads++;
+          break;
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(statusSegment_slotsAndSeqlock)
+{
+  const int       instanceId = 987654;
+  InstanceStatus* pStatus = getInstanceStatus(instanceId);
+  InstanceStatus  copy;
+  SymbolStatus*   pSymbol;
+  SymbolStatus    symbolCopy;
+  SeqlockRace     race;
+
+  BOOST_REQUIRE(pStatus != NULL);
+  BOOST_CHECK(getInstanceStatus(instanceId) == pStatus);
+  BOOST_CHECK(getInstanceStatus(instanceId + 1) != pStatus);
+
+  beginStatusWrite(&pStatus->sequence);
+  BOOST_CHECK(!readInstanceStatus(pStatus, &copy));
+  pStatus->heartBeatTime = 1401062400;
+  pStatus->heartBeatHour = 0;
+  pStatus->uiValuesCount = 1;
+  strcpy(pStatus->uiNames[0], "strategyATR");
+  pStatus->uiValues[0] = 0.0125;
+  endStatusWrite(&pStatus->sequence);
+
+  BOOST_REQUIRE(readInstanceStatus(pStatus, &copy));
+  BOOST_CHECK_EQUAL(copy.owner, instanceId + 1);
+  BOOST_CHECK_EQUAL(copy.heartBeatTime, 1401062400);
+  BOOST_CHECK_EQUAL(std::string(copy.uiNames[0]), std::string("strategyATR"));
+  BOOST_CHECK_EQUAL(copy.uiValues[0], 0.0125);
+
+  pSymbol = getSymbolStatus("STATUSTEST");
+  BOOST_REQUIRE(pSymbol != NULL);
+  BOOST_CHECK(getSymbolStatus("STATUSTEST") == pSymbol);
+  beginStatusWrite(&pSymbol->sequence);
+  pSymbol->updateTime         = 1401062400;
+  pSymbol->predictedWeeklyATR = 0.02;
+  endStatusWrite(&pSymbol->sequence);
+  BOOST_REQUIRE(readSymbolStatus(pSymbol, &symbolCopy));
+  BOOST_CHECK_EQUAL(symbolCopy.predictedWeeklyATR, 0.02);
+
+  /* Symbol slots stay claimed for the life of the segment, so free the test one by hand. */
+  beginStatusWrite(&pSymbol->sequence);
+  pSymbol->updateTime = 0;
+  endStatusWrite(&pSymbol->sequence);
+  pSymbol->state = STATUS_SLOT_FREE;
+
+  race.pStatus   = pStatus;
+  race.writes    = 200000;
+  race.reads     = 0;
+  race.tornReads = 0;
+  race.isWriting = 1;
+  runParallelTasks(2, 2, seqlockRaceTask, &race);
+  BOOST_CHECK_EQUAL(race.tornReads, 0);
+  BOOST_REQUIRE(readInstanceStatus(pStatus, &copy));
+  BOOST_CHECK_EQUAL(copy.heartBeatTime, race.writes);
+
+  releaseInstanceStatus(instanceId);
+  releaseInstanceStatus(instanceId + 1);
+  BOOST_CHECK_EQUAL(pStatus->owner, 0);
+}
+
+namespace
+{
+  /* Every task adds to the same symbol slot, as savePredicatedWeeklyATR does from each instance. */
+  void symbolWriterTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    SymbolStatus* pSymbol = (SymbolStatus*)pContext;
+
+    for(int i = 0; i < 50000; i++)
+    {
+      beginStatusWrite(&pSymbol->sequence);
+      pSymbol->updateTime++;
+      pSymbol->predictedWeeklyATR += 1;
+      endStatusWrite(&pSymbol->sequence);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(statusSegment_concurrentWriters)
+{
+  SymbolStatus* pSymbol = getSymbolStatus("STATUSWRITERS");
+  SymbolStatus  copy;
+
+  BOOST_REQUIRE(pSymbol != NULL);
+  beginStatusWrite(&pSymbol->sequence);
+  pSymbol->updateTime         = 0;
+  pSymbol->predictedWeeklyATR = 0;
+  endStatusWrite(&pSymbol->sequence);
+
+  BOOST_REQUIRE_EQUAL(runParallelTasks(4, 4, symbolWriterTask, pSymbol), SUCCESS);
+
+  BOOST_CHECK_EQUAL(pSymbol->sequence & 1, 0);
+  BOOST_REQUIRE(readSymbolStatus(pSymbol, &copy));
+  BOOST_CHECK_EQUAL(copy.updateTime, 4 * 50000);
+  BOOST_CHECK_EQUAL(copy.predictedWeeklyATR, 4 * 50000.0);
+
+  pSymbol->state = STATUS_SLOT_FREE;
+}
+
+namespace
+{
+  BOOL parseCachedInt(const char* pText, void* pValue)
+  {
+    if(*pText == '\0')
+    {
+      return FALSE;
+    }
+    *(int*)pValue = atoi(pText);
+    return TRUE;
+  }
+
+  void writeTextFile(const char* pPath, const char* pText)
+  {
+    FILE* fp = fopen(pPath, "w");
+    fputs(pText, fp);
+    fclose(fp);
+  }
+
+  struct FileCacheRace
+  {
+    int reads;
+    int wrongReads[8];
+    int wrongOwnReads[8];
+  };
+
+  /* Every task reads a file shared by all instances and writes through its own file, as instances on one terminal do. */
+  void fileCacheRaceTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    FileCacheRace* pRace = (FileCacheRace*)pContext;
+    char path[64], text[32];
+    int  value;
+
+    sprintf(path, "fileCacheTest_%d.txt", taskIndex);
+    for(int i = 0; i < pRace->reads; i++)
+    {
+      if(!readFileCache("fileCacheTest_shared.txt", parseCachedInt, &value, sizeof(int)) || (value != 42))
+      {
+        pRace->wrongReads[taskIndex]++;
+      }
+
+      if(i % 100 == 0)
+      {
+        sprintf(text, "%d\n", i);
+        writeFileCache(path, text, parseCachedInt, sizeof(int));
+      }
+      if(!readFileCache(path, parseCachedInt, &value, sizeof(int)) || (value != i - i % 100))
+      {
+        pRace->wrongOwnReads[taskIndex]++;
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fileCache_parsesOnceAndSeesExternalEdits)
+{
+  FileCacheStats stats;
+  int value = -1, parses;
+
+  remove("fileCacheTest.txt");
+  resetFileCache();
+  setFileCacheCheckInterval(0);
+
+  /* A missing file keeps the caller's default until it is created. */
+  BOOST_CHECK(!readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, -1);
+  writeTextFile("fileCacheTest.txt", "7\n");
+  BOOST_REQUIRE(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, 7);
+
+  for(int i = 0; i < 100; i++)
+  {
+    value = 0;
+    BOOST_CHECK(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+    BOOST_CHECK_EQUAL(value, 7);
+  }
+  getFileCacheStats(&stats);
+  BOOST_CHECK_EQUAL(stats.lookups, 102);
+  BOOST_CHECK_EQUAL(stats.checks, 102);
+  BOOST_CHECK_EQUAL(stats.parses, 1);
+
+  /* An edit made by another program is picked up by the next check. */
+  writeTextFile("fileCacheTest.txt", "1234\n");
+  BOOST_CHECK(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, 1234);
+
+  /* Within the check interval the cached value is used without looking at the file. */
+  setFileCacheCheckInterval(60000);
+  writeTextFile("fileCacheTest.txt", "99\n");
+  BOOST_CHECK(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, 1234);
+  getFileCacheStats(&stats);
+  BOOST_CHECK_EQUAL(stats.checks, 103);
+  setFileCacheCheckInterval(0);
+  BOOST_CHECK(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, 99);
+
+  /* Writes go through the cache, so the written file isn't parsed back. */
+  getFileCacheStats(&stats);
+  parses = stats.parses;
+  BOOST_CHECK_EQUAL(writeFileCache("fileCacheTest.txt", "-5\n", parseCachedInt, sizeof(int)), SUCCESS);
+  BOOST_CHECK(readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+  BOOST_CHECK_EQUAL(value, -5);
+  getFileCacheStats(&stats);
+  BOOST_CHECK_EQUAL(stats.parses, parses);
+
+  remove("fileCacheTest.txt");
+  BOOST_CHECK(!readFileCache("fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+
+  BOOST_CHECK_EQUAL(writeFileCache("missingFolder/fileCacheTest.txt", "1\n", parseCachedInt, sizeof(int)), FILE_WRITING_ERROR);
+  BOOST_CHECK(!readFileCache("missingFolder/fileCacheTest.txt", parseCachedInt, &value, sizeof(int)));
+
+  setFileCacheCheckInterval(DEFAULT_FILE_CACHE_CHECK_MS);
+}
+
+BOOST_AUTO_TEST_CASE(fileCache_concurrentInstances)
+{
+  FileCacheRace  race;
+  FileCacheStats stats;
+  char path[64];
+
+  writeTextFile("fileCacheTest_shared.txt", "42\n");
+  resetFileCache();
+  memset(&race, 0, sizeof(race));
+  race.reads = 2000;
+
+  BOOST_REQUIRE_EQUAL(runParallelTasks(8, 4, fileCacheRaceTask, &race), SUCCESS);
+
+  getFileCacheStats(&stats);
+  BOOST_CHECK_EQUAL(stats.lookups, 8 * 2 * race.reads);
+  BOOST_CHECK_EQUAL(stats.writes, 8 * race.reads / 100);
+  BOOST_CHECK_EQUAL(stats.parses, 1);
+  for(int t = 0; t < 8; t++)
+  {
+    BOOST_CHECK_EQUAL(race.wrongReads[t], 0);
+    BOOST_CHECK_EQUAL(race.wrongOwnReads[t], 0);
+    sprintf(path, "fileCacheTest_%d.txt", t);
+    remove(path);
+  }
+
+  remove("fileCacheTest_shared.txt");
+}
+
+namespace
+{
+  struct PersistedState
+  {
+    int    version;
+    double values[512];
+  };
+
+  void fillPersistedState(PersistedState* pState, int version)
+  {
+    pState->version = version;
+    for(int i = 0; i < 512; i++)
+    {
+      pState->values[i] = version * 1000.0 + i;
+    }
+  }
+
+  /* Returns the version of a complete state file, -1 if it is missing, -2 if it is torn. */
+  int readPersistedState(const char* pPath)
+  {
+    PersistedState state;
+    FILE*          fp = fopen(pPath, "rb");
+    size_t         read;
+
+    if(fp == NULL)
+    {
+      return -1;
+    }
+    read = fread(&state, 1, sizeof(state), fp);
+    fclose(fp);
+
+    if(read != sizeof(state))
+    {
+      return -2;
+    }
+    for(int i = 0; i < 512; i++)
+    {
+      if(state.values[i] != state.version * 1000.0 + i)
+      {
+        return -2;
+      }
+    }
+    return state.version;
+  }
+
+  long getFileSize(const char* pPath)
+  {
+    FILE* fp = fopen(pPath, "rb");
+    long  size;
+
+    if(fp == NULL)
+    {
+      return -1;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fclose(fp);
+    return size;
+  }
+
+  BOOL killWriter(const char* pPath, size_t writtenBytes)
+  {
+    return FALSE;
+  }
+
+  /* Waits for the background writer without sleeping, so the test doesn't depend on the platform. */
+  BOOL waitForWriteBehind(int writes, int failures)
+  {
+    WriteBehindStats stats;
+    time_t           start = time(NULL);
+
+    do
+    {
+      getWriteBehindStats(&stats);
+      if((stats.writes >= writes) && (stats.failures >= failures))
+      {
+        return TRUE;
+      }
+    } while(time(NULL) - start < 10);
+
+    return FALSE;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(writeBehind_coalescesAndFlushes)
+{
+  const char*      pPath = "writeBehindTest.state";
+  PersistedState   state;
+  WriteBehindStats before, after;
+
+  remove(pPath);
+  getWriteBehindStats(&before);
+
+  fillPersistedState(&state, 1);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(77, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_REQUIRE(waitForWriteBehind(before.writes + 1, 0));
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 1);
+
+  /* Versions queued faster than the disk takes them are skipped, the latest one always ends up on disk. */
+  for(int version = 2; version <= 1000; version++)
+  {
+    fillPersistedState(&state, version);
+    BOOST_REQUIRE_EQUAL(queueWriteBehind(77, pPath, &state, sizeof(state)), SUCCESS);
+  }
+  BOOST_CHECK_EQUAL(flushWriteBehind(77), SUCCESS);
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 1000);
+
+  getWriteBehindStats(&after);
+  BOOST_CHECK_EQUAL(after.queued - before.queued, 1000);
+  BOOST_CHECK_EQUAL(after.writes - before.writes + after.coalesced - before.coalesced, 1000);
+  BOOST_CHECK(after.writes - before.writes < 1000);
+  BOOST_CHECK_EQUAL(after.failures, before.failures);
+  BOOST_CHECK_EQUAL(getFileSize("writeBehindTest.state.tmp"), -1);
+
+  /* Flushing a key with nothing queued does nothing. */
+  BOOST_CHECK_EQUAL(flushWriteBehind(77), SUCCESS);
+
+  stopWriteBehind();
+  remove(pPath);
+}
+
+BOOST_AUTO_TEST_CASE(writeBehind_survivesWriterKilledMidWrite)
+{
+  const char*      pPath = "writeBehindTest.state";
+  PersistedState   state;
+  WriteBehindStats before;
+
+  remove(pPath);
+  fillPersistedState(&state, 1);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(78, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_REQUIRE_EQUAL(flushWriteBehind(78), SUCCESS);
+  BOOST_REQUIRE_EQUAL(readPersistedState(pPath), 1);
+
+  /* The background writer dies half way through the temporary file. */
+  getWriteBehindStats(&before);
+  setWriteBehindFault(killWriter);
+  fillPersistedState(&state, 2);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(78, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_REQUIRE(waitForWriteBehind(0, before.failures + 1));
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 1);
+  BOOST_CHECK_EQUAL(getFileSize("writeBehindTest.state.tmp"), (long)sizeof(state) / 2);
+
+  /* So does an explicit flush. */
+  BOOST_CHECK_EQUAL(flushWriteBehind(78), FILE_WRITING_ERROR);
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 1);
+
+  /* The next write replaces the leftover temporary file and the state. */
+  setWriteBehindFault(NULL);
+  fillPersistedState(&state, 3);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(78, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_CHECK_EQUAL(flushWriteBehind(78), SUCCESS);
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 3);
+  BOOST_CHECK_EQUAL(getFileSize("writeBehindTest.state.tmp"), -1);
+
+  BOOST_CHECK_EQUAL(writeFileAtomically("missingFolder/writeBehindTest.state", &state, sizeof(state)), FILE_WRITING_ERROR);
+
+  stopWriteBehind();
+  remove(pPath);
+}
+
+BOOST_AUTO_TEST_CASE(writeBehind_keepsContentOfFailedFlush)
+{
+  const char*    pPath = "writeBehindTest.state";
+  PersistedState state;
+
+  remove(pPath);
+  fillPersistedState(&state, 1);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(79, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_REQUIRE_EQUAL(flushWriteBehind(79), SUCCESS);
+
+  setWriteBehindFault(killWriter);
+  fillPersistedState(&state, 2);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(79, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_CHECK_EQUAL(flushWriteBehind(79), FILE_WRITING_ERROR);
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 1);
+
+  /* Nothing new is queued, the next flush writes the content that failed. */
+  setWriteBehindFault(NULL);
+  BOOST_CHECK_EQUAL(flushWriteBehind(79), SUCCESS);
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 2);
+  BOOST_CHECK_EQUAL(getFileSize("writeBehindTest.state.tmp"), -1);
+
+  /* So does stopping the writer. */
+  setWriteBehindFault(killWriter);
+  fillPersistedState(&state, 3);
+  BOOST_REQUIRE_EQUAL(queueWriteBehind(79, pPath, &state, sizeof(state)), SUCCESS);
+  BOOST_CHECK_EQUAL(flushWriteBehind(79), FILE_WRITING_ERROR);
+  setWriteBehindFault(NULL);
+  stopWriteBehind();
+  BOOST_CHECK_EQUAL(readPersistedState(pPath), 3);
+
+  BOOST_CHECK_EQUAL(flushWriteBehind(79), SUCCESS);
+  remove(pPath);
+}
+
+namespace
+{
+  struct AsyncLogCapture
+  {
+    FILE*             pFile;      /* Messages are written here if set, like the pantheios file back end */
+    int               messages;
+    std::vector<int>  nextSequence; /* Per producer, to check ordering */
+    int               wrongOrder;
+  };
+
+  AsyncLogCapture gAsyncLogCapture;
+  int             gEvaluatedArguments = 0;
+
+  void captureAsyncLog(int severity, const char* pMessage)
+  {
+    int producer, sequence;
+
+    gAsyncLogCapture.messages++;
+    if(gAsyncLogCapture.pFile != NULL)
+    {
+      fprintf(gAsyncLogCapture.pFile, "%d %s\n", severity, pMessage);
+    }
+    if(sscanf(pMessage, "producer %d message %d", &producer, &sequence) == 2)
+    {
+      if(gAsyncLogCapture.nextSequence[producer] != sequence)
+      {
+        gAsyncLogCapture.wrongOrder++;
+      }
+      gAsyncLogCapture.nextSequence[producer] = sequence + 1;
+    }
+  }
+
+  void resetAsyncLogCapture(FILE* pFile, int totalProducers)
+  {
+    gAsyncLogCapture.pFile      = pFile;
+    gAsyncLogCapture.messages   = 0;
+    gAsyncLogCapture.wrongOrder = 0;
+    gAsyncLogCapture.nextSequence.assign(totalProducers, 0);
+  }
+
+  int evaluateArgument(int value)
+  {
+    gEvaluatedArguments++;
+    return value;
+  }
+
+  /* A tick of a strategy that logs its indicators at DEBUG, with the bar time formatted for the log. */
+  double runLoggedTicks(int totalTicks)
+  {
+    const time_t start = 1262304000; /* 01/01/2010 */
+    double       sum = 0;
+    clock_t      begin = clock();
+
+    for(int tick = 0; tick < totalTicks; tick++)
+    {
+      time_t time = start + (time_t)tick * 60;
+      double high = 1.3 + sin(tick * 0.01) * 0.01, low = high - 0.002;
+      char   timeString[MAX_TIME_STRING_SIZE];
+
+      sum += high - low;
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, dailyHigh=%lf, dailyLow = %lf", 1, safe_timeString(timeString, time), high, low);
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, dailyTrend=%ld, dailyTP=%lf", 1, safe_timeString(timeString, time), (long)(tick % 3), high + 0.01);
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() close[%d] = %f,ratesIndex=%d", tick % 500, low, 0);
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "PNL = %lf, Equity = %lf", sum, 10000.0 + sum);
+    }
+
+    BOOST_CHECK(sum > 0);
+    return totalTicks / ((double)(clock() - begin) / CLOCKS_PER_SEC + 1e-9);
+  }
+
+  void asyncLogProducerTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    for(int i = 0; i < 1000; i++)
+    {
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "producer %d message %d", taskIndex, i);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(asyncLog_gatesArgumentsAndBenchmarksTicks)
+{
+  const int     totalTicks = 50000;
+  AsyncLogStats before, after;
+  double        warningRate, asyncRate, syncRate;
+
+  resetAsyncLogCapture(fopen("asyncLogTest.log", "w"), 0);
+  BOOST_REQUIRE(gAsyncLogCapture.pFile != NULL);
+  setAsyncLogSink(captureAsyncLog);
+
+  /* Disabled severities don't evaluate their arguments. */
+  setAsyncLogSeverity(PANTHEIOS_SEV_WARNING);
+  ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "%d", evaluateArgument(1));
+  BOOST_CHECK_EQUAL(gEvaluatedArguments, 0);
+  ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_ERROR, "%d", evaluateArgument(1));
+  BOOST_CHECK_EQUAL(gEvaluatedArguments, 1);
+  BOOST_CHECK_EQUAL(gAsyncLogCapture.messages, 1);
+
+  gAsyncLogCapture.messages = 0;
+  warningRate = runLoggedTicks(totalTicks);
+  BOOST_CHECK_EQUAL(gAsyncLogCapture.messages, 0);
+
+  /* Written by the ticking thread, like pantheios_logprintf. */
+  setAsyncLogSeverity(PANTHEIOS_SEV_DEBUG);
+  syncRate = runLoggedTicks(totalTicks);
+  BOOST_CHECK_EQUAL(gAsyncLogCapture.messages, 4 * totalTicks);
+
+  gAsyncLogCapture.messages = 0;
+  getAsyncLogStats(&before);
+  BOOST_REQUIRE(startAsyncLog());
+  asyncRate = runLoggedTicks(totalTicks);
+  stopAsyncLog();
+  getAsyncLogStats(&after);
+
+  /* Messages that didn't fit while the writer was busy are counted, everything else is written. */
+  BOOST_CHECK_EQUAL(after.queued - before.queued, after.written - before.written);
+  BOOST_CHECK_EQUAL((after.written - before.written) + (after.dropped - before.dropped), 4 * totalTicks);
+  BOOST_CHECK_EQUAL(after.overflow - before.overflow, 0);
+  BOOST_CHECK(gAsyncLogCapture.messages >= after.written - before.written);
+
+  BOOST_TEST_MESSAGE("ticks/s with 4 DEBUG messages per tick: " << warningRate << " at WARNING, " << syncRate << " at DEBUG written synchronously, "
+    << asyncRate << " at DEBUG queued (" << after.dropped - before.dropped << " dropped)");
+
+  setAsyncLogSink(NULL);
+  fclose(gAsyncLogCapture.pFile);
+  remove("asyncLogTest.log");
+}
+
+BOOST_AUTO_TEST_CASE(asyncLog_concurrentProducers)
+{
+  AsyncLogStats before, after;
+
+  resetAsyncLogCapture(NULL, 4);
+  setAsyncLogSink(captureAsyncLog);
+  setAsyncLogSeverity(PANTHEIOS_SEV_DEBUG);
+  getAsyncLogStats(&before);
+  BOOST_REQUIRE(startAsyncLog());
+
+  /* 4000 messages fit in the ring even if the writer doesn't drain any of them meanwhile. */
+  BOOST_REQUIRE_EQUAL(runParallelTasks(4, 4, asyncLogProducerTask, NULL), SUCCESS);
+  flushAsyncLog();
+  getAsyncLogStats(&after);
+
+  BOOST_CHECK_EQUAL(after.dropped - before.dropped, 0);
+  BOOST_CHECK_EQUAL(after.queued - before.queued, 4000);
+  BOOST_CHECK_EQUAL(gAsyncLogCapture.messages, 4000);
+  BOOST_CHECK_EQUAL(gAsyncLogCapture.wrongOrder, 0);
+  for(int producer = 0; producer < 4; producer++)
+  {
+    BOOST_CHECK_EQUAL(gAsyncLogCapture.nextSequence[producer], 1000);
+  }
+
+  stopAsyncLog();
+  setAsyncLogSink(NULL);
+}
+
+
+BOOST_AUTO_TEST_CASE(equityCurve_downsamplingKeepsEndsAndExtremes)
+{
+  EquityCurve curve;
+  int n;
+
+  BOOST_REQUIRE_EQUAL(allocEquityCurve(&curve, 1000, 50, EQUITY_CURVE_MIN_MAX), SUCCESS);
+
+  /* A slow sine with one deep drawdown and one spike. */
+  for(n = 0; n < 1000; n++)
+  {
+    double equity = 10000 + 100 * sin(n / 50.0);
+    if(n == 333) equity = 5000;
+    if(n == 777) equity = 15000;
+    BOOST_REQUIRE(addEquityCurvePoint(&curve, 1000000 + n * 3600, 10000, equity, 0.5 * n));
+  }
+  BOOST_CHECK(!addEquityCurvePoint(&curve, 1000000 + 1000 * 3600, 10000, 10000, 0));
+  BOOST_CHECK_EQUAL(curve.totalPoints, 1000);
+  BOOST_CHECK_EQUAL(curve.overflowPoints, 1);
+
+  downsampleEquityCurve(&curve);
+  BOOST_REQUIRE(curve.totalPoints <= 50);
+  BOOST_CHECK(curve.totalPoints >= 40);
+  BOOST_CHECK_EQUAL(curve.time[0], 1000000);
+  BOOST_CHECK_EQUAL(curve.time[curve.totalPoints - 1], 1000000 + 999 * 3600);
+  BOOST_CHECK(std::find(curve.equity, curve.equity + curve.totalPoints, 5000.0) != curve.equity + curve.totalPoints);
+  BOOST_CHECK(std::find(curve.equity, curve.equity + curve.totalPoints, 15000.0) != curve.equity + curve.totalPoints);
+  for(n = 1; n < curve.totalPoints; n++)
+  {
+    BOOST_CHECK(curve.time[n] > curve.time[n - 1]);
+    BOOST_CHECK_CLOSE(curve.margin[n], 0.5 * (curve.time[n] - 1000000) / 3600, 1e-9);
+  }
+
+  /* LTTB keeps the spikes too since they form the largest triangles. */
+  clearEquityCurve(&curve);
+  curve.downsampling = EQUITY_CURVE_LTTB;
+  for(n = 0; n < 1000; n++)
+  {
+    addEquityCurvePoint(&curve, 1000000 + n * 3600, 10000, n == 333 ? 5000 : 10000 + n, 0);
+  }
+  downsampleEquityCurve(&curve);
+  BOOST_CHECK_EQUAL(curve.totalPoints, 50);
+  BOOST_CHECK_EQUAL(curve.time[0], 1000000);
+  BOOST_CHECK_EQUAL(curve.time[49], 1000000 + 999 * 3600);
+  BOOST_CHECK(std::find(curve.equity, curve.equity + curve.totalPoints, 5000.0) != curve.equity + curve.totalPoints);
+
+  freeEquityCurve(&curve);
+  BOOST_CHECK_EQUAL(allocEquityCurve(&curve, 0, 0, EQUITY_CURVE_KEEP_ALL), INVALID_PARAMETER);
+}
+
+BOOST_AUTO_TEST_CASE(equityCurve_fileRoundTrip)
+{
+  EquityCurve curve, loaded;
+  FILE* pFile;
+  int n;
+
+  BOOST_REQUIRE_EQUAL(allocEquityCurve(&curve, 100, 0, EQUITY_CURVE_KEEP_ALL), SUCCESS);
+  for(n = 0; n < 100; n++)
+  {
+    addEquityCurvePoint(&curve, 1000000 + n * 60, 10000 + n, 9990 + n * 1.5, n * 0.25);
+  }
+  downsampleEquityCurve(&curve);
+  BOOST_REQUIRE_EQUAL(curve.totalPoints, 100);
+
+  BOOST_REQUIRE_EQUAL(writeEquityCurve(&curve, "equityCurveTest.bin"), SUCCESS);
+  BOOST_REQUIRE_EQUAL(readEquityCurve(&loaded, "equityCurveTest.bin"), SUCCESS);
+  BOOST_REQUIRE_EQUAL(loaded.totalPoints, 100);
+  for(n = 0; n < 100; n++)
+  {
+    BOOST_CHECK_EQUAL(loaded.time[n], curve.time[n]);
+    BOOST_CHECK_EQUAL(loaded.balance[n], curve.balance[n]);
+    BOOST_CHECK_EQUAL(loaded.equity[n], curve.equity[n]);
+    BOOST_CHECK_EQUAL(loaded.margin[n], curve.margin[n]);
+  }
+  freeEquityCurve(&loaded);
+
+  pFile = fopen("equityCurveTest.bin", "wb");
+  fputs("not a curve", pFile);
+  fclose(pFile);
+  BOOST_CHECK_EQUAL(readEquityCurve(&loaded, "equityCurveTest.bin"), FILE_READING_ERROR);
+  BOOST_CHECK_EQUAL(readEquityCurve(&loaded, "equityCurveTestMissing.bin"), FILE_READING_ERROR);
+
+  freeEquityCurve(&curve);
+  remove("equityCurveTest.bin");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -43,6 +43,11 @@
 
 #include "AsirikuyDefines.h"
 #include "StrategyUserInterface.h"
+#include "OrderHistoryIndex.h"
+#include "OpenPositions.h"
+#include "DerivedRates.h"
+#include "TickJournal.h"
+#include "SessionBars.h"
 
 class EasyTrade
 {
@@ -253,6 +258,22 @@ double iAtrDailyByHourInterval(int period, int firstHour, int lastHour);
   * 
   */
  double iAtrSafeShiftZero(int period);
+
+  /**
+  * Returns the current day or week aggregated from the closed bars of the primary rates.
+  * The aggregates are kept per instance and only the bars closed since the previous run are added.
+  *
+  * @param SessionType type
+  *   SESSION_DAY or SESSION_WEEK.
+  *
+  * @param SessionBar* pOutBar
+  *   Receives the open, high, low, close, volume and start index of the session.
+  *
+  * @return AsirikuyReturnCode
+  * 
+  */
+  AsirikuyReturnCode getCurrentSessionBar(SessionType type, SessionBar* pOutBar);
+
   /**
   * Adds a value to the trading platforms UI.
   *
@@ -820,6 +841,88 @@ AsirikuyReturnCode openSingleSellLimitEasy(double entryPrice, double takeProfit,
 
   double iBBandStop(int ratesArrayIndex, int bb_period, double bb_deviation, int * signal, double * stopPrice, int *index);
 
+  /**
+  * Computes the last count values of iMA in one pass, newest first, so that backward scans do not
+  * recompute the average at every shift. Like iMA, each value is the SMA of the period bars ending at its shift.
+  *
+  * @param int type
+  *   selects the array to be used for the MA calculation (open=0, high=1, low=2, close=3, volume=4).
+  *
+  * @param int ratesArrayIndex
+  *   index of the rates array to use, selecting the timeframe.
+  *
+  * @param int period
+  *   period to be used
+  *
+  * @param int startShift
+  *   shift of the newest value, written to pOutValues[0]
+  *
+  * @param int count
+  *   number of shifts to compute, pOutValues[i] holds shift startShift + i. Shifts without enough data are set to 0.
+  *
+  * @param double* pOutValues
+  *   caller owned buffer of at least count values
+  *
+  * @return AsirikuyReturnCode
+  * 
+  */
+  AsirikuyReturnCode iMASeries(int type, int ratesArrayIndex, int period, int startShift, int count, double* pOutValues);
+
+  /**
+  * Computes the last count MACD values newest first. Each shift is calculated exactly as iMACD calculates it.
+  *
+  * @param int startShift
+  *   shift of the newest value, written to index 0 of each buffer
+  *
+  * @param int count
+  *   number of shifts to compute. Shifts without enough data are set to 0.
+  *
+  * @param double* pMacd, pMacdSignal, pMacdHist
+  *   caller owned buffers of at least count values
+  *
+  * @return AsirikuyReturnCode
+  * 
+  */
+  AsirikuyReturnCode iMACDSeries(int ratesArrayIndex, int fastPeriod, int slowPeriod, int signalPeriod, int startShift, int count, double* pMacd, double* pMacdSignal, double* pMacdHist);
+
+  /**
+  * Computes the last count Bollinger Bands in one TA-lib call, newest first.
+  *
+  * @param int type
+  *   selects the array the bands are calculated on (open=0, high=1, low=2, close=3, volume=4). iBBands uses open.
+  *
+  * @param int startShift
+  *   shift of the newest value, written to index 0 of each buffer
+  *
+  * @param int count
+  *   number of shifts to compute. Shifts without enough data are set to 0.
+  *
+  * @param double* pUpperBand, pMiddleBand, pLowerBand
+  *   caller owned buffers of at least count values
+  *
+  * @return AsirikuyReturnCode
+  * 
+  */
+  AsirikuyReturnCode iBBandsSeries(int type, int ratesArrayIndex, int bb_period, double bb_deviation, int startShift, int count, double* pUpperBand, double* pMiddleBand, double* pLowerBand);
+
+  /**
+  * Computes the last count values of iAtr in one pass, newest first. Like iAtr, each value is the average
+  * true range of the period bars ending at its shift.
+  *
+  * @param int startShift
+  *   shift of the newest value, written to pOutValues[0]
+  *
+  * @param int count
+  *   number of shifts to compute. Shifts without enough data are set to 0.
+  *
+  * @param double* pOutValues
+  *   caller owned buffer of at least count values
+  *
+  * @return AsirikuyReturnCode
+  * 
+  */
+  AsirikuyReturnCode iAtrSeries(int ratesArrayIndex, int period, int startShift, int count, double* pOutValues);
+
   /**
   * This is a wrapper for the TA-lib standard deviation indicator that simplifies its use
   * making it similar to the MQL4 function. It returns the standard deviation of prices of chosen type.
@@ -1126,6 +1229,18 @@ private:
   StrategyParams*  pParams;
   char*  userInterfaceVariableNames[TOTAL_UI_VALUES];
   double userInterfaceValues[TOTAL_UI_VALUES];
+  OrderHistoryIndex* pOrderHistoryIndex;
+  BOOL   isOrderHistoryIndexed;
+  OpenPositions openPositions;
+  BOOL   isOpenPositionsAggregated;
+
+  const OrderHistoryIndex* getOrderHistoryIndex();
+  const OpenPositions* getOpenPositions();
+  const SessionTracker* getInstanceSessions();
+  AsirikuyReturnCode getTickJournal(TickJournal** ppJournal);
+  AsirikuyReturnCode addNewDerivedRates(int originalRatesIndex, int ratesIndex, DerivedRatesType type, double barSize);
+  const double* getSeriesPrices(int type, int ratesArrayIndex);
+  AsirikuyReturnCode getSeriesRange(int ratesArrayIndex, int startShift, int count, int* pStartIndex, int* pEndIndex);
 
 };
 
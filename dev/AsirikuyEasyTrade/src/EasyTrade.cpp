@@ -44,6 +44,7 @@
 #include <ta_libc.h>
 
 #include "AsirikuyTime.h"
+#include "Calendar.h"
 #include "EasyTrade.hpp"
 #include "AsirikuyStrategies.h"
 #include "StrategyUserInterface.h"
@@ -56,6 +57,7 @@
 #include "curl/curl.h"
 #include "TimeZoneOffsets.h"
 #include "Broker-tz.h"
+#include "AsyncLog.h"
 
 #define STOPS_REFERENCE_POINTS      5000
 #define INDICATOR_CALCULATION_ERROR -1
@@ -105,12 +107,48 @@ AsirikuyReturnCode freeTickData(tickData loadedData)
 
 EasyTrade::EasyTrade()
 {
-
+  pOrderHistoryIndex = NULL;
+  isOrderHistoryIndexed = FALSE;
+  isOpenPositionsAggregated = FALSE;
 }
 
 EasyTrade::~EasyTrade()
 {
+  if (isOpenPositionsAggregated)
+    freeOpenPositions(&openPositions);
+}
+
+const OrderHistoryIndex* EasyTrade::getOrderHistoryIndex()
+{
+  // The index of the instance persists between calls. The first query of a call adds the orders opened or closed since the last one.
+  if (!isOrderHistoryIndexed)
+  {
+    pOrderHistoryIndex = getInstanceOrderHistoryIndex((int)pParams->settings[STRATEGY_INSTANCE_ID], TRUE);
+    if (pOrderHistoryIndex == NULL || updateOrderHistoryIndex(pOrderHistoryIndex, pParams->orderInfo, (int)pParams->settings[ORDERINFO_ARRAY_SIZE]) != SUCCESS)
+    {
+      pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getOrderHistoryIndex() failed to index the order history.");
+      return NULL;
+    }
+    isOrderHistoryIndexed = TRUE;
+  }
+
+  return pOrderHistoryIndex;
+}
+
+const OpenPositions* EasyTrade::getOpenPositions()
+{
+  // Like the order history index, the open orders are aggregated once per call. Only the prices change afterwards.
+  if (!isOpenPositionsAggregated)
+  {
+    if (initOpenPositions(&openPositions, pParams->orderInfo, (int)pParams->settings[ORDERINFO_ARRAY_SIZE]) != SUCCESS)
+    {
+      pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getOpenPositions() failed to aggregate the open orders.");
+      return NULL;
+    }
+    isOpenPositionsAggregated = TRUE;
+  }
 
+  return &openPositions;
 }
 
 StrategyParams* EasyTrade::getParams()
@@ -205,134 +243,110 @@ AsirikuyReturnCode EasyTrade::addDistortedArray(int sourceRateIndex, int ratesIn
 
 AsirikuyReturnCode EasyTrade::freeRates(int ratesIndex)
 {
-   free(pParams->ratesBuffers->rates[ratesIndex].time);
-   free(pParams->ratesBuffers->rates[ratesIndex].open);
-   free(pParams->ratesBuffers->rates[ratesIndex].high);
-   free(pParams->ratesBuffers->rates[ratesIndex].low);
-   free(pParams->ratesBuffers->rates[ratesIndex].close);
-   free(pParams->ratesBuffers->rates[ratesIndex].volume);
+   DerivedRatesBuilder* pBuilder = getDerivedRatesBuilder((int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, FALSE);
+
+   if (pBuilder != NULL && pBuilder->rates.time == pParams->ratesBuffers->rates[ratesIndex].time)
+   {
+      releaseDerivedRatesBuilder(pBuilder);
+   }
+   else
+   {
+      free(pParams->ratesBuffers->rates[ratesIndex].time);
+      free(pParams->ratesBuffers->rates[ratesIndex].open);
+      free(pParams->ratesBuffers->rates[ratesIndex].high);
+      free(pParams->ratesBuffers->rates[ratesIndex].low);
+      free(pParams->ratesBuffers->rates[ratesIndex].close);
+      free(pParams->ratesBuffers->rates[ratesIndex].volume);
+   }
+
+   pParams->ratesBuffers->rates[ratesIndex].info.arraySize = 0;
+   pParams->ratesBuffers->rates[ratesIndex].time   = NULL;
+   pParams->ratesBuffers->rates[ratesIndex].open   = NULL;
+   pParams->ratesBuffers->rates[ratesIndex].high   = NULL;
+   pParams->ratesBuffers->rates[ratesIndex].low    = NULL;
+   pParams->ratesBuffers->rates[ratesIndex].close  = NULL;
+   pParams->ratesBuffers->rates[ratesIndex].volume = NULL;
 
    return SUCCESS;
 }
 
 AsirikuyReturnCode EasyTrade::saveTickData()
 {
-   char buffer[MAX_FILE_PATH_CHARS] = "";
-   char tempPath[MAX_FILE_PATH_CHARS] = "";
-   FILE *fp;
-   tickData currentTickData;
-   int lastTickTime=0;
-   int i=0;
-
-   currentTickData = addTickArray();
+   AsirikuyReturnCode returnCode;
+   TickJournal* pJournal;
+   int count, lastTickTime = 0;
 
-   requestTempFileFolderPath(tempPath);
-   sprintf(buffer, "%s%d_%s.csv", tempPath, (int)pParams->settings[STRATEGY_INSTANCE_ID], pParams->tradeSymbol);
+   returnCode = getTickJournal(&pJournal);
+   if(returnCode != SUCCESS){
+	   pantheios_logputs(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"Could not write tick data file.");
+	   return returnCode;
+   }
 
-   if (currentTickData.arraySize > 0){
-	   lastTickTime = (int)currentTickData.time[currentTickData.arraySize-1];
+   count = getTickJournalCount(pJournal);
+   if (count > 0){
+	   lastTickTime = getTickJournalRecord(pJournal, count-1)->time;
 
-	   // if the tick array contains future data, start from scratch 
+	   // if the journal contains future data, start from scratch 
 	   // this may happen if we start a back-test with a previously created file
 	   if(lastTickTime >= (int)pParams->currentBrokerTime){
-
-			fp = fopen(buffer,"w");
-			if(fp == NULL){
-				pantheios_logputs(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"Could not write tick data file.");
-				freeTickData(currentTickData);
-				return FILE_WRITING_ERROR;
-			}
-
-			fprintf(fp,"");
-			fclose(fp);
-		}
-   }
-
-   // if we pass the storage limit then rewrite file starting from second item
-   if(currentTickData.arraySize >= TICK_DATA_STORAGE_LIMIT){
-
-	   fp = fopen(buffer,"w");
-	   if(fp == NULL){
-			pantheios_logputs(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"Could not write tick data file.");
-			freeTickData(currentTickData);
-			return FILE_WRITING_ERROR;
-	   }
-
-	   for(i=1;i<currentTickData.arraySize;i++){
-			fprintf(fp,"%d,%lf,%lf\n",currentTickData.time[i], currentTickData.bid[i], currentTickData.ask[i]);
+			resetTickJournal(pJournal);
+			return SUCCESS;
 	   }
-
-	   fclose(fp);
    }
 
-  fp = fopen(buffer,"a");
-  if(fp == NULL){
-    pantheios_logputs(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"Could not write tick data file.");
-	freeTickData(currentTickData);
-    return FILE_WRITING_ERROR;
-  }
-
-  fseek(fp,0, SEEK_END);
+   // once the storage limit is reached the oldest tick is overwritten
+   if((int)pParams->currentBrokerTime > lastTickTime){
+	   appendTickJournal(pJournal, (int)pParams->currentBrokerTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0]);
+   }
 
-  if((int)pParams->currentBrokerTime > lastTickTime){
-	fprintf(fp,"%d,%lf,%lf\n",(int)pParams->currentBrokerTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0]);
-  }
+   return SUCCESS;
+}
 
-  fclose(fp);
+AsirikuyReturnCode EasyTrade::getTickJournal(TickJournal** ppJournal)
+{
+   char journalPath[MAX_FILE_PATH_CHARS] = "";
+   char csvPath[MAX_FILE_PATH_CHARS] = "";
+   char tempPath[MAX_FILE_PATH_CHARS] = "";
 
-  freeTickData(currentTickData);
+   requestTempFileFolderPath(tempPath);
+   sprintf(journalPath, "%s%d_%s.ticks", tempPath, (int)pParams->settings[STRATEGY_INSTANCE_ID], pParams->tradeSymbol);
+   // the CSV file written by earlier versions is imported once when the journal is created
+   sprintf(csvPath, "%s%d_%s.csv", tempPath, (int)pParams->settings[STRATEGY_INSTANCE_ID], pParams->tradeSymbol);
 
-  return SUCCESS;
+   return getInstanceTickJournal((int)pParams->settings[STRATEGY_INSTANCE_ID], journalPath, csvPath, ppJournal);
 }
 
 tickData EasyTrade::addTickArray()
 {
-  char buffer[MAX_FILE_PATH_CHARS] = "";
-  char tempPath[MAX_FILE_PATH_CHARS] = "";
-  char data[200] = "";
-  int arraySize;
   tickData loadedTickData;
+  TickJournal* pJournal;
+  const TickRecord* pRecord;
   int i;
-  char *ptr;
-  FILE *fp;
-  char *strtokSave;
-
 
-  requestTempFileFolderPath(tempPath);
-  sprintf(buffer, "%s%d_%s.csv", tempPath,  (int)pParams->settings[STRATEGY_INSTANCE_ID], pParams->tradeSymbol);
   loadedTickData.arraySize = 0;
+  loadedTickData.time = NULL;
+  loadedTickData.bid  = NULL;
+  loadedTickData.ask  = NULL;
 
-  arraySize = countLinesInCSV(buffer);
-
-  loadedTickData.arraySize = arraySize;
-  loadedTickData.time  =  (int*)malloc(arraySize * sizeof(int));
-  loadedTickData.bid   =  (double*)malloc(arraySize * sizeof(double));
-  loadedTickData.ask   =  (double*)malloc(arraySize * sizeof(double));
-
-  i = 0;
-
-  fp = fopen(buffer,"r");
-  if(fp == NULL){
+  if(getTickJournal(&pJournal) != SUCCESS){
     pantheios_logputs(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"No tick data present yet.");
     return loadedTickData;
   }
 
-    while ( fgets(data, 200, fp ) != NULL) {
-	
-        ptr = strtok_r(data, ",", &strtokSave);
-		sscanf(ptr,"%d",&loadedTickData.time[i]);
-		ptr = strtok_r(NULL, ",", &strtokSave);
-		sscanf(ptr,"%lf",&loadedTickData.bid[i]);
-		ptr = strtok_r(NULL, ",", &strtokSave);
-		sscanf(ptr,"%lf",&loadedTickData.ask[i]);
-		i++;
-    }
-
-
-    fclose(fp);
-
-	return loadedTickData;
+  // callers own the arrays and release them with freeTickData()
+  loadedTickData.arraySize = getTickJournalCount(pJournal);
+  loadedTickData.time  =  (int*)malloc(loadedTickData.arraySize * sizeof(int));
+  loadedTickData.bid   =  (double*)malloc(loadedTickData.arraySize * sizeof(double));
+  loadedTickData.ask   =  (double*)malloc(loadedTickData.arraySize * sizeof(double));
+
+  for(i = 0; i < loadedTickData.arraySize; i++){
+	pRecord = getTickJournalRecord(pJournal, i);
+	loadedTickData.time[i] = pRecord->time;
+	loadedTickData.bid[i]  = pRecord->bid;
+	loadedTickData.ask[i]  = pRecord->ask;
+  }
 
+  return loadedTickData;
 }
 
 AsirikuyReturnCode EasyTrade::addNewDailyRates(char* ratesName, time_t intFromDate, int ratesIndex)
@@ -387,7 +401,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRates(char* ratesName, time_t intFromDa
 
 	strcat(url, "&ignore=.csv");
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*) "URL To parse for rate addition of symbol %s: %s", ratesName, url);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "URL To parse for rate addition of symbol %s: %s", ratesName, url);
 
 	curl_global_init(CURL_GLOBAL_ALL);
     curl = curl_easy_init();
@@ -462,7 +476,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRates(char* ratesName, time_t intFromDa
 		pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i] = mktime(&lDate);
 		strftime(date, 20, "%d/%m/%Y %H:%M:%S", localtime(&pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i]));
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
 
 		}
 
@@ -532,7 +546,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRatesQuandl(char* token, char* dataset,
 	sprintf(str,"%d-%d-%d",finalDate.tm_mday, finalDate.tm_mon+1, finalDate.tm_year+1900);
 	strcat(url, str);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*) "URL To parse for rate addition of symbol %s: %s", ratesName, url);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "URL To parse for rate addition of symbol %s: %s", ratesName, url);
 
 	curl_global_init(CURL_GLOBAL_ALL);
     curl = curl_easy_init();
@@ -608,7 +622,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRatesQuandl(char* token, char* dataset,
 		pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i] = mktime(&lDate);
 		strftime(date, 20, "%d/%m/%Y %H:%M:%S", localtime(&pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i]));
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
 
 		}
 
@@ -679,7 +693,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRatesQuandlOpenOnly(char* token, char*
 	sprintf(str,"%d-%d-%d",finalDate.tm_mday, finalDate.tm_mon+1, finalDate.tm_year+1900);
 	strcat(url, str);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*) "URL To parse for rate addition of symbol %s: %s", ratesName, url);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "URL To parse for rate addition of symbol %s: %s", ratesName, url);
 
 	curl_global_init(CURL_GLOBAL_ALL);
     curl = curl_easy_init();
@@ -744,7 +758,7 @@ AsirikuyReturnCode EasyTrade::addNewDailyRatesQuandlOpenOnly(char* token, char*
 		pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i] = mktime(&lDate);
 		strftime(date, 20, "%d/%m/%Y %H:%M:%S", localtime(&pParams->ratesBuffers->rates[ratesIndex].time[arraySize-i]));
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Rate item addition -> %s, %lf, %lf, %lf, %lf", date, pParams->ratesBuffers->rates[ratesIndex].open[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].high[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].low[arraySize-i], pParams->ratesBuffers->rates[ratesIndex].close[arraySize-i]);
 
 		}
 
@@ -777,191 +791,30 @@ AsirikuyReturnCode EasyTrade::addNewDailyRatesQuandlOpenOnly(char* token, char*
 
 AsirikuyReturnCode EasyTrade::addNewRenkoRates(int originalRatesIndex, int ratesIndex, double renkoSize)
 {
-
-	int arraySize, i, newCandle;
-	double cumulativeUp, cumulativeDown, cumulativeVolume;
-	double currentOpen, lowest, highest;
-	time_t currentTime;
-
-    arraySize = pParams->ratesBuffers->rates[originalRatesIndex].info.arraySize;
-
-	pParams->ratesBuffers->rates[ratesIndex].info.arraySize = 0 ;
-
-	cumulativeUp = 0;
-	cumulativeDown = 0;
-	newCandle = TRUE;
-	cumulativeVolume = 0;
-
-	for(i=0;i<arraySize;i++)
-	{
-
-		if (newCandle == TRUE)
-		{
-			if (pParams->ratesBuffers->rates[ratesIndex].info.arraySize == 0) 
-			currentOpen = pParams->ratesBuffers->rates[originalRatesIndex].open[i] ; else
-			currentOpen = pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] ;
-
-			currentTime  = pParams->ratesBuffers->rates[originalRatesIndex].time[i];
-			lowest = currentOpen;
-			highest = currentOpen;
-			cumulativeVolume = 0;
-			newCandle = FALSE;
-		}
-
-		cumulativeDown = currentOpen-pParams->ratesBuffers->rates[originalRatesIndex].low[i];
-	    cumulativeUp   = pParams->ratesBuffers->rates[originalRatesIndex].high[i]-currentOpen;
-		cumulativeVolume += pParams->ratesBuffers->rates[originalRatesIndex].volume[i]; 
-
-		/*if((cumulativeUp > renkoSize) && (cumulativeDown > renkoSize))
-		{
-			pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"addNewRenkoRates() failed. Requested renko bar size is too small for current data resolution. Use a lower time frame as source or use a larger renko bar size for array generation.");
-			return SUCCESS;
-		}*/
-
-		if (pParams->ratesBuffers->rates[originalRatesIndex].low[i] < lowest) lowest = pParams->ratesBuffers->rates[originalRatesIndex].low[i];
-		if (pParams->ratesBuffers->rates[originalRatesIndex].high[i] > highest) highest = pParams->ratesBuffers->rates[originalRatesIndex].high[i];
-
-		if ((cumulativeDown > renkoSize) || (cumulativeUp > renkoSize) || (i == arraySize-1))
-		{
-			
-			pParams->ratesBuffers->rates[ratesIndex].info.arraySize += 1 ;
-
-			if (pParams->ratesBuffers->rates[ratesIndex].info.arraySize > 1) 
-			{
-				pParams->ratesBuffers->rates[ratesIndex].time   =  (time_t*)realloc(pParams->ratesBuffers->rates[ratesIndex].time, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(time_t));
-				pParams->ratesBuffers->rates[ratesIndex].open   =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].open, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].high   =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].high, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].low    =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].low, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].close  =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].close, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].volume =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].volume, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-			}
-			else
-			{		
-				pParams->ratesBuffers->rates[ratesIndex].time   =  (time_t*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(time_t));
-				pParams->ratesBuffers->rates[ratesIndex].open   =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].high   =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].low    =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].close  =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].volume =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-			}
-
-			if (cumulativeDown > renkoSize)
-			{
-				pParams->ratesBuffers->rates[ratesIndex].time[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentTime;
-				pParams->ratesBuffers->rates[ratesIndex].open[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen;
-				pParams->ratesBuffers->rates[ratesIndex].high[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = highest;
-				pParams->ratesBuffers->rates[ratesIndex].low[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen-renkoSize;
-				pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen-renkoSize;
-				pParams->ratesBuffers->rates[ratesIndex].volume[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = cumulativeVolume;
-			}
-
-			if (cumulativeUp > renkoSize)
-			{
-				pParams->ratesBuffers->rates[ratesIndex].time[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentTime;
-				pParams->ratesBuffers->rates[ratesIndex].open[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen;
-				pParams->ratesBuffers->rates[ratesIndex].high[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen+renkoSize;
-				pParams->ratesBuffers->rates[ratesIndex].low[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = lowest;
-				pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen+renkoSize;
-				pParams->ratesBuffers->rates[ratesIndex].volume[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = cumulativeVolume;
-			}
-
-			if ((i == arraySize-1) && (cumulativeDown < renkoSize) && (cumulativeUp < renkoSize))
-			{
-				pParams->ratesBuffers->rates[ratesIndex].time[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentTime;
-				pParams->ratesBuffers->rates[ratesIndex].open[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen;
-				pParams->ratesBuffers->rates[ratesIndex].high[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = highest;
-				pParams->ratesBuffers->rates[ratesIndex].low[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = lowest;
-				pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = pParams->ratesBuffers->rates[originalRatesIndex].close[i];
-				pParams->ratesBuffers->rates[ratesIndex].volume[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = cumulativeVolume;
-			}
-
-			newCandle = TRUE;
-		
-		}
-
-
-	}
-
-
-	return SUCCESS;
+	return addNewDerivedRates(originalRatesIndex, ratesIndex, DERIVED_RENKO_RATES, renkoSize);
 }
 
 AsirikuyReturnCode EasyTrade::addNewConstantVolumeRates(int originalRatesIndex, int ratesIndex, int volumeRequired)
 {
+	return addNewDerivedRates(originalRatesIndex, ratesIndex, DERIVED_CONSTANT_VOLUME_RATES, volumeRequired);
+}
 
-	int arraySize, i , newCandle;
-	double cumulativeVolume;
-	double currentOpen, lowest, highest;
-	time_t currentTime;
-
-    arraySize = pParams->ratesBuffers->rates[originalRatesIndex].info.arraySize;
-
-	pParams->ratesBuffers->rates[ratesIndex].info.arraySize = 0 ;
-
-	newCandle = TRUE;
-	cumulativeVolume = 0;
+AsirikuyReturnCode EasyTrade::addNewDerivedRates(int originalRatesIndex, int ratesIndex, DerivedRatesType type, double barSize)
+{
+	AsirikuyReturnCode returnCode;
+	DerivedRatesBuilder* pBuilder;
 
-	for(i=0;i<arraySize;i++)
+	/* The builder outlives this object so only the source bars closed since the last run are consumed. */
+	pBuilder = getDerivedRatesBuilder((int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, TRUE);
+	if (pBuilder == NULL)
 	{
-
-		if (newCandle == TRUE)
-		{
-			if (pParams->ratesBuffers->rates[ratesIndex].info.arraySize == 0) 
-			currentOpen = pParams->ratesBuffers->rates[originalRatesIndex].open[i] ; else
-			currentOpen = pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] ;
-
-			currentTime  = pParams->ratesBuffers->rates[originalRatesIndex].time[i];
-			lowest = currentOpen;
-			highest = currentOpen;
-			cumulativeVolume = 0;
-			newCandle = FALSE;
-		}
-
-		cumulativeVolume += pParams->ratesBuffers->rates[originalRatesIndex].volume[i]; 
-
-		if (pParams->ratesBuffers->rates[originalRatesIndex].low[i] < lowest) lowest = pParams->ratesBuffers->rates[originalRatesIndex].low[i];
-		if (pParams->ratesBuffers->rates[originalRatesIndex].high[i] > highest) highest = pParams->ratesBuffers->rates[originalRatesIndex].high[i];
-
-		if ((cumulativeVolume >= volumeRequired) || (i == arraySize-1))
-		{
-			
-			pParams->ratesBuffers->rates[ratesIndex].info.arraySize += 1 ;
-
-			if (pParams->ratesBuffers->rates[ratesIndex].info.arraySize > 1) 
-			{
-				pParams->ratesBuffers->rates[ratesIndex].time   =  (time_t*)realloc(pParams->ratesBuffers->rates[ratesIndex].time, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(time_t));
-				pParams->ratesBuffers->rates[ratesIndex].open   =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].open, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].high   =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].high, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].low    =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].low, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].close  =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].close, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].volume =  (double*)realloc(pParams->ratesBuffers->rates[ratesIndex].volume, pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-			}
-			else
-			{		
-				pParams->ratesBuffers->rates[ratesIndex].time   =  (time_t*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(time_t));
-				pParams->ratesBuffers->rates[ratesIndex].open   =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].high   =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].low    =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].close  =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-				pParams->ratesBuffers->rates[ratesIndex].volume =  (double*)malloc(pParams->ratesBuffers->rates[ratesIndex].info.arraySize * sizeof(double));
-			}
-
-
-				pParams->ratesBuffers->rates[ratesIndex].time[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentTime;
-				pParams->ratesBuffers->rates[ratesIndex].open[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = currentOpen;
-				pParams->ratesBuffers->rates[ratesIndex].high[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = highest;
-				pParams->ratesBuffers->rates[ratesIndex].low[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = lowest;
-				pParams->ratesBuffers->rates[ratesIndex].close[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = pParams->ratesBuffers->rates[originalRatesIndex].close[i];
-				pParams->ratesBuffers->rates[ratesIndex].volume[pParams->ratesBuffers->rates[ratesIndex].info.arraySize-1] = cumulativeVolume;
-
-			newCandle = TRUE;
-		
-		}
-
-
+		return TOO_MANY_INSTANCES;
 	}
 
-	return SUCCESS;
+	returnCode = updateDerivedRates(pBuilder, type, barSize, &pParams->ratesBuffers->rates[originalRatesIndex]);
+	viewDerivedRates(pBuilder, &pParams->ratesBuffers->rates[ratesIndex]);
+
+	return returnCode;
 }
 
 AsirikuyReturnCode EasyTrade::openSingleSellLimitEasy(double entryPrice, double takeProfit, double stopLoss, double lotSize,double risk)
@@ -1247,6 +1100,13 @@ AsirikuyReturnCode EasyTrade::initEasyTradeLibrary(StrategyParams* pInputParams)
 
   pParams = pInputParams;	
 
+  isOrderHistoryIndexed = FALSE;
+  if (isOpenPositionsAggregated)
+  {
+    freeOpenPositions(&openPositions);
+    isOpenPositionsAggregated = FALSE;
+  }
+
   for (i=0; i < TOTAL_UI_VALUES; i++)
   {
     userInterfaceVariableNames[i] = (char*)"";
@@ -1412,29 +1272,20 @@ double EasyTrade::absBody(int shift)
 
 int EasyTrade::hour()
 {
-  struct tm timeInfo;
   int shift0Index = pParams->ratesBuffers->rates[0].info.arraySize - 1 ;
-  time_t time = pParams->ratesBuffers->rates[0].time[shift0Index ] ;
-  safe_gmtime(&timeInfo, time);
-  return timeInfo.tm_hour;
+  return calendarHour(pParams->ratesBuffers->rates[0].time[shift0Index]);
 }
 
 int EasyTrade::minute()
 {
-  struct tm timeInfo;
   int shift0Index = pParams->ratesBuffers->rates[0].info.arraySize - 1 ;
-  time_t time = pParams->ratesBuffers->rates[0].time[shift0Index ] ;
-  safe_gmtime(&timeInfo, time);
-  return timeInfo.tm_min;
+  return calendarMinute(pParams->ratesBuffers->rates[0].time[shift0Index]);
 }
 
 int EasyTrade::dayOfWeek()
 {
-  struct tm timeInfo;
   int shift0Index = pParams->ratesBuffers->rates[0].info.arraySize - 1 ;
-  time_t time = pParams->ratesBuffers->rates[0].time[shift0Index ] ;
-  safe_gmtime(&timeInfo, time);
-  return timeInfo.tm_wday;
+  return calendarDayOfWeek(pParams->ratesBuffers->rates[0].time[shift0Index]);
 }
 
 int EasyTrade::month()
@@ -1482,8 +1333,7 @@ double EasyTrade::iSMI(int ratesArrayIndex, int period_Q, int period_R, int peri
 	double* SMI_Buffer;
 	int shift0Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 1 ;
 	int arraySize = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize;
-	int i, n;
-	int highestHighIndex, lowestLowIndex;
+	int i;
 	double SMI_Signal;
 	Rates*     rates;
 	TA_RetCode taRetCode;
@@ -1501,26 +1351,29 @@ double EasyTrade::iSMI(int ratesArrayIndex, int period_Q, int period_R, int peri
 	SM_EMA_2 = (double*)malloc((pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize)  * sizeof(double));
 	SMI_Buffer = (double*)malloc((pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize)  * sizeof(double));
 
+	// rolling highest high and lowest low of the last period_Q bars
+	if (rollingExtremum(pParams->ratesBuffers->rates[ratesArrayIndex].high, arraySize, period_Q, TRUE, HQ_Buffer, NULL) != SUCCESS
+		|| rollingExtremum(pParams->ratesBuffers->rates[ratesArrayIndex].low, arraySize, period_Q, FALSE, SM_Buffer, NULL) != SUCCESS){
+
+		free(HQ_Buffer);
+		free(SM_Buffer);
+		free(HQ_EMA_1);
+		free(HQ_EMA_2);
+		free(SM_EMA_1);
+		free(SM_EMA_2);
+		free(SMI_Buffer);
+		return 0;
+	}
+
 	for (i = 0; i < arraySize ; i++){
 
 		if (i > period_Q){
 
-			highestHigh = pParams->ratesBuffers->rates[ratesArrayIndex].high[i];
-			lowestLow = pParams->ratesBuffers->rates[ratesArrayIndex].low[i];
-
-			for(n = 0; n < period_Q; n++){ 
-
-				if(pParams->ratesBuffers->rates[ratesArrayIndex].high[i-n] > highestHigh){
-					highestHighIndex = i-n;
-				}
-
-				if(pParams->ratesBuffers->rates[ratesArrayIndex].low[i-n] < lowestLow){
-					lowestLowIndex = i-n;
-				}
-			}
+			highestHigh = HQ_Buffer[i];
+			lowestLow = SM_Buffer[i];
 
-			HQ_Buffer[i] = pParams->ratesBuffers->rates[ratesArrayIndex].high[highestHighIndex]-pParams->ratesBuffers->rates[ratesArrayIndex].low[lowestLowIndex] ;
-			SM_Buffer[i] = pParams->ratesBuffers->rates[ratesArrayIndex].close[i] - (pParams->ratesBuffers->rates[ratesArrayIndex].high[highestHighIndex]+pParams->ratesBuffers->rates[ratesArrayIndex].low[lowestLowIndex])/2 ;
+			HQ_Buffer[i] = highestHigh - lowestLow ;
+			SM_Buffer[i] = pParams->ratesBuffers->rates[ratesArrayIndex].close[i] - (highestHigh + lowestLow)/2 ;
 		
 		} else {
 
@@ -1630,10 +1483,10 @@ int EasyTrade::iMACDTrendBeiLi(int ratesArrayIndex, int fastPeriod, int slowPeri
 
 	//startShift = 1;
 		
-	// Load 100 MACD signals
-	for (int i = startShift; i < 299; i++)
+	// Load the MACD signals from startShift back to shift 298
+	if (iMACDSeries(ratesArrayIndex, fastPeriod, slowPeriod, signalPeriod, startShift, 299 - startShift, &fast[startShift], &slow[startShift], &preHist[startShift]) != SUCCESS)
 	{
-		iMACDAll(ratesArrayIndex, fastPeriod, slowPeriod, signalPeriod, i, &fast[i], &slow[i], &preHist[i]);
+		return 0;
 	}
 
 	// ϣ Ϳ
@@ -1705,27 +1558,44 @@ int EasyTrade::iMACDTrendBeiLi(int ratesArrayIndex, int fastPeriod, int slowPeri
 
 double EasyTrade::iBBandStop(int ratesArrayIndex, int bb_period, double bb_deviation, int * trend, double * bbStopPrice,int *index)
 {
-	TA_RetCode retCode;
-	int        outBegIdx, outNBElement;
-	double	  upperBand[2000] = {}, middleBand[2000] = {}, lowerBand[2000] = {};
+	double	  *upperBand, *middleBand, *lowerBand;
 	int shift1Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 2;
-	int start = 0;
+	int count = shift1Index + 1;
+	int i;
 
 	double upLimit = 10000, downLimit = 0;
 	*trend = 0;
 	*bbStopPrice = 0;
 
-	retCode = TA_BBANDS(start, shift1Index, pParams->ratesBuffers->rates[ratesArrayIndex].close, bb_period, bb_deviation, bb_deviation, TA_MAType_SMA, &outBegIdx, &outNBElement, upperBand, middleBand, lowerBand);
-	if (retCode != TA_SUCCESS)
+	if (count <= 0)
+	{
+		return INDICATOR_CALCULATION_ERROR;
+	}
+
+	upperBand = (double*)malloc(3 * count * sizeof(double));
+	if (upperBand == NULL)
 	{
 		return INDICATOR_CALCULATION_ERROR;
 	}
+	middleBand = upperBand + count;
+	lowerBand = middleBand + count;
 
-	//int bbSize = 0;	
+	// The bands come newest first, band i belongs to the bar at shift1Index - i
+	if (iBBandsSeries(3, ratesArrayIndex, bb_period, bb_deviation, 1, count, upperBand, middleBand, lowerBand) != SUCCESS)
+	{
+		free(upperBand);
+		return INDICATOR_CALCULATION_ERROR;
+	}
 
+	// Skip the oldest bars that only feed the lookback of the bands
+	i = count - 1;
+	while (i >= 0 && upperBand[i] == 0)
+	{
+		i--;
+	}
 
 	// Loop through and chceck out if BBS exists
-	for (int i = start; i < outNBElement; i++)
+	for (; i >= 0; i--)
 	{
 		if (upperBand[i] == 0)
 			break;
@@ -1754,23 +1624,22 @@ double EasyTrade::iBBandStop(int ratesArrayIndex, int bb_period, double bb_devia
 		}
 
 		// Found a new up trend
-		if (pParams->ratesBuffers->rates[ratesArrayIndex].close[outBegIdx+i] > upLimit && *trend != 1)
+		if (pParams->ratesBuffers->rates[ratesArrayIndex].close[shift1Index - i] > upLimit && *trend != 1)
 		{
 			*trend = 1;
 			*bbStopPrice = lowerBand[i];	
-			*index = outBegIdx + i;
+			*index = shift1Index - i;
 		}
 		//Found a new down trend
-		else if (pParams->ratesBuffers->rates[ratesArrayIndex].close[outBegIdx+i] < downLimit && *trend != -1)
+		else if (pParams->ratesBuffers->rates[ratesArrayIndex].close[shift1Index - i] < downLimit && *trend != -1)
 		{
 			*trend = -1;
 			*bbStopPrice = upperBand[i];	
-			*index = outBegIdx + i;
+			*index = shift1Index - i;
 		}	
-
-		
 	}
 
+	free(upperBand);
 	return 0;
 }
 
@@ -2038,127 +1907,133 @@ double EasyTrade::iRangeAverage(int ratesArrayIndex, int period, int shift)
   return average;
 }
 
-double EasyTrade::iRangeSafeShiftZero(int period)
+/* Reads the high, low and close of a daily shift, with shift 0 taken from the intraday bars of the current day when pToday is set. */
+static void readSafeShiftZeroDay(const Rates* pDaily, const SessionBar* pToday, int shift, double* pHigh, double* pLow, double* pClose)
 {
-  double average = 0;
-  int i,j;
-  int dailyShift0Index = pParams->ratesBuffers->rates[DAILY_RATES].info.arraySize - 1 ;
-  double* highDaily = (double*)malloc(period * sizeof(double));
-  double* lowDaily  = (double*)malloc(period * sizeof(double));
+  int index = pDaily->info.arraySize - 1 - shift;
 
-  for (i=0; i<period; i++)
+  if((shift == 0) && (pToday != NULL))
   {
-    highDaily[i]  =  pParams->ratesBuffers->rates[DAILY_RATES].high[dailyShift0Index-i];
-    lowDaily[i]   =  pParams->ratesBuffers->rates[DAILY_RATES].low[dailyShift0Index-i];
-
-    if (i == 0)
-    {
-      highDaily[i]  =  pParams->ratesBuffers->rates[DAILY_RATES].open[dailyShift0Index];
-      lowDaily[i]   =  pParams->ratesBuffers->rates[DAILY_RATES].open[dailyShift0Index];
-
-      j = 1;
+    *pHigh  = pToday->high;
+    *pLow   = pToday->low;
+    *pClose = pToday->close;
+    return;
+  }
 
-      while  (openTime(j) >= pParams->ratesBuffers->rates[DAILY_RATES].time[dailyShift0Index])
-      {
-        if (high(j) > highDaily[i])
-          highDaily[i] = high(j) ;
+  *pHigh  = pDaily->high[index];
+  *pLow   = pDaily->low[index];
+  *pClose = pDaily->close[index];
+}
 
-        if (low(j) < lowDaily[i])
-          lowDaily[i] = low(j) ;
+const SessionTracker* EasyTrade::getInstanceSessions()
+{
+  SessionTracker* pTracker = getSessionTracker((int)pParams->settings[STRATEGY_INSTANCE_ID], TRUE);
 
-        j++;
-      }
-    }		
+  if(pTracker == NULL)
+  {
+    return NULL;
   }
 
-  for (i=0; i<period-1; i++)
+  if(updateSessionTracker(pTracker, &pParams->ratesBuffers->rates[PRIMARY_RATES_INDEX]) != SUCCESS)
   {
-    average += (highDaily[i]-lowDaily[i])/period ;
+    return NULL;
   }
 
-  free(highDaily);
-  free(lowDaily);
-
-  return average;
+  return pTracker;
 }
 
-
-double EasyTrade::iAtrSafeShiftZero(int period)
+AsirikuyReturnCode EasyTrade::getCurrentSessionBar(SessionType type, SessionBar* pOutBar)
 {
-  double trueRange;
-  double average;
-  int i,j, currentDay, lastCandleCloseDay;
-  int dailyShift0Index = pParams->ratesBuffers->rates[DAILY_RATES].info.arraySize - 1 ;
-  struct tm  currentTime, lastCandleTime;
-  double* openDaily  = (double*)malloc(period * sizeof(double));
-  double* highDaily  = (double*)malloc(period * sizeof(double));
-  double* lowDaily   = (double*)malloc(period * sizeof(double));
-  double* closeDaily = (double*)malloc(period * sizeof(double));
+  const SessionTracker* pSessions = getInstanceSessions();
 
-  safe_gmtime(&currentTime, pParams->currentBrokerTime);
-  safe_gmtime(&lastCandleTime, openTime(1));
+  if(pOutBar == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"getCurrentSessionBar() failed. pOutBar = NULL");
+    return NULL_POINTER;
+  }
 
-  currentDay = currentTime.tm_wday;
-  lastCandleCloseDay = lastCandleTime.tm_wday;
+  if(pSessions == NULL)
+  {
+    return NULL_POINTER;
+  }
 
-  i = 0;
+  *pOutBar = *getSessionBar(pSessions, type);
+  return SUCCESS;
+}
 
-  while (i<period)
+double EasyTrade::iRangeSafeShiftZero(int period)
+{
+  double average = 0;
+  double highDaily, lowDaily;
+  int i;
+  int dailyShift0Index = pParams->ratesBuffers->rates[DAILY_RATES].info.arraySize - 1 ;
+  time_t dailyOpenTime = pParams->ratesBuffers->rates[DAILY_RATES].time[dailyShift0Index];
+  const SessionTracker* pSessions = getInstanceSessions();
+  const SessionBar* pToday = (pSessions != NULL) ? getSessionBar(pSessions, SESSION_DAY) : NULL;
+
+  for (i=0; i<period-1; i++)
   {
-    if ((i > 0) || lastCandleCloseDay != currentDay )
-    {
-      openDaily[i]  =  pParams->ratesBuffers->rates[DAILY_RATES].open[dailyShift0Index-i];
-      highDaily[i]  =  pParams->ratesBuffers->rates[DAILY_RATES].high[dailyShift0Index-i];
-      lowDaily[i]   =  pParams->ratesBuffers->rates[DAILY_RATES].low[dailyShift0Index-i];
-      closeDaily[i] =  pParams->ratesBuffers->rates[DAILY_RATES].close[dailyShift0Index-i];
-      i++;
-    }
+    highDaily = pParams->ratesBuffers->rates[DAILY_RATES].high[dailyShift0Index-i];
+    lowDaily  = pParams->ratesBuffers->rates[DAILY_RATES].low[dailyShift0Index-i];
 
-    if ((i == 0) && (lastCandleCloseDay == currentDay))
+    if (i == 0)
     {
-      closeDaily[i] = close(1);
-      highDaily [i] = high(1);
-      lowDaily[i] = low(1);
-
-      j = 1;
+      // The current day starts at the open of the daily bar and grows with the intraday bars closed since then
+      highDaily = pParams->ratesBuffers->rates[DAILY_RATES].open[dailyShift0Index];
+      lowDaily  = pParams->ratesBuffers->rates[DAILY_RATES].open[dailyShift0Index];
 
-      while  (lastCandleCloseDay == currentDay)
+      if ((pToday != NULL) && (pToday->startIndex >= 0) && (pToday->key == getSessionKey(SESSION_DAY, dailyOpenTime)))
       {
-        if (high(j) > highDaily[i])
-        {
-          highDaily[i] = high(j);
-        }
+        if (pToday->high > highDaily)
+          highDaily = pToday->high;
 
-        if (low(j) < lowDaily[i])
-        {
-          lowDaily[i] = low(j);
-        }
+        if (pToday->low < lowDaily)
+          lowDaily = pToday->low;
+      }
+    }
 
-        openDaily[i] = open(j); 
+    average += (highDaily-lowDaily)/period ;
+  }
 
-        j++;
+  return average;
+}
 
-        safe_gmtime(&lastCandleTime, openTime(j));
-        lastCandleCloseDay = lastCandleTime.tm_wday;
-      }
 
-      i++;
-    }		
+double EasyTrade::iAtrSafeShiftZero(int period)
+{
+  double trueRange;
+  double average;
+  double highDaily, lowDaily, closeDaily, previousHigh, previousLow, previousClose;
+  int i;
+  const Rates* pDaily = &pParams->ratesBuffers->rates[DAILY_RATES];
+  const SessionTracker* pSessions = getInstanceSessions();
+  const SessionBar* pToday = NULL;
+
+  // When the last closed intraday bar belongs to the current day, that day is synthesized from the intraday bars
+  if (pSessions != NULL)
+  {
+    pToday = getSessionBar(pSessions, SESSION_DAY);
+    if ((pToday->startIndex < 0) || (pToday->key != getSessionKey(SESSION_DAY, pParams->currentBrokerTime)))
+    {
+      pToday = NULL;
+    }
   }
 
-  average = (highDaily[period-1]-lowDaily[period-1])/period ;
+  readSafeShiftZeroDay(pDaily, pToday, period - 1, &highDaily, &lowDaily, &closeDaily);
+  average = (highDaily-lowDaily)/period ;
 
+  readSafeShiftZeroDay(pDaily, pToday, 0, &previousHigh, &previousLow, &previousClose);
   for (i=0; i<period-1; i++)
   {
-    trueRange = max(highDaily[i]-lowDaily[i], max(fabs(highDaily[i]-closeDaily[i+1]), fabs(lowDaily[i]-closeDaily[i+1]))) ;
+    readSafeShiftZeroDay(pDaily, pToday, i + 1, &highDaily, &lowDaily, &closeDaily);
+
+    trueRange = max(previousHigh-previousLow, max(fabs(previousHigh-closeDaily), fabs(previousLow-closeDaily))) ;
 
     average += trueRange/period;
-  }
 
-  free(openDaily);
-  free(highDaily);
-  free(lowDaily);
-  free(closeDaily);
+    previousHigh = highDaily;
+    previousLow  = lowDaily;
+  }
 
   return average;
 }
@@ -2327,20 +2202,293 @@ double EasyTrade::iAtr(int ratesArrayIndex, int period, int shift)
   return atr;
 }
 
-void EasyTrade::print(double valueToPrint)
+/* Puts the outNBElement values TA-lib wrote oldest first into newest first order and clears the shifts it could not compute. */
+static void orderSeriesNewestFirst(double* pValues, int outNBElement, int count)
 {
-  pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"Print = %lf", valueToPrint);
-}
+  double value;
+  int    i;
 
-AsirikuyReturnCode EasyTrade::checkOrders(double takeProfit, double stopLoss)
-{
-  AsirikuyReturnCode returnCode = SUCCESS;
+  for(i = 0; i < outNBElement / 2; i++)
+  {
+    value = pValues[i];
+    pValues[i] = pValues[outNBElement - 1 - i];
+    pValues[outNBElement - 1 - i] = value;
+  }
 
-  // check internal TP
-  checkInternalTP(pParams, PRIMARY_RATES_INDEX, 0, takeProfit);
-  if(returnCode != SUCCESS)
+  for(i = outNBElement; i < count; i++)
   {
-    return logAsirikuyError("checkOrders()", returnCode);
+    pValues[i] = 0;
+  }
+}
+
+const double* EasyTrade::getSeriesPrices(int type, int ratesArrayIndex)
+{
+  switch(type)
+  {
+  case 0: return pParams->ratesBuffers->rates[ratesArrayIndex].open;
+  case 1: return pParams->ratesBuffers->rates[ratesArrayIndex].high;
+  case 2: return pParams->ratesBuffers->rates[ratesArrayIndex].low;
+  case 3: return pParams->ratesBuffers->rates[ratesArrayIndex].close;
+  case 4: return pParams->ratesBuffers->rates[ratesArrayIndex].volume;
+  default: return NULL;
+  }
+}
+
+AsirikuyReturnCode EasyTrade::getSeriesRange(int ratesArrayIndex, int startShift, int count, int* pStartIndex, int* pEndIndex)
+{
+  int shift0Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 1;
+
+  if((startShift < 0) || (count <= 0))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"getSeriesRange() failed. startShift = %d, count = %d", startShift, count);
+    return INVALID_PARAMETER;
+  }
+
+  *pEndIndex = shift0Index - startShift;
+  if(*pEndIndex < 0)
+  {
+    logAsirikuyError("getSeriesRange()", NOT_ENOUGH_RATES_DATA);
+    return NOT_ENOUGH_RATES_DATA;
+  }
+
+  *pStartIndex = *pEndIndex - count + 1;
+  if(*pStartIndex < 0)
+  {
+    *pStartIndex = 0;
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode EasyTrade::iMASeries(int type, int ratesArrayIndex, int period, int startShift, int count, double* pOutValues)
+{
+  AsirikuyReturnCode returnCode;
+  const double*      pPrices = getSeriesPrices(type, ratesArrayIndex);
+  double             periodTotal;
+  int                startIndex, endIndex, firstIndex, i;
+
+  if(pOutValues == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"iMASeries() failed. pOutValues = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pPrices == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"iMASeries() failed. Unknown price type %d", type);
+    return INVALID_PARAMETER;
+  }
+
+  if(period < 1)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"iMASeries() failed. period = %d", period);
+    return INVALID_PARAMETER;
+  }
+
+  returnCode = getSeriesRange(ratesArrayIndex, startShift, count, &startIndex, &endIndex);
+  if(returnCode != SUCCESS)
+  {
+    return returnCode;
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    pOutValues[i] = 0;
+  }
+
+  /* iMA asks TA-lib for a single EMA value, which is the SMA that seeds the EMA, so every shift is the SMA of the
+     period bars ending at it. The running total is kept the way TA_SMA keeps it. */
+  firstIndex = startIndex > period - 1 ? startIndex : period - 1;
+  if(firstIndex > endIndex)
+  {
+    return SUCCESS;
+  }
+
+  periodTotal = 0;
+  for(i = firstIndex - period + 1; i < firstIndex; i++)
+  {
+    periodTotal += pPrices[i];
+  }
+
+  for(i = firstIndex; i <= endIndex; i++)
+  {
+    periodTotal += pPrices[i];
+    pOutValues[endIndex - i] = periodTotal / period;
+    periodTotal -= pPrices[i - period + 1];
+  }
+
+  return SUCCESS;
+}
+
+AsirikuyReturnCode EasyTrade::iMACDSeries(int ratesArrayIndex, int fastPeriod, int slowPeriod, int signalPeriod, int startShift, int count, double* pMacd, double* pMacdSignal, double* pMacdHist)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+  TA_RetCode         taRetCode;
+  int                startIndex, endIndex, outBegIdx, outNBElement, i;
+
+  if((pMacd == NULL) || (pMacdSignal == NULL) || (pMacdHist == NULL))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"iMACDSeries() failed. An output buffer is NULL");
+    return NULL_POINTER;
+  }
+
+  returnCode = getSeriesRange(ratesArrayIndex, startShift, count, &startIndex, &endIndex);
+  if(returnCode != SUCCESS)
+  {
+    return returnCode;
+  }
+
+  /* Each iMACD value runs its EMAs through 35 unstable bars before its own shift, so a range call would return
+     different values. Every shift gets the same single value call, only the unstable period is set once. */
+  TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, 35);
+  for(i = 0; i < count; i++)
+  {
+    pMacd[i] = pMacdSignal[i] = pMacdHist[i] = 0;
+    if(endIndex - i < startIndex)
+    {
+      continue;
+    }
+
+    taRetCode = TA_MACDEXT(endIndex - i, endIndex - i, pParams->ratesBuffers->rates[ratesArrayIndex].close, fastPeriod, TA_MAType_EMA, slowPeriod, TA_MAType_EMA, signalPeriod, TA_MAType_EMA, &outBegIdx, &outNBElement, &pMacd[i], &pMacdSignal[i], &pMacdHist[i]);
+    if(taRetCode != TA_SUCCESS)
+    {
+      logTALibError("TA_MACDEXT()", taRetCode);
+      returnCode = TA_LIB_ERROR;
+      break;
+    }
+  }
+  TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, 0);
+
+  return returnCode;
+}
+
+AsirikuyReturnCode EasyTrade::iBBandsSeries(int type, int ratesArrayIndex, int bb_period, double bb_deviation, int startShift, int count, double* pUpperBand, double* pMiddleBand, double* pLowerBand)
+{
+  AsirikuyReturnCode returnCode;
+  TA_RetCode         taRetCode;
+  const double*      pPrices = getSeriesPrices(type, ratesArrayIndex);
+  int                startIndex, endIndex, outBegIdx, outNBElement;
+
+  if((pUpperBand == NULL) || (pMiddleBand == NULL) || (pLowerBand == NULL))
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"iBBandsSeries() failed. An output buffer is NULL");
+    return NULL_POINTER;
+  }
+
+  if(pPrices == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"iBBandsSeries() failed. Unknown price type %d", type);
+    return INVALID_PARAMETER;
+  }
+
+  returnCode = getSeriesRange(ratesArrayIndex, startShift, count, &startIndex, &endIndex);
+  if(returnCode != SUCCESS)
+  {
+    return returnCode;
+  }
+
+  taRetCode = TA_BBANDS(startIndex, endIndex, pPrices, bb_period, bb_deviation, bb_deviation, TA_MAType_SMA, &outBegIdx, &outNBElement, pUpperBand, pMiddleBand, pLowerBand);
+  if(taRetCode != TA_SUCCESS)
+  {
+    logTALibError("TA_BBANDS()", taRetCode);
+    return TA_LIB_ERROR;
+  }
+
+  orderSeriesNewestFirst(pUpperBand, outNBElement, count);
+  orderSeriesNewestFirst(pMiddleBand, outNBElement, count);
+  orderSeriesNewestFirst(pLowerBand, outNBElement, count);
+  return SUCCESS;
+}
+
+/* The true range as TA_TRANGE computes it. */
+static double trueRange(const double* pHigh, const double* pLow, const double* pClose, int index)
+{
+  double greatest = pHigh[index] - pLow[index];
+  double value    = fabs(pClose[index - 1] - pHigh[index]);
+
+  if(value > greatest)
+  {
+    greatest = value;
+  }
+  value = fabs(pClose[index - 1] - pLow[index]);
+  if(value > greatest)
+  {
+    greatest = value;
+  }
+
+  return greatest;
+}
+
+AsirikuyReturnCode EasyTrade::iAtrSeries(int ratesArrayIndex, int period, int startShift, int count, double* pOutValues)
+{
+  AsirikuyReturnCode returnCode;
+  const double*      pHigh  = pParams->ratesBuffers->rates[ratesArrayIndex].high;
+  const double*      pLow   = pParams->ratesBuffers->rates[ratesArrayIndex].low;
+  const double*      pClose = pParams->ratesBuffers->rates[ratesArrayIndex].close;
+  double             periodTotal;
+  int                startIndex, endIndex, firstIndex, i;
+
+  if(pOutValues == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"iAtrSeries() failed. pOutValues = NULL");
+    return NULL_POINTER;
+  }
+
+  if(period < 1)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"iAtrSeries() failed. period = %d", period);
+    return INVALID_PARAMETER;
+  }
+
+  returnCode = getSeriesRange(ratesArrayIndex, startShift, count, &startIndex, &endIndex);
+  if(returnCode != SUCCESS)
+  {
+    return returnCode;
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    pOutValues[i] = 0;
+  }
+
+  /* A single value TA_ATR call averages the true ranges of the period bars ending at the shift without any Wilder
+     smoothing, so iAtr is a rolling SMA of the true range. */
+  firstIndex = startIndex > period ? startIndex : period;
+  if(firstIndex > endIndex)
+  {
+    return SUCCESS;
+  }
+
+  periodTotal = 0;
+  for(i = firstIndex - period + 1; i < firstIndex; i++)
+  {
+    periodTotal += trueRange(pHigh, pLow, pClose, i);
+  }
+
+  for(i = firstIndex; i <= endIndex; i++)
+  {
+    periodTotal += trueRange(pHigh, pLow, pClose, i);
+    pOutValues[endIndex - i] = periodTotal / period;
+    periodTotal -= trueRange(pHigh, pLow, pClose, i - period + 1);
+  }
+
+  return SUCCESS;
+}
+
+void EasyTrade::print(double valueToPrint)
+{
+  pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"Print = %lf", valueToPrint);
+}
+
+AsirikuyReturnCode EasyTrade::checkOrders(double takeProfit, double stopLoss)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+
+  // check internal TP
+  checkInternalTP(pParams, PRIMARY_RATES_INDEX, 0, takeProfit);
+  if(returnCode != SUCCESS)
+  {
+    return logAsirikuyError("checkOrders()", returnCode);
   }
 
   // check timed exit
@@ -2804,63 +2952,22 @@ int EasyTrade::getOldestOpenOrderIndex(int rateIndex)
 
 int EasyTrade::getLastestOrderIndexExceptLimitAndStopOrders(int rateIndex,BOOL isClosedOnly)
 {
-	int i;
-	int    shift0Index = pParams->ratesBuffers->rates[rateIndex].info.arraySize - 1, shift1Index = pParams->ratesBuffers->rates[rateIndex].info.arraySize - 2;
-	time_t openTime, maxTime = 0;
-	struct tm timeInfo1;
-	int  execution_tf = (int)pParams->settings[TIMEFRAME];
-	int index = -1;
-
-	time_t currentTime = pParams->ratesBuffers->rates[rateIndex].time[shift0Index];
-	safe_gmtime(&timeInfo1, currentTime);
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 
-			&& (pParams->orderInfo[i].type == BUY || pParams->orderInfo[i].type == SELL)
-			&& (isClosedOnly == FALSE || pParams->orderInfo[i].isOpen == FALSE)
-			)
-		{
-			openTime = pParams->orderInfo[i].openTime;
-
-			if (openTime > maxTime)
-			{
-				maxTime = openTime;
-				index = i;
-			}
-		}
-	}
+	if (pIndex == NULL)
+		return -1;
 
-	return index;
+	return isClosedOnly ? pIndex->latestClosedMarketOrder : pIndex->latestMarketOrder;
 }
 
 int EasyTrade::getLastestOrderIndex(int rateIndex)
 {
-	int i;
-	int    shift0Index = pParams->ratesBuffers->rates[rateIndex].info.arraySize - 1, shift1Index = pParams->ratesBuffers->rates[rateIndex].info.arraySize - 2;
-	time_t openTime, maxTime = 0;
-	struct tm timeInfo1;
-	int  execution_tf = (int)pParams->settings[TIMEFRAME];
-	int index = -1;
-	
-	time_t currentTime = pParams->ratesBuffers->rates[rateIndex].time[shift0Index];
-	safe_gmtime(&timeInfo1, currentTime);
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			openTime = pParams->orderInfo[i].openTime;
+	if (pIndex == NULL)
+		return -1;
 
-			if (openTime > maxTime)
-			{
-				maxTime = openTime;
-				index = i;
-			}
-		}
-	}
-
-	return index;
+	return pIndex->latestOrder;
 }
 
 double EasyTrade::getLastestOrderPrice(int rateIndex, BOOL * pIsOpen)
@@ -3268,25 +3375,19 @@ int EasyTrade::hasSameDayOrderExcludeBreakeventOrders(time_t currentTime, BOOL *
 
 int EasyTrade::hasSameDayOrder( time_t currentTime,BOOL *pIsOpen)
 {
-	int i;
-	struct tm timeInfo1, timeInfo2;
-	safe_gmtime(&timeInfo1, currentTime);
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
+	const OrderHistoryDay* pDay;
 
 	*pIsOpen = FALSE;
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);
-			if (timeInfo1.tm_year == timeInfo2.tm_year &&  timeInfo1.tm_mon == timeInfo2.tm_mon && timeInfo1.tm_mday == timeInfo2.tm_mday)
-			{
-				*pIsOpen = pParams->orderInfo[i].isOpen;
-				return TRUE;
-			}
-		}
-	}
+	if (pIndex == NULL)
+		return FALSE;
 
-	return FALSE;
+	pDay = findOrderHistoryDay(pIndex, currentTime);
+	if (pDay == NULL)
+		return FALSE;
+
+	*pIsOpen = pParams->orderInfo[pDay->firstOrder].isOpen;
+	return TRUE;
 }
 
 double EasyTrade::isSameDaySamePricePendingOrder(double entryPrice, double limit, time_t currentTime)
@@ -3313,122 +3414,23 @@ double EasyTrade::isSameDaySamePricePendingOrder(double entryPrice, double limit
 
 int EasyTrade::getLossTimesInWeek(time_t currentTime, double * total_lost_pips)
 {
-	int i;
-	int lossTimes = 0;
-	int monday, friday, current;
-	struct tm timeInfo1, timeInfo2;
-	BOOL isCrossNewYear = FALSE;
-	*total_lost_pips = 0;
-
-	safe_gmtime(&timeInfo1, currentTime);
-
-	monday = timeInfo1.tm_yday - timeInfo1.tm_wday + 1;
-	friday = timeInfo1.tm_yday - timeInfo1.tm_wday + 5;
-	if (monday < 0)
-	{
-		isCrossNewYear = TRUE;
-		monday += 365;
-		friday += 365;
-	}
-
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{		
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);
-			current = timeInfo2.tm_yday;
-
-			if (isCrossNewYear == FALSE && timeInfo2.tm_year != timeInfo1.tm_year)
-				continue;
-
-			if (isCrossNewYear && timeInfo2.tm_yday < 7)
-				current += 365;
-
-			if (current >= monday && current <= friday)
-			{
-				if (pParams->orderInfo[i].isOpen == FALSE && pParams->orderInfo[i].profit < 0)
-				{
-					*total_lost_pips += fabs(pParams->orderInfo[i].closePrice - pParams->orderInfo[i].openPrice) * pParams->orderInfo[i].lots;
-					lossTimes++;
-				}
-
-				if (pParams->orderInfo[i].isOpen == TRUE)
-				{
-					if (pParams->orderInfo[i].type == BUY && pParams->bidAsk.ask[0] < pParams->orderInfo[i].openPrice)
-					{
-						*total_lost_pips += fabs(pParams->bidAsk.bid[0] - pParams->orderInfo[i].openPrice) * pParams->orderInfo[i].lots;
-						lossTimes++;
-					}
-					if (pParams->orderInfo[i].type == SELL && pParams->bidAsk.bid[0] > pParams->orderInfo[i].openPrice)
-					{
-						*total_lost_pips += fabs(pParams->bidAsk.bid[0] - pParams->orderInfo[i].openPrice) * pParams->orderInfo[i].lots;
-						lossTimes++;
-					}
-				}
-
-			}
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-			
-		}
-		
-	}
+	*total_lost_pips = 0;
+	if (pIndex == NULL)
+		return 0;
 
-	return lossTimes;
+	return getOrderHistoryLossesInWeek(pIndex, currentTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0], total_lost_pips);
 }
 
 int EasyTrade::getWinTimesInWeek(time_t currentTime)
 {
-	int i;
-	int winningTimes = 0;
-	int monday, friday, current;
-	struct tm timeInfo1, timeInfo2;
-	BOOL isCrossNewYear = FALSE;
-
-	safe_gmtime(&timeInfo1, currentTime);
-
-	monday = timeInfo1.tm_yday - timeInfo1.tm_wday + 1;
-	friday = timeInfo1.tm_yday - timeInfo1.tm_wday + 5;
-	if (monday < 0)
-	{
-		isCrossNewYear = TRUE;
-		monday += 365;
-		friday += 365;
-	}
-	
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		// Close winning trades.
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);
-			current = timeInfo2.tm_yday;
-
-			if (isCrossNewYear == FALSE && timeInfo2.tm_year != timeInfo1.tm_year)
-				continue;
-
-			if (isCrossNewYear && timeInfo2.tm_yday < 7)
-				current += 365;
-
-			if (current >= monday && current <= friday)
-			{
-
-				if (pParams->orderInfo[i].isOpen == FALSE && pParams->orderInfo[i].profit > 0)
-					winningTimes++;					
-
-				if (pParams->orderInfo[i].isOpen == TRUE)
-				{
-					if (pParams->orderInfo[i].type == BUY && pParams->bidAsk.ask[0] > pParams->orderInfo[i].takeProfit)
-						winningTimes++;
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-					if (pParams->orderInfo[i].type == SELL && pParams->bidAsk.bid[0] < pParams->orderInfo[i].takeProfit)
-						winningTimes++;
-				}
-			}
-		}
-		
-	}
+	if (pIndex == NULL)
+		return 0;
 
-	return winningTimes;
+	return getOrderHistoryWinsInWeek(pIndex, currentTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0]);
 }
 
 
@@ -3814,19 +3816,12 @@ int EasyTrade::getOrderCount()
 
 double EasyTrade::caculateFreeMargin()
 {
-	int i;
-	double cost = 0;
-	
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 && pParams->orderInfo[i].isOpen == TRUE)
-		{
-			cost += pParams->bidAsk.ask[0] * pParams->orderInfo[i].lots;
-		}
-	}
+	const OpenPositions* pPositions = getOpenPositions();
 
-	return pParams->accountInfo.equity - cost;
-	
+	if (pPositions == NULL)
+		return pParams->accountInfo.equity;
+
+	return pParams->accountInfo.equity - pParams->bidAsk.ask[0] * getOpenPositionsLots(pPositions);
 }
 
 int EasyTrade::getOrderCountTodayExcludeBreakeventOrders(time_t currentTime, double points)
@@ -3859,28 +3854,17 @@ int EasyTrade::getOrderCountTodayExcludeBreakeventOrders(time_t currentTime, dou
 
 int EasyTrade::getOrderCountToday(time_t currentTime)
 {
-	int i;
-	int count = 0;
-	struct tm timeInfo1, timeInfo2;
-	
-
-	safe_gmtime(&timeInfo1, currentTime);
-
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 && (pParams->orderInfo[i].type == BUY || pParams->orderInfo[i].type == SELL))
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
+	const OrderHistoryDay* pDay;
 
-			if (timeInfo1.tm_year == timeInfo2.tm_year && timeInfo1.tm_yday == timeInfo2.tm_yday)
-			{
-				count++;
-			}
-		}
+	if (pIndex == NULL)
+		return 0;
 
-	}
+	pDay = findOrderHistoryDay(pIndex, currentTime);
+	if (pDay == NULL)
+		return 0;
 
-	return count;
+	return pDay->marketOrders;
 }
 
 int EasyTrade::getOrderCountForCurrentWeek(time_t currentTime)
@@ -3998,54 +3982,13 @@ int EasyTrade::getLossTimesInDayCloseOrder(time_t currentTime, double * total_lo
 
 int EasyTrade::getLossTimesInDay(time_t currentTime,double * total_lost_pips)
 {
-	int i;
-	int lossTimes = 0;	
-	struct tm timeInfo1, timeInfo2;	
-	*total_lost_pips = 0;
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-	safe_gmtime(&timeInfo1, currentTime);
-
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);			
-
-			if (timeInfo1.tm_year == timeInfo2.tm_year && timeInfo1.tm_yday == timeInfo2.tm_yday)
-			{
-				if (pParams->orderInfo[i].isOpen == FALSE && pParams->orderInfo[i].profit < 0) 
-				{
-					lossTimes++;
-					*total_lost_pips += fabs(pParams->orderInfo[i].closePrice - pParams->orderInfo[i].openPrice) * pParams->orderInfo[i].lots;
-				}
-
-				if (pParams->orderInfo[i].isOpen == TRUE)
-				{
-					if (pParams->orderInfo[i].type == BUY && pParams->bidAsk.ask[0] < pParams->orderInfo[i].openPrice 
-						//&& fabs(pParams->bidAsk.ask[0] - pParams->orderInfo[i].openPrice) > 0.2
-						)
-					{
-						lossTimes++;
-						*total_lost_pips += fabs(pParams->bidAsk.ask[0] - pParams->orderInfo[i].openPrice)* pParams->orderInfo[i].lots;
-					}
-
-					if (pParams->orderInfo[i].type == SELL && pParams->bidAsk.bid[0] > pParams->orderInfo[i].openPrice  
-						//&& fabs(pParams->bidAsk.ask[0] - pParams->orderInfo[i].openPrice) > 0.2
-						)
-					{
-						lossTimes++;
-						*total_lost_pips += fabs(pParams->bidAsk.bid[0] - pParams->orderInfo[i].openPrice)* pParams->orderInfo[i].lots;
-					}
-				}
-
-			}
-
-
-		}
-
-	}
+	*total_lost_pips = 0;
+	if (pIndex == NULL)
+		return 0;
 
-	return lossTimes;
+	return getOrderHistoryLossesInDay(pIndex, currentTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0], total_lost_pips);
 }
 
 int EasyTrade::getLossTimesInDaywithSamePrice(time_t currentTime, double openPrice, double limit)
@@ -4127,38 +4070,12 @@ int EasyTrade::getWinTimesInDaywithSamePrice(time_t currentTime,double openPrice
 
 int EasyTrade::getWinTimesInDay(time_t currentTime)
 {
-	int i;
-	int winningTimes = 0;	
-	struct tm timeInfo1, timeInfo2;
-	
-	safe_gmtime(&timeInfo1, currentTime);
-
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		// Close winning trades.
-		if (pParams->orderInfo[i].ticket != 0)
-		{
-			safe_gmtime(&timeInfo2, pParams->orderInfo[i].openTime);
-			if (timeInfo1.tm_year == timeInfo2.tm_year && timeInfo1.tm_yday == timeInfo2.tm_yday)
-			{
-
-				if (pParams->orderInfo[i].isOpen == FALSE && pParams->orderInfo[i].profit > 0)
-					winningTimes++;
-
-				if (pParams->orderInfo[i].isOpen == TRUE && pParams->orderInfo[i].takeProfit > 0)
-				{
-					if (pParams->orderInfo[i].type == BUY && pParams->bidAsk.ask[0] > pParams->orderInfo[i].takeProfit)
-						winningTimes++;
+	const OrderHistoryIndex* pIndex = getOrderHistoryIndex();
 
-					if (pParams->orderInfo[i].type == SELL && pParams->bidAsk.bid[0] < pParams->orderInfo[i].takeProfit)
-						winningTimes++;
-				}
-			}
-		}
-
-	}
+	if (pIndex == NULL)
+		return 0;
 
-	return winningTimes;
+	return getOrderHistoryWinsInDay(pIndex, currentTime, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0]);
 }
 
 double EasyTrade::isSamePricePendingOrder(double entryPrice, double limit)
@@ -4264,7 +4181,7 @@ double EasyTrade::caculateStrategyPNLCloseOrder(OrderType type, double openPrice
 	mLP = maxLossPerLot(pParams, type, openPrice, stopLoss);
 
 	risk = lots * mLP * adjust / (0.01 * equity);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"PNL = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, lots);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "PNL = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, lots);
 
 
 	return risk;
@@ -4305,7 +4222,7 @@ double EasyTrade::caculateStrategyPNLOrder(OrderType type, double openPrice, dou
 	mLP = maxLossPerLot(pParams, type, openPrice, stopLoss);
 
 	risk = lots * mLP * adjust / (0.01 * equity);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"PNL = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, lots);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "PNL = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, lots);
 
 
 	return risk;
@@ -4313,15 +4230,28 @@ double EasyTrade::caculateStrategyPNLOrder(OrderType type, double openPrice, dou
 
 double EasyTrade::caculateStrategyPNL(BOOL isIgnoredLockedProfit)
 {		
-	int i, adjust = 1;
-	double risk = 0;
+	const OpenPositions* pPositions = getOpenPositions();
+	double equity = pParams->accountInfo.equity;
+	double lotsAtPrice, risk;
 
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
+	if (pPositions == NULL || getOpenPositionsLots(pPositions) == 0)
+		return 0;
+
+	if ((int)pParams->settings[DISABLE_COMPOUNDING] == TRUE)
 	{
-		if (pParams->orderInfo[i].ticket != 0 && pParams->orderInfo[i].isOpen)		
-			risk = risk + caculateStrategyPNLOrder(pParams->orderInfo[i].type, pParams->orderInfo[i].openPrice, pParams->orderInfo[i].lots, isIgnoredLockedProfit);
+		equity = pParams->settings[ORIGINAL_EQUITY];
 	}
 
+	// maxLossPerLot() is proportional to the distance, so all the orders are valued with the loss of a price move of 1.
+	risk = getOpenPositionsPNL(pPositions, pParams->bidAsk.bid[0], pParams->bidAsk.ask[0], maxLossPerLot(pParams, BUY, pParams->bidAsk.ask[0], 1), isIgnoredLockedProfit, &lotsAtPrice);
+
+	// Orders opened at the current price are valued by maxLossPerLot() for a zero distance.
+	if (lotsAtPrice > 0)
+		risk += lotsAtPrice * maxLossPerLot(pParams, BUY, pParams->bidAsk.ask[0], 0);
+
+	risk = risk / (0.01 * equity);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "PNL = %lf, Equity = %lf", risk, equity);
+
 	return risk;
 }
 
@@ -4390,127 +4320,46 @@ int EasyTrade::getSamePricePendingNoTPOrders(double entryPrice, double limit)
 
 double EasyTrade::caculateStrategyVolRiskForNoTPOrders(double dailyATR)
 {
-	double mLP;
-	double equity = pParams->accountInfo.equity;
-	int i, adjust = 0;
-	double totalLoss = 0, risk = 0;
+	const OpenPositions* pPositions = getOpenPositions();
+	double mLP, risk;
 
-	if ((int)pParams->settings[DISABLE_COMPOUNDING] == TRUE)
-	{
-		equity = pParams->settings[ORIGINAL_EQUITY];
-	}
-
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 && pParams->orderInfo[i].isOpen && pParams->orderInfo[i].takeProfit == 0)
-		{
-			if (pParams->orderInfo[i].type == BUY)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss > 0)
-					adjust = -1;
-			}
-			if (pParams->orderInfo[i].type == SELL)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss < 0)
-					adjust = -1;
-			}
+	if (pPositions == NULL || pPositions->volatilityRiskLotsNoTP == 0)
+		return 0;
 
-			mLP = maxLossPerLot(pParams, pParams->orderInfo[i].type, pParams->orderInfo[i].openPrice, dailyATR);
+	mLP = maxLossPerLot(pParams, BUY, pParams->bidAsk.ask[0], dailyATR);
 
-			risk = risk + pParams->orderInfo[i].lots * mLP * adjust / (0.01 * pParams->accountInfo.equity);
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"VolRisk = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, pParams->orderInfo[i].lots);
-
-		}
-	}
+	risk = getOpenPositionsVolatilityRisk(pPositions, mLP, TRUE) / (0.01 * pParams->accountInfo.equity);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "VolRisk = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, pParams->accountInfo.equity, mLP, pPositions->volatilityRiskLotsNoTP);
 
 	return risk;
 }
 
 double EasyTrade::caculateStrategyVolRisk(double dailyATR)
 {	
-	double mLP;
-	double equity = pParams->accountInfo.equity;
-	int i, adjust = 0;
-	double totalLoss = 0, risk = 0;
-
-	if ((int)pParams->settings[DISABLE_COMPOUNDING] == TRUE)
-	{
-		equity = pParams->settings[ORIGINAL_EQUITY];
-	}
+	const OpenPositions* pPositions = getOpenPositions();
+	double mLP, risk;
 
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 && pParams->orderInfo[i].isOpen)
-		{
-			if (pParams->orderInfo[i].type == BUY)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss > 0)
-					adjust = -1;				
-			}
-			if (pParams->orderInfo[i].type == SELL)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss < 0)
-					adjust = -1;				
-			}
-
-			mLP = maxLossPerLot(pParams, pParams->orderInfo[i].type, pParams->orderInfo[i].openPrice, dailyATR);
+	if (pPositions == NULL || pPositions->volatilityRiskLots == 0)
+		return 0;
 
-			risk = risk + pParams->orderInfo[i].lots * mLP * adjust / (0.01 * pParams->accountInfo.equity);
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"VolRisk = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, pParams->orderInfo[i].lots);
+	mLP = maxLossPerLot(pParams, BUY, pParams->bidAsk.ask[0], dailyATR);
 
-		}
-	}
+	risk = getOpenPositionsVolatilityRisk(pPositions, mLP, FALSE) / (0.01 * pParams->accountInfo.equity);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "VolRisk = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, pParams->accountInfo.equity, mLP, pPositions->volatilityRiskLots);
 
 	return risk;
 }
 
 double EasyTrade::caculateStrategyRisk(BOOL isIgnoredLockedProfit)
 {
-	double mLP;
-	double equity = pParams->accountInfo.equity;
-	int i, adjust = 0;
-	double stopLoss, totalLoss = 0, risk = 0;
-	
-	if ((int)pParams->settings[DISABLE_COMPOUNDING] == TRUE)
-	{
-		equity = pParams->settings[ORIGINAL_EQUITY];
-	}
-	
-	for (i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
-	{
-		if (pParams->orderInfo[i].ticket != 0 && pParams->orderInfo[i].isOpen)
-		{
-			adjust = 0;
+	const OpenPositions* pPositions = getOpenPositions();
+	double risk;
 
- 			if (pParams->orderInfo[i].type == BUY)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss > 0)
-					adjust = -1;
-				else if (!isIgnoredLockedProfit)
-					adjust = 1;
-			}
-			if (pParams->orderInfo[i].type == SELL)
-			{
-				if (pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss < 0)
-					adjust = -1;
-				else if (!isIgnoredLockedProfit)
-					adjust = 1;
-			}
-
-			if (adjust == 0)
-				continue;
-
-			stopLoss = fabs(pParams->orderInfo[i].openPrice - pParams->orderInfo[i].stopLoss);			
-			if (stopLoss == 0)
-				mLP = 0;
-			else			
-				mLP = maxLossPerLot(pParams, pParams->orderInfo[i].type, pParams->orderInfo[i].openPrice, stopLoss);
-
-			risk = risk + pParams->orderInfo[i].lots * mLP * adjust / (0.01 * pParams->accountInfo.equity);
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Risk = %lf, Equity = %lf, maxLossPerLot =%lf,OrderSize = %lf", risk, equity, mLP, pParams->orderInfo[i].lots);
+	if (pPositions == NULL || getOpenPositionsLots(pPositions) == 0)
+		return 0;
 
-		}
-	}
+	risk = getOpenPositionsStopLossRisk(pPositions, maxLossPerLot(pParams, BUY, pParams->bidAsk.ask[0], 1), isIgnoredLockedProfit) / (0.01 * pParams->accountInfo.equity);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Risk = %lf, Equity = %lf", risk, pParams->accountInfo.equity);
 
 	return risk;
 }
@@ -5285,7 +5134,7 @@ AsirikuyReturnCode EasyTrade::validateCurrentTime(StrategyParams* pParams, int p
 	safe_gmtime(&timeInfo, currentTime);
 	safe_timeString(timeString, currentTime);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checking missing bars: current time = %s, adjusted local current time =%s", timeString, adjustedLocaltimeString);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checking missing bars: current time = %s, adjusted local current time =%s", timeString, adjustedLocaltimeString);
 	diff = (int)(difftime(adjustedLocalTime, currentTime) / 60);
 
 	if (diff < primary_tf)
@@ -5314,7 +5163,7 @@ void EasyTrade::printBarInfo(StrategyParams* pParams, int rate, char * currentTi
 	safe_gmtime(&barTimeInfo, currentBarTime);
 	safe_timeString(currentBarTimeString, currentBarTime);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", currentTimeString, rate, currentBarTimeString,
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", currentTimeString, rate, currentBarTimeString,
 		pParams->ratesBuffers->rates[rate].high[shift0Index],
 		pParams->ratesBuffers->rates[rate].low[shift0Index],
 		pParams->ratesBuffers->rates[rate].open[shift0Index],
@@ -5361,7 +5210,7 @@ AsirikuyReturnCode EasyTrade::validateDailyBars(StrategyParams* pParams, int pri
 	//	)
 	//	startHour = 1;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checking missing bars: Current daily bar matached: current time = %s, current daily time =%s", timeString, dailyTimeString);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checking missing bars: Current daily bar matached: current time = %s, current daily time =%s", timeString, dailyTimeString);
 	printBarInfo(pParams, daily_rate, timeString);
 
 	if (dailyTimeInfo.tm_yday == timeInfo.tm_yday  //&& dailyTimeInfo.tm_hour == startHour
@@ -5416,7 +5265,7 @@ AsirikuyReturnCode EasyTrade::validateHourlyBars(StrategyParams* pParams, int pr
 		}
 	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"checking missing bars: Current hourly bar matached: current time = %s, current hourly time =%s", timeString, hourlyTimeString);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "checking missing bars: Current hourly bar matached: current time = %s, current hourly time =%s", timeString, hourlyTimeString);
 	printBarInfo(pParams, hourly_rate, timeString);
 	if (strstr(pParams->tradeSymbol, "BTCUSD") != NULL || strstr(pParams->tradeSymbol, "ETHUSD") != NULL)
 	{
@@ -5497,7 +5346,7 @@ BOOL EasyTrade::validateSecondaryBarsGap(StrategyParams* pParams, time_t current
 		}
 	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"validateSecondaryBarsGap:current time = %s, current secondary time =%s weekend=%d,startHour=%d,diff=%d,secondary_tf=%d",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "validateSecondaryBarsGap:current time = %s, current secondary time =%s weekend=%d,startHour=%d,diff=%d,secondary_tf=%d",
 		timeString, secondaryTimeString, isWeekend(currentTime), startHour, diff, secondary_tf);
 
 	
@@ -5701,8 +5550,8 @@ AsirikuyReturnCode EasyTrade::validateSecondaryBars(StrategyParams* pParams, int
 	//if (primary_tf != secondary_tf)
 	{
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Checking missing bars:current time = %s, current secondary time =%s", timeString, secondaryTimeString);
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", timeString, secondary_rate, secondaryTimeString,
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Checking missing bars:current time = %s, current secondary time =%s", timeString, secondaryTimeString);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", timeString, secondary_rate, secondaryTimeString,
 			pParams->ratesBuffers->rates[secondary_rate].high[shiftSecondary0Index],
 			pParams->ratesBuffers->rates[secondary_rate].low[shiftSecondary0Index],
 			pParams->ratesBuffers->rates[secondary_rate].open[shiftSecondary0Index],
@@ -5728,8 +5577,8 @@ AsirikuyReturnCode EasyTrade::validateSecondaryBars(StrategyParams* pParams, int
 			safe_timeString(timeString, currentTime);
 			safe_timeString(secondaryTimeString, currentSeondaryTime);
 
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Checking missing bars:current time = %s, current secondary time =%s", timeString, secondaryTimeString);
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", timeString, secondary_rate, secondaryTimeString,
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Checking missing bars:current time = %s, current secondary time =%s", timeString, secondaryTimeString);
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "current time=%s checking rate %d current bar 0: time =%s high=%lf,low=%lf,open=%lf,close=%lf", timeString, secondary_rate, secondaryTimeString,
 				pParams->ratesBuffers->rates[secondary_rate].high[shiftSecondary0Index - 1],
 				pParams->ratesBuffers->rates[secondary_rate].low[shiftSecondary0Index - 1],
 				pParams->ratesBuffers->rates[secondary_rate].open[shiftSecondary0Index - 1],
@@ -302,6 +302,26 @@ double iBBandStop(int ratesArrayIndex, int bb_period, double bb_deviation, int *
 	return easyTradePtr->iBBandStop(ratesArrayIndex, bb_period, bb_deviation, signal, stopPrice,index);
 }
 
+AsirikuyReturnCode iMASeries(int type, int ratesArrayIndex, int period, int startShift, int count, double* pOutValues)
+{
+	return easyTradePtr->iMASeries(type, ratesArrayIndex, period, startShift, count, pOutValues);
+}
+
+AsirikuyReturnCode iMACDSeries(int ratesArrayIndex, int fastPeriod, int slowPeriod, int signalPeriod, int startShift, int count, double* pMacd, double* pMacdSignal, double* pMacdHist)
+{
+	return easyTradePtr->iMACDSeries(ratesArrayIndex, fastPeriod, slowPeriod, signalPeriod, startShift, count, pMacd, pMacdSignal, pMacdHist);
+}
+
+AsirikuyReturnCode iBBandsSeries(int type, int ratesArrayIndex, int bb_period, double bb_deviation, int startShift, int count, double* pUpperBand, double* pMiddleBand, double* pLowerBand)
+{
+	return easyTradePtr->iBBandsSeries(type, ratesArrayIndex, bb_period, bb_deviation, startShift, count, pUpperBand, pMiddleBand, pLowerBand);
+}
+
+AsirikuyReturnCode iAtrSeries(int ratesArrayIndex, int period, int startShift, int count, double* pOutValues)
+{
+	return easyTradePtr->iAtrSeries(ratesArrayIndex, period, startShift, count, pOutValues);
+}
+
 double iStdev(int ratesArrayIndex, int type, int period, int shift)
 {
   return easyTradePtr->iStdev(ratesArrayIndex, type, period, shift);
@@ -342,6 +362,11 @@ double iAtrSafeShiftZero(int period)
   return easyTradePtr->iAtrSafeShiftZero(period);
 }
 
+AsirikuyReturnCode getCurrentSessionBar(SessionType type, SessionBar* pOutBar)
+{
+  return easyTradePtr->getCurrentSessionBar(type, pOutBar);
+}
+
 double iAtrDailyByHourInterval(int period, int firstHour, int lastHour)
 {
   return easyTradePtr->iAtrDailyByHourInterval(period, firstHour, lastHour);
@@ -69,7 +69,10 @@ typedef struct asirikuyConfig_t
 {
   char            configFileName[MAX_FILE_PATH_CHARS];
   int             ratesBufferExtension;
+  BOOL            shareRatesBuffers;
   char            tempFileFolderPath[MAX_FILE_PATH_CHARS];
+  int             uiFileDumpInterval;
+  int             fileCacheCheckInterval;
   ConfigFilePaths configFilePaths;
   LoggingConfig   loggingConfig;
   NtpConfig       ntpConfig;
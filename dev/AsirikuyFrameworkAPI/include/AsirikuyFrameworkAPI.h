@@ -95,6 +95,33 @@ extern "C" {
   */
   void __stdcall deinitInstance(int instanceId);
 
+  /**
+  * Copies the daily equity series the equity log collected for an instance, oldest sample first.
+  * Only the newest maxSamples samples are copied if the series is longer.
+  *
+  * @param int instanceId
+  *   The ID of the instance.
+  *
+  * @param double* pOutTimes
+  *   Receives the time of each sample.
+  *
+  * @param double* pOutEquityMin
+  *   Receives the lowest equity of each day.
+  *
+  * @param double* pOutProfit
+  *   Receives the change of the lowest equity since the previous day.
+  *
+  * @param int maxSamples
+  *   Size of the arrays.
+  *
+  * @param int* pTotalSamples
+  *   Receives the number of samples in the series.
+  *
+  * @return int
+  *   The return value is an AsirikuyReturnCode enum cast to an int for compatibility reasons.
+  */
+  int __stdcall c_getEquitySeries(int instanceId, double* pOutTimes, double* pOutEquityMin, double* pOutProfit, int maxSamples, int* pTotalSamples);
+
   /**
   * Gets the framework version numbers.
   */
@@ -48,6 +48,12 @@
   #include "MQLDefines.h"
 #endif
 
+#include "TimeZoneOffsets.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
 * Copy MQL parameters into a StrategyParams structure
 *
@@ -83,7 +89,38 @@ AsirikuyReturnCode convertMqlParameters(
   StrategyResults* pMqlResults,
   StrategyParams*  pParams);
 
+/**
+* Convert the MQL rates arrays of an instance into its rates buffers.
+* Indexes that share rates with other instances are converted once per
+* tick and attached to the instance until detachSharedRates() is called.
+*
+* @param StrategyParams* pParams
+*   The instance parameters. The rates buffers are set on return.
+*
+* @return enum AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode convertRatesArrays(
+  MQLVersion      mqlVersion,
+  StrategyParams* pParams,
+  TZOffsets*      pTZOffsets,
+  MqlRatesInfo*   pMqlRatesInfo,
+  void*           pMqlRates_0,
+  void*           pMqlRates_1,
+  void*           pMqlRates_2,
+  void*           pMqlRates_3,
+  void*           pMqlRates_4,
+  void*           pMqlRates_5,
+  void*           pMqlRates_6,
+  void*           pMqlRates_7,
+  void*           pMqlRates_8,
+  void*           pMqlRates_9);
+
 AsirikuyReturnCode allocateOrderInfo(StrategyParams* pParams, int orderInfoArraySize);
 AsirikuyReturnCode freeOrderInfo(StrategyParams* pParams);
 
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif /* MQL_PARAMETERS_H_ */
\ No newline at end of file
@@ -52,6 +52,9 @@ extern "C" {
 * For example, if both values are set to 4 the trading week will start at
 * 04:00 on Monday and end at 19:00 on Friday.
 *
+* Also rebuilds the minute of the week and holiday bitmaps used to answer the
+* queries below without decomposing the time.
+*
 * @param int cropMondayHours
 *   The number of hours to crop from Monday morning.
 *
@@ -239,7 +239,7 @@ AsirikuyReturnCode parseConfigFile(AsirikuyConfig* pAsirikuyConfig)
 {
   AsirikuyReturnCode returnCode;
   FILE        *configFile;
-  mxml_node_t *rootNode = NULL, *ratesBufExtNode = NULL, *tempFileFolderPathNode = NULL;
+  mxml_node_t *rootNode = NULL, *ratesBufExtNode = NULL, *shareRatesBufNode = NULL, *tempFileFolderPathNode = NULL, *uiFileDumpIntervalNode = NULL, *fileCacheCheckIntervalNode = NULL;
   mxml_node_t *configPathsNode = NULL, *loggingNode = NULL, *ntpNode = NULL, *tradingWeekBoundariesNode = NULL;
 
   if(pAsirikuyConfig == NULL)
@@ -283,6 +283,12 @@ AsirikuyReturnCode parseConfigFile(AsirikuyConfig* pAsirikuyConfig)
     pAsirikuyConfig->ratesBufferExtension = atoi(ratesBufExtNode->child->value.opaque);
   }
 
+  shareRatesBufNode = mxmlFindElement(rootNode, rootNode, "ShareRatesBuffers", NULL, NULL, MXML_DESCEND);
+  if(shareRatesBufNode)
+  {
+    pAsirikuyConfig->shareRatesBuffers = (BOOL)atoi(shareRatesBufNode->child->value.opaque);
+  }
+
   tempFileFolderPathNode = mxmlFindElement(rootNode, rootNode, "TempFileFolderPath", NULL, NULL, MXML_DESCEND);
   if(!tempFileFolderPathNode)
   {
@@ -290,6 +296,18 @@ AsirikuyReturnCode parseConfigFile(AsirikuyConfig* pAsirikuyConfig)
   }
   strcpy(pAsirikuyConfig->tempFileFolderPath, tempFileFolderPathNode->child->value.opaque);
 
+  uiFileDumpIntervalNode = mxmlFindElement(rootNode, rootNode, "UIFileDumpInterval", NULL, NULL, MXML_DESCEND);
+  if(uiFileDumpIntervalNode)
+  {
+    pAsirikuyConfig->uiFileDumpInterval = atoi(uiFileDumpIntervalNode->child->value.opaque);
+  }
+
+  fileCacheCheckIntervalNode = mxmlFindElement(rootNode, rootNode, "FileCacheCheckInterval", NULL, NULL, MXML_DESCEND);
+  if(fileCacheCheckIntervalNode)
+  {
+    pAsirikuyConfig->fileCacheCheckInterval = atoi(fileCacheCheckIntervalNode->child->value.opaque);
+  }
+
   configPathsNode = mxmlFindElement(rootNode, rootNode, "ConfigPaths", NULL, NULL, MXML_DESCEND);
   if(!configPathsNode)
   {
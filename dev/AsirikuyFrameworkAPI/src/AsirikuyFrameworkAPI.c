@@ -47,10 +47,21 @@
 #include "Broker-tz.h"
 #include "TimeZoneOffsets.h"
 #include "ContiguousRatesCircBuf.h"
+#include "TickJournal.h"
+#include "BarRecorder.h"
+#include "StatusSegment.h"
+#include "FileCache.h"
+#include "WriteBehind.h"
+#include "AsyncLog.h"
+#include "SessionBars.h"
+#include "DerivedRates.h"
+#include "OrderHistoryIndex.h"
 #include "Logging.h"
 #include "EquityLog.h"
 #include "CriticalSection.h"
 #include "InstanceStates.h"
+#include "Base.h"
+#include "Screening.h"
 #include "NTPCWrapper.hpp"
 #include "TradingWeekBoundaries.h"
 
@@ -58,6 +69,10 @@
 
 const PAN_CHAR_T PANTHEIOS_FE_PROCESS_IDENTITY[] = PANTHEIOS_LITERAL_STRING("AsirikuyFramework");
 
+/* IDs of the instances between initInstance and deinitInstance. -1 marks a free slot. */
+static int gActiveInstances[MAX_INSTANCES];
+static int gTotalActiveInstances = 0;
+
 static void seedRand()
 {
 #if defined _WIN32 || defined _WIN64
@@ -82,6 +97,78 @@ static void sleepMilliseconds(int milliseconds)
 #endif
 }
 
+static void initActiveInstances()
+{
+  int i;
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    gActiveInstances[i] = -1;
+  }
+  gTotalActiveInstances = 0;
+}
+
+/* Called inside the critical section. Returns the slot holding instanceId, or a free slot if isCreated is TRUE. */
+static int findActiveInstance(int instanceId, BOOL isCreated)
+{
+  int i, freeIndex = -1;
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gActiveInstances[i] == instanceId)
+    {
+      return i;
+    }
+    if((freeIndex == -1) && (gActiveInstances[i] == -1))
+    {
+      freeIndex = i;
+    }
+  }
+
+  return isCreated ? freeIndex : -1;
+}
+
+/* Restarts the background threads if the last instance stopped them. */
+static void addActiveInstance(int instanceId)
+{
+  int index;
+
+  enterCriticalSection();
+  index = findActiveInstance(instanceId, TRUE);
+  if((index != -1) && (gActiveInstances[index] == -1))
+  {
+    gActiveInstances[index] = instanceId;
+    gTotalActiveInstances++;
+  }
+  startAsyncLog();
+  leaveCriticalSection();
+}
+
+/* Stops the background threads when the last instance goes away. They can't be joined from DllMain under the loader lock, so this is the last safe place to do it. */
+static void removeActiveInstance(int instanceId)
+{
+  int index;
+
+  enterCriticalSection();
+  index = findActiveInstance(instanceId, FALSE);
+  if(index == -1)
+  {
+    leaveCriticalSection();
+    return;
+  }
+
+  gActiveInstances[index] = -1;
+  gTotalActiveInstances--;
+  if(gTotalActiveInstances == 0)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Last instance deinitialized. Stopping background threads.");
+    stopWriteBehind();
+    closeEquityLog();
+    stopAsyncLog();
+  }
+  leaveCriticalSection();
+}
+
 static int initFramework(char* pAsirikuyConfig, char* pAccountName)
 {
   static BOOL initialized  = FALSE;
@@ -119,6 +206,9 @@ static int initFramework(char* pAsirikuyConfig, char* pAccountName)
   strcpy(config.configFileName, pAsirikuyConfig);
   config.loggingConfig.severityLevel = PANTHEIOS_SEV_NOTICE;
   config.ratesBufferExtension = DEFAULT_RATES_BUF_EXT;
+  config.shareRatesBuffers    = FALSE;
+  config.uiFileDumpInterval   = 0;
+  config.fileCacheCheckInterval = DEFAULT_FILE_CACHE_CHECK_MS;
   result = parseConfigFile(&config);
   if(result != SUCCESS)
   {
@@ -136,6 +226,8 @@ static int initFramework(char* pAsirikuyConfig, char* pAccountName)
   pantheios_init();
   pantheios_be_file_setFilePath((PAN_CHAR_T*)pantheiosLogPath, 0, 0, PANTHEIOS_BEID_ALL);
   pantheios_fe_simple_setSeverityCeiling(config.loggingConfig.severityLevel);
+  setAsyncLogSeverity(config.loggingConfig.severityLevel);
+  startAsyncLog();
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Pantheios initialized.");
 
   retCode = TA_Initialize();
@@ -160,6 +252,7 @@ static int initFramework(char* pAsirikuyConfig, char* pAccountName)
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Loaded broker timezone configuration.");
 
   setExtendedBufferSize(config.ratesBufferExtension);
+  setShareRatesBuffers(config.shareRatesBuffers);
   resetAllRatesBuffers();
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Rates buffers initialized.");
 
@@ -174,6 +267,8 @@ static int initFramework(char* pAsirikuyConfig, char* pAccountName)
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"NTPClient initialized.");
 
   setTempFileFolderPath(config.tempFileFolderPath);
+  setUserInterfaceFileDumpInterval(config.uiFileDumpInterval);
+  setFileCacheCheckInterval(config.fileCacheCheckInterval);
   setTradingWeekBoundaries(config.cropMondayHours, config.cropFridayHours);
 
   initialized  = TRUE;
@@ -190,7 +285,7 @@ static int initInstance(int instanceId, int isTesting, char* pAsirikuyConfig, ch
     return returnCode;
   }
 
-  closeEquityLog();
+  closeInstanceEquityLog(instanceId);
   resetInstanceBuffer(instanceId);
 
   if(isTesting)
@@ -202,6 +297,7 @@ static int initInstance(int instanceId, int isTesting, char* pAsirikuyConfig, ch
     loadInstanceState(instanceId);
   }
 
+  addActiveInstance(instanceId);
   pantheios_logprintf(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Initialized instance ID: %d.", instanceId);
 
   return returnCode;
@@ -246,8 +342,54 @@ extern "C" {
 
   void __stdcall deinitInstance(int instanceId)
   {
-    closeEquityLog();
+    closeInstanceEquityLog(instanceId);
+    closeInstanceTickJournal(instanceId);
+    closeInstanceBarRecorder(instanceId);
+    flushInstanceState(instanceId);
+    closeInstanceEntryBarLog(instanceId);
+    releaseInstanceStatus(instanceId);
+    releaseInstanceSessionTracker(instanceId);
+    releaseBaseSnapshot(instanceId);
+    releaseScreeningSnapshot(instanceId);
+    releaseInstanceOrderHistoryIndex(instanceId);
+    releaseInstanceDerivedRatesBuilders(instanceId);
     resetInstanceBuffer(instanceId);
+    removeActiveInstance(instanceId);
+  }
+
+  int __stdcall c_getEquitySeries(int instanceId, double* pOutTimes, double* pOutEquityMin, double* pOutProfit, int maxSamples, int* pTotalSamples)
+  {
+    EquitySample* pSamples;
+    AsirikuyReturnCode returnCode;
+    int i, copied;
+
+    if((pOutTimes == NULL) || (pOutEquityMin == NULL) || (pOutProfit == NULL) || (pTotalSamples == NULL))
+    {
+      return NULL_POINTER;
+    }
+
+    if(maxSamples <= 0)
+    {
+      return getEquitySeries(instanceId, NULL, 0, pTotalSamples);
+    }
+
+    pSamples = (EquitySample*)malloc(maxSamples * sizeof(EquitySample));
+    if(pSamples == NULL)
+    {
+      return INSUFFICIENT_MEMORY;
+    }
+
+    returnCode = getEquitySeries(instanceId, pSamples, maxSamples, pTotalSamples);
+    copied = (*pTotalSamples < maxSamples) ? *pTotalSamples : maxSamples;
+    for(i = 0; i < copied; i++)
+    {
+      pOutTimes[i]     = (double)pSamples[i].time;
+      pOutEquityMin[i] = pSamples[i].equityMin;
+      pOutProfit[i]    = pSamples[i].profit;
+    }
+
+    free(pSamples);
+    return returnCode;
   }
 
   void __stdcall getFrameworkVersion(int* pMajor, int* pMinor, int* pBugfix)
@@ -269,10 +411,12 @@ BOOL APIENTRY DllMain(HANDLE hModule, DWORD reasonForCall, LPVOID reserved)
   case DLL_PROCESS_ATTACH:
     {
       initCriticalSection();
+      initActiveInstances();
       break;
     }
   case DLL_PROCESS_DETACH:
     {
+      /* No locks or thread joins under the loader lock. The last deinitInstance already stopped the background threads. */
       deinitCriticalSection();
       break;
     }
@@ -300,11 +444,15 @@ void __attribute__ ((destructor)) unload(void);
 void load(void)
 {
   initCriticalSection();
+  initActiveInstances();
 }
 
 /* Called when the library is unloaded and before dlclose() returns */
 void unload(void)
 {
+  stopWriteBehind();
+  closeEquityLog();
+  stopAsyncLog();
   deinitCriticalSection();
 }
 
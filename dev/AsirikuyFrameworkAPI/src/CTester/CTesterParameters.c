@@ -37,6 +37,7 @@
  */
 
 #include "Precompiled.h"
+#include "AsyncLog.h"
 #include "ContiguousRatesCircBuf.h"
 #include "TimeZoneOffsets.h"
 #include "AsirikuyTime.h"
@@ -130,41 +131,41 @@ static AsirikuyReturnCode copyBarC(const CRates* pSource, Rates* pDest, int dest
   if(pDest->time)
   {
     pDest->time[destIndex] = getAdjustedBrokerTime(pSource->time, tzOffsets);
-    if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+    if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
     {
       char timeString[MAX_TIME_STRING_SIZE];
-      pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() time[%d] = %s", destIndex, safe_timeString(timeString, pDest->time[destIndex]));
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() time[%d] = %s", destIndex, safe_timeString(timeString, pDest->time[destIndex]));
     }
   }
 
   if(pDest->open)
   {
     pDest->open[destIndex] = pSource->open;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() open[%d] = %f", destIndex, pDest->open[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() open[%d] = %f", destIndex, pDest->open[destIndex]);
   }
 
   if(pDest->high)
   {
     pDest->high[destIndex] = pSource->high;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() high[%d] = %f", destIndex, pDest->high[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() high[%d] = %f", destIndex, pDest->high[destIndex]);
   }
 
   if(pDest->low)
   {
     pDest->low[destIndex] = pSource->low;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() low[%d] = %f", destIndex, pDest->low[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() low[%d] = %f", destIndex, pDest->low[destIndex]);
   }
 
   if(pDest->close)
   {
     pDest->close[destIndex] = pSource->close;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() close[%d] = %f", destIndex, pDest->close[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() close[%d] = %f", destIndex, pDest->close[destIndex]);
   }
 
   if(pDest->volume)
   {
     pDest->volume[destIndex] = pSource->volume;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() volume[%d] = %f", destIndex, pDest->volume[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() volume[%d] = %f", destIndex, pDest->volume[destIndex]);
   }
 
   return SUCCESS;
@@ -209,10 +210,10 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
       pDest->time[destIndex] = CTime;
     }
 
-    if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+    if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
     {
       char timeString[MAX_TIME_STRING_SIZE];
-      pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() time[%d] = %s", destIndex, safe_timeString(timeString, pDest->time[destIndex]));
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() time[%d] = %s", destIndex, safe_timeString(timeString, pDest->time[destIndex]));
     }
   }
 
@@ -222,7 +223,7 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
     {
       pDest->open[destIndex] = pSource->open;
     }
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() open[%d] = %lf", destIndex, pDest->open[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() open[%d] = %lf", destIndex, pDest->open[destIndex]);
   }
 
   if(pDest->high)
@@ -231,7 +232,7 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
     {
       pDest->high[destIndex] = pSource->high;
     }
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() high[%d] = %lf", destIndex, pDest->high[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() high[%d] = %lf", destIndex, pDest->high[destIndex]);
   }
 
   if(pDest->low)
@@ -240,7 +241,7 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
     {
       pDest->low[destIndex] = pSource->low;
     }
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() low[%d] = %lf", destIndex, pDest->low[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() low[%d] = %lf", destIndex, pDest->low[destIndex]);
   }
 
   if(pDest->close)
@@ -249,7 +250,7 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
     {
       pDest->close[destIndex] = pSource->close;
     }
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() close[%d] = %lf", destIndex, pDest->close[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() close[%d] = %lf", destIndex, pDest->close[destIndex]);
   }
 
   if(pDest->volume)
@@ -268,7 +269,7 @@ static AsirikuyReturnCode mergeBar(int instanceId, int ratesIndex, const CRates*
     }
     pOldTickVolume->oldTime[ratesIndex]   = CTime;
     pOldTickVolume->oldVolume[ratesIndex] = pSource->volume;
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"mergeBar() volume[%d] = %lf", destIndex, pDest->volume[destIndex]);
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "mergeBar() volume[%d] = %lf", destIndex, pDest->volume[destIndex]);
   }
 
   return SUCCESS;
@@ -287,7 +288,7 @@ static AsirikuyReturnCode reprocessConvertedBar(StrategyParams* pParams,int inst
     epochOffset = EPOCH_WEEK_OFFSET;
   }
   
-  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"reprocessConvertedBar() ratesIndex = %d, convertedRatesIndex = %d", ratesIndex, convertedRatesIndex);
+  ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "reprocessConvertedBar() ratesIndex = %d, convertedRatesIndex = %d", ratesIndex, convertedRatesIndex);
 
   returnCode = copyBarC(&pCRates[ratesBufferIndex], pConvertedRates, convertedRatesIndex, tzOffsets);
   if(returnCode != SUCCESS)
@@ -336,7 +337,7 @@ static AsirikuyReturnCode convertCurrentCBar(StrategyParams* pParams, TZOffsets*
 
    if (CTime0 < 0 || CTime1 < 0)
   {
-	   pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Discarding candle with invalid timestamp");
+	   ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Discarding candle with invalid timestamp");
 	  return SUCCESS;
   }
 
@@ -348,7 +349,7 @@ static AsirikuyReturnCode convertCurrentCBar(StrategyParams* pParams, TZOffsets*
 
   if (!isValidTradingTime(pParams,CTime0))
   {
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertCurrentCBar() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime0));
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "convertCurrentCBar() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime0));
     return SUCCESS;
   }
 
@@ -420,7 +421,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(StrategyParams* pParams, TZOffset
 
 	  CTime = getAdjustedBrokerTime(pCRates[CRatesBufferIndex].time, tzOffsets);
 
-      pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"fillEmptyRatesBuffer() Discarding unusuable bar. Bar time = %s", safe_timeString(timeString, CTime));
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "fillEmptyRatesBuffer() Discarding unusuable bar. Bar time = %s", safe_timeString(timeString, CTime));
     }
 
 	returnCode = copyBarC(&pCRates[CRatesBufferIndex], &pParams->ratesBuffers->rates[ratesIndex], convertedRatesBufferIndex, tzOffsets);
@@ -448,7 +449,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(StrategyParams* pParams, TZOffset
 
 	  CTime = getAdjustedBrokerTime(pCRates[CRatesBufferIndex].time, tzOffsets);
 
-      pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"fillEmptyRatesBuffer() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime));
+      ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "fillEmptyRatesBuffer() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime));
     }
 
     while((CRatesBufferIndex >= 0) && (((CTime + epochOffset) / TIME_FRAME_IN_SECONDS) == ((pParams->ratesBuffers->rates[ratesIndex].time[convertedRatesBufferIndex] + epochOffset) / TIME_FRAME_IN_SECONDS)))
@@ -475,7 +476,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(StrategyParams* pParams, TZOffset
           pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
           return SUCCESS;
         }
-        pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"fillEmptyRatesBuffer() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime));
+        ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "fillEmptyRatesBuffer() Discarding unusable bar. Bar time = %s", safe_timeString(timeString, CTime));
 		
 		CTime = getAdjustedBrokerTime(pCRates[CRatesBufferIndex].time, tzOffsets);
 	  }
@@ -492,12 +493,12 @@ AsirikuyReturnCode convertRatesArrayC(StrategyParams* pParams, TZOffsets* tzOffs
   {
     if(!pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull)
     {
-      pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertRatesArray() Filling empty rates buffer.");
+      ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "convertRatesArray() Filling empty rates buffer.");
       return fillEmptyRatesBuffer(pParams, tzOffsets, pCRatesInfo, pCRates, ratesIndex);
     }
     else
     {
-      pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertRatesArray() Converting new C bar.");
+      ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "convertRatesArray() Converting new C bar.");
       return convertCurrentCBar(pParams, tzOffsets, pCRatesInfo, pCRates, ratesIndex);
     }
   }
@@ -38,6 +38,7 @@
 
 #include "Precompiled.h"
 #include "MQLParameters.h"
+#include "AsyncLog.h"
 #include "ContiguousRatesCircBuf.h"
 #include "TimeZoneOffsets.h"
 #include "AsirikuyTime.h"
@@ -55,7 +56,7 @@ typedef struct oldTickVolume_t
 
 static AsirikuyReturnCode getOldTickVolume(int instanceId, OldTickVolume** ppOldTickVolume)
 {
-  static OldTickVolume oldTickVolume[MAX_INSTANCES];
+  static OldTickVolume oldTickVolume[MAX_INSTANCES + MAX_SHARED_RATES];
   static BOOL oldTickVolumeInitialized = FALSE;
 
   AsirikuyReturnCode returnCode = SUCCESS;
@@ -65,7 +66,7 @@ static AsirikuyReturnCode getOldTickVolume(int instanceId, OldTickVolume** ppOld
 
   if(!oldTickVolumeInitialized)
   {
-    for(i = 0; i < MAX_INSTANCES; i++)
+    for(i = 0; i < MAX_INSTANCES + MAX_SHARED_RATES; i++)
     {
       oldTickVolume[i].instanceId = -1;
 
@@ -80,7 +81,7 @@ static AsirikuyReturnCode getOldTickVolume(int instanceId, OldTickVolume** ppOld
     pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"getOldTickVolume() Initialized old tick volume.");
   }
 
-  for(i = 0; i < MAX_INSTANCES; i++)
+  for(i = 0; i < MAX_INSTANCES + MAX_SHARED_RATES; i++)
   {
     if((oldTickVolume[i].instanceId == -1) || (oldTickVolume[i].instanceId == instanceId))
     {
@@ -136,10 +137,10 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->time[destIndex] = getAdjustedBrokerTime(((Mql5Rates*)pSource)[sourceIndex].time, tzOffsets);
     }
-    if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+    if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
     {
       char timeString[MAX_TIME_STRING_SIZE];
-	  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() time[%d] = %s,ratesIndex=%d", destIndex, safe_timeString(timeString, pDest->time[destIndex]), ratesIndex);
+	  ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() time[%d] = %s,ratesIndex=%d", destIndex, safe_timeString(timeString, pDest->time[destIndex]), ratesIndex);
     }
   }
 
@@ -153,7 +154,7 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->open[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].open;
     }
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() open[%d] = %f,ratesIndex=%d", destIndex, pDest->open[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() open[%d] = %f,ratesIndex=%d", destIndex, pDest->open[destIndex], ratesIndex);
   }
 
   if(pDest->high)
@@ -166,7 +167,7 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->high[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].high;
     }
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() high[%d] = %f,ratesIndex=%d", destIndex, pDest->high[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() high[%d] = %f,ratesIndex=%d", destIndex, pDest->high[destIndex], ratesIndex);
   }
 
   if(pDest->low)
@@ -179,7 +180,7 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->low[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].low;
     }
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() low[%d] = %f,ratesIndex=%d", destIndex, pDest->low[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() low[%d] = %f,ratesIndex=%d", destIndex, pDest->low[destIndex], ratesIndex);
   }
 
   if(pDest->close)
@@ -192,7 +193,7 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->close[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].close;
     }
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() close[%d] = %f,ratesIndex=%d", destIndex, pDest->close[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() close[%d] = %f,ratesIndex=%d", destIndex, pDest->close[destIndex], ratesIndex);
   }
 
   if(pDest->volume)
@@ -205,7 +206,7 @@ static AsirikuyReturnCode copyBar(MQLVersion mqlVersion, const void* pSource, in
     {
       pDest->volume[destIndex] = (double)((Mql5Rates*)pSource)[sourceIndex].tick_volume;
     }
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"copyBar() volume[%d] = %f,ratesIndex=%d", destIndex, pDest->volume[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "copyBar() volume[%d] = %f,ratesIndex=%d", destIndex, pDest->volume[destIndex], ratesIndex);
   }
 
   return SUCCESS;
@@ -262,10 +263,10 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
       pDest->time[destIndex] = mqlTime;
     }
 
-    if(pantheios_fe_simple_getSeverityCeiling() >= PANTHEIOS_SEV_DEBUG)
+    if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
     {
       char timeString[MAX_TIME_STRING_SIZE];
-	  pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() time[%d] = %s,ratesIndex=%d", destIndex, safe_timeString(timeString, pDest->time[destIndex]), ratesIndex);
+	  ASIRIKUY_LOG_PRINTF(level, "mergeBar() time[%d] = %s,ratesIndex=%d", destIndex, safe_timeString(timeString, pDest->time[destIndex]), ratesIndex);
     }
   }
 
@@ -282,7 +283,7 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
         pDest->open[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].open;
       }
     }
-	pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() open[%d] = %lf,ratesIndex=%d", destIndex, pDest->open[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(level, "mergeBar() open[%d] = %lf,ratesIndex=%d", destIndex, pDest->open[destIndex], ratesIndex);
   }
 
   if(pDest->high)
@@ -302,7 +303,7 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
     {
       pDest->high[destIndex] = sourceHigh;
     }
-	pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() high[%d] = %lf,ratesIndex=%d", destIndex, pDest->high[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(level, "mergeBar() high[%d] = %lf,ratesIndex=%d", destIndex, pDest->high[destIndex], ratesIndex);
   }
 
   if(pDest->low)
@@ -322,7 +323,7 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
     {
       pDest->low[destIndex] = sourceLow;
     }
-	pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() low[%d] = %lf,ratesIndex=%d", destIndex, pDest->low[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(level, "mergeBar() low[%d] = %lf,ratesIndex=%d", destIndex, pDest->low[destIndex], ratesIndex);
   }
 
   if(pDest->close)
@@ -338,7 +339,7 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
         pDest->close[destIndex] = ((Mql5Rates*)pSource)[sourceIndex].close;
       }
     }
-	pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() close[%d] = %lf,ratesIndex=%d", destIndex, pDest->close[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(level, "mergeBar() close[%d] = %lf,ratesIndex=%d", destIndex, pDest->close[destIndex], ratesIndex);
   }
 
   if(pDest->volume)
@@ -368,7 +369,7 @@ static AsirikuyReturnCode mergeBar(MQLVersion mqlVersion, int instanceId, int ra
     }
     pOldTickVolume->oldTime[ratesIndex]   = mqlTime;
     pOldTickVolume->oldVolume[ratesIndex] = sourceVolume;
-	pantheios_logprintf(level, (PAN_CHAR_T*)"mergeBar() volume[%d] = %lf,ratesIndex=%d", destIndex, pDest->volume[destIndex], ratesIndex);
+	ASIRIKUY_LOG_PRINTF(level, "mergeBar() volume[%d] = %lf,ratesIndex=%d", destIndex, pDest->volume[destIndex], ratesIndex);
   }
 
   return SUCCESS;
@@ -387,7 +388,7 @@ static AsirikuyReturnCode reprocessConvertedBar(StrategyParams* pParams,MQLVersi
     epochOffset = EPOCH_WEEK_OFFSET;
   }
   
-  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"reprocessConvertedBar() ratesIndex = %d, convertedRatesIndex = %d", ratesIndex, convertedRatesIndex);
+  ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "reprocessConvertedBar() ratesIndex = %d, convertedRatesIndex = %d", ratesIndex, convertedRatesIndex);
 
   returnCode = copyBar(mqlVersion, pMqlRates, ratesBufferIndex, pConvertedRates, convertedRatesIndex, tzOffsets, ratesIndex);
   if(returnCode != SUCCESS)
@@ -430,16 +431,16 @@ static AsirikuyReturnCode reprocessConvertedBar(StrategyParams* pParams,MQLVersi
   return SUCCESS;
 }
 
-static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyParams* pParams, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
+static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyParams* pParams, RatesBuffers* pRatesBuffers, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
 {
-  const int TIME_FRAME_IN_SECONDS = SECONDS_PER_MINUTE * pParams->ratesBuffers->rates[ratesIndex].info.timeframe;
+  const int TIME_FRAME_IN_SECONDS = SECONDS_PER_MINUTE * pRatesBuffers->rates[ratesIndex].info.timeframe;
 
   AsirikuyReturnCode returnCode;
   char   timeString[MAX_TIME_STRING_SIZE];
   char   timeString2[MAX_TIME_STRING_SIZE], timeString3[MAX_TIME_STRING_SIZE];
   int    mqlShift0Index = (int)pMqlRatesInfo->ratesArraySize - 1;
   int    mqlShift1Index = (int)pMqlRatesInfo->ratesArraySize - 2;
-  int    convertedShift0Index = pParams->ratesBuffers->rates[ratesIndex].info.arraySize - 1;
+  int    convertedShift0Index = pRatesBuffers->rates[ratesIndex].info.arraySize - 1;
   time_t epochOffset   = 0;
   time_t mqlTime0, mqlTime1;
 
@@ -460,7 +461,7 @@ static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyPa
     return SUCCESS;
   }
 
-  if(pParams->ratesBuffers->rates[ratesIndex].info.timeframe == MINUTES_PER_WEEK)
+  if(pRatesBuffers->rates[ratesIndex].info.timeframe == MINUTES_PER_WEEK)
   {
     /* Offset the epoch to the beginning of the week */
     epochOffset += EPOCH_WEEK_OFFSET;
@@ -486,15 +487,15 @@ static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyPa
    
   //ʧȥʷhour bars,Ͳprevious daily bar. 
   if(  ((mqlTime0 + epochOffset) / TIME_FRAME_IN_SECONDS) > ((mqlTime1 + epochOffset) / TIME_FRAME_IN_SECONDS)
-    && (mqlTime0 != pParams->ratesBuffers->rates[ratesIndex].time[convertedShift0Index]))
+    && (mqlTime0 != pRatesBuffers->rates[ratesIndex].time[convertedShift0Index]))
   {  
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertCurrentMqlBar() Testing .... strategyID= %d,ratesIndex=%d,mqlShift0Index=%d, mqlTime0=%s,mqlShift1Index =%d,mqlTime1=%s,convertedShift0Index=%d,converted bar time=%s", (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, mqlShift0Index, safe_timeString(timeString, mqlTime0), mqlShift1Index, safe_timeString(timeString2, mqlTime1), convertedShift0Index, safe_timeString(timeString3, pParams->ratesBuffers->rates[ratesIndex].time[convertedShift0Index]));
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "convertCurrentMqlBar() Testing .... strategyID= %d,ratesIndex=%d,mqlShift0Index=%d, mqlTime0=%s,mqlShift1Index =%d,mqlTime1=%s,convertedShift0Index=%d,converted bar time=%s", (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, mqlShift0Index, safe_timeString(timeString, mqlTime0), mqlShift1Index, safe_timeString(timeString2, mqlTime1), convertedShift0Index, safe_timeString(timeString3, pRatesBuffers->rates[ratesIndex].time[convertedShift0Index]));
 
 	// ̬buffer
-    incrementRatesOffset((int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex);
+    incrementRatesOffset(pRatesBuffers->instanceId, ratesIndex);
 
 	// Add the latest one
-	returnCode = copyBar(mqlVersion, pMqlRates, mqlShift0Index, &pParams->ratesBuffers->rates[ratesIndex], convertedShift0Index, tzOffsets,ratesIndex);
+	returnCode = copyBar(mqlVersion, pMqlRates, mqlShift0Index, &pRatesBuffers->rates[ratesIndex], convertedShift0Index, tzOffsets,ratesIndex);
     if(returnCode != SUCCESS)
     {
       logAsirikuyError("convertCurrentMqlBar()", returnCode);
@@ -502,7 +503,7 @@ static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyPa
     }
 
 	//reprocess the second latest bar
-	returnCode = reprocessConvertedBar(pParams,mqlVersion, (int)pParams->settings[STRATEGY_INSTANCE_ID], pMqlRates, ratesIndex, mqlShift1Index, &pParams->ratesBuffers->rates[ratesIndex], (convertedShift0Index - 1), tzOffsets);
+	returnCode = reprocessConvertedBar(pParams,mqlVersion, pRatesBuffers->instanceId, pMqlRates, ratesIndex, mqlShift1Index, &pRatesBuffers->rates[ratesIndex], (convertedShift0Index - 1), tzOffsets);
     if(returnCode != SUCCESS)
     {
       logAsirikuyError("convertCurrentMqlBar()", returnCode);
@@ -513,7 +514,7 @@ static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyPa
   {
 	 // pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"convertCurrentMqlBar()-> mergebar() Testing .... strategyID= %d,ratesIndex=%d,mqlShift0Index=%d, convertedShift0Index=%d", (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, mqlShift0Index, convertedShift0Index);
 
-	  returnCode = mergeBar(mqlVersion, (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, pMqlRates, mqlShift0Index, &pParams->ratesBuffers->rates[ratesIndex], convertedShift0Index, tzOffsets);
+	  returnCode = mergeBar(mqlVersion, pRatesBuffers->instanceId, ratesIndex, pMqlRates, mqlShift0Index, &pRatesBuffers->rates[ratesIndex], convertedShift0Index, tzOffsets);
     if(returnCode != SUCCESS)
     {
       logAsirikuyError("convertCurrentMqlBar()", returnCode);
@@ -524,19 +525,19 @@ static AsirikuyReturnCode convertCurrentMqlBar(MQLVersion mqlVersion, StrategyPa
   return SUCCESS;
 }
 
-static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyParams* pParams, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
+static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyParams* pParams, RatesBuffers* pRatesBuffers, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
 {
-  const int TIME_FRAME_IN_SECONDS = SECONDS_PER_MINUTE * pParams->ratesBuffers->rates[ratesIndex].info.timeframe;
+  const int TIME_FRAME_IN_SECONDS = SECONDS_PER_MINUTE * pRatesBuffers->rates[ratesIndex].info.timeframe;
 
   AsirikuyReturnCode returnCode;
   char   timeString[MAX_TIME_STRING_SIZE] = "";
   char   timeString2[MAX_TIME_STRING_SIZE] = "";
   time_t mqlTime;
   time_t epochOffset            = 0;
-  int convertedRatesBufferIndex = pParams->ratesBuffers->rates[ratesIndex].info.arraySize - 1;
+  int convertedRatesBufferIndex = pRatesBuffers->rates[ratesIndex].info.arraySize - 1;
   int mqlRatesBufferIndex       = (int)pMqlRatesInfo->ratesArraySize - 1;
 
-  if(pParams->ratesBuffers->rates[ratesIndex].info.timeframe == MINUTES_PER_WEEK)
+  if(pRatesBuffers->rates[ratesIndex].info.timeframe == MINUTES_PER_WEEK)
   {
     /* Offset the epoch to the beginning of the week */
     epochOffset = EPOCH_WEEK_OFFSET;
@@ -557,7 +558,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
     {
       if(--mqlRatesBufferIndex < 0)
       {
-        pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+        pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
         return SUCCESS;
       }
 	  pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"fillEmptyRatesBuffer() Discarding unusuable bar. Bar time = %s", safe_timeString(timeString, mqlTime));
@@ -574,7 +575,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
 	}
 	
 	// Copy current bar
-	returnCode = copyBar(mqlVersion, pMqlRates, mqlRatesBufferIndex, &pParams->ratesBuffers->rates[ratesIndex], convertedRatesBufferIndex, tzOffsets, ratesIndex);
+	returnCode = copyBar(mqlVersion, pMqlRates, mqlRatesBufferIndex, &pRatesBuffers->rates[ratesIndex], convertedRatesBufferIndex, tzOffsets, ratesIndex);
     if(returnCode != SUCCESS)
     {
       logAsirikuyError("fillEmptyRatesBuffer()", returnCode);
@@ -584,7 +585,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
 	// Move to previous bar
     if(--mqlRatesBufferIndex < 0)
     {
-      pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+      pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
       return SUCCESS;
     }
 
@@ -601,7 +602,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
     {
       if(--mqlRatesBufferIndex < 0)
       {
-        pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+        pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
         return SUCCESS;
       }
 
@@ -616,13 +617,13 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
 			mqlTime = getAdjustedBrokerTime(((Mql5Rates*)pMqlRates)[mqlRatesBufferIndex].time, tzOffsets);
 		}
 	}
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Testing.... strategyID= %d,ratesIndex=%d,  mqlRatesBufferIndex =%d, mqlTime=%s, converted bar time=%s", (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex,mqlRatesBufferIndex, safe_timeString(timeString, mqlTime), safe_timeString(timeString2, pParams->ratesBuffers->rates[ratesIndex].time[convertedRatesBufferIndex]));
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Testing.... strategyID= %d,ratesIndex=%d,  mqlRatesBufferIndex =%d, mqlTime=%s, converted bar time=%s", (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex,mqlRatesBufferIndex, safe_timeString(timeString, mqlTime), safe_timeString(timeString2, pRatesBuffers->rates[ratesIndex].time[convertedRatesBufferIndex]));
 
-    while((mqlRatesBufferIndex >= 0) && (((mqlTime + epochOffset) / TIME_FRAME_IN_SECONDS) == ((pParams->ratesBuffers->rates[ratesIndex].time[convertedRatesBufferIndex] + epochOffset) / TIME_FRAME_IN_SECONDS)))
+    while((mqlRatesBufferIndex >= 0) && (((mqlTime + epochOffset) / TIME_FRAME_IN_SECONDS) == ((pRatesBuffers->rates[ratesIndex].time[convertedRatesBufferIndex] + epochOffset) / TIME_FRAME_IN_SECONDS)))
     {
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"fillEmptyRatesBuffer() mergebar.....strategyID =%d, Bar time = %s, ratesIndex=%d, mqlRatesBufferIndex=%d,convertedRatesBufferIndex=%d", (int)pParams->settings[STRATEGY_INSTANCE_ID], safe_timeString(timeString, mqlTime), ratesIndex, mqlRatesBufferIndex, convertedRatesBufferIndex);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "fillEmptyRatesBuffer() mergebar.....strategyID =%d, Bar time = %s, ratesIndex=%d, mqlRatesBufferIndex=%d,convertedRatesBufferIndex=%d", (int)pParams->settings[STRATEGY_INSTANCE_ID], safe_timeString(timeString, mqlTime), ratesIndex, mqlRatesBufferIndex, convertedRatesBufferIndex);
 
-      returnCode = mergeBar(mqlVersion, (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, pMqlRates, mqlRatesBufferIndex, &pParams->ratesBuffers->rates[ratesIndex], convertedRatesBufferIndex, tzOffsets);
+      returnCode = mergeBar(mqlVersion, pRatesBuffers->instanceId, ratesIndex, pMqlRates, mqlRatesBufferIndex, &pRatesBuffers->rates[ratesIndex], convertedRatesBufferIndex, tzOffsets);
       if(returnCode != SUCCESS)
       {
         logAsirikuyError("fillEmptyRatesBuffer()", returnCode);
@@ -631,7 +632,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
       
       if(--mqlRatesBufferIndex < 0)
       {
-        pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+        pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
         return SUCCESS;
       }
 
@@ -648,7 +649,7 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
       {
         if(--mqlRatesBufferIndex < 0)
         {
-          pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+          pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
           return SUCCESS;
         }
 
@@ -666,29 +667,80 @@ static AsirikuyReturnCode fillEmptyRatesBuffer(MQLVersion mqlVersion, StrategyPa
     }
   }
 
-  pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
+  pRatesBuffers->rates[ratesIndex].info.isBufferFull = TRUE;
   return SUCCESS;
 }
 
-AsirikuyReturnCode convertRatesArray(MQLVersion mqlVersion, StrategyParams* pParams, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
+AsirikuyReturnCode convertRatesArray(MQLVersion mqlVersion, StrategyParams* pParams, RatesBuffers* pRatesBuffers, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, void* pMqlRates, int ratesIndex)
 {
-  if(pMqlRatesInfo->isEnabled && pParams->ratesBuffers->rates[ratesIndex].info.isEnabled)
+  if(pMqlRatesInfo->isEnabled && pRatesBuffers->rates[ratesIndex].info.isEnabled)
   {
-    if(!pParams->ratesBuffers->rates[ratesIndex].info.isBufferFull)
+    if(!pRatesBuffers->rates[ratesIndex].info.isBufferFull)
     {
-      pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertRatesArray() Filling empty rates buffer.");
-      return fillEmptyRatesBuffer(mqlVersion, pParams, tzOffsets, pMqlRatesInfo, pMqlRates, ratesIndex);
+      ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "convertRatesArray() Filling empty rates buffer.");
+      return fillEmptyRatesBuffer(mqlVersion, pParams, pRatesBuffers, tzOffsets, pMqlRatesInfo, pMqlRates, ratesIndex);
     }
     else
     {
-      pantheios_logputs(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"convertRatesArray() Converting new MQL4 bar.");
-      return convertCurrentMqlBar(mqlVersion, pParams, tzOffsets, pMqlRatesInfo, pMqlRates, ratesIndex);
+      ASIRIKUY_LOG_PUTS(PANTHEIOS_SEV_DEBUG, "convertRatesArray() Converting new MQL4 bar.");
+      return convertCurrentMqlBar(mqlVersion, pParams, pRatesBuffers, tzOffsets, pMqlRatesInfo, pMqlRates, ratesIndex);
     }
   }
 
   return SUCCESS;
 }
 
+static AsirikuyReturnCode convertSharedRatesArray(MQLVersion mqlVersion, StrategyParams* pParams, TZOffsets* tzOffsets, MqlRatesInfo* pMqlRatesInfo, RatesInfo* pRatesInfo, void* pMqlRates, int ratesIndex)
+{
+  AsirikuyReturnCode returnCode;
+  SharedRatesKey key;
+  RatesBuffers*  pSharedBuffers;
+  int    sharedRatesId, sharedRatesIndex;
+  int    mqlShift0Index = (int)pMqlRatesInfo->ratesArraySize - 1;
+  time_t sourceTime;
+  double sourceClose, sourceVolume;
+
+  memset(&key, 0, sizeof(SharedRatesKey));
+  strncpy(key.symbol, pParams->tradeSymbol, MAX_SHARED_RATES_KEY_CHARS - 1);
+  strncpy(key.timeZones, pParams->accountInfo.brokerName, MAX_SHARED_RATES_KEY_CHARS / 2 - 1);
+  strcat(key.timeZones, "|");
+  strncat(key.timeZones, pParams->accountInfo.referenceName, MAX_SHARED_RATES_KEY_CHARS / 2 - 1);
+  key.sourceTimeframe = (int)pMqlRatesInfo->actualTimeframe;
+  key.timeframe       = pRatesInfo->timeframe;
+  key.arraySize       = pRatesInfo->arraySize;
+
+  returnCode = acquireSharedRates((int)pParams->settings[STRATEGY_INSTANCE_ID], ratesIndex, &key, pRatesInfo, &sharedRatesId);
+  if(returnCode != SUCCESS)
+  {
+    logAsirikuyError("convertSharedRatesArray()", returnCode);
+    return returnCode;
+  }
+
+  if(mqlVersion == MQL4)
+  {
+    sourceTime   = ((Mql4Rates*)pMqlRates)[mqlShift0Index].time;
+    sourceClose  = ((Mql4Rates*)pMqlRates)[mqlShift0Index].close;
+    sourceVolume = ((Mql4Rates*)pMqlRates)[mqlShift0Index].volume;
+  }
+  else
+  {
+    sourceTime   = ((Mql5Rates*)pMqlRates)[mqlShift0Index].time;
+    sourceClose  = ((Mql5Rates*)pMqlRates)[mqlShift0Index].close;
+    sourceVolume = (double)((Mql5Rates*)pMqlRates)[mqlShift0Index].tick_volume;
+  }
+
+  /* Every instance on the same chart passes the same tick. Only the first one converts it. */
+  if(!beginSharedRatesUpdate(sharedRatesId, sourceTime, sourceClose, sourceVolume, &pSharedBuffers, &sharedRatesIndex))
+  {
+    return SUCCESS;
+  }
+
+  returnCode = convertRatesArray(mqlVersion, pParams, pSharedBuffers, tzOffsets, pMqlRatesInfo, pMqlRates, sharedRatesIndex);
+  endSharedRatesUpdate(sharedRatesId);
+
+  return returnCode;
+}
+
 AsirikuyReturnCode convertRatesArrays(
   MQLVersion      mqlVersion,
   StrategyParams* pParams, 
@@ -705,9 +757,12 @@ AsirikuyReturnCode convertRatesArrays(
   void*           pMqlRates_8,
   void*           pMqlRates_9)
 {
-  AsirikuyReturnCode result;
-  RatesInfo ratesInfo[MAX_RATES_BUFFERS];
-  int i;
+  AsirikuyReturnCode result = SUCCESS;
+  RatesInfo ratesInfo[MAX_RATES_BUFFERS], sharedRatesInfo[MAX_RATES_BUFFERS];
+  BOOL  isShared[MAX_RATES_BUFFERS], isAnyShared = FALSE;
+  void* pMqlRates[MAX_RATES_BUFFERS] = {pMqlRates_0, pMqlRates_1, pMqlRates_2, pMqlRates_3, pMqlRates_4, pMqlRates_5, pMqlRates_6, pMqlRates_7, pMqlRates_8, pMqlRates_9};
+  int   instanceId = (int)pParams->settings[STRATEGY_INSTANCE_ID];
+  int   i;
 
   /* Copy the rates info */
   for(i = 0; i < MAX_RATES_BUFFERS; i++)
@@ -737,112 +792,46 @@ AsirikuyReturnCode convertRatesArrays(
 	  ratesInfo[i].digits       = (int)pMqlRatesInfo[i].digits;
   }
 
+  /* Shared indexes are converted into shared rates and only borrowed by the instance while it runs. */
+  for(i = 0; i < MAX_RATES_BUFFERS; i++)
+  {
+    sharedRatesInfo[i]       = ratesInfo[i];
+    isShared[i]              = ratesInfo[i].isEnabled && isShareRatesBuffersEnabled() && !(BOOL)pParams->settings[IS_BACKTESTING];
+    ratesInfo[i].isEnabled  &= !isShared[i];
+    isAnyShared             |= isShared[i];
+  }
+
   /* Allocate memory for all rates data */
-  result = allocateRates(&pParams->ratesBuffers, (int)pParams->settings[STRATEGY_INSTANCE_ID], ratesInfo);
+  result = allocateRates(&pParams->ratesBuffers, instanceId, ratesInfo);
   if(result != SUCCESS)
   {
     logAsirikuyError("convertRatesArrays()", result);
     return result;
   }
 
-  if(pParams->ratesBuffers->rates[0].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[0], pMqlRates_0, 0);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index0 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[1].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[1], pMqlRates_1, 1);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index1 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[2].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[2], pMqlRates_2, 2);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index2 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[3].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[3], pMqlRates_3, 3);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index3 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[4].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[4], pMqlRates_4, 4);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index4 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[5].info.isEnabled)
+  for(i = 0; i < MAX_RATES_BUFFERS; i++)
   {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[5], pMqlRates_5, 5);
-    if(result != SUCCESS)
+    if(isShared[i])
     {
-      logAsirikuyError("convertRatesArrays() index5 ", result);
-      return result;
+      result = convertSharedRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[i], &sharedRatesInfo[i], pMqlRates[i], i);
     }
-  }
-
-  if(pParams->ratesBuffers->rates[6].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[6], pMqlRates_6, 6);
-    if(result != SUCCESS)
+    else if(pParams->ratesBuffers->rates[i].info.isEnabled)
     {
-      logAsirikuyError("convertRatesArrays() index6 ", result);
-      return result;
+      result = convertRatesArray(mqlVersion, pParams, pParams->ratesBuffers, pTZOffsets, &pMqlRatesInfo[i], pMqlRates[i], i);
     }
-  }
 
-  if(pParams->ratesBuffers->rates[7].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[7], pMqlRates_7, 7);
     if(result != SUCCESS)
     {
-      logAsirikuyError("convertRatesArrays() index7 ", result);
+      pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"convertRatesArrays() failed to convert rates index %d", i);
+      logAsirikuyError("convertRatesArrays()", result);
       return result;
     }
   }
 
-  if(pParams->ratesBuffers->rates[8].info.isEnabled)
+  /* Views are attached only after every shared conversion released its write lock. */
+  if(isAnyShared)
   {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[8], pMqlRates_8, 8);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index8 ", result);
-      return result;
-    }
-  }
-
-  if(pParams->ratesBuffers->rates[9].info.isEnabled)
-  {
-    result = convertRatesArray(mqlVersion, pParams, pTZOffsets, &pMqlRatesInfo[9], pMqlRates_9, 9);
-    if(result != SUCCESS)
-    {
-      logAsirikuyError("convertRatesArrays() index9 ", result);
-      return result;
-    }
+    return attachSharedRates(instanceId);
   }
 
   return SUCCESS;
@@ -212,6 +212,9 @@ extern "C" {
       result = runStrategy(&params);
     }
 
+    /* Shared rates stay read locked from their conversion until the strategy is done with them. */
+    detachSharedRates((int)pInSettings[STRATEGY_INSTANCE_ID]);
+
     if(result != SUCCESS)
     {
       logAsirikuyError("mql_runStrategy()", (AsirikuyReturnCode)result);
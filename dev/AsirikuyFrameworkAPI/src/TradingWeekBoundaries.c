@@ -36,15 +36,77 @@
 
 #include "Precompiled.h"
 #include "TradingWeekBoundaries.h"
+#include "AsyncLog.h"
 #include "AsirikuyTime.h"
+#include "Calendar.h"
+
+#define CALENDAR_WORD_BITS      32
+#define WEEK_BITMAP_WORDS       ((MINUTES_PER_WEEK + CALENDAR_WORD_BITS - 1) / CALENDAR_WORD_BITS)
+#define HOLIDAY_FIRST_YEAR      1970
+#define HOLIDAY_LAST_YEAR       2105
+#define HOLIDAY_TOTAL_DAYS      49673 /* Days from 01/01/1970 to 31/12/2105 inclusive. */
+#define HOLIDAY_BITMAP_WORDS    ((HOLIDAY_TOTAL_DAYS + CALENDAR_WORD_BITS - 1) / CALENDAR_WORD_BITS)
+#define CHRISTMAS_DAY_OF_YEAR   358   /* Zero based day of the year of December 25th in a non leap year. */
+
+#define CALENDAR_TEST_BIT(bitmap, index) (((bitmap)[(index) / CALENDAR_WORD_BITS] >> ((index) % CALENDAR_WORD_BITS)) & 1)
+#define CALENDAR_SET_BIT(bitmap, index)  ((bitmap)[(index) / CALENDAR_WORD_BITS] |= ((uint32_t)1 << ((index) % CALENDAR_WORD_BITS)))
 
 static int gCropMondayHours = 4;
 static int gCropFridayHours = 4;
 
+/* Broker times are passed in, so one calendar serves every instance. Bit n of the week bitmap
+ * is minute n of the week counted from Sunday 00:00. Bit n of the holiday bitmap is day n since the unix epoch. */
+static BOOL     gCalendarBuilt = FALSE;
+static uint32_t gOutsideWeekBitmap[WEEK_BITMAP_WORDS];
+static uint32_t gHolidayBitmap[HOLIDAY_BITMAP_WORDS];
+
+static int minuteOfWeek(time_t time)
+{
+  time_t minutes = time / SECONDS_PER_MINUTE;
+  int    minute;
+
+  if((time % SECONDS_PER_MINUTE) < 0)
+  {
+    minutes--;
+  }
+
+  minute = (int)((minutes + (time_t)THURSDAY * MINUTES_PER_DAY) % MINUTES_PER_WEEK);
+  return (minute < 0) ? minute + MINUTES_PER_WEEK : minute;
+}
+
+static void buildTradingCalendar()
+{
+  int minute, year, dayNumber = 0;
+
+  memset(gOutsideWeekBitmap, 0, sizeof(gOutsideWeekBitmap));
+  for(minute = 0; minute < MINUTES_PER_WEEK; minute++)
+  {
+    int dayOfWeek = minute / MINUTES_PER_DAY;
+    int hour      = (minute % MINUTES_PER_DAY) / MINUTES_PER_HOUR;
+
+    if(((dayOfWeek == MONDAY) && (hour < gCropMondayHours)) || ((dayOfWeek == FRIDAY) && (hour > (23 - gCropFridayHours))))
+    {
+      CALENDAR_SET_BIT(gOutsideWeekBitmap, minute);
+    }
+  }
+
+  memset(gHolidayBitmap, 0, sizeof(gHolidayBitmap));
+  for(year = HOLIDAY_FIRST_YEAR; year <= HOLIDAY_LAST_YEAR; year++)
+  {
+    /* New Years Day and Christmas Day */
+    CALENDAR_SET_BIT(gHolidayBitmap, dayNumber);
+    CALENDAR_SET_BIT(gHolidayBitmap, dayNumber + CHRISTMAS_DAY_OF_YEAR + LEAPYEAR(year));
+    dayNumber += YEARSIZE(year);
+  }
+
+  gCalendarBuilt = TRUE;
+}
+
 void setTradingWeekBoundaries(int cropMondayHours, int cropFridayHours)
 {
   gCropMondayHours = cropMondayHours;
   gCropFridayHours = cropFridayHours;
+  buildTradingCalendar();
 }
 
 BOOL isWeekend(time_t time)
@@ -57,25 +119,15 @@ BOOL isWeekend(time_t time)
 
 BOOL isOutsideTradingBoundaries(StrategyParams* pParams,time_t time)
 {
-	struct tm * timeStructure;
-	char       timeString[MAX_TIME_STRING_SIZE] = "";
-	int   startHour = 0;
+	char timeString[MAX_TIME_STRING_SIZE] = "";
+	int  startHour = 0;
 
 	//if (strstr(pParams->tradeSymbol, "XAU") != NULL)
 	//	startHour = 1;
 
-#if defined _MSC_VER
-	timeStructure = gmtime(&time);
-#else
-	struct tm temp;
-	timeStructure = gmtime_r(&time, &temp);
-#endif
-
-	safe_timeString(timeString, time);
-
-	if (timeStructure->tm_hour < startHour  )
+	if ((minuteOfWeek(time) % MINUTES_PER_DAY) / MINUTES_PER_HOUR < startHour)
 	{
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"isOutsideTradingBoundaries() PassedDate = %s", timeString);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "isOutsideTradingBoundaries() PassedDate = %s", safe_timeString(timeString, time));
 		return TRUE;
 	}
 
@@ -85,51 +137,38 @@ BOOL isOutsideTradingBoundaries(StrategyParams* pParams,time_t time)
 
 BOOL isOutsideTradingWeekBoundaries(time_t time)
 {
-	struct tm * timeStructure;
-	char       timeString[MAX_TIME_STRING_SIZE] = "";
-
-	#if defined _MSC_VER
-		timeStructure = gmtime(&time);
-	#else
-		struct tm temp;
-		timeStructure = gmtime_r(&time, &temp);
-	#endif
-
-	safe_timeString(timeString, time);
-
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"isOutsideTradingWeekBoundaries() PassedDate = %s Day of week: %d, Hour: %d", timeString, timeStructure->tm_wday, timeStructure->tm_hour);
-
-	if((timeStructure->tm_wday == MONDAY) && (timeStructure->tm_hour < gCropMondayHours))
-  {
-		return TRUE;
-  }
- 
-	if((timeStructure->tm_wday == FRIDAY) && (timeStructure->tm_hour > (23 - gCropFridayHours)))
-  {
-		return TRUE;
-  }
+	if(!gCalendarBuilt)
+	{
+		buildTradingCalendar();
+	}
 
-	return FALSE;
+	return (BOOL)CALENDAR_TEST_BIT(gOutsideWeekBitmap, minuteOfWeek(time));
 }
 
 BOOL isForexBrokerHoliday(time_t time)
 {
-  struct tm * timeStructure;
+  CalendarDay day;
+  time_t      dayNumber = time / SECONDS_PER_DAY;
 
-    #if defined _MSC_VER
-		timeStructure = gmtime(&time);
-	#else
-		struct tm temp;
-		timeStructure = gmtime_r(&time, &temp);
-	#endif
+  if((time >= 0) && (dayNumber < HOLIDAY_TOTAL_DAYS))
+  {
+    if(!gCalendarBuilt)
+    {
+      buildTradingCalendar();
+    }
+
+    return (BOOL)CALENDAR_TEST_BIT(gHolidayBitmap, dayNumber);
+  }
 
-	if((timeStructure->tm_mon == 11) && (timeStructure->tm_mday == 25))
+  getCalendarDay(&day, time);
+
+	if((day.month == 11) && (day.monthDay == 25))
   {
     /* Christmas Day */
 		return TRUE;
   }
  
-	if((timeStructure->tm_mon == 0) && (timeStructure->tm_mday == 1))
+	if((day.month == 0) && (day.monthDay == 1))
   {
     /* New Years Day */
 		return TRUE;
@@ -141,6 +180,10 @@ BOOL isForexBrokerHoliday(time_t time)
 BOOL isValidTradingTime(StrategyParams* pParams,time_t time)
 {
 	//return !(isWeekend(time) || isForexBrokerHoliday(time) || isOutsideTradingBoundaries(pParams,time));
-	return !(isWeekend(time) || isForexBrokerHoliday(time) || isOutsideTradingBoundaries(pParams, time)) || (isWeekend(time) 
-		&& (strstr(pParams->tradeSymbol, "BTCUSD") != NULL || strstr(pParams->tradeSymbol, "ETHUSD") != NULL));
-}
\ No newline at end of file
+	if(isWeekend(time))
+	{
+		return (strstr(pParams->tradeSymbol, "BTCUSD") != NULL || strstr(pParams->tradeSymbol, "ETHUSD") != NULL);
+	}
+
+	return !(isForexBrokerHoliday(time) || isOutsideTradingBoundaries(pParams, time));
+}
@@ -39,7 +39,10 @@
 #endif
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <stdio.h>
+#include <time.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
@@ -49,6 +52,93 @@
 #include "MQLDefines.h"
 #include "AsirikuyConfig.h"
 #include "AsirikuyFrameworkAPI.h"
+#include "TradingWeekBoundaries.h"
+#include "MQLParameters.h"
+#include "ContiguousRatesCircBuf.h"
+#include "AsyncLog.h"
+
+namespace
+{
+  /* Reference implementations decomposing each time with gmtime, as the trading week functions used to. */
+  struct tm referenceTime(time_t time)
+  {
+    struct tm timeInfo;
+#if defined _MSC_VER
+    timeInfo = *gmtime(&time);
+#else
+    gmtime_r(&time, &timeInfo);
+#endif
+    return timeInfo;
+  }
+
+  bool referenceIsOutsideTradingWeekBoundaries(time_t time, int cropMondayHours, int cropFridayHours)
+  {
+    struct tm timeInfo = referenceTime(time);
+    return ((timeInfo.tm_wday == MONDAY) && (timeInfo.tm_hour < cropMondayHours))
+      || ((timeInfo.tm_wday == FRIDAY) && (timeInfo.tm_hour > (23 - cropFridayHours)));
+  }
+
+  bool referenceIsForexBrokerHoliday(time_t time)
+  {
+    struct tm timeInfo = referenceTime(time);
+    return ((timeInfo.tm_mon == 11) && (timeInfo.tm_mday == 25)) || ((timeInfo.tm_mon == 0) && (timeInfo.tm_mday == 1));
+  }
+
+  bool referenceIsWeekend(time_t time)
+  {
+    struct tm timeInfo = referenceTime(time);
+    return (timeInfo.tm_wday == SATURDAY) || (timeInfo.tm_wday == SUNDAY);
+  }
+
+  const time_t CALENDAR_TEST_START = 946684800;  /* 01/01/2000 00:00 */
+  const time_t CALENDAR_TEST_END   = 1924992000; /* 01/01/2031 00:00 */
+
+  /* Hourly source bars skip weekends, as a broker chart does. */
+  unsigned int nextHourlyBarTime(unsigned int time)
+  {
+    do
+    {
+      time += SECONDS_PER_HOUR;
+    } while(referenceIsWeekend((time_t)time));
+
+    return time;
+  }
+
+  /* Feeds one MQL4 chart to every instance for each tick and returns the CPU seconds spent converting it.
+   * The chart is a window sliding over mqlRates, so starting a new bar copies nothing. */
+  double convertTicks(int beginTick, int endTick, int ticksPerBar, std::vector<Mql4Rates>& mqlRates, MqlRatesInfo* pMqlRatesInfo, TZOffsets* pTZOffsets, std::vector<StrategyParams>& params)
+  {
+    const int SOURCE_BARS = (int)pMqlRatesInfo->ratesArraySize;
+    int       failures    = 0;
+    clock_t   begin       = clock();
+
+    for(int tick = beginTick; tick < endTick; tick++)
+    {
+      int        lastBar = tick / ticksPerBar + SOURCE_BARS - 1;
+      Mql4Rates* pLast   = &mqlRates[lastBar];
+
+      if((tick > 0) && (tick % ticksPerBar == 0))
+      {
+        pLast->open   = pLast->high = pLast->low = pLast->close = mqlRates[lastBar - 1].close;
+        pLast->volume = 0;
+      }
+
+      pLast->close  += (tick & 1) ? 0.0002 : -0.0001;
+      pLast->high    = (pLast->close > pLast->high) ? pLast->close : pLast->high;
+      pLast->low     = (pLast->close < pLast->low) ? pLast->close : pLast->low;
+      pLast->volume += 1;
+
+      for(size_t instance = 0; instance < params.size(); instance++)
+      {
+        failures += (convertRatesArrays(MQL4, &params[instance], pTZOffsets, pMqlRatesInfo, &mqlRates[lastBar - SOURCE_BARS + 1], NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) != SUCCESS);
+        detachSharedRates((int)params[instance].settings[STRATEGY_INSTANCE_ID]);
+      }
+    }
+
+    BOOST_CHECK_EQUAL(failures, 0);
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+  }
+}
 
 BOOST_AUTO_TEST_SUITE(Asirikuy_Framework_API)
 
@@ -82,4 +172,142 @@ BOOST_AUTO_TEST_CASE(parseConfigFile_spaces_forwardslashes)
   //BOOST_CHECK(result == SUCCESS);
 }
 
+BOOST_AUTO_TEST_CASE(tradingCalendar_everyMinuteMatchesGmtime)
+{
+  char symbol[] = "EURUSD";
+  char cryptoSymbol[] = "BTCUSD";
+  StrategyParams params, cryptoParams;
+  params.tradeSymbol = symbol;
+  cryptoParams.tradeSymbol = cryptoSymbol;
+
+  setTradingWeekBoundaries(4, 4);
+
+  int mismatches = 0;
+  for(time_t time = CALENDAR_TEST_START; time < CALENDAR_TEST_END; time += SECONDS_PER_MINUTE)
+  {
+    bool weekend = referenceIsWeekend(time);
+    bool holiday = referenceIsForexBrokerHoliday(time);
+
+    if(((isOutsideTradingWeekBoundaries(time) != FALSE) != referenceIsOutsideTradingWeekBoundaries(time, 4, 4))
+      || ((isForexBrokerHoliday(time) != FALSE) != holiday)
+      || ((isWeekend(time) != FALSE) != weekend)
+      || ((isValidTradingTime(&params, time) != FALSE) != !(weekend || holiday))
+      || ((isValidTradingTime(&cryptoParams, time) != FALSE) != (weekend || !holiday)))
+    {
+      mismatches++;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(mismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(tradingCalendar_cropHoursRebuildBitmap)
+{
+  const int cropHours[][2] = {{0, 0}, {1, 6}, {6, 1}, {24, 24}};
+
+  for(size_t i = 0; i < sizeof(cropHours) / sizeof(cropHours[0]); i++)
+  {
+    setTradingWeekBoundaries(cropHours[i][0], cropHours[i][1]);
+
+    int mismatches = 0;
+    for(time_t time = CALENDAR_TEST_START; time < CALENDAR_TEST_END; time += 17 * SECONDS_PER_MINUTE)
+    {
+      if((isOutsideTradingWeekBoundaries(time) != FALSE) != referenceIsOutsideTradingWeekBoundaries(time, cropHours[i][0], cropHours[i][1]))
+      {
+        mismatches++;
+      }
+    }
+
+    BOOST_CHECK_EQUAL(mismatches, 0);
+  }
+
+  setTradingWeekBoundaries(4, 4);
+}
+
+BOOST_AUTO_TEST_CASE(convertRatesArrays_sharedRatesCpu)
+{
+  const int TOTAL_INSTANCES = 50;
+  const int TOTAL_BARS      = 1000;
+  const int SOURCE_BARS     = 1300;
+  const int TOTAL_TICKS     = 20000;
+  const int TICKS_PER_BAR[] = { 10, 1 };
+
+  char symbol[] = "EURUSD", brokerName[] = "Broker", referenceName[] = "Reference";
+  std::vector<double>         settings(TOTAL_INSTANCES * (ORDERINFO_ARRAY_SIZE + 1), 0);
+  std::vector<StrategyParams> params(TOTAL_INSTANCES);
+  std::vector<Mql4Rates>      initialRates(SOURCE_BARS + TOTAL_TICKS);
+  MqlRatesInfo mqlRatesInfo[MAX_RATES_BUFFERS];
+  TZOffsets*   pTZOffsets = new TZOffsets();
+  int          logSeverity = gAsyncLogSeverity;
+
+  /* Time the conversions at a live logging level rather than with every DEBUG line formatted. */
+  setAsyncLogSeverity(PANTHEIOS_SEV_WARNING);
+  memset(mqlRatesInfo, 0, sizeof(mqlRatesInfo));
+  mqlRatesInfo[0].isEnabled         = 1;
+  mqlRatesInfo[0].requiredTimeframe = 60;
+  mqlRatesInfo[0].totalBarsRequired = TOTAL_BARS;
+  mqlRatesInfo[0].actualTimeframe   = 60;
+  mqlRatesInfo[0].ratesArraySize    = SOURCE_BARS;
+  mqlRatesInfo[0].point             = 0.00001;
+  mqlRatesInfo[0].digits            = 5;
+
+  for(size_t bar = 0; bar < initialRates.size(); bar++)
+  {
+    initialRates[bar].time   = (bar > 0) ? nextHourlyBarTime(initialRates[bar - 1].time) : 1262563200; /* 04/01/2010 00:00 */
+    initialRates[bar].open   = initialRates[bar].close = 1.4 + bar * 0.00001;
+    initialRates[bar].high   = initialRates[bar].open + 0.001;
+    initialRates[bar].low    = initialRates[bar].open - 0.001;
+    initialRates[bar].volume = 1;
+  }
+
+  for(int instance = 0; instance < TOTAL_INSTANCES; instance++)
+  {
+    memset(&params[instance], 0, sizeof(StrategyParams));
+    params[instance].settings                       = &settings[instance * (ORDERINFO_ARRAY_SIZE + 1)];
+    params[instance].settings[STRATEGY_INSTANCE_ID] = 1000 + instance;
+    params[instance].tradeSymbol                    = symbol;
+    params[instance].accountInfo.brokerName         = brokerName;
+    params[instance].accountInfo.referenceName      = referenceName;
+  }
+
+  for(size_t i = 0; i < sizeof(TICKS_PER_BAR) / sizeof(TICKS_PER_BAR[0]); i++)
+  {
+    std::vector<Mql4Rates> mqlRates;
+    std::vector<double>    privateClose;
+    double privateFillSeconds, privateSeconds, sharedFillSeconds, sharedSeconds;
+
+    /* Before: every instance converts each tick into its own rates. */
+    mqlRates = initialRates;
+    resetAllRatesBuffers();
+    setShareRatesBuffers(FALSE);
+    privateFillSeconds = convertTicks(0, 1, TICKS_PER_BAR[i], mqlRates, mqlRatesInfo, pTZOffsets, params);
+    privateSeconds = convertTicks(1, TOTAL_TICKS + 1, TICKS_PER_BAR[i], mqlRates, mqlRatesInfo, pTZOffsets, params);
+    privateClose.assign(params[0].ratesBuffers->rates[0].close, params[0].ratesBuffers->rates[0].close + TOTAL_BARS);
+    BOOST_CHECK_EQUAL(privateClose.back(), mqlRates[TOTAL_TICKS / TICKS_PER_BAR[i] + SOURCE_BARS - 1].close);
+
+    /* After: the first instance converts each tick into the shared rates and the others attach them. */
+    mqlRates = initialRates;
+    resetAllRatesBuffers();
+    setShareRatesBuffers(TRUE);
+    sharedFillSeconds = convertTicks(0, 1, TICKS_PER_BAR[i], mqlRates, mqlRatesInfo, pTZOffsets, params);
+    sharedSeconds = convertTicks(1, TOTAL_TICKS + 1, TICKS_PER_BAR[i], mqlRates, mqlRatesInfo, pTZOffsets, params);
+
+    for(int instance = 0; instance < TOTAL_INSTANCES; instance++)
+    {
+      BOOST_REQUIRE_EQUAL(attachSharedRates(1000 + instance), SUCCESS);
+      BOOST_CHECK(std::equal(privateClose.begin(), privateClose.end(), params[instance].ratesBuffers->rates[0].close));
+      detachSharedRates(1000 + instance);
+    }
+
+    BOOST_TEST_MESSAGE("CPU for " << TOTAL_INSTANCES << " instances with " << TICKS_PER_BAR[i] << " ticks per bar: "
+      << privateFillSeconds * 1e6 << " us private, " << sharedFillSeconds * 1e6 << " us shared to fill the buffers, "
+      << privateSeconds * 1e6 / TOTAL_TICKS << " us private, " << sharedSeconds * 1e6 / TOTAL_TICKS << " us shared per tick");
+  }
+
+  setShareRatesBuffers(FALSE);
+  resetAllRatesBuffers();
+  setAsyncLogSeverity(logSeverity);
+  delete pTZOffsets;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -56,4 +56,12 @@
   #include "PriceAction.h"
 #endif
 
+#ifndef ROLLING_EXTREMUM_H_
+  #include "RollingExtremum.h"
+#endif
+
+#ifndef SIMD_KERNELS_H_
+  #include "SimdKernels.h"
+#endif
+
 #endif /* ASIRIKUY_TECHNICAL_ANALYSIS_H_ */
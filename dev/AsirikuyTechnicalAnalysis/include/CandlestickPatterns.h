@@ -49,6 +49,21 @@
 extern "C" {
 #endif
 
+/* Bits of the pattern masks returned by scanCandlestickPatterns, one per detect function. */
+typedef enum candlestickPattern_t
+{
+  PATTERN_THREE_BLACK_CROWS    = 1 << 0,
+  PATTERN_THREE_WHITE_SOLDIERS = 1 << 1,
+  PATTERN_HANGING_MAN          = 1 << 2,
+  PATTERN_HAMMER               = 1 << 3,
+  PATTERN_BEARISH_ENGULFING    = 1 << 4,
+  PATTERN_BULLISH_ENGULFING    = 1 << 5,
+  PATTERN_BEARISH_RAPID_TP     = 1 << 6,
+  PATTERN_BULLISH_RAPID_TP     = 1 << 7,
+  PATTERN_DARK_CLOUD_COVER     = 1 << 8,
+  PATTERN_PIERCING             = 1 << 9
+} CandlestickPattern;
+
 /**
 * A customized version of the Three Black Crows pattern.
 *
@@ -347,6 +362,45 @@ BOOL detectDarkCloudCover(double atrMultiplier, double atr, const double* pOpen,
 */
 BOOL detectPiercing(double atrMultiplier, double atr, const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int arraySize);
 
+/**
+* Evaluates every candlestick pattern above on a range of bars in one pass.
+*
+* The body and range of each bar are computed once with the SIMD kernels and shared by all the patterns.
+* Bit p of pOutPatterns[i - first] is set when the detect function of pattern p would return true with bar i as
+* its most recent closed bar, i.e. when called with arraySize = i + 2.
+*
+* @param double atrMultiplier
+*   The configurable multiplier of the average true range.
+*
+* @param double atr
+*   The average true range.
+*
+* @param const double* pOpen
+*   Array of bar opening prices. open[0] is the oldest bar.
+*
+* @param const double* pHigh
+*   Array of bar highs. high[0] is the oldest bar.
+*
+* @param const double* pLow
+*   Array of bar lows. low[0] is the oldest bar.
+*
+* @param const double* pClose
+*   Array of bar closing prices. close[0] is the oldest bar.
+*
+* @param int first
+*   Index of the oldest bar to evaluate. Patterns that need bars before index 0 are never set.
+*
+* @param int last
+*   Index of the most recent bar to evaluate.
+*
+* @param unsigned int* pOutPatterns
+*   Receives last - first + 1 masks of CandlestickPattern bits.
+*
+* @return AsirikuyReturnCode
+*   An error code or SUCCESS.
+*/
+AsirikuyReturnCode scanCandlestickPatterns(double atrMultiplier, double atr, const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, unsigned int* pOutPatterns);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
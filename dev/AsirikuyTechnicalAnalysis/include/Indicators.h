@@ -100,6 +100,7 @@ AsirikuyReturnCode calculateKeltnerChannels(const double* pHigh, const double* p
 * Bars to Previous time.
 *
 * Calculates the number of bars in a time series to reach a certain past time
+* Bar open times must be in ascending order. The search is a binary search so the cost is O(log n).
 *
 * @param const time_t* barOpenTimes
 *   Array containing time data for opening of bars.
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief     Rolling minimum and maximum over a sliding window of bars.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef ROLLING_EXTREMUM_H_
+#define ROLLING_EXTREMUM_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A monotonic deque of the bars which can still become the extremum of the window. 
+ * Each bar is added and removed once so a window of any period costs O(1) per bar. */
+typedef struct rollingExtremum_t
+{
+  int     period;
+  BOOL    isMaximum;
+  int*    pIndexes; /* Ring buffer of period candidates, oldest at front */
+  double* pValues;
+  int     front;
+  int     count;
+} RollingExtremum;
+
+/**
+* Allocates a rolling minimum or maximum.
+*
+* @param RollingExtremum* pExtremum
+*   The rolling extremum to initialize.
+*
+* @param int period
+*   The number of bars in the window.
+*
+* @param BOOL isMaximum
+*   TRUE to track the maximum, FALSE to track the minimum.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode initRollingExtremum(RollingExtremum* pExtremum, int period, BOOL isMaximum);
+
+/**
+* Frees a rolling extremum.
+*
+* @param RollingExtremum* pExtremum
+*   The rolling extremum to free.
+*/
+void freeRollingExtremum(RollingExtremum* pExtremum);
+
+/**
+* Empties the window of a rolling extremum.
+*
+* @param RollingExtremum* pExtremum
+*   The rolling extremum to reset.
+*/
+void resetRollingExtremum(RollingExtremum* pExtremum);
+
+/**
+* Adds the next bar to the window and drops the bars which fall out of it.
+*
+* @param RollingExtremum* pExtremum
+*   The rolling extremum.
+*
+* @param int index
+*   Index of the bar. Must be larger than the index of the previous bar added.
+*
+* @param double value
+*   The price of the bar.
+*/
+void pushRollingExtremum(RollingExtremum* pExtremum, int index, double value);
+
+/**
+* Returns the index of the extremum of the window. When several bars share the extreme value the most recent one is returned.
+*
+* @param const RollingExtremum* pExtremum
+*   The rolling extremum. At least one bar must have been added.
+*
+* @return int
+*   The bar index.
+*/
+int getRollingExtremumIndex(const RollingExtremum* pExtremum);
+
+/**
+* Returns the extreme value of the window.
+*
+* @param const RollingExtremum* pExtremum
+*   The rolling extremum. At least one bar must have been added.
+*
+* @return double
+*   The minimum or maximum price.
+*/
+double getRollingExtremumValue(const RollingExtremum* pExtremum);
+
+/**
+* Fills arrays with the rolling minimum or maximum of a price array.
+* Element i covers the bars i - period + 1 to i. The first period - 1 elements cover the bars available.
+*
+* @param const double* pPrice
+*   Array of prices. pPrice[0] is the oldest bar.
+*
+* @param int arraySize
+*   The size of the price array.
+*
+* @param int period
+*   The number of bars in the window.
+*
+* @param BOOL isMaximum
+*   TRUE for the rolling maximum, FALSE for the rolling minimum.
+*
+* @param double* pOutValues
+*   Receives arraySize extreme values. May be NULL.
+*
+* @param int* pOutIndexes
+*   Receives arraySize bar indexes of the extremes, the most recent one on ties. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   An enum indicating success or the type of failure that occured.
+*/
+AsirikuyReturnCode rollingExtremum(const double* pPrice, int arraySize, int period, BOOL isMaximum, double* pOutValues, int* pOutIndexes);
+
+/**
+* Finds the extremum of a single window of bars, scanning from the most recent bar.
+* The oldest bar of the window is the initial candidate, so it wins ties with later bars. Among the other bars the most recent one wins ties.
+*
+* @param const double* pPrice
+*   Array of prices. pPrice[0] is the oldest bar.
+*
+* @param int first
+*   Index of the oldest bar of the window. Bars before index 0 are skipped.
+*
+* @param int last
+*   Index of the most recent bar of the window.
+*
+* @param BOOL isMaximum
+*   TRUE to find the maximum, FALSE to find the minimum.
+*
+* @return int
+*   The bar index, or first if the window has no bar after it.
+*/
+int findExtremumIndex(const double* pPrice, int first, int last, BOOL isMaximum);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ROLLING_EXTREMUM_H_ */
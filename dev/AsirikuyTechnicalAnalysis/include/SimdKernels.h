@@ -0,0 +1,221 @@
+/**
+ * @file
+ * @brief     Vectorized kernels for the summations of the technical analysis loops.
+ * @details   Each kernel has a scalar reference plus SSE2 and AVX2 versions selected at runtime from the instruction sets the CPU reports.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef SIMD_KERNELS_H_
+#define SIMD_KERNELS_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum simdLevel_t
+{
+  SIMD_SCALAR = 0,
+  SIMD_SSE2   = 1,
+  SIMD_AVX2   = 2
+} SimdLevel;
+
+/**
+* Returns the widest instruction set the CPU and operating system support.
+*
+* @return SimdLevel
+*   The supported level. Always SIMD_SCALAR on non x86 processors.
+*/
+SimdLevel getSupportedSimdLevel();
+
+/**
+* Returns the instruction set the kernels currently use.
+*
+* @return SimdLevel
+*   The level in use. Defaults to the supported level.
+*/
+SimdLevel getSimdLevel();
+
+/**
+* Selects the instruction set of the kernels, e.g. SIMD_SCALAR to reproduce results bit for bit.
+* The vector versions add in a different order, so their sums may differ from the scalar ones in the last bits.
+*
+* @param SimdLevel level
+*   The requested level. Levels the CPU doesn't support fall back to the supported one.
+*
+* @return SimdLevel
+*   The level in use.
+*/
+SimdLevel setSimdLevel(SimdLevel level);
+
+/**
+* Adds pHigh[i] - pLow[i] for i from last down to first to a sum.
+*
+* @param const double* pHigh
+*   Array of high prices.
+*
+* @param const double* pLow
+*   Array of low prices.
+*
+* @param int first
+*   Index of the oldest bar.
+*
+* @param int last
+*   Index of the most recent bar.
+*
+* @param double sum
+*   The initial sum.
+*
+* @return double
+*   The sum.
+*/
+double sumRanges(const double* pHigh, const double* pLow, int first, int last, double sum);
+
+/**
+* Adds the typical prices (pHigh[i] + pLow[i] + pClose[i]) / 3 for i from last down to first to a sum.
+*
+* @param const double* pHigh
+*   Array of high prices.
+*
+* @param const double* pLow
+*   Array of low prices.
+*
+* @param const double* pClose
+*   Array of close prices.
+*
+* @param int first
+*   Index of the oldest bar.
+*
+* @param int last
+*   Index of the most recent bar.
+*
+* @param double sum
+*   The initial sum.
+*
+* @return double
+*   The sum.
+*/
+double sumTypicalPrices(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum);
+
+/**
+* Adds the buying pressures pClose[i] - min(pLow[i], pClose[i - 1]) for i from last down to first to a sum.
+*
+* @param const double* pLow
+*   Array of low prices.
+*
+* @param const double* pClose
+*   Array of close prices.
+*
+* @param int first
+*   Index of the oldest bar. Must be at least 1.
+*
+* @param int last
+*   Index of the most recent bar.
+*
+* @param double sum
+*   The initial sum.
+*
+* @return double
+*   The sum.
+*/
+double sumBuyingPressures(const double* pLow, const double* pClose, int first, int last, double sum);
+
+/**
+* Adds the values of an array from the first to the last one.
+*
+* @param const double* pValues
+*   The values.
+*
+* @param int count
+*   The number of values.
+*
+* @return double
+*   The sum.
+*/
+double sumValues(const double* pValues, int count);
+
+/**
+* Adds the squared deviations (pValues[i] - mean)^2 of an array from the first to the last one.
+*
+* @param const double* pValues
+*   The values.
+*
+* @param int count
+*   The number of values.
+*
+* @param double mean
+*   The mean the deviations are taken from.
+*
+* @return double
+*   The sum.
+*/
+double sumSquaredDeviations(const double* pValues, int count, double mean);
+
+/**
+* Computes the body fabs(pOpen[i] - pClose[i]) and range fabs(pHigh[i] - pLow[i]) of every bar from first to last.
+* Unlike the sums these are exact, so every level gives the same results.
+*
+* @param const double* pOpen
+*   Array of open prices.
+*
+* @param const double* pHigh
+*   Array of high prices.
+*
+* @param const double* pLow
+*   Array of low prices.
+*
+* @param const double* pClose
+*   Array of close prices.
+*
+* @param int first
+*   Index of the oldest bar.
+*
+* @param int last
+*   Index of the most recent bar.
+*
+* @param double* pOutBodies
+*   Receives the body of bar i at index i - first.
+*
+* @param double* pOutRanges
+*   Receives the range of bar i at index i - first.
+*/
+void computeBarMeasures(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SIMD_KERNELS_H_ */
@@ -42,6 +42,10 @@
 #include <float.h>
 
 #include "CandlestickPatterns.h"
+#include "SimdKernels.h"
+
+/* Bars whose measures are computed together. The two bars before the window are included for the three bar patterns. */
+#define SCAN_WINDOW 256
 
 
 BOOL detectThreeBlackCrows(double atrMultiplier, double atr, const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int arraySize)
@@ -528,4 +532,141 @@ BOOL detectPiercing(double atrMultiplier, double atr, const double* pOpen, const
     && (bar1Body >= atrCoefficient));
 
   return patternDetected;
-}
\ No newline at end of file
+}
+
+/* Mirrors the conditions of the detect functions with bar1 = i, bar2 = i - 1 and bar3 = i - 2. The measures of bar i are at index m of pBody and pRange. */
+static unsigned int evaluateCandlestickPatterns(double atrCoefficient, const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, const double* pBody, const double* pRange, int i, int m)
+{
+  unsigned int patterns = 0;
+  double       clampedBar1Body, bar2Median;
+
+  /* The single bar patterns guard against dividing by zero, the others use the raw body. */
+  clampedBar1Body = pBody[m];
+  if(clampedBar1Body < DBL_EPSILON) clampedBar1Body = DBL_EPSILON;
+
+  if(((pHigh[i] - pClose[i]) > atrCoefficient) && (pRange[m] / clampedBar1Body > 3))
+  {
+    patterns |= PATTERN_HANGING_MAN;
+  }
+
+  if(((pClose[i] - pLow[i]) > atrCoefficient) && (pRange[m] / clampedBar1Body > 3))
+  {
+    patterns |= PATTERN_HAMMER;
+  }
+
+  if(i < 1)
+  {
+    return patterns;
+  }
+
+  if((pOpen[i] > pClose[i - 1]) && (pClose[i] < pOpen[i - 1]) && (pOpen[i - 1] < pOpen[i]) && (pClose[i] < pClose[i - 1])
+    && ((pRange[m - 1] - pBody[m - 1]) < atrCoefficient) && ((pRange[m] - pBody[m]) < atrCoefficient) && ((pBody[m] - pBody[m - 1]) > atrCoefficient))
+  {
+    patterns |= PATTERN_BEARISH_ENGULFING;
+  }
+
+  if((pOpen[i] < pClose[i - 1]) && (pClose[i] > pOpen[i - 1]) && (pOpen[i - 1] > pOpen[i]) && (pClose[i] > pClose[i - 1])
+    && ((pRange[m - 1] - pBody[m - 1]) < atrCoefficient) && ((pRange[m] - pBody[m]) < atrCoefficient) && ((pBody[m] - pBody[m - 1]) > atrCoefficient))
+  {
+    patterns |= PATTERN_BULLISH_ENGULFING;
+  }
+
+  if((pClose[i] > pOpen[i]) && (pClose[i - 1] < pOpen[i - 1]) && (pBody[m] > atrCoefficient))
+  {
+    patterns |= PATTERN_BEARISH_RAPID_TP;
+  }
+
+  if((pClose[i] < pOpen[i]) && (pClose[i - 1] > pOpen[i - 1]) && (pBody[m] > atrCoefficient))
+  {
+    patterns |= PATTERN_BULLISH_RAPID_TP;
+  }
+
+  bar2Median = (pLow[i - 1] + pHigh[i - 1]) / 2;
+
+  if((pClose[i - 1] > pOpen[i - 1]) && (pOpen[i] > pClose[i]) && (pOpen[i] >= pClose[i - 1]) && (pClose[i] <= bar2Median) && (pBody[m] >= atrCoefficient))
+  {
+    patterns |= PATTERN_DARK_CLOUD_COVER;
+  }
+
+  if((pOpen[i - 1] > pClose[i - 1]) && (pClose[i] > pOpen[i]) && (pOpen[i] <= pClose[i - 1]) && (pClose[i] >= bar2Median) && (pBody[m] >= atrCoefficient))
+  {
+    patterns |= PATTERN_PIERCING;
+  }
+
+  if(i < 2)
+  {
+    return patterns;
+  }
+
+  if((pClose[i - 2] < pOpen[i - 2]) && (pClose[i - 1] < pOpen[i - 1]) && (pClose[i] < pOpen[i])
+    && (pBody[m - 1] > atrCoefficient) && (pBody[m] > atrCoefficient) && (pRange[m] / clampedBar1Body < 3))
+  {
+    patterns |= PATTERN_THREE_BLACK_CROWS;
+  }
+
+  if((pClose[i - 2] > pOpen[i - 2]) && (pClose[i - 1] > pOpen[i - 1]) && (pClose[i] > pOpen[i])
+    && (pBody[m - 1] > atrCoefficient) && (pBody[m] > atrCoefficient) && (pRange[m] / clampedBar1Body < 3))
+  {
+    patterns |= PATTERN_THREE_WHITE_SOLDIERS;
+  }
+
+  return patterns;
+}
+
+AsirikuyReturnCode scanCandlestickPatterns(double atrMultiplier, double atr, const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, unsigned int* pOutPatterns)
+{
+  double atrCoefficient = atr * atrMultiplier;
+  double bodies[SCAN_WINDOW + 2], ranges[SCAN_WINDOW + 2];
+  int    windowStart, windowEnd, measuresStart, i;
+
+  if(pOpen == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. pOpen = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pHigh == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. pHigh = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pLow == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. pLow = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pClose == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. pClose = NULL");
+    return NULL_POINTER;
+  }
+
+  if(pOutPatterns == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. pOutPatterns = NULL");
+    return NULL_POINTER;
+  }
+
+  if((first < 0) || (last < first))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"scanCandlestickPatterns() failed. first = %d, last = %d", first, last);
+    return INVALID_PARAMETER;
+  }
+
+  for(windowStart = first; windowStart <= last; windowStart += SCAN_WINDOW)
+  {
+    windowEnd     = (last - windowStart < SCAN_WINDOW) ? last : windowStart + SCAN_WINDOW - 1;
+    measuresStart = (windowStart < 2) ? 0 : windowStart - 2;
+
+    computeBarMeasures(pOpen, pHigh, pLow, pClose, measuresStart, windowEnd, bodies, ranges);
+
+    for(i = windowStart; i <= windowEnd; i++)
+    {
+      pOutPatterns[i - first] = evaluateCandlestickPatterns(atrCoefficient, pOpen, pHigh, pLow, pClose, bodies, ranges, i, i - measuresStart);
+    }
+  }
+
+  return SUCCESS;
+}
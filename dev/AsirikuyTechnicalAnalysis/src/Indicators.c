@@ -40,19 +40,14 @@
 #include "Precompiled.h"
 #include "Indicators.h"
 #include "MovingAverages.h"
+#include "SimdKernels.h"
 #include "Logging.h"
+#include "TimeIndex.h"
 
 AsirikuyReturnCode barsToPreviousTime(const time_t* barOpenTimes, time_t time, int shiftIndex, int* pOutBarNumber)
 {
-	int i = 0, barsToTime = 0;
-
-	while ( barOpenTimes[shiftIndex-i] > time)
-	{
-		i++;
-		barsToTime++;
-	}
-
-	*pOutBarNumber = barsToTime ;
+	/* Bar times are in ascending order so the bars newer than time form a suffix of [0, shiftIndex]. */
+	*pOutBarNumber = shiftIndex + 1 - searchTimeUpperBound(barOpenTimes, shiftIndex + 1, time);
 
 	return(SUCCESS);
 }
@@ -133,8 +128,8 @@ AsirikuyReturnCode calculateKeltnerChannels(const double* pHigh, const double* p
 AsirikuyReturnCode calculateUltimateOscillator(const double* pHigh, const double* pLow, const double* pClose, int arraySize, int fastPeriod, int middlePeriod, int slowPeriod, int fastK, int middleK, int slowK, int shift, double* pOutUltimateOscillator)
 {
   TA_RetCode retCode;
-  int i, outBegIdx, outNBElement, startIdx = arraySize - 1 - shift;
-  double rawUltimateOscillator, trueLow, fastMa = 0, middleMa = 0, slowMa = 0, fastAtr = 0, middleAtr = 0, slowAtr = 0;
+  int outBegIdx, outNBElement, startIdx = arraySize - 1 - shift;
+  double rawUltimateOscillator, fastMa = 0, middleMa = 0, slowMa = 0, fastAtr = 0, middleAtr = 0, slowAtr = 0;
 
   if(pHigh == NULL)
   {
@@ -187,42 +182,9 @@ AsirikuyReturnCode calculateUltimateOscillator(const double* pHigh, const double
     return TA_LIB_ERROR;
   }
 
-  for(i = startIdx; i > (startIdx - fastPeriod); i--)
-  {
-    trueLow = pLow[i];
-    if(pClose[i-1] < trueLow)
-    {
-      trueLow = pClose[i-1];
-    }
-
-    fastMa += pClose[i] - trueLow;
-  }
-
-  middleMa = fastMa;
-
-  for(; i > (startIdx - middlePeriod); i--)
-  {
-    trueLow = pLow[i];
-    if(pClose[i-1] < trueLow)
-    {
-      trueLow = pClose[i-1];
-    }
-
-    middleMa += pClose[i] - trueLow;
-  }
-
-  slowMa  = middleMa;
-
-  for(; i > (startIdx - slowPeriod); i--)
-  {
-    trueLow = pLow[i];
-    if(pClose[i-1] < trueLow)
-    {
-      trueLow = pClose[i-1];
-    }
-
-    slowMa += pClose[i] - trueLow;
-  }
+  fastMa   = sumBuyingPressures(pLow, pClose, startIdx - fastPeriod + 1, startIdx, 0);
+  middleMa = sumBuyingPressures(pLow, pClose, startIdx - middlePeriod + 1, startIdx - fastPeriod, fastMa);
+  slowMa   = sumBuyingPressures(pLow, pClose, startIdx - slowPeriod + 1, startIdx - middlePeriod, middleMa);
 
   fastMa   /= fastPeriod;
   middleMa /= middlePeriod;
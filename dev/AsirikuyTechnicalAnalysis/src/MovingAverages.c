@@ -38,11 +38,12 @@
 
 #include "Precompiled.h"
 #include "MovingAverages.h"
+#include "SimdKernels.h"
 #include "Logging.h"
 
 AsirikuyReturnCode calculateAverageRange(const double* pHigh, const double* pLow, int arraySize, int period, int shift, double* pOutAverageRange)
 {
-  int i, startIdx = arraySize - 1 - shift, endIdx = arraySize - 1 - shift - period;
+  int startIdx = arraySize - 1 - shift, endIdx = arraySize - 1 - shift - period;
   double sum = 0;
 
   if(pHigh == NULL)
@@ -75,10 +76,7 @@ AsirikuyReturnCode calculateAverageRange(const double* pHigh, const double* pLow
     return ZERO_DIVIDE;
   }
 
-  for(i = startIdx; i > endIdx; i--) 
-  {
-    sum += pHigh[i] - pLow[i];
-  }
+  sum = sumRanges(pHigh, pLow, endIdx + 1, startIdx, 0);
 
   *pOutAverageRange = sum / period;
 
@@ -87,7 +85,7 @@ AsirikuyReturnCode calculateAverageRange(const double* pHigh, const double* pLow
 
 AsirikuyReturnCode calculateAverageTypicalPrice(const double* pHigh, const double* pLow, const double* pClose, int arraySize, int period, int shift, double* pOutAverageTypicalPrice)
 {
-  int i, startIdx = arraySize - 1 - shift, endIdx = arraySize - 1 - shift - period;
+  int startIdx = arraySize - 1 - shift, endIdx = arraySize - 1 - shift - period;
   double sum = 0;
 
   if(pHigh == NULL)
@@ -127,10 +125,7 @@ AsirikuyReturnCode calculateAverageTypicalPrice(const double* pHigh, const doubl
 
   }
 
-  for(i = startIdx; i > endIdx; i--)
-  {
-    sum += (pHigh[i] + pLow[i] + pClose[i]) / 3;
-  }
+  sum = sumTypicalPrices(pHigh, pLow, pClose, endIdx + 1, startIdx, 0);
 
   *pOutAverageTypicalPrice = sum / period;
 
@@ -38,6 +38,7 @@
 
 #include "Precompiled.h"
 #include "PriceAction.h"
+#include "RollingExtremum.h"
 
 typedef enum strategy_t
 {
@@ -48,8 +49,6 @@ typedef enum strategy_t
 
 AsirikuyReturnCode minMaxIndex(const double* pPrice, int arraySize, int period, int shift, int* pOutMinIndex, int* pOutMaxIndex)
 {
-  int i;
-
   if(pPrice == NULL)
   {
     pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"minMaxIndex() failed. pPrice = NULL");
@@ -68,30 +67,16 @@ AsirikuyReturnCode minMaxIndex(const double* pPrice, int arraySize, int period,
     return NULL_POINTER;
   }
 
-  *pOutMinIndex = *pOutMaxIndex = arraySize - 1 - period - shift;
-
-  for(i = arraySize -1 - shift; (i > arraySize - 1 - period - shift) && (i >= 0); i--)
-  {
-    if(pPrice[i] < pPrice[*pOutMinIndex])
-    {
-      *pOutMinIndex = i;
-    }
+  *pOutMinIndex = findExtremumIndex(pPrice, arraySize - 1 - period - shift, arraySize - 1 - shift, FALSE);
+  *pOutMaxIndex = findExtremumIndex(pPrice, arraySize - 1 - period - shift, arraySize - 1 - shift, TRUE);
 
-    if(pPrice[i] > pPrice[*pOutMaxIndex])
-    {
-      *pOutMaxIndex = i;
-    }
-
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"minMaxIndex() arraySize = %d, period = %d, shift = %d, Index %d = %f", arraySize, period, shift, i, pPrice[i]);
-  }
+  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"minMaxIndex() arraySize = %d, period = %d, shift = %d, min index = %d, max index = %d", arraySize, period, shift, *pOutMinIndex, *pOutMaxIndex);
 
   return SUCCESS;
 }
 
 AsirikuyReturnCode minIndex(const double* pPrice, int arraySize, int period, int shift, int* pOutMinIndex)
 {
-  int i;
-
   if(pPrice == NULL)
   {
     pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"minIndex() failed. pPrice = NULL");
@@ -104,25 +89,15 @@ AsirikuyReturnCode minIndex(const double* pPrice, int arraySize, int period, int
     return NULL_POINTER;
   }
 
-  *pOutMinIndex = arraySize - 1 - period - shift;
+  *pOutMinIndex = findExtremumIndex(pPrice, arraySize - 1 - period - shift, arraySize - 1 - shift, FALSE);
 
-  for(i = arraySize -1 - shift; (i > arraySize - 1 - period - shift) && (i >= 0); i--)
-  {
-    if(pPrice[i] < pPrice[*pOutMinIndex])
-    {
-      *pOutMinIndex = i;
-    }
-
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"minIndex() arraySize = %d, period = %d, shift = %d, Index %d = %f", arraySize, period, shift, i, pPrice[i]);
-  }
+  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"minIndex() arraySize = %d, period = %d, shift = %d, min index = %d", arraySize, period, shift, *pOutMinIndex);
 
   return SUCCESS;
 }
 
 AsirikuyReturnCode maxIndex(const double* pPrice, int arraySize, int period, int shift, int* pOutMaxIndex)
 {
-  int i;
-
   if(pPrice == NULL)
   {
     pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"maxIndex() failed. pPrice = NULL");
@@ -135,17 +110,9 @@ AsirikuyReturnCode maxIndex(const double* pPrice, int arraySize, int period, int
     return NULL_POINTER;
   }
 
-  *pOutMaxIndex = arraySize - 1 - period - shift;
+  *pOutMaxIndex = findExtremumIndex(pPrice, arraySize - 1 - period - shift, arraySize - 1 - shift, TRUE);
 
-  for(i = arraySize -1 - shift; (i > arraySize - 1 - period - shift) && (i >= 0); i--)
-  {
-    if(pPrice[i] > pPrice[*pOutMaxIndex])
-    {
-      *pOutMaxIndex = i;
-    }
-
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"maxIndex() arraySize = %d, period = %d, shift = %d, Index %d = %f", arraySize, period, shift, i, pPrice[i]);
-  }
+  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"maxIndex() arraySize = %d, period = %d, shift = %d, max index = %d", arraySize, period, shift, *pOutMaxIndex);
 
   return SUCCESS;
 }
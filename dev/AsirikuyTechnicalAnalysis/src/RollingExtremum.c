@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @brief     Rolling minimum and maximum over a sliding window of bars.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "RollingExtremum.h"
+
+/* TRUE if a candidate with value a is dominated by a later bar with value b. */
+static BOOL isDominated(const RollingExtremum* pExtremum, double a, double b)
+{
+  return pExtremum->isMaximum ? (a <= b) : (a >= b);
+}
+
+AsirikuyReturnCode initRollingExtremum(RollingExtremum* pExtremum, int period, BOOL isMaximum)
+{
+  memset(pExtremum, 0, sizeof(RollingExtremum));
+
+  if(period < 1)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"initRollingExtremum() failed. Invalid period %d", period);
+    return INVALID_PARAMETER;
+  }
+
+  pExtremum->pIndexes = (int*)malloc(period * sizeof(int));
+  pExtremum->pValues  = (double*)malloc(period * sizeof(double));
+  if((pExtremum->pIndexes == NULL) || (pExtremum->pValues == NULL))
+  {
+    freeRollingExtremum(pExtremum);
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"initRollingExtremum() failed. Not enough memory");
+    return INSUFFICIENT_MEMORY;
+  }
+
+  pExtremum->period    = period;
+  pExtremum->isMaximum = isMaximum;
+  return SUCCESS;
+}
+
+void freeRollingExtremum(RollingExtremum* pExtremum)
+{
+  free(pExtremum->pIndexes);
+  free(pExtremum->pValues);
+  pExtremum->pIndexes = NULL;
+  pExtremum->pValues  = NULL;
+  pExtremum->front    = 0;
+  pExtremum->count    = 0;
+}
+
+void resetRollingExtremum(RollingExtremum* pExtremum)
+{
+  pExtremum->front = 0;
+  pExtremum->count = 0;
+}
+
+void pushRollingExtremum(RollingExtremum* pExtremum, int index, double value)
+{
+  int period = pExtremum->period;
+  int back;
+
+  /* Bars older than the window leave from the front. */
+  while((pExtremum->count > 0) && (pExtremum->pIndexes[pExtremum->front] <= index - period))
+  {
+    pExtremum->front = (pExtremum->front + 1 == period) ? 0 : pExtremum->front + 1;
+    pExtremum->count--;
+  }
+
+  /* Bars which can't be the extremum while the new bar is in the window leave from the back. */
+  while(pExtremum->count > 0)
+  {
+    back = pExtremum->front + pExtremum->count - 1;
+    if(back >= period)
+    {
+      back -= period;
+    }
+    if(!isDominated(pExtremum, pExtremum->pValues[back], value))
+    {
+      break;
+    }
+    pExtremum->count--;
+  }
+
+  back = pExtremum->front + pExtremum->count;
+  if(back >= period)
+  {
+    back -= period;
+  }
+  pExtremum->pIndexes[back] = index;
+  pExtremum->pValues[back]  = value;
+  pExtremum->count++;
+}
+
+int getRollingExtremumIndex(const RollingExtremum* pExtremum)
+{
+  return pExtremum->pIndexes[pExtremum->front];
+}
+
+double getRollingExtremumValue(const RollingExtremum* pExtremum)
+{
+  return pExtremum->pValues[pExtremum->front];
+}
+
+AsirikuyReturnCode rollingExtremum(const double* pPrice, int arraySize, int period, BOOL isMaximum, double* pOutValues, int* pOutIndexes)
+{
+  AsirikuyReturnCode returnCode;
+  RollingExtremum    extremum;
+  int                i;
+
+  if(pPrice == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"rollingExtremum() failed. pPrice = NULL");
+    return NULL_POINTER;
+  }
+
+  returnCode = initRollingExtremum(&extremum, period, isMaximum);
+  if(returnCode != SUCCESS)
+  {
+    return returnCode;
+  }
+
+  for(i = 0; i < arraySize; i++)
+  {
+    pushRollingExtremum(&extremum, i, pPrice[i]);
+
+    if(pOutValues != NULL)
+    {
+      pOutValues[i] = getRollingExtremumValue(&extremum);
+    }
+    if(pOutIndexes != NULL)
+    {
+      pOutIndexes[i] = getRollingExtremumIndex(&extremum);
+    }
+  }
+
+  freeRollingExtremum(&extremum);
+  return SUCCESS;
+}
+
+int findExtremumIndex(const double* pPrice, int first, int last, BOOL isMaximum)
+{
+  int bestIndex = first;
+  int i;
+
+  for(i = last; (i > first) && (i >= 0); i--)
+  {
+    if((bestIndex < 0) || (isMaximum ? (pPrice[i] > pPrice[bestIndex]) : (pPrice[i] < pPrice[bestIndex])))
+    {
+      bestIndex = i;
+    }
+  }
+
+  return bestIndex;
+}
@@ -0,0 +1,553 @@
+/**
+ * @file
+ * @brief     Vectorized kernels for the summations of the technical analysis loops.
+ * @details   Each kernel has a scalar reference plus SSE2 and AVX2 versions selected at runtime from the instruction sets the CPU reports.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "SimdKernels.h"
+
+#if defined __x86_64__ || defined _M_X64 || defined __i386__ || defined _M_IX86
+  #define SIMD_KERNELS_X86
+  #if defined _MSC_VER
+    #include <intrin.h>
+    #define TARGET_SSE2
+    #define TARGET_AVX2
+  #else
+    #include <cpuid.h>
+    #define TARGET_SSE2 __attribute__((target("sse2")))
+    #define TARGET_AVX2 __attribute__((target("avx2")))
+  #endif
+  #include <immintrin.h>
+#endif
+
+typedef struct simdKernels_t
+{
+  double (*sumRanges)(const double* pHigh, const double* pLow, int first, int last, double sum);
+  double (*sumTypicalPrices)(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum);
+  double (*sumBuyingPressures)(const double* pLow, const double* pClose, int first, int last, double sum);
+  double (*sumValues)(const double* pValues, int count);
+  double (*sumSquaredDeviations)(const double* pValues, int count, double mean);
+  void   (*computeBarMeasures)(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges);
+} SimdKernels;
+
+/* Scalar references. They add in the same order as the loops they replaced. */
+
+static double sumRangesScalar(const double* pHigh, const double* pLow, int first, int last, double sum)
+{
+  int i;
+
+  for(i = last; i >= first; i--)
+  {
+    sum += pHigh[i] - pLow[i];
+  }
+
+  return sum;
+}
+
+static double sumTypicalPricesScalar(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  int i;
+
+  for(i = last; i >= first; i--)
+  {
+    sum += (pHigh[i] + pLow[i] + pClose[i]) / 3;
+  }
+
+  return sum;
+}
+
+static double sumBuyingPressuresScalar(const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  double trueLow;
+  int    i;
+
+  for(i = last; i >= first; i--)
+  {
+    trueLow = pLow[i];
+    if(pClose[i - 1] < trueLow)
+    {
+      trueLow = pClose[i - 1];
+    }
+
+    sum += pClose[i] - trueLow;
+  }
+
+  return sum;
+}
+
+static double sumValuesScalar(const double* pValues, int count)
+{
+  double sum = 0;
+  int    i;
+
+  for(i = 0; i < count; i++)
+  {
+    sum += pValues[i];
+  }
+
+  return sum;
+}
+
+static double sumSquaredDeviationsScalar(const double* pValues, int count, double mean)
+{
+  double sum = 0;
+  int    i;
+
+  for(i = 0; i < count; i++)
+  {
+    sum += (pValues[i] - mean) * (pValues[i] - mean);
+  }
+
+  return sum;
+}
+
+static void computeBarMeasuresScalar(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges)
+{
+  int i;
+
+  for(i = first; i <= last; i++)
+  {
+    pOutBodies[i - first] = fabs(pOpen[i] - pClose[i]);
+    pOutRanges[i - first] = fabs(pHigh[i] - pLow[i]);
+  }
+}
+
+static const SimdKernels scalarKernels = { sumRangesScalar, sumTypicalPricesScalar, sumBuyingPressuresScalar, sumValuesScalar, sumSquaredDeviationsScalar, computeBarMeasuresScalar };
+
+#if defined SIMD_KERNELS_X86
+
+/* SSE2 versions, two bars per instruction. The remaining bar goes through the scalar reference. */
+
+TARGET_SSE2 static double horizontalSumSse2(__m128d values)
+{
+  return _mm_cvtsd_f64(_mm_add_sd(values, _mm_unpackhi_pd(values, values)));
+}
+
+TARGET_SSE2 static double sumRangesSse2(const double* pHigh, const double* pLow, int first, int last, double sum)
+{
+  __m128d total = _mm_setzero_pd();
+  int     i;
+
+  for(i = first; i + 1 <= last; i += 2)
+  {
+    total = _mm_add_pd(total, _mm_sub_pd(_mm_loadu_pd(pHigh + i), _mm_loadu_pd(pLow + i)));
+  }
+
+  return sumRangesScalar(pHigh, pLow, i, last, sum + horizontalSumSse2(total));
+}
+
+TARGET_SSE2 static double sumTypicalPricesSse2(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  const __m128d three = _mm_set1_pd(3);
+  __m128d       total = _mm_setzero_pd();
+  int           i;
+
+  for(i = first; i + 1 <= last; i += 2)
+  {
+    __m128d typicalPrice = _mm_add_pd(_mm_add_pd(_mm_loadu_pd(pHigh + i), _mm_loadu_pd(pLow + i)), _mm_loadu_pd(pClose + i));
+    total = _mm_add_pd(total, _mm_div_pd(typicalPrice, three));
+  }
+
+  return sumTypicalPricesScalar(pHigh, pLow, pClose, i, last, sum + horizontalSumSse2(total));
+}
+
+TARGET_SSE2 static double sumBuyingPressuresSse2(const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  __m128d total = _mm_setzero_pd();
+  int     i;
+
+  for(i = first; i + 1 <= last; i += 2)
+  {
+    /* min(a, b) returns b unless a < b, which matches the scalar comparison. */
+    __m128d trueLow = _mm_min_pd(_mm_loadu_pd(pClose + i - 1), _mm_loadu_pd(pLow + i));
+    total = _mm_add_pd(total, _mm_sub_pd(_mm_loadu_pd(pClose + i), trueLow));
+  }
+
+  return sumBuyingPressuresScalar(pLow, pClose, i, last, sum + horizontalSumSse2(total));
+}
+
+TARGET_SSE2 static double sumValuesSse2(const double* pValues, int count)
+{
+  __m128d total = _mm_setzero_pd();
+  double  sum;
+  int     i;
+
+  for(i = 0; i + 1 < count; i += 2)
+  {
+    total = _mm_add_pd(total, _mm_loadu_pd(pValues + i));
+  }
+
+  sum = horizontalSumSse2(total);
+  for(; i < count; i++)
+  {
+    sum += pValues[i];
+  }
+
+  return sum;
+}
+
+TARGET_SSE2 static double sumSquaredDeviationsSse2(const double* pValues, int count, double mean)
+{
+  const __m128d means = _mm_set1_pd(mean);
+  __m128d       total = _mm_setzero_pd();
+  double        sum;
+  int           i;
+
+  for(i = 0; i + 1 < count; i += 2)
+  {
+    __m128d deviation = _mm_sub_pd(_mm_loadu_pd(pValues + i), means);
+    total = _mm_add_pd(total, _mm_mul_pd(deviation, deviation));
+  }
+
+  sum = horizontalSumSse2(total);
+  for(; i < count; i++)
+  {
+    sum += (pValues[i] - mean) * (pValues[i] - mean);
+  }
+
+  return sum;
+}
+
+/* Clearing the sign bit is what fabs does, so the measures match the scalar ones exactly. */
+TARGET_SSE2 static void computeBarMeasuresSse2(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges)
+{
+  const __m128d signMask = _mm_set1_pd(-0.0);
+  int           i;
+
+  for(i = first; i + 1 <= last; i += 2)
+  {
+    _mm_storeu_pd(pOutBodies + i - first, _mm_andnot_pd(signMask, _mm_sub_pd(_mm_loadu_pd(pOpen + i), _mm_loadu_pd(pClose + i))));
+    _mm_storeu_pd(pOutRanges + i - first, _mm_andnot_pd(signMask, _mm_sub_pd(_mm_loadu_pd(pHigh + i), _mm_loadu_pd(pLow + i))));
+  }
+
+  computeBarMeasuresScalar(pOpen, pHigh, pLow, pClose, i, last, pOutBodies + i - first, pOutRanges + i - first);
+}
+
+static const SimdKernels sse2Kernels = { sumRangesSse2, sumTypicalPricesSse2, sumBuyingPressuresSse2, sumValuesSse2, sumSquaredDeviationsSse2, computeBarMeasuresSse2 };
+
+/* AVX2 versions, four bars per instruction with two accumulators to hide the latency of the additions. */
+
+TARGET_AVX2 static double horizontalSumAvx2(__m256d values)
+{
+  __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(values), _mm256_extractf128_pd(values, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+TARGET_AVX2 static double sumRangesAvx2(const double* pHigh, const double* pLow, int first, int last, double sum)
+{
+  __m256d total0 = _mm256_setzero_pd(), total1 = _mm256_setzero_pd();
+  int     i;
+
+  for(i = first; i + 7 <= last; i += 8)
+  {
+    total0 = _mm256_add_pd(total0, _mm256_sub_pd(_mm256_loadu_pd(pHigh + i), _mm256_loadu_pd(pLow + i)));
+    total1 = _mm256_add_pd(total1, _mm256_sub_pd(_mm256_loadu_pd(pHigh + i + 4), _mm256_loadu_pd(pLow + i + 4)));
+  }
+  for(; i + 3 <= last; i += 4)
+  {
+    total0 = _mm256_add_pd(total0, _mm256_sub_pd(_mm256_loadu_pd(pHigh + i), _mm256_loadu_pd(pLow + i)));
+  }
+
+  return sumRangesScalar(pHigh, pLow, i, last, sum + horizontalSumAvx2(_mm256_add_pd(total0, total1)));
+}
+
+TARGET_AVX2 static double sumTypicalPricesAvx2(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  const __m256d three  = _mm256_set1_pd(3);
+  __m256d       total0 = _mm256_setzero_pd(), total1 = _mm256_setzero_pd();
+  int           i;
+
+  for(i = first; i + 7 <= last; i += 8)
+  {
+    __m256d typicalPrice0 = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(pHigh + i), _mm256_loadu_pd(pLow + i)), _mm256_loadu_pd(pClose + i));
+    __m256d typicalPrice1 = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(pHigh + i + 4), _mm256_loadu_pd(pLow + i + 4)), _mm256_loadu_pd(pClose + i + 4));
+    total0 = _mm256_add_pd(total0, _mm256_div_pd(typicalPrice0, three));
+    total1 = _mm256_add_pd(total1, _mm256_div_pd(typicalPrice1, three));
+  }
+  for(; i + 3 <= last; i += 4)
+  {
+    __m256d typicalPrice = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(pHigh + i), _mm256_loadu_pd(pLow + i)), _mm256_loadu_pd(pClose + i));
+    total0 = _mm256_add_pd(total0, _mm256_div_pd(typicalPrice, three));
+  }
+
+  return sumTypicalPricesScalar(pHigh, pLow, pClose, i, last, sum + horizontalSumAvx2(_mm256_add_pd(total0, total1)));
+}
+
+TARGET_AVX2 static double sumBuyingPressuresAvx2(const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  __m256d total0 = _mm256_setzero_pd(), total1 = _mm256_setzero_pd();
+  int     i;
+
+  for(i = first; i + 7 <= last; i += 8)
+  {
+    __m256d trueLow0 = _mm256_min_pd(_mm256_loadu_pd(pClose + i - 1), _mm256_loadu_pd(pLow + i));
+    __m256d trueLow1 = _mm256_min_pd(_mm256_loadu_pd(pClose + i + 3), _mm256_loadu_pd(pLow + i + 4));
+    total0 = _mm256_add_pd(total0, _mm256_sub_pd(_mm256_loadu_pd(pClose + i), trueLow0));
+    total1 = _mm256_add_pd(total1, _mm256_sub_pd(_mm256_loadu_pd(pClose + i + 4), trueLow1));
+  }
+  for(; i + 3 <= last; i += 4)
+  {
+    __m256d trueLow = _mm256_min_pd(_mm256_loadu_pd(pClose + i - 1), _mm256_loadu_pd(pLow + i));
+    total0 = _mm256_add_pd(total0, _mm256_sub_pd(_mm256_loadu_pd(pClose + i), trueLow));
+  }
+
+  return sumBuyingPressuresScalar(pLow, pClose, i, last, sum + horizontalSumAvx2(_mm256_add_pd(total0, total1)));
+}
+
+TARGET_AVX2 static double sumValuesAvx2(const double* pValues, int count)
+{
+  __m256d total0 = _mm256_setzero_pd(), total1 = _mm256_setzero_pd();
+  double  sum;
+  int     i;
+
+  for(i = 0; i + 8 <= count; i += 8)
+  {
+    total0 = _mm256_add_pd(total0, _mm256_loadu_pd(pValues + i));
+    total1 = _mm256_add_pd(total1, _mm256_loadu_pd(pValues + i + 4));
+  }
+  for(; i + 4 <= count; i += 4)
+  {
+    total0 = _mm256_add_pd(total0, _mm256_loadu_pd(pValues + i));
+  }
+
+  sum = horizontalSumAvx2(_mm256_add_pd(total0, total1));
+  for(; i < count; i++)
+  {
+    sum += pValues[i];
+  }
+
+  return sum;
+}
+
+TARGET_AVX2 static double sumSquaredDeviationsAvx2(const double* pValues, int count, double mean)
+{
+  const __m256d means  = _mm256_set1_pd(mean);
+  __m256d       total0 = _mm256_setzero_pd(), total1 = _mm256_setzero_pd();
+  double        sum;
+  int           i;
+
+  for(i = 0; i + 8 <= count; i += 8)
+  {
+    __m256d deviation0 = _mm256_sub_pd(_mm256_loadu_pd(pValues + i), means);
+    __m256d deviation1 = _mm256_sub_pd(_mm256_loadu_pd(pValues + i + 4), means);
+    total0 = _mm256_add_pd(total0, _mm256_mul_pd(deviation0, deviation0));
+    total1 = _mm256_add_pd(total1, _mm256_mul_pd(deviation1, deviation1));
+  }
+  for(; i + 4 <= count; i += 4)
+  {
+    __m256d deviation = _mm256_sub_pd(_mm256_loadu_pd(pValues + i), means);
+    total0 = _mm256_add_pd(total0, _mm256_mul_pd(deviation, deviation));
+  }
+
+  sum = horizontalSumAvx2(_mm256_add_pd(total0, total1));
+  for(; i < count; i++)
+  {
+    sum += (pValues[i] - mean) * (pValues[i] - mean);
+  }
+
+  return sum;
+}
+
+TARGET_AVX2 static void computeBarMeasuresAvx2(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges)
+{
+  const __m256d signMask = _mm256_set1_pd(-0.0);
+  int           i;
+
+  for(i = first; i + 3 <= last; i += 4)
+  {
+    _mm256_storeu_pd(pOutBodies + i - first, _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_loadu_pd(pOpen + i), _mm256_loadu_pd(pClose + i))));
+    _mm256_storeu_pd(pOutRanges + i - first, _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_loadu_pd(pHigh + i), _mm256_loadu_pd(pLow + i))));
+  }
+
+  computeBarMeasuresScalar(pOpen, pHigh, pLow, pClose, i, last, pOutBodies + i - first, pOutRanges + i - first);
+}
+
+static const SimdKernels avx2Kernels = { sumRangesAvx2, sumTypicalPricesAvx2, sumBuyingPressuresAvx2, sumValuesAvx2, sumSquaredDeviationsAvx2, computeBarMeasuresAvx2 };
+
+static void readCpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+{
+#if defined _MSC_VER
+  int info[4];
+  __cpuidex(info, (int)leaf, (int)subleaf);
+  registers[0] = (unsigned int)info[0];
+  registers[1] = (unsigned int)info[1];
+  registers[2] = (unsigned int)info[2];
+  registers[3] = (unsigned int)info[3];
+#else
+  __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+/* The AVX registers are only usable if the operating system saves them on context switches. */
+static BOOL isAvxStateEnabled()
+{
+#if defined _MSC_VER
+  return (_xgetbv(0) & 0x6) == 0x6;
+#else
+  unsigned int eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (eax & 0x6) == 0x6;
+#endif
+}
+
+static SimdLevel detectSimdLevel()
+{
+  unsigned int registers[4];
+  unsigned int maxLeaf;
+  SimdLevel    level = SIMD_SCALAR;
+
+  readCpuid(0, 0, registers);
+  maxLeaf = registers[0];
+  if(maxLeaf < 1)
+  {
+    return SIMD_SCALAR;
+  }
+
+  readCpuid(1, 0, registers);
+  if(registers[3] & (1u << 26))
+  {
+    level = SIMD_SSE2;
+  }
+
+  /* OSXSAVE and AVX in ECX of leaf 1, AVX2 in EBX of leaf 7. */
+  if((level == SIMD_SSE2) && (maxLeaf >= 7) && (registers[2] & (1u << 27)) && (registers[2] & (1u << 28)) && isAvxStateEnabled())
+  {
+    readCpuid(7, 0, registers);
+    if(registers[1] & (1u << 5))
+    {
+      level = SIMD_AVX2;
+    }
+  }
+
+  return level;
+}
+
+#else
+
+static SimdLevel detectSimdLevel()
+{
+  return SIMD_SCALAR;
+}
+
+#endif
+
+static const SimdKernels* gpKernels = NULL;
+static SimdLevel          gSimdLevel = SIMD_SCALAR;
+static int                gSupportedSimdLevel = -1;
+
+/* Detection is idempotent so concurrent first calls agree on the result. */
+static const SimdKernels* getKernels()
+{
+  if(gpKernels == NULL)
+  {
+    setSimdLevel(getSupportedSimdLevel());
+  }
+
+  return gpKernels;
+}
+
+SimdLevel getSupportedSimdLevel()
+{
+  if(gSupportedSimdLevel < 0)
+  {
+    gSupportedSimdLevel = (int)detectSimdLevel();
+  }
+
+  return (SimdLevel)gSupportedSimdLevel;
+}
+
+SimdLevel getSimdLevel()
+{
+  getKernels();
+  return gSimdLevel;
+}
+
+SimdLevel setSimdLevel(SimdLevel level)
+{
+  SimdLevel supportedLevel = getSupportedSimdLevel();
+
+  if(level > supportedLevel)
+  {
+    level = supportedLevel;
+  }
+
+  switch(level)
+  {
+#if defined SIMD_KERNELS_X86
+  case SIMD_AVX2:
+    gpKernels = &avx2Kernels;
+    break;
+  case SIMD_SSE2:
+    gpKernels = &sse2Kernels;
+    break;
+#endif
+  default:
+    level     = SIMD_SCALAR;
+    gpKernels = &scalarKernels;
+    break;
+  }
+
+  gSimdLevel = level;
+  return level;
+}
+
+double sumRanges(const double* pHigh, const double* pLow, int first, int last, double sum)
+{
+  return getKernels()->sumRanges(pHigh, pLow, first, last, sum);
+}
+
+double sumTypicalPrices(const double* pHigh, const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  return getKernels()->sumTypicalPrices(pHigh, pLow, pClose, first, last, sum);
+}
+
+double sumBuyingPressures(const double* pLow, const double* pClose, int first, int last, double sum)
+{
+  return getKernels()->sumBuyingPressures(pLow, pClose, first, last, sum);
+}
+
+double sumValues(const double* pValues, int count)
+{
+  return getKernels()->sumValues(pValues, count);
+}
+
+double sumSquaredDeviations(const double* pValues, int count, double mean)
+{
+  return getKernels()->sumSquaredDeviations(pValues, count, mean);
+}
+
+void computeBarMeasures(const double* pOpen, const double* pHigh, const double* pLow, const double* pClose, int first, int last, double* pOutBodies, double* pOutRanges)
+{
+  getKernels()->computeBarMeasures(pOpen, pHigh, pLow, pClose, first, last, pOutBodies, pOutRanges);
+}
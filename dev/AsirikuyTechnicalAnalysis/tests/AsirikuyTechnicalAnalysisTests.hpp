@@ -34,8 +34,131 @@
  * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
  */
 
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <time.h>
 #include <boost/test/unit_test.hpp>
 
+#include "AsirikuyDefines.h"
+#include "Indicators.h"
+#include "PriceAction.h"
+#include "RollingExtremum.h"
+#include "MovingAverages.h"
+#include "SimdKernels.h"
+#include "CandlestickPatterns.h"
+
+namespace
+{
+  /* Window of period bars ending at bar i, the most recent bar wins ties. */
+  int scanExtremumIndex(const std::vector<double>& prices, int i, int period, bool isMaximum)
+  {
+    int bestIndex = i;
+    for(int n = i - 1; n > i - period && n >= 0; n--)
+    {
+      if(isMaximum ? (prices[n] > prices[bestIndex]) : (prices[n] < prices[bestIndex])) bestIndex = n;
+    }
+    return bestIndex;
+  }
+
+  std::vector<double> randomPrices(unsigned int seed, int size, int levels)
+  {
+    std::vector<double> prices(size);
+    srand(seed);
+    for(int i = 0; i < size; i++)
+    {
+      prices[i] = 1.3 + (rand() % levels) * 0.0001;
+    }
+    return prices;
+  }
+
+  /* Copies of the loops the SIMD kernels replaced. */
+  double legacyRangeSum(const std::vector<double>& high, const std::vector<double>& low, int first, int last)
+  {
+    double sum = 0;
+    for(int i = last; i >= first; i--)
+    {
+      sum += high[i] - low[i];
+    }
+    return sum;
+  }
+
+  double legacyTypicalPriceSum(const std::vector<double>& high, const std::vector<double>& low, const std::vector<double>& close, int first, int last)
+  {
+    double sum = 0;
+    for(int i = last; i >= first; i--)
+    {
+      sum += (high[i] + low[i] + close[i]) / 3;
+    }
+    return sum;
+  }
+
+  double legacyBuyingPressureSum(const std::vector<double>& low, const std::vector<double>& close, int first, int last)
+  {
+    double sum = 0;
+    for(int i = last; i >= first; i--)
+    {
+      double trueLow = low[i];
+      if(close[i - 1] < trueLow)
+      {
+        trueLow = close[i - 1];
+      }
+      sum += close[i] - trueLow;
+    }
+    return sum;
+  }
+
+  double legacyVariance(const std::vector<double>& values)
+  {
+    double sum = 0, average;
+    int    count = (int)values.size();
+    for(int j = 0; j < count; j++)
+    {
+      sum += values[j];
+    }
+    average = sum / count;
+    sum = 0;
+    for(int j = 0; j < count; j++)
+    {
+      sum += (values[j] - average) * (values[j] - average);
+    }
+    return sum / (count - 1);
+  }
+
+  void randomBars(unsigned int seed, int size, std::vector<double>& high, std::vector<double>& low, std::vector<double>& close)
+  {
+    std::vector<double> prices = randomPrices(seed, size, 2000);
+    high.resize(size);
+    low.resize(size);
+    close.resize(size);
+    for(int i = 0; i < size; i++)
+    {
+      high[i]  = prices[i] + (rand() % 50) * 0.0001;
+      low[i]   = prices[i] - (rand() % 50) * 0.0001;
+      close[i] = low[i] + (high[i] - low[i]) * (rand() % 100) / 100.0;
+    }
+  }
+
+  /* Random walk candles with dojis and long shadows so that every pattern occurs. */
+  void randomCandles(unsigned int seed, int size, std::vector<double>& open, std::vector<double>& high, std::vector<double>& low, std::vector<double>& close)
+  {
+    double price = 1.3;
+    open.resize(size);
+    high.resize(size);
+    low.resize(size);
+    close.resize(size);
+    srand(seed);
+    for(int i = 0; i < size; i++)
+    {
+      open[i]  = price + ((rand() % 21) - 10) * 0.0001;
+      close[i] = (rand() % 10 == 0) ? open[i] : open[i] + ((rand() % 81) - 40) * 0.0001;
+      high[i]  = (open[i] > close[i] ? open[i] : close[i]) + (rand() % 40) * 0.0001;
+      low[i]   = (open[i] < close[i] ? open[i] : close[i]) - (rand() % 40) * 0.0001;
+      price    = close[i];
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(Asirikuy_Technical_Analysis)
 
 BOOST_AUTO_TEST_CASE(placeholder)
@@ -43,4 +166,300 @@ BOOST_AUTO_TEST_CASE(placeholder)
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(barsToPreviousTime_matchesBackwardScan)
+{
+  std::vector<time_t> times;
+  time_t t = 1325462400;
+
+  /* 15 minute bars with weekend gaps and repeated timestamps. */
+  for(int i = 0; i < 2000; i++, t += 900)
+  {
+    int dayOfWeek = (int)DAY_OF_WEEK(t);
+    if(dayOfWeek == SATURDAY || dayOfWeek == SUNDAY) continue;
+    times.push_back(t);
+    if(i % 11 == 0) times.push_back(t);
+  }
+
+  int shiftIndex = (int)times.size() - 1;
+  for(time_t query = times.front(); query <= times.back() + 3600; query += 450)
+  {
+    int expected = 0, actual = -1;
+    while(times[shiftIndex - expected] > query) expected++;
+
+    BOOST_CHECK(barsToPreviousTime(&times[0], query, shiftIndex, &actual) == SUCCESS);
+    BOOST_CHECK_EQUAL(actual, expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rollingExtremum_matchesScan)
+{
+  /* Few price levels so that ties are common. */
+  std::vector<double> prices = randomPrices(3, 2000, 12);
+  std::vector<double> values(prices.size());
+  std::vector<int>    indexes(prices.size());
+  const int           periods[] = { 1, 2, 3, 7, 20, 64, 250 };
+
+  for(int p = 0; p < (int)(sizeof(periods) / sizeof(periods[0])); p++)
+  {
+    for(int isMaximum = 0; isMaximum < 2; isMaximum++)
+    {
+      RollingExtremum extremum;
+      int             mismatches = 0;
+
+      BOOST_REQUIRE_EQUAL(rollingExtremum(&prices[0], (int)prices.size(), periods[p], isMaximum, &values[0], &indexes[0]), SUCCESS);
+      BOOST_REQUIRE_EQUAL(initRollingExtremum(&extremum, periods[p], isMaximum), SUCCESS);
+
+      for(int i = 0; i < (int)prices.size(); i++)
+      {
+        int expected = scanExtremumIndex(prices, i, periods[p], isMaximum != 0);
+
+        pushRollingExtremum(&extremum, i, prices[i]);
+        if(indexes[i] != expected || values[i] != prices[expected] || getRollingExtremumIndex(&extremum) != expected || getRollingExtremumValue(&extremum) != prices[expected])
+        {
+          mismatches++;
+        }
+      }
+
+      freeRollingExtremum(&extremum);
+      BOOST_CHECK_EQUAL(mismatches, 0);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(rollingExtremum(&prices[0], (int)prices.size(), 0, TRUE, &values[0], NULL), INVALID_PARAMETER);
+}
+
+BOOST_AUTO_TEST_CASE(minMaxIndex_matchesBackwardScan)
+{
+  std::vector<double> prices = randomPrices(5, 300, 8);
+  int arraySize = (int)prices.size();
+
+  for(int period = 1; period < 40; period++)
+  {
+    for(int shift = 0; shift < 20; shift++)
+    {
+      int expectedMin = arraySize - 1 - period - shift, expectedMax = expectedMin;
+      int outMin = -1, outMax = -1, outMinOnly = -1, outMaxOnly = -1;
+
+      for(int i = arraySize - 1 - shift; i > arraySize - 1 - period - shift; i--)
+      {
+        if(prices[i] < prices[expectedMin]) expectedMin = i;
+        if(prices[i] > prices[expectedMax]) expectedMax = i;
+      }
+
+      BOOST_CHECK(minMaxIndex(&prices[0], arraySize, period, shift, &outMin, &outMax) == SUCCESS);
+      BOOST_CHECK(minIndex(&prices[0], arraySize, period, shift, &outMinOnly) == SUCCESS);
+      BOOST_CHECK(maxIndex(&prices[0], arraySize, period, shift, &outMaxOnly) == SUCCESS);
+      BOOST_CHECK_EQUAL(outMin, expectedMin);
+      BOOST_CHECK_EQUAL(outMax, expectedMax);
+      BOOST_CHECK_EQUAL(outMinOnly, expectedMin);
+      BOOST_CHECK_EQUAL(outMaxOnly, expectedMax);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rollingExtremum_benchmarkPeriods)
+{
+  std::vector<double> prices = randomPrices(11, 100000, 2000);
+  std::vector<double> values(prices.size());
+  const int           periods[] = { 5, 20, 100, 500 };
+
+  for(int p = 0; p < (int)(sizeof(periods) / sizeof(periods[0])); p++)
+  {
+    double  scanSum = 0, dequeSum = 0;
+    double  scanSeconds, dequeSeconds;
+    clock_t begin;
+
+    begin = clock();
+    for(int i = 0; i < (int)prices.size(); i++)
+    {
+      scanSum += prices[scanExtremumIndex(prices, i, periods[p], true)];
+    }
+    scanSeconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    begin = clock();
+    rollingExtremum(&prices[0], (int)prices.size(), periods[p], TRUE, &values[0], NULL);
+    for(int i = 0; i < (int)prices.size(); i++)
+    {
+      dequeSum += values[i];
+    }
+    dequeSeconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    BOOST_TEST_MESSAGE("period " << periods[p] << ": window scans " << scanSeconds << "s, rolling extremum " << dequeSeconds << "s for " << prices.size() << " bars");
+    BOOST_CHECK_EQUAL(dequeSum, scanSum);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(simdKernels_scalarMatchesLegacyLoops)
+{
+  std::vector<double> high, low, close;
+  SimdLevel           previousLevel = getSimdLevel();
+
+  randomBars(17, 500, high, low, close);
+  BOOST_REQUIRE_EQUAL(setSimdLevel(SIMD_SCALAR), SIMD_SCALAR);
+
+  for(int first = 1; first < 60; first += 7)
+  {
+    for(int last = first - 1; last < 480; last += 37)
+    {
+      BOOST_CHECK_EQUAL(sumRanges(&high[0], &low[0], first, last, 0), legacyRangeSum(high, low, first, last));
+      BOOST_CHECK_EQUAL(sumTypicalPrices(&high[0], &low[0], &close[0], first, last, 0), legacyTypicalPriceSum(high, low, close, first, last));
+      BOOST_CHECK_EQUAL(sumBuyingPressures(&low[0], &close[0], first, last, 0), legacyBuyingPressureSum(low, close, first, last));
+    }
+  }
+
+  for(int period = 1; period < 200; period += 13)
+  {
+    double average = 0;
+    BOOST_REQUIRE_EQUAL(calculateAverageRange(&high[0], &low[0], (int)high.size(), period, 3, &average), SUCCESS);
+    BOOST_CHECK_EQUAL(average, legacyRangeSum(high, low, (int)high.size() - 3 - period, (int)high.size() - 4) / period);
+  }
+
+  for(int count = 2; count < 100; count += 9)
+  {
+    std::vector<double> values(close.begin(), close.begin() + count);
+    double              mean = sumValues(&values[0], count) / count;
+    BOOST_CHECK_EQUAL(sumSquaredDeviations(&values[0], count, mean) / (count - 1), legacyVariance(values));
+  }
+
+  setSimdLevel(previousLevel);
+}
+
+BOOST_AUTO_TEST_CASE(simdKernels_vectorLevelsMatchScalar)
+{
+  std::vector<double> high, low, close;
+  SimdLevel           previousLevel = getSimdLevel();
+  const double        tolerance = 1e-10;
+
+  randomBars(19, 1000, high, low, close);
+  BOOST_TEST_MESSAGE("supported SIMD level: " << getSupportedSimdLevel());
+
+  for(int level = SIMD_SSE2; level <= getSupportedSimdLevel(); level++)
+  {
+    BOOST_REQUIRE_EQUAL(setSimdLevel((SimdLevel)level), level);
+
+    /* Every length from empty to a few vector widths, at every alignment. */
+    for(int first = 1; first < 9; first++)
+    {
+      for(int last = first - 1; last < first + 40; last++)
+      {
+        BOOST_CHECK_CLOSE(sumRanges(&high[0], &low[0], first, last, 1.0), 1.0 + legacyRangeSum(high, low, first, last), tolerance);
+        BOOST_CHECK_CLOSE(sumTypicalPrices(&high[0], &low[0], &close[0], first, last, 1.0), 1.0 + legacyTypicalPriceSum(high, low, close, first, last), tolerance);
+        BOOST_CHECK_CLOSE(sumBuyingPressures(&low[0], &close[0], first, last, 1.0), 1.0 + legacyBuyingPressureSum(low, close, first, last), tolerance);
+      }
+    }
+
+    for(int count = 2; count < 50; count++)
+    {
+      std::vector<double> values(close.begin() + count, close.begin() + 2 * count);
+      double              mean = sumValues(&values[0], count) / count;
+      BOOST_CHECK_CLOSE(sumSquaredDeviations(&values[0], count, mean) / (count - 1), legacyVariance(values), 1e-6);
+    }
+  }
+
+  setSimdLevel(previousLevel);
+}
+
+BOOST_AUTO_TEST_CASE(simdKernels_benchmarkLevels)
+{
+  std::vector<double> high, low, close;
+  SimdLevel           previousLevel = getSimdLevel();
+  const int           size = 4096, repeats = 2000;
+
+  randomBars(23, size, high, low, close);
+
+  for(int level = SIMD_SCALAR; level <= getSupportedSimdLevel(); level++)
+  {
+    double  seconds[4], checksum = 0;
+    clock_t begin;
+
+    setSimdLevel((SimdLevel)level);
+
+    begin = clock();
+    for(int r = 0; r < repeats; r++) checksum += sumRanges(&high[0], &low[0], 1, size - 1, 0);
+    seconds[0] = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    begin = clock();
+    for(int r = 0; r < repeats; r++) checksum += sumTypicalPrices(&high[0], &low[0], &close[0], 1, size - 1, 0);
+    seconds[1] = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    begin = clock();
+    for(int r = 0; r < repeats; r++) checksum += sumBuyingPressures(&low[0], &close[0], 1, size - 1, 0);
+    seconds[2] = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    begin = clock();
+    for(int r = 0; r < repeats; r++) checksum += sumSquaredDeviations(&close[0], size, sumValues(&close[0], size) / size);
+    seconds[3] = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    BOOST_TEST_MESSAGE("SIMD level " << level << ": ranges " << seconds[0] << "s, typical prices " << seconds[1] << "s, buying pressures " << seconds[2] << "s, variance " << seconds[3] << "s for " << repeats << " x " << size << " bars");
+    BOOST_CHECK(checksum > 0);
+  }
+
+  setSimdLevel(previousLevel);
+}
+
+BOOST_AUTO_TEST_CASE(scanCandlestickPatterns_matchesDetectors)
+{
+  std::vector<double> open, high, low, close;
+  const int           size = 20000;
+  const double        atr = 0.002, atrMultiplier = 0.5;
+  SimdLevel           previousLevel = getSimdLevel();
+
+  randomCandles(29, size, open, high, low, close);
+
+  for(int level = SIMD_SCALAR; level <= getSupportedSimdLevel(); level++)
+  {
+    std::vector<unsigned int> patterns(size);
+    int                       counts[10] = { 0 };
+
+    setSimdLevel((SimdLevel)level);
+    BOOST_REQUIRE_EQUAL(scanCandlestickPatterns(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], 0, size - 1, &patterns[0]), SUCCESS);
+
+    for(int i = 0; i < size; i++)
+    {
+      int arraySize = i + 2;
+      unsigned int expected = 0;
+
+      if(i >= 2 && detectThreeBlackCrows(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))     expected |= PATTERN_THREE_BLACK_CROWS;
+      if(i >= 2 && detectThreeWhiteSoldiers(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))  expected |= PATTERN_THREE_WHITE_SOLDIERS;
+      if(detectHangingMan(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))                     expected |= PATTERN_HANGING_MAN;
+      if(detectHammer(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))                         expected |= PATTERN_HAMMER;
+      if(i >= 1 && detectBearishEngulfing(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))    expected |= PATTERN_BEARISH_ENGULFING;
+      if(i >= 1 && detectBullishEngulfing(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))    expected |= PATTERN_BULLISH_ENGULFING;
+      if(i >= 1 && detectBearishRapidTp(atrMultiplier, atr, &open[0], &close[0], arraySize))                          expected |= PATTERN_BEARISH_RAPID_TP;
+      if(i >= 1 && detectBullishRapidTp(atrMultiplier, atr, &open[0], &close[0], arraySize))                          expected |= PATTERN_BULLISH_RAPID_TP;
+      if(i >= 1 && detectDarkCloudCover(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))      expected |= PATTERN_DARK_CLOUD_COVER;
+      if(i >= 1 && detectPiercing(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], arraySize))            expected |= PATTERN_PIERCING;
+
+      if(patterns[i] != expected)
+      {
+        BOOST_ERROR("bar " << i << " at SIMD level " << level << ": scanned " << patterns[i] << ", detected " << expected);
+        break;
+      }
+
+      for(int p = 0; p < 10; p++)
+      {
+        if(expected & (1u << p)) counts[p]++;
+      }
+    }
+
+    for(int p = 0; p < 10; p++)
+    {
+      BOOST_CHECK_MESSAGE(counts[p] > 0, "pattern bit " << p << " never occurred");
+    }
+  }
+
+  /* Ranges that start and end inside a window give the same masks as the full scan. */
+  {
+    std::vector<unsigned int> all(size), part(1000);
+    BOOST_REQUIRE_EQUAL(scanCandlestickPatterns(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], 0, size - 1, &all[0]), SUCCESS);
+    for(int first = 1; first < 600; first += 97)
+    {
+      BOOST_REQUIRE_EQUAL(scanCandlestickPatterns(atrMultiplier, atr, &open[0], &high[0], &low[0], &close[0], first, first + 999, &part[0]), SUCCESS);
+      BOOST_CHECK(std::equal(part.begin(), part.end(), all.begin() + first));
+    }
+  }
+
+  setSimdLevel(previousLevel);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
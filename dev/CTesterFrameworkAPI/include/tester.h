@@ -71,6 +71,7 @@ typedef struct statistic_item_t
 #pragma once
 
 #include "CTesterFrameworkDefines.h"
+#include "EquityCurve.h"
 
 #define MAX_ORDERS 200
 #define MIN_STATISTICS_SIZE 200
@@ -98,6 +99,30 @@ TestResult __stdcall runPortfolioTest (
 	void			(*signalUpdate)(TradeSignal signal)
 	);
 
+/** TestResult runPortfolioTestWithEquityCurve (..., EquityCurve* pEquityCurve);
+ @brief performs a portfolio test like runPortfolioTest and captures the balance, equity and margin of every bar
+ @param pEquityCurve Curve allocated with allocEquityCurve, with at least numCandles points. It is cleared at the start of the test and downsampled to its targetPoints at the end. NULL captures nothing.
+ */
+TestResult __stdcall runPortfolioTestWithEquityCurve (
+	int				testId,
+	double**		pInSettings,
+	char**			pInTradeSymbol,
+    char*			pInAccountCurrency,
+    char*			pInBrokerName,
+	char*			pInRefBrokerName,
+    double**			pInAccountInfo,
+	TestSettings	*testSettings,
+	CRatesInfo**	pRatesInfo,
+	int				numCandles,
+	int				numSystems,
+    ASTRates***		pRates,
+	double			minLotSize,
+	void			(*testUpdate)(int testId, double percentageOfTestCompleted, COrderInfo lastOrder, double currentBalance, char* symbol), 
+	void			(*testFinished)(TestResult testResults), 
+	void			(*signalUpdate)(TradeSignal signal),
+	EquityCurve*	pEquityCurve
+	);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Precompiled.h"
 #include "CTesterFrameworkDefines.h"
 #include "Logging.h"
+#include "AsyncLog.h"
 
 const PAN_CHAR_T PANTHEIOS_FE_PROCESS_IDENTITY[] = PANTHEIOS_LITERAL_STRING("AsirikuyCTester");
 
@@ -46,6 +47,7 @@ static int startCTesterFramework(char* pAsirikuyTesterLog, int severityLevel)
   pantheios_init();
   pantheios_be_file_setFilePath((PAN_CHAR_T*)pantheiosLogPath, 0, 0, PANTHEIOS_BEID_ALL);
   pantheios_fe_simple_setSeverityCeiling(severityLevel);
+  setAsyncLogSeverity(severityLevel);
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Pantheios initialized.");
 
   pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"CTesterframework initialization complete.");
@@ -15,12 +15,26 @@
 #include "Precompiled.h"
 #include "AsirikuyTime.h"
 #include "AsirikuyDefines.h"
+#include "Calendar.h"
+#include "TimeIndex.h"
+#include "TimerWheel.h"
+#include "AsyncLog.h"
+#include "EquityCurve.h"
 
 #define MATHEMATICAL_EXPECTANCY_LIMIT 50
 #define MATHEMATICAL_EXPECTANCY_DIVISION 5
+#define SWAP_ACCRUAL_INTERVAL 3600
 
 static void (*globalSignalUpdate)(TradeSignal signal);
 
+typedef struct quoteSeries_t
+{
+	int       size;
+	time_t*   time;
+	double*   bid;
+	TimeIndex index;
+} QuoteSeries;
+
 static void sleepMilliseconds(int milliseconds)
 {
 #if defined _WIN32 || defined _WIN64
@@ -35,34 +49,100 @@ static void sleepMilliseconds(int milliseconds)
 const int SecondsPerMinute = 60;
 const int SecondsPerHour = 3600;
 const int SecondsPerDay = 86400;
-const int DaysOfMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-
-BOOL IsLeapYear(short year)
-{
-    if (year % 4 != 0) return false;
-    if (year % 100 != 0) return true;
-    return (year % 400) == 0;
-}
 
 time_t mkgmtime(short year, short month, short day, short hour, short minute, short second)
 {
-    time_t secs = 0;
-	short y;
-	short m;
-
-    for (y = 1970; y < year; ++y)
-        secs += (IsLeapYear(y)? 366: 365) * SecondsPerDay;
-    for (m = 1; m < month; ++m) {
-        secs += DaysOfMonth[m - 1] * SecondsPerDay;
-        if (m == 2 && IsLeapYear(year)) secs += SecondsPerDay;
-    }
-    secs += (day - 1) * SecondsPerDay;
+    time_t secs = daysFromCivil(year, month, day) * SecondsPerDay;
     secs += hour * SecondsPerHour;
     secs += minute * SecondsPerMinute;
     secs += second;
     return secs;
 }
 
+// Loads a whole conversion quotes file (dd/mm/yy hh:mm,bid) so that quotes can be looked up by time
+// instead of being read line by line while the test advances.
+static void loadQuoteSeries(FILE* quoteFile, QuoteSeries* pSeries)
+{
+	char data[200] = "";
+	char *ptr, *timeString, *strtokSave;
+	struct tm lDate;
+	int capacity = 1024;
+
+	pSeries->size = 0;
+	pSeries->time = (time_t*)malloc(capacity * sizeof(time_t));
+	pSeries->bid  = (double*)malloc(capacity * sizeof(double));
+	initTimeIndexFromTimes(&pSeries->index, NULL, 0);
+
+	while (fgets(data, 200, quoteFile) != NULL){
+
+		if (pSeries->size == capacity){
+			capacity *= 2;
+			pSeries->time = (time_t*)realloc(pSeries->time, capacity * sizeof(time_t));
+			pSeries->bid  = (double*)realloc(pSeries->bid, capacity * sizeof(double));
+		}
+
+		memset(&lDate, 0, sizeof(struct tm));
+		timeString = strtok_r(data, ",", &strtokSave);
+		ptr = strtok_r(NULL, ",", &strtokSave);
+		if (timeString == NULL || ptr == NULL) continue;
+		if (sscanf(ptr,"%lf",&pSeries->bid[pSeries->size]) != 1) continue;
+
+		ptr = strtok_r(timeString, "/", &strtokSave);
+		sscanf(ptr,"%d",&lDate.tm_mday);
+		ptr = strtok_r(NULL, "/", &strtokSave);
+		sscanf(ptr,"%d",&lDate.tm_mon);
+		ptr = strtok_r(NULL, " ", &strtokSave);
+		sscanf(ptr,"%d",&lDate.tm_year);
+		ptr = strtok_r(NULL, ":", &strtokSave);
+		sscanf(ptr,"%d",&lDate.tm_hour);
+		ptr = strtok_r(NULL, " ", &strtokSave);
+		sscanf(ptr,"%d",&lDate.tm_min);
+
+		if(lDate.tm_year < 50) lDate.tm_year += 2000 ; else lDate.tm_year += 1900;
+
+		pSeries->time[pSeries->size] = mkgmtime(lDate.tm_year, lDate.tm_mon, lDate.tm_mday, lDate.tm_hour, lDate.tm_min, 0);
+		pSeries->size++;
+	}
+
+	if (initTimeIndexFromTimes(&pSeries->index, pSeries->time, pSeries->size) != SUCCESS){
+		pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"Quotes file is not sorted by time. Conversion rates will be inaccurate.");
+	}
+}
+
+static void freeQuoteSeries(QuoteSeries* pSeries)
+{
+	freeTimeIndex(&pSeries->index);
+	free(pSeries->time); pSeries->time = NULL;
+	free(pSeries->bid); pSeries->bid = NULL;
+	pSeries->size = 0;
+}
+
+// Returns the first quote at or after the bar time, or the last quote if the series ends before it.
+static double seekQuote(const QuoteSeries* pSeries, int barTime)
+{
+	int index = timeIndexLowerBound(&pSeries->index, barTime);
+
+	if (index >= pSeries->index.size) index = pSeries->index.size - 1;
+	if (index < 0) index = pSeries->size - 1;
+
+	return pSeries->bid[index];
+}
+
+// Swap accrual is scheduled on a timer wheel per system so that bars between accruals cost nothing.
+static void onSwapTimer(WheelTimer* pTimer, void* pContext){
+	((BOOL*)pContext)[pTimer->id] = true;
+}
+
+static BOOL hasOpenOrders(int* openOrdersCount, COrderInfo* openOrders, int instanceId){
+	int m;
+
+	for(m = 0; m < openOrdersCount[BUY] + openOrdersCount[SELL]; m++){
+		if (openOrders[m].instanceId == instanceId && openOrders[m].isOpen) return true;
+	}
+
+	return false;
+}
+
 
 double standardDeviation(double data[], int n)
 {
@@ -307,7 +387,7 @@ int updateOrder(int instanceId, StrategyResults* strategyResults, int* openOrder
 					globalSignalUpdate(lastSignal);
 				}
 
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Update Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[i].ticket, openOrders[i].instanceId, openOrders[i].openPrice, openOrders[i].stopLoss, openOrders[i].takeProfit);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Update Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[i].ticket, openOrders[i].instanceId, openOrders[i].openPrice, openOrders[i].stopLoss, openOrders[i].takeProfit);
 			}
 			if(openOrders[i].type == SELL || openOrders[i].type == SELLSTOP || openOrders[i].type == SELLLIMIT){
 
@@ -358,7 +438,7 @@ int updateOrder(int instanceId, StrategyResults* strategyResults, int* openOrder
 					globalSignalUpdate(lastSignal);
 				}
 
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Update Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[i].ticket, openOrders[i].instanceId, openOrders[i].openPrice, openOrders[i].stopLoss, openOrders[i].takeProfit);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Update Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[i].ticket, openOrders[i].instanceId, openOrders[i].openPrice, openOrders[i].stopLoss, openOrders[i].takeProfit);
 			}
 
 			if (strategyResults->brokerTP == 0) openOrders[i].takeProfit = 0;
@@ -457,14 +537,14 @@ double checkTPSL(double bid, double ask, int i, int shift1, CRates *rates0, int*
 					openOrders[i].closePrice = openOrders[i].stopLoss;
 				}
 
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"BUY Order hit SL. Ticket = %f", openOrders[i].ticket);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "BUY Order hit SL. Ticket = %f", openOrders[i].ticket);
 				touchedTPSL = true;
 				triggeredSL = true;
 			}
 			
 			if ((openOrders[i].takeProfit<=rates0[shift1].high || openOrders[i].takeProfit<=bid) && !triggeredSL && openOrders[i].takeProfit != 0){
 				openOrders[i].closePrice = openOrders[i].takeProfit;
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"BUY Order hit TP. Ticket = %f", openOrders[i].ticket);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "BUY Order hit TP. Ticket = %f", openOrders[i].ticket);
 				touchedTPSL = true;
 			}
 		}
@@ -478,13 +558,13 @@ double checkTPSL(double bid, double ask, int i, int shift1, CRates *rates0, int*
 					openOrders[i].closePrice = openOrders[i].stopLoss;
 				}
 
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"SELL Order hit SL. Ticket = %f", openOrders[i].ticket);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "SELL Order hit SL. Ticket = %f", openOrders[i].ticket);
 				triggeredSL = true;
 				touchedTPSL = true;
 			}
 
 			if((openOrders[i].takeProfit>=rates0[shift1].low+spread || openOrders[i].takeProfit>=ask) && !triggeredSL && openOrders[i].takeProfit != 0){
-				pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"SELL Order hit TP. Ticket = %f", openOrders[i].ticket);
+				ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "SELL Order hit TP. Ticket = %f", openOrders[i].ticket);
 				openOrders[i].closePrice = openOrders[i].takeProfit;
 				touchedTPSL = true;
 			}
@@ -555,7 +635,7 @@ int addInterest(int* openOrdersCount, COrderInfo* openOrders, int instanceId, in
 			(openOrders[i].instanceId == instanceId) && 
 			//(timeInfo.tm_hour == 17 ) && 
 			//(timeInfo.tm_min == 0) &&
-			(currentTime - lastInterestAdditionTime > 3600)
+			(currentTime - lastInterestAdditionTime > SWAP_ACCRUAL_INTERVAL)
 			){	
 			//if(openOrders[i].type == BUY)  swapInterest = (swapLong/(365*100))*contractSize*openOrders[i].lots;
 			//if(openOrders[i].type == SELL) swapInterest = (swapShort/(365*100))*contractSize*openOrders[i].lots;
@@ -566,7 +646,7 @@ int addInterest(int* openOrdersCount, COrderInfo* openOrders, int instanceId, in
 
 			if(timeInfo.tm_wday == 3) swapInterest *= 3;	
 
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Adding Swap interest = %lf, swapLong = %lf, swapShort = %lf, hours = %d, dayOfweek = %d, contractSize = %lf, volume = %lf BidAsk = %lf/%lf", swapInterest, swapLong, swapShort, timeInfo.tm_hour, timeInfo.tm_wday, contractSize, openOrders[i].lots, bidAsk[IDX_BID], bidAsk[IDX_ASK]);
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Adding Swap interest = %lf, swapLong = %lf, swapShort = %lf, hours = %d, dayOfweek = %d, contractSize = %lf, volume = %lf BidAsk = %lf/%lf", swapInterest, swapLong, swapShort, timeInfo.tm_hour, timeInfo.tm_wday, contractSize, openOrders[i].lots, bidAsk[IDX_BID], bidAsk[IDX_ASK]);
 			openOrders[i].swap += swapInterest; 
 			newAdditionTime = currentTime;
 		}
@@ -966,6 +1046,31 @@ void calculate_weekly_statistics(StatisticItem *statistics,
     
 }
 
+/* Values every open order at the last price seen by its system and appends the portfolio balance, equity and margin. */
+static void captureEquityCurvePoint(EquityCurve* pCurve, int time, double balance, int* openOrdersCount, COrderInfo* openOrders, double** pInSettings, double** pInAccountInfo, int numSystems, const double* lastBid, const double* lastAsk, const double* lastConversion)
+{
+	double floating = 0, margin = 0, orderSize;
+	int n, s, orderIndex = openOrdersCount[BUY] + openOrdersCount[SELL];
+
+	for(n = 0; n < orderIndex; n++){
+		if (openOrders[n].isOpen != 1 || (openOrders[n].type != BUY && openOrders[n].type != SELL)) continue;
+
+		for(s = 0; s < numSystems && (int)pInSettings[s][STRATEGY_INSTANCE_ID] != (int)openOrders[n].instanceId; s++);
+		if (s == numSystems || lastConversion[s] == 0) continue;
+
+		orderSize = openOrders[n].lots*pInAccountInfo[s][IDX_CONTRACT_SIZE]*lastConversion[s];
+
+		if (openOrders[n].type == BUY)
+			floating += (lastBid[s] - openOrders[n].openPrice)*orderSize;
+		else
+			floating += (openOrders[n].openPrice - lastAsk[s])*orderSize;
+
+		margin += orderSize/pInAccountInfo[s][IDX_LEVERAGE];
+	}
+
+	addEquityCurvePoint(pCurve, time, balance, balance + floating, margin);
+}
+
 TestResult __stdcall runPortfolioTest (
 	int				testId,
 	double**		pInSettings,
@@ -984,6 +1089,30 @@ TestResult __stdcall runPortfolioTest (
 	void			(*testFinished)(TestResult testResults), 
 	void			(*signalUpdate)(TradeSignal signal)
 	)
+{
+	return runPortfolioTestWithEquityCurve(testId, pInSettings, pInTradeSymbol, pInAccountCurrency, pInBrokerName, pInRefBrokerName, pInAccountInfo, testSettings, pRatesInfo, 
+		numCandles, numSystems, pRates, minLotSize, testUpdate, testFinished, signalUpdate, NULL);
+}
+
+TestResult __stdcall runPortfolioTestWithEquityCurve (
+	int				testId,
+	double**		pInSettings,
+	char**			pInTradeSymbol,
+    char*			pInAccountCurrency,
+    char*			pInBrokerName,
+	char*			pInRefBrokerName,
+    double**			pInAccountInfo,
+	TestSettings	*testSettings,
+	CRatesInfo**	pRatesInfo,
+	int				numCandles,
+	int				numSystems,
+    ASTRates***		pRates,
+	double			minLotSize,
+	void			(*testUpdate)(int testId, double percentageOfTestCompleted, COrderInfo lastOrder, double currentBalance, char* symbol), 
+	void			(*testFinished)(TestResult testResults), 
+	void			(*signalUpdate)(TradeSignal signal),
+	EquityCurve*	pEquityCurve
+	)
 { 
 	//Test variables
 	int		j, n, m, s, openOrdersCount[2] = {0}, openOrdersCountSystem[2] = {0}, operation, tries;
@@ -1007,6 +1136,11 @@ TestResult __stdcall runPortfolioTest (
 	int* i;
 	int* testsFinished;
 	int lastInterestAdditionTime = 0;
+	int newInterestAdditionTime;
+	TimerWheel* timerWheels;
+	WheelTimer* swapTimers;
+	BOOL*       swapDue;
+	int         system;
 	//Statistics variables
     double conversionRate;
 	double  finalBalance;
@@ -1017,6 +1151,11 @@ TestResult __stdcall runPortfolioTest (
 	int totalOrders = 0;
 	int lastTradeIndex;
 	int *numSignals;
+	//Equity curve variables
+	double* lastBid = NULL;
+	double* lastAsk = NULL;
+	double* lastConversion = NULL;
+	int     captureTime = 0, lastCaptureTime = 0;
 	
 	TradeSignal lastSignal = {0};
 	
@@ -1033,11 +1172,15 @@ TestResult __stdcall runPortfolioTest (
 	FILE** tickFiles;
 	FILE** baseFiles;
 	FILE** quoteFiles;
+	QuoteSeries* baseSeries;
+	QuoteSeries* quoteSeries;
+	TimeIndex*   barIndex;
+	int          firstTestBar;
 	
 	char data[200] = "";
 	char *ptr;
 	char *timeString;
-	struct tm lDate;
+	struct tm lDate, dateInfo;
 	char date[20] = "";
 	time_t currentDateTime;
     char *strtokSave;
@@ -1056,7 +1199,7 @@ TestResult __stdcall runPortfolioTest (
 
 	for (n=0; n<numSystems; n++){
 		sprintf (buffer, "%s_TICK.csv", pInTradeSymbol[n]);
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Searching for tick data: %s", buffer);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Searching for tick data: %s", buffer);
 		tickFiles[n] = NULL;
 		tickFiles[n] = fopen(buffer , "r+" );
 	}
@@ -1077,9 +1220,21 @@ TestResult __stdcall runPortfolioTest (
 
 	quoteFiles = (FILE**)malloc(numSystems * sizeof(FILE*));
 	baseFiles = (FILE**)malloc(numSystems * sizeof(FILE*));
+	quoteSeries = (QuoteSeries*)calloc(numSystems, sizeof(QuoteSeries));
+	baseSeries = (QuoteSeries*)calloc(numSystems, sizeof(QuoteSeries));
+	barIndex = (TimeIndex*)calloc(numSystems, sizeof(TimeIndex));
+	timerWheels = (TimerWheel*)malloc(numSystems * sizeof(TimerWheel));
+	swapTimers = (WheelTimer*)malloc(numSystems * sizeof(WheelTimer));
+	swapDue = (BOOL*)malloc(numSystems * sizeof(BOOL));
 	quoteSymbols = (char**)malloc(numSystems * sizeof(char*));
 	baseSymbols = (char**)malloc(numSystems * sizeof(char*));
 
+	if(pEquityCurve != NULL){
+		clearEquityCurve(pEquityCurve);
+		lastBid = (double*)calloc(numSystems, sizeof(double));
+		lastAsk = (double*)calloc(numSystems, sizeof(double));
+		lastConversion = (double*)calloc(numSystems, sizeof(double));
+	}
 	
 	rates = (CRates***)malloc(sizeof(CRates**) * numSystems);
 
@@ -1103,22 +1258,22 @@ TestResult __stdcall runPortfolioTest (
 			numBarsRequired[j][n] = (int)(pRatesInfo[j][n].totalBarsRequired * 1.2 * pRatesInfo[j][n].requiredTimeframe/pRatesInfo[j][n].actualTimeframe);
 		}
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Bar requirements for all rates:");
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Bar requirements for all rates:");
 
 		for (n=0;n<10;n++){
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"rates %d = %d bars", n, numBarsRequired[j][n]);
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "rates %d = %d bars", n, numBarsRequired[j][n]);
 			pRatesInfo[j][n].ratesArraySize = numBarsRequired[j][n];
 			if (numBarsRequired[j][n] > maxNumbarsRequired) maxNumbarsRequired = numBarsRequired[j][n];
 		}
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"-- strategy settings --");
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "-- strategy settings --");
 		for (n=0;n<64;n++){
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Setting No.%d = %lf", n, pInSettings[j][n]);
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Setting No.%d = %lf", n, pInSettings[j][n]);
 		}
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"-- Pairs loaded --");
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "-- Pairs loaded --");
 		for (n=0;n<numSystems;n++){
-			pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Symbol No.%d= %s", n, pInTradeSymbol[n]);
+			ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Symbol No.%d= %s", n, pInTradeSymbol[n]);
 		}
 
 	if(signalUpdate != NULL) numSignals[j] = 1;
@@ -1158,7 +1313,7 @@ TestResult __stdcall runPortfolioTest (
 	}
 
 	// get base/quote symbols for all systems
-    pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Starting base/quote symbol extraction");
+    ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Starting base/quote symbol extraction");
 	
 	for (n=0; n<numSystems; n++){
 
@@ -1196,6 +1351,10 @@ TestResult __stdcall runPortfolioTest (
 			baseFiles[n] = fopen(buffer , "r" );
 			if (baseFiles[n] == NULL) {
     			pantheios_logprintf(PANTHEIOS_SEV_EMERGENCY, (PAN_CHAR_T*)"Error. Quotes for base symbol %s not found. Trading results will be inaccurate.", baseSymbols[n]);
+			} else {
+				loadQuoteSeries(baseFiles[n], &baseSeries[n]);
+				fclose(baseFiles[n]);
+				baseFiles[n] = NULL;
 			}
 		}
 
@@ -1205,19 +1364,35 @@ TestResult __stdcall runPortfolioTest (
 			quoteFiles[n] = fopen(buffer , "r" );
 			if (quoteFiles[n] == NULL) {
     			pantheios_logprintf(PANTHEIOS_SEV_EMERGENCY, (PAN_CHAR_T*)"Error. Quotes for quote symbol %s not found. Trading results will be inaccurate.",  quoteSymbols[n]);
+			} else {
+				loadQuoteSeries(quoteFiles[n], &quoteSeries[n]);
+				fclose(quoteFiles[n]);
+				quoteFiles[n] = NULL;
 			}
 		}
 	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Starting main test loop. Max numbars required = %d, numCandles = %d", maxNumbarsRequired, numCandles);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Requested testing limits. StartDate = %d, EndDate = %d", testSettings[0].fromDate, testSettings[0].toDate);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Starting main test loop. Max numbars required = %d, numCandles = %d", maxNumbarsRequired, numCandles);
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Requested testing limits. StartDate = %d, EndDate = %d", testSettings[0].fromDate, testSettings[0].toDate);
 
 	for(s = 0; s<numSystems; s++){
 	rates[s][0] = (CRates*)malloc(sizeof(CRates) * numBarsRequired[s][0]);
 	i[s] = maxNumbarsRequired - 1;
+
+	// Start directly at the bar preceding fromDate instead of walking every bar before it.
+	// The strategy cannot run before fromDate so no orders can exist on the skipped bars.
+	initTimeIndex(&barIndex[s], &pRates[s][0][0].time, sizeof(ASTRates), sizeof(int), numCandles);
+	firstTestBar = timeIndexLowerBound(&barIndex[s], testSettings[s].fromDate) - 1;
+	if (firstTestBar > i[s]) i[s] = firstTestBar;
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System No.%d starts at bar %d", s, i[s]);
 	lastProcessedBar[s] = 0;
 	testsFinished[s] = 0;
 
+	initTimerWheel(&timerWheels[s], 0);
+	initWheelTimer(&swapTimers[s], s);
+	scheduleWheelTimer(&timerWheels[s], &swapTimers[s], lastInterestAdditionTime + SWAP_ACCRUAL_INTERVAL + 1);
+	swapDue[s] = false;
+
 		for (n = 1; n < 10; n++){
 			if (numBarsRequired[s][n] > 0){
 			rates[s][n] = (CRates*)malloc(sizeof(CRates) * numBarsRequired[s][n]);
@@ -1244,7 +1419,7 @@ TestResult __stdcall runPortfolioTest (
 				continue;
 			}
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"bar = %d, finishedCount = %d, numSystem = %d", i[s], finishedCount, s);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "bar = %d, finishedCount = %d, numSystem = %d", i[s], finishedCount, s);
 
 		currentBrokerTime = 0;
 
@@ -1275,7 +1450,7 @@ TestResult __stdcall runPortfolioTest (
 			sscanf(ptr,"%d",&lDate.tm_sec);
 
 			currentDateTime = mkgmtime(lDate.tm_year, lDate.tm_mon, lDate.tm_mday, lDate.tm_hour, lDate.tm_min, lDate.tm_sec);
-			strftime(date, 20, "%d/%m/%Y %H:%M:%S", gmtime(&currentDateTime));
+			strftime(date, 20, "%d/%m/%Y %H:%M:%S", safe_gmtime(&dateInfo, currentDateTime));
 			
 			currentBrokerTime = (int)currentDateTime;
 			}
@@ -1299,6 +1474,12 @@ TestResult __stdcall runPortfolioTest (
 			lastDate = testSettings[s].toDate; 
 		}
 
+		// Past toDate the strategy no longer runs, so once the system is flat nothing can change.
+		if ((pRates[s][0][i[s]].time >= testSettings[s].toDate) && !hasOpenOrders(openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID])){
+			testsFinished[s] = 1;
+			continue;
+		}
+
 		abortTest = false;
 
 		// reset strategy results
@@ -1317,38 +1498,9 @@ TestResult __stdcall runPortfolioTest (
 
 		// we should now get quote currency values if necessary
 
-		if(quoteFiles[s] != NULL){	
-
-			currentDateTime = 0;
-
-			while ( (int)currentDateTime < (int)pRates[s][0][i[s]].time){
-
-			if (fgets(data, 200, quoteFiles[s]) == NULL) break;
-
-			timeString = strtok_r(data, ",", &strtokSave);
-
-			ptr = strtok_r(NULL, ",", &strtokSave);
-			sscanf(ptr,"%lf",&bidAsk[IDX_QUOTE_CONVERSION_BID]);
+		if(quoteSeries[s].size > 0){
+			bidAsk[IDX_QUOTE_CONVERSION_BID] = seekQuote(&quoteSeries[s], pRates[s][0][i[s]].time);
 			bidAsk[IDX_QUOTE_CONVERSION_ASK] = bidAsk[IDX_QUOTE_CONVERSION_BID];
-
-			ptr = strtok_r(timeString, "/", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_mday);
-			ptr = strtok_r(NULL, "/", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_mon);
-			ptr = strtok_r(NULL, " ", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_year);
-			ptr = strtok_r(NULL, ":", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_hour);
-			ptr = strtok_r(NULL, " ", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_min);
-
-			lDate.tm_sec = 0;
-
-			if(lDate.tm_year < 50) lDate.tm_year += 2000 ; else lDate.tm_year += 1900;
-
-			currentDateTime = mkgmtime(lDate.tm_year, lDate.tm_mon, lDate.tm_mday, lDate.tm_hour, lDate.tm_min, lDate.tm_sec);
-			strftime(date, 20, "%d/%m/%Y %H:%M:%S", gmtime(&currentDateTime));
-			}
 		} else {
             bidAsk[IDX_QUOTE_CONVERSION_ASK] = 1;  
             bidAsk[IDX_QUOTE_CONVERSION_BID] = 1; 
@@ -1356,38 +1508,9 @@ TestResult __stdcall runPortfolioTest (
 
 		// we should now get base currency values if necessary
 
-		if(baseFiles[s] != NULL){	
-
-			currentDateTime = 0;
-
-			while ( (int)currentDateTime < (int)pRates[s][0][i[s]].time){
-
-			if (fgets(data, 200, baseFiles[s]) == NULL) break;
-
-			timeString = strtok_r(data, ",", &strtokSave);
-
-			ptr = strtok_r(NULL, ",", &strtokSave);
-			sscanf(ptr,"%lf",&bidAsk[IDX_BASE_CONVERSION_BID]);
+		if(baseSeries[s].size > 0){
+			bidAsk[IDX_BASE_CONVERSION_BID] = seekQuote(&baseSeries[s], pRates[s][0][i[s]].time);
 			bidAsk[IDX_BASE_CONVERSION_ASK] = bidAsk[IDX_BASE_CONVERSION_BID];
-
-			ptr = strtok_r(timeString, "/", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_mday);
-			ptr = strtok_r(NULL, "/", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_mon);
-			ptr = strtok_r(NULL, " ", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_year);
-			ptr = strtok_r(NULL, ":", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_hour);
-			ptr = strtok_r(NULL, " ", &strtokSave);
-			sscanf(ptr,"%d",&lDate.tm_min);
-
-			lDate.tm_sec = 0;
-
-			if(lDate.tm_year < 50) lDate.tm_year += 2000 ; else lDate.tm_year += 1900;
-
-			currentDateTime = mkgmtime(lDate.tm_year, lDate.tm_mon, lDate.tm_mday, lDate.tm_hour, lDate.tm_min, lDate.tm_sec);
-			strftime(date, 20, "%d/%m/%Y %H:%M:%S", gmtime(&currentDateTime));
-			}
 		} else {
             bidAsk[IDX_BASE_CONVERSION_ASK] = 1;  
             bidAsk[IDX_BASE_CONVERSION_BID] = 1; 
@@ -1496,6 +1619,13 @@ TestResult __stdcall runPortfolioTest (
         }
 
 		pInAccountInfo[s][IDX_EQUITY] = calculateAccountEquity(pInAccountInfo[s], openOrdersCount, openOrders, conversionRate);
+
+		if(pEquityCurve != NULL){
+			lastBid[s] = bidAsk[IDX_BID];
+			lastAsk[s] = bidAsk[IDX_ASK];
+			lastConversion[s] = conversionRate;
+			if ((int)pRates[s][0][i[s]].time > captureTime) captureTime = (int)pRates[s][0][i[s]].time;
+		}
         
 		for(m=0; m<openOrdersCount[BUY] + openOrdersCount[SELL]; m++){
 			checkPending(bidAsk[IDX_BID], bidAsk[IDX_ASK], m, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], currentBrokerTime, numCandles, i[s]-1, pRates[s][0], testUpdate != NULL, testSettings[0].is_calculate_expectancy);
@@ -1508,7 +1638,20 @@ TestResult __stdcall runPortfolioTest (
 				}
 		}
 
-		lastInterestAdditionTime = addInterest(openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], (int)currentBrokerTime, (int)pInAccountInfo[s][IDX_CONTRACT_SIZE], swapLong, swapShort, bidAsk, lastInterestAdditionTime);
+		advanceTimerWheel(&timerWheels[s], currentBrokerTime, onSwapTimer, swapDue);
+
+		if (swapDue[s]){
+			newInterestAdditionTime = addInterest(openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], (int)currentBrokerTime, (int)pInAccountInfo[s][IDX_CONTRACT_SIZE], swapLong, swapShort, bidAsk, lastInterestAdditionTime);
+
+			// The accrual time is shared by all systems, so all of them wait for the next interval again.
+			if (newInterestAdditionTime != lastInterestAdditionTime){
+				lastInterestAdditionTime = newInterestAdditionTime;
+				for (system = 0; system < numSystems; system++){
+					swapDue[system] = false;
+					scheduleWheelTimer(&timerWheels[system], &swapTimers[system], lastInterestAdditionTime + SWAP_ACCRUAL_INTERVAL + 1);
+				}
+			}
+		}
 
 		for (m=0;m<MAX_ORDERS;m++){
 			systemOrders[m].instanceId = 0;
@@ -1567,9 +1710,9 @@ TestResult __stdcall runPortfolioTest (
 					if ((operation & SIGNAL_OPEN_BUYLIMIT) != 0) updateOrderType = BUYLIMIT;
 					if ((operation & SIGNAL_OPEN_BUYSTOP) != 0) updateOrderType = BUYSTOP;
 
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"BUY signal type %d. Instance ID = %d", (int)updateOrderType, (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "BUY signal type %d. Instance ID = %d", (int)updateOrderType, (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 					openOrder(&strategyResults[m], openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], &totalTrades, currentBrokerTime, bidAsk[IDX_ASK], (int)updateOrderType,lastSignal, numSignals, finalBalance, minLotSize, pInAccountInfo[s][IDX_MINIMUM_STOP]);
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Open Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].ticket, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].instanceId, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].openPrice, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].stopLoss, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].takeProfit);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Open Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].ticket, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].instanceId, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].openPrice, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].stopLoss, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].takeProfit);
 					numLongs++;
 
 
@@ -1584,7 +1727,7 @@ TestResult __stdcall runPortfolioTest (
 					if ((operation & SIGNAL_CLOSE_BUYLIMIT) != 0) updateOrderType = BUYLIMIT;
 					if ((operation & SIGNAL_CLOSE_BUYSTOP) != 0) updateOrderType = BUYSTOP;
 
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Close BUY Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Close BUY Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 					if (closeOrder(&strategyResults[m], openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], currentBrokerTime, bidAsk[IDX_BID], &lastOrder, pInTradeSymbol[s], (int)updateOrderType, &profit, pInAccountInfo[s][IDX_CONTRACT_SIZE], globalSignalUpdate,lastSignal, numSignals, finalBalance, conversionRate, &testResult.avgTradeDuration)){
 						finalBalance += profit;
 						if(is_optimization == FALSE){
@@ -1603,7 +1746,7 @@ TestResult __stdcall runPortfolioTest (
 				}
 				if((operation & SIGNAL_UPDATE_BUY) != 0 || (operation & SIGNAL_UPDATE_BUYLIMIT) != 0 || (operation & SIGNAL_UPDATE_BUYSTOP) != 0)
 				{
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Update BUY Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Update BUY Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 					
 					if ((operation & SIGNAL_UPDATE_BUY) != 0) updateOrderType = BUY;
 					if ((operation & SIGNAL_UPDATE_BUYLIMIT) != 0) updateOrderType = BUYLIMIT;
@@ -1619,9 +1762,9 @@ TestResult __stdcall runPortfolioTest (
 					if ((operation & SIGNAL_OPEN_SELLLIMIT) != 0) updateOrderType = SELLLIMIT;
 					if ((operation & SIGNAL_OPEN_SELLSTOP) != 0) updateOrderType = SELLSTOP;
 
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"SELL signal type %d. Instance ID = %d", (int)updateOrderType, (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "SELL signal type %d. Instance ID = %d", (int)updateOrderType, (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 					openOrder(&strategyResults[m], openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], &totalTrades, currentBrokerTime, bidAsk[IDX_BID], (int)updateOrderType,lastSignal, numSignals, finalBalance, minLotSize, pInAccountInfo[s][IDX_MINIMUM_STOP]);
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Open Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].ticket, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].instanceId, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].openPrice, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].stopLoss, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].takeProfit);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Open Order. ticket = %lf, instanceID = %lf, Entry = %lf, SL = %lf, TP =%lf", openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].ticket, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].instanceId, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].openPrice, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].stopLoss, openOrders[openOrdersCount[BUY]+openOrdersCount[SELL]-1].takeProfit);
 					numShorts++;
 
 					if(is_optimization == FALSE && updateOrderType == SELL) calculate_mathematical_expectancy(SELL, numCandles, i[s], bidAsk[IDX_BID], pRates[s][0], fabs(bidAsk[IDX_ASK]-bidAsk[IDX_BID]), testSettings[0].is_calculate_expectancy) ;
@@ -1633,7 +1776,7 @@ TestResult __stdcall runPortfolioTest (
 					if ((operation & SIGNAL_CLOSE_SELLLIMIT) != 0) updateOrderType = SELLLIMIT;
 					if ((operation & SIGNAL_CLOSE_SELLSTOP) != 0) updateOrderType = SELLSTOP;
 
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Close SELL Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Close SELL Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 					if (closeOrder(&strategyResults[m], openOrdersCount, openOrders, (int)pInSettings[s][STRATEGY_INSTANCE_ID], currentBrokerTime, bidAsk[IDX_ASK], &lastOrder, pInTradeSymbol[s], (int)updateOrderType, &profit, pInAccountInfo[s][IDX_CONTRACT_SIZE], globalSignalUpdate,lastSignal, numSignals, finalBalance, conversionRate, &testResult.avgTradeDuration)){
 						finalBalance += profit;
 						if(is_optimization == FALSE){
@@ -1651,7 +1794,7 @@ TestResult __stdcall runPortfolioTest (
 				}
 				if((operation & SIGNAL_UPDATE_SELL) != 0 || (operation & SIGNAL_UPDATE_SELLLIMIT) != 0 || (operation & SIGNAL_UPDATE_SELLSTOP) != 0)
 				{
-					pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Update SELL Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
+					ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Update SELL Signal. Instance ID = %d", (int)pInSettings[s][STRATEGY_INSTANCE_ID]);
 
 					if ((operation & SIGNAL_UPDATE_SELL) != 0) updateOrderType = SELL;
 					if ((operation & SIGNAL_UPDATE_SELLLIMIT) != 0) updateOrderType = SELLLIMIT;
@@ -1673,6 +1816,12 @@ TestResult __stdcall runPortfolioTest (
 
 		}	
 
+		// one point per bar of the portfolio, after every system has processed it
+		if (pEquityCurve != NULL && captureTime > lastCaptureTime){
+			captureEquityCurvePoint(pEquityCurve, captureTime, finalBalance, openOrdersCount, openOrders, pInSettings, pInAccountInfo, numSystems, lastBid, lastAsk, lastConversion);
+			lastCaptureTime = captureTime;
+		}
+
 		finishedCount = 0;
 
 		for(s = 0; s<numSystems; s++){
@@ -1743,6 +1892,13 @@ TestResult __stdcall runPortfolioTest (
     save_statistics_to_file(testResult, finalBalance, initialBalance);
         }
     
+    if(pEquityCurve != NULL){
+		if (pEquityCurve->overflowPoints > 0){
+			pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"runPortfolioTest() Equity curve full, %d bars were not captured. Allocate it with at least numCandles points.", pEquityCurve->overflowPoints);
+		}
+		downsampleEquityCurve(pEquityCurve);
+	}
+
     if(testFinished!=NULL) {
 		testFinished(testResult); // callback finish test function
 	}
@@ -1763,6 +1919,10 @@ TestResult __stdcall runPortfolioTest (
 		if (baseFiles[s] != NULL)
 		fclose(baseFiles[s]);
 
+		freeQuoteSeries(&quoteSeries[s]);
+		freeQuoteSeries(&baseSeries[s]);
+		freeTimeIndex(&barIndex[s]);
+
 		free(baseSymbols[s]); baseSymbols[s] = NULL;
 		free(quoteSymbols[s]); quoteSymbols[s] = NULL;
 	}
@@ -1772,10 +1932,19 @@ TestResult __stdcall runPortfolioTest (
 	free(tickFiles); tickFiles = NULL;
 	free(quoteFiles); quoteFiles = NULL;
 	free(baseFiles); baseFiles = NULL;
+	free(quoteSeries); quoteSeries = NULL;
+	free(baseSeries); baseSeries = NULL;
+	free(barIndex); barIndex = NULL;
+	free(timerWheels); timerWheels = NULL;
+	free(swapTimers); swapTimers = NULL;
+	free(swapDue); swapDue = NULL;
 	free(baseSymbols); baseSymbols = NULL;
 	free(quoteSymbols); quoteSymbols = NULL;
 	free(rates); rates = NULL;
 	free(lastProcessedBar); lastProcessedBar = NULL;
+	free(lastBid); lastBid = NULL;
+	free(lastAsk); lastAsk = NULL;
+	free(lastConversion); lastConversion = NULL;
     
 	free(statistics); statistics = NULL;
 	
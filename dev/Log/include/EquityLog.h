@@ -44,22 +44,38 @@
   #include "AsirikuyDefines.h"
 #endif
 
+#define EQUITY_SERIES_CAPACITY 8192 /* Daily samples kept in memory per instance. The oldest ones are discarded first. */
+#define EQUITY_LOG_BATCH_SIZE  32   /* Samples collected in a backtest before they are handed to the flusher */
+
+/* One line of the equity log. */
+typedef struct equitySample_t
+{
+  time_t time;      /* Time of the first tick of the next day */
+  double equityMin; /* Lowest equity of the day */
+  double profit;    /* Change of the lowest equity since the previous day */
+} EquitySample;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
-* Writes an entry to the equity log.
+* Samples the equity of an instance.
 *
-* The equity log will be opened and initialized
-* the first time this function is called.
+* The lowest equity of each day is always added to the series of the instance.
+* When the equity log is enabled, it is also written to the log of the instance
+* by a background thread. The log is opened the first time this function is
+* called for the instance.
 *
 * @param time_t currentTime
-*   The open time of the current daily bar.
+*   The current broker time.
 *
 * @param double accountEquity
 *   The current account equity.
 *
+* @param StrategyParams* pParams
+*   The parameters of the instance.
+*
 * @return AsirikuyReturnCode
 *   An enum indicating success or the type of failure that occured.
 */
@@ -72,13 +88,40 @@ AsirikuyReturnCode writeEquityLog(time_t currentTime, double accountEquity, Stra
 *   TRUE = enabled, FALSE = disabled
 *
 * @param const char* folderName
-*   The folder to store the equity log in.
+*   The folder to store the equity logs in.
 */
 void initEquityLog(BOOL enableEquityLog, const char* folderName);
 
 /**
-* Closes the equity log releasing the file handle.
+* Copies the equity series of an instance, oldest sample first.
+*
+* @param int instanceId
+*   The instance ID.
 *
+* @param EquitySample* pSamples
+*   Receives the newest samples. May be NULL to only count them.
+*
+* @param int maxSamples
+*   Size of pSamples.
+*
+* @param int* pTotalSamples
+*   Receives the number of samples in the series.
+*
+* @return AsirikuyReturnCode
+*   NULL_POINTER if pTotalSamples is NULL.
+*/
+AsirikuyReturnCode getEquitySeries(int instanceId, EquitySample* pSamples, int maxSamples, int* pTotalSamples);
+
+/**
+* Writes the samples of an instance that are still pending, closes its equity log and discards its series.
+*
+* @param int instanceId
+*   The instance ID.
+*/
+void closeInstanceEquityLog(int instanceId);
+
+/**
+* Closes the equity log of every instance and stops the background thread.
 */
 void closeEquityLog();
 
@@ -0,0 +1,179 @@
+/**
+ * @file
+ * @brief     Binary recorder of entry bar feature vectors.
+ * @details   Records are fixed-width rows of doubles described by a schema header, so any column can be read with a fixed stride.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef FEATURE_RECORDER_H_
+#define FEATURE_RECORDER_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#define FEATURE_FILE_MAGIC   0x31524641 /* "AFR1" */
+#define FEATURE_FILE_VERSION 1
+#define FEATURE_NAME_SIZE    24
+#define MAX_FEATURE_COLUMNS  64
+
+typedef enum featureType_t
+{
+  FEATURE_INT    = 0, /* Exported with %d */
+  FEATURE_DOUBLE = 1  /* Exported with %lf */
+} FeatureType;
+
+typedef struct featureColumn_t
+{
+  char    name[FEATURE_NAME_SIZE]; /* Exported with the bar index appended */
+  int32_t type;
+} FeatureColumn;
+
+/* Followed by totalColumns FeatureColumn and then by the records. */
+typedef struct featureFileHeader_t
+{
+  int32_t magic;
+  int32_t version;
+  int32_t totalColumns; /* Per bar */
+  int32_t barNumber;    /* Bars per record */
+  int32_t recordSize;   /* Bytes per record */
+} FeatureFileHeader;
+
+/* Followed by barNumber * totalColumns doubles, the bar at index 0 first. */
+typedef struct featureRecordKey_t
+{
+  int32_t ticket;
+  int32_t instanceId;
+  int32_t entryTime;
+  int32_t positionType;
+} FeatureRecordKey;
+
+typedef struct featureRecorder_t
+{
+  char     path[MAX_FILE_PATH_CHARS];
+  int      totalColumns;
+  int      barNumber;
+  int      recordSize;
+  int      totalRecords;
+  int32_t* pTickets;       /* Open addressing hash set of the recorded tickets */
+  int      ticketCapacity; /* A power of 2 */
+} FeatureRecorder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Creates a feature file, replacing any existing one, and writes its schema header.
+*
+* @param FeatureRecorder* pRecorder
+*   The recorder to open.
+*
+* @param const char* pPath
+*   Path of the feature file.
+*
+* @param const FeatureColumn* pColumns
+*   The columns of a bar.
+*
+* @param int totalColumns
+*   The number of columns of a bar, up to MAX_FEATURE_COLUMNS.
+*
+* @param int barNumber
+*   The number of bars in each record.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the file could not be created.
+*/
+AsirikuyReturnCode openFeatureRecorder(FeatureRecorder* pRecorder, const char* pPath, const FeatureColumn* pColumns, int totalColumns, int barNumber);
+
+/**
+* Checks whether a ticket was already recorded, so its features don't need to be computed again.
+*
+* @param const FeatureRecorder* pRecorder
+*   An open recorder.
+*
+* @param int ticket
+*   The ticket of the entry.
+*
+* @return BOOL
+*   TRUE if the ticket has a record.
+*/
+BOOL isFeatureRecorded(const FeatureRecorder* pRecorder, int ticket);
+
+/**
+* Appends the record of an entry unless its ticket already has one.
+*
+* @param FeatureRecorder* pRecorder
+*   An open recorder.
+*
+* @param const FeatureRecordKey* pKey
+*   Identifies the entry.
+*
+* @param const double* pValues
+*   barNumber * totalColumns values, the bar at index 0 first.
+*
+* @return AsirikuyReturnCode
+*   FILE_WRITING_ERROR if the record could not be appended.
+*/
+AsirikuyReturnCode appendFeatureRecord(FeatureRecorder* pRecorder, const FeatureRecordKey* pKey, const double* pValues);
+
+/**
+* Releases the ticket set of a recorder. The file is left as it is.
+*
+* @param FeatureRecorder* pRecorder
+*   The recorder to close.
+*/
+void closeFeatureRecorder(FeatureRecorder* pRecorder);
+
+/**
+* Exports a feature file as csv, one line per record with a header line naming every column.
+*
+* @param const char* pPath
+*   Path of the feature file.
+*
+* @param const char* pCsvPath
+*   Path of the csv file, replaced if it exists.
+*
+* @param int* pExported
+*   Receives the number of exported records. May be NULL.
+*
+* @return AsirikuyReturnCode
+*   FILE_READING_ERROR if the feature file is missing or invalid, FILE_WRITING_ERROR if the csv could not be written.
+*/
+AsirikuyReturnCode exportFeatureFileCsv(const char* pPath, const char* pCsvPath, int* pExported);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* FEATURE_RECORDER_H_ */
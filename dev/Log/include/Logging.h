@@ -54,20 +54,31 @@ extern "C" {
 
 
 /**
-* Logs additional information for entry bars.
+* Logs additional information for entry bars. Each ticket is only recorded once.
 *
 * @param StrategyParams
 *   Strategy parameter structure
 *
+* @param int ticket
+*   Ticket of the entry order
+*
 * @param int positionType
 *   Entry position type
 *
 *
 */
-void recordData(StrategyParams* pParams, int positionType);
+void recordData(StrategyParams* pParams, int ticket, int positionType);
 
 void initExtendedEntryBarLog(BOOL enableEntryBarLog, int barNumber, const char* folderName);
 
+/**
+* Releases the entry bars cached for an instance and exports the entry bar records to ExtendedEntryLog.csv.
+*
+* @param int instanceId
+*   The instance being closed.
+*/
+void closeInstanceEntryBarLog(int instanceId);
+
 /**
 * Provides a string representation of an AsirikuyReturnCode.
 *
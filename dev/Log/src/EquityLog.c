@@ -40,24 +40,266 @@
 #include "EquityLog.h"
 #include "Logging.h"
 #include "AsirikuyTime.h"
-#include "CriticalSection.h"
+#include <float.h>
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  #include <process.h>
+  typedef HANDLE             FlusherHandle;
+  typedef SRWLOCK            FlusherLock;
+  typedef CONDITION_VARIABLE FlusherCondition;
+  #define FLUSHER_LOCK_INIT      SRWLOCK_INIT
+  #define FLUSHER_CONDITION_INIT CONDITION_VARIABLE_INIT
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  typedef pthread_t          FlusherHandle;
+  typedef pthread_mutex_t    FlusherLock;
+  typedef pthread_cond_t     FlusherCondition;
+  #define FLUSHER_LOCK_INIT      PTHREAD_MUTEX_INITIALIZER
+  #define FLUSHER_CONDITION_INIT PTHREAD_COND_INITIALIZER
+#else
+  #error "Unsupported operating system"
+#endif
 
 #define EQUITY_LOG_FILENAME "EquityLog.csv"
+#define MAX_EQUITY_LINE_CHARS 128
+
+typedef struct equityLog_t
+{
+  int           instanceId;       /* -1 if the log is free */
+  BOOL          isBacktesting;    /* Samples are written in batches rather than one by one */
+  int           currentDay;
+  time_t        timeOfEquityMin;
+  double        dailyEquityMin;
+  double        prevDailyEquityMin;
+  EquitySample* pSeries;          /* Ring of EQUITY_SERIES_CAPACITY samples */
+  int           firstSample;
+  int           totalSamples;
+  char*         pPending;         /* Lines not handed to the file yet */
+  size_t        pendingSize;
+  size_t        pendingCapacity;
+  int           pendingSamples;
+  BOOL          isFlushRequested;
+  BOOL          isWriting;        /* A thread is writing a chunk. Only that thread touches pFile. */
+  FILE*         pFile;
+  char          path[MAX_FILE_PATH_CHARS];
+} EquityLog;
+
+static BOOL             gEnableEquityLog = FALSE;
+static char             gEquityLogFolder[MAX_FILE_PATH_CHARS] = "";
+static EquityLog        gLogs[MAX_INSTANCES];
+static BOOL             gAreLogsInitialized = FALSE;
+static FlusherLock      gLock      = FLUSHER_LOCK_INIT;
+static FlusherCondition gCondition = FLUSHER_CONDITION_INIT; /* Signalled when a flush is requested, a chunk is written or the flusher stops */
+static FlusherHandle    gFlusher;
+static BOOL             gIsFlusherRunning  = FALSE;
+static BOOL             gIsFlusherStopping = FALSE;
+
+static void lockLogs()
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_lock(&gLock);
+#endif
+}
+
+static void unlockLogs()
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_unlock(&gLock);
+#endif
+}
+
+static void waitLogs()
+{
+#if defined _WIN32 || defined _WIN64
+  SleepConditionVariableSRW(&gCondition, &gLock, INFINITE, 0);
+#else
+  pthread_cond_wait(&gCondition, &gLock);
+#endif
+}
+
+static void wakeLogs()
+{
+#if defined _WIN32 || defined _WIN64
+  WakeAllConditionVariable(&gCondition);
+#else
+  pthread_cond_broadcast(&gCondition);
+#endif
+}
+
+/* Called with the lock held. */
+static EquityLog* findLog(int instanceId, BOOL isCreated)
+{
+  EquityLog* pFree = NULL;
+  int i;
+
+  if(!gAreLogsInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      memset(&gLogs[i], 0, sizeof(EquityLog));
+      gLogs[i].instanceId = -1;
+    }
+    gAreLogsInitialized = TRUE;
+  }
+
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gLogs[i].instanceId == instanceId)
+    {
+      return &gLogs[i];
+    }
+    if((pFree == NULL) && (gLogs[i].instanceId == -1))
+    {
+      pFree = &gLogs[i];
+    }
+  }
+
+  if(isCreated && (pFree != NULL))
+  {
+    pFree->instanceId = instanceId;
+    return pFree;
+  }
+
+  return NULL;
+}
+
+/* Called with the lock held. */
+static AsirikuyReturnCode appendPending(EquityLog* pLog, const char* pText)
+{
+  size_t length = strlen(pText);
+
+  if(pLog->pendingSize + length > pLog->pendingCapacity)
+  {
+    size_t capacity = 2 * (pLog->pendingSize + length) + EQUITY_LOG_BATCH_SIZE * MAX_EQUITY_LINE_CHARS;
+    char*  pBuffer  = (char*)realloc(pLog->pPending, capacity);
+
+    if(pBuffer == NULL)
+    {
+      return INSUFFICIENT_MEMORY;
+    }
+    pLog->pPending        = pBuffer;
+    pLog->pendingCapacity = capacity;
+  }
+
+  memcpy(pLog->pPending + pLog->pendingSize, pText, length);
+  pLog->pendingSize += length;
+  return SUCCESS;
+}
+
+/* Called with the lock held. Writes the pending lines without holding the lock. */
+static void writeChunk(EquityLog* pLog)
+{
+  char*  pChunk = pLog->pPending;
+  size_t size   = pLog->pendingSize;
+  FILE*  pFile;
+  BOOL   isWritten;
+
+  pLog->pPending         = NULL;
+  pLog->pendingSize      = 0;
+  pLog->pendingCapacity  = 0;
+  pLog->pendingSamples   = 0;
+  pLog->isFlushRequested = FALSE;
+  pLog->isWriting        = TRUE;
+  unlockLogs();
+
+  if(pLog->pFile == NULL)
+  {
+    pLog->pFile = fopen(pLog->path, "w");
+  }
+  pFile     = pLog->pFile;
+  isWritten = (pFile != NULL) && (fwrite(pChunk, 1, size, pFile) == size) && (fflush(pFile) == 0);
+  free(pChunk);
+
+  lockLogs();
+  pLog->isWriting = FALSE;
+  wakeLogs();
+
+  if(!isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"writeChunk() Failed to write the equity log of instance %d. Path = %s", pLog->instanceId, pLog->path);
+  }
+}
+
+static void runFlusher()
+{
+  lockLogs();
+  while(!gIsFlusherStopping)
+  {
+    EquityLog* pLog = NULL;
+    int i;
+
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      if((gLogs[i].instanceId != -1) && gLogs[i].isFlushRequested && !gLogs[i].isWriting)
+      {
+        pLog = &gLogs[i];
+        break;
+      }
+    }
+
+    if(pLog == NULL)
+    {
+      waitLogs();
+    }
+    else
+    {
+      writeChunk(pLog);
+    }
+  }
+  unlockLogs();
+}
+
+#if defined _WIN32 || defined _WIN64
+static unsigned __stdcall flusherEntry(void* pArgument)
+{
+  (void)pArgument;
+  runFlusher();
+  return 0;
+}
+#else
+static void* flusherEntry(void* pArgument)
+{
+  (void)pArgument;
+  runFlusher();
+  return NULL;
+}
+#endif
+
+/* Called with the lock held. */
+static BOOL startFlusher()
+{
+  if(gIsFlusherRunning)
+  {
+    return TRUE;
+  }
 
-static BOOL  gEnableEquityLog = FALSE;
-static FILE* gEquityLog = NULL;
-static char  gEquityLogPath[MAX_FILE_PATH_CHARS] = "";
+#if defined _WIN32 || defined _WIN64
+  gFlusher = (HANDLE)_beginthreadex(NULL, 0, flusherEntry, NULL, 0, NULL);
+  gIsFlusherRunning = (gFlusher != NULL);
+#else
+  gIsFlusherRunning = (pthread_create(&gFlusher, NULL, flusherEntry, NULL) == 0);
+#endif
+
+  if(!gIsFlusherRunning)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"startFlusher() Failed to start the equity log thread. Equity logs are written synchronously.");
+  }
+  return gIsFlusherRunning;
+}
 
 void initEquityLog(BOOL enableEquityLog, const char* folderName)
 {
-  strcat(gEquityLogPath, folderName);
-  strcat(gEquityLogPath, "/");
-  strcat(gEquityLogPath, EQUITY_LOG_FILENAME);
+  strcpy(gEquityLogFolder, folderName);
   gEnableEquityLog = enableEquityLog;
 
   if(gEnableEquityLog)
   {
-    pantheios_logprintf(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Equity log enabled. Path = %s", gEquityLogPath);
+    pantheios_logprintf(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Equity log enabled. Folder = %s", gEquityLogFolder);
   }
   else
   {
@@ -65,86 +307,235 @@ void initEquityLog(BOOL enableEquityLog, const char* folderName)
   }
 }
 
-static AsirikuyReturnCode openEquityLog(StrategyParams* pParams)
+/* Called with the lock held. */
+static AsirikuyReturnCode openEquityLog(EquityLog* pLog, StrategyParams* pParams)
 {
-  gEquityLog = fopen(gEquityLogPath, "w");
-  if(!gEquityLog)
+  char header[MAX_FILE_PATH_CHARS + 256];
+
+  pLog->pSeries = (EquitySample*)malloc(EQUITY_SERIES_CAPACITY * sizeof(EquitySample));
+  if(pLog->pSeries == NULL)
   {
-    return INIT_LOG_FAILED;
+    return INSUFFICIENT_MEMORY;
   }
 
-  fprintf(gEquityLog, "MaxAdaptiveCrit=0.0;MinAdaptiveCrit=0.0;Symbol=%s;Period=%d;Deposit=%lf;AccountRiskUnit=%lf;Spread=%lf;Digits=%d\n", pParams->tradeSymbol, (int) pParams->settings[TIMEFRAME], pParams->settings[ORIGINAL_EQUITY], pParams->settings[ACCOUNT_RISK_PERCENT], pParams->bidAsk.ask[0] - pParams->bidAsk.bid[0], pParams->ratesBuffers->rates[0].info.digits );
-  fprintf(gEquityLog, "Time;DailyEquityMin;Profit/Loss\n");
-  fprintf(gEquityLog, "-----------------------------------\n");
+  pLog->isBacktesting = (BOOL)pParams->settings[IS_BACKTESTING];
+  if(!gEnableEquityLog)
+  {
+    return SUCCESS;
+  }
 
-  return SUCCESS;
+  sprintf(pLog->path, "%s/%d_%s", gEquityLogFolder, pLog->instanceId, EQUITY_LOG_FILENAME);
+
+  sprintf(header, "MaxAdaptiveCrit=0.0;MinAdaptiveCrit=0.0;Symbol=%s;Period=%d;Deposit=%lf;AccountRiskUnit=%lf;Spread=%lf;Digits=%d\n", pParams->tradeSymbol, (int) pParams->settings[TIMEFRAME], pParams->settings[ORIGINAL_EQUITY], pParams->settings[ACCOUNT_RISK_PERCENT], pParams->bidAsk.ask[0] - pParams->bidAsk.bid[0], pParams->ratesBuffers->rates[0].info.digits );
+  strcat(header, "Time;DailyEquityMin;Profit/Loss\n");
+  strcat(header, "-----------------------------------\n");
+
+  return appendPending(pLog, header);
 }
 
-AsirikuyReturnCode writeEquityLog(time_t currentTime, double accountEquity, StrategyParams* pParams)
+/* Called with the lock held. */
+static AsirikuyReturnCode addSample(EquityLog* pLog, const struct tm* pTimeInfo, time_t time, double equityMin, double profit)
 {
-  static int    currentDay         = 0;
-  static time_t timeOfEquityMin    = 0;
-  static double dailyEquityMin     = 0;
-  static double prevDailyEquityMin = 0;
+  char          line[MAX_EQUITY_LINE_CHARS];
+  EquitySample* pSample;
 
-  double dailyEquityProfit = 0;
-  struct tm timeInfo;
-  AsirikuyReturnCode returnCode = SUCCESS;
+  if(pLog->totalSamples < EQUITY_SERIES_CAPACITY)
+  {
+    pSample = &pLog->pSeries[(pLog->firstSample + pLog->totalSamples) % EQUITY_SERIES_CAPACITY];
+    pLog->totalSamples++;
+  }
+  else
+  {
+    pSample = &pLog->pSeries[pLog->firstSample];
+    pLog->firstSample = (pLog->firstSample + 1) % EQUITY_SERIES_CAPACITY;
+  }
+  pSample->time      = time;
+  pSample->equityMin = equityMin;
+  pSample->profit    = profit;
 
   if(!gEnableEquityLog)
   {
-    return returnCode;
+    return SUCCESS;
+  }
+
+  sprintf(line, "%d.%.2d.%.2d %.2d:%.2d;%.2f;%.2f\n", pTimeInfo->tm_year + 1900, pTimeInfo->tm_mon + 1, pTimeInfo->tm_mday, pTimeInfo->tm_hour, pTimeInfo->tm_min, equityMin, profit);
+  pLog->pendingSamples++;
+  return appendPending(pLog, line);
+}
+
+AsirikuyReturnCode writeEquityLog(time_t currentTime, double accountEquity, StrategyParams* pParams)
+{
+  int        instanceId = (int)pParams->settings[STRATEGY_INSTANCE_ID];
+  struct tm  timeInfo;
+  EquityLog* pLog;
+  AsirikuyReturnCode returnCode = SUCCESS;
+
+  /* The series is sampled even without the file so that callers of getEquitySeries don't depend on EnableEquityLog. */
+  safe_gmtime(&timeInfo, currentTime);
+
+  lockLogs();
+
+  pLog = findLog(instanceId, TRUE);
+  if(pLog == NULL)
+  {
+    unlockLogs();
+    logAsirikuyError("writeEquityLog()", INIT_LOG_FAILED);
+    return INIT_LOG_FAILED;
   }
 
-  if(!gEquityLog)
+  if(pLog->pSeries == NULL)
   {
-    returnCode = openEquityLog(pParams);
+    returnCode = openEquityLog(pLog, pParams);
     if(returnCode != SUCCESS)
     {
+      free(pLog->pSeries);
+      free(pLog->pPending);
+      memset(pLog, 0, sizeof(EquityLog));
+      pLog->instanceId = -1;
+      unlockLogs();
       logAsirikuyError("writeEquityLog()", returnCode);
       return returnCode;
     }
-
-    currentDay         = 0;
-    timeOfEquityMin    = 0;
-    dailyEquityMin     = 0;
-    prevDailyEquityMin = 0;
   }
 
-  safe_gmtime(&timeInfo, currentTime);
-  if(timeInfo.tm_mday != currentDay)
+  if(timeInfo.tm_mday != pLog->currentDay)
   {
-    if(currentDay != 0) 
+    if(pLog->currentDay != 0)
     {
-      dailyEquityProfit = dailyEquityMin - prevDailyEquityMin;
+      returnCode = addSample(pLog, &timeInfo, currentTime, pLog->dailyEquityMin, pLog->dailyEquityMin - pLog->prevDailyEquityMin);
+      pLog->prevDailyEquityMin = pLog->dailyEquityMin;
 
-      enterCriticalSection();
+      if(gEnableEquityLog && (!pLog->isBacktesting || (pLog->pendingSamples >= EQUITY_LOG_BATCH_SIZE)))
       {
-        fprintf(gEquityLog, "%d.%.2d.%.2d %.2d:%.2d;%.2f;%.2f\n", timeInfo.tm_year + 1900, timeInfo.tm_mon + 1, timeInfo.tm_mday, timeInfo.tm_hour, timeInfo.tm_min, dailyEquityMin, dailyEquityProfit);
-        fflush(gEquityLog);
+        pLog->isFlushRequested = TRUE;
+        if(startFlusher())
+        {
+          wakeLogs();
+        }
+        else if(!pLog->isWriting)
+        {
+          writeChunk(pLog);
+        }
       }
-      leaveCriticalSection();
-
-      prevDailyEquityMin = dailyEquityMin;
     }
-    currentDay = timeInfo.tm_mday;
-    dailyEquityMin = DBL_MAX;
+    pLog->currentDay     = timeInfo.tm_mday;
+    pLog->dailyEquityMin = DBL_MAX;
   }
 
-  if(accountEquity < dailyEquityMin)
+  if(accountEquity < pLog->dailyEquityMin)
   {
-    dailyEquityMin  = accountEquity;
-    timeOfEquityMin = currentTime;
+    pLog->dailyEquityMin  = accountEquity;
+    pLog->timeOfEquityMin = currentTime;
   }
 
+  unlockLogs();
+
+  if(returnCode != SUCCESS)
+  {
+    logAsirikuyError("writeEquityLog()", returnCode);
+  }
   return returnCode;
 }
 
+AsirikuyReturnCode getEquitySeries(int instanceId, EquitySample* pSamples, int maxSamples, int* pTotalSamples)
+{
+  EquityLog* pLog;
+  int        copied, first, i;
+
+  if(pTotalSamples == NULL)
+  {
+    return NULL_POINTER;
+  }
+
+  lockLogs();
+
+  pLog = findLog(instanceId, FALSE);
+  if((pLog == NULL) || (pLog->pSeries == NULL))
+  {
+    *pTotalSamples = 0;
+    unlockLogs();
+    return SUCCESS;
+  }
+
+  *pTotalSamples = pLog->totalSamples;
+  if(pSamples != NULL)
+  {
+    copied = (maxSamples < pLog->totalSamples) ? maxSamples : pLog->totalSamples;
+    first  = pLog->firstSample + pLog->totalSamples - copied;
+    for(i = 0; i < copied; i++)
+    {
+      pSamples[i] = pLog->pSeries[(first + i) % EQUITY_SERIES_CAPACITY];
+    }
+  }
+
+  unlockLogs();
+  return SUCCESS;
+}
+
+void closeInstanceEquityLog(int instanceId)
+{
+  EquityLog* pLog;
+
+  lockLogs();
+
+  pLog = findLog(instanceId, FALSE);
+  if(pLog == NULL)
+  {
+    unlockLogs();
+    return;
+  }
+
+  while(pLog->isWriting)
+  {
+    waitLogs();
+  }
+
+  if(pLog->pendingSize > 0)
+  {
+    writeChunk(pLog);
+  }
+
+  if(pLog->pFile != NULL)
+  {
+    fclose(pLog->pFile);
+  }
+  free(pLog->pSeries);
+  free(pLog->pPending);
+  memset(pLog, 0, sizeof(EquityLog));
+  pLog->instanceId = -1;
+
+  unlockLogs();
+}
+
 void closeEquityLog()
 {
-  if(gEquityLog != NULL)
+  int i;
+
+  lockLogs();
+  if(gIsFlusherRunning)
+  {
+    gIsFlusherStopping = TRUE;
+    wakeLogs();
+    unlockLogs();
+
+#if defined _WIN32 || defined _WIN64
+    WaitForSingleObject(gFlusher, INFINITE);
+    CloseHandle(gFlusher);
+#else
+    pthread_join(gFlusher, NULL);
+#endif
+
+    lockLogs();
+    gIsFlusherRunning  = FALSE;
+    gIsFlusherStopping = FALSE;
+  }
+  unlockLogs();
+
+  for(i = 0; i < MAX_INSTANCES; i++)
   {
-    fclose(gEquityLog);
-    gEquityLog = NULL;
+    if(gAreLogsInitialized && (gLogs[i].instanceId != -1))
+    {
+      closeInstanceEquityLog(gLogs[i].instanceId);
+    }
   }
 }
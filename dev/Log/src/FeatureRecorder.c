@@ -0,0 +1,299 @@
+/**
+ * @file
+ * @brief     Binary recorder of entry bar feature vectors.
+ * @details   Records are fixed-width rows of doubles described by a schema header, so any column can be read with a fixed stride.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "FeatureRecorder.h"
+
+#define EMPTY_TICKET            INT32_MIN
+#define INITIAL_TICKET_CAPACITY 256
+
+static unsigned int hashTicket(int32_t ticket)
+{
+  return (unsigned int)ticket * 2654435761u;
+}
+
+static BOOL insertTicket(FeatureRecorder* pRecorder, int32_t ticket);
+
+static BOOL growTickets(FeatureRecorder* pRecorder)
+{
+  int32_t* pOld = pRecorder->pTickets;
+  int      oldCapacity = pRecorder->ticketCapacity;
+  int      capacity = (oldCapacity > 0) ? oldCapacity * 2 : INITIAL_TICKET_CAPACITY;
+  int      i;
+
+  pRecorder->pTickets = (int32_t*)malloc(capacity * sizeof(int32_t));
+  if(pRecorder->pTickets == NULL)
+  {
+    pRecorder->pTickets = pOld;
+    return FALSE;
+  }
+  for(i = 0; i < capacity; i++)
+  {
+    pRecorder->pTickets[i] = EMPTY_TICKET;
+  }
+  pRecorder->ticketCapacity = capacity;
+  pRecorder->totalRecords   = 0;
+
+  for(i = 0; i < oldCapacity; i++)
+  {
+    if(pOld[i] != EMPTY_TICKET)
+    {
+      insertTicket(pRecorder, pOld[i]);
+    }
+  }
+  free(pOld);
+
+  return TRUE;
+}
+
+/* Returns FALSE if the ticket was already in the set. */
+static BOOL insertTicket(FeatureRecorder* pRecorder, int32_t ticket)
+{
+  unsigned int mask, slot;
+
+  if((pRecorder->totalRecords + 1) * 2 > pRecorder->ticketCapacity && !growTickets(pRecorder))
+  {
+    /* Without room in the set duplicates can't be detected, but the record is still written. */
+    return TRUE;
+  }
+
+  mask = (unsigned int)pRecorder->ticketCapacity - 1;
+  for(slot = hashTicket(ticket) & mask; pRecorder->pTickets[slot] != EMPTY_TICKET; slot = (slot + 1) & mask)
+  {
+    if(pRecorder->pTickets[slot] == ticket)
+    {
+      return FALSE;
+    }
+  }
+
+  pRecorder->pTickets[slot] = ticket;
+  pRecorder->totalRecords++;
+  return TRUE;
+}
+
+AsirikuyReturnCode openFeatureRecorder(FeatureRecorder* pRecorder, const char* pPath, const FeatureColumn* pColumns, int totalColumns, int barNumber)
+{
+  FeatureFileHeader header;
+  FILE*             pFile;
+  BOOL              isWritten;
+
+  memset(pRecorder, 0, sizeof(FeatureRecorder));
+
+  if((totalColumns <= 0) || (totalColumns > MAX_FEATURE_COLUMNS) || (barNumber <= 0) || (strlen(pPath) >= MAX_FILE_PATH_CHARS))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openFeatureRecorder() Invalid schema. Columns = %d, Bars = %d", totalColumns, barNumber);
+    return INVALID_PARAMETER;
+  }
+
+  header.magic        = FEATURE_FILE_MAGIC;
+  header.version      = FEATURE_FILE_VERSION;
+  header.totalColumns = totalColumns;
+  header.barNumber    = barNumber;
+  header.recordSize   = (int32_t)(sizeof(FeatureRecordKey) + barNumber * totalColumns * sizeof(double));
+
+  pFile = fopen(pPath, "wb");
+  if(pFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openFeatureRecorder() Failed to create %s", pPath);
+    return FILE_WRITING_ERROR;
+  }
+  isWritten = (fwrite(&header, sizeof(header), 1, pFile) == 1) && (fwrite(pColumns, sizeof(FeatureColumn), totalColumns, pFile) == (size_t)totalColumns);
+  if((fclose(pFile) != 0) || !isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"openFeatureRecorder() Failed to write the header of %s", pPath);
+    return FILE_WRITING_ERROR;
+  }
+
+  strcpy(pRecorder->path, pPath);
+  pRecorder->totalColumns = totalColumns;
+  pRecorder->barNumber    = barNumber;
+  pRecorder->recordSize   = header.recordSize;
+
+  return SUCCESS;
+}
+
+BOOL isFeatureRecorded(const FeatureRecorder* pRecorder, int ticket)
+{
+  unsigned int mask, slot;
+
+  if(pRecorder->ticketCapacity == 0)
+  {
+    return FALSE;
+  }
+
+  mask = (unsigned int)pRecorder->ticketCapacity - 1;
+  for(slot = hashTicket(ticket) & mask; pRecorder->pTickets[slot] != EMPTY_TICKET; slot = (slot + 1) & mask)
+  {
+    if(pRecorder->pTickets[slot] == ticket)
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+AsirikuyReturnCode appendFeatureRecord(FeatureRecorder* pRecorder, const FeatureRecordKey* pKey, const double* pValues)
+{
+  size_t totalValues = (size_t)pRecorder->barNumber * pRecorder->totalColumns;
+  FILE*  pFile;
+  BOOL   isWritten;
+
+  if(pRecorder->recordSize == 0)
+  {
+    return NULL_POINTER;
+  }
+
+  if(isFeatureRecorded(pRecorder, pKey->ticket))
+  {
+    return SUCCESS;
+  }
+
+  /* Entries are rare, so the file is only kept open while a record is written. */
+  pFile = fopen(pRecorder->path, "ab");
+  if(pFile == NULL)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"appendFeatureRecord() Failed to open %s", pRecorder->path);
+    return FILE_WRITING_ERROR;
+  }
+  isWritten = (fwrite(pKey, sizeof(FeatureRecordKey), 1, pFile) == 1) && (fwrite(pValues, sizeof(double), totalValues, pFile) == totalValues);
+  if((fclose(pFile) != 0) || !isWritten)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"appendFeatureRecord() Failed to append ticket %d to %s", pKey->ticket, pRecorder->path);
+    return FILE_WRITING_ERROR;
+  }
+
+  insertTicket(pRecorder, pKey->ticket);
+  return SUCCESS;
+}
+
+void closeFeatureRecorder(FeatureRecorder* pRecorder)
+{
+  free(pRecorder->pTickets);
+  memset(pRecorder, 0, sizeof(FeatureRecorder));
+}
+
+AsirikuyReturnCode exportFeatureFileCsv(const char* pPath, const char* pCsvPath, int* pExported)
+{
+  AsirikuyReturnCode returnCode = SUCCESS;
+  FeatureFileHeader  header;
+  FeatureColumn      columns[MAX_FEATURE_COLUMNS];
+  FeatureRecordKey   key;
+  double*            pValues = NULL;
+  FILE*              pFile;
+  FILE*              pCsvFile;
+  int                exported = 0, bar, column;
+
+  if(pExported != NULL)
+  {
+    *pExported = 0;
+  }
+
+  pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+  {
+    return FILE_READING_ERROR;
+  }
+
+  if((fread(&header, sizeof(header), 1, pFile) != 1) || (header.magic != FEATURE_FILE_MAGIC) || (header.version != FEATURE_FILE_VERSION)
+    || (header.totalColumns <= 0) || (header.totalColumns > MAX_FEATURE_COLUMNS) || (header.barNumber <= 0)
+    || (header.recordSize != (int32_t)(sizeof(FeatureRecordKey) + header.barNumber * header.totalColumns * sizeof(double)))
+    || (fread(columns, sizeof(FeatureColumn), header.totalColumns, pFile) != (size_t)header.totalColumns))
+  {
+    fclose(pFile);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"exportFeatureFileCsv() %s is not a feature file.", pPath);
+    return FILE_READING_ERROR;
+  }
+
+  pValues  = (double*)malloc(header.barNumber * header.totalColumns * sizeof(double));
+  pCsvFile = fopen(pCsvPath, "w");
+  if((pValues == NULL) || (pCsvFile == NULL))
+  {
+    free(pValues);
+    fclose(pFile);
+    if(pCsvFile != NULL)
+    {
+      fclose(pCsvFile);
+    }
+    return (pValues == NULL) ? INSUFFICIENT_MEMORY : FILE_WRITING_ERROR;
+  }
+
+  for(bar = 0; bar < header.barNumber; bar++)
+  {
+    for(column = 0; column < header.totalColumns; column++)
+    {
+      columns[column].name[FEATURE_NAME_SIZE - 1] = '\0';
+      fprintf(pCsvFile, "%s%d,", columns[column].name, bar);
+    }
+  }
+  fprintf(pCsvFile, "\n");
+
+  /* A partial last record, from a crash while appending, is skipped. */
+  while((fread(&key, sizeof(key), 1, pFile) == 1) && (fread(pValues, sizeof(double) * header.totalColumns, header.barNumber, pFile) == (size_t)header.barNumber))
+  {
+    const double* pValue = pValues;
+
+    for(bar = 0; bar < header.barNumber; bar++)
+    {
+      for(column = 0; column < header.totalColumns; column++, pValue++)
+      {
+        if(columns[column].type == FEATURE_INT)
+        {
+          fprintf(pCsvFile, "%d,", (int)*pValue);
+        }
+        else
+        {
+          fprintf(pCsvFile, "%lf,", *pValue);
+        }
+      }
+    }
+    fprintf(pCsvFile, "\n");
+    exported++;
+  }
+
+  if(fclose(pCsvFile) != 0)
+  {
+    returnCode = FILE_WRITING_ERROR;
+  }
+  fclose(pFile);
+  free(pValues);
+
+  if(pExported != NULL)
+  {
+    *pExported = exported;
+  }
+  return returnCode;
+}
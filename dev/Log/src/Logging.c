@@ -41,268 +41,346 @@
 #include "AsirikuyTime.h"
 #include "ta_libc.h"
 #include "EasyTradeCWrapper.hpp"
+#include "FeatureRecorder.h"
+#include "CriticalSection.h"
 
-#define EQUITY_LOG_FILENAME "ExtendedEntryLog.csv"
+#define ENTRY_BAR_LOG_FILENAME     "ExtendedEntryLog.csv"
+#define ENTRY_BAR_RECORDS_FILENAME "ExtendedEntryLog.bin"
+#define ENTRY_BAR_FEATURES         32
+#define FIRST_ENTRY_BAR_SHIFT      2
 
-static BOOL  gEnableEntryBarLog = FALSE;
-static char  gEntryBarLogPath[MAX_FILE_PATH_CHARS] = "";
-static int   gBarNumber = 0;
+/* The values of a bar that don't depend on the direction or the day of the entry, computed once per bar. */
+typedef struct entryBarFeatures_t
+{
+  time_t barTime;
+  int    hour;
+  int    dayOfMonth;
+  int    month;
+  int    dayOfWeek;
+  double range;
+  double body;
+  double closeToHigh;
+  double closeToLow;
+  double rsi[4];       /* Minus 50 */
+  double sto[4];       /* Minus 50 */
+  double closeToMA[4];
+  double cci[4];
+  double close;
+  double closeToBBUp;
+  double closeToBBDown;
+  double envelope[3];
+  double macd[3];
+  double atrPredictionDiff;
+} EntryBarFeatures;
+
+typedef struct entryBarCache_t
+{
+  int               instanceId;
+  int               capacity;
+  EntryBarFeatures* pBars;     /* Indexed by bar number modulo capacity */
+} EntryBarCache;
+
+static const FeatureColumn gEntryBarColumns[ENTRY_BAR_FEATURES] =
+{
+  {"hour", FEATURE_INT}, {"dayOfMonth", FEATURE_INT}, {"month", FEATURE_INT}, {"dayOfWeek", FEATURE_INT},
+  {"range", FEATURE_DOUBLE}, {"body", FEATURE_DOUBLE}, {"closeToHigh", FEATURE_DOUBLE}, {"closeToLow", FEATURE_DOUBLE},
+  {"5RSI", FEATURE_DOUBLE}, {"10RSI", FEATURE_DOUBLE}, {"20RSI", FEATURE_DOUBLE}, {"50RSI", FEATURE_DOUBLE},
+  {"5STO", FEATURE_DOUBLE}, {"10STO", FEATURE_DOUBLE}, {"20STO", FEATURE_DOUBLE}, {"50STO", FEATURE_DOUBLE},
+  {"5MA", FEATURE_DOUBLE}, {"10MA", FEATURE_DOUBLE}, {"20MA", FEATURE_DOUBLE}, {"50MA", FEATURE_DOUBLE},
+  {"5CCI", FEATURE_DOUBLE}, {"10CCI", FEATURE_DOUBLE}, {"20CCI", FEATURE_DOUBLE}, {"50CCI", FEATURE_DOUBLE},
+  {"20BB", FEATURE_DOUBLE}, {"5Envelopes", FEATURE_DOUBLE}, {"10Envelopes", FEATURE_DOUBLE}, {"20Envelopes", FEATURE_DOUBLE},
+  {"5MACD", FEATURE_DOUBLE}, {"10MACD", FEATURE_DOUBLE}, {"20MACD", FEATURE_DOUBLE}, {"20ATRPredDiff", FEATURE_DOUBLE}
+};
+
+static const int gIndicatorPeriods[4] = {5, 10, 20, 50};
+static const int gMacdPeriods[3][2]   = {{5, 10}, {10, 20}, {20, 40}};
+
+static BOOL            gEnableEntryBarLog = FALSE;
+static char            gEntryBarLogPath[MAX_FILE_PATH_CHARS] = "";
+static char            gEntryBarRecordsPath[MAX_FILE_PATH_CHARS] = "";
+static int             gBarNumber = 0;
+static FeatureRecorder gEntryBarRecorder;
+static EntryBarCache   gEntryBarCaches[MAX_INSTANCES];
+static BOOL            gAreEntryBarCachesInitialized = FALSE;
 
 void initExtendedEntryBarLog(BOOL enableEntryBarLog, int barNumber, const char* folderName)
 {
-  char line[50000] = "";
-  char inside[50] = "";
-  FILE *fp;
+  AsirikuyReturnCode returnCode;
   int i;
 
-  strcat(gEntryBarLogPath, folderName);
-  strcat(gEntryBarLogPath, "/");
-  strcat(gEntryBarLogPath, EQUITY_LOG_FILENAME);
+  sprintf(gEntryBarLogPath, "%s/%s", folderName, ENTRY_BAR_LOG_FILENAME);
+  sprintf(gEntryBarRecordsPath, "%s/%s", folderName, ENTRY_BAR_RECORDS_FILENAME);
   gEnableEntryBarLog = enableEntryBarLog;
   gBarNumber = barNumber;
 
-  if(gEnableEntryBarLog)
-  {
-
-	fp =fopen(gEntryBarLogPath, "w");
-
-	for (i=0;i<barNumber;i++){
-
-	sprintf(inside,"hour%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"dayOfMonth%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"month%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"dayOfWeek%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"range%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"body%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"closeToHigh%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"closeToLow%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"5RSI%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"10RSI%d,",i);
-	strcat(line, inside);
-	sprintf(inside,"20RSI%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"50RSI%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"5STO%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"10STO%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"20STO%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"50STO%d,", i);
-	strcat(line, inside);
-
-	sprintf(inside,"5MA%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"10MA%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"20MA%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"50MA%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"5CCI%d,",i);
-	strcat(line, inside);
-	sprintf(inside,"10CCI%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"20CCI%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"50CCI%d,", i);
-	strcat(line, inside);
-
-	sprintf(inside,"20BB%d,",i);
-	strcat(line, inside);
-	sprintf(inside,"5Envelopes%d,",i);
-	strcat(line, inside);
-	sprintf(inside,"10Envelopes%d,",i);
-	strcat(line, inside);
-	sprintf(inside,"20Envelopes%d,", i);
-	strcat(line, inside);
-
-	sprintf(inside,"5MACD%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"10MACD%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"20MACD%d,", i);
-	strcat(line, inside);
-	sprintf(inside,"20ATRPredDiff%d,",i);
-	strcat(line, inside);
-
-	}
-
-	fprintf(fp, "%s\n", line);
-
-	fclose(fp);  
-  
+  if(!gEnableEntryBarLog)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Entry bar log is not enabled.");
+    return;
+  }
+
+  enterCriticalSection();
+  if(!gAreEntryBarCachesInitialized)
+  {
+    for(i = 0; i < MAX_INSTANCES; i++)
+    {
+      gEntryBarCaches[i].instanceId = -1;
+    }
+    gAreEntryBarCachesInitialized = TRUE;
+  }
+
+  closeFeatureRecorder(&gEntryBarRecorder);
+  returnCode = openFeatureRecorder(&gEntryBarRecorder, gEntryBarRecordsPath, gEntryBarColumns, ENTRY_BAR_FEATURES, barNumber);
+  if(returnCode == SUCCESS)
+  {
+    /* Starts the csv with its header line, as it always did. */
+    returnCode = exportFeatureFileCsv(gEntryBarRecordsPath, gEntryBarLogPath, NULL);
+  }
+  leaveCriticalSection();
+
+  if(returnCode != SUCCESS)
+  {
+    gEnableEntryBarLog = FALSE;
+    logAsirikuyError("initExtendedEntryBarLog()", returnCode);
+  }
+}
+
+/* Returns the bar cache of an instance, claiming a free one on first use. */
+static EntryBarCache* getEntryBarCache(int instanceId)
+{
+  EntryBarCache* pCache = NULL;
+  int i;
+
+  enterCriticalSection();
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gEntryBarCaches[i].instanceId == instanceId)
+    {
+      pCache = &gEntryBarCaches[i];
+      break;
+    }
+    if((pCache == NULL) && (gEntryBarCaches[i].instanceId == -1))
+    {
+      pCache = &gEntryBarCaches[i];
+    }
+  }
+
+  if((pCache != NULL) && (pCache->instanceId != instanceId))
+  {
+    /* Room for two records worth of bars, so consecutive entries never evict each other's bars. */
+    pCache->pBars = (EntryBarFeatures*)calloc(2 * gBarNumber, sizeof(EntryBarFeatures));
+    if(pCache->pBars == NULL)
+    {
+      pCache = NULL;
+    }
+    else
+    {
+      pCache->capacity   = 2 * gBarNumber;
+      pCache->instanceId = instanceId;
+    }
+  }
+  leaveCriticalSection();
+
+  return pCache;
+}
+
+static void computeEntryBarFeatures(StrategyParams* pParams, int shift, EntryBarFeatures* pBar)
+{
+  int    shift0Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 1;
+  int    outBegIdx, outNBElement, shiftDay, i;
+  double notUsed, bbUp, bbDown, ma5;
+  struct tm timeInfo;
+
+  pBar->barTime = openTime(shift);
+  safe_gmtime(&timeInfo, pBar->barTime);
+  pBar->hour       = timeInfo.tm_hour;
+  pBar->dayOfMonth = timeInfo.tm_mday;
+  pBar->month      = timeInfo.tm_mon;
+  pBar->dayOfWeek  = timeInfo.tm_wday;
+
+  pBar->close       = cClose(shift);
+  pBar->range       = fabs(high(shift) - low(shift));
+  pBar->body        = pBar->close - cOpen(shift);
+  pBar->closeToHigh = fabs(pBar->close - high(shift));
+  pBar->closeToLow  = fabs(pBar->close - low(shift));
+
+  for(i = 0; i < 4; i++)
+  {
+    pBar->rsi[i]       = iRSI(PRIMARY_RATES, gIndicatorPeriods[i], shift) - 50;
+    pBar->sto[i]       = iSTO(PRIMARY_RATES, gIndicatorPeriods[i], 1, 1, 0, shift) - 50;
+    pBar->closeToMA[i] = pBar->close - iMA(3, PRIMARY_RATES, gIndicatorPeriods[i], shift);
+    pBar->cci[i]       = iCCI(PRIMARY_RATES, gIndicatorPeriods[i], shift);
+  }
+
+  TA_BBANDS(shift0Index-shift, shift0Index-shift, pParams->ratesBuffers->rates[PRIMARY_RATES].close, 20, 2, 2, TA_MAType_SMA, &outBegIdx, &outNBElement, &bbUp, &notUsed, &bbDown);
+  pBar->closeToBBUp   = pBar->close - bbUp;
+  pBar->closeToBBDown = pBar->close - bbDown;
+
+  ma5 = iMA(3, PRIMARY_RATES, 5, shift);
+  for(i = 0; i < 3; i++)
+  {
+    pBar->envelope[i] = iMA(3, PRIMARY_RATES, gIndicatorPeriods[i], shift) - 0.02 * ma5;
+    pBar->macd[i]     = iMACD(PRIMARY_RATES, gMacdPeriods[i][0], gMacdPeriods[i][1], 6, 0, shift);
+  }
+
+  shiftDay = findShift(DAILY_RATES, PRIMARY_RATES, shift);
+  pBar->atrPredictionDiff = iAtr(DAILY_RATES, 20, shiftDay + 2) - (iHigh(DAILY_RATES, shiftDay + 1) - iLow(DAILY_RATES, shiftDay + 1));
+}
+
+static const EntryBarFeatures* getEntryBarFeatures(StrategyParams* pParams, EntryBarCache* pCache, int shift)
+{
+  time_t            barTime = openTime(shift);
+  int               barSeconds = (int)pParams->settings[TIMEFRAME] * 60;
+  EntryBarFeatures* pBar = &pCache->pBars[(barTime / (barSeconds > 0 ? barSeconds : 1)) % pCache->capacity];
+
+  if(pBar->barTime != barTime)
+  {
+    computeEntryBarFeatures(pParams, shift, pBar);
+  }
+
+  return pBar;
+}
+
+/* Applies the direction of the entry and the current daily ATR to the values of a bar, in the order of gEntryBarColumns. */
+static void writeEntryBarValues(const EntryBarFeatures* pBar, int positionType, double atr, double* pValues)
+{
+  int mult = (positionType == BUY) ? 1 : -1;
+  int i;
+
+  *pValues++ = pBar->hour;
+  *pValues++ = pBar->dayOfMonth;
+  *pValues++ = pBar->month;
+  *pValues++ = pBar->dayOfWeek;
+  *pValues++ = pBar->range/atr;
+  *pValues++ = mult*pBar->body/atr;
+  *pValues++ = pBar->closeToHigh/atr;
+  *pValues++ = pBar->closeToLow/atr;
+  for(i = 0; i < 4; i++)
+  {
+    *pValues++ = pBar->rsi[i]*mult;
+  }
+  for(i = 0; i < 4; i++)
+  {
+    *pValues++ = pBar->sto[i]*mult;
+  }
+  for(i = 0; i < 4; i++)
+  {
+    *pValues++ = mult*pBar->closeToMA[i]/atr;
+  }
+  for(i = 0; i < 4; i++)
+  {
+    *pValues++ = mult*pBar->cci[i];
+  }
+
+  if(positionType == BUY)
+  {
+    *pValues++ = pBar->closeToBBDown/atr;
+    for(i = 0; i < 3; i++)
+    {
+      *pValues++ = mult*(pBar->close - pBar->envelope[i])/atr;
+    }
   }
   else
   {
-    pantheios_logputs(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"Entry bar log is not enabled.");
+    *pValues++ = mult*pBar->closeToBBUp/atr;
+    for(i = 0; i < 3; i++)
+    {
+      *pValues++ = mult*(pBar->close + pBar->envelope[i])/atr;
+    }
   }
 
+  for(i = 0; i < 3; i++)
+  {
+    *pValues++ = mult*pBar->macd[i];
+  }
+  *pValues = pBar->atrPredictionDiff;
+}
 
+void recordData(StrategyParams* pParams, int ticket, int positionType)
+{
+  AsirikuyReturnCode returnCode;
+  FeatureRecordKey   key;
+  EntryBarCache*     pCache;
+  double*            pValues;
+  double             atr;
+  BOOL               isRecorded;
+  int                i;
 
+  if(gEnableEntryBarLog == FALSE) return;
+
+  if((positionType != BUY) && (positionType != SELL))
+  {
+    return;
+  }
+
+  /* runStrategy asks on every tick of the entry bar, so check before computing anything. */
+  enterCriticalSection();
+  isRecorded = isFeatureRecorded(&gEntryBarRecorder, ticket);
+  leaveCriticalSection();
+  if(isRecorded)
+  {
+    return;
+  }
+
+  pCache  = getEntryBarCache((int)pParams->settings[STRATEGY_INSTANCE_ID]);
+  pValues = (double*)malloc(gBarNumber * ENTRY_BAR_FEATURES * sizeof(double));
+  if((pCache == NULL) || (pValues == NULL))
+  {
+    free(pValues);
+    logAsirikuyError("recordData()", INSUFFICIENT_MEMORY);
+    return;
+  }
+
+  atr = iAtr(DAILY_RATES, (int)parameter(ATR_AVERAGING_PERIOD), 1);
+  for(i = 0; i < gBarNumber; i++)
+  {
+    writeEntryBarValues(getEntryBarFeatures(pParams, pCache, FIRST_ENTRY_BAR_SHIFT + i), positionType, atr, pValues + i * ENTRY_BAR_FEATURES);
+  }
+
+  key.ticket       = ticket;
+  key.instanceId   = (int32_t)pParams->settings[STRATEGY_INSTANCE_ID];
+  key.entryTime    = (int32_t)openTime(1);
+  key.positionType = positionType;
+
+  enterCriticalSection();
+  returnCode = appendFeatureRecord(&gEntryBarRecorder, &key, pValues);
+  leaveCriticalSection();
+  free(pValues);
+
+  if(returnCode != SUCCESS)
+  {
+    logAsirikuyError("recordData()", returnCode);
+    return;
+  }
+  pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"recordData() Recorded the entry bars of ticket %d.", ticket);
 }
 
-void recordData(StrategyParams* pParams, int positionType)
+void closeInstanceEntryBarLog(int instanceId)
 {
-	FILE *fp;
-	char line[50000] = "";
-	char inside[50] = "";
-	int max_len; 
-	char* buff; 
-	char* final;
-	int  mult, i;
-	int shift = 2;
-	struct tm timeInfo;
-	double atr = iAtr(DAILY_RATES,(int)parameter(ATR_AVERAGING_PERIOD), 1);
-	int outBegIdx, outNBElement, shiftDay;
-	double notUsed, bbUp, bbDown;
-	int  shift0Index      = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 1;
-	char *last_newline;
-	char *last_line;
-
-	
-	if(gEnableEntryBarLog == FALSE) return;
-
-	max_len = gBarNumber*550;
-	buff = (char*)malloc(max_len * sizeof(char));
-	final = (char*)malloc(max_len * sizeof(char));
-
-	if (positionType == BUY) mult = 1;
-	if (positionType == SELL) mult = -1;
-
-	if ((fp = fopen(gEntryBarLogPath, "rb")) != NULL)  {      
-
-    fseek(fp, -max_len, SEEK_END);            // set pointer to the end of file minus the length you need. Presumably there can be more than one new line caracter
-    fread(buff, max_len-1, 1, fp);            // read the contents of the file starting from where fseek() positioned us
-    fclose(fp);                               // close the file
-
-	//buff[max_len-1] = '\0';
-    last_newline = strrchr(buff, '\n'); // find last occurrence of newlinw 
-    last_line = last_newline+1;         // jump to it
-
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"last line in entry bar log = %s", last_line);
-
-	}
-
-	fp =fopen(gEntryBarLogPath, "a");
-
-	for (i=0;i<gBarNumber;i++){
-
-	safe_gmtime(&timeInfo, openTime(shift));
-	//pantheios_logprintf(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"%d", size);
-
-	sprintf(inside,"%d,", timeInfo.tm_hour);
-	strcat(line, inside);
-	sprintf(inside,"%d,", timeInfo.tm_mday);
-	strcat(line, inside);
-	sprintf(inside,"%d,", timeInfo.tm_mon);
-	strcat(line, inside);
-	sprintf(inside,"%d,", timeInfo.tm_wday);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", fabs(high(shift) - low(shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) - cOpen(shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", fabs(cClose(shift) - high(shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", fabs(cClose(shift) - low(shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iRSI(PRIMARY_RATES,5,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iRSI(PRIMARY_RATES,10,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iRSI(PRIMARY_RATES,20,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iRSI(PRIMARY_RATES,50,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iSTO(PRIMARY_RATES,5,1,1,0,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iSTO(PRIMARY_RATES,10,1,1,0,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iSTO(PRIMARY_RATES,20,1,1,0,shift)-50)*mult);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", (iSTO(PRIMARY_RATES,50,1,1,0,shift)-50)*mult);
-	strcat(line, inside);
-
-	TA_BBANDS(shift0Index-shift, shift0Index-shift, pParams->ratesBuffers->rates[PRIMARY_RATES].close, 20, 2, 2, TA_MAType_SMA, &outBegIdx, &outNBElement, &bbUp, &notUsed, &bbDown);
-
-	sprintf(inside,"%lf,", mult*(cClose(shift)-iMA(3,PRIMARY_RATES,5,shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift)-iMA(3,PRIMARY_RATES,10,shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift)-iMA(3,PRIMARY_RATES,20,shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift)-iMA(3,PRIMARY_RATES,50,shift))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iCCI(PRIMARY_RATES,5,shift)));
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iCCI(PRIMARY_RATES,10,shift)));
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iCCI(PRIMARY_RATES,20,shift)));
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iCCI(PRIMARY_RATES,50,shift)));
-	strcat(line, inside);
-
-
-	if (positionType == BUY){
-	sprintf(inside,"%lf,", (cClose(shift) - bbDown)/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) - (iMA(3,PRIMARY_RATES,5,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) - (iMA(3,PRIMARY_RATES,10,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) - (iMA(3,PRIMARY_RATES,20,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	}
-
-	if (positionType == SELL){
-	sprintf(inside,"%lf,", mult*(cClose(shift) - bbUp)/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) + (iMA(3,PRIMARY_RATES,5,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) + (iMA(3,PRIMARY_RATES,10,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(cClose(shift) + (iMA(3,PRIMARY_RATES,20,shift)-0.02*iMA(3,PRIMARY_RATES,5,shift)))/atr);
-	strcat(line, inside);
-	}
-
-	sprintf(inside,"%lf,", mult*(iMACD(PRIMARY_RATES,5,10,6,0,shift)));
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iMACD(PRIMARY_RATES,10,20,6,0,shift)));
-	strcat(line, inside);
-	sprintf(inside,"%lf,", mult*(iMACD(PRIMARY_RATES,20,40,6,0,shift)));
-	strcat(line, inside);
-
-	shiftDay = findShift(DAILY_RATES, PRIMARY_RATES, shift);
-
-	sprintf(inside,"%lf,", iAtr(DAILY_RATES,20,shiftDay+2)-(iHigh(DAILY_RATES,shiftDay+1)-iLow(DAILY_RATES,shiftDay+1)));
-	strcat(line, inside);
-
-	shift += 1;
-
-	}
-
-	sprintf(final, "%s\n", line);
-
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Line to add to entry bar log = %s", final);
-
-	if (strncmp(final , last_line, 20))
-	fprintf(fp, "%s\n", line);
-
-	fclose(fp);
-
-	free(buff);
-	free(final);
+  int i;
+
+  if(!gEnableEntryBarLog)
+  {
+    return;
+  }
+
+  enterCriticalSection();
+  for(i = 0; i < MAX_INSTANCES; i++)
+  {
+    if(gEntryBarCaches[i].instanceId == instanceId)
+    {
+      free(gEntryBarCaches[i].pBars);
+      gEntryBarCaches[i].pBars      = NULL;
+      gEntryBarCaches[i].capacity   = 0;
+      gEntryBarCaches[i].instanceId = -1;
+    }
+  }
+
+  if(exportFeatureFileCsv(gEntryBarRecordsPath, gEntryBarLogPath, NULL) != SUCCESS)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"closeInstanceEntryBarLog() Failed to export %s", gEntryBarLogPath);
+  }
+  leaveCriticalSection();
 }
 
 char* asirikuyReturnCodeToString(AsirikuyReturnCode returnCode, char* pBuffer, int bufferLength)
@@ -34,8 +34,17 @@
  * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
  */
 
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <math.h>
 #include <boost/test/unit_test.hpp>
 
+#include "AsirikuyDefines.h"
+#include "EquityLog.h"
+#include "FeatureRecorder.h"
+#include "WorkerThreads.h"
+
 BOOST_AUTO_TEST_SUITE(Log)
 
 BOOST_AUTO_TEST_CASE(placeholder)
@@ -43,4 +52,242 @@ BOOST_AUTO_TEST_CASE(placeholder)
   BOOST_CHECK(true);
 }
 
+namespace
+{
+  std::vector<std::string> readLines(const char* pPath)
+  {
+    std::vector<std::string> lines;
+    char  line[1024];
+    FILE* fp = fopen(pPath, "r");
+
+    while((fp != NULL) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+      lines.push_back(line);
+    }
+    if(fp != NULL)
+    {
+      fclose(fp);
+    }
+    return lines;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(featureRecorder_recordsOncePerTicketAndExportsCsv)
+{
+  const FeatureColumn columns[3] = {{"hour", FEATURE_INT}, {"range", FEATURE_DOUBLE}, {"5RSI", FEATURE_DOUBLE}};
+  FeatureRecorder     recorder;
+  FeatureRecordKey    key = {0, 7, 1401062400, BUY};
+  double              values[6];
+  int                 exported;
+
+  BOOST_CHECK_EQUAL(openFeatureRecorder(&recorder, "featureRecorderTest.bin", columns, 0, 2), INVALID_PARAMETER);
+  BOOST_REQUIRE_EQUAL(openFeatureRecorder(&recorder, "featureRecorderTest.bin", columns, 3, 2), SUCCESS);
+  BOOST_CHECK_EQUAL(recorder.recordSize, (int)(sizeof(FeatureRecordKey) + 6 * sizeof(double)));
+
+  /* Enough tickets to grow the ticket set a few times. */
+  for(int ticket = 1; ticket <= 1000; ticket++)
+  {
+    key.ticket = ticket;
+    for(int i = 0; i < 6; i++)
+    {
+      values[i] = ticket + i * 0.25;
+    }
+    BOOST_REQUIRE_EQUAL(appendFeatureRecord(&recorder, &key, values), SUCCESS);
+  }
+  BOOST_CHECK(isFeatureRecorded(&recorder, 1));
+  BOOST_CHECK(isFeatureRecorded(&recorder, 1000));
+  BOOST_CHECK(!isFeatureRecorded(&recorder, 1001));
+
+  /* The same ticket on later ticks of the entry bar isn't recorded again. */
+  key.ticket = 500;
+  values[0]  = -1;
+  BOOST_CHECK_EQUAL(appendFeatureRecord(&recorder, &key, values), SUCCESS);
+  closeFeatureRecorder(&recorder);
+
+  BOOST_REQUIRE_EQUAL(exportFeatureFileCsv("featureRecorderTest.bin", "featureRecorderTest.csv", &exported), SUCCESS);
+  BOOST_CHECK_EQUAL(exported, 1000);
+  {
+    std::vector<std::string> lines = readLines("featureRecorderTest.csv");
+    BOOST_REQUIRE_EQUAL(lines.size(), 1001u);
+    BOOST_CHECK_EQUAL(lines[0], "hour0,range0,5RSI0,hour1,range1,5RSI1,\n");
+    BOOST_CHECK_EQUAL(lines[1], "1,1.250000,1.500000,1,2.000000,2.250000,\n");
+    BOOST_CHECK_EQUAL(lines[500], "500,500.250000,500.500000,500,501.000000,501.250000,\n");
+  }
+
+  /* A record cut short by a crash is left out. */
+  {
+    FILE* fp = fopen("featureRecorderTest.bin", "ab");
+    fwrite(&key, sizeof(key), 1, fp);
+    fwrite(values, sizeof(double), 2, fp);
+    fclose(fp);
+  }
+  BOOST_CHECK_EQUAL(exportFeatureFileCsv("featureRecorderTest.bin", "featureRecorderTest.csv", &exported), SUCCESS);
+  BOOST_CHECK_EQUAL(exported, 1000);
+
+  BOOST_CHECK_EQUAL(exportFeatureFileCsv("featureRecorderTest.csv", "featureRecorderTest2.csv", &exported), FILE_READING_ERROR);
+  BOOST_CHECK_EQUAL(exportFeatureFileCsv("missingFeatureFile.bin", "featureRecorderTest2.csv", &exported), FILE_READING_ERROR);
+
+  remove("featureRecorderTest.bin");
+  remove("featureRecorderTest.csv");
+  remove("featureRecorderTest2.csv");
+}
+
+namespace
+{
+  struct EquityLogRun
+  {
+    int                               totalDays;
+    std::vector<std::vector<double> > expectedMins; /* Per task */
+    std::vector<int>                  failedWrites; /* Per task, Boost.Test checks aren't thread safe */
+  };
+
+  /* Hourly ticks of an instance whose equity dips a different amount every day. */
+  double equityAt(int taskIndex, int day, int hour)
+  {
+    return 10000.0 + taskIndex * 1000.0 + day * 10.0 - fabs((double)(hour - 12)) * 0.25 - (day % 7) * 3.0;
+  }
+
+  void equityLogTask(int taskIndex, int threadIndex, void* pContext)
+  {
+    EquityLogRun*  pRun = (EquityLogRun*)pContext;
+    double         settings[64] = {0}, bid = 1.1, ask = 1.1002;
+    char           symbol[] = "EURUSD";
+    RatesBuffers*  pRatesBuffers = (RatesBuffers*)calloc(1, sizeof(RatesBuffers));
+    StrategyParams params;
+
+    memset(&params, 0, sizeof(StrategyParams));
+    settings[STRATEGY_INSTANCE_ID] = 7000 + taskIndex;
+    settings[IS_BACKTESTING]       = 1;
+    settings[TIMEFRAME]            = 60;
+    settings[ORIGINAL_EQUITY]      = 10000;
+    params.settings    = settings;
+    params.tradeSymbol = symbol;
+    params.bidAsk.bid  = &bid;
+    params.bidAsk.ask  = &ask;
+    params.ratesBuffers = pRatesBuffers;
+    pRatesBuffers->rates[0].info.digits = 5;
+
+    for(int day = 0; day < pRun->totalDays; day++)
+    {
+      double dailyMin = 1e9;
+      for(int hour = 0; hour < 24; hour++)
+      {
+        double equity = equityAt(taskIndex, day, hour);
+        if(writeEquityLog(1262304000 + day * 86400 + hour * 3600, equity, &params) != SUCCESS)
+        {
+          pRun->failedWrites[taskIndex]++;
+        }
+        dailyMin = equity < dailyMin ? equity : dailyMin;
+      }
+      pRun->expectedMins[taskIndex].push_back(dailyMin);
+    }
+
+    free(pRatesBuffers);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(equityLog_perInstanceSeriesAndBatchedFile)
+{
+  const int    totalTasks = 4;
+  EquityLogRun run;
+
+  initEquityLog(TRUE, ".");
+  run.totalDays = 100;
+  run.expectedMins.resize(totalTasks);
+  run.failedWrites.assign(totalTasks, 0);
+  BOOST_REQUIRE_EQUAL(runParallelTasks(totalTasks, totalTasks, equityLogTask, &run), SUCCESS);
+
+  for(int task = 0; task < totalTasks; task++)
+  {
+    std::vector<EquitySample> samples(run.totalDays);
+    char path[64], expected[64];
+    int  total;
+
+    BOOST_CHECK_EQUAL(run.failedWrites[task], 0);
+
+    /* A sample is taken when a day ends, so the last day isn't in the series yet. */
+    BOOST_REQUIRE_EQUAL(getEquitySeries(7000 + task, &samples[0], run.totalDays, &total), SUCCESS);
+    BOOST_REQUIRE_EQUAL(total, run.totalDays - 1);
+    for(int day = 0; day < total; day++)
+    {
+      BOOST_CHECK_CLOSE(samples[day].equityMin, run.expectedMins[task][day], 1e-9);
+      BOOST_CHECK_EQUAL(samples[day].time, (time_t)(1262304000 + (day + 1) * 86400));
+      if(day > 0)
+      {
+        BOOST_CHECK_CLOSE(samples[day].profit, run.expectedMins[task][day] - run.expectedMins[task][day - 1], 1e-6);
+      }
+    }
+
+    /* Only the newest samples are copied into a short array. */
+    BOOST_REQUIRE_EQUAL(getEquitySeries(7000 + task, &samples[0], 10, &total), SUCCESS);
+    BOOST_CHECK_CLOSE(samples[9].equityMin, run.expectedMins[task][total - 1], 1e-9);
+
+    closeInstanceEquityLog(7000 + task);
+    BOOST_REQUIRE_EQUAL(getEquitySeries(7000 + task, NULL, 0, &total), SUCCESS);
+    BOOST_CHECK_EQUAL(total, 0);
+
+    sprintf(path, "./%d_EquityLog.csv", 7000 + task);
+    std::vector<std::string> lines = readLines(path);
+    BOOST_REQUIRE_EQUAL((int)lines.size(), 3 + run.totalDays - 1);
+    BOOST_CHECK_EQUAL(lines[1], "Time;DailyEquityMin;Profit/Loss\n");
+    for(int day = 0; day < run.totalDays - 1; day++)
+    {
+      sprintf(expected, ";%.2f;", run.expectedMins[task][day]);
+      BOOST_CHECK(lines[3 + day].find(expected) != std::string::npos);
+    }
+    remove(path);
+  }
+
+  closeEquityLog();
+  initEquityLog(FALSE, ".");
+}
+
+BOOST_AUTO_TEST_CASE(equityLog_seriesIsBounded)
+{
+  EquityLogRun run;
+  int          total;
+
+  initEquityLog(TRUE, ".");
+  run.totalDays = EQUITY_SERIES_CAPACITY + 50;
+  run.expectedMins.resize(1);
+  run.failedWrites.assign(1, 0);
+  equityLogTask(0, 0, &run);
+  BOOST_CHECK_EQUAL(run.failedWrites[0], 0);
+
+  std::vector<EquitySample> samples(EQUITY_SERIES_CAPACITY);
+  BOOST_REQUIRE_EQUAL(getEquitySeries(7000, &samples[0], EQUITY_SERIES_CAPACITY, &total), SUCCESS);
+  BOOST_REQUIRE_EQUAL(total, EQUITY_SERIES_CAPACITY);
+  BOOST_CHECK_CLOSE(samples[0].equityMin, run.expectedMins[0][run.totalDays - 1 - EQUITY_SERIES_CAPACITY], 1e-9);
+  BOOST_CHECK_CLOSE(samples[total - 1].equityMin, run.expectedMins[0][run.totalDays - 2], 1e-9);
+
+  /* The file keeps every sample. */
+  closeEquityLog();
+  BOOST_CHECK_EQUAL((int)readLines("./7000_EquityLog.csv").size(), 3 + run.totalDays - 1);
+  remove("./7000_EquityLog.csv");
+  initEquityLog(FALSE, ".");
+}
+
+BOOST_AUTO_TEST_CASE(equityLog_seriesWithoutFile)
+{
+  EquityLogRun run;
+  int          total;
+
+  remove("./7000_EquityLog.csv");
+  initEquityLog(FALSE, ".");
+  run.totalDays = 30;
+  run.expectedMins.resize(1);
+  run.failedWrites.assign(1, 0);
+  equityLogTask(0, 0, &run);
+  BOOST_CHECK_EQUAL(run.failedWrites[0], 0);
+
+  std::vector<EquitySample> samples(run.totalDays);
+  BOOST_REQUIRE_EQUAL(getEquitySeries(7000, &samples[0], run.totalDays, &total), SUCCESS);
+  BOOST_REQUIRE_EQUAL(total, run.totalDays - 1);
+  BOOST_CHECK_CLOSE(samples[0].equityMin, run.expectedMins[0][0], 1e-9);
+  BOOST_CHECK_CLOSE(samples[total - 1].equityMin, run.expectedMins[0][run.totalDays - 2], 1e-9);
+
+  closeEquityLog();
+  BOOST_CHECK(readLines("./7000_EquityLog.csv").empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1054,22 +1054,13 @@ double roundN(double value, int to)
 
 double iVarOnArray(double arrayForCalculation[], int numItems )
 {
-  int j;
   double sum = 0, var = 0, average = 0;
 
-  for(j= 0;j < numItems;j++)
-  {
-    sum+=arrayForCalculation[j];
-  }
+  sum = sumValues(arrayForCalculation, numItems);
 
   average = sum/numItems;
 
-  sum = 0 ;
-
-  for (j = 0; j < numItems; j++)
-  {
-    sum += (arrayForCalculation[j] - average)*(arrayForCalculation[j] - average);
-  }
+  sum = sumSquaredDeviations(arrayForCalculation, numItems, average);
 
   var =  sum / (numItems-1);
 
@@ -0,0 +1,28 @@
+project "StatusMonitor"
+  location("../../build/" .. _ACTION .. "/projects")
+  kind "ConsoleApp"
+  language "C"
+  files{
+    "**.c"
+  }
+  vpaths{
+	["Source Files"] = "**.c"
+  }
+  links{
+	"AsirikuyCommon",
+	"Pantheios_frontend",
+	"Pantheios_backend",
+	"Pantheios_utils",
+	"Pantheios_core"
+  }
+  configuration{"linux"}
+    links{"rt", "pthread"}
+  os.chdir("../..")
+  configuration{"x32", "Debug"}
+    targetdir("bin/" .. _ACTION .. "/x32/Debug")
+  configuration{"x64", "Debug"}
+    targetdir("bin/" .. _ACTION .. "/x64/Debug")
+  configuration{"x32", "Release"}
+    targetdir("bin/" .. _ACTION .. "/x32/Release")
+  configuration{"x64", "Release"}
+    targetdir("bin/" .. _ACTION .. "/x64/Release")
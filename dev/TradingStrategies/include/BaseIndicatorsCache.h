@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief     Process wide cache of the Base indicators shared by the instances trading the same symbol.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#ifndef BASE_INDICATORS_CACHE_H_
+#define BASE_INDICATORS_CACHE_H_
+#pragma once
+
+#ifndef ASIRIKUY_DEFINES_H_
+  #include "AsirikuyDefines.h"
+#endif
+
+#include "Base.h"
+
+#define BASE_INDICATORS_CACHE_SIZE        64
+#define BASE_INDICATORS_CACHE_SYMBOL_SIZE 32
+#define BASE_INDICATORS_CACHE_TIMEFRAMES  6    /* B_PRIMARY_RATES to B_WEEKLY_RATES */
+#define BASE_INDICATORS_CACHE_REPORT      1000 /* Lookups between two hit rate log lines */
+
+typedef struct baseRatesStamp_t
+{
+  int    timeframe;
+  int    arraySize;
+  time_t openTime;        /* Open time of the forming bar */
+  double open;
+  double high;
+  double low;
+  double close;
+  time_t lastClosedTime;
+  double lastClosedClose;
+} BaseRatesStamp;
+
+/* Everything the Base indicators depend on. Instances with equal keys compute equal values. */
+typedef struct baseIndicatorsKey_t
+{
+  char           symbol[BASE_INDICATORS_CACHE_SYMBOL_SIZE];
+  int            variant;         /* Caller defined value for the parameters the indicators read, e.g. the ATR averaging period */
+  int            strategyMode;    /* 1 for the weekly strategy modes, 0 for the daily one */
+  int            weeklyMAMode;    /* 0 in the daily mode, which does not read it */
+  double         bid;
+  double         ask;
+  BaseRatesStamp rates[BASE_INDICATORS_CACHE_TIMEFRAMES];
+} BaseIndicatorsKey;
+
+typedef struct baseIndicatorsCacheStats_t
+{
+  unsigned long lookups;
+  unsigned long hits;       /* Values computed by an earlier call */
+  unsigned long waits;      /* Hits that waited for another instance to finish computing them */
+  unsigned long misses;
+  unsigned long evictions;
+  unsigned long bypasses;   /* Calls that could not use the cache and computed their own values */
+} BaseIndicatorsCacheStats;
+
+typedef AsirikuyReturnCode (*BaseIndicatorsLoader)(StrategyParams* pParams, Base_Indicators* pIndicators);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* Enables or disables the cache. It is enabled by default.
+*
+* @param BOOL isEnabled
+*   FALSE makes every call compute its own values.
+*/
+void setBaseIndicatorsCacheEnabled(BOOL isEnabled);
+
+/**
+* Builds the cache key of a call.
+*
+* @param const StrategyParams* pParams
+*   The parameters passed to the strategy.
+*
+* @param int variant
+*   Caller defined value for the parameters the indicators read.
+*
+* @param const Base_Indicators* pIndicators
+*   The indicators to load. Only the strategy mode, and the weekly MA mode of the weekly strategy modes, are read.
+*
+* @param BaseIndicatorsKey* pKey
+*   Receives the key.
+*
+* @return BOOL
+*   FALSE if the symbol is too long to be part of a key.
+*/
+BOOL getBaseIndicatorsKey(const StrategyParams* pParams, int variant, const Base_Indicators* pIndicators, BaseIndicatorsKey* pKey);
+
+/**
+* Loads the Base indicators, reusing the values of another instance when it already computed them for the same key.
+* The first instance to reach a key runs the loader, instances reaching it meanwhile wait for its values.
+* Safe to call from several threads.
+*
+* @param StrategyParams* pParams
+*   The parameters passed to the strategy.
+*
+* @param int variant
+*   Caller defined value for the parameters the loader reads.
+*
+* @param BaseIndicatorsLoader loader
+*   Computes the indicators on a miss.
+*
+* @param Base_Indicators* pIndicators
+*   The indicators to load. The strategy and weekly MA modes must be set.
+*
+* @return AsirikuyReturnCode
+*   The code returned by the loader. Only successful values are shared.
+*/
+AsirikuyReturnCode loadCachedBaseIndicators(StrategyParams* pParams, int variant, BaseIndicatorsLoader loader, Base_Indicators* pIndicators);
+
+/**
+* Reads the cache counters.
+*
+* @param BaseIndicatorsCacheStats* pStats
+*   Receives the counters.
+*/
+void getBaseIndicatorsCacheStats(BaseIndicatorsCacheStats* pStats);
+
+/**
+* Returns the fraction of lookups served from the cache.
+*
+* @return double
+*   Between 0 and 1, 0 before the first lookup.
+*/
+double getBaseIndicatorsCacheHitRate();
+
+/**
+* Drops all the cached values and clears the counters.
+*/
+void resetBaseIndicatorsCache();
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BASE_INDICATORS_CACHE_H_ */
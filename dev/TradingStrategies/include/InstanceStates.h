@@ -82,6 +82,14 @@ void initializeInstanceStates(const char* folderPath);
 */
 void loadInstanceState(int instanceId);
 
+/**
+* Writes the state of an instance now if it is still waiting for the write-behind thread.
+*
+* @param int instanceId
+*   The ID of the instance.
+*/
+void flushInstanceState(int instanceId);
+
 /**
 * Get's the state of the specified instance.
 *
@@ -54,8 +54,9 @@ extern "C" {
 #include "Base.h"
 
 /**
- * Saves an array of string and double to a file
- * so that the front-ends can use this information to draw UI objects
+ * Saves an array of string and double to the status segment and,
+ * when a file dump is due, to a file so that the front-ends can use
+ * this information to draw UI objects
  */
 AsirikuyReturnCode saveUserInterfaceValues(char* userInterfaceVariableNames[15], double userInterfaceValues[15], int userInterfaceElementsCount, int instanceID, BOOL isBackTesting);
 
@@ -76,6 +77,12 @@ AsirikuyReturnCode requestTempFileFolderPath(char* tempPath);
  */
 AsirikuyReturnCode saveUserHeartBeat(int instanceID, BOOL isBackTesting);
 
+/**
+ * sets how often the UI, heart beat and weekly ATR files are written, in seconds.
+ * 0, the default, writes them on every call. The values are always updated in the status segment, -1 disables the files.
+ */
+AsirikuyReturnCode setUserInterfaceFileDumpInterval(int seconds);
+
 double readRiskFile(BOOL isBackTesting);
 int readRateFile(int instanceID, BOOL isBackTesting);
 int readXAUUSDKeyNewsDateFile(time_t *pKeyDates);
@@ -206,6 +206,10 @@ typedef struct order_turning_info_t
 } Order_Turning_Info;
 
 AsirikuyReturnCode runBase(StrategyParams* pParams, Base_Indicators * pIndicators);
+
+/* Forgets the closed bar values runBase keeps for an instance, so its ID starts clean and its slot can be reused. */
+void releaseBaseSnapshot(int instanceId);
+
 AsirikuyReturnCode base_ModifyOrders(StrategyParams* pParams, OrderType orderType, double stopLoss, double takePrice);
 int getMATrend(double iATR, int ratesArrayIndex, int index);
 int getMATrendBase(int rateShort,int rateLong,double iATR, int ratesArrayIndex, int index);
@@ -7,6 +7,37 @@
   #include "AsirikuyDefines.h"
 #endif
 
+#include "BarFile.h"
+
+#define SCREENING_SYMBOL_SIZE 32
+
+/* One row of a batch screening. */
+typedef struct screeningResult_t
+{
+  char               symbol[SCREENING_SYMBOL_SIZE];
+  AsirikuyReturnCode returnCode;  /* SUCCESS, or why the symbol could not be screened */
+  time_t             barTime;     /* Open time of the last hourly bar screened */
+  int                dailyTrend;
+  int                daily3RulesTrend;
+  int                weeklyTrend;
+  int                weekly3RulesTrend;
+  double             dailyS;
+  double             dailyR;
+  double             dailyTP;
+  double             weeklyS;
+  double             weeklyR;
+  double             weeklyTP;
+  double             dailyATR;
+  double             weeklyATR;
+} ScreeningResult;
+
+typedef struct screeningBatchSettings_t
+{
+  int    totalThreads;        /* 0 for one per processor */
+  int    atrAveragingPeriod;  /* Daily ATR period, ATR_AVERAGING_PERIOD of a screening instance */
+  time_t asOfTime;            /* Only the hourly bars opened up to this time are screened, 0 for all of them */
+} ScreeningBatchSettings;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,6 +53,61 @@ extern "C" {
 */
 AsirikuyReturnCode runScreening(StrategyParams* pParams);
 
+/**
+* Forgets the closed bar values runScreening keeps for an instance, so its ID starts clean and its slot can be reused.
+*
+* @param int instanceId
+*   The strategy instance.
+*/
+void releaseScreeningSnapshot(int instanceId);
+
+/**
+* Screens a list of symbols from their hourly history on a pool of worker threads.
+* The 4H, daily and weekly bars are built from the hourly ones.
+*
+* @param const char* historyFolder
+*   The folder holding a SYMBOL_60.bin binary bar file or a SYMBOL_60.csv file (as written by RecordBars) per symbol.
+*
+* @param const char** symbols
+*   The symbols to screen.
+*
+* @param int totalSymbols
+*   The number of symbols.
+*
+* @param const ScreeningBatchSettings* pSettings
+*   The batch settings.
+*
+* @param ScreeningResult* pResults
+*   Receives one row per symbol, in the order of the symbols.
+*
+* @return enum AsirikuyReturnCode
+*   An error if the batch could not run. Errors of single symbols are reported in their rows.
+*/
+AsirikuyReturnCode runScreeningBatch(const char* historyFolder, const char** symbols, int totalSymbols, const ScreeningBatchSettings* pSettings, ScreeningResult* pResults);
+
+/**
+* Screens a list of symbols from hourly history already in memory on a pool of worker threads.
+*
+* @param const char** symbols
+*   The symbols to screen.
+*
+* @param const BarSeries* pHourlySeries
+*   The hourly bars of each symbol, oldest first.
+*
+* @param int totalSymbols
+*   The number of symbols.
+*
+* @param const ScreeningBatchSettings* pSettings
+*   The batch settings.
+*
+* @param ScreeningResult* pResults
+*   Receives one row per symbol, in the order of the symbols.
+*
+* @return enum AsirikuyReturnCode
+*   An error if the batch could not run. Errors of single symbols are reported in their rows.
+*/
+AsirikuyReturnCode runScreeningOnSeries(const char** symbols, const BarSeries* pHourlySeries, int totalSymbols, const ScreeningBatchSettings* pSettings, ScreeningResult* pResults);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
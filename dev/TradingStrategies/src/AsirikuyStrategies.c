@@ -256,7 +256,7 @@ AsirikuyReturnCode runStrategy(StrategyParams* pParams)
   for(i = 0; i < pParams->settings[ORDERINFO_ARRAY_SIZE]; i++)
   {
 	  if (pParams->orderInfo[i].openTime == openTime(1) && pParams->orderInfo[i].instanceId == pParams->settings[STRATEGY_INSTANCE_ID]){
-	  recordData(pParams,(int)pParams->orderInfo[i].type);
+	  recordData(pParams, pParams->orderInfo[i].ticket, (int)pParams->orderInfo[i].type);
 	  }
   }
 
@@ -0,0 +1,379 @@
+/**
+ * @file
+ * @brief     Process wide cache of the Base indicators shared by the instances trading the same symbol.
+ * 
+ * @version   F4.x.x
+ * @date      2026
+ *
+ * @copyright END-USER LICENSE AGREEMENT FOR ASIRIKUY SOFTWARE. IMPORTANT PLEASE READ THE TERMS AND CONDITIONS OF THIS LICENSE AGREEMENT CAREFULLY BEFORE USING THIS SOFTWARE: 
+ * @copyright Asirikuy's End-User License Agreement ("EULA") is a legal agreement between you (either an individual or a single entity) and Asirikuy for the use of the Asirikuy Framework in both source and binary forms. By installing, copying, or otherwise using the Asirikuy Framework, you agree to be bound by the terms of this EULA. This license agreement represents the entire agreement concerning the program between you and Asirikuy, (referred to as "licenser"), and it supersedes any prior proposal, representation, or understanding between the parties. If you do not agree to the terms of this EULA, do not install or use the Asirikuy Framework.
+ * @copyright The Asirikuy Framework is protected by copyright laws and international copyright treaties, as well as other intellectual property laws and treaties. The Asirikuy Framework is licensed, not sold.
+ * @copyright 1. GRANT OF LICENSE.
+ * @copyright The Asirikuy Framework is licensed as follows:
+ * @copyright (a) Installation and Use.
+ * @copyright Asirikuy grants you the right to install and use copies of the Asirikuy Framework in both source and binary forms for personal and business use. You may also make modifications to the source code.
+ * @copyright (b) Backup Copies.
+ * @copyright You may make copies of the Asirikuy Framework as may be necessary for backup and archival purposes.
+ * @copyright 2. DESCRIPTION OF OTHER RIGHTS AND LIMITATIONS.
+ * @copyright (a) Maintenance of Copyright Notices.
+ * @copyright You must not remove or alter any copyright notices on any and all copies of the Asirikuy Framework.
+ * @copyright (b) Distribution.
+ * @copyright You may not distribute copies of the Asirikuy Framework in binary or source forms to third parties outside of the Asirikuy community.
+ * @copyright (c) Rental.
+ * @copyright You may not rent, lease, or lend the Asirikuy Framework.
+ * @copyright (d) Compliance with Applicable Laws.
+ * @copyright You must comply with all applicable laws regarding use of the Asirikuy Framework.
+ * @copyright 3. TERMINATION
+ * @copyright Without prejudice to any other rights, Asirikuy may terminate this EULA if you fail to comply with the terms and conditions of this EULA. In such event, you must destroy all copies of the Asirikuy Framework in your possession.
+ * @copyright 4. COPYRIGHT
+ * @copyright All title, including but not limited to copyrights, in and to the Asirikuy Framework and any copies thereof are owned by Asirikuy or its suppliers. All title and intellectual property rights in and to the content which may be accessed through use of the Asirikuy Framework is the property of the respective content owner and may be protected by applicable copyright or other intellectual property laws and treaties. This EULA grants you no rights to use such content. All rights not expressly granted are reserved by Asirikuy.
+ * @copyright 5. NO WARRANTIES
+ * @copyright Asirikuy expressly disclaims any warranty for the Asirikuy Framework. The Asirikuy Framework is provided 'As Is' without any express or implied warranty of any kind, including but not limited to any warranties of merchantability, noninfringement, or fitness of a particular purpose. Asirikuy does not warrant or assume responsibility for the accuracy or completeness of any information, text, graphics, links or other items contained within the Asirikuy Framework. Asirikuy makes no warranties respecting any harm that may be caused by the transmission of a computer virus, worm, time bomb, logic bomb, or other such computer program. Asirikuy further expressly disclaims any warranty or representation to Authorized Users or to any third party.
+ * @copyright 6. LIMITATION OF LIABILITY
+ * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
+ */
+
+#include "Precompiled.h"
+#include "BaseIndicatorsCache.h"
+#include "Logging.h"
+
+#if defined _WIN32 || defined _WIN64
+  #include <windows.h>
+  typedef SRWLOCK            CacheLock;
+  typedef CONDITION_VARIABLE CacheCondition;
+  #define CACHE_LOCK_INIT      SRWLOCK_INIT
+  #define CACHE_CONDITION_INIT CONDITION_VARIABLE_INIT
+#elif defined __linux__ || defined __APPLE__
+  #include <pthread.h>
+  typedef pthread_mutex_t    CacheLock;
+  typedef pthread_cond_t     CacheCondition;
+  #define CACHE_LOCK_INIT      PTHREAD_MUTEX_INITIALIZER
+  #define CACHE_CONDITION_INIT PTHREAD_COND_INITIALIZER
+#else
+  #error "Unsupported operating system"
+#endif
+
+typedef enum cacheEntryState_t
+{
+  ENTRY_EMPTY     = 0,
+  ENTRY_COMPUTING = 1,
+  ENTRY_READY     = 2
+} CacheEntryState;
+
+typedef struct cacheEntry_t
+{
+  CacheEntryState   state;
+  unsigned int      hash;
+  unsigned long     generation;  /* Changes whenever the entry is given to another key */
+  unsigned long     lastUsed;
+  BaseIndicatorsKey key;
+  Base_Indicators   values;
+} CacheEntry;
+
+static CacheLock                gLock      = CACHE_LOCK_INIT;
+static CacheCondition           gComputed  = CACHE_CONDITION_INIT;
+static BOOL                     gIsEnabled = TRUE;
+static unsigned long            gClock     = 0;
+static CacheEntry               gEntries[BASE_INDICATORS_CACHE_SIZE];
+static BaseIndicatorsCacheStats gStats;
+
+static void lockCache()
+{
+#if defined _WIN32 || defined _WIN64
+  AcquireSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_lock(&gLock);
+#endif
+}
+
+static void unlockCache()
+{
+#if defined _WIN32 || defined _WIN64
+  ReleaseSRWLockExclusive(&gLock);
+#else
+  pthread_mutex_unlock(&gLock);
+#endif
+}
+
+/* Must be called with the cache locked. */
+static void waitForComputedValues()
+{
+#if defined _WIN32 || defined _WIN64
+  SleepConditionVariableSRW(&gComputed, &gLock, INFINITE, 0);
+#else
+  pthread_cond_wait(&gComputed, &gLock);
+#endif
+}
+
+static void signalComputedValues()
+{
+#if defined _WIN32 || defined _WIN64
+  WakeAllConditionVariable(&gComputed);
+#else
+  pthread_cond_broadcast(&gComputed);
+#endif
+}
+
+/* FNV-1a over the key bytes. Keys are zero filled before being built so the padding hashes the same. */
+static unsigned int hashKey(const BaseIndicatorsKey* pKey)
+{
+  const unsigned char* pBytes = (const unsigned char*)pKey;
+  unsigned int hash = 2166136261U;
+  size_t i;
+
+  for(i = 0; i < sizeof(BaseIndicatorsKey); i++)
+  {
+    hash = (hash ^ pBytes[i]) * 16777619U;
+  }
+
+  return hash;
+}
+
+static void stampRates(const Rates* pRates, BaseRatesStamp* pStamp)
+{
+  int shift0Index = pRates->info.arraySize - 1;
+
+  pStamp->timeframe = pRates->info.timeframe;
+  pStamp->arraySize = pRates->info.arraySize;
+
+  if(pRates->time == NULL || pRates->info.arraySize < 2)
+  {
+    return;
+  }
+
+  pStamp->openTime        = pRates->time[shift0Index];
+  pStamp->open            = pRates->open[shift0Index];
+  pStamp->high            = pRates->high[shift0Index];
+  pStamp->low             = pRates->low[shift0Index];
+  pStamp->close           = pRates->close[shift0Index];
+  pStamp->lastClosedTime  = pRates->time[shift0Index - 1];
+  pStamp->lastClosedClose = pRates->close[shift0Index - 1];
+}
+
+static CacheEntry* findEntry(unsigned int hash, const BaseIndicatorsKey* pKey)
+{
+  int i;
+
+  for(i = 0; i < BASE_INDICATORS_CACHE_SIZE; i++)
+  {
+    if(gEntries[i].state != ENTRY_EMPTY && gEntries[i].hash == hash && memcmp(&gEntries[i].key, pKey, sizeof(BaseIndicatorsKey)) == 0)
+    {
+      return &gEntries[i];
+    }
+  }
+
+  return NULL;
+}
+
+/* Picks an empty entry, or the least recently used one whose values are not being computed. */
+static CacheEntry* claimEntry()
+{
+  CacheEntry* pVictim = NULL;
+  int i;
+
+  for(i = 0; i < BASE_INDICATORS_CACHE_SIZE; i++)
+  {
+    if(gEntries[i].state == ENTRY_EMPTY)
+    {
+      return &gEntries[i];
+    }
+
+    if(gEntries[i].state == ENTRY_READY && (pVictim == NULL || gEntries[i].lastUsed < pVictim->lastUsed))
+    {
+      pVictim = &gEntries[i];
+    }
+  }
+
+  if(pVictim != NULL)
+  {
+    gStats.evictions++;
+  }
+
+  return pVictim;
+}
+
+static void reportHitRate()
+{
+  if(gStats.lookups % BASE_INDICATORS_CACHE_REPORT == 0)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"loadCachedBaseIndicators() Hit rate = %.1lf%%, lookups = %lu, hits = %lu, waits = %lu, misses = %lu, evictions = %lu, bypasses = %lu",
+      100.0 * gStats.hits / gStats.lookups, gStats.lookups, gStats.hits, gStats.waits, gStats.misses, gStats.evictions, gStats.bypasses);
+  }
+}
+
+void setBaseIndicatorsCacheEnabled(BOOL isEnabled)
+{
+  lockCache();
+  gIsEnabled = isEnabled;
+  unlockCache();
+}
+
+BOOL getBaseIndicatorsKey(const StrategyParams* pParams, int variant, const Base_Indicators* pIndicators, BaseIndicatorsKey* pKey)
+{
+  int i;
+
+  memset(pKey, 0, sizeof(BaseIndicatorsKey));
+
+  if(pParams->tradeSymbol == NULL || strlen(pParams->tradeSymbol) >= BASE_INDICATORS_CACHE_SYMBOL_SIZE)
+  {
+    return FALSE;
+  }
+
+  strcpy(pKey->symbol, pParams->tradeSymbol);
+  pKey->variant      = variant;
+  /* loadIndicators only tells the daily mode from the weekly modes, and only reads the weekly MA mode in the latter. */
+  pKey->strategyMode = pIndicators->strategy_mode > 0;
+  pKey->weeklyMAMode = pKey->strategyMode ? pIndicators->weeklyMAMode : 0;
+
+  if(pParams->bidAsk.bid != NULL && pParams->bidAsk.ask != NULL)
+  {
+    pKey->bid = pParams->bidAsk.bid[0];
+    pKey->ask = pParams->bidAsk.ask[0];
+  }
+
+  for(i = 0; i < BASE_INDICATORS_CACHE_TIMEFRAMES; i++)
+  {
+    stampRates(&pParams->ratesBuffers->rates[i], &pKey->rates[i]);
+  }
+
+  return TRUE;
+}
+
+AsirikuyReturnCode loadCachedBaseIndicators(StrategyParams* pParams, int variant, BaseIndicatorsLoader loader, Base_Indicators* pIndicators)
+{
+  AsirikuyReturnCode returnCode;
+  BaseIndicatorsKey  key;
+  CacheEntry*        pEntry;
+  unsigned long      generation;
+  unsigned int       hash;
+  BOOL               hasWaited = FALSE;
+  int                strategyMode, weeklyMAMode;
+
+  if(pParams == NULL || loader == NULL || pIndicators == NULL)
+  {
+    pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadCachedBaseIndicators() failed. pParams, loader or pIndicators = NULL");
+    return NULL_POINTER;
+  }
+
+  if(!getBaseIndicatorsKey(pParams, variant, pIndicators, &key))
+  {
+    lockCache();
+    gStats.bypasses++;
+    unlockCache();
+    return loader(pParams, pIndicators);
+  }
+
+  hash = hashKey(&key);
+
+  lockCache();
+
+  if(!gIsEnabled)
+  {
+    unlockCache();
+    return loader(pParams, pIndicators);
+  }
+
+  gStats.lookups++;
+
+  /* Another instance may be computing the same key, its values are worth waiting for. */
+  while((pEntry = findEntry(hash, &key)) != NULL && pEntry->state == ENTRY_COMPUTING)
+  {
+    hasWaited = TRUE;
+    waitForComputedValues();
+  }
+
+  if(pEntry != NULL)
+  {
+    pEntry->lastUsed = ++gClock;
+    /* The modes are the caller's inputs, the entry may have been computed with values the key does not tell apart. */
+    strategyMode = pIndicators->strategy_mode;
+    weeklyMAMode = pIndicators->weeklyMAMode;
+    *pIndicators = pEntry->values;
+    pIndicators->strategy_mode = strategyMode;
+    pIndicators->weeklyMAMode  = weeklyMAMode;
+    gStats.hits++;
+    if(hasWaited)
+    {
+      gStats.waits++;
+    }
+    reportHitRate();
+    unlockCache();
+    return SUCCESS;
+  }
+
+  gStats.misses++;
+  reportHitRate();
+
+  pEntry = claimEntry();
+  if(pEntry == NULL)
+  {
+    /* Every entry is being computed, no room to share these values. */
+    gStats.bypasses++;
+    unlockCache();
+    return loader(pParams, pIndicators);
+  }
+
+  pEntry->state      = ENTRY_COMPUTING;
+  pEntry->hash       = hash;
+  pEntry->key        = key;
+  pEntry->lastUsed   = ++gClock;
+  generation         = ++pEntry->generation;
+  unlockCache();
+
+  returnCode = loader(pParams, pIndicators);
+
+  lockCache();
+  if(pEntry->generation == generation)
+  {
+    if(returnCode == SUCCESS)
+    {
+      pEntry->values = *pIndicators;
+      pEntry->state  = ENTRY_READY;
+    }
+    else
+    {
+      pEntry->state = ENTRY_EMPTY;
+    }
+  }
+  signalComputedValues();
+  unlockCache();
+
+  return returnCode;
+}
+
+void getBaseIndicatorsCacheStats(BaseIndicatorsCacheStats* pStats)
+{
+  lockCache();
+  *pStats = gStats;
+  unlockCache();
+}
+
+double getBaseIndicatorsCacheHitRate()
+{
+  double hitRate = 0;
+
+  lockCache();
+  if(gStats.lookups > 0)
+  {
+    hitRate = (double)gStats.hits / gStats.lookups;
+  }
+  unlockCache();
+
+  return hitRate;
+}
+
+void resetBaseIndicatorsCache()
+{
+  int i;
+
+  lockCache();
+  for(i = 0; i < BASE_INDICATORS_CACHE_SIZE; i++)
+  {
+    /* Loaders still running see the generation change and keep their values to themselves. */
+    gEntries[i].state = ENTRY_EMPTY;
+    gEntries[i].generation++;
+  }
+  memset(&gStats, 0, sizeof(BaseIndicatorsCacheStats));
+  signalComputedValues();
+  unlockCache();
+}
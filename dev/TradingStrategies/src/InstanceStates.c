@@ -38,6 +38,7 @@
 #include "Precompiled.h"
 #include "InstanceStates.h"
 #include "CriticalSection.h"
+#include "WriteBehind.h"
 #include "EasyTradeCWrapper.hpp"
 
 #define INSTANCE_STATES_FILENAME_EXTENSION ".state"
@@ -66,6 +67,17 @@ void initializeInstanceStates(const char* folderPath)
   strcpy(gInstanceStatesFolder, folderPath);
 }
 
+static void getInstanceStatePath(int instanceId, char* pPath)
+{
+  char instanceIdString[MAX_FILE_PATH_CHARS] = "";
+
+  strcpy(pPath, gInstanceStatesFolder);
+  strcat(pPath, "/");
+  sprintf(instanceIdString, "%d", instanceId);
+  strcat(pPath, instanceIdString);
+  strcat(pPath, INSTANCE_STATES_FILENAME_EXTENSION);
+}
+
 static int safe_getInstanceIndex(int instanceId)
 {
   int i;
@@ -94,7 +106,6 @@ static int safe_getInstanceIndex(int instanceId)
 void loadInstanceState(int instanceId)
 {
   FILE *file;
-  char instanceIdString[MAX_FILE_PATH_CHARS] = "";
   char path[MAX_FILE_PATH_CHARS] = "";
   int  instanceIndex = safe_getInstanceIndex(instanceId);
 
@@ -104,11 +115,13 @@ void loadInstanceState(int instanceId)
     return;
   }
 
-  strcpy(path, gInstanceStatesFolder);
-  strcat(path, "/");
-  sprintf(instanceIdString,  "%d", instanceId);
-  strcat(path, instanceIdString);
-  strcat(path, INSTANCE_STATES_FILENAME_EXTENSION);
+  /* A state still waiting to be written is newer than the file. If it can't be written, the one in memory is kept. */
+  if((flushWriteBehind(instanceId) != SUCCESS) && (gInstanceStates[instanceIndex].instanceId == instanceId))
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadInstanceState() Failed to write the queued state of instance %d. Keeping the state in memory.", instanceId);
+    return;
+  }
+  getInstanceStatePath(instanceId, path);
 
   file = fopen(path, "rb");
   if(!file)
@@ -119,7 +132,12 @@ void loadInstanceState(int instanceId)
   }
 
   pantheios_logprintf(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"loadInstanceState() Loading instance state from %s", path);
-  fread(&gInstanceStates[instanceIndex], sizeof(InstanceState), 1, file);
+  if(fread(&gInstanceStates[instanceIndex], sizeof(InstanceState), 1, file) != 1)
+  {
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"loadInstanceState() %s is truncated. Starting from an empty state.", path);
+    initializeInstanceState(instanceIndex);
+    gInstanceStates[instanceIndex].instanceId = instanceId;
+  }
   fclose(file);
 
   pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"loadInstanceState() InstanceId = %d, States Index = %d, instance ID = %d, Is parameter space loaded = %d, Last order update time = %d, Last Run time = %d, ", instanceId, instanceIndex, gInstanceStates[instanceIndex].instanceId, gInstanceStates[instanceIndex].isParameterSpaceLoaded, gInstanceStates[instanceIndex].lastOrderUpdateTime, gInstanceStates[instanceIndex].lastRunTime);
@@ -138,10 +156,9 @@ InstanceState* getInstanceState(int instanceId)
   return &gInstanceStates[instanceIndex];
 }
 
+/* Queues a copy of the state for the write-behind thread, so the caller never waits for the disk. */
 static void backupInstanceState(int instanceId)
 {
-  FILE *file;
-  char instanceIdString[MAX_FILE_PATH_CHARS] = "";
   char path[MAX_FILE_PATH_CHARS] = "";
   int  instanceIndex = safe_getInstanceIndex(instanceId);
 
@@ -153,21 +170,18 @@ static void backupInstanceState(int instanceId)
 
   pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"backupInstanceState() InstanceId = %d, States Index = %d, instance ID = %d, Is parameter space loaded = %d, Last order update time = %d, Last Run time = %d, ", instanceId, instanceIndex, gInstanceStates[instanceIndex].instanceId, gInstanceStates[instanceIndex].isParameterSpaceLoaded, gInstanceStates[instanceIndex].lastOrderUpdateTime, gInstanceStates[instanceIndex].lastRunTime);
 
-  strcpy(path, gInstanceStatesFolder);
-  strcat(path, "/");
-  sprintf(instanceIdString, "%d", instanceId);
-  strcat(path, instanceIdString);
-  strcat(path, INSTANCE_STATES_FILENAME_EXTENSION);
-
-  file = fopen(path, "wb");
-  if(file)
+  getInstanceStatePath(instanceId, path);
+  if(queueWriteBehind(instanceId, path, &gInstanceStates[instanceIndex], sizeof(InstanceState)) != SUCCESS)
   {
-    fwrite(&gInstanceStates[instanceIndex], sizeof(InstanceState), 1, file);
-    fclose(file);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"backupInstanceState() Failed to write %s. Cannot backup instance states.", path);
   }
-  else
+}
+
+void flushInstanceState(int instanceId)
+{
+  if(flushWriteBehind(instanceId) != SUCCESS)
   {
-    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"backupInstanceState() Failed to open %s. Cannot backup instance states.", path);
+    pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"flushInstanceState() Failed to write the state of instance %d.", instanceId);
   }
 }
 
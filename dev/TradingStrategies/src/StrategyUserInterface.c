@@ -43,9 +43,135 @@
 #include <curl/curl.h> /* added for curl_getdate prototype (fix C4013) */
 
 #include "Logging.h"
+#include "StatusSegment.h"
+#include "FileCache.h"
 
 static char tempFilePath[MAX_FILE_PATH_CHARS] ;
 
+/* Seconds between file dumps of the status slots, 0 on every call, -1 to only update the status segment. */
+static int    gUiFileDumpInterval = 0;
+static time_t gUiDumpTimes[MAX_INSTANCES];
+static time_t gHeartBeatDumpTimes[MAX_INSTANCES];
+static time_t gWeeklyATRDumpTimes[STATUS_MAX_SYMBOLS];
+
+/* Files are always written when there is no status slot so that nothing is lost without shared memory. */
+static BOOL isFileDumpDue(time_t* pLastDumpTime, time_t now)
+{
+  if(pLastDumpTime == NULL)
+  {
+    return TRUE;
+  }
+
+  if((gUiFileDumpInterval < 0) || (now - *pLastDumpTime < gUiFileDumpInterval))
+  {
+    return FALSE;
+  }
+
+  *pLastDumpTime = now;
+  return TRUE;
+}
+
+AsirikuyReturnCode setUserInterfaceFileDumpInterval(int seconds)
+{
+  gUiFileDumpInterval = seconds;
+  pantheios_logprintf(PANTHEIOS_SEV_NOTICE, (PAN_CHAR_T*)"UI file dump interval set to : %d", seconds);
+
+  return SUCCESS;
+}
+
+/* Returns the next line of a file's text, advancing past it. Like fgets, an exhausted text keeps returning an empty line. */
+static const char* nextLine(const char** ppText)
+{
+	const char* pLine = *ppText;
+	const char* pEnd = strchr(pLine, '\n');
+
+	*ppText = (pEnd != NULL) ? pEnd + 1 : pLine + strlen(pLine);
+	return pLine;
+}
+
+typedef struct weeklyATR_t
+{
+	double predictWeeklyATR;
+	double predictWeeklyMaxATR;
+} WeeklyATR;
+
+static BOOL parseWeeklyATRFile(const char* pText, void* pValue)
+{
+	WeeklyATR* pATR = (WeeklyATR*)pValue;
+
+	pATR->predictWeeklyATR = atof(nextLine(&pText));
+	pATR->predictWeeklyMaxATR = atof(nextLine(&pText));
+	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readWeeklyATRFile() pPredictWeeklyATR= %f,pPredictWeeklyMaxATR=%f", pATR->predictWeeklyATR, pATR->predictWeeklyMaxATR);
+
+	return TRUE;
+}
+
+static BOOL parseRateFile(const char* pText, void* pValue)
+{
+	int* pRate = (int*)pValue;
+
+	*pRate = -1;
+	while (*pText != '\0') {
+		*pRate = atoi(nextLine(&pText));
+	}
+	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readRateFile() rateTimes= %d", *pRate);
+
+	return TRUE;
+}
+
+static BOOL parseRiskFile(const char* pText, void* pValue)
+{
+	double* pRisk = (double*)pValue;
+
+	*pRisk = 1.0;
+	while (*pText != '\0') {
+		*pRisk = atof(nextLine(&pText));
+	}
+	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"readRiskFile() risk= %f", *pRisk);
+
+	return TRUE;
+}
+
+static BOOL parseTradingInfo(const char* pText, void* pValue)
+{
+	Order_Info* pOrderInfo = (Order_Info*)pValue;
+
+	pOrderInfo->orderNumber = atoi(nextLine(&pText));
+	pOrderInfo->type = atoi(nextLine(&pText));
+	pOrderInfo->orderStatus = atoi(nextLine(&pText));
+	pOrderInfo->openPrice = atof(nextLine(&pText));
+	pOrderInfo->stopLossPrice = atof(nextLine(&pText));
+	pOrderInfo->takeProfitPrice = atof(nextLine(&pText));
+	pOrderInfo->timeStamp = atoi(nextLine(&pText));
+
+	return TRUE;
+}
+
+static BOOL parseTurningPoint(const char* pText, void* pValue)
+{
+	Order_Turning_Info* pOrderTurning = (Order_Turning_Info*)pValue;
+
+	pOrderTurning->type = atoi(nextLine(&pText));
+	pOrderTurning->isTurning = atoi(nextLine(&pText));
+
+	return TRUE;
+}
+
+static BOOL parseVirtualOrderInfo(const char* pText, void* pValue)
+{
+	OrderInfo* pOrderInfo = (OrderInfo*)pValue;
+
+	pOrderInfo->ticket = atoi(nextLine(&pText));
+	pOrderInfo->type = atoi(nextLine(&pText));
+	pOrderInfo->isOpen = atoi(nextLine(&pText));
+	pOrderInfo->openPrice = atof(nextLine(&pText));
+	pOrderInfo->stopLoss = atof(nextLine(&pText));
+	pOrderInfo->takeProfit = atof(nextLine(&pText));
+	pOrderInfo->openTime = atoi(nextLine(&pText));
+
+	return TRUE;
+}
+
 AsirikuyReturnCode setTempFileFolderPath(char* tempPath)
 {
 		strcpy (tempFilePath,tempPath);
@@ -69,6 +195,8 @@ AsirikuyReturnCode saveUserInterfaceValues(char* userInterfaceVariableNames[TOTA
 	char extension[] = ".ui" ;
 	int n;
 	FILE *fp;
+	InstanceStatus* pStatus;
+	time_t now;
 
 	if(isBackTesting)
 	{
@@ -76,6 +204,26 @@ AsirikuyReturnCode saveUserInterfaceValues(char* userInterfaceVariableNames[TOTA
     return SUCCESS;
   }
 
+	now = time(NULL);
+	pStatus = getInstanceStatus(instanceID);
+	if(pStatus != NULL)
+	{
+		beginStatusWrite(&pStatus->sequence);
+		for(n = 0; n < userInterfaceElementsCount && n < STATUS_MAX_UI_VALUES; n++)
+		{
+			strncpy(pStatus->uiNames[n], (userInterfaceVariableNames[n] != NULL) ? userInterfaceVariableNames[n] : "", STATUS_UI_NAME_SIZE - 1);
+			pStatus->uiNames[n][STATUS_UI_NAME_SIZE - 1] = '\0';
+			pStatus->uiValues[n] = userInterfaceValues[n];
+		}
+		pStatus->uiValuesCount = n;
+		endStatusWrite(&pStatus->sequence);
+	}
+
+	if(!isFileDumpDue((pStatus != NULL) ? &gUiDumpTimes[pStatus - openStatusSegment(TRUE)->instances] : NULL, now))
+	{
+		return SUCCESS;
+	}
+
     sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
 	strcat(buffer, instanceIDName);
@@ -109,6 +257,7 @@ AsirikuyReturnCode saveUserHeartBeat(int instanceID, BOOL isBackTesting)
 	time_t rawtime;
     struct tm timeinfo;
     FILE *fp;
+	InstanceStatus* pStatus;
 
 	/* This function is in the StrategyUserInterface.c file because 
 	it's information is used to draw a part of the UI 
@@ -123,6 +272,20 @@ AsirikuyReturnCode saveUserHeartBeat(int instanceID, BOOL isBackTesting)
 	time ( &rawtime );
     safe_gmtime(&timeinfo, rawtime);
 
+	pStatus = getInstanceStatus(instanceID);
+	if(pStatus != NULL)
+	{
+		beginStatusWrite(&pStatus->sequence);
+		pStatus->heartBeatTime = (int)rawtime;
+		pStatus->heartBeatHour = timeinfo.tm_hour;
+		endStatusWrite(&pStatus->sequence);
+	}
+
+	if(!isFileDumpDue((pStatus != NULL) ? &gHeartBeatDumpTimes[pStatus - openStatusSegment(TRUE)->instances] : NULL, rawtime))
+	{
+		return SUCCESS;
+	}
+
     sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
 	strcat(buffer, instanceIDName);
@@ -150,10 +313,10 @@ AsirikuyReturnCode savePredicatedWeeklyATR(char * pName, double predicatedWeekly
 {
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_weekly.txt";
-	char timeString[MAX_TIME_STRING_SIZE] = "";
+	char text[MAX_FILE_PATH_CHARS];
 	time_t rawtime;
 	struct tm timeinfo;
-	FILE *fp;
+	SymbolStatus* pStatus;
 
 	if (isBackTesting)
 	{
@@ -164,26 +327,34 @@ AsirikuyReturnCode savePredicatedWeeklyATR(char * pName, double predicatedWeekly
 	time(&rawtime);
 	safe_gmtime(&timeinfo, rawtime);
 
+	pStatus = getSymbolStatus(pName);
+	if (pStatus != NULL)
+	{
+		beginStatusWrite(&pStatus->sequence);
+		pStatus->updateTime            = (int)rawtime;
+		pStatus->predictedWeeklyATR    = predicatedWeeklyATR;
+		pStatus->predictedMaxWeeklyATR = predicatedMaxWeeklyATR;
+		endStatusWrite(&pStatus->sequence);
+	}
+
+	if (!isFileDumpDue((pStatus != NULL) ? &gWeeklyATRDumpTimes[pStatus - openStatusSegment(TRUE)->symbols] : NULL, rawtime))
+	{
+		return SUCCESS;
+	}
+
 	strcat(buffer, tempFilePath);
 	strcat(buffer, pName);
 	strcat(buffer, extension);
 
 	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"saveUserInterfaceValues() Saving weekly ATR to : %s", buffer);
 
-	fp = fopen(buffer, "w");
-	if (fp == NULL)
+	sprintf(text, "%lf\n%lf\n", predicatedWeeklyATR, predicatedMaxWeeklyATR);
+	if (writeFileCache(buffer, text, parseWeeklyATRFile, sizeof(WeeklyATR)) != SUCCESS)
 	{
 		pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"saveUserInterfaceValues() Failed to open weekly ATR file.");
 		return NULL_POINTER;
 	}
 
-	fprintf(fp, "%lf\n", predicatedWeeklyATR);
-	fprintf(fp, "%lf\n", predicatedMaxWeeklyATR);
-	
-
-
-	fclose(fp);
-
 	return SUCCESS;
 }
 
@@ -192,7 +363,7 @@ AsirikuyReturnCode saveRateFile(int instanceID, int rate,BOOL isBackTesting)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_rate.txt";
-	FILE *fp;
+	char text[MAX_FILE_PATH_CHARS];
 
 	/* This function is in the StrategyUserInterface.c file because
 	it's information is used to draw a part of the UI
@@ -211,15 +382,8 @@ AsirikuyReturnCode saveRateFile(int instanceID, int rate,BOOL isBackTesting)
 
 	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"saveRateFile() %s", buffer);
 
-	fp = fopen(buffer, "w");
-	if (fp == NULL)
-	{
-		return SUCCESS;
-	}
-
-	fprintf(fp, "%d\n", rate);
-
-	fclose(fp);
+	sprintf(text, "%d\n", rate);
+	writeFileCache(buffer, text, parseRateFile, sizeof(int));
 
 	return SUCCESS;
 }
@@ -228,9 +392,10 @@ int readWeeklyATRFile(char * pName,double *pPredictWeeklyATR,double *pPredictWee
 {	
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_weekly.txt";
-	char line[1024] = "";
-	FILE *fp;
 	int rateErrorTimes = -1;
+	SymbolStatus* pStatus;
+	SymbolStatus status;
+	WeeklyATR weeklyATR;
 
 	/* This function is in the StrategyUserInterface.c file because
 	it's information is used to draw a part of the UI
@@ -242,26 +407,26 @@ int readWeeklyATRFile(char * pName,double *pPredictWeeklyATR,double *pPredictWee
 		return 0;
 	}
 
+	/* The status segment holds the latest prediction, the file is only needed when it doesn't. */
+	pStatus = getSymbolStatus(pName);
+	if (pStatus != NULL && readSymbolStatus(pStatus, &status) && status.updateTime != 0)
+	{
+		*pPredictWeeklyATR = status.predictedWeeklyATR;
+		*pPredictWeeklyMaxATR = status.predictedMaxWeeklyATR;
+		return 1;
+	}
+
 	strcat(buffer, tempFilePath);
 	strcat(buffer, pName);
 	strcat(buffer, extension);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readWeeklyATRFile() %s", buffer);
-
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
+	if (!readFileCache(buffer, parseWeeklyATRFile, &weeklyATR, sizeof(WeeklyATR)))
 	{
 		return rateErrorTimes;
 	}
 
-	fgets(line, 1024, fp);
-	*pPredictWeeklyATR = atof(line);
-	fgets(line, 1024, fp);
-	*pPredictWeeklyMaxATR = atof(line);
-	
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readWeeklyATRFile() pPredictWeeklyATR= %f,pPredictWeeklyMaxATR=%f", *pPredictWeeklyATR, *pPredictWeeklyMaxATR);
-
-	fclose(fp);
+	*pPredictWeeklyATR = weeklyATR.predictWeeklyATR;
+	*pPredictWeeklyMaxATR = weeklyATR.predictWeeklyMaxATR;
 
 	return 1;
 	
@@ -272,8 +437,6 @@ int readRateFile(int instanceID, BOOL isBackTesting)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_rate.txt";
-	char line[1024] = "";
-	FILE *fp;
 	int rateErrorTimes = -1;
 
 	/* This function is in the StrategyUserInterface.c file because
@@ -291,20 +454,7 @@ int readRateFile(int instanceID, BOOL isBackTesting)
 	strcat(buffer, instanceIDName);
 	strcat(buffer, extension);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readRateFile() %s", buffer);
-
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
-	{		
-		return rateErrorTimes;
-	}
-
-	while (fgets(line, 1024, fp)) {
-		rateErrorTimes = atoi(line);
-	}
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readRateFile() rateTimes= %d", rateErrorTimes);
-
-	fclose(fp);
+	readFileCache(buffer, parseRateFile, &rateErrorTimes, sizeof(int));
 
 	return rateErrorTimes;
 }
@@ -313,8 +463,6 @@ double readRiskFile(BOOL isBackTesting)
 {
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "risk.txt";
-	char line[1024] = "";
-	FILE* fp;
 	double risk = 1.0;
 
 	/* This function is in the StrategyUserInterface.c file because
@@ -330,20 +478,7 @@ double readRiskFile(BOOL isBackTesting)
 	strcat(buffer, tempFilePath);
 	strcat(buffer, extension);
 
-	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"readRiskFile() %s", buffer);
-
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
-	{
-		return risk;
-	}
-
-	while (fgets(line, 1024, fp)) {
-		risk = atof(line);
-	}
-	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"readRiskFile() risk= %f", risk);
-
-	fclose(fp);
+	readFileCache(buffer, parseRiskFile, &risk, sizeof(double));
 
 	return risk;
 }
@@ -413,8 +548,7 @@ AsirikuyReturnCode saveTradingInfo(int instanceID, Order_Info * pOrderInfo)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_OrderInfo.txt";
-	char timeString[MAX_TIME_STRING_SIZE] = "";		
-	FILE *fp;
+	char text[FILE_CACHE_MAX_TEXT_SIZE];
 
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
@@ -423,24 +557,14 @@ AsirikuyReturnCode saveTradingInfo(int instanceID, Order_Info * pOrderInfo)
 
 	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"saveTradingInfo() Saving trading order info to : %s", buffer);
 
-	fp = fopen(buffer, "w");
-	if (fp == NULL)
+	sprintf(text, "%d\n%d\n%d\n%f\n%f\n%f\n%d\n", pOrderInfo->orderNumber, pOrderInfo->type, pOrderInfo->orderStatus,
+		pOrderInfo->openPrice, pOrderInfo->stopLossPrice, pOrderInfo->takeProfitPrice, pOrderInfo->timeStamp);
+	if (writeFileCache(buffer, text, parseTradingInfo, sizeof(Order_Info)) != SUCCESS)
 	{
 		pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"saveTradingInfo() Failed to open trading order info file.");
 		return NULL_POINTER;
 	}
 
-	fprintf(fp, "%d\n", pOrderInfo->orderNumber);
-	fprintf(fp, "%d\n", pOrderInfo->type);
-	fprintf(fp, "%d\n", pOrderInfo->orderStatus);
-	fprintf(fp, "%f\n", pOrderInfo->openPrice);
-	fprintf(fp, "%f\n", pOrderInfo->stopLossPrice);
-	fprintf(fp, "%f\n", pOrderInfo->takeProfitPrice);
-	fprintf(fp, "%d\n", pOrderInfo->timeStamp);
-	
-
-	fclose(fp);
-
 	return SUCCESS;
 }
 
@@ -449,46 +573,17 @@ int readTradingInfo(int instanceID, Order_Info *pOrderInfo)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_OrderInfo.txt";
-	char line[1024] = "";
-	FILE *fp;
-	time_t now;
-	int i = 0;
-	char       timeString[MAX_TIME_STRING_SIZE] = "";
-	//struct tm timeInfo1;
-
-
 
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
 	strcat(buffer, instanceIDName);
 	strcat(buffer, extension);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readTradingInfo() %s", buffer);
 
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
+	if (!readFileCache(buffer, parseTradingInfo, pOrderInfo, sizeof(Order_Info)))
 	{
 		return -1;
 	}
 
-	now = time(NULL);
-
-	fgets(line, 1024, fp);
-	pOrderInfo->orderNumber= atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->type = atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->orderStatus = atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->openPrice = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->stopLossPrice = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->takeProfitPrice = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->timeStamp = atoi(line);
-	
-	fclose(fp);
-
 	return 0;
 }
 
@@ -497,7 +592,7 @@ AsirikuyReturnCode saveTurningPoint(int instanceID, Order_Turning_Info *pOrderTu
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_turningPoint.txt";
-	FILE *fp;
+	char text[MAX_FILE_PATH_CHARS];
 
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
@@ -506,16 +601,8 @@ AsirikuyReturnCode saveTurningPoint(int instanceID, Order_Turning_Info *pOrderTu
 
 	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"saveTurningPoint() %s", buffer);
 
-	fp = fopen(buffer, "w");
-	if (fp == NULL)
-	{
-		return SUCCESS;
-	}
-		
-	fprintf(fp, "%d\n", pOrderTurning->type);
-	fprintf(fp, "%d\n", pOrderTurning->isTurning);
-
-	fclose(fp);
+	sprintf(text, "%d\n%d\n", pOrderTurning->type, pOrderTurning->isTurning);
+	writeFileCache(buffer, text, parseTurningPoint, sizeof(Order_Turning_Info));
 
 	return SUCCESS;
 }
@@ -525,30 +612,17 @@ int readTurningPoint(int instanceID, Order_Turning_Info *pOrderTurning)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_turningPoint.txt";
-	char line[1024] = "";
-	FILE *fp;	
-	BOOL isTurningPoint = FALSE;
 	
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
 	strcat(buffer, instanceIDName);
 	strcat(buffer, extension);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readTurningPoint() %s", buffer);
 
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
+	if (!readFileCache(buffer, parseTurningPoint, pOrderTurning, sizeof(Order_Turning_Info)))
 	{
-		//pOrderTurning->isTurning = TRUE;
 		return -1;
 	}
 
-	fgets(line, 1024, fp);
-	pOrderTurning->type = atoi(line);
-	fgets(line, 1024, fp);
-	pOrderTurning->isTurning = atoi(line);
-	
-	fclose(fp);
-
 	return 0;
 }
 
@@ -557,8 +631,7 @@ AsirikuyReturnCode saveVirutalOrdergInfo(int instanceID, OrderInfo orderInfo)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_VirutalOrderInfo.txt";
-	char timeString[MAX_TIME_STRING_SIZE] = "";
-	FILE *fp;
+	char text[FILE_CACHE_MAX_TEXT_SIZE];
 
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
@@ -567,24 +640,14 @@ AsirikuyReturnCode saveVirutalOrdergInfo(int instanceID, OrderInfo orderInfo)
 
 	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"saveTradingInfo() Saving virual order info to : %s", buffer);
 
-	fp = fopen(buffer, "w");
-	if (fp == NULL)
+	sprintf(text, "%d\n%d\n%d\n%f\n%f\n%f\n%d\n", orderInfo.ticket, orderInfo.type, orderInfo.isOpen,
+		orderInfo.openPrice, orderInfo.stopLoss, orderInfo.takeProfit, orderInfo.openTime);
+	if (writeFileCache(buffer, text, parseVirtualOrderInfo, sizeof(OrderInfo)) != SUCCESS)
 	{
 		pantheios_logputs(PANTHEIOS_SEV_CRITICAL, (PAN_CHAR_T*)"saveTradingInfo() Failed to open virual order info file.");
 		return NULL_POINTER;
 	}
 
-	fprintf(fp, "%d\n", orderInfo.ticket);
-	fprintf(fp, "%d\n", orderInfo.type);
-	fprintf(fp, "%d\n", orderInfo.isOpen);
-	fprintf(fp, "%f\n", orderInfo.openPrice);
-	fprintf(fp, "%f\n", orderInfo.stopLoss);
-	fprintf(fp, "%f\n", orderInfo.takeProfit);
-	fprintf(fp, "%d\n", orderInfo.openTime);
-
-
-	fclose(fp);
-
 	return SUCCESS;
 }
 
@@ -593,42 +656,26 @@ int readVirtualOrderInfo(int instanceID, OrderInfo *pOrderInfo)
 	char instanceIDName[TOTAL_UI_VALUES];
 	char buffer[MAX_FILE_PATH_CHARS] = "";
 	char extension[] = "_VirutalOrderInfo.txt";
-	char line[1024] = "";
-	FILE *fp;
-	time_t now;
-	int i = 0;
-	char       timeString[MAX_TIME_STRING_SIZE] = "";
+	OrderInfo fileOrderInfo;
 
 	sprintf(instanceIDName, "%d", instanceID);
 	strcat(buffer, tempFilePath);
 	strcat(buffer, instanceIDName);
 	strcat(buffer, extension);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"readTradingInfo() %s", buffer);
 
-	fp = fopen(buffer, "r");
-	if (fp == NULL)
+	if (!readFileCache(buffer, parseVirtualOrderInfo, &fileOrderInfo, sizeof(OrderInfo)))
 	{
 		return -1;
 	}
 
-	now = time(NULL);
-
-	fgets(line, 1024, fp);
-	pOrderInfo->ticket= atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->type = atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->isOpen = atoi(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->openPrice = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->stopLoss = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->takeProfit = atof(line);
-	fgets(line, 1024, fp);
-	pOrderInfo->openTime = atoi(line);
-
-	fclose(fp);
+	/* The file only carries these fields, the caller's other fields are left alone. */
+	pOrderInfo->ticket = fileOrderInfo.ticket;
+	pOrderInfo->type = fileOrderInfo.type;
+	pOrderInfo->isOpen = fileOrderInfo.isOpen;
+	pOrderInfo->openPrice = fileOrderInfo.openPrice;
+	pOrderInfo->stopLoss = fileOrderInfo.stopLoss;
+	pOrderInfo->takeProfit = fileOrderInfo.takeProfit;
+	pOrderInfo->openTime = fileOrderInfo.openTime;
 
 	return 0;
 }
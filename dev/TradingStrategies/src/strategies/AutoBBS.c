@@ -768,7 +768,7 @@ AsirikuyReturnCode runAutoBBS(StrategyParams* pParams)
 {
 	AsirikuyReturnCode returnCode = SUCCESS;
 	Indicators indicators;
-	Base_Indicators base_Indicators;
+	Base_Indicators base_Indicators = { 0 };
 	int rateErrorTimes = -1;
 	BOOL isRateCheck = TRUE;
 	
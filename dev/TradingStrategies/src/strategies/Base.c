@@ -8,14 +8,72 @@ It mainly provide the trend classification and support, resistance levels.
 #include "EasyTradeCWrapper.hpp"
 #include "base.h"
 #include "InstanceStates.h"
+#include "BarCloseStamp.h"
+#include "RollingExtremum.h"
+#include "BaseIndicatorsCache.h"
+#include "AsyncLog.h"
 
 #define USE_INTERNAL_SL FALSE
 #define USE_INTERNAL_TP FALSE
 
+/* Values computed from closed bars, kept per instance and recomputed only when a new bar opens on their timeframe. */
+typedef struct baseSnapshot_t
+{
+	BarCloseStamp   primaryStamp;
+	BarCloseStamp   hourlyStamp;
+	BarCloseStamp   fourHourlyStamp;
+	BarCloseStamp   dailyStamp;
+	BarCloseStamp   weeklyStamp;
+	Base_Indicators closedBarValues;
+} BaseSnapshot;
+
+static void invalidateBaseSnapshot(BaseSnapshot* pSnapshot)
+{
+	invalidateBarCloseStamp(&pSnapshot->primaryStamp);
+	invalidateBarCloseStamp(&pSnapshot->hourlyStamp);
+	invalidateBarCloseStamp(&pSnapshot->fourHourlyStamp);
+	invalidateBarCloseStamp(&pSnapshot->dailyStamp);
+	invalidateBarCloseStamp(&pSnapshot->weeklyStamp);
+}
+
+static int          gBaseSnapshotOwners[MAX_INSTANCES];
+static BaseSnapshot gBaseSnapshots[MAX_INSTANCES];
+
+static BaseSnapshot* getBaseSnapshot(int instanceId)
+{
+	BOOL isClaimed;
+	int index = claimInstanceStampSlot(gBaseSnapshotOwners, instanceId, &isClaimed);
+
+	if (index < 0)
+	{
+		return NULL;
+	}
+
+	if (isClaimed)
+	{
+		invalidateBaseSnapshot(&gBaseSnapshots[index]);
+	}
+
+	return &gBaseSnapshots[index];
+}
+
+void releaseBaseSnapshot(int instanceId)
+{
+	int index = releaseInstanceStampSlot(gBaseSnapshotOwners, instanceId);
+
+	if (index >= 0)
+	{
+		invalidateBaseSnapshot(&gBaseSnapshots[index]);
+	}
+}
+
+
+static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, Base_Indicators* pIndicators);
 
 AsirikuyReturnCode runBase(StrategyParams* pParams, Base_Indicators * pIndicators)
 {
-	loadIndicators(pParams, pIndicators);	
+	// Instances on the same symbol and bar compute identical values, the first one to get there shares them.
+	loadCachedBaseIndicators(pParams, (int)parameter(ATR_AVERAGING_PERIOD), loadIndicators, pIndicators);
 	return SUCCESS;
 }
 
@@ -26,45 +84,74 @@ static AsirikuyReturnCode loadMonthlyIndicators(StrategyParams* pParams, Base_In
 	int shift1Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 2;
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	}
 	iSRLevels(pParams, pIndicators, B_WEEKLY_RATES, shift1Index, 8, &(pIndicators->monthlyHigh), &(pIndicators->monthlyLow));
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, 10weeksHigh=%lf, 10weeksLow = %lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, 10weeksHigh=%lf, 10weeksLow = %lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->monthlyHigh, pIndicators->monthlyLow);
 	return SUCCESS;
 }
 
-AsirikuyReturnCode loadWeeklyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
-{	
-	int shift0Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 1;		
+static void loadWeeklyMATrend(StrategyParams* pParams, Base_Indicators* pIndicators)
+{
+	if (pIndicators->weeklyMAMode == 0)
+		iTrend_MA(pIndicators->weeklyATR, B_FOURHOURLY_RATES, &(pIndicators->weeklyMATrend));
+	else
+		iTrend_MA_WeeklyBar_For4H(pIndicators->weeklyATR, &(pIndicators->weeklyMATrend));
+}
+
+static AsirikuyReturnCode loadClosedWeeklyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
+{
+	int shift0Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 1;
 	int shift1Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 2;
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
-		
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	}
+
 	iTrend3Rules(pParams, pIndicators, B_WEEKLY_RATES, 2, &(pIndicators->weekly3RulesTrend),0);
 	iTrend_HL(B_WEEKLY_RATES, &(pIndicators->weeklyHLTrend),0);
-	if (pIndicators->weeklyMAMode == 0)
-		iTrend_MA(pIndicators->weeklyATR, B_FOURHOURLY_RATES, &(pIndicators->weeklyMATrend));
-	else
-		iTrend_MA_WeeklyBar_For4H(pIndicators->weeklyATR, &(pIndicators->weeklyMATrend));
 
 	iSRLevels(pParams, pIndicators, B_WEEKLY_RATES, shift1Index,2, &(pIndicators->weeklyHigh), &(pIndicators->weeklyLow));
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weeklyHLTrend = %ld,weeklyMATrend=%ld",
-		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyHLTrend, pIndicators->weeklyMATrend);
-
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weekly3RulesTrend = %ld,weeklyHigh=%lf, weeklyLow = %lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, weekly3RulesTrend = %ld,weeklyHigh=%lf, weeklyLow = %lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weekly3RulesTrend, pIndicators->weeklyHigh, pIndicators->weeklyLow);
 
+	return SUCCESS;
+}
+
+static AsirikuyReturnCode loadFormingWeeklyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
+{
+	int shift0Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 1;
+	char timeString[MAX_TIME_STRING_SIZE] = "";
+
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	}
+
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, weeklyHLTrend = %ld,weeklyMATrend=%ld",
+		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyHLTrend, pIndicators->weeklyMATrend);
+
 	workoutWeeklyTrend(pParams, pIndicators);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weeklyTrend=%ld, weeklySupport = %lf,weeklyResistance = %lf,weeklyTP=%lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, weeklyTrend=%ld, weeklySupport = %lf,weeklyResistance = %lf,weeklyTP=%lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyTrend, pIndicators->weeklyS, pIndicators->weeklyR, pIndicators->weeklyTP);
 
 	predictWeeklyATR(pParams, pIndicators);
 
 	return SUCCESS;
+}
 
+AsirikuyReturnCode loadWeeklyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
+{
+	loadClosedWeeklyIndicators(pParams, pIndicators);
+	loadWeeklyMATrend(pParams, pIndicators);
+	return loadFormingWeeklyIndicators(pParams, pIndicators);
 }
 static AsirikuyReturnCode loadIntradayKeyKIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
 {
@@ -79,7 +166,10 @@ static AsirikuyReturnCode loadIntradayKeyKIndicators(StrategyParams* pParams, Ba
 	
 	currentTime = pParams->ratesBuffers->rates[B_PRIMARY_RATES].time[shift0Index];
 	safe_gmtime(&timeInfo1, currentTime);
-	safe_timeString(timeString, currentTime);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, currentTime);
+	}
 
 	pIndicators->intradayTrend = 0;
 	pIndicators->intradyIndex = 0;
@@ -120,7 +210,7 @@ static AsirikuyReturnCode loadIntradayKeyKIndicators(StrategyParams* pParams, Ba
 		}
 	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, intradayTrend = %ld,intradyIndex=%ld",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, intradayTrend = %ld,intradyIndex=%ld",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->intradayTrend, pIndicators->intradyIndex);
 
 
@@ -131,14 +221,17 @@ static AsirikuyReturnCode loadIntradayKeyKIndicators(StrategyParams* pParams, Ba
 If index = 1 -> current day (EOD)
 If index == 0 -> previous day (SOD)
 */
-static AsirikuyReturnCode loadDailyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators,int index)
+static AsirikuyReturnCode loadClosedDailyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators,int index)
 {	
 	int shift0Index = pParams->ratesBuffers->rates[B_DAILY_RATES].info.arraySize - 1;
 	int shift1Index = pParams->ratesBuffers->rates[B_DAILY_RATES].info.arraySize - 2;	
 	char       timeString[MAX_TIME_STRING_SIZE] = "";
 	int pre3KTrend, preHLTrend;
 	
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_DAILY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_DAILY_RATES].time[shift0Index]);
+	}
 
 	iTrend3Rules(pParams, pIndicators, B_DAILY_RATES, 2, &(pIndicators->daily3RulesTrend),index);
 	iTrend_HL(B_DAILY_RATES, &(pIndicators->dailyHLTrend),index);
@@ -147,10 +240,10 @@ static AsirikuyReturnCode loadDailyIndicators(StrategyParams* pParams, Base_Indi
 
 	iSRLevels(pParams, pIndicators, B_DAILY_RATES, shift1Index-index,2, &(pIndicators->dailyHigh), &(pIndicators->dailyLow));
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, dailyHLTrend = %ld,dailyMATrend=%ld",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, dailyHLTrend = %ld,dailyMATrend=%ld",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyHLTrend, pIndicators->dailyMATrend);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, daily3RulesTrend = %ld,dailyHigh=%lf, dailyLow = %lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, daily3RulesTrend = %ld,dailyHigh=%lf, dailyLow = %lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->daily3RulesTrend, pIndicators->dailyHigh, pIndicators->dailyLow);
 
 	
@@ -188,8 +281,21 @@ static AsirikuyReturnCode loadDailyIndicators(StrategyParams* pParams, Base_Indi
 		}
 	}
 
+	return SUCCESS;
+}
+
+static AsirikuyReturnCode loadFormingDailyIndicators(StrategyParams* pParams, Base_Indicators* pIndicators)
+{
+	int shift0Index = pParams->ratesBuffers->rates[B_DAILY_RATES].info.arraySize - 1;
+	char       timeString[MAX_TIME_STRING_SIZE] = "";
+
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_DAILY_RATES].time[shift0Index]);
+	}
+
 	workoutDailyTrend(pParams, pIndicators);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, dailyTrend=%ld, dailySupport = %lf,dailyResistance = %lf��dailyTP=%lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, dailyTrend=%ld, dailySupport = %lf,dailyResistance = %lf��dailyTP=%lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyTrend, pIndicators->dailyS, pIndicators->dailyR, pIndicators->dailyTP);
 
 	predictDailyATR(pParams, pIndicators);
@@ -208,53 +314,151 @@ static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, Base_Indicator
 	time_t currentTime;
 	struct tm timeInfo1;
 	int index = 0;
+	int atrPeriod = (int)parameter(ATR_AVERAGING_PERIOD);
+	BaseSnapshot localSnapshot;
+	BaseSnapshot* pSnapshot = getBaseSnapshot((int)pParams->settings[STRATEGY_INSTANCE_ID]);
+	Base_Indicators* pClosed;
+	BOOL newDailyBar, newWeeklyBar = FALSE, newFourHourlyBar = FALSE;
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_HOURLY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_HOURLY_RATES].time[shift0Index]);
+	}
 
 	currentTime = pParams->ratesBuffers->rates[B_PRIMARY_RATES].time[shift0Index_primary];
 	safe_gmtime(&timeInfo1, currentTime);
 
-	pIndicators->dailyATR = iAtr(B_DAILY_RATES, (int)parameter(ATR_AVERAGING_PERIOD), 1);
+	if (pSnapshot == NULL)
+	{
+		pSnapshot = &localSnapshot;
+		invalidateBaseSnapshot(pSnapshot);
+	}
+
+	// Closed bar values only change when a new bar opens on their timeframe, so they are kept per instance
+	// and only the values depending on the forming bars are worked out on every call.
+	pClosed = &pSnapshot->closedBarValues;
+	pClosed->strategy_mode = pIndicators->strategy_mode;
+	pClosed->weeklyMAMode = pIndicators->weeklyMAMode;
 
-	if (pIndicators->strategy_mode > 0)
-		pIndicators->weeklyATR = iAtr(B_WEEKLY_RATES, 4, 1);
+	newDailyBar = !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[B_DAILY_RATES], atrPeriod, &pSnapshot->dailyStamp);
+	if (newDailyBar)
+	{
+		pClosed->dailyATR = iAtr(B_DAILY_RATES, atrPeriod, 1);
 
-	pIndicators->ma1H50M = iMA(3, B_HOURLY_RATES, 50, 1);
-	pIndicators->ma1H200M = iMA(3, B_HOURLY_RATES, 200, 1);
+		iPivot(B_DAILY_RATES,1, &(pClosed->dailyPivot),
+			&(pClosed->dailyS1), &(pClosed->dailyR1),
+			&(pClosed->dailyS2), &(pClosed->dailyR2),
+			&(pClosed->dailyS3), &(pClosed->dailyR3));
 
-	if (pIndicators->strategy_mode > 0)
+		loadClosedDailyIndicators(pParams, pClosed, 0);
+		setBarCloseStamp(&pParams->ratesBuffers->rates[B_DAILY_RATES], atrPeriod, &pSnapshot->dailyStamp);
+	}
+
+	if (!isBarCloseStampCurrent(&pParams->ratesBuffers->rates[B_HOURLY_RATES], 0, &pSnapshot->hourlyStamp))
 	{
-		pIndicators->ma4H50M = iMA(3, B_FOURHOURLY_RATES, 50, 1);
-		pIndicators->ma4H200M = iMA(3, B_FOURHOURLY_RATES, 200, 1);
+		pClosed->ma1H50M = iMA(3, B_HOURLY_RATES, 50, 1);
+		pClosed->ma1H200M = iMA(3, B_HOURLY_RATES, 200, 1);
+		setBarCloseStamp(&pParams->ratesBuffers->rates[B_HOURLY_RATES], 0, &pSnapshot->hourlyStamp);
 	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, MA1H200M = %lf,MA4H200M=%lf",
-		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->ma1H200M, pIndicators->ma4H200M);
+	if (pIndicators->strategy_mode > 0)
+	{
+		newWeeklyBar = !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[B_WEEKLY_RATES], pIndicators->weeklyMAMode, &pSnapshot->weeklyStamp);
+		if (newWeeklyBar)
+		{
+			pClosed->weeklyATR = iAtr(B_WEEKLY_RATES, 4, 1);
 
-	iPivot(B_DAILY_RATES,1, &(pIndicators->dailyPivot),
-		&(pIndicators->dailyS1), &(pIndicators->dailyR1),
-		&(pIndicators->dailyS2), &(pIndicators->dailyR2),
-		&(pIndicators->dailyS3), &(pIndicators->dailyR3));
+			iPivot(B_WEEKLY_RATES, 1, &(pClosed->weeklyPivot),
+				&(pClosed->weeklyS1), &(pClosed->weeklyR1),
+				&(pClosed->weeklyS2), &(pClosed->weeklyR2),
+				&(pClosed->weeklyS3), &(pClosed->weeklyR3));
 
+			loadMonthlyIndicators(pParams, pClosed);
+			loadClosedWeeklyIndicators(pParams, pClosed);
+			setBarCloseStamp(&pParams->ratesBuffers->rates[B_WEEKLY_RATES], pIndicators->weeklyMAMode, &pSnapshot->weeklyStamp);
+		}
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, dailyPivot = %lf,dailyS1=%lf, dailyR1 = %lf,dailyS2=%lf, dailyR2 = %lf,dailyS3=%lf, dailyR3 = %lf",
-		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyPivot, pIndicators->dailyS1, pIndicators->dailyR1, pIndicators->dailyS2, pIndicators->dailyR2, pIndicators->dailyS3, pIndicators->dailyR3);
+		newFourHourlyBar = !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[B_FOURHOURLY_RATES], 0, &pSnapshot->fourHourlyStamp);
+		if (newFourHourlyBar)
+		{
+			pClosed->ma4H50M = iMA(3, B_FOURHOURLY_RATES, 50, 1);
+			pClosed->ma4H200M = iMA(3, B_FOURHOURLY_RATES, 200, 1);
+			setBarCloseStamp(&pParams->ratesBuffers->rates[B_FOURHOURLY_RATES], 0, &pSnapshot->fourHourlyStamp);
+		}
 
-	if (pIndicators->strategy_mode > 0)
+		if (newWeeklyBar || (pIndicators->weeklyMAMode == 0 && newFourHourlyBar))
+			loadWeeklyMATrend(pParams, pClosed);
+	}
+
+	if (newDailyBar || !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[B_PRIMARY_RATES], 0, &pSnapshot->primaryStamp))
 	{
-		iPivot(B_WEEKLY_RATES, 1, &(pIndicators->weeklyPivot),
-			&(pIndicators->weeklyS1), &(pIndicators->weeklyR1),
-			&(pIndicators->weeklyS2), &(pIndicators->weeklyR2),
-			&(pIndicators->weeklyS3), &(pIndicators->weeklyR3));
+		loadIntradayKeyKIndicators(pParams, pClosed);
 
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weeklyPivot = %lf,weeklyS1=%lf, weeklyR1 = %lf,weeklyS2=%lf, weeklyR2 = %lf,weeklyS3=%lf, weeklyR3 = %lf",
-			(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyPivot, pIndicators->weeklyS1, pIndicators->weeklyR1, pIndicators->weeklyS2, pIndicators->weeklyR2, pIndicators->weeklyS3, pIndicators->weeklyR3);
+		//Those two are used for weekly swing only. They are inactive now.
+		//TODO: should be clean up.
+		pClosed->maTrend = getMATrend(iAtr(B_PRIMARY_RATES, 20, 1), B_PRIMARY_RATES, 1);
+		pClosed->ma_Signal = getMATrend_Signal(B_PRIMARY_RATES);
+		setBarCloseStamp(&pParams->ratesBuffers->rates[B_PRIMARY_RATES], 0, &pSnapshot->primaryStamp);
+	}
+
+	pIndicators->dailyATR = pClosed->dailyATR;
+	pIndicators->ma1H50M = pClosed->ma1H50M;
+	pIndicators->ma1H200M = pClosed->ma1H200M;
+
+	pIndicators->dailyPivot = pClosed->dailyPivot;
+	pIndicators->dailyS1 = pClosed->dailyS1;
+	pIndicators->dailyR1 = pClosed->dailyR1;
+	pIndicators->dailyS2 = pClosed->dailyS2;
+	pIndicators->dailyR2 = pClosed->dailyR2;
+	pIndicators->dailyS3 = pClosed->dailyS3;
+	pIndicators->dailyR3 = pClosed->dailyR3;
+
+	pIndicators->daily3RulesTrend = pClosed->daily3RulesTrend;
+	pIndicators->dailyHLTrend = pClosed->dailyHLTrend;
+	pIndicators->dailyMATrend = pClosed->dailyMATrend;
+	pIndicators->dailyHigh = pClosed->dailyHigh;
+	pIndicators->dailyLow = pClosed->dailyLow;
+
+	pIndicators->intradayTrend = pClosed->intradayTrend;
+	pIndicators->intradyIndex = pClosed->intradyIndex;
+	pIndicators->maTrend = pClosed->maTrend;
+	pIndicators->ma_Signal = pClosed->ma_Signal;
+
+	if (pIndicators->strategy_mode > 0)
+	{
+		pIndicators->weeklyATR = pClosed->weeklyATR;
+		pIndicators->ma4H50M = pClosed->ma4H50M;
+		pIndicators->ma4H200M = pClosed->ma4H200M;
+
+		pIndicators->weeklyPivot = pClosed->weeklyPivot;
+		pIndicators->weeklyS1 = pClosed->weeklyS1;
+		pIndicators->weeklyR1 = pClosed->weeklyR1;
+		pIndicators->weeklyS2 = pClosed->weeklyS2;
+		pIndicators->weeklyR2 = pClosed->weeklyR2;
+		pIndicators->weeklyS3 = pClosed->weeklyS3;
+		pIndicators->weeklyR3 = pClosed->weeklyR3;
+
+		pIndicators->monthlyHigh = pClosed->monthlyHigh;
+		pIndicators->monthlyLow = pClosed->monthlyLow;
+		pIndicators->weekly3RulesTrend = pClosed->weekly3RulesTrend;
+		pIndicators->weeklyHLTrend = pClosed->weeklyHLTrend;
+		pIndicators->weeklyMATrend = pClosed->weeklyMATrend;
+		pIndicators->weeklyHigh = pClosed->weeklyHigh;
+		pIndicators->weeklyLow = pClosed->weeklyLow;
 	}
 
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, MA1H200M = %lf,MA4H200M=%lf",
+		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->ma1H200M, pIndicators->ma4H200M);
+
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, dailyPivot = %lf,dailyS1=%lf, dailyR1 = %lf,dailyS2=%lf, dailyR2 = %lf,dailyS3=%lf, dailyR3 = %lf",
+		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyPivot, pIndicators->dailyS1, pIndicators->dailyR1, pIndicators->dailyS2, pIndicators->dailyR2, pIndicators->dailyS3, pIndicators->dailyR3);
+
 	if (pIndicators->strategy_mode > 0)
 	{
-		loadMonthlyIndicators(pParams, pIndicators);
-		loadWeeklyIndicators(pParams, pIndicators);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, weeklyPivot = %lf,weeklyS1=%lf, weeklyR1 = %lf,weeklyS2=%lf, weeklyR2 = %lf,weeklyS3=%lf, weeklyR3 = %lf",
+			(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyPivot, pIndicators->weeklyS1, pIndicators->weeklyR1, pIndicators->weeklyS2, pIndicators->weeklyR2, pIndicators->weeklyS3, pIndicators->weeklyR3);
+
+		loadFormingWeeklyIndicators(pParams, pIndicators);
 	}
 	
 	if (timeInfo1.tm_hour >= 23 && timeInfo1.tm_min >= 30)
@@ -262,15 +466,11 @@ static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, Base_Indicator
 		index = 1;
 	}
 
-	loadDailyIndicators(pParams, pIndicators,index);
-	loadIntradayKeyKIndicators(pParams, pIndicators);
-	
-
-	//Those two are used for weekly swing only. They are inactive now.
-	//TODO: should be clean up.
-	pIndicators->maTrend = getMATrend(iAtr(B_PRIMARY_RATES, 20, 1), B_PRIMARY_RATES, 1);
-	pIndicators->ma_Signal = getMATrend_Signal(B_PRIMARY_RATES);
+	// At the end of the day the daily values are taken from the forming bar, so they cannot be reused.
+	if (index == 1)
+		loadClosedDailyIndicators(pParams, pIndicators, index);
 
+	loadFormingDailyIndicators(pParams, pIndicators);
 	
 	return SUCCESS;
 }
@@ -647,32 +847,72 @@ AsirikuyReturnCode iTrend_HL(int ratesArrayIndex,int *trend,int index)
 	return SUCCESS;
 }
 
+static int compareMATrend(double maShort, double maLong, double iATR)
+{
+	int trend;
+
+	if (maShort > maLong)
+	{
+		trend = 1;
+		if (maShort - maLong >= iATR)
+			trend = 2;
+	}
+	else if (maShort < maLong)
+	{
+		trend = -1;
+		if (maLong - maShort >= iATR)
+			trend = -2;
+	}
+	else
+		trend = 0;
+	return trend;
+}
+
 int getMATrend_SignalBase(int rateShort,int rateLong,int ratesArrayIndex,int maxBars)
 {
-	int i = 0, j, maTrend, maTrend_Prev;
+	int i = 0, maTrend, maTrend_Prev, signal = 0;
 	double adjust = iAtr(ratesArrayIndex, 20, 1);
+	double *maShort, *maLong;
 
-	maTrend = getMATrendBase(rateShort,rateLong,adjust, ratesArrayIndex, 1);
-	if (maTrend == 0)
-		//if (fabs(maTrend) < 2)
+	if (maxBars <= 1)
 		return 0;
 
-	for (i = 1; i < maxBars; i++)
+	// Both averages for shifts 1 to maxBars, maShort[i] is shift i + 1
+	maShort = (double*)malloc(2 * maxBars * sizeof(double));
+	if (maShort == NULL)
+		return 0;
+	maLong = maShort + maxBars;
+
+	if (iMASeries(3, ratesArrayIndex, rateShort, 1, maxBars, maShort) != SUCCESS
+		|| iMASeries(3, ratesArrayIndex, rateLong, 1, maxBars, maLong) != SUCCESS)
 	{
-		maTrend_Prev = getMATrendBase(rateShort,rateLong,adjust, ratesArrayIndex, i + 1);
-		
-		if (maTrend > 0 && maTrend_Prev < 0)
-		{			
-			return 1;
-		}
+		free(maShort);
+		return 0;
+	}
 
-		if (maTrend < 0 && maTrend_Prev > 0)
+	maTrend = compareMATrend(maShort[0], maLong[0], adjust);
+	if (maTrend != 0)
+	{
+		for (i = 1; i < maxBars; i++)
 		{
-			return -1;
+			maTrend_Prev = compareMATrend(maShort[i], maLong[i], adjust);
+
+			if (maTrend > 0 && maTrend_Prev < 0)
+			{
+				signal = 1;
+				break;
+			}
+
+			if (maTrend < 0 && maTrend_Prev > 0)
+			{
+				signal = -1;
+				break;
+			}
 		}
 	}
-		
-	return 0;
+
+	free(maShort);
+	return signal;
 }
 
 int getMATrend_Signal(int ratesArrayIndex)
@@ -682,27 +922,7 @@ int getMATrend_Signal(int ratesArrayIndex)
 
 int getMATrendBase(int rateShort,int rateLong,double iATR, int ratesArrayIndex, int index)
 {
-	double maShort, maLong;
-	int trend;
-
-	maShort = iMA(3, ratesArrayIndex, rateShort, index);
-	maLong = iMA(3, ratesArrayIndex, rateLong, index);
-
-	if (maShort > maLong)
-	{
-		trend = 1;
-		if (maShort - maLong >= iATR)
-			trend = 2;
-	}
-	else if (maShort < maLong)
-	{
-		trend = -1;
-		if (maLong - maShort >= iATR)
-			trend = -2;
-	}
-	else
-		trend = 0;
-	return trend;
+	return compareMATrend(iMA(3, ratesArrayIndex, rateShort, index), iMA(3, ratesArrayIndex, rateLong, index), iATR);
 }
 
 int getMATrend(double iATR, int ratesArrayIndex, int index)
@@ -732,12 +952,18 @@ int iTrendMA_LookBack(StrategyParams* pParams, Base_Indicators* pIndicators, int
 {
 	int trend[100] = { 0 };
 	int i = 0;
-	double ma50M, ma200M;	
+	double ma50M[99], ma200M[99];
+	double atr = iAtr(ratesArrayIndex, 20, 1);
 	int truningIndex = 100;
 
+	// The averages for shifts 1 to 99, ma50M[i - 1] is shift i
+	if (iMASeries(3, ratesArrayIndex, 50, 1, 99, ma50M) != SUCCESS
+		|| iMASeries(3, ratesArrayIndex, 200, 1, 99, ma200M) != SUCCESS)
+		return truningIndex;
+
 	for (i = 1; i < 100; i++)
 	{
-		trend[i] = getMATrend(iAtr(ratesArrayIndex, 20, 1), ratesArrayIndex, i);
+		trend[i] = compareMATrend(ma50M[i - 1], ma200M[i - 1], atr);
 		if ( (signal > 0 && trend[i] != UP_NORMAL) ||
 			(signal < 0 && trend[i] != DOWN_NORMAL))
 		{
@@ -789,50 +1015,46 @@ AsirikuyReturnCode iTrend_MA_DailyBar_For1H(double iATR, int *trend,int index)
 
 AsirikuyReturnCode iTrend3Rules_LookBack(StrategyParams* pParams, Base_Indicators* pIndicators, int ratesArrayIndex, int shift, int * pTrend)
 {
-	TA_RetCode retCode;
-	int shift0Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 1;
 	int shift1Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 2;
-	int        outBegIdx, outNBElement;
-	double	  boxHigh[100] = { 0 }, boxLow[100] = { 0 };
-	int trend[100] = { 0 };
-	int i = 0;
+	double	  *boxHigh, *boxLow;
+	int i, trend;
 
-	retCode = TA_MIN(shift - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].low, shift, &outBegIdx, &outNBElement, boxLow);
-	if (retCode != TA_SUCCESS)
+	if (shift < 2 || shift1Index < shift)
 	{
-		return logTALibError("TA_MIN()", retCode);
+		return logAsirikuyError("iTrend3Rules_LookBack()", INVALID_PARAMETER);
 	}
 
-	retCode = TA_MAX(shift - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].high, shift, &outBegIdx, &outNBElement, boxHigh);
-	if (retCode != TA_SUCCESS)
+	// Rolling box of the previous shift bars for every bar, in one pass whatever the period.
+	boxHigh = (double*)malloc(shift1Index * sizeof(double));
+	boxLow = (double*)malloc(shift1Index * sizeof(double));
+	if (boxHigh == NULL || boxLow == NULL
+		|| rollingExtremum(pParams->ratesBuffers->rates[ratesArrayIndex].high, shift1Index, shift, TRUE, boxHigh, NULL) != SUCCESS
+		|| rollingExtremum(pParams->ratesBuffers->rates[ratesArrayIndex].low, shift1Index, shift, FALSE, boxLow, NULL) != SUCCESS)
 	{
-		return logTALibError("TA_MAX()", retCode);
+		free(boxHigh);
+		free(boxLow);
+		return logAsirikuyError("iTrend3Rules_LookBack()", INSUFFICIENT_MEMORY);
 	}
 
-	for (i = 0; i < outNBElement; i++)
+	for (i = shift - 1; i < shift1Index; i++)
 	{
 		// Check close price. 
-		trend[i] = RANGE;
 		if (boxHigh[i] == 0 || boxLow[i] == 0)
 			break;
 
-		if (iClose(ratesArrayIndex, shift1Index - (i + outBegIdx)) > boxHigh[i]) //�ܹ������ϡ� c3 > max(h1,h2) or c3 > max(c1,c2) && h3>max(h1,h2) && l3>max(l1,l2)
-			trend[i] = UP_NORMAL;
+		trend = RANGE;
+		if (iClose(ratesArrayIndex, shift1Index - i) > boxHigh[i]) //�ܹ������ϡ� c3 > max(h1,h2) or c3 > max(c1,c2) && h3>max(h1,h2) && l3>max(l1,l2)
+			trend = UP_NORMAL;
 
-		if (iClose(ratesArrayIndex, shift1Index - (i + outBegIdx)) < boxLow[i]) //�ܹ������ϡ�
-			trend[i] = DOWN_NORMAL;
+		if (iClose(ratesArrayIndex, shift1Index - i) < boxLow[i]) //�ܹ������ϡ�
+			trend = DOWN_NORMAL;
 
-		if (i - 1 >= 0 && trend[i - 1] == UP && trend[i] == RANGE)
-			trend[i] = RANGE;
-
-		if (i - 1 >= 0 && trend[i - 1] == DOWN && trend[i] == RANGE)
-			trend[i] = RANGE;
-
-		*pTrend = trend[i];
-	}	
+		*pTrend = trend;
+	}
 
+	free(boxHigh);
+	free(boxLow);
 	return SUCCESS;
-	
 }
 
 /*
@@ -941,7 +1163,10 @@ void predictDailyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	int shift0Index = pParams->ratesBuffers->rates[B_DAILY_RATES].info.arraySize - 1;
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_DAILY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_DAILY_RATES].time[shift0Index]);
+	}
 
 	ATR0 = iAtr(B_DAILY_RATES, 1, 0);
 	ATR1 = iAtr(B_DAILY_RATES, 1, 1);
@@ -963,10 +1188,10 @@ void predictDailyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	maxATR = max(maxATR, longDailyATR);
 	pIndicators->pDailyMaxATR = maxATR;
 	
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, shortDailyATR = %f,mediumDailyATR=%f,longDailyATR=%f,minATR=%f,maxATR=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, shortDailyATR = %f,mediumDailyATR=%f,longDailyATR=%f,minATR=%f,maxATR=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, shortDailyATR, mediumDailyATR, longDailyATR, minATR, maxATR);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f,ATR4=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f,ATR4=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, ATR0, ATR1, ATR2, ATR3, ATR4);
 
 	// 1. ʹ��ƽ��5�첨��
@@ -992,12 +1217,12 @@ void predictDailyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	//Get average atr on the same week day.
 	pATRSameWeekDay = (iAtr(B_DAILY_RATES, 1, 5) + iAtr(B_DAILY_RATES, 1, 10) + iAtr(B_DAILY_RATES, 1, 15) + iAtr(B_DAILY_RATES, 1, 20)) / 4;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameWeekDay=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameWeekDay=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, pATRSameWeekDay);
 
 	pATR = min(pATR, pATRSameWeekDay);
 	//pATR = min(pATR, minATR);
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameWeekDay=%f,ATR0=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameWeekDay=%f,ATR0=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, pATRSameWeekDay, ATR0);
 
 	//pATR = max(ATR0, pATR);
@@ -1056,7 +1281,7 @@ void predictDailyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	pIndicators->pMaxDailyHigh = pMaxHigh;
 	pIndicators->pMaxDailyLow = pMaxLow;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pDailyPredictATR=%f,pDailyATR=%f,pDailyHigh=%f,pDailyLow=%f, pDailyTrend = %ld,pMaxDailyHigh=%lf,pMaxDailyLow=%lf",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pDailyPredictATR=%f,pDailyATR=%f,pDailyHigh=%f,pDailyLow=%f, pDailyTrend = %ld,pMaxDailyHigh=%lf,pMaxDailyLow=%lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->pDailyPredictATR, pIndicators->pDailyATR, pIndicators->pDailyHigh, pIndicators->pDailyLow, pIndicators->pDailyTrend, pIndicators->pMaxDailyHigh, pIndicators->pMaxDailyLow);
 
 	//setPredictDailyATR((int)pParams->settings[STRATEGY_INSTANCE_ID], pIndicators->pDailyATR, (BOOL)pParams->settings[IS_BACKTESTING]);
@@ -1078,7 +1303,10 @@ void predictWeeklyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	int shift0Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 1;
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	}
 
 	ATR0 = iAtr(B_WEEKLY_RATES, 1, 0);
 	ATR1 = iAtr(B_WEEKLY_RATES, 1, 1);
@@ -1099,10 +1327,10 @@ void predictWeeklyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	
 	pIndicators->pWeeklyPredictMaxATR = maxATR;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, shortWeeklyATR = %f,mediumWeeklyATR=%f,longWeeklyATR=%f,minATR=%f,maxATR=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, shortWeeklyATR = %f,mediumWeeklyATR=%f,longWeeklyATR=%f,minATR=%f,maxATR=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, shortWeeklyATR, mediumWeeklyATR, longWeeklyATR, minATR, maxATR);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, ATR0, ATR1, ATR2, ATR3);
 
 	// 1. ʹ��ƽ��4�ܲ���
@@ -1124,7 +1352,7 @@ void predictWeeklyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	else
 		pATR = (pMinATR + pMaxATR) / 2;
 		
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,ATR0=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,ATR0=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, ATR0);
 
 	//Get average atr on the same week day.
@@ -1134,7 +1362,7 @@ void predictWeeklyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	pATR = min(pATR, pATRSameMonthWeek);
 	pATR = min(pATR, minATR);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameMonthWeek=%f,ATR0=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameMonthWeek=%f,ATR0=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, pATRSameMonthWeek, ATR0);
 	
 	//3. ʹ��pivot����?���������£����з��ദ��
@@ -1177,7 +1405,7 @@ void predictWeeklyATR(StrategyParams* pParams, Base_Indicators* pIndicators)
 	pIndicators->pMaxWeeklyHigh = pMaxHigh;
 	pIndicators->pMaxWeeklyLow = pMaxLow;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pWeeklyPredictATR=%f,pWeeklyATR=%f,pWeeklyHigh=%f,pWeeklyLow=%f, pWeeklyTrend = %ld,pMaxWeeklyHigh=%f,pMaxWeeklyLow=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pWeeklyPredictATR=%f,pWeeklyATR=%f,pWeeklyHigh=%f,pWeeklyLow=%f, pWeeklyTrend = %ld,pMaxWeeklyHigh=%f,pMaxWeeklyLow=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->pWeeklyPredictATR, pIndicators->pWeeklyATR, pIndicators->pWeeklyHigh, pIndicators->pWeeklyLow, pIndicators->pWeeklyTrend, pIndicators->pMaxWeeklyHigh, pIndicators->pMaxWeeklyLow);
 
 	//setPredictDailyATR((int)pParams->settings[STRATEGY_INSTANCE_ID], pIndicators->pDailyATR, (BOOL)pParams->settings[IS_BACKTESTING]);
@@ -1198,7 +1426,10 @@ void predictWeeklyATR_LongerTerm(StrategyParams* pParams, Base_Indicators* pIndi
 	int shift0Index = pParams->ratesBuffers->rates[B_WEEKLY_RATES].info.arraySize - 1;
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
-	safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString, pParams->ratesBuffers->rates[B_WEEKLY_RATES].time[shift0Index]);
+	}
 
 	ATR0 = iAtr(B_WEEKLY_RATES, 1, 0);
 	ATR1 = iAtr(B_WEEKLY_RATES, 1, 1);
@@ -1219,10 +1450,10 @@ void predictWeeklyATR_LongerTerm(StrategyParams* pParams, Base_Indicators* pIndi
 
 	pIndicators->pWeeklyPredictMaxATR = maxATR;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, shortWeeklyATR = %f,mediumWeeklyATR=%f,longWeeklyATR=%f,minATR=%f,maxATR=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, shortWeeklyATR = %f,mediumWeeklyATR=%f,longWeeklyATR=%f,minATR=%f,maxATR=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, shortWeeklyATR, mediumWeeklyATR, longWeeklyATR, minATR, maxATR);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s, ATR0 = %f,ATR1=%f,ATR2=%f,ATR3=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, ATR0, ATR1, ATR2, ATR3);
 
 	// 1. ʹ��ƽ��4�ܲ���
@@ -1244,7 +1475,7 @@ void predictWeeklyATR_LongerTerm(StrategyParams* pParams, Base_Indicators* pIndi
 	else
 		pATR = (pMinATR + pMaxATR) / 2;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,ATR0=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,ATR0=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, ATR0);
 
 	//Get average atr on the same week day.
@@ -1253,7 +1484,7 @@ void predictWeeklyATR_LongerTerm(StrategyParams* pParams, Base_Indicators* pIndi
 	pATR = min(pATR, pATRSameMonthWeek);
 	pATR = min(pATR, minATR);
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameMonthWeek=%f,ATR0=%f ",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pATR=%f,pATRSameMonthWeek=%f,ATR0=%f ",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pATR, pATRSameMonthWeek, ATR0);
 
 	//3. ʹ��pivot����?���������£����з��ദ��
@@ -1296,7 +1527,7 @@ void predictWeeklyATR_LongerTerm(StrategyParams* pParams, Base_Indicators* pIndi
 	pIndicators->pMaxWeeklyHigh = pMaxHigh;
 	pIndicators->pMaxWeeklyLow = pMaxLow;
 
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s,pWeeklyPredictATR=%f,pWeeklyATR=%f,pWeeklyHigh=%f,pWeeklyLow=%f, pWeeklyTrend = %ld,pMaxWeeklyHigh=%f,pMaxWeeklyLow=%f",
+	ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "System InstanceID = %d, BarTime = %s,pWeeklyPredictATR=%f,pWeeklyATR=%f,pWeeklyHigh=%f,pWeeklyLow=%f, pWeeklyTrend = %ld,pMaxWeeklyHigh=%f,pMaxWeeklyLow=%f",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->pWeeklyPredictATR, pIndicators->pWeeklyATR, pIndicators->pWeeklyHigh, pIndicators->pWeeklyLow, pIndicators->pWeeklyTrend, pIndicators->pMaxWeeklyHigh, pIndicators->pMaxWeeklyLow);
 
 	//setPredictDailyATR((int)pParams->settings[STRATEGY_INSTANCE_ID], pIndicators->pDailyATR, (BOOL)pParams->settings[IS_BACKTESTING]);
@@ -1324,14 +1555,16 @@ BOOL isNewDay(StrategyParams* pParams, time_t currentTime)
 	safe_gmtime(&timeInfo1, currentTime);
 	safe_gmtime(&timeInfo2, virtualOrderEntryTime);
 
-	safe_timeString(timeString1, currentTime);
-	safe_timeString(timeString2, virtualOrderEntryTime);
-
-	pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Last order update time = %s,current time = %s, Time Difference (hours) = %lf", timeString2, timeString1, difftime(virtualOrderEntryTime, currentTime) / 3600);
+	if(ASIRIKUY_LOG_ENABLED(PANTHEIOS_SEV_DEBUG))
+	{
+		safe_timeString(timeString1, currentTime);
+		safe_timeString(timeString2, virtualOrderEntryTime);
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Last order update time = %s,current time = %s, Time Difference (hours) = %lf", timeString2, timeString1, difftime(virtualOrderEntryTime, currentTime) / 3600);
+	}
 
 	if (virtualOrderEntryTime != -1 && timeInfo1.tm_mday != timeInfo2.tm_mday && timeInfo1.tm_min >= 15) // New day
 	{
-		pantheios_logprintf(PANTHEIOS_SEV_DEBUG, (PAN_CHAR_T*)"Move to a new day.");
+		ASIRIKUY_LOG_PRINTF(PANTHEIOS_SEV_DEBUG, "Move to a new day.");
 		//setLastOrderUpdateTime((int)pParams->settings[STRATEGY_INSTANCE_ID], pParams->ratesBuffers->rates[0].time[pParams->ratesBuffers->rates[0].info.arraySize - 1], (BOOL)pParams->settings[IS_BACKTESTING]);
 		return TRUE;
 	}
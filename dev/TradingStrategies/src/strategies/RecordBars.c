@@ -49,6 +49,7 @@
 #include "OrderManagement.h"
 #include "AsirikuyTechnicalAnalysis.h"
 #include "EasyTradeCWrapper.hpp"
+#include "BarRecorder.h"
 
 #define USE_INTERNAL_SL FALSE
 #define USE_INTERNAL_TP FALSE
@@ -64,14 +65,15 @@ typedef enum additionalSettings_t
 AsirikuyReturnCode runRecordBars(StrategyParams* pParams)
 {
   AsirikuyReturnCode returnCode = SUCCESS;
-  char timeString[MAX_TIME_STRING_SIZE] = "";
   char tempFilePath[MAX_FILE_PATH_CHARS] = "";
   char timeframeString[TOTAL_UI_VALUES];
   char buffer[MAX_FILE_PATH_CHARS] = "";
-  char extension[] = ".csv" ;
-  int  shift1Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 2, shift0Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 1;
-  struct tm timeInfo;
-  FILE *fp;
+  char barFilePath[MAX_FILE_PATH_CHARS] = "";
+  char csvFilePath[MAX_FILE_PATH_CHARS] = "";
+  int  shift1Index, recordMode;
+  BarTextLayout exportLayout = BAR_TEXT_NONE;
+  BarRecorder*  pRecorder;
+  BarRecord     bar;
 
   if(pParams == NULL)
   {
@@ -79,7 +81,7 @@ AsirikuyReturnCode runRecordBars(StrategyParams* pParams)
     return NULL_POINTER;
   }
 
-  safe_gmtime(&timeInfo, pParams->ratesBuffers->rates[PRIMARY_RATES].time[shift1Index]);
+  shift1Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 2;
 
   requestTempFileFolderPath(tempFilePath);
 
@@ -88,30 +90,38 @@ AsirikuyReturnCode runRecordBars(StrategyParams* pParams)
   strcat(buffer, pParams->tradeSymbol);
   strcat(buffer, "_");
   strcat(buffer, timeframeString);
-  strcat(buffer, extension);
 
-  fp = fopen(buffer,"a");
-  fseek(fp,0, SEEK_END);                
-  
-  switch( (int)parameter(RECORD_MODE))
+  strcat(barFilePath, buffer);
+  strcat(barFilePath, ".bin");
+  strcat(csvFilePath, buffer);
+  strcat(csvFilePath, ".csv");
+
+  /* Bars are kept in a binary file and the csv file in the selected layout is rewritten from it when the instance is closed. */
+  recordMode = (int)parameter(RECORD_MODE);
+  if(recordMode == RECORD_DATE_AS_INTEGER || recordMode == RECORD_DATE_AS_STRING || recordMode == RECORD_DATE_FOR_R)
+  {
+    exportLayout = (BarTextLayout)recordMode;
+  }
+
+  returnCode = getInstanceBarRecorder((int)pParams->settings[STRATEGY_INSTANCE_ID], barFilePath, (int)pParams->settings[TIMEFRAME], csvFilePath, exportLayout, &pRecorder);
+  if(returnCode != SUCCESS)
   {
-	case RECORD_DATE_AS_INTEGER:
-		fprintf(fp,"%d, %lf, %lf, %lf, %lf, %lf\n",(int)pParams->ratesBuffers->rates[PRIMARY_RATES].time[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].open[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].high[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].low[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].close[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].volume[shift1Index]);
-	break;
-	case RECORD_DATE_AS_STRING:
-		strftime (timeString,MAX_TIME_STRING_SIZE - 1," %d/%m/%y %H:%M",&timeInfo);
-		fprintf(fp,"%s, %lf, %lf, %lf, %lf, %lf\n",timeString, pParams->ratesBuffers->rates[PRIMARY_RATES].open[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].high[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].low[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].close[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].volume[shift1Index]);
-	break;
-	case RECORD_DATE_FOR_R:
-		strftime (timeString,MAX_TIME_STRING_SIZE - 1," %Y-%m-%d",&timeInfo);
-		fprintf(fp,"%s, %lf, %lf, %lf, %lf, %lf\n",timeString, pParams->ratesBuffers->rates[PRIMARY_RATES].open[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].high[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].low[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].close[shift1Index], pParams->ratesBuffers->rates[PRIMARY_RATES].volume[shift1Index]);
-	break;
-	default:		
-			/* do nothing if no valid recording mode is given*/
-	break;
+    return logAsirikuyError("runRecordBars()", returnCode);
   }
 
-  fclose(fp);
+  memset(&bar, 0, sizeof(BarRecord));
+  bar.time   = (int)pParams->ratesBuffers->rates[PRIMARY_RATES].time[shift1Index];
+  bar.open   = pParams->ratesBuffers->rates[PRIMARY_RATES].open[shift1Index];
+  bar.high   = pParams->ratesBuffers->rates[PRIMARY_RATES].high[shift1Index];
+  bar.low    = pParams->ratesBuffers->rates[PRIMARY_RATES].low[shift1Index];
+  bar.close  = pParams->ratesBuffers->rates[PRIMARY_RATES].close[shift1Index];
+  bar.volume = pParams->ratesBuffers->rates[PRIMARY_RATES].volume[shift1Index];
+
+  returnCode = appendBarRecorder(pRecorder, &bar);
+  if(returnCode != SUCCESS)
+  {
+    return logAsirikuyError("runRecordBars()", returnCode);
+  }
 
   return SUCCESS;
 }
@@ -6,6 +6,10 @@ Primary rate: 1H
 #include "OrderManagement.h"
 #include "Logging.h"
 #include "EasyTradeCWrapper.hpp"
+#include "BarCloseStamp.h"
+#include "SessionBars.h"
+#include "WorkerThreads.h"
+#include "Screening.h"
 
 #define USE_INTERNAL_SL FALSE
 #define USE_INTERNAL_TP FALSE
@@ -79,10 +83,63 @@ typedef struct indicators_t
 
 } Indicators;
 
+/* Values computed from closed bars, kept per instance and recomputed only when a new bar opens on their timeframe. */
+typedef struct screeningSnapshot_t
+{
+	BarCloseStamp hourlyStamp;
+	BarCloseStamp fourHourlyStamp;
+	BarCloseStamp dailyStamp;
+	BarCloseStamp weeklyStamp;
+	Indicators    closedBarValues;
+} ScreeningSnapshot;
+
+static void invalidateScreeningSnapshot(ScreeningSnapshot* pSnapshot)
+{
+	invalidateBarCloseStamp(&pSnapshot->hourlyStamp);
+	invalidateBarCloseStamp(&pSnapshot->fourHourlyStamp);
+	invalidateBarCloseStamp(&pSnapshot->dailyStamp);
+	invalidateBarCloseStamp(&pSnapshot->weeklyStamp);
+}
+
+static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, ScreeningSnapshot* pSnapshot, Indicators* pIndicators);
+
+static int               gScreeningSnapshotOwners[MAX_INSTANCES];
+static ScreeningSnapshot gScreeningSnapshots[MAX_INSTANCES];
+
+static ScreeningSnapshot* getScreeningSnapshot(int instanceId)
+{
+	BOOL isClaimed;
+	int index = claimInstanceStampSlot(gScreeningSnapshotOwners, instanceId, &isClaimed);
+
+	if (index < 0)
+	{
+		return NULL;
+	}
+
+	if (isClaimed)
+	{
+		invalidateScreeningSnapshot(&gScreeningSnapshots[index]);
+	}
+
+	return &gScreeningSnapshots[index];
+}
+
+void releaseScreeningSnapshot(int instanceId)
+{
+	int index = releaseInstanceStampSlot(gScreeningSnapshotOwners, instanceId);
+
+	if (index >= 0)
+	{
+		invalidateScreeningSnapshot(&gScreeningSnapshots[index]);
+	}
+}
+
 AsirikuyReturnCode runScreening(StrategyParams* pParams)
 {
 	AsirikuyReturnCode returnCode = SUCCESS;
 	Indicators indicators;
+	ScreeningSnapshot localSnapshot;
+	ScreeningSnapshot* pSnapshot;
 
 	char       timeString[MAX_TIME_STRING_SIZE] = "";
 	int        shift0Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 1, shift1Index = pParams->ratesBuffers->rates[PRIMARY_RATES].info.arraySize - 2;
@@ -98,7 +155,14 @@ AsirikuyReturnCode runScreening(StrategyParams* pParams)
 	//if (strcmp(timeString, "08/09/17 21:00") == 0)
 	//	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, "hit a point");
 
-	loadIndicators(pParams, &indicators);	
+	pSnapshot = getScreeningSnapshot((int)pParams->settings[STRATEGY_INSTANCE_ID]);
+	if (pSnapshot == NULL)
+	{
+		pSnapshot = &localSnapshot;
+		invalidateScreeningSnapshot(pSnapshot);
+	}
+
+	loadIndicators(pParams, pSnapshot, &indicators);	
 	
 	setUIValues(pParams, &indicators);
 	return SUCCESS;
@@ -118,18 +182,22 @@ static AsirikuyReturnCode loadMonthlyIndicators(StrategyParams* pParams, Indicat
 	return SUCCESS;
 }
 
+static AsirikuyReturnCode loadClosedWeeklyIndicators(StrategyParams* pParams, Indicators* pIndicators)
+{
+	iTrend3Rules(pParams, pIndicators, S_WEEKLY_RATES, 2, &(pIndicators->weekly3RulesTrend));
+	iTrend_HL(S_WEEKLY_RATES, &(pIndicators->weeklyHLTrend));
+
+	iSRLevels(pParams, pIndicators, S_WEEKLY_RATES, 2, &(pIndicators->weeklyHigh), &(pIndicators->weeklyLow));
+
+	return SUCCESS;
+}
+
 static AsirikuyReturnCode loadWeeklyIndicators(StrategyParams* pParams, Indicators* pIndicators)
 {	
 	int shift0Index = pParams->ratesBuffers->rates[S_WEEKLY_RATES].info.arraySize - 1;		
 	char timeString[MAX_TIME_STRING_SIZE] = "";
 
 	safe_timeString(timeString, pParams->ratesBuffers->rates[S_WEEKLY_RATES].time[shift0Index]);
-		
-	iTrend3Rules(pParams, pIndicators, S_WEEKLY_RATES, 2, &(pIndicators->weekly3RulesTrend));
-	iTrend_HL(S_WEEKLY_RATES, &(pIndicators->weeklyHLTrend));
-	iTrend_MA(pIndicators->weeklyATR, S_FOURHOURLY_RATES, &(pIndicators->weeklyMATrend));
-
-	iSRLevels(pParams, pIndicators, S_WEEKLY_RATES, 2, &(pIndicators->weeklyHigh), &(pIndicators->weeklyLow));
 
 	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weeklyHLTrend = %ld,weeklyMATrend=%ld",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyHLTrend, pIndicators->weeklyMATrend);
@@ -145,18 +213,22 @@ static AsirikuyReturnCode loadWeeklyIndicators(StrategyParams* pParams, Indicato
 
 }
 
+static AsirikuyReturnCode loadClosedDailyIndicators(StrategyParams* pParams, Indicators* pIndicators)
+{
+	iTrend3Rules(pParams, pIndicators, S_DAILY_RATES, 2, &(pIndicators->daily3RulesTrend));
+	iTrend_HL(S_DAILY_RATES, &(pIndicators->dailyHLTrend));
+
+	iSRLevels(pParams, pIndicators, S_DAILY_RATES, 2, &(pIndicators->dailyHigh), &(pIndicators->dailyLow));
+
+	return SUCCESS;
+}
+
 static AsirikuyReturnCode loadDailyIndicators(StrategyParams* pParams, Indicators* pIndicators)
 {
 	int shift0Index = pParams->ratesBuffers->rates[S_DAILY_RATES].info.arraySize - 1;	
 	char       timeString[MAX_TIME_STRING_SIZE] = "";
 	
 	safe_timeString(timeString, pParams->ratesBuffers->rates[S_DAILY_RATES].time[shift0Index]);
-		
-	iTrend3Rules(pParams, pIndicators, S_DAILY_RATES, 2, &(pIndicators->daily3RulesTrend));
-	iTrend_HL(S_DAILY_RATES, &(pIndicators->dailyHLTrend));
-	iTrend_MA(pIndicators->dailyATR,S_HOURLY_RATES, &(pIndicators->dailyMATrend));
-
-	iSRLevels(pParams, pIndicators, S_DAILY_RATES, 2, &(pIndicators->dailyHigh), &(pIndicators->dailyLow));
 
 	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, dailyHLTrend = %ld,dailyMATrend=%ld",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyHLTrend, pIndicators->dailyMATrend);
@@ -174,47 +246,81 @@ static AsirikuyReturnCode loadDailyIndicators(StrategyParams* pParams, Indicator
 
 
 
-static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, Indicators* pIndicators)
+static AsirikuyReturnCode loadIndicators(StrategyParams* pParams, ScreeningSnapshot* pSnapshot, Indicators* pIndicators)
 {	
 	int shift0Index = pParams->ratesBuffers->rates[S_HOURLY_RATES].info.arraySize - 1;
 	char       timeString[MAX_TIME_STRING_SIZE] = "";
+	int atrPeriod = (int)parameter(ATR_AVERAGING_PERIOD);
+	Indicators* pClosed;
+	BOOL newDailyBar, newWeeklyBar;
+
 	safe_timeString(timeString, pParams->ratesBuffers->rates[S_HOURLY_RATES].time[shift0Index]);
 
-	pIndicators->dailyATR = iAtr(S_DAILY_RATES, (int)parameter(ATR_AVERAGING_PERIOD), 1);
-	pIndicators->weeklyATR = iAtr(S_WEEKLY_RATES, 8, 1);
+	// Everything but the daily and weekly trend work out only depends on closed bars, so it is kept per instance
+	// and recomputed when a new bar opens on the timeframe it is computed from.
+	pClosed = &pSnapshot->closedBarValues;
+
+	newDailyBar = !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[S_DAILY_RATES], atrPeriod, &pSnapshot->dailyStamp);
+	if (newDailyBar)
+	{
+		pClosed->dailyATR = iAtr(S_DAILY_RATES, atrPeriod, 1);
+
+		iPivot(S_DAILY_RATES, 1, &(pClosed->dailyPivot),
+			&(pClosed->dailyS1), &(pClosed->dailyR1),
+			&(pClosed->dailyS2), &(pClosed->dailyR2),
+			&(pClosed->dailyS3), &(pClosed->dailyR3));
+
+		loadClosedDailyIndicators(pParams, pClosed);
+		setBarCloseStamp(&pParams->ratesBuffers->rates[S_DAILY_RATES], atrPeriod, &pSnapshot->dailyStamp);
+	}
+
+	newWeeklyBar = !isBarCloseStampCurrent(&pParams->ratesBuffers->rates[S_WEEKLY_RATES], 0, &pSnapshot->weeklyStamp);
+	if (newWeeklyBar)
+	{
+		pClosed->weeklyATR = iAtr(S_WEEKLY_RATES, 8, 1);
+
+		iPivot(S_WEEKLY_RATES, 1, &(pClosed->weeklyPivot),
+			&(pClosed->weeklyS1), &(pClosed->weeklyR1),
+			&(pClosed->weeklyS2), &(pClosed->weeklyR2),
+			&(pClosed->weeklyS3), &(pClosed->weeklyR3));
+
+		loadMonthlyIndicators(pParams, pClosed);
+		loadClosedWeeklyIndicators(pParams, pClosed);
+		setBarCloseStamp(&pParams->ratesBuffers->rates[S_WEEKLY_RATES], 0, &pSnapshot->weeklyStamp);
+	}
 
 	//pIndicators->ma1H50M = iMA(3, S_DAILY_RATES, 2, 1);
 	//pIndicators->ma1H200M = iMA(3, S_DAILY_RATES, 8, 1);
 	//pIndicators->ma4H50M = iMA(3, S_DAILY_RATES, 12, 1);
 	//pIndicators->ma4H200M = iMA(3, S_DAILY_RATES, 33, 1);
 
-	pIndicators->ma1H50M = iMA(3, S_HOURLY_RATES, 50, 1);
-	pIndicators->ma1H200M = iMA(3, S_HOURLY_RATES, 200, 1);
-	pIndicators->ma4H50M = iMA(3, S_FOURHOURLY_RATES, 50, 1);
-	pIndicators->ma4H200M = iMA(3, S_FOURHOURLY_RATES, 200, 1);
+	if (!isBarCloseStampCurrent(&pParams->ratesBuffers->rates[S_HOURLY_RATES], 0, &pSnapshot->hourlyStamp) || newDailyBar)
+	{
+		pClosed->ma1H50M = iMA(3, S_HOURLY_RATES, 50, 1);
+		pClosed->ma1H200M = iMA(3, S_HOURLY_RATES, 200, 1);
+		iTrend_MA(pClosed->dailyATR, S_HOURLY_RATES, &(pClosed->dailyMATrend));
+		setBarCloseStamp(&pParams->ratesBuffers->rates[S_HOURLY_RATES], 0, &pSnapshot->hourlyStamp);
+	}
 
-	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, MA1H200M = %lf,MA4H200M=%lf",
-		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->ma1H200M, pIndicators->ma4H200M);
+	if (!isBarCloseStampCurrent(&pParams->ratesBuffers->rates[S_FOURHOURLY_RATES], 0, &pSnapshot->fourHourlyStamp) || newWeeklyBar)
+	{
+		pClosed->ma4H50M = iMA(3, S_FOURHOURLY_RATES, 50, 1);
+		pClosed->ma4H200M = iMA(3, S_FOURHOURLY_RATES, 200, 1);
+		iTrend_MA(pClosed->weeklyATR, S_FOURHOURLY_RATES, &(pClosed->weeklyMATrend));
+		setBarCloseStamp(&pParams->ratesBuffers->rates[S_FOURHOURLY_RATES], 0, &pSnapshot->fourHourlyStamp);
+	}
 
-	iPivot(S_DAILY_RATES, 1, &(pIndicators->dailyPivot),
-		&(pIndicators->dailyS1), &(pIndicators->dailyR1),
-		&(pIndicators->dailyS2), &(pIndicators->dailyR2),
-		&(pIndicators->dailyS3), &(pIndicators->dailyR3));
+	*pIndicators = *pClosed;
 
+	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, MA1H200M = %lf,MA4H200M=%lf",
+		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->ma1H200M, pIndicators->ma4H200M);
 
 	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, dailyPivot = %lf,dailyS1=%lf, dailyR1 = %lf,dailyS2=%lf, dailyR2 = %lf,dailyS3=%lf, dailyR3 = %lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->dailyPivot, pIndicators->dailyS1, pIndicators->dailyR1, pIndicators->dailyS2, pIndicators->dailyR2, pIndicators->dailyS3, pIndicators->dailyR3);
 
-	iPivot(S_WEEKLY_RATES, 1, &(pIndicators->weeklyPivot),
-		&(pIndicators->weeklyS1), &(pIndicators->weeklyR1),
-		&(pIndicators->weeklyS2), &(pIndicators->weeklyR2),
-		&(pIndicators->weeklyS3), &(pIndicators->weeklyR3));
-
 	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"System InstanceID = %d, BarTime = %s, weeklyPivot = %lf,weeklyS1=%lf, weeklyR1 = %lf,weeklyS2=%lf, weeklyR2 = %lf,weeklyS3=%lf, weeklyR3 = %lf",
 		(int)pParams->settings[STRATEGY_INSTANCE_ID], timeString, pIndicators->weeklyPivot, pIndicators->weeklyS1, pIndicators->weeklyR1, pIndicators->weeklyS2, pIndicators->weeklyR2, pIndicators->weeklyS3, pIndicators->weeklyR3);
 
-	loadMonthlyIndicators(pParams, pIndicators);
-
 	loadWeeklyIndicators(pParams, pIndicators);
 	loadDailyIndicators(pParams, pIndicators);
 	
@@ -497,80 +603,310 @@ static AsirikuyReturnCode iTrend_MA(double iATR,int ratesArrayIndex,int *trend)
 	return SUCCESS;
 }
 
-static AsirikuyReturnCode iTrend3Rules_LookBack(StrategyParams* pParams, Indicators* pIndicators, int ratesArrayIndex, int shift,int * pTrend)
+static AsirikuyReturnCode iTrend3Rules(StrategyParams* pParams, Indicators* pIndicators, int ratesArrayIndex, int shift, int * pTrend)
 {
 	TA_RetCode retCode;
 	int shift0Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 1;
 	int shift1Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 2;
-	int        outBegIdx, outNBElement;
-	double	  boxHigh[100] = { 0 }, boxLow[100] = { 0 }, trend[100] = { 0 };
-	int i = 0;
+	int       outBegIdx, outNBElement;
+	double	  boxHigh, boxLow;	
 
-	retCode = TA_MIN(shift - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].low, shift, &outBegIdx, &outNBElement, boxLow);
+	retCode = TA_MIN(shift1Index - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].low, shift, &outBegIdx, &outNBElement, &boxLow);
 	if (retCode != TA_SUCCESS)
 	{
 		return logTALibError("TA_MIN()", retCode);
 	}
 
-	retCode = TA_MAX(shift - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].high, shift, &outBegIdx, &outNBElement, boxHigh);
+	retCode = TA_MAX(shift1Index - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].high, shift, &outBegIdx, &outNBElement, &boxHigh);
 	if (retCode != TA_SUCCESS)
 	{
 		return logTALibError("TA_MAX()", retCode);
 	}
 
-	for (i = 0; i < outNBElement; i++)
+	*pTrend = RANGE;
+	if (iClose(ratesArrayIndex, 1) > boxHigh) //ܹϡ c3 > max(h1,h2)
+			*pTrend = UP;
+
+	if (iClose(ratesArrayIndex, 1) < boxLow) //ܹϡ
+			*pTrend = DOWN;
+
+	return SUCCESS;
+
+}
+
+#define SCREENING_TIMEFRAME_SECONDS_4H 14400
+#define SCREENING_BATCH_SETTINGS       (ORDERINFO_ARRAY_SIZE + 1)
+#define SCREENING_MIN_MA_BARS          202  /* The 200 bars MAs at shift 1 */
+#define SCREENING_MIN_WEEKLY_BARS      10   /* 8 weeks ATR and levels at shift 1 */
+
+typedef struct screeningBatch_t
+{
+	const char**                  symbols;
+	const BarSeries*              pHourlySeries;  /* NULL when the history is loaded from historyFolder */
+	const char*                   historyFolder;
+	const ScreeningBatchSettings* pSettings;
+	ScreeningResult*              pResults;
+} ScreeningBatch;
+
+static time_t screeningBucket(int ratesIndex, time_t time)
+{
+	if (ratesIndex == S_FOURHOURLY_RATES)
+		return time / SCREENING_TIMEFRAME_SECONDS_4H;
+	if (ratesIndex == S_DAILY_RATES)
+		return getSessionKey(SESSION_DAY, time);
+	return getSessionKey(SESSION_WEEK, time);
+}
+
+// Builds the 4H, daily or weekly bars of the first totalBars hourly bars into arrays of at least totalBars elements.
+static void aggregateHourlyBars(const BarSeries* pHourly, int totalBars, int ratesIndex, Rates* pRates)
+{
+	int i, n = -1;
+	time_t bucket = 0, barBucket;
+
+	for (i = 0; i < totalBars; i++)
+	{
+		barBucket = screeningBucket(ratesIndex, pHourly->time[i]);
+		if (n < 0 || barBucket != bucket)
+		{
+			n++;
+			bucket = barBucket;
+			pRates->time[n] = pHourly->time[i];
+			pRates->open[n] = pHourly->open[i];
+			pRates->high[n] = pHourly->high[i];
+			pRates->low[n] = pHourly->low[i];
+			pRates->volume[n] = 0;
+		}
+		pRates->high[n] = max(pRates->high[n], pHourly->high[i]);
+		pRates->low[n] = min(pRates->low[n], pHourly->low[i]);
+		pRates->close[n] = pHourly->close[i];
+		pRates->volume[n] += pHourly->volume[i];
+	}
+
+	pRates->info.arraySize = n + 1;
+}
+
+static AsirikuyReturnCode screenHourlySeries(const char* symbol, int symbolIndex, const BarSeries* pHourly, const ScreeningBatchSettings* pSettings, ScreeningResult* pResult)
+{
+	AsirikuyReturnCode returnCode = SUCCESS;
+	StrategyParams     params;
+	RatesBuffers       ratesBuffers;
+	ScreeningSnapshot  snapshot;
+	Indicators         indicators;
+	double             settings[SCREENING_BATCH_SETTINGS];
+	double             bid, ask;
+	time_t*            pTimes;
+	double*            pValues;
+	int                totalBars = pHourly->size, ratesIndex, i;
+
+	if (pSettings->asOfTime > 0)
 	{
-		// Check close price. 
-		trend[i] = RANGE;
-		if (boxHigh[i] == 0 || boxLow[i] == 0)
-			break;
+		while (totalBars > 0 && pHourly->time[totalBars - 1] > pSettings->asOfTime)
+			totalBars--;
+	}
 
-		if (iClose(ratesArrayIndex, shift1Index - (i + outBegIdx)) > boxHigh[i]) //ܹϡ c3 > max(h1,h2) or c3 > max(c1,c2) && h3>max(h1,h2) && l3>max(l1,l2)
-			trend[i] = UP;
+	if (totalBars < SCREENING_MIN_MA_BARS)
+		return NOT_ENOUGH_RATES_DATA;
 
-		if (iClose(ratesArrayIndex, shift1Index - (i + outBegIdx)) < boxLow[i]) //ܹϡ
-			trend[i] = DOWN;
+	// One block for the three aggregated timeframes, the hourly rates point straight into the series.
+	pTimes = (time_t*)malloc(3 * totalBars * sizeof(time_t));
+	pValues = (double*)malloc(3 * 5 * totalBars * sizeof(double));
+	if (pTimes == NULL || pValues == NULL)
+	{
+		free(pTimes);
+		free(pValues);
+		return INSUFFICIENT_MEMORY;
+	}
 
-		if (i - 1 >= 0 && trend[i - 1] == UP && trend[i] == RANGE)
-			trend[i] = RANGE;
+	memset(&ratesBuffers, 0, sizeof(RatesBuffers));
+	ratesBuffers.instanceId = symbolIndex;
+	ratesBuffers.rates[S_HOURLY_RATES].info.isEnabled = TRUE;
+	ratesBuffers.rates[S_HOURLY_RATES].info.timeframe = 60;
+	ratesBuffers.rates[S_HOURLY_RATES].info.arraySize = totalBars;
+	ratesBuffers.rates[S_HOURLY_RATES].time = pHourly->time;
+	ratesBuffers.rates[S_HOURLY_RATES].open = pHourly->open;
+	ratesBuffers.rates[S_HOURLY_RATES].high = pHourly->high;
+	ratesBuffers.rates[S_HOURLY_RATES].low = pHourly->low;
+	ratesBuffers.rates[S_HOURLY_RATES].close = pHourly->close;
+	ratesBuffers.rates[S_HOURLY_RATES].volume = pHourly->volume;
+
+	for (i = 0, ratesIndex = S_FOURHOURLY_RATES; ratesIndex <= S_WEEKLY_RATES; i++, ratesIndex++)
+	{
+		Rates* pRates = &ratesBuffers.rates[ratesIndex];
+		pRates->info.isEnabled = TRUE;
+		pRates->info.timeframe = (ratesIndex == S_FOURHOURLY_RATES) ? 240 : (ratesIndex == S_DAILY_RATES) ? 1440 : 10080;
+		pRates->time = pTimes + i * totalBars;
+		pRates->open = pValues + (i * 5) * totalBars;
+		pRates->high = pValues + (i * 5 + 1) * totalBars;
+		pRates->low = pValues + (i * 5 + 2) * totalBars;
+		pRates->close = pValues + (i * 5 + 3) * totalBars;
+		pRates->volume = pValues + (i * 5 + 4) * totalBars;
+		aggregateHourlyBars(pHourly, totalBars, ratesIndex, pRates);
+	}
 
-		if (i - 1 >= 0 && trend[i - 1] == DOWN && trend[i] == RANGE)
-			trend[i] = RANGE;
+	if (ratesBuffers.rates[S_FOURHOURLY_RATES].info.arraySize < SCREENING_MIN_MA_BARS
+		|| ratesBuffers.rates[S_DAILY_RATES].info.arraySize < pSettings->atrAveragingPeriod + 2
+		|| ratesBuffers.rates[S_WEEKLY_RATES].info.arraySize < SCREENING_MIN_WEEKLY_BARS)
+	{
+		returnCode = NOT_ENOUGH_RATES_DATA;
+	}
+	else
+	{
+		memset(settings, 0, sizeof(settings));
+		settings[STRATEGY_INSTANCE_ID] = symbolIndex;
+		settings[ATR_AVERAGING_PERIOD] = pSettings->atrAveragingPeriod;
+		settings[TIMEFRAME] = 60;
+		settings[IS_BACKTESTING] = TRUE;
+		bid = ask = pHourly->close[totalBars - 1];
+
+		memset(&params, 0, sizeof(StrategyParams));
+		params.tradeSymbol = (char*)symbol;
+		params.currentBrokerTime = pHourly->time[totalBars - 1];
+		params.ratesBuffers = &ratesBuffers;
+		params.bidAsk.arraySize = 1;
+		params.bidAsk.bid = &bid;
+		params.bidAsk.ask = &ask;
+		params.settings = settings;
+
+		// Every worker thread has its own EasyTrade instance, and a batch always starts from an empty snapshot.
+		initEasyTradeLibrary(&params);
+		invalidateScreeningSnapshot(&snapshot);
+		returnCode = loadIndicators(&params, &snapshot, &indicators);
+	}
 
-		*pTrend = trend[i];
-	}	
+	if (returnCode == SUCCESS)
+	{
+		pResult->barTime = pHourly->time[totalBars - 1];
+		pResult->dailyTrend = indicators.dailyTrend;
+		pResult->daily3RulesTrend = indicators.daily3RulesTrend;
+		pResult->weeklyTrend = indicators.weeklyTrend;
+		pResult->weekly3RulesTrend = indicators.weekly3RulesTrend;
+		pResult->dailyS = indicators.dailyS;
+		pResult->dailyR = indicators.dailyR;
+		pResult->dailyTP = indicators.dailyTP;
+		pResult->weeklyS = indicators.weeklyS;
+		pResult->weeklyR = indicators.weeklyR;
+		pResult->weeklyTP = indicators.weeklyTP;
+		pResult->dailyATR = indicators.dailyATR;
+		pResult->weeklyATR = indicators.weeklyATR;
+	}
 
-	return SUCCESS;
-	
+	free(pTimes);
+	free(pValues);
+	return returnCode;
 }
 
-static AsirikuyReturnCode iTrend3Rules(StrategyParams* pParams, Indicators* pIndicators, int ratesArrayIndex, int shift, int * pTrend)
+static AsirikuyReturnCode loadHourlyHistory(const char* historyFolder, const char* symbol, BarSeries* pSeries)
 {
-	TA_RetCode retCode;
-	int shift0Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 1;
-	int shift1Index = pParams->ratesBuffers->rates[ratesArrayIndex].info.arraySize - 2;
-	int       outBegIdx, outNBElement;
-	double	  boxHigh, boxLow;	
+	char filePath[MAX_FILE_PATH_CHARS];
+	const char* separator = "";
+	size_t length = strlen(historyFolder);
+	FILE* fp;
+
+	if (length > 0 && historyFolder[length - 1] != '/' && historyFolder[length - 1] != '\\')
+		separator = "/";
+
+	if (length + strlen(symbol) + 12 >= MAX_FILE_PATH_CHARS)
+		return INVALID_PARAMETER;
+
+	// Binary bar files are preferred, csv files are the fallback.
+	sprintf(filePath, "%s%s%s_60.bin", historyFolder, separator, symbol);
+	fp = fopen(filePath, "rb");
+	if (fp != NULL)
+		fclose(fp);
+	else
+		sprintf(filePath, "%s%s%s_60.csv", historyFolder, separator, symbol);
+
+	return loadBarFile(filePath, pSeries);
+}
 
-	retCode = TA_MIN(shift1Index - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].low, shift, &outBegIdx, &outNBElement, &boxLow);
-	if (retCode != TA_SUCCESS)
+static void screenBatchSymbol(int taskIndex, int threadIndex, void* pContext)
+{
+	ScreeningBatch*  pBatch = (ScreeningBatch*)pContext;
+	ScreeningResult* pResult = &pBatch->pResults[taskIndex];
+	const char*      symbol = pBatch->symbols[taskIndex];
+	BarSeries        series;
+
+	memset(pResult, 0, sizeof(ScreeningResult));
+	strncpy(pResult->symbol, symbol, SCREENING_SYMBOL_SIZE - 1);
+
+	if (pBatch->pHourlySeries != NULL)
 	{
-		return logTALibError("TA_MIN()", retCode);
+		pResult->returnCode = screenHourlySeries(symbol, taskIndex, &pBatch->pHourlySeries[taskIndex], pBatch->pSettings, pResult);
+		return;
 	}
 
-	retCode = TA_MAX(shift1Index - 1, shift1Index - 1, pParams->ratesBuffers->rates[ratesArrayIndex].high, shift, &outBegIdx, &outNBElement, &boxHigh);
-	if (retCode != TA_SUCCESS)
+	initBarSeries(&series);
+	pResult->returnCode = loadHourlyHistory(pBatch->historyFolder, symbol, &series);
+	if (pResult->returnCode == SUCCESS)
+		pResult->returnCode = screenHourlySeries(symbol, taskIndex, &series, pBatch->pSettings, pResult);
+	freeBarSeries(&series);
+}
+
+static AsirikuyReturnCode runBatch(ScreeningBatch* pBatch, int totalSymbols)
+{
+	AsirikuyReturnCode returnCode;
+	int i, totalScreened = 0;
+
+	if (pBatch->symbols == NULL || pBatch->pSettings == NULL || pBatch->pResults == NULL)
 	{
-		return logTALibError("TA_MAX()", retCode);
+		pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runScreeningBatch() failed. symbols, pSettings or pResults = NULL");
+		return NULL_POINTER;
 	}
 
-	*pTrend = RANGE;
-	if (iClose(ratesArrayIndex, 1) > boxHigh) //ܹϡ c3 > max(h1,h2)
-			*pTrend = UP;
+	if (pBatch->pSettings->atrAveragingPeriod <= 0)
+	{
+		pantheios_logprintf(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runScreeningBatch() failed. atrAveragingPeriod must be greater than 0. atrAveragingPeriod = %d", pBatch->pSettings->atrAveragingPeriod);
+		return INVALID_PARAMETER;
+	}
 
-	if (iClose(ratesArrayIndex, 1) < boxLow) //ܹϡ
-			*pTrend = DOWN;
+	returnCode = runParallelTasks(totalSymbols, pBatch->pSettings->totalThreads, screenBatchSymbol, pBatch);
+	if (returnCode != SUCCESS)
+		return logAsirikuyError("runScreeningBatch()", returnCode);
+
+	for (i = 0; i < totalSymbols; i++)
+	{
+		if (pBatch->pResults[i].returnCode == SUCCESS)
+			totalScreened++;
+		else
+			pantheios_logprintf(PANTHEIOS_SEV_WARNING, (PAN_CHAR_T*)"runScreeningBatch() %s was not screened. Error = %d", pBatch->pResults[i].symbol, pBatch->pResults[i].returnCode);
+	}
 
+	pantheios_logprintf(PANTHEIOS_SEV_INFORMATIONAL, (PAN_CHAR_T*)"runScreeningBatch() screened %d of %d symbols.", totalScreened, totalSymbols);
 	return SUCCESS;
+}
+
+AsirikuyReturnCode runScreeningBatch(const char* historyFolder, const char** symbols, int totalSymbols, const ScreeningBatchSettings* pSettings, ScreeningResult* pResults)
+{
+	ScreeningBatch batch;
+
+	if (historyFolder == NULL)
+	{
+		pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runScreeningBatch() failed. historyFolder = NULL");
+		return NULL_POINTER;
+	}
+
+	batch.symbols = symbols;
+	batch.pHourlySeries = NULL;
+	batch.historyFolder = historyFolder;
+	batch.pSettings = pSettings;
+	batch.pResults = pResults;
+	return runBatch(&batch, totalSymbols);
+}
+
+AsirikuyReturnCode runScreeningOnSeries(const char** symbols, const BarSeries* pHourlySeries, int totalSymbols, const ScreeningBatchSettings* pSettings, ScreeningResult* pResults)
+{
+	ScreeningBatch batch;
+
+	if (pHourlySeries == NULL)
+	{
+		pantheios_logputs(PANTHEIOS_SEV_ERROR, (PAN_CHAR_T*)"runScreeningOnSeries() failed. pHourlySeries = NULL");
+		return NULL_POINTER;
+	}
 
+	batch.symbols = symbols;
+	batch.pHourlySeries = pHourlySeries;
+	batch.historyFolder = NULL;
+	batch.pSettings = pSettings;
+	batch.pResults = pResults;
+	return runBatch(&batch, totalSymbols);
 }
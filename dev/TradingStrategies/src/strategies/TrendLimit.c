@@ -30,7 +30,7 @@ AsirikuyReturnCode runTrendLimit(StrategyParams* pParams)
 {
 	AsirikuyReturnCode returnCode = SUCCESS;
 	Indicators indicators;
-	Base_Indicators base_Indicators;
+	Base_Indicators base_Indicators = { 0 };
 
 	char       timeString[MAX_TIME_STRING_SIZE] = "";
 	int        shift0Index = pParams->ratesBuffers->rates[B_PRIMARY_RATES].info.arraySize - 1, shift1Index = pParams->ratesBuffers->rates[B_PRIMARY_RATES].info.arraySize - 2;
@@ -34,7 +34,147 @@
  * @copyright In no event shall Asirikuy or any contributors to the Asirikuy Framework be liable for any damages (including, without limitation, lost profits, business interruption, or lost information) rising out of 'Authorized Users' use of or inability to use the Asirikuy Framework, even if Asirikuy has been advised of the possibility of such damages. In no event will Asirikuy or any contributors to the Asirikuy Framework be liable for loss of data or for indirect, special, incidental, consequential (including lost profit), or other damages based in contract, tort or otherwise. Asirikuy and contributors to the Asirikuy Framework shall have no liability with respect to the content of the Asirikuy Framework or any part thereof, including but not limited to errors or omissions contained therein, libel, infringements of rights of publicity, privacy, trademark rights, business interruption, personal injury, loss of privacy, moral rights or the disclosure of confidential information.
  */
 
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <string.h>
+#include <time.h>
 #include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "AsirikuyDefines.h"
+#include "BaseIndicatorsCache.h"
+#include "EasyTradeCWrapper.hpp"
+#include "Screening.h"
+#include "StrategyUserInterface.h"
+#include "WorkerThreads.h"
+
+namespace
+{
+  int baseLoaderCalls = 0;
+  int baseLoaderWork  = 1;
+
+  /* Stands in for the Base loadIndicators: reads the rates and the bid, costs baseLoaderWork passes over the primary bars. */
+  AsirikuyReturnCode fakeBaseLoader(StrategyParams* pParams, Base_Indicators* pIndicators)
+  {
+    const Rates* pPrimary = &pParams->ratesBuffers->rates[B_PRIMARY_RATES];
+    double sum = 0;
+
+    baseLoaderCalls++;
+    for(int pass = 0; pass < baseLoaderWork; pass++)
+    {
+      for(int i = 0; i < pPrimary->info.arraySize; i++)
+      {
+        sum += pPrimary->close[i] * (pass + 1);
+      }
+    }
+
+    pIndicators->dailyATR = sum;
+    pIndicators->dailyS   = pParams->bidAsk.bid[0];
+    pIndicators->dailyR   = pParams->ratesBuffers->rates[B_DAILY_RATES].close[pParams->ratesBuffers->rates[B_DAILY_RATES].info.arraySize - 1];
+    return SUCCESS;
+  }
+
+  /* Reads the modes like the Base loadIndicators: the weekly values, and the weekly MA mode, only in the weekly modes. */
+  AsirikuyReturnCode modeBaseLoader(StrategyParams* pParams, Base_Indicators* pIndicators)
+  {
+    baseLoaderCalls++;
+    pIndicators->dailyATR = pParams->bidAsk.bid[0];
+    if(pIndicators->strategy_mode > 0)
+    {
+      pIndicators->weeklyATR      = 100 + pIndicators->weeklyMAMode;
+      pIndicators->weeklyMATrend  = pIndicators->weeklyMAMode == 0 ? 1 : -1;
+    }
+    return SUCCESS;
+  }
+
+  /* One symbol with every Base timeframe backed by the same bars, which is all the cache looks at. */
+  struct BaseTestChart
+  {
+    std::vector<time_t> times;
+    std::vector<double> prices;
+    RatesBuffers        buffers;
+    double              bid, ask;
+    char                symbol[16];
+
+    BaseTestChart(int bars)
+      : times(bars), prices(bars), bid(0), ask(0)
+    {
+      srand(3);
+      for(int i = 0; i < bars; i++)
+      {
+        times[i]  = 1400371200 + i * 300;
+        prices[i] = 1.3 + (rand() % 1000) * 0.0001;
+      }
+      strcpy(symbol, "EURUSD");
+      memset(&buffers, 0, sizeof(RatesBuffers));
+    }
+
+    void fill(StrategyParams* pParams, int arraySize)
+    {
+      memset(pParams, 0, sizeof(StrategyParams));
+      for(int r = 0; r < BASE_INDICATORS_CACHE_TIMEFRAMES; r++)
+      {
+        Rates* pRates = &buffers.rates[r];
+        pRates->info.timeframe = (r + 1) * 5;
+        pRates->info.arraySize = arraySize;
+        pRates->time  = &times[0];
+        pRates->open  = &prices[0];
+        pRates->high  = &prices[0];
+        pRates->low   = &prices[0];
+        pRates->close = &prices[0];
+      }
+      bid = ask = prices[arraySize - 1];
+      pParams->tradeSymbol    = symbol;
+      pParams->ratesBuffers   = &buffers;
+      pParams->bidAsk.bid     = &bid;
+      pParams->bidAsk.ask     = &ask;
+      pParams->bidAsk.arraySize = 1;
+    }
+  };
+
+  /* A random walk of OHLC bars in the primary rates, for comparing EasyTrade indicator calls. */
+  struct IndicatorTestChart
+  {
+    std::vector<time_t> times;
+    std::vector<double> open, high, low, close, volume;
+    RatesBuffers        buffers;
+    StrategyParams      params;
+
+    IndicatorTestChart(int bars)
+      : times(bars), open(bars), high(bars), low(bars), close(bars), volume(bars)
+    {
+      double price = 1.3;
+
+      srand(11);
+      for(int i = 0; i < bars; i++)
+      {
+        times[i]  = 1400371200 + i * 3600;
+        open[i]   = price;
+        price    += ((rand() % 2001) - 1000) * 0.000002;
+        close[i]  = price;
+        high[i]   = std::max(open[i], close[i]) + (rand() % 100) * 0.00001;
+        low[i]    = std::min(open[i], close[i]) - (rand() % 100) * 0.00001;
+        volume[i] = 100 + rand() % 1000;
+      }
+
+      memset(&buffers, 0, sizeof(RatesBuffers));
+      buffers.rates[PRIMARY_RATES].info.arraySize = bars;
+      buffers.rates[PRIMARY_RATES].info.timeframe = 60;
+      buffers.rates[PRIMARY_RATES].time   = &times[0];
+      buffers.rates[PRIMARY_RATES].open   = &open[0];
+      buffers.rates[PRIMARY_RATES].high   = &high[0];
+      buffers.rates[PRIMARY_RATES].low    = &low[0];
+      buffers.rates[PRIMARY_RATES].close  = &close[0];
+      buffers.rates[PRIMARY_RATES].volume = &volume[0];
+
+      memset(&params, 0, sizeof(StrategyParams));
+      params.ratesBuffers = &buffers;
+    }
+  };
+}
 
 BOOST_AUTO_TEST_SUITE(Trading_Strategies)
 
@@ -43,4 +183,373 @@ BOOST_AUTO_TEST_CASE(placeholder)
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(baseIndicatorsCache_sharesValuesBetweenInstances)
+{
+  const int INSTANCES = 20;
+  const int BARS      = 600;
+  BaseTestChart  chart(BARS);
+  StrategyParams params;
+  BaseIndicatorsCacheStats stats;
+  bool isMatching = true;
+
+  resetBaseIndicatorsCache();
+  baseLoaderCalls = 0;
+  baseLoaderWork  = 1;
+
+  for(int n = 100; n < BARS && isMatching; n++)
+  {
+    Base_Indicators direct, cached;
+
+    chart.fill(&params, n);
+    memset(&direct, 0, sizeof(Base_Indicators));
+    fakeBaseLoader(&params, &direct);
+    baseLoaderCalls--;
+
+    for(int instance = 0; instance < INSTANCES && isMatching; instance++)
+    {
+      memset(&cached, 0, sizeof(Base_Indicators));
+      BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &cached), SUCCESS);
+      isMatching = memcmp(&cached, &direct, sizeof(Base_Indicators)) == 0;
+    }
+    BOOST_CHECK_MESSAGE(isMatching, "cached values differ at bar " << n);
+  }
+
+  getBaseIndicatorsCacheStats(&stats);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, BARS - 100);
+  BOOST_CHECK_EQUAL(stats.lookups, (unsigned long)(INSTANCES * (BARS - 100)));
+  BOOST_CHECK_EQUAL(stats.misses, (unsigned long)(BARS - 100));
+  BOOST_CHECK_CLOSE(getBaseIndicatorsCacheHitRate(), (INSTANCES - 1.0) / INSTANCES, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(baseIndicatorsCache_keyCoversInputs)
+{
+  BaseTestChart   chart(200);
+  StrategyParams  params;
+  Base_Indicators indicators;
+  char            longSymbol[BASE_INDICATORS_CACHE_SYMBOL_SIZE + 8];
+
+  resetBaseIndicatorsCache();
+  baseLoaderCalls = 0;
+  baseLoaderWork  = 1;
+  memset(&indicators, 0, sizeof(Base_Indicators));
+
+  chart.fill(&params, 150);
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 1);
+
+  /* Parameters, modes, symbol, tick and forming bar each make a new key. */
+  loadCachedBaseIndicators(&params, 20, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 2);
+
+  indicators.strategy_mode = 1;
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 3);
+  indicators.strategy_mode = 0;
+
+  strcpy(chart.symbol, "GBPUSD");
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 4);
+  strcpy(chart.symbol, "EURUSD");
+
+  chart.bid += 0.0001;
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 5);
+  chart.bid -= 0.0001;
+
+  chart.prices[149] += 0.0002;
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 6);
+  chart.prices[149] -= 0.0002;
+
+  /* Back to the first inputs, still cached. */
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 6);
+
+  /* Symbols that don't fit in a key are never shared. */
+  memset(longSymbol, 'X', sizeof(longSymbol) - 1);
+  longSymbol[sizeof(longSymbol) - 1] = '\0';
+  params.tradeSymbol = longSymbol;
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 8);
+
+  setBaseIndicatorsCacheEnabled(FALSE);
+  params.tradeSymbol = chart.symbol;
+  loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 9);
+  setBaseIndicatorsCacheEnabled(TRUE);
+}
+
+BOOST_AUTO_TEST_CASE(baseIndicatorsCache_modesSelectTheirOwnValues)
+{
+  BaseTestChart   chart(200);
+  StrategyParams  params;
+  Base_Indicators daily, weekly;
+
+  resetBaseIndicatorsCache();
+  baseLoaderCalls = 0;
+  chart.fill(&params, 150);
+
+  /* The daily mode does not read the weekly MA mode, so it is not part of its key. */
+  memset(&daily, 0, sizeof(Base_Indicators));
+  daily.weeklyMAMode = 7;
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &daily), SUCCESS);
+  memset(&daily, 0, sizeof(Base_Indicators));
+  daily.weeklyMAMode = 3;
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &daily), SUCCESS);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 1);
+  BOOST_CHECK_EQUAL(daily.weeklyMAMode, 3);
+  BOOST_CHECK_EQUAL(daily.strategy_mode, 0);
+  BOOST_CHECK_EQUAL(daily.weeklyATR, 0);
+
+  /* The weekly mode gets its own values, one entry per weekly MA mode. */
+  memset(&weekly, 0, sizeof(Base_Indicators));
+  weekly.strategy_mode = 1;
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &weekly), SUCCESS);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 2);
+  BOOST_CHECK_EQUAL(weekly.weeklyATR, 100);
+  BOOST_CHECK_EQUAL(weekly.weeklyMATrend, 1);
+
+  weekly.weeklyMAMode = 1;
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &weekly), SUCCESS);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 3);
+  BOOST_CHECK_EQUAL(weekly.weeklyATR, 101);
+  BOOST_CHECK_EQUAL(weekly.weeklyMATrend, -1);
+
+  /* Every mode hits its own entry from now on. */
+  memset(&weekly, 0, sizeof(Base_Indicators));
+  weekly.strategy_mode = 1;
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &weekly), SUCCESS);
+  BOOST_CHECK_EQUAL(weekly.weeklyATR, 100);
+  memset(&daily, 0, sizeof(Base_Indicators));
+  BOOST_REQUIRE_EQUAL(loadCachedBaseIndicators(&params, 14, modeBaseLoader, &daily), SUCCESS);
+  BOOST_CHECK_EQUAL(daily.weeklyATR, 0);
+  BOOST_CHECK_EQUAL(daily.strategy_mode, 0);
+  BOOST_CHECK_EQUAL(baseLoaderCalls, 3);
+}
+
+BOOST_AUTO_TEST_CASE(baseIndicatorsCache_benchmarkInstances)
+{
+  const int INSTANCES = 20;
+  const int BARS      = 1000;
+  BaseTestChart  chart(BARS);
+  StrategyParams params;
+  double seconds[2];
+
+  baseLoaderWork = 200;
+
+  for(int isEnabled = 0; isEnabled < 2; isEnabled++)
+  {
+    clock_t begin = clock();
+
+    resetBaseIndicatorsCache();
+    setBaseIndicatorsCacheEnabled(isEnabled ? TRUE : FALSE);
+    baseLoaderCalls = 0;
+
+    for(int n = 500; n < BARS; n++)
+    {
+      chart.fill(&params, n);
+      for(int instance = 0; instance < INSTANCES; instance++)
+      {
+        Base_Indicators indicators;
+        memset(&indicators, 0, sizeof(Base_Indicators));
+        loadCachedBaseIndicators(&params, 14, fakeBaseLoader, &indicators);
+      }
+    }
+
+    seconds[isEnabled] = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    BOOST_CHECK_EQUAL(baseLoaderCalls, isEnabled ? BARS - 500 : INSTANCES * (BARS - 500));
+  }
+
+  BOOST_TEST_MESSAGE(INSTANCES << " instances on one symbol: " << seconds[0] << "s without the Base indicators cache, " << seconds[1] << "s with it, hit rate " << getBaseIndicatorsCacheHitRate());
+  baseLoaderWork = 1;
+  setBaseIndicatorsCacheEnabled(TRUE);
+}
+
+BOOST_AUTO_TEST_CASE(screeningBatch_benchmarkSymbols)
+{
+  const int SYMBOLS = 200;
+  const int BARS    = 4000;  /* About 24 weeks of hourly bars, enough for the 4H 200 bars MA */
+  std::vector<BarSeries>       series(SYMBOLS);
+  std::vector<std::string>     names(SYMBOLS);
+  std::vector<const char*>     symbols(SYMBOLS);
+  std::vector<ScreeningResult> serialResults(SYMBOLS), parallelResults(SYMBOLS);
+  ScreeningBatchSettings       settings;
+  double seconds[2];
+
+  srand(5);
+  for(int s = 0; s < SYMBOLS; s++)
+  {
+    std::ostringstream name;
+    double price = 1 + s * 0.01;
+
+    name << "SYM" << s;
+    names[s]   = name.str();
+    symbols[s] = names[s].c_str();
+    initBarSeries(&series[s]);
+    for(int i = 0; i < BARS; i++)
+    {
+      BarRecord bar;
+      memset(&bar, 0, sizeof(BarRecord));
+      bar.time   = 1400371200 + i * 3600;
+      bar.open   = price;
+      bar.close  = price + (rand() % 201 - 100) * 0.0001;
+      bar.high   = std::max(bar.open, bar.close) + (rand() % 20) * 0.0001;
+      bar.low    = std::min(bar.open, bar.close) - (rand() % 20) * 0.0001;
+      bar.volume = 1 + rand() % 100;
+      price      = bar.close;
+      appendBarToSeries(&series[s], &bar);
+    }
+  }
+
+  settings.atrAveragingPeriod = 20;
+  settings.asOfTime           = 0;
+
+  for(int run = 0; run < 2; run++)
+  {
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+
+    settings.totalThreads = (run == 0) ? 1 : 0;
+    BOOST_REQUIRE_EQUAL(runScreeningOnSeries(&symbols[0], &series[0], SYMBOLS, &settings, (run == 0) ? &serialResults[0] : &parallelResults[0]), SUCCESS);
+    seconds[run] = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() / 1e6;
+  }
+
+  for(int s = 0; s < SYMBOLS; s++)
+  {
+    BOOST_CHECK_EQUAL(serialResults[s].returnCode, SUCCESS);
+    BOOST_CHECK_EQUAL(std::string(serialResults[s].symbol), names[s]);
+    BOOST_CHECK(memcmp(&serialResults[s], &parallelResults[s], sizeof(ScreeningResult)) == 0);
+    freeBarSeries(&series[s]);
+  }
+
+  BOOST_TEST_MESSAGE("Screening " << SYMBOLS << " symbols: " << SYMBOLS / std::max(seconds[0], 1e-6) << " symbols/s on one thread, "
+    << SYMBOLS / std::max(seconds[1], 1e-6) << " symbols/s on " << getProcessorCount() << " processors");
+}
+
+
+BOOST_AUTO_TEST_CASE(easyTradeSeries_matchSingleShiftMA)
+{
+  const int BARS  = 1000;
+  const int COUNT = 400;
+  const int periods[] = {1, 20, 50, 200};
+  IndicatorTestChart  chart(BARS);
+  std::vector<double> series(BARS);
+
+  BOOST_REQUIRE_EQUAL(initEasyTradeLibrary(&chart.params), SUCCESS);
+
+  for(int p = 0; p < 4; p++)
+  {
+    int mismatchShift = -1;
+
+    BOOST_REQUIRE_EQUAL(iMASeries(3, PRIMARY_RATES, periods[p], 1, COUNT, &series[0]), SUCCESS);
+    for(int i = 0; i < COUNT && mismatchShift < 0; i++)
+    {
+      double expected = iMA(3, PRIMARY_RATES, periods[p], i + 1);
+      if(fabs(series[i] - expected) > 1e-12 * fabs(expected))
+      {
+        mismatchShift = i + 1;
+      }
+    }
+    BOOST_CHECK_MESSAGE(mismatchShift < 0, "iMASeries differs from iMA for period " << periods[p] << " at shift " << mismatchShift);
+
+    /* Shifts without period bars behind them are cleared. */
+    BOOST_REQUIRE_EQUAL(iMASeries(0, PRIMARY_RATES, periods[p], 0, BARS, &series[0]), SUCCESS);
+    BOOST_CHECK_CLOSE(series[BARS - periods[p]], iMA(0, PRIMARY_RATES, periods[p], BARS - periods[p]), 1e-10);
+    for(int i = BARS - periods[p] + 1; i < BARS; i++)
+    {
+      BOOST_CHECK_EQUAL(series[i], 0);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(iMASeries(3, PRIMARY_RATES, 0, 1, COUNT, &series[0]), INVALID_PARAMETER);
+  BOOST_CHECK_EQUAL(iMASeries(3, PRIMARY_RATES, 20, BARS, COUNT, &series[0]), NOT_ENOUGH_RATES_DATA);
+}
+
+BOOST_AUTO_TEST_CASE(easyTradeSeries_matchSingleShiftMACDAndAtr)
+{
+  const int BARS  = 1000;
+  const int COUNT = 298;
+  IndicatorTestChart  chart(BARS);
+  std::vector<double> macd(COUNT), signal(COUNT), hist(COUNT), atr(BARS);
+  int mismatchShift = -1;
+
+  BOOST_REQUIRE_EQUAL(initEasyTradeLibrary(&chart.params), SUCCESS);
+
+  BOOST_REQUIRE_EQUAL(iMACDSeries(PRIMARY_RATES, 12, 26, 9, 1, COUNT, &macd[0], &signal[0], &hist[0]), SUCCESS);
+  for(int i = 0; i < COUNT && mismatchShift < 0; i++)
+  {
+    if(macd[i] != iMACD(PRIMARY_RATES, 12, 26, 9, 0, i + 1) || signal[i] != iMACD(PRIMARY_RATES, 12, 26, 9, 1, i + 1)
+      || hist[i] != iMACD(PRIMARY_RATES, 12, 26, 9, 2, i + 1))
+    {
+      mismatchShift = i + 1;
+    }
+  }
+  BOOST_CHECK_MESSAGE(mismatchShift < 0, "iMACDSeries differs from iMACD at shift " << mismatchShift);
+
+  /* The EMA unstable period is restored, so iMA keeps returning the SMA seed. */
+  BOOST_CHECK_CLOSE(iMA(3, PRIMARY_RATES, 2, 1), (chart.close[BARS - 2] + chart.close[BARS - 3]) / 2, 1e-10);
+
+  mismatchShift = -1;
+  BOOST_REQUIRE_EQUAL(iAtrSeries(PRIMARY_RATES, 20, 1, BARS, &atr[0]), SUCCESS);
+  for(int i = 0; i < BARS - 21 && mismatchShift < 0; i++)
+  {
+    double expected = iAtr(PRIMARY_RATES, 20, i + 1);
+    if(fabs(atr[i] - expected) > 1e-12 * expected)
+    {
+      mismatchShift = i + 1;
+    }
+  }
+  BOOST_CHECK_MESSAGE(mismatchShift < 0, "iAtrSeries differs from iAtr at shift " << mismatchShift);
+  BOOST_CHECK_EQUAL(atr[BARS - 21], 0);
+}
+
+BOOST_AUTO_TEST_CASE(virtualOrderInfo_keepsFieldsNotInFile)
+{
+  const int instanceId = 4501;
+  OrderInfo saved, read;
+
+  memset(&saved, 0, sizeof(OrderInfo));
+  saved.ticket     = 12;
+  saved.type       = SELL;
+  saved.isOpen     = TRUE;
+  saved.openPrice  = 1.25f;
+  saved.stopLoss   = 1.5f;
+  saved.takeProfit = 1.f;
+  saved.openTime   = 1401062400;
+
+  setTempFileFolderPath((char*)".");
+  BOOST_REQUIRE_EQUAL(saveVirutalOrdergInfo(instanceId, saved), SUCCESS);
+
+  memset(&read, 0, sizeof(OrderInfo));
+  read.instanceId  = instanceId;
+  read.closeTime   = 1401066000;
+  read.expiriation = 1401069600;
+  read.closePrice  = 1.125f;
+  read.lots        = 0.5f;
+  read.profit      = 62.5f;
+  read.commission  = 3.f;
+  read.swap        = -0.25f;
+  BOOST_REQUIRE_EQUAL(readVirtualOrderInfo(instanceId, &read), 0);
+
+  BOOST_CHECK_EQUAL(read.ticket, 12);
+  BOOST_CHECK_EQUAL(read.type, SELL);
+  BOOST_CHECK_EQUAL(read.isOpen, TRUE);
+  BOOST_CHECK_CLOSE(read.openPrice, 1.25f, 1e-4);
+  BOOST_CHECK_CLOSE(read.stopLoss, 1.5f, 1e-4);
+  BOOST_CHECK_CLOSE(read.takeProfit, 1.f, 1e-4);
+  BOOST_CHECK_EQUAL(read.openTime, 1401062400);
+
+  BOOST_CHECK_EQUAL(read.instanceId, instanceId);
+  BOOST_CHECK_EQUAL(read.closeTime, 1401066000);
+  BOOST_CHECK_EQUAL(read.expiriation, 1401069600);
+  BOOST_CHECK_EQUAL(read.closePrice, 1.125f);
+  BOOST_CHECK_EQUAL(read.lots, 0.5f);
+  BOOST_CHECK_EQUAL(read.profit, 62.5f);
+  BOOST_CHECK_EQUAL(read.commission, 3.f);
+  BOOST_CHECK_EQUAL(read.swap, -0.25f);
+
+  remove("./4501_VirutalOrderInfo.txt");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,8 @@ project "UnitTests"
 	"TradingStrategies",
 	"SymbolAnalyzer",
 	"OrderManager",
+	"Log",
+	"AsirikuyCommon",
 	"DevIL",
 	"dSFMT",
     "FANN",
@@ -225,6 +225,7 @@ else
 	include "dev/AsirikuyFrameworkAPI"
 	include "dev/CTesterFrameworkAPI"
 	include "dev/UnitTests"
+	include "dev/StatusMonitor"
     if os.get() == "windows" then
 	  include "vendor/curl"
     end